@@ -0,0 +1,347 @@
+// Core/BinarySXMLDocument.cpp
+
+#include <Core/BinarySXMLDocument.h>
+
+#include <Core/Constants.h>
+#include <Core/FastFormat.hpp>
+
+#include <cassert>
+#include <sstream>
+#include <stdexcept>
+
+namespace Core
+{
+	namespace detail
+	{
+		const unsigned char c_BinarySXMLMagic[4] = { 'B', 'S', 'X', 'M' };
+		const std::uint32_t c_BinarySXMLVersion = 1;
+
+		struct BinarySXMLHeader
+		{
+			unsigned char Magic[4];
+			std::uint32_t Version;
+			std::uint32_t CountNodes;
+			std::uint32_t Reserved;
+			std::uint64_t DataSize;
+		};
+
+		static_assert(sizeof(BinarySXMLHeader) == 24, "Invalid binary SXML header size.");
+		static_assert(sizeof(BinarySXMLNode) == 40, "Invalid binary SXML node size.");
+
+		inline void ThrowInvalidBinarySXML()
+		{
+			throw std::runtime_error("Invalid binary SXML document.");
+		}
+
+		inline size_t GetBinarySXMLValueSize(BinarySXMLValueType type)
+		{
+			switch (type)
+			{
+			case BinarySXMLValueType::Text: case BinarySXMLValueType::Bytes:
+			case BinarySXMLValueType::Bool: case BinarySXMLValueType::Int8: case BinarySXMLValueType::UInt8: return 1;
+			case BinarySXMLValueType::Int16: case BinarySXMLValueType::UInt16: return 2;
+			case BinarySXMLValueType::Int32: case BinarySXMLValueType::UInt32: case BinarySXMLValueType::Float: return 4;
+			case BinarySXMLValueType::Int64: case BinarySXMLValueType::UInt64: case BinarySXMLValueType::Double: return 8;
+			default: return 0;
+			}
+		}
+
+		template <typename T, typename TargetType>
+		inline void FormatBinarySXMLValues(TargetType& target, const unsigned char* source, size_t count,
+			size_t groupSize)
+		{
+			for (size_t i = 0; i < count; i++, source += sizeof(T))
+			{
+				T value;
+				memcpy(&value, source, sizeof(T));
+				char buffer[c_MaxNumberCharacters];
+				auto end = ToChars(buffer, buffer + c_MaxNumberCharacters, value);
+				AppendChars(target, buffer, static_cast<size_t>(end - buffer));
+				if (i + 1 < count)
+				{
+					char separator = ((i + 1) % groupSize == 0 ? ';' : ',');
+					AppendChars(target, &separator, 1);
+				}
+			}
+		}
+
+		template <typename TargetType>
+		inline void FormatBinarySXMLValue(const BinarySXMLNode& nodeData, const unsigned char* source,
+			TargetType& target)
+		{
+			size_t count = static_cast<size_t>(nodeData.ValueCount);
+			size_t groupSize = (nodeData.GroupSize == 0 ? 1 : nodeData.GroupSize);
+			switch (nodeData.ValueType)
+			{
+			case BinarySXMLValueType::None: break;
+			case BinarySXMLValueType::Text: case BinarySXMLValueType::Bytes:
+				AppendChars(target, reinterpret_cast<const char*>(source), count); break;
+			case BinarySXMLValueType::Bool: FormatBinarySXMLValues<bool>(target, source, count, groupSize); break;
+			case BinarySXMLValueType::Int8: FormatBinarySXMLValues<std::int8_t>(target, source, count, groupSize); break;
+			case BinarySXMLValueType::UInt8: FormatBinarySXMLValues<std::uint8_t>(target, source, count, groupSize); break;
+			case BinarySXMLValueType::Int16: FormatBinarySXMLValues<std::int16_t>(target, source, count, groupSize); break;
+			case BinarySXMLValueType::UInt16: FormatBinarySXMLValues<std::uint16_t>(target, source, count, groupSize); break;
+			case BinarySXMLValueType::Int32: FormatBinarySXMLValues<std::int32_t>(target, source, count, groupSize); break;
+			case BinarySXMLValueType::UInt32: FormatBinarySXMLValues<std::uint32_t>(target, source, count, groupSize); break;
+			case BinarySXMLValueType::Int64: FormatBinarySXMLValues<std::int64_t>(target, source, count, groupSize); break;
+			case BinarySXMLValueType::UInt64: FormatBinarySXMLValues<std::uint64_t>(target, source, count, groupSize); break;
+			case BinarySXMLValueType::Float: FormatBinarySXMLValues<float>(target, source, count, groupSize); break;
+			case BinarySXMLValueType::Double: FormatBinarySXMLValues<double>(target, source, count, groupSize); break;
+			}
+		}
+	}
+
+	BinarySXMLDocument::BinarySXMLDocument()
+	{
+		Clear();
+	}
+
+	void BinarySXMLDocument::Clear()
+	{
+		m_Nodes.Clear();
+		m_LastChildren.Clear();
+		m_Data.Clear();
+		m_ExternalData = nullptr;
+
+		auto& root = m_Nodes.PushBackPlaceHolder();
+		memset(&root, 0, sizeof(BinarySXMLNode));
+		root.ValueType = BinarySXMLValueType::None;
+		root.GroupSize = 1;
+		root.FirstChild = c_InvalidIndexU;
+		root.NextSibling = c_InvalidIndexU;
+		m_LastChildren.PushBack(c_InvalidIndexU);
+	}
+
+	const unsigned char* BinarySXMLDocument::GetData() const
+	{
+		return (m_ExternalData != nullptr ? m_ExternalData : m_Data.GetArray());
+	}
+
+	std::uint64_t BinarySXMLDocument::AddData(const void* data, size_t size, size_t alignment)
+	{
+		assert(m_ExternalData == nullptr);
+		size_t countPadding = (alignment - m_Data.GetSize() % alignment) % alignment;
+		if (countPadding > 0) m_Data.PushBack(static_cast<unsigned char>(0), countPadding);
+		std::uint64_t offset = m_Data.GetSize();
+		if (size > 0) m_Data.PushBack(reinterpret_cast<const unsigned char*>(data), size);
+		return offset;
+	}
+
+	unsigned BinarySXMLDocument::AddNode(unsigned parent, const char* name, bool isAttribute)
+	{
+		assert(m_ExternalData == nullptr);
+		size_t nameSize = strlen(name);
+		assert(nameSize <= 0xffff);
+
+		unsigned nodeIndex = m_Nodes.GetSize();
+		auto& node = m_Nodes.PushBackPlaceHolder();
+		node.NameOffset = static_cast<std::uint32_t>(AddData(name, nameSize, 1));
+		node.NameSize = static_cast<std::uint16_t>(nameSize);
+		node.ValueType = BinarySXMLValueType::None;
+		node.Flags = (isAttribute ? c_AttributeFlag : 0);
+		node.GroupSize = 1;
+		node.FirstChild = c_InvalidIndexU;
+		node.NextSibling = c_InvalidIndexU;
+		node.Reserved = 0;
+		node.ValueOffset = 0;
+		node.ValueCount = 0;
+		m_LastChildren.PushBack(c_InvalidIndexU);
+
+		auto& lastChild = m_LastChildren[parent];
+		if (lastChild == c_InvalidIndexU) m_Nodes[parent].FirstChild = nodeIndex;
+		else m_Nodes[lastChild].NextSibling = nodeIndex;
+		lastChild = nodeIndex;
+
+		return nodeIndex;
+	}
+
+	void BinarySXMLDocument::SetValue(unsigned node, BinarySXMLValueType type, const void* data, size_t size,
+		size_t count, size_t groupSize, size_t alignment)
+	{
+		auto offset = AddData(data, size, alignment);
+		auto& nodeData = m_Nodes[node];
+		nodeData.ValueType = type;
+		nodeData.ValueOffset = offset;
+		nodeData.ValueCount = count;
+		nodeData.GroupSize = static_cast<std::uint32_t>(groupSize);
+	}
+
+	void BinarySXMLDocument::SetText(unsigned node, const char* text, size_t size)
+	{
+		SetValue(node, BinarySXMLValueType::Text, text, size, size, 1, 1);
+	}
+
+	void BinarySXMLDocument::SetBytes(unsigned node, const unsigned char* bytes, size_t size)
+	{
+		SetValue(node, BinarySXMLValueType::Bytes, bytes, size, size, 1, 1);
+	}
+
+	unsigned BinarySXMLDocument::GetCountNodes() const
+	{
+		return m_Nodes.GetSize();
+	}
+
+	const BinarySXMLNode& BinarySXMLDocument::GetNode(unsigned node) const
+	{
+		return m_Nodes[node];
+	}
+
+	unsigned BinarySXMLDocument::GetFirstChild(unsigned node) const
+	{
+		return m_Nodes[node].FirstChild;
+	}
+
+	unsigned BinarySXMLDocument::GetNextSibling(unsigned node) const
+	{
+		return m_Nodes[node].NextSibling;
+	}
+
+	unsigned BinarySXMLDocument::FindChild(unsigned node, const char* name) const
+	{
+		size_t nameSize = strlen(name);
+		auto data = GetData();
+		for (unsigned child = m_Nodes[node].FirstChild; child != c_InvalidIndexU; child = m_Nodes[child].NextSibling)
+		{
+			auto& childData = m_Nodes[child];
+			if ((childData.Flags & c_AttributeFlag) == 0 && childData.NameSize == nameSize
+				&& memcmp(data + childData.NameOffset, name, nameSize) == 0)
+			{
+				return child;
+			}
+		}
+		return c_InvalidIndexU;
+	}
+
+	unsigned BinarySXMLDocument::FindAttribute(unsigned node, const char* name) const
+	{
+		size_t nameSize = strlen(name);
+		auto data = GetData();
+		for (unsigned child = m_Nodes[node].FirstChild; child != c_InvalidIndexU; child = m_Nodes[child].NextSibling)
+		{
+			auto& childData = m_Nodes[child];
+			if ((childData.Flags & c_AttributeFlag) != 0 && childData.NameSize == nameSize
+				&& memcmp(data + childData.NameOffset, name, nameSize) == 0)
+			{
+				return child;
+			}
+		}
+		return c_InvalidIndexU;
+	}
+
+	bool BinarySXMLDocument::IsAttribute(unsigned node) const
+	{
+		return ((m_Nodes[node].Flags & c_AttributeFlag) != 0);
+	}
+
+	const char* BinarySXMLDocument::GetName(unsigned node) const
+	{
+		return reinterpret_cast<const char*>(GetData() + m_Nodes[node].NameOffset);
+	}
+
+	size_t BinarySXMLDocument::GetNameSize(unsigned node) const
+	{
+		return m_Nodes[node].NameSize;
+	}
+
+	BinarySXMLValueType BinarySXMLDocument::GetValueType(unsigned node) const
+	{
+		return m_Nodes[node].ValueType;
+	}
+
+	size_t BinarySXMLDocument::GetValueCount(unsigned node) const
+	{
+		return static_cast<size_t>(m_Nodes[node].ValueCount);
+	}
+
+	const unsigned char* BinarySXMLDocument::GetValueData(unsigned node) const
+	{
+		return GetData() + m_Nodes[node].ValueOffset;
+	}
+
+	bool BinarySXMLDocument::IsNumeric(unsigned node) const
+	{
+		auto type = m_Nodes[node].ValueType;
+		return (type != BinarySXMLValueType::None && type != BinarySXMLValueType::Text
+			&& type != BinarySXMLValueType::Bytes);
+	}
+
+	void BinarySXMLDocument::ThrowNotNumeric(unsigned node) const
+	{
+		std::stringstream ss;
+		ss << "The binary SXML node is not numeric: " << std::string(GetName(node), GetNameSize(node));
+		throw std::runtime_error(ss.str().c_str());
+	}
+
+	void BinarySXMLDocument::FormatValue(unsigned node, std::string& text) const
+	{
+		text.clear();
+		detail::FormatBinarySXMLValue(m_Nodes[node], GetValueData(node), text);
+	}
+
+	void BinarySXMLDocument::FormatValue(unsigned node, SimpleTypeVector<char>& text) const
+	{
+		text.Clear();
+		detail::FormatBinarySXMLValue(m_Nodes[node], GetValueData(node), text);
+	}
+
+	void BinarySXMLDocument::Save(ByteVector& bytes) const
+	{
+		assert(m_ExternalData == nullptr);
+
+		detail::BinarySXMLHeader header;
+		memcpy(header.Magic, detail::c_BinarySXMLMagic, sizeof(detail::c_BinarySXMLMagic));
+		header.Version = detail::c_BinarySXMLVersion;
+		header.CountNodes = m_Nodes.GetSize();
+		header.Reserved = 0;
+		header.DataSize = m_Data.GetSize();
+
+		bytes.Reserve(bytes.GetSize() + sizeof(header) + m_Nodes.GetSizeInBytes() + m_Data.GetSize());
+		bytes.PushBack(reinterpret_cast<const unsigned char*>(&header), sizeof(header));
+		bytes.PushBack(reinterpret_cast<const unsigned char*>(m_Nodes.GetArray()), m_Nodes.GetSizeInBytes());
+		if (m_Data.GetSize() > 0) bytes.PushBack(m_Data.GetArray(), m_Data.GetSize());
+	}
+
+	void BinarySXMLDocument::Load(const unsigned char* data, size_t size)
+	{
+		if (!IsBinarySXML(data, size)) detail::ThrowInvalidBinarySXML();
+
+		detail::BinarySXMLHeader header;
+		memcpy(&header, data, sizeof(header));
+		if (header.Version != detail::c_BinarySXMLVersion || header.CountNodes == 0) detail::ThrowInvalidBinarySXML();
+		std::uint64_t tableSize = static_cast<std::uint64_t>(header.CountNodes) * sizeof(BinarySXMLNode);
+		if (tableSize > size - sizeof(header) || header.DataSize != size - sizeof(header) - tableSize)
+		{
+			detail::ThrowInvalidBinarySXML();
+		}
+
+		m_LastChildren.Clear();
+		m_Data.Clear();
+		m_Nodes.Resize(header.CountNodes);
+		memcpy(m_Nodes.GetArray(), data + sizeof(header), static_cast<size_t>(tableSize));
+		m_ExternalData = data + sizeof(header) + tableSize;
+
+		// The links always point forward, which guarantees that the traversals terminate.
+		for (unsigned i = 0; i < header.CountNodes; i++)
+		{
+			auto& node = m_Nodes[i];
+			auto valueSize = detail::GetBinarySXMLValueSize(node.ValueType);
+			bool isValid = (node.NameOffset + static_cast<std::uint64_t>(node.NameSize) <= header.DataSize
+				&& (node.FirstChild == c_InvalidIndexU || (node.FirstChild > i && node.FirstChild < header.CountNodes))
+				&& (node.NextSibling == c_InvalidIndexU || (node.NextSibling > i && node.NextSibling < header.CountNodes))
+				&& node.ValueType <= BinarySXMLValueType::Double
+				&& node.ValueOffset <= header.DataSize
+				&& (valueSize == 0 || node.ValueCount <= (header.DataSize - node.ValueOffset) / valueSize));
+			if (!isValid)
+			{
+				Clear();
+				detail::ThrowInvalidBinarySXML();
+			}
+		}
+	}
+
+	bool BinarySXMLDocument::IsBinarySXML(const unsigned char* data, size_t size)
+	{
+		return (size >= sizeof(detail::BinarySXMLHeader)
+			&& memcmp(data, detail::c_BinarySXMLMagic, sizeof(detail::c_BinarySXMLMagic)) == 0);
+	}
+}
@@ -0,0 +1,183 @@
+// Core/BinarySXMLDocument.h
+
+#ifndef _CORE_BINARYSXMLDOCUMENT_H_INCLUDED_
+#define _CORE_BINARYSXMLDOCUMENT_H_INCLUDED_
+
+#include <Core/Platform.h>
+#include <Core/DataStructures/SimpleTypeVector.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace Core
+{
+	enum class BinarySXMLValueType : unsigned char
+	{
+		None, Text, Bytes, Bool, Int8, UInt8, Int16, UInt16, Int32, UInt32, Int64, UInt64, Float, Double
+	};
+
+	namespace detail
+	{
+		template <typename T, bool IsEnum = std::is_enum<T>::value>
+		struct BinarySXMLScalar
+		{
+			using Type = T;
+		};
+
+		template <typename T>
+		struct BinarySXMLScalar<T, true>
+		{
+			using Type = std::underlying_type_t<T>;
+		};
+
+		template <typename T>
+		using BinarySXMLScalarType = typename BinarySXMLScalar<T>::Type;
+
+		template <typename T>
+		inline CORE_CONSTEXPR BinarySXMLValueType GetBinarySXMLValueType()
+		{
+			using S = BinarySXMLScalarType<T>;
+			return std::is_same<S, bool>::value ? BinarySXMLValueType::Bool
+				: std::is_floating_point<S>::value
+					? (sizeof(S) == 4 ? BinarySXMLValueType::Float : BinarySXMLValueType::Double)
+				: std::is_signed<S>::value
+					? (sizeof(S) == 1 ? BinarySXMLValueType::Int8
+						: sizeof(S) == 2 ? BinarySXMLValueType::Int16
+						: sizeof(S) == 4 ? BinarySXMLValueType::Int32 : BinarySXMLValueType::Int64)
+					: (sizeof(S) == 1 ? BinarySXMLValueType::UInt8
+						: sizeof(S) == 2 ? BinarySXMLValueType::UInt16
+						: sizeof(S) == 4 ? BinarySXMLValueType::UInt32 : BinarySXMLValueType::UInt64);
+		}
+
+		template <typename SourceType, typename T>
+		inline void ConvertBinarySXMLValues(const unsigned char* source, T* values, size_t count)
+		{
+			for (size_t i = 0; i < count; i++, source += sizeof(SourceType))
+			{
+				SourceType value;
+				memcpy(&value, source, sizeof(SourceType));
+				values[i] = static_cast<T>(static_cast<BinarySXMLScalarType<T>>(value));
+			}
+		}
+	}
+
+	struct BinarySXMLNode
+	{
+		std::uint32_t NameOffset;
+		std::uint16_t NameSize;
+		BinarySXMLValueType ValueType;
+		unsigned char Flags;
+		std::uint32_t GroupSize;		// The number of values which are separated by ',' in the XML form.
+		std::uint32_t FirstChild;
+		std::uint32_t NextSibling;
+		std::uint32_t Reserved;
+		std::uint64_t ValueOffset;
+		std::uint64_t ValueCount;		// The number of values or the size of a text or a byte value.
+	};
+
+	// Binary tree with the structure of the XML documents written by SimpleXMLSerialization.
+	// Numbers are stored as typed arrays and binary data as raw bytes, thus no text conversion
+	// and base64 encoding is necessary. Attributes are stored as flagged child nodes.
+	//
+	// Layout: header (magic, version, node count, data size), node table in creation order, data.
+	// Loading only copies the node table, the names and the values are accessed in-place.
+	class BinarySXMLDocument
+	{
+		SimpleTypeVector<BinarySXMLNode> m_Nodes;
+		SimpleTypeVector<std::uint32_t> m_LastChildren;
+		ByteVector m_Data;
+		const unsigned char* m_ExternalData;
+
+		const unsigned char* GetData() const;
+		std::uint64_t AddData(const void* data, size_t size, size_t alignment);
+		void SetValue(unsigned node, BinarySXMLValueType type, const void* data, size_t size,
+			size_t count, size_t groupSize, size_t alignment);
+		void ThrowNotNumeric(unsigned node) const;
+
+	public:
+
+		static const unsigned c_RootNode = 0;
+		static const unsigned char c_AttributeFlag = 1;
+
+		BinarySXMLDocument();
+
+		void Clear();
+
+		unsigned AddNode(unsigned parent, const char* name, bool isAttribute = false);
+		void SetText(unsigned node, const char* text, size_t size);
+		void SetBytes(unsigned node, const unsigned char* bytes, size_t size);
+
+		template <typename T>
+		inline void SetValues(unsigned node, const T* values, size_t count, size_t groupSize = 1)
+		{
+			static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value,
+				"Only arithmetic and enum types can be stored as typed values.");
+			SetValue(node, detail::GetBinarySXMLValueType<T>(), values, count * sizeof(T), count, groupSize,
+				sizeof(T));
+		}
+
+		unsigned GetCountNodes() const;
+		const BinarySXMLNode& GetNode(unsigned node) const;
+
+		// Iterates over the child nodes including the attributes. Returns c_InvalidIndexU at the end.
+		unsigned GetFirstChild(unsigned node) const;
+		unsigned GetNextSibling(unsigned node) const;
+
+		// Returns the first child element or attribute with the given name or c_InvalidIndexU.
+		unsigned FindChild(unsigned node, const char* name) const;
+		unsigned FindAttribute(unsigned node, const char* name) const;
+
+		bool IsAttribute(unsigned node) const;
+		const char* GetName(unsigned node) const;
+		size_t GetNameSize(unsigned node) const;
+		BinarySXMLValueType GetValueType(unsigned node) const;
+		size_t GetValueCount(unsigned node) const;
+		const unsigned char* GetValueData(unsigned node) const;
+
+		// Formats a numeric or text value as it is written to XML. The vector is not null-terminated.
+		void FormatValue(unsigned node, std::string& text) const;
+		void FormatValue(unsigned node, SimpleTypeVector<char>& text) const;
+
+		// Converts a numeric value to the given type.
+		template <typename T>
+		inline void GetValues(unsigned node, T* values) const
+		{
+			auto type = GetValueType(node);
+			auto source = GetValueData(node);
+			size_t count = GetValueCount(node);
+			if (type == detail::GetBinarySXMLValueType<T>())
+			{
+				if (count > 0) memcpy(values, source, count * sizeof(T));
+				return;
+			}
+			switch (type)
+			{
+			case BinarySXMLValueType::Bool: detail::ConvertBinarySXMLValues<bool>(source, values, count); break;
+			case BinarySXMLValueType::Int8: detail::ConvertBinarySXMLValues<std::int8_t>(source, values, count); break;
+			case BinarySXMLValueType::UInt8: detail::ConvertBinarySXMLValues<std::uint8_t>(source, values, count); break;
+			case BinarySXMLValueType::Int16: detail::ConvertBinarySXMLValues<std::int16_t>(source, values, count); break;
+			case BinarySXMLValueType::UInt16: detail::ConvertBinarySXMLValues<std::uint16_t>(source, values, count); break;
+			case BinarySXMLValueType::Int32: detail::ConvertBinarySXMLValues<std::int32_t>(source, values, count); break;
+			case BinarySXMLValueType::UInt32: detail::ConvertBinarySXMLValues<std::uint32_t>(source, values, count); break;
+			case BinarySXMLValueType::Int64: detail::ConvertBinarySXMLValues<std::int64_t>(source, values, count); break;
+			case BinarySXMLValueType::UInt64: detail::ConvertBinarySXMLValues<std::uint64_t>(source, values, count); break;
+			case BinarySXMLValueType::Float: detail::ConvertBinarySXMLValues<float>(source, values, count); break;
+			case BinarySXMLValueType::Double: detail::ConvertBinarySXMLValues<double>(source, values, count); break;
+			default: ThrowNotNumeric(node);
+			}
+		}
+
+		bool IsNumeric(unsigned node) const;
+
+		void Save(ByteVector& bytes) const;
+
+		// The data must outlive the document or the next call of Load or Clear.
+		void Load(const unsigned char* data, size_t size);
+
+		static bool IsBinarySXML(const unsigned char* data, size_t size);
+	};
+}
+
+#endif
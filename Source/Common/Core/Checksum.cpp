@@ -0,0 +1,203 @@
+// Core/Checksum.cpp
+
+#include <Core/Checksum.h>
+
+#include <cstring>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+#if defined(__SSE4_2__) || defined(__AVX__)
+#define CORE_CHECKSUM_USING_SSE42
+#include <nmmintrin.h>
+#endif
+
+namespace
+{
+#ifndef CORE_CHECKSUM_USING_SSE42
+	const std::uint32_t c_CRC32CPolynomial = 0x82f63b78; // Reversed Castagnoli polynomial.
+
+	struct CRC32CTables
+	{
+		std::uint32_t Tables[8][256];
+
+		CRC32CTables()
+		{
+			for (std::uint32_t i = 0; i < 256; i++)
+			{
+				std::uint32_t crc = i;
+				for (int j = 0; j < 8; j++)
+				{
+					crc = (crc >> 1) ^ ((crc & 1) ? c_CRC32CPolynomial : 0);
+				}
+				Tables[0][i] = crc;
+			}
+			for (std::uint32_t i = 0; i < 256; i++)
+			{
+				for (int k = 1; k < 8; k++)
+				{
+					Tables[k][i] = (Tables[k - 1][i] >> 8) ^ Tables[0][Tables[k - 1][i] & 0xff];
+				}
+			}
+		}
+	};
+
+	const CRC32CTables& GetCRC32CTables()
+	{
+		static CRC32CTables tables;
+		return tables;
+	}
+#endif
+
+	const std::uint64_t c_HashSecret[4] = {
+		0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL };
+
+	// Computes the 128-bit product of a and b, and returns the low part in a and the high part in b.
+	inline void Multiply128(std::uint64_t& a, std::uint64_t& b)
+	{
+#if defined(_MSC_VER) && defined(_M_X64)
+		a = _umul128(a, b, &b);
+#elif defined(__SIZEOF_INT128__)
+		unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+		a = static_cast<std::uint64_t>(product);
+		b = static_cast<std::uint64_t>(product >> 64);
+#else
+		std::uint64_t aHigh = a >> 32, aLow = static_cast<std::uint32_t>(a);
+		std::uint64_t bHigh = b >> 32, bLow = static_cast<std::uint32_t>(b);
+		std::uint64_t high = aHigh * bHigh, middle0 = aHigh * bLow, middle1 = aLow * bHigh, low = aLow * bLow;
+		std::uint64_t t = low + (middle0 << 32);
+		std::uint64_t carry = (t < low);
+		std::uint64_t lowResult = t + (middle1 << 32);
+		carry += (lowResult < t);
+		b = high + (middle0 >> 32) + (middle1 >> 32) + carry;
+		a = lowResult;
+#endif
+	}
+
+	inline std::uint64_t Mix(std::uint64_t a, std::uint64_t b)
+	{
+		Multiply128(a, b);
+		return a ^ b;
+	}
+
+	// Native loads, which are little-endian on the supported platforms.
+	inline std::uint64_t Read8(const unsigned char* p)
+	{
+		std::uint64_t value;
+		memcpy(&value, p, 8);
+		return value;
+	}
+
+	inline std::uint64_t Read4(const unsigned char* p)
+	{
+		std::uint32_t value;
+		memcpy(&value, p, 4);
+		return value;
+	}
+
+	inline std::uint64_t Read3(const unsigned char* p, size_t size)
+	{
+		return (static_cast<std::uint64_t>(p[0]) << 16) | (static_cast<std::uint64_t>(p[size >> 1]) << 8) | p[size - 1];
+	}
+}
+
+namespace Core
+{
+	std::uint32_t ComputeCRC32C(const void* data, size_t size, std::uint32_t crc)
+	{
+		auto bytes = reinterpret_cast<const unsigned char*>(data);
+		crc = ~crc;
+
+#ifdef CORE_CHECKSUM_USING_SSE42
+#if defined(_M_X64) || defined(__x86_64__)
+		std::uint64_t crc64 = crc;
+		for (; size >= 8; size -= 8, bytes += 8)
+		{
+			std::uint64_t word;
+			memcpy(&word, bytes, 8);
+			crc64 = _mm_crc32_u64(crc64, word);
+		}
+		crc = static_cast<std::uint32_t>(crc64);
+#endif
+		for (; size >= 4; size -= 4, bytes += 4)
+		{
+			std::uint32_t word;
+			memcpy(&word, bytes, 4);
+			crc = _mm_crc32_u32(crc, word);
+		}
+		for (; size > 0; size--, bytes++)
+		{
+			crc = _mm_crc32_u8(crc, *bytes);
+		}
+#else
+		auto& t = GetCRC32CTables().Tables;
+		for (; size >= 8; size -= 8, bytes += 8)
+		{
+			// Little-endian load.
+			std::uint32_t low = crc ^ (static_cast<std::uint32_t>(bytes[0]) | (static_cast<std::uint32_t>(bytes[1]) << 8)
+				| (static_cast<std::uint32_t>(bytes[2]) << 16) | (static_cast<std::uint32_t>(bytes[3]) << 24));
+			crc = t[7][low & 0xff] ^ t[6][(low >> 8) & 0xff] ^ t[5][(low >> 16) & 0xff] ^ t[4][low >> 24]
+				^ t[3][bytes[4]] ^ t[2][bytes[5]] ^ t[1][bytes[6]] ^ t[0][bytes[7]];
+		}
+		for (; size > 0; size--, bytes++)
+		{
+			crc = (crc >> 8) ^ t[0][(crc ^ *bytes) & 0xff];
+		}
+#endif
+
+		return ~crc;
+	}
+
+	std::uint64_t ComputeHash64(const void* data, size_t size, std::uint64_t seed)
+	{
+		auto p = reinterpret_cast<const unsigned char*>(data);
+		auto& secret = c_HashSecret;
+		seed ^= Mix(seed ^ secret[0], secret[1]);
+		std::uint64_t a, b;
+		if (size <= 16)
+		{
+			if (size >= 4)
+			{
+				size_t offset = ((size >> 3) << 2);
+				a = (Read4(p) << 32) | Read4(p + offset);
+				b = (Read4(p + size - 4) << 32) | Read4(p + size - 4 - offset);
+			}
+			else if (size > 0)
+			{
+				a = Read3(p, size);
+				b = 0;
+			}
+			else a = b = 0;
+		}
+		else
+		{
+			size_t i = size;
+			if (i >= 48)
+			{
+				std::uint64_t seed1 = seed, seed2 = seed;
+				do
+				{
+					seed = Mix(Read8(p) ^ secret[1], Read8(p + 8) ^ seed);
+					seed1 = Mix(Read8(p + 16) ^ secret[2], Read8(p + 24) ^ seed1);
+					seed2 = Mix(Read8(p + 32) ^ secret[3], Read8(p + 40) ^ seed2);
+					p += 48;
+					i -= 48;
+				} while (i >= 48);
+				seed ^= seed1 ^ seed2;
+			}
+			while (i > 16)
+			{
+				seed = Mix(Read8(p) ^ secret[1], Read8(p + 8) ^ seed);
+				i -= 16;
+				p += 16;
+			}
+			a = Read8(p + i - 16);
+			b = Read8(p + i - 8);
+		}
+		a ^= secret[1];
+		b ^= seed;
+		Multiply128(a, b);
+		return Mix(a ^ secret[0] ^ size, b ^ secret[1]);
+	}
+}
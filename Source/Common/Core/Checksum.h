@@ -0,0 +1,22 @@
+// Core/Checksum.h
+
+#ifndef _CORE_CHECKSUM_H_INCLUDED_
+#define _CORE_CHECKSUM_H_INCLUDED_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Core
+{
+	// Computes the CRC-32C (Castagnoli) checksum of the data. The checksum can be computed incrementally
+	// by passing the result of the previous call as 'crc'. Uses the SSE4.2 CRC32 instruction if the compiler
+	// targets it, otherwise a slicing-by-8 table implementation.
+	std::uint32_t ComputeCRC32C(const void* data, size_t size, std::uint32_t crc = 0);
+
+	// Computes a 64-bit non-cryptographic hash of the data with the wyhash (version 4) algorithm.
+	// Different seeds give independent hash functions. The result doesn't depend on the platform,
+	// thus it can be used in file names and stored data.
+	std::uint64_t ComputeHash64(const void* data, size_t size, std::uint64_t seed = 0);
+}
+
+#endif
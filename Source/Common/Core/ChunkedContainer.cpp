@@ -0,0 +1,252 @@
+// Core/ChunkedContainer.cpp
+
+#include <Core/ChunkedContainer.h>
+
+#include <Core/Constants.h>
+#include <Core/Checksum.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+namespace Core
+{
+	namespace detail
+	{
+		const unsigned char c_ContainerMagic[8] = { 'C', 'O', 'R', 'E', 'C', 'N', 'T', 'R' };
+		const std::uint32_t c_ContainerVersion = 1;
+
+		struct ContainerHeader
+		{
+			unsigned char Magic[8];
+			std::uint32_t ContainerVersion;
+			std::uint32_t ContentVersion;
+			unsigned char Padding[48];
+		};
+
+		struct ContainerFooter
+		{
+			std::uint64_t TableOffset;
+			std::uint32_t CountChunks;
+			std::uint32_t TableCRC32C;
+			std::uint32_t ContentVersion;
+			std::uint32_t FooterCRC32C;		// Checksum of the previous members.
+			unsigned char Magic[8];
+		};
+
+		static_assert(sizeof(ContainerHeader) == 64, "Invalid container header size.");
+		static_assert(sizeof(ContainerFooter) == 32, "Invalid container footer size.");
+		static_assert(sizeof(ChunkInfo) == 32, "Invalid chunk info size.");
+
+		const size_t c_FooterCheckedSize = offsetof(ContainerFooter, FooterCRC32C);
+
+		inline void ThrowInvalidContainer(const char* reason)
+		{
+			std::stringstream ss;
+			ss << "Invalid chunked container: " << reason;
+			throw std::runtime_error(ss.str().c_str());
+		}
+
+		// Checks the header and the footer. Returns nullptr on success, or the reason of the failure.
+		const char* CheckContainer(const unsigned char* data, size_t size,
+			ContainerHeader& header, ContainerFooter& footer)
+		{
+			if (size < sizeof(ContainerHeader) + sizeof(ContainerFooter)) return "the file is too small.";
+			memcpy(&header, data, sizeof(ContainerHeader));
+			memcpy(&footer, data + size - sizeof(ContainerFooter), sizeof(ContainerFooter));
+			if (memcmp(header.Magic, c_ContainerMagic, sizeof(c_ContainerMagic)) != 0
+				|| memcmp(footer.Magic, c_ContainerMagic, sizeof(c_ContainerMagic)) != 0)
+			{
+				return "invalid magic.";
+			}
+			if (header.ContainerVersion != c_ContainerVersion) return "unsupported container version.";
+			if (footer.FooterCRC32C != ComputeCRC32C(&footer, c_FooterCheckedSize)) return "corrupt footer.";
+			if (footer.ContentVersion != header.ContentVersion) return "inconsistent content version.";
+			std::uint64_t tableEnd = footer.TableOffset + static_cast<std::uint64_t>(footer.CountChunks) * sizeof(ChunkInfo);
+			if (footer.TableOffset < sizeof(ContainerHeader) || tableEnd != size - sizeof(ContainerFooter))
+			{
+				return "invalid table of contents location.";
+			}
+			return nullptr;
+		}
+	}
+
+	//////////////////////////////////////// WRITER ////////////////////////////////////////
+
+	ChunkedContainerWriter::ChunkedContainerWriter(OutputSinkSB& sink, std::uint32_t contentVersion)
+		: m_Sink(&sink)
+		, m_Position(0)
+		, m_ContentVersion(contentVersion)
+		, m_IsWritingChunk(false)
+	{
+		detail::ContainerHeader header = {};
+		memcpy(header.Magic, detail::c_ContainerMagic, sizeof(detail::c_ContainerMagic));
+		header.ContainerVersion = detail::c_ContainerVersion;
+		header.ContentVersion = contentVersion;
+		Write(&header, sizeof(header));
+	}
+
+	void ChunkedContainerWriter::Write(const void* data, size_t size)
+	{
+		m_Sink->Write(reinterpret_cast<const unsigned char*>(data), size);
+		m_Position += size;
+	}
+
+	void ChunkedContainerWriter::WritePadding(std::uint32_t alignment)
+	{
+		const unsigned char c_Zeros[64] = {};
+		size_t countPadding = static_cast<size_t>((alignment - m_Position % alignment) % alignment);
+		while (countPadding > 0)
+		{
+			size_t size = (countPadding < sizeof(c_Zeros) ? countPadding : sizeof(c_Zeros));
+			Write(c_Zeros, size);
+			countPadding -= size;
+		}
+	}
+
+	OutputSinkSB& ChunkedContainerWriter::BeginChunk(std::uint32_t id, std::uint32_t alignment)
+	{
+		assert(!m_IsWritingChunk);
+		assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+		WritePadding(alignment);
+
+		auto& chunk = m_Chunks.PushBackPlaceHolder();
+		chunk.Id = id;
+		chunk.Alignment = alignment;
+		chunk.Offset = m_Position;
+		chunk.Size = 0;
+		chunk.CRC32C = 0;
+		chunk.Reserved = 0;
+
+		m_ChunkSink = HashingOutputSinkSB(m_Sink);
+		m_IsWritingChunk = true;
+		return m_ChunkSink;
+	}
+
+	void ChunkedContainerWriter::EndChunk()
+	{
+		assert(m_IsWritingChunk);
+		auto& chunk = m_Chunks.GetLastElement();
+		chunk.Size = m_ChunkSink.GetCountBytes();
+		chunk.CRC32C = m_ChunkSink.GetCRC32C();
+		m_Position += chunk.Size;
+		m_IsWritingChunk = false;
+	}
+
+	void ChunkedContainerWriter::Finish()
+	{
+		assert(!m_IsWritingChunk);
+
+		WritePadding(sizeof(std::uint64_t));
+
+		detail::ContainerFooter footer = {};
+		footer.TableOffset = m_Position;
+		footer.CountChunks = static_cast<std::uint32_t>(m_Chunks.GetSize());
+		footer.TableCRC32C = ComputeCRC32C(m_Chunks.GetArray(), m_Chunks.GetSizeInBytes());
+		footer.ContentVersion = m_ContentVersion;
+		footer.FooterCRC32C = ComputeCRC32C(&footer, detail::c_FooterCheckedSize);
+		memcpy(footer.Magic, detail::c_ContainerMagic, sizeof(detail::c_ContainerMagic));
+
+		Write(m_Chunks.GetArray(), m_Chunks.GetSizeInBytes());
+		Write(&footer, sizeof(footer));
+	}
+
+	//////////////////////////////////////// READER ////////////////////////////////////////
+
+	ChunkedContainerReader::ChunkedContainerReader()
+		: m_Data(nullptr)
+		, m_Size(0)
+		, m_ContentVersion(0)
+	{
+	}
+
+	ChunkedContainerReader::ChunkedContainerReader(const unsigned char* data, size_t size)
+	{
+		Open(data, size);
+	}
+
+	void ChunkedContainerReader::Open(const unsigned char* data, size_t size)
+	{
+		detail::ContainerHeader header;
+		detail::ContainerFooter footer;
+		auto error = detail::CheckContainer(data, size, header, footer);
+		if (error != nullptr) detail::ThrowInvalidContainer(error);
+
+		auto table = data + footer.TableOffset;
+		size_t tableSize = static_cast<size_t>(footer.CountChunks) * sizeof(ChunkInfo);
+		if (ComputeCRC32C(table, tableSize) != footer.TableCRC32C)
+		{
+			detail::ThrowInvalidContainer("corrupt table of contents.");
+		}
+
+		m_Chunks.Resize(footer.CountChunks);
+		memcpy(m_Chunks.GetArray(), table, tableSize);
+		for (unsigned i = 0; i < footer.CountChunks; i++)
+		{
+			auto& chunk = m_Chunks[i];
+			if (chunk.Offset < sizeof(detail::ContainerHeader) || chunk.Offset > footer.TableOffset
+				|| chunk.Size > footer.TableOffset - chunk.Offset)
+			{
+				detail::ThrowInvalidContainer("chunk out of bounds.");
+			}
+		}
+
+		m_Data = data;
+		m_Size = size;
+		m_ContentVersion = header.ContentVersion;
+	}
+
+	bool ChunkedContainerReader::IsValid(const unsigned char* data, size_t size, std::uint32_t contentVersion)
+	{
+		detail::ContainerHeader header;
+		detail::ContainerFooter footer;
+		return (detail::CheckContainer(data, size, header, footer) == nullptr
+			&& header.ContentVersion == contentVersion);
+	}
+
+	std::uint32_t ChunkedContainerReader::GetContentVersion() const
+	{
+		return m_ContentVersion;
+	}
+
+	unsigned ChunkedContainerReader::GetCountChunks() const
+	{
+		return static_cast<unsigned>(m_Chunks.GetSize());
+	}
+
+	const ChunkInfo& ChunkedContainerReader::GetChunkInfo(unsigned chunkIndex) const
+	{
+		return m_Chunks[chunkIndex];
+	}
+
+	unsigned ChunkedContainerReader::FindChunk(std::uint32_t id) const
+	{
+		unsigned countChunks = GetCountChunks();
+		for (unsigned i = 0; i < countChunks; i++)
+		{
+			if (m_Chunks[i].Id == id) return i;
+		}
+		return c_InvalidIndexU;
+	}
+
+	ArrayView<unsigned char> ChunkedContainerReader::GetChunkData(unsigned chunkIndex) const
+	{
+		auto& chunk = m_Chunks[chunkIndex];
+		return ArrayView<unsigned char>(m_Data + chunk.Offset, static_cast<size_t>(chunk.Size));
+	}
+
+	bool ChunkedContainerReader::IsChunkIntact(unsigned chunkIndex) const
+	{
+		auto data = GetChunkData(chunkIndex);
+		return (ComputeCRC32C(data.GetArray(), data.GetSize()) == m_Chunks[chunkIndex].CRC32C);
+	}
+
+	ArrayView<unsigned char> ChunkedContainerReader::GetVerifiedChunkData(unsigned chunkIndex) const
+	{
+		if (!IsChunkIntact(chunkIndex)) detail::ThrowInvalidContainer("corrupt chunk.");
+		return GetChunkData(chunkIndex);
+	}
+}
@@ -0,0 +1,102 @@
+// Core/ChunkedContainer.h
+
+#ifndef _CORE_CHUNKEDCONTAINER_H_INCLUDED_
+#define _CORE_CHUNKEDCONTAINER_H_INCLUDED_
+
+#include <Core/Platform.h>
+#include <Core/DataStructures/SimpleTypeVector.hpp>
+#include <Core/DataStructures/ArrayView.hpp>
+#include <Core/StreamBinarySerialization.h>
+
+#include <cstdint>
+
+namespace Core
+{
+	inline CORE_CONSTEXPR std::uint32_t MakeFourCC(char c0, char c1, char c2, char c3)
+	{
+		return static_cast<std::uint32_t>(static_cast<unsigned char>(c0))
+			| (static_cast<std::uint32_t>(static_cast<unsigned char>(c1)) << 8)
+			| (static_cast<std::uint32_t>(static_cast<unsigned char>(c2)) << 16)
+			| (static_cast<std::uint32_t>(static_cast<unsigned char>(c3)) << 24);
+	}
+
+	// Versioned container of independently readable, checksummed chunks.
+	//
+	// Layout: header (magic, container version, content version), aligned chunks,
+	// table of contents, footer (table of contents location and checksum, content version, magic).
+	// The header and the footer allow detecting outdated and truncated files in O(1), the table of contents
+	// is protected by a CRC-32C checksum, and each chunk has its own CRC-32C checksum, which is verified
+	// when the chunk is read.
+	struct ChunkInfo
+	{
+		std::uint32_t Id;
+		std::uint32_t Alignment;
+		std::uint64_t Offset;
+		std::uint64_t Size;
+		std::uint32_t CRC32C;
+		std::uint32_t Reserved;
+	};
+
+	class ChunkedContainerWriter
+	{
+		OutputSinkSB* m_Sink;
+		HashingOutputSinkSB m_ChunkSink;
+		std::uint64_t m_Position;
+		std::uint32_t m_ContentVersion;
+		SimpleTypeVector<ChunkInfo> m_Chunks;
+		bool m_IsWritingChunk;
+
+		void Write(const void* data, size_t size);
+		void WritePadding(std::uint32_t alignment);
+
+	public:
+
+		// Writes the header of the container.
+		ChunkedContainerWriter(OutputSinkSB& sink, std::uint32_t contentVersion);
+
+		// Starts a chunk and returns the sink to write its data to. The alignment must be a power of two.
+		// The chunk starts at an aligned position, thus if the alignment is a multiple of c_AlignmentSB,
+		// the aligned arrays of a StreamSerializerSB with zero start position remain aligned in the file.
+		OutputSinkSB& BeginChunk(std::uint32_t id, std::uint32_t alignment = static_cast<std::uint32_t>(c_AlignmentSB));
+		void EndChunk();
+
+		// Writes the table of contents and the footer. The sink is not flushed.
+		void Finish();
+	};
+
+	// Reads a container from memory, typically from a memory-mapped file. The memory must outlive the reader.
+	class ChunkedContainerReader
+	{
+		const unsigned char* m_Data;
+		size_t m_Size;
+		std::uint32_t m_ContentVersion;
+		SimpleTypeVector<ChunkInfo> m_Chunks;
+
+	public:
+
+		ChunkedContainerReader();
+		ChunkedContainerReader(const unsigned char* data, size_t size);
+
+		// Throws if the container is invalid.
+		void Open(const unsigned char* data, size_t size);
+
+		// Checks the header and the footer in O(1). It doesn't verify the chunk checksums.
+		static bool IsValid(const unsigned char* data, size_t size, std::uint32_t contentVersion);
+
+		std::uint32_t GetContentVersion() const;
+
+		unsigned GetCountChunks() const;
+		const ChunkInfo& GetChunkInfo(unsigned chunkIndex) const;
+
+		// Returns the index of the first chunk with the given id or c_InvalidIndexU.
+		unsigned FindChunk(std::uint32_t id) const;
+
+		ArrayView<unsigned char> GetChunkData(unsigned chunkIndex) const;
+		bool IsChunkIntact(unsigned chunkIndex) const;
+
+		// Returns the chunk's data after verifying its checksum. Throws if the chunk is corrupt.
+		ArrayView<unsigned char> GetVerifiedChunkData(unsigned chunkIndex) const;
+	};
+}
+
+#endif
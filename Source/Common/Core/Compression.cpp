@@ -0,0 +1,181 @@
+// Core/Compression.cpp
+
+#include <Core/Compression.h>
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+	const unsigned c_MinMatchLength = 4;
+	const size_t c_MaxOffset = 65535;
+	const size_t c_LastLiteralsLength = 5;	// The last bytes are always stored as literals.
+	const unsigned c_HashLog = 14;
+
+	inline std::uint32_t Read32(const unsigned char* p)
+	{
+		std::uint32_t value;
+		memcpy(&value, p, 4);
+		return value;
+	}
+
+	inline std::uint32_t Hash(std::uint32_t value)
+	{
+		return (value * 2654435761U) >> (32 - c_HashLog);
+	}
+
+	inline unsigned char* WriteLength(unsigned char* op, size_t length)
+	{
+		for (; length >= 255; length -= 255) *op++ = 255;
+		*op++ = static_cast<unsigned char>(length);
+		return op;
+	}
+
+	inline unsigned char* WriteSequence(unsigned char* op, const unsigned char* literals, size_t countLiterals,
+		size_t offset, size_t matchLength)
+	{
+		bool hasMatch = (matchLength > 0);
+		size_t matchCode = (hasMatch ? matchLength - c_MinMatchLength : 0);
+
+		auto token = op++;
+		*token = static_cast<unsigned char>(((countLiterals < 15 ? countLiterals : 15) << 4)
+			| (matchCode < 15 ? matchCode : 15));
+		if (countLiterals >= 15) op = WriteLength(op, countLiterals - 15);
+		if (countLiterals > 0) memcpy(op, literals, countLiterals);
+		op += countLiterals;
+		if (hasMatch)
+		{
+			*op++ = static_cast<unsigned char>(offset & 0xff);
+			*op++ = static_cast<unsigned char>(offset >> 8);
+			if (matchCode >= 15) op = WriteLength(op, matchCode - 15);
+		}
+		return op;
+	}
+
+	inline void ThrowCorruptBlock()
+	{
+		throw std::runtime_error("The compressed block is corrupt.");
+	}
+
+	inline size_t ReadLength(const unsigned char*& ip, const unsigned char* iEnd)
+	{
+		size_t length = 0;
+		unsigned char b;
+		do
+		{
+			if (ip >= iEnd) ThrowCorruptBlock();
+			b = *ip++;
+			length += b;
+		} while (b == 255);
+		return length;
+	}
+}
+
+namespace Core
+{
+	size_t GetMaxCompressedSizeLZ(size_t size)
+	{
+		return size + size / 255 + 16;
+	}
+
+	void CompressLZ(const unsigned char* input, size_t size, ByteVector& output)
+	{
+		size_t startSize = output.GetSize();
+		output.Resize(startSize + GetMaxCompressedSizeLZ(size));
+		unsigned char* op = output.GetArray() + startSize;
+
+		size_t anchor = 0;
+		if (size > c_LastLiteralsLength + c_MinMatchLength)
+		{
+			// Positions + 1, zero is empty.
+			std::vector<std::uint32_t> hashTable(size_t(1) << c_HashLog, 0);
+
+			size_t matchLimit = size - c_LastLiteralsLength;
+			size_t position = 0;
+			while (position + c_MinMatchLength <= matchLimit)
+			{
+				auto value = Read32(input + position);
+				auto& entry = hashTable[Hash(value)];
+				size_t reference = static_cast<size_t>(entry) - 1;
+				entry = static_cast<std::uint32_t>(position + 1);
+
+				if (reference != static_cast<size_t>(-1) && position - reference <= c_MaxOffset
+					&& Read32(input + reference) == value)
+				{
+					size_t matchLength = c_MinMatchLength;
+					while (position + matchLength < matchLimit
+						&& input[reference + matchLength] == input[position + matchLength])
+					{
+						matchLength++;
+					}
+
+					op = WriteSequence(op, input + anchor, position - anchor, position - reference, matchLength);
+					position += matchLength;
+					anchor = position;
+				}
+				else
+				{
+					position++;
+				}
+			}
+		}
+
+		// The last sequence contains only literals.
+		op = WriteSequence(op, input + anchor, size - anchor, 0, 0);
+
+		output.Resize(static_cast<size_t>(op - output.GetArray()));
+	}
+
+	void DecompressLZ(const unsigned char* input, size_t inputSize, unsigned char* output, size_t outputSize)
+	{
+		auto ip = input;
+		auto iEnd = input + inputSize;
+		auto op = output;
+		auto oEnd = output + outputSize;
+
+		while (true)
+		{
+			if (ip >= iEnd) ThrowCorruptBlock();
+			unsigned token = *ip++;
+
+			size_t countLiterals = token >> 4;
+			if (countLiterals == 15) countLiterals += ReadLength(ip, iEnd);
+			if (countLiterals > static_cast<size_t>(iEnd - ip) || countLiterals > static_cast<size_t>(oEnd - op))
+			{
+				ThrowCorruptBlock();
+			}
+			memcpy(op, ip, countLiterals);
+			ip += countLiterals;
+			op += countLiterals;
+
+			// The last sequence has no match.
+			if (ip == iEnd) break;
+
+			if (iEnd - ip < 2) ThrowCorruptBlock();
+			size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+			ip += 2;
+			if (offset == 0 || offset > static_cast<size_t>(op - output)) ThrowCorruptBlock();
+
+			size_t matchLength = token & 15;
+			if (matchLength == 15) matchLength += ReadLength(ip, iEnd);
+			matchLength += c_MinMatchLength;
+			if (matchLength > static_cast<size_t>(oEnd - op)) ThrowCorruptBlock();
+
+			auto match = op - offset;
+			if (offset >= matchLength)
+			{
+				memcpy(op, match, matchLength);
+				op += matchLength;
+			}
+			else
+			{
+				// Overlapping match: repeating the last 'offset' bytes.
+				for (size_t i = 0; i < matchLength; i++) *op++ = *match++;
+			}
+		}
+
+		if (op != oEnd) ThrowCorruptBlock();
+	}
+}
@@ -0,0 +1,24 @@
+// Core/Compression.h
+
+#ifndef _CORE_COMPRESSION_H_INCLUDED_
+#define _CORE_COMPRESSION_H_INCLUDED_
+
+#include <Core/DataStructures/SimpleTypeVector.hpp>
+
+namespace Core
+{
+	// Fast LZ77 block compression without entropy coding. The compressed block is a sequence of
+	// (literals, match) pairs, where the matches reference the previous 64 KB of the decompressed data.
+	// The block format is similar to LZ4's, but the two are not compatible.
+
+	// Returns an upper bound of the compressed size of 'size' bytes.
+	size_t GetMaxCompressedSizeLZ(size_t size);
+
+	// Appends the compressed data to 'output'.
+	void CompressLZ(const unsigned char* input, size_t size, ByteVector& output);
+
+	// Decompresses a block to exactly 'outputSize' bytes. Throws if the block is corrupt.
+	void DecompressLZ(const unsigned char* input, size_t inputSize, unsigned char* output, size_t outputSize);
+}
+
+#endif
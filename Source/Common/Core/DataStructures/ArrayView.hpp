@@ -0,0 +1,65 @@
+// Core/DataStructures/ArrayView.hpp
+
+#ifndef _CORE_ARRAYVIEW_HPP_INCLUDED_
+#define _CORE_ARRAYVIEW_HPP_INCLUDED_
+
+#include <cassert>
+#include <cstddef>
+
+namespace Core
+{
+	// Non-owning read-only view of a contiguous array. The viewed memory must outlive the view.
+	template <typename T>
+	class ArrayView
+	{
+		const T* m_Array;
+		size_t m_Size;
+
+	public:
+
+		ArrayView()
+			: m_Array(nullptr)
+			, m_Size(0)
+		{
+		}
+
+		ArrayView(const T* pArray, size_t size)
+			: m_Array(pArray)
+			, m_Size(size)
+		{
+		}
+
+		inline const T* GetArray() const
+		{
+			return m_Array;
+		}
+
+		inline const T* GetEndPointer() const
+		{
+			return m_Array + m_Size;
+		}
+
+		inline size_t GetSize() const
+		{
+			return m_Size;
+		}
+
+		inline size_t GetSizeInBytes() const
+		{
+			return m_Size * sizeof(T);
+		}
+
+		inline bool IsEmpty() const
+		{
+			return (m_Size == 0);
+		}
+
+		inline const T& operator[](size_t index) const
+		{
+			assert(index < m_Size);
+			return m_Array[index];
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,446 @@
+// Core/DataStructures/BitSet.cpp
+
+#include <Core/DataStructures/BitSet.h>
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define CORE_BITSET_USING_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#define CORE_BITSET_USING_AVX2
+#include <immintrin.h>
+#endif
+
+using namespace Core;
+
+namespace
+{
+	struct AndOperation
+	{
+		static inline std::uint64_t Apply(std::uint64_t a, std::uint64_t b) { return a & b; }
+#ifdef CORE_BITSET_USING_SSE2
+		static inline __m128i Apply(__m128i a, __m128i b) { return _mm_and_si128(a, b); }
+#endif
+#ifdef CORE_BITSET_USING_AVX2
+		static inline __m256i Apply(__m256i a, __m256i b) { return _mm256_and_si256(a, b); }
+#endif
+	};
+
+	struct OrOperation
+	{
+		static inline std::uint64_t Apply(std::uint64_t a, std::uint64_t b) { return a | b; }
+#ifdef CORE_BITSET_USING_SSE2
+		static inline __m128i Apply(__m128i a, __m128i b) { return _mm_or_si128(a, b); }
+#endif
+#ifdef CORE_BITSET_USING_AVX2
+		static inline __m256i Apply(__m256i a, __m256i b) { return _mm256_or_si256(a, b); }
+#endif
+	};
+
+	struct XorOperation
+	{
+		static inline std::uint64_t Apply(std::uint64_t a, std::uint64_t b) { return a ^ b; }
+#ifdef CORE_BITSET_USING_SSE2
+		static inline __m128i Apply(__m128i a, __m128i b) { return _mm_xor_si128(a, b); }
+#endif
+#ifdef CORE_BITSET_USING_AVX2
+		static inline __m256i Apply(__m256i a, __m256i b) { return _mm256_xor_si256(a, b); }
+#endif
+	};
+
+	struct AndNotOperation
+	{
+		static inline std::uint64_t Apply(std::uint64_t a, std::uint64_t b) { return a & ~b; }
+#ifdef CORE_BITSET_USING_SSE2
+		static inline __m128i Apply(__m128i a, __m128i b) { return _mm_andnot_si128(b, a); }
+#endif
+#ifdef CORE_BITSET_USING_AVX2
+		static inline __m256i Apply(__m256i a, __m256i b) { return _mm256_andnot_si256(b, a); }
+#endif
+	};
+
+	template <typename Operation>
+	void ApplyBinaryOperation(std::uint64_t* target, const std::uint64_t* source, size_t countWords)
+	{
+		size_t i = 0;
+#if defined(CORE_BITSET_USING_AVX2)
+		for (; i + 4 <= countWords; i += 4)
+		{
+			auto pTarget = reinterpret_cast<__m256i*>(target + i);
+			auto a = _mm256_loadu_si256(pTarget);
+			auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+			_mm256_storeu_si256(pTarget, Operation::Apply(a, b));
+		}
+#elif defined(CORE_BITSET_USING_SSE2)
+		for (; i + 2 <= countWords; i += 2)
+		{
+			auto pTarget = reinterpret_cast<__m128i*>(target + i);
+			auto a = _mm_loadu_si128(pTarget);
+			auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+			_mm_storeu_si128(pTarget, Operation::Apply(a, b));
+		}
+#endif
+		for (; i < countWords; i++)
+		{
+			target[i] = Operation::Apply(target[i], source[i]);
+		}
+	}
+
+	inline size_t GetCountWordsForBits(size_t countBits)
+	{
+		return ((countBits + 63) >> 6);
+	}
+}
+
+BitSet::BitSet()
+	: m_CountBits(0)
+{
+}
+
+BitSet::BitSet(size_t countBits, bool value)
+	: m_CountBits(0)
+{
+	Resize(countBits);
+	if (value) SetAll();
+}
+
+void BitSet::ClearUnusedBits()
+{
+	size_t countUsedBitsInLastWord = (m_CountBits & 63);
+	if (countUsedBitsInLastWord != 0)
+	{
+		m_Words.GetLastElement() &= ((1ULL << countUsedBitsInLastWord) - 1);
+	}
+}
+
+size_t BitSet::GetSize() const
+{
+	return m_CountBits;
+}
+
+size_t BitSet::GetCountWords() const
+{
+	return m_Words.GetSize();
+}
+
+bool BitSet::IsEmpty() const
+{
+	return (m_CountBits == 0);
+}
+
+const std::uint64_t* BitSet::GetWords() const
+{
+	return m_Words.GetArray();
+}
+
+std::uint64_t* BitSet::GetWords()
+{
+	return m_Words.GetArray();
+}
+
+void BitSet::Resize(size_t countBits)
+{
+	size_t oldCountWords = m_Words.GetSize();
+	size_t countWords = GetCountWordsForBits(countBits);
+	m_Words.Resize(countWords);
+	for (size_t i = oldCountWords; i < countWords; i++) m_Words[i] = 0;
+	m_CountBits = countBits;
+	ClearUnusedBits();
+}
+
+void BitSet::Clear()
+{
+	m_Words.Clear();
+	m_CountBits = 0;
+}
+
+void BitSet::SetAll()
+{
+	m_Words.SetByte(0xff);
+	ClearUnusedBits();
+}
+
+void BitSet::ResetAll()
+{
+	m_Words.SetByte(0);
+}
+
+void BitSet::And(const BitSet& other)
+{
+	assert(m_CountBits == other.m_CountBits);
+	ApplyBinaryOperation<AndOperation>(m_Words.GetArray(), other.m_Words.GetArray(), m_Words.GetSize());
+}
+
+void BitSet::Or(const BitSet& other)
+{
+	assert(m_CountBits == other.m_CountBits);
+	ApplyBinaryOperation<OrOperation>(m_Words.GetArray(), other.m_Words.GetArray(), m_Words.GetSize());
+}
+
+void BitSet::Xor(const BitSet& other)
+{
+	assert(m_CountBits == other.m_CountBits);
+	ApplyBinaryOperation<XorOperation>(m_Words.GetArray(), other.m_Words.GetArray(), m_Words.GetSize());
+}
+
+void BitSet::AndNot(const BitSet& other)
+{
+	assert(m_CountBits == other.m_CountBits);
+	ApplyBinaryOperation<AndNotOperation>(m_Words.GetArray(), other.m_Words.GetArray(), m_Words.GetSize());
+}
+
+void BitSet::Not()
+{
+	size_t countWords = m_Words.GetSize();
+	for (size_t i = 0; i < countWords; i++) m_Words[i] = ~m_Words[i];
+	ClearUnusedBits();
+}
+
+size_t BitSet::PopCount() const
+{
+	// Four independent accumulators to break the dependency chain.
+	size_t counts[4] = {};
+	size_t countWords = m_Words.GetSize();
+	auto words = m_Words.GetArray();
+	size_t i = 0;
+	for (; i + 4 <= countWords; i += 4)
+	{
+		counts[0] += PopCount64(words[i]);
+		counts[1] += PopCount64(words[i + 1]);
+		counts[2] += PopCount64(words[i + 2]);
+		counts[3] += PopCount64(words[i + 3]);
+	}
+	for (; i < countWords; i++) counts[0] += PopCount64(words[i]);
+	return counts[0] + counts[1] + counts[2] + counts[3];
+}
+
+bool BitSet::IsAnySet() const
+{
+	size_t countWords = m_Words.GetSize();
+	for (size_t i = 0; i < countWords; i++)
+	{
+		if (m_Words[i] != 0) return true;
+	}
+	return false;
+}
+
+size_t BitSet::FindNextSet(size_t start) const
+{
+	if (start >= m_CountBits) return c_InvalidBitIndex;
+	size_t wordIndex = (start >> 6);
+	std::uint64_t word = m_Words[wordIndex] & (~0ULL << (start & 63));
+	size_t countWords = m_Words.GetSize();
+	while (true)
+	{
+		if (word != 0) return (wordIndex << 6) + FindFirstSet64(word);
+		if (++wordIndex == countWords) return c_InvalidBitIndex;
+		word = m_Words[wordIndex];
+	}
+}
+
+size_t BitSet::FindFirstSet() const
+{
+	return FindNextSet(0);
+}
+
+void BitSet::GetSetBitIndices(SimpleTypeVectorU<unsigned>& indices) const
+{
+	indices.ReserveAdditionalWithGrowing(static_cast<unsigned>(PopCount()));
+	ForEachSetBit([&indices](size_t index) { indices.UnsafePushBack(static_cast<unsigned>(index)); });
+}
+
+void BitSet::SetIndices(const unsigned* indices, size_t countIndices)
+{
+	if (countIndices == 0) return;
+	size_t maxIndex = *std::max_element(indices, indices + countIndices);
+	if (maxIndex >= m_CountBits) Resize(maxIndex + 1);
+	for (size_t i = 0; i < countIndices; i++) Set(indices[i]);
+}
+
+void BitSet::SetFromByteMask(const unsigned char* mask, size_t countBytes)
+{
+	Resize(countBytes);
+	ResetAll();
+	size_t i = 0;
+#ifdef CORE_BITSET_USING_SSE2
+	// Comparing 16 bytes against zero and gathering the byte sign bits.
+	auto zero = _mm_setzero_si128();
+	for (; i + 16 <= countBytes; i += 16)
+	{
+		auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask + i));
+		auto isZero = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, zero)));
+		std::uint64_t bits = (~isZero & 0xffffU);
+		m_Words[i >> 6] |= (bits << (i & 63));
+	}
+#endif
+	for (; i < countBytes; i++)
+	{
+		if (mask[i] != 0) Set(i);
+	}
+}
+
+void BitSet::ToByteMask(unsigned char* mask) const
+{
+	for (size_t i = 0; i < m_CountBits; i++)
+	{
+		mask[i] = (Get(i) ? 1 : 0);
+	}
+}
+
+bool BitSet::operator==(const BitSet& other) const
+{
+	return (m_CountBits == other.m_CountBits && m_Words == other.m_Words);
+}
+
+bool BitSet::operator!=(const BitSet& other) const
+{
+	return !(*this == other);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+
+BitSetRankSelect::BitSetRankSelect()
+	: m_BitSet(nullptr)
+	, m_CountSetBits(0)
+{
+}
+
+BitSetRankSelect::BitSetRankSelect(const BitSet& bitSet)
+{
+	Build(bitSet);
+}
+
+void BitSetRankSelect::Build(const BitSet& bitSet)
+{
+	m_BitSet = &bitSet;
+	size_t countWords = bitSet.GetCountWords();
+	size_t countBlocks = (countWords + c_WordsPerBlock - 1) / c_WordsPerBlock;
+	auto words = bitSet.GetWords();
+	m_BlockRanks.Resize(countBlocks + 1);
+	size_t rank = 0;
+	for (size_t i = 0; i < countBlocks; i++)
+	{
+		m_BlockRanks[i] = rank;
+		size_t end = std::min(countWords, (i + 1) * c_WordsPerBlock);
+		for (size_t j = i * c_WordsPerBlock; j < end; j++) rank += PopCount64(words[j]);
+	}
+	m_BlockRanks[countBlocks] = rank;
+	m_CountSetBits = rank;
+}
+
+size_t BitSetRankSelect::GetCountSetBits() const
+{
+	return m_CountSetBits;
+}
+
+size_t BitSetRankSelect::Rank(size_t index) const
+{
+	assert(m_BitSet != nullptr && index <= m_BitSet->GetSize());
+	auto words = m_BitSet->GetWords();
+	size_t wordIndex = (index >> 6);
+	size_t blockIndex = wordIndex / c_WordsPerBlock;
+	size_t rank = m_BlockRanks[blockIndex];
+	for (size_t j = blockIndex * c_WordsPerBlock; j < wordIndex; j++) rank += PopCount64(words[j]);
+	size_t bitInWord = (index & 63);
+	if (bitInWord != 0) rank += PopCount64(words[wordIndex] & ((1ULL << bitInWord) - 1));
+	return rank;
+}
+
+size_t BitSetRankSelect::Select(size_t k) const
+{
+	assert(m_BitSet != nullptr);
+	if (k >= m_CountSetBits) return BitSet::c_InvalidBitIndex;
+
+	// Finding the last block whose rank is <= k.
+	auto blocksBegin = m_BlockRanks.GetArray();
+	auto blocksEnd = blocksBegin + (m_BlockRanks.GetSize() - 1);
+	size_t blockIndex = static_cast<size_t>(std::upper_bound(blocksBegin, blocksEnd, k) - blocksBegin) - 1;
+
+	auto words = m_BitSet->GetWords();
+	size_t countWords = m_BitSet->GetCountWords();
+	size_t remaining = k - m_BlockRanks[blockIndex];
+	for (size_t j = blockIndex * c_WordsPerBlock; j < countWords; j++)
+	{
+		unsigned count = PopCount64(words[j]);
+		if (remaining < count) return (j << 6) + SelectInWord64(words[j], static_cast<unsigned>(remaining));
+		remaining -= count;
+	}
+	assert(false);
+	return BitSet::c_InvalidBitIndex;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	inline unsigned UnpackElement(const unsigned char* packed, size_t countPackedBytes,
+		size_t bitIndex, std::uint64_t mask)
+	{
+		size_t byteIndex = (bitIndex >> 3);
+		std::uint64_t value = 0;
+		memcpy(&value, packed + byteIndex, std::min<size_t>(8, countPackedBytes - byteIndex));
+		return static_cast<unsigned>((value >> (bitIndex & 7)) & mask);
+	}
+}
+
+void Core::UnpackBits(const unsigned char* packed, unsigned countBitsPerElement,
+	size_t startElement, size_t countElements, unsigned* output)
+{
+	assert(countBitsPerElement >= 1 && countBitsPerElement <= 32);
+
+	size_t startBit = startElement * countBitsPerElement;
+	size_t endBit = (startElement + countElements) * countBitsPerElement;
+	size_t countPackedBytes = (endBit + 7) >> 3;
+
+	// Byte aligned widths: direct widening.
+	if ((startBit & 7) == 0 && (countBitsPerElement & 7) == 0)
+	{
+		auto source = packed + (startBit >> 3);
+		switch (countBitsPerElement)
+		{
+		case 8: for (size_t i = 0; i < countElements; i++) output[i] = source[i]; return;
+		case 16: for (size_t i = 0; i < countElements; i++) { std::uint16_t v; memcpy(&v, source + 2 * i, 2); output[i] = v; } return;
+		case 32: memcpy(output, source, countElements * sizeof(unsigned)); return;
+		default: break;
+		}
+	}
+
+	std::uint64_t mask = (countBitsPerElement == 32 ? 0xffffffffULL : ((1ULL << countBitsPerElement) - 1));
+	size_t i = 0;
+
+#ifdef CORE_BITSET_USING_AVX2
+	// Gathering 8 elements with 32-bit loads: each element has to fit into the 4 loaded bytes
+	// after the in-byte shift, i.e. 7 + countBits <= 32.
+	if (countBitsPerElement <= 25)
+	{
+		auto laneBitOffsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+			_mm256_set1_epi32(static_cast<int>(countBitsPerElement)));
+		auto vMask = _mm256_set1_epi32(static_cast<int>(mask));
+		auto seven = _mm256_set1_epi32(7);
+		size_t bitsPer8 = 8 * static_cast<size_t>(countBitsPerElement);
+		for (size_t bitIndex = startBit; i + 8 <= countElements; i += 8, bitIndex += bitsPer8)
+		{
+			// The last lane must not read beyond the packed data.
+			size_t lastByte = ((bitIndex + 7 * countBitsPerElement) >> 3);
+			if (lastByte + 4 > countPackedBytes) break;
+
+			auto baseByte = packed + (bitIndex >> 3);
+			auto bitOffsets = _mm256_add_epi32(laneBitOffsets, _mm256_set1_epi32(static_cast<int>(bitIndex & 7)));
+			auto byteOffsets = _mm256_srli_epi32(bitOffsets, 3);
+			auto shifts = _mm256_and_si256(bitOffsets, seven);
+			auto values = _mm256_i32gather_epi32(reinterpret_cast<const int*>(baseByte), byteOffsets, 1);
+			values = _mm256_and_si256(_mm256_srlv_epi32(values, shifts), vMask);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), values);
+		}
+	}
+#endif
+
+	for (; i < countElements; i++)
+	{
+		output[i] = UnpackElement(packed, countPackedBytes, startBit + i * countBitsPerElement, mask);
+	}
+}
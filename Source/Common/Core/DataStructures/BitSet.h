@@ -0,0 +1,190 @@
+// Core/DataStructures/BitSet.h
+
+#ifndef _CORE_BITSET_H_INCLUDED_
+#define _CORE_BITSET_H_INCLUDED_
+
+#include <Core/Platform.h>
+#include <Core/DataStructures/SimpleTypeVector.hpp>
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Core
+{
+	inline unsigned PopCount64(std::uint64_t word)
+	{
+#if defined(_MSC_VER) && defined(_M_X64)
+		return static_cast<unsigned>(__popcnt64(word));
+#elif defined(__GNUC__)
+		return static_cast<unsigned>(__builtin_popcountll(word));
+#else
+		word = word - ((word >> 1) & 0x5555555555555555ULL);
+		word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+		word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+		return static_cast<unsigned>((word * 0x0101010101010101ULL) >> 56);
+#endif
+	}
+
+	// Returns the index of the lowest set bit. The word must not be zero.
+	inline unsigned FindFirstSet64(std::uint64_t word)
+	{
+		assert(word != 0);
+#if defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index;
+		_BitScanForward64(&index, word);
+		return static_cast<unsigned>(index);
+#elif defined(__GNUC__)
+		return static_cast<unsigned>(__builtin_ctzll(word));
+#else
+		unsigned index = 0;
+		while ((word & 1) == 0) { word >>= 1; index++; }
+		return index;
+#endif
+	}
+
+	// Returns the index of the k-th (0-based) set bit of the word. The word must have more than k set bits.
+	inline unsigned SelectInWord64(std::uint64_t word, unsigned k)
+	{
+		assert(k < PopCount64(word));
+		for (unsigned i = 0; i < k; i++) word &= word - 1;
+		return FindFirstSet64(word);
+	}
+
+	// Fixed-size set of bits stored in 64-bit words. The bulk operations process 128 bits per
+	// instruction with SSE2 (256 bits with AVX2, if the compiler targets it).
+	// The bits above the size in the last word are always kept zero.
+	class BitSet
+	{
+		SimpleTypeVector<std::uint64_t> m_Words;
+		size_t m_CountBits;
+
+		void ClearUnusedBits();
+
+	public:
+
+		static const size_t c_InvalidBitIndex = static_cast<size_t>(-1);
+
+		BitSet();
+		explicit BitSet(size_t countBits, bool value = false);
+
+		size_t GetSize() const;
+		size_t GetCountWords() const;
+		bool IsEmpty() const;
+
+		const std::uint64_t* GetWords() const;
+		std::uint64_t* GetWords();
+
+		// Sets the size. The new bits are cleared.
+		void Resize(size_t countBits);
+		void Clear();
+
+		inline bool Get(size_t index) const
+		{
+			assert(index < m_CountBits);
+			return ((m_Words[index >> 6] >> (index & 63)) & 1) != 0;
+		}
+
+		inline void Set(size_t index)
+		{
+			assert(index < m_CountBits);
+			m_Words[index >> 6] |= (1ULL << (index & 63));
+		}
+
+		inline void Reset(size_t index)
+		{
+			assert(index < m_CountBits);
+			m_Words[index >> 6] &= ~(1ULL << (index & 63));
+		}
+
+		inline void Set(size_t index, bool value)
+		{
+			if (value) Set(index); else Reset(index);
+		}
+
+		void SetAll();
+		void ResetAll();
+
+		// Bulk operations. The other set must have the same size.
+		void And(const BitSet& other);
+		void Or(const BitSet& other);
+		void Xor(const BitSet& other);
+		void AndNot(const BitSet& other); // this = this & ~other.
+		void Not();
+
+		size_t PopCount() const;
+		bool IsAnySet() const;
+
+		// Returns the index of the first set bit with index >= 'start'
+		// or c_InvalidBitIndex if there is no such bit.
+		size_t FindNextSet(size_t start) const;
+		size_t FindFirstSet() const;
+
+		// Calls 'function(index)' for each set bit in increasing order.
+		template <typename Function>
+		inline void ForEachSetBit(Function&& function) const
+		{
+			size_t countWords = m_Words.GetSize();
+			for (size_t i = 0; i < countWords; i++)
+			{
+				std::uint64_t word = m_Words[i];
+				while (word != 0)
+				{
+					function((i << 6) + FindFirstSet64(word));
+					word &= word - 1;
+				}
+			}
+		}
+
+		// Appends the indices of the set bits to the index vector in increasing order.
+		void GetSetBitIndices(SimpleTypeVectorU<unsigned>& indices) const;
+
+		// Sets the bits of the given indices. The set is grown if necessary.
+		void SetIndices(const unsigned* indices, size_t countIndices);
+
+		// Conversion from and to a byte mask, where each non-zero byte represents a set bit.
+		void SetFromByteMask(const unsigned char* mask, size_t countBytes);
+		void ToByteMask(unsigned char* mask) const;
+
+		bool operator==(const BitSet& other) const;
+		bool operator!=(const BitSet& other) const;
+	};
+
+	// Rank/select support structure over a bit set. It stores the number of set bits before
+	// each 512-bit block, thus Rank is O(1) and Select is O(log(n)). The structure has to be
+	// rebuilt after the bit set is modified.
+	class BitSetRankSelect
+	{
+		static const unsigned c_WordsPerBlock = 8;
+
+		const BitSet* m_BitSet;
+		SimpleTypeVector<std::uint64_t> m_BlockRanks;
+		size_t m_CountSetBits;
+
+	public:
+
+		BitSetRankSelect();
+		explicit BitSetRankSelect(const BitSet& bitSet);
+
+		void Build(const BitSet& bitSet);
+
+		size_t GetCountSetBits() const;
+
+		// Returns the number of set bits in the range [0, index).
+		size_t Rank(size_t index) const;
+
+		// Returns the index of the k-th (0-based) set bit or BitSet::c_InvalidBitIndex,
+		// if there are not more than k set bits.
+		size_t Select(size_t k) const;
+	};
+
+	// Unpacks 'countElements' values of 'countBitsPerElement' bits into unsigned values.
+	// The packed layout is the one of BitVector: element i starts at bit i * countBitsPerElement,
+	// bits are stored from the least significant bit of each byte. The count of bits must be in [1, 32].
+	void UnpackBits(const unsigned char* packed, unsigned countBitsPerElement,
+		size_t startElement, size_t countElements, unsigned* output);
+}
+
+#endif
@@ -1,6 +1,7 @@
 // Core/DataStructures/BitVector.cpp
 
 #include <Core/DataStructures/BitVector.h>
+#include <Core/DataStructures/BitSet.h>
 
 #include <stdexcept>
 
@@ -138,7 +139,6 @@ void BitVector::UpdateVector()
 		if (totalBytes > m_ContainedVector.size())
 		{
 			m_ContainedVector.resize(totalBytes);
-			m_ReservedCountElements = totalBytes;
 			m_Vector = &m_ContainedVector[0];
 		}
 	}
@@ -163,6 +163,12 @@ size_t BitVector::Get(size_t index) const
 	return value;
 }
 
+void BitVector::GetRange(size_t start, size_t count, unsigned* output) const
+{
+	assert(start + count <= m_CountElements);
+	UnpackBits(m_Vector, m_CountBitsPerElement, start, count, output);
+}
+
 void BitVector::Set(size_t index, size_t value)
 {
 	size_t startBit = index * m_CountBitsPerElement;
@@ -56,6 +56,9 @@ namespace Core
 
 		size_t Get(size_t index) const;
 
+		// Unpacks the elements [start, start + count) into the output array.
+		void GetRange(size_t start, size_t count, unsigned* output) const;
+
 		void Add(size_t value);
 
 		void Resize(size_t size);
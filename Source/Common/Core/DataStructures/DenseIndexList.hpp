@@ -0,0 +1,145 @@
+// Core/DataStructures/DenseIndexList.hpp
+
+#ifndef _CORE_DENSEINDEXLIST_HPP_INCLUDED_
+#define _CORE_DENSEINDEXLIST_HPP_INCLUDED_
+
+#include <Core/DataStructures/SimpleTypeVector.hpp>
+
+namespace Core
+{
+	// Sparse set of the live indices of an unordered vector. The live indices are stored
+	// in a packed array, thus iterating them costs time proportional to the number of live elements
+	// and not to the number of slots. Add and Remove are O(1), Remove doesn't keep the order.
+	template <typename SizeType>
+	class DenseIndexList
+	{
+		SimpleTypeVector<SizeType, SizeType> m_Indices;		// Packed live indices.
+		SimpleTypeVector<SizeType, SizeType> m_Positions;	// Position in 'm_Indices' for each slot.
+
+	public:
+
+		inline SizeType GetSize() const
+		{
+			return m_Indices.GetSize();
+		}
+
+		inline const SizeType* GetArray() const
+		{
+			return m_Indices.GetArray();
+		}
+
+		inline const SizeType* GetEndPointer() const
+		{
+			return m_Indices.GetEndPointer();
+		}
+
+		inline void Add(SizeType index)
+		{
+			m_Positions.SetAtIndex(index, m_Indices.GetSize());
+			m_Indices.PushBack(index);
+		}
+
+		inline void Remove(SizeType index)
+		{
+			assert(m_Indices[m_Positions[index]] == index);
+
+			SizeType position = m_Positions[index];
+			SizeType lastIndex = m_Indices.PopBackReturn();
+			if (lastIndex != index)
+			{
+				m_Indices[position] = lastIndex;
+				m_Positions[lastIndex] = position;
+			}
+		}
+
+		inline void Clear()
+		{
+			m_Indices.Clear();
+			m_Positions.Clear();
+		}
+
+		// Sets the list to the index range [0, size - 1].
+		inline void SetToRange(SizeType size)
+		{
+			m_Indices.Resize(size);
+			m_Positions.Resize(size);
+			for (SizeType i = 0; i < size; i++)
+			{
+				m_Indices[i] = i;
+				m_Positions[i] = i;
+			}
+		}
+
+		// Rebuilds the list from a validity predicate over the slots [0, countSlots - 1].
+		template <typename IsValidFunction>
+		inline void Rebuild(SizeType countSlots, IsValidFunction&& isValid)
+		{
+			m_Indices.ClearAndReserve(countSlots);
+			m_Positions.Resize(countSlots);
+			for (SizeType i = 0; i < countSlots; i++)
+			{
+				if (isValid(i))
+				{
+					m_Positions[i] = m_Indices.GetSize();
+					m_Indices.UnsafePushBack(i);
+				}
+			}
+		}
+
+		inline void ShrinkToFit()
+		{
+			m_Indices.ShrinkToFit();
+			m_Positions.ShrinkToFit();
+		}
+	};
+
+	// Iterator over the elements addressed by a dense index list.
+	template <typename U, typename SizeType>
+	class DenseIterator
+	{
+		U* m_PData;
+		const SizeType* m_PIndex;
+
+	public:
+
+		DenseIterator(U* pData, const SizeType* pIndex)
+			: m_PData(pData)
+			, m_PIndex(pIndex)
+		{
+		}
+
+		inline bool operator==(const DenseIterator& other) const
+		{
+			return (m_PIndex == other.m_PIndex);
+		}
+
+		inline bool operator!=(const DenseIterator& other) const
+		{
+			return (m_PIndex != other.m_PIndex);
+		}
+
+		inline DenseIterator& operator++()
+		{
+			++m_PIndex;
+			return *this;
+		}
+
+		inline U& operator*() const
+		{
+			return m_PData[*m_PIndex];
+		}
+
+		inline U* operator->() const
+		{
+			return m_PData + *m_PIndex;
+		}
+
+		// Returns the index of the current element in the unordered vector.
+		inline SizeType GetIndex() const
+		{
+			return *m_PIndex;
+		}
+	};
+}
+
+#endif
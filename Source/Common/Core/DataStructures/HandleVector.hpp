@@ -0,0 +1,290 @@
+// Core/DataStructures/HandleVector.hpp
+
+#ifndef _CORE_HANDLEVECTOR_HPP_INCLUDED_
+#define _CORE_HANDLEVECTOR_HPP_INCLUDED_
+
+#include <Core/Constants.h>
+#include <Core/Platform.h>
+#include <Core/DataStructures/SimpleTypeVector.hpp>
+#include <Core/SimpleBinarySerialization.hpp>
+
+#include <vector>
+#include <utility>
+
+namespace Core
+{
+	// Generational handle: the index addresses a slot in the indirection table, the generation
+	// is compared against the slot's current generation, thus stale handles are detected in O(1).
+	struct Handle
+	{
+		unsigned Index;
+		unsigned Generation;
+
+		Handle()
+			: Index(c_InvalidIndexU)
+			, Generation(0)
+		{
+		}
+
+		Handle(unsigned index, unsigned generation)
+			: Index(index)
+			, Generation(generation)
+		{
+		}
+
+		inline bool IsInvalid() const
+		{
+			return (Index == c_InvalidIndexU);
+		}
+
+		inline unsigned long long ToU64() const
+		{
+			return ((static_cast<unsigned long long>(Generation) << 32) | Index);
+		}
+
+		static inline Handle FromU64(unsigned long long value)
+		{
+			return Handle(static_cast<unsigned>(value & 0xffffffffULL), static_cast<unsigned>(value >> 32));
+		}
+
+		inline bool operator==(const Handle& other) const
+		{
+			NumericalEqualCompareBlock(Index);
+			NumericalEqualCompareBlock(Generation);
+			return true;
+		}
+
+		inline bool operator!=(const Handle& other) const
+		{
+			return !(*this == other);
+		}
+
+		inline bool operator<(const Handle& other) const
+		{
+			NumericalLessCompareBlock(Index);
+			NumericalLessCompareBlock(Generation);
+			return false;
+		}
+	};
+
+	// Container handing out generational handles instead of raw indices.
+	//
+	// The elements are stored densely: removing an element moves the last element into its place,
+	// thus iteration over the live elements never touches removed slots. The handles remain stable,
+	// since they address the indirection table and not the element storage.
+	// Operations Add, Remove, IsValid and access by handle are O(1).
+	template <typename T>
+	class HandleVector
+	{
+		struct Slot
+		{
+			unsigned DenseIndex;	// Index into 'm_Data' or the next free slot, if the slot is unused.
+			unsigned Generation;
+		};
+
+		std::vector<T> m_Data;
+		SimpleTypeVectorU<unsigned> m_DenseToSlot;
+		SimpleTypeVectorU<Slot> m_Slots;
+		unsigned m_FirstFreeSlot;
+
+		inline Handle AllocateSlot(unsigned denseIndex)
+		{
+			unsigned slotIndex;
+			if (m_FirstFreeSlot == c_InvalidIndexU)
+			{
+				slotIndex = m_Slots.GetSize();
+				auto& slot = m_Slots.PushBackPlaceHolder();
+				slot.Generation = 1;
+			}
+			else
+			{
+				slotIndex = m_FirstFreeSlot;
+				m_FirstFreeSlot = m_Slots[slotIndex].DenseIndex;
+			}
+			auto& slot = m_Slots[slotIndex];
+			slot.DenseIndex = denseIndex;
+			m_DenseToSlot.PushBack(slotIndex);
+			return Handle(slotIndex, slot.Generation);
+		}
+
+		inline void ReleaseSlot(unsigned slotIndex)
+		{
+			auto& slot = m_Slots[slotIndex];
+
+			// Generation 0 is never used, therefore a zero-initialized handle is never valid.
+			if (++slot.Generation == 0) slot.Generation = 1;
+
+			slot.DenseIndex = m_FirstFreeSlot;
+			m_FirstFreeSlot = slotIndex;
+		}
+
+	public:
+
+		HandleVector()
+			: m_FirstFreeSlot(c_InvalidIndexU)
+		{
+		}
+
+		inline unsigned GetSize() const
+		{
+			return static_cast<unsigned>(m_Data.size());
+		}
+
+		inline bool IsEmpty() const
+		{
+			return m_Data.empty();
+		}
+
+		// Returns the size of the indirection table, i.e. the maximum number of elements
+		// which were alive at the same time.
+		inline unsigned GetCountSlots() const
+		{
+			return m_Slots.GetSize();
+		}
+
+		inline void Reserve(unsigned size)
+		{
+			m_Data.reserve(size);
+			m_DenseToSlot.Reserve(size);
+			m_Slots.Reserve(size);
+		}
+
+		inline bool IsValid(Handle handle) const
+		{
+			return (handle.Index < m_Slots.GetSize()
+				&& m_Slots[handle.Index].Generation == handle.Generation
+				&& handle.Generation != 0);
+		}
+
+		template <typename... _T>
+		inline Handle Add(_T&& ... element)
+		{
+			auto denseIndex = static_cast<unsigned>(m_Data.size());
+			m_Data.emplace_back(std::forward<_T>(element)...);
+			return AllocateSlot(denseIndex);
+		}
+
+		inline void Remove(Handle handle)
+		{
+			assert(IsValid(handle));
+
+			unsigned denseIndex = m_Slots[handle.Index].DenseIndex;
+			unsigned lastDenseIndex = static_cast<unsigned>(m_Data.size()) - 1;
+			if (denseIndex != lastDenseIndex)
+			{
+				unsigned movedSlotIndex = m_DenseToSlot[lastDenseIndex];
+				m_Data[denseIndex] = std::move(m_Data[lastDenseIndex]);
+				m_DenseToSlot[denseIndex] = movedSlotIndex;
+				m_Slots[movedSlotIndex].DenseIndex = denseIndex;
+			}
+			m_Data.pop_back();
+			m_DenseToSlot.PopBack();
+			ReleaseSlot(handle.Index);
+		}
+
+		// Removes the element if the handle is valid and returns whether the element was removed.
+		inline bool TryRemove(Handle handle)
+		{
+			if (!IsValid(handle)) return false;
+			Remove(handle);
+			return true;
+		}
+
+		inline void Clear()
+		{
+			// The slots are kept to guarantee that the handles become invalid.
+			unsigned size = m_DenseToSlot.GetSize();
+			for (unsigned i = 0; i < size; i++)
+			{
+				ReleaseSlot(m_DenseToSlot[i]);
+			}
+			m_Data.clear();
+			m_DenseToSlot.Clear();
+		}
+
+		inline T& operator[](Handle handle)
+		{
+			assert(IsValid(handle));
+			return m_Data[m_Slots[handle.Index].DenseIndex];
+		}
+
+		inline const T& operator[](Handle handle) const
+		{
+			assert(IsValid(handle));
+			return m_Data[m_Slots[handle.Index].DenseIndex];
+		}
+
+		// Returns nullptr if the handle is stale.
+		inline T* TryGet(Handle handle)
+		{
+			return (IsValid(handle) ? &m_Data[m_Slots[handle.Index].DenseIndex] : nullptr);
+		}
+
+		inline const T* TryGet(Handle handle) const
+		{
+			return (IsValid(handle) ? &m_Data[m_Slots[handle.Index].DenseIndex] : nullptr);
+		}
+
+		// Returns the index of the element in the dense storage. Note that this index
+		// changes when an other element is removed.
+		inline unsigned GetDenseIndex(Handle handle) const
+		{
+			assert(IsValid(handle));
+			return m_Slots[handle.Index].DenseIndex;
+		}
+
+		inline Handle GetHandle(unsigned denseIndex) const
+		{
+			assert(denseIndex < m_Data.size());
+			unsigned slotIndex = m_DenseToSlot[denseIndex];
+			return Handle(slotIndex, m_Slots[slotIndex].Generation);
+		}
+
+		inline bool IsSlotUsed(unsigned slotIndex) const
+		{
+			unsigned denseIndex = m_Slots[slotIndex].DenseIndex;
+			return (denseIndex < m_DenseToSlot.GetSize() && m_DenseToSlot[denseIndex] == slotIndex);
+		}
+
+		// Dense access to the live elements. The arrays are parallel: the i-th element
+		// belongs to the slot GetSlotIndices()[i].
+		inline T* GetArray()
+		{
+			return m_Data.data();
+		}
+
+		inline const T* GetArray() const
+		{
+			return m_Data.data();
+		}
+
+		inline const unsigned* GetSlotIndices() const
+		{
+			return m_DenseToSlot.GetArray();
+		}
+
+		inline void ShrinkToFit()
+		{
+			m_Data.shrink_to_fit();
+			m_DenseToSlot.ShrinkToFit();
+		}
+
+		void SerializeSB(Core::ByteVector& bytes) const
+		{
+			Core::SerializeSB(bytes, m_Data);
+			Core::SerializeSB(bytes, m_DenseToSlot);
+			Core::SerializeSB(bytes, m_Slots);
+			Core::SerializeSB(bytes, m_FirstFreeSlot);
+		}
+
+		void DeserializeSB(const unsigned char*& bytes)
+		{
+			Core::DeserializeSB(bytes, m_Data);
+			Core::DeserializeSB(bytes, m_DenseToSlot);
+			Core::DeserializeSB(bytes, m_Slots);
+			Core::DeserializeSB(bytes, m_FirstFreeSlot);
+		}
+	};
+}
+
+#endif
@@ -5,6 +5,7 @@
 #include <Core/System/SimpleIO.h>
 #include <Core/Constants.h>
 #include <Core/String.hpp>
+#include <Core/StringSearch.h>
 
 #include <External/rapidxml/rapidxml.hpp>
 #include <External/rapidxml/rapidxml_print.hpp>
@@ -15,6 +16,7 @@
 #include <queue>
 #include <sstream>
 #include <stdexcept>
+#include <string_view>
 
 using namespace Core;
 
@@ -49,58 +51,147 @@ const char* Properties::GetString(unsigned index) const
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-unsigned Properties::CreateNode(const char* name, unsigned parent)
+Properties::Properties()
+	: m_StructureVersion(1)
 {
-	Node node;
-	node.Name = AddString(name);
-	node.Parent = parent;
-	return m_Nodes.Add(std::move(node));
 }
 
-unsigned Properties::CreateNode(const char* name, unsigned nameSize, unsigned parent)
+////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+unsigned Properties::InternSymbol(std::string_view name)
+{
+	unsigned symbol = FindSymbol(name);
+	if (symbol == c_InvalidIndexU)
+	{
+		symbol = static_cast<unsigned>(m_SymbolNames.size());
+		m_SymbolNames.emplace_back(name);
+		m_SymbolHashes.insert({ GetHash64(name), symbol });
+	}
+	return symbol;
+}
+
+unsigned Properties::FindSymbol(std::string_view name) const
+{
+	auto range = m_SymbolHashes.equal_range(GetHash64(name));
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		if (std::string_view(m_SymbolNames[it->second]) == name) return it->second;
+	}
+	return c_InvalidIndexU;
+}
+
+const char* Properties::GetSymbolName(unsigned symbol) const
+{
+	return m_SymbolNames[symbol].c_str();
+}
+
+// Calls the function with the parts of the path between the dots.
+template <typename Function>
+inline void ForEachPathPart(const char* path, Function&& function)
+{
+	size_t length = strlen(path);
+	while (true)
+	{
+		size_t partLength = FindCharacter(path, length, '.');
+		function(std::string_view(path, partLength));
+		if (partLength == length) break;
+		path += partLength + 1;
+		length -= partLength + 1;
+	}
+}
+
+void Properties::GetPathSymbols(const char* path, IndexVectorU& symbols) const
+{
+	symbols.Clear();
+	ForEachPathPart(path, [this, &symbols](std::string_view part) { symbols.PushBack(FindSymbol(part)); });
+}
+
+void Properties::InternPathSymbols(const char* path, IndexVectorU& symbols)
+{
+	symbols.Clear();
+	ForEachPathPart(path, [this, &symbols](std::string_view part) { symbols.PushBack(InternSymbol(part)); });
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+inline std::uint64_t GetIndexKey(unsigned nodeIndex, unsigned nameSymbol)
+{
+	return (static_cast<std::uint64_t>(nodeIndex) << 32) | nameSymbol;
+}
+
+unsigned Properties::GetFirstChild(unsigned nodeIndex, unsigned nameSymbol) const
+{
+	auto it = m_ChildIndex.find(GetIndexKey(nodeIndex, nameSymbol));
+	return (it == m_ChildIndex.end() ? c_InvalidIndexU : it->second);
+}
+
+unsigned Properties::GetFirstProperty(unsigned nodeIndex, unsigned nameSymbol) const
+{
+	auto it = m_PropertyIndex.find(GetIndexKey(nodeIndex, nameSymbol));
+	return (it == m_PropertyIndex.end() ? c_InvalidIndexU : it->second);
+}
+
+// Appends the element to the end of the chain of the elements with the same name, keeping the insertion order.
+template <typename ContainerType>
+inline void LinkWithSameName(std::unordered_map<std::uint64_t, unsigned>& index, ContainerType& elements,
+	std::uint64_t key, unsigned elementIndex)
+{
+	auto result = index.insert({ key, elementIndex });
+	if (!result.second)
+	{
+		unsigned lastIndex = result.first->second;
+		while (elements[lastIndex].NextWithSameName != c_InvalidIndexU) lastIndex = elements[lastIndex].NextWithSameName;
+		elements[lastIndex].NextWithSameName = elementIndex;
+	}
+}
+
+unsigned Properties::CreateNode(unsigned nameSymbol, unsigned parent)
 {
 	Node node;
-	node.Name = AddString(name, nameSize);
+	node.Name = nameSymbol;
+	node.NextWithSameName = c_InvalidIndexU;
 	node.Parent = parent;
-	return m_Nodes.Add(std::move(node));
+	unsigned nodeIndex = m_Nodes.Add(std::move(node));
+	if (parent == c_InvalidIndexU) m_Roots.Add(nodeIndex);
+	else m_Nodes[parent].Children.Add(nodeIndex);
+	LinkWithSameName(m_ChildIndex, m_Nodes, GetIndexKey(parent, nameSymbol), nodeIndex);
+	++m_StructureVersion;
+	return nodeIndex;
 }
 
-unsigned Properties::CreateProperty(const char* name, const char* value)
+unsigned Properties::CreateProperty(unsigned nameSymbol, const char* value, unsigned nodeIndex)
 {
 	Property property;
-	property.Name = AddString(name);
+	property.Name = nameSymbol;
 	property.Value = AddString(value);
-	return m_Properties.Add(std::move(property));
+	property.NextWithSameName = c_InvalidIndexU;
+	property.ValueVersion = 1;
+	unsigned propertyIndex = m_Properties.Add(std::move(property));
+	m_Nodes[nodeIndex].Properties.Add(propertyIndex);
+	LinkWithSameName(m_PropertyIndex, m_Properties, GetIndexKey(nodeIndex, nameSymbol), propertyIndex);
+	++m_StructureVersion;
+	return propertyIndex;
 }
 
-inline bool Properties::IsMatchingNodeName(unsigned nameIndex, const char* path, const char* dotSearchRes) const
-{
-	return (strncmp(GetString(nameIndex), path, static_cast<unsigned>(dotSearchRes - path)) == 0);
-}
-
-void Properties::Traverse(const char* path, IndexVectorU& propertyIndices,
+void Properties::Traverse(const unsigned* symbols, unsigned countSymbols, IndexVectorU& propertyIndices,
 	unsigned& longestMatchSize, unsigned& longestMatchIndex) const
 {
 	struct TraverseData
 	{
 		unsigned NodeIndex;
-		unsigned PathStart;
 		unsigned MatchSize;
 	};
 
-	auto pRootDot = strchr(path, '.');
-	assert(pRootDot != nullptr); // No direct properties are supported.
+	assert(countSymbols > 1); // No direct properties are supported.
+	unsigned countNodeSymbols = countSymbols - 1;
 
-	auto roots = const_cast<decltype(m_Roots)&>(m_Roots);
-	auto it = roots.GetBeginIterator();
-	auto end = roots.GetEndIterator();
 	std::queue<TraverseData> indices;
-	for (; it != end; ++it)
+	for (unsigned rootIndex = GetFirstChild(c_InvalidIndexU, symbols[0]); rootIndex != c_InvalidIndexU;
+		rootIndex = m_Nodes[rootIndex].NextWithSameName)
 	{
-		if (IsMatchingNodeName(m_Nodes[*it].Name, path, pRootDot))
-		{
-			indices.push({ *it, static_cast<unsigned>(pRootDot - path) + 1, 1 });
-		}
+		indices.push({ rootIndex, 1 });
 	}
 
 	longestMatchSize = 0;
@@ -110,9 +201,7 @@ void Properties::Traverse(const char* path, IndexVectorU& propertyIndices,
 	{
 		auto& traverseData = indices.front();
 		unsigned nodeIndex = traverseData.NodeIndex;
-		auto currentPath = path + traverseData.PathStart;
 		unsigned matchSize = traverseData.MatchSize;
-		unsigned nextMatchSize = matchSize + 1;
 		indices.pop();
 
 		if (matchSize > longestMatchSize)
@@ -121,110 +210,109 @@ void Properties::Traverse(const char* path, IndexVectorU& propertyIndices,
 			longestMatchIndex = nodeIndex;
 		}
 
-		auto& nodeData = m_Nodes[nodeIndex];
-
-		auto pDot = strchr(currentPath, '.');
-		if (pDot == nullptr)
+		if (matchSize == countNodeSymbols)
 		{
-			auto& properties = nodeData.Properties;
-			for (unsigned i = 0; i < properties.GetSize(); i++)
+			for (unsigned propertyIndex = GetFirstProperty(nodeIndex, symbols[countNodeSymbols]);
+				propertyIndex != c_InvalidIndexU; propertyIndex = m_Properties[propertyIndex].NextWithSameName)
 			{
-				unsigned propertyIndex = properties[i];
-				auto& property = m_Properties[propertyIndex];
-
-				if (strcmp(GetString(property.Name), currentPath) == 0)
-				{
-					propertyIndices.PushBack(propertyIndex);
-				}
+				propertyIndices.PushBack(propertyIndex);
 			}
 		}
 		else
 		{
-			auto& children = nodeData.Children;
-			for (unsigned i = 0; i < children.GetSize(); i++)
+			for (unsigned childNodeIndex = GetFirstChild(nodeIndex, symbols[matchSize]);
+				childNodeIndex != c_InvalidIndexU; childNodeIndex = m_Nodes[childNodeIndex].NextWithSameName)
 			{
-				unsigned childNodeIndex = children[i];
-				auto& childNode = m_Nodes[childNodeIndex];
-				if (IsMatchingNodeName(childNode.Name, currentPath, pDot))
-				{
-					indices.push({ childNodeIndex, static_cast<unsigned>(pDot - path) + 1, nextMatchSize });
-				}
+				indices.push({ childNodeIndex, matchSize + 1 });
 			}
 		}
 	}
 }
 
-inline const char* SkipNChar(const char* str, char ch, unsigned n)
+void Properties::AddPropertyOnNonExistingPath(const unsigned* symbols, unsigned countSymbols,
+	unsigned matchSize, unsigned nodeIndex, const char* value)
 {
-	const char* result = str;
-	for (; n > 0; --n, result = strchr(result, ch) + 1);
-	return result;
+	assert(countSymbols > 1); // No direct property is supported.
+	assert(nodeIndex != c_InvalidIndexU || matchSize == 0);
+
+	unsigned countNodeSymbols = countSymbols - 1;
+	for (unsigned i = matchSize; i < countNodeSymbols; i++)
+	{
+		nodeIndex = CreateNode(symbols[i], nodeIndex);
+	}
+	CreateProperty(symbols[countNodeSymbols], value, nodeIndex);
 }
 
-void Properties::AddPropertyOnNonExistingPath(const char* path, unsigned matchSize, unsigned nodeIndex,
-	const char* value)
+void Properties::SetProperty(const unsigned* symbols, unsigned countSymbols, const char* value)
 {
-	if (nodeIndex == c_InvalidIndexU)
+	IndexVectorU propertyIndices;
+	unsigned longestMatchSize, longestMatchIndex;
+	Traverse(symbols, countSymbols, propertyIndices, longestMatchSize, longestMatchIndex);
+
+	if (propertyIndices.GetSize() > 0)
 	{
-		assert(matchSize == 0);
-		auto pRootDot = strchr(path, '.');
-		assert(pRootDot != nullptr); // No direct property is supported.
-		nodeIndex = CreateNode(path, static_cast<unsigned>(pRootDot - path), c_InvalidIndexU);
-		path = pRootDot + 1;
-		m_Roots.Add(nodeIndex);
+		assert(propertyIndices.GetSize() == 1);
+		auto& property = m_Properties[propertyIndices[0]];
+		ModifyString(property.Value, value);
+		++property.ValueVersion;
 	}
-
-	auto currentPath = SkipNChar(path, '.', matchSize);
-	while (true)
+	else
 	{
-		auto pDot = strchr(currentPath, '.');
-		if (pDot == nullptr)
-		{
-			m_Nodes[nodeIndex].Properties.Add(CreateProperty(currentPath, value));
-			break;
-		}
-		else
-		{
-			unsigned childNodeIndex = CreateNode(currentPath, static_cast<unsigned>(pDot - currentPath), nodeIndex);
-			m_Nodes[nodeIndex].Children.Add(childNodeIndex);
-			nodeIndex = childNodeIndex;
-			currentPath = pDot + 1;
-		}
+		AddPropertyOnNonExistingPath(symbols, countSymbols, longestMatchSize, longestMatchIndex, value);
 	}
 }
 
+const char* Properties::GetPropertyValueStrByIndex(unsigned propertyIndex) const
+{
+	return GetString(m_Properties[propertyIndex].Value);
+}
+
+unsigned Properties::GetPropertyValueVersion(unsigned propertyIndex) const
+{
+	return m_Properties[propertyIndex].ValueVersion;
+}
+
 const char* Properties::GetPropertyValueStr(const char* path) const
 {
+	IndexVectorU symbols;
+	GetPathSymbols(path, symbols);
+
 	IndexVectorU propertyIndices;
 	unsigned longestMatchSize, longestMatchIndex;
-	Traverse(path, propertyIndices, longestMatchSize, longestMatchIndex);
+	Traverse(symbols.GetArray(), symbols.GetSize(), propertyIndices, longestMatchSize, longestMatchIndex);
 
 	assert(propertyIndices.GetSize() <= 1);
 
 	if (propertyIndices.GetSize() == 0) return nullptr;
-	return GetString(m_Properties[propertyIndices[0]].Value);
+	return GetPropertyValueStrByIndex(propertyIndices[0]);
 }
 
 bool Properties::HasProperty(const char* path) const
 {
+	IndexVectorU symbols;
+	GetPathSymbols(path, symbols);
+
 	IndexVectorU propertyIndices;
 	unsigned longestMatchSize, longestMatchIndex;
-	Traverse(path, propertyIndices, longestMatchSize, longestMatchIndex);
+	Traverse(symbols.GetArray(), symbols.GetSize(), propertyIndices, longestMatchSize, longestMatchIndex);
 
 	return (propertyIndices.GetSize() > 0);
 }
 
 unsigned Properties::GetPropertyValuesStr(const char* path, const char** pPath, unsigned maxResultCount)
 {
+	IndexVectorU symbols;
+	GetPathSymbols(path, symbols);
+
 	IndexVectorU propertyIndices;
 	unsigned longestMatchSize, longestMatchIndex;
-	Traverse(path, propertyIndices, longestMatchSize, longestMatchIndex);
+	Traverse(symbols.GetArray(), symbols.GetSize(), propertyIndices, longestMatchSize, longestMatchIndex);
 
 	unsigned countResults = propertyIndices.GetSize();
 	unsigned countStoredResults = std::min(countResults, maxResultCount);
 	for (unsigned i = 0; i < countStoredResults; i++)
 	{
-		pPath[i] = GetString(m_Properties[propertyIndices[i]].Value);
+		pPath[i] = GetPropertyValueStrByIndex(propertyIndices[i]);
 	}
 
 	return countResults;
@@ -232,28 +320,78 @@ unsigned Properties::GetPropertyValuesStr(const char* path, const char** pPath,
 
 void Properties::AddProperty(const char* path, const char* value)
 {
+	IndexVectorU symbols;
+	InternPathSymbols(path, symbols);
+
 	IndexVectorU propertyIndices;
 	unsigned longestMatchSize, longestMatchIndex;
-	Traverse(path, propertyIndices, longestMatchSize, longestMatchIndex);
+	Traverse(symbols.GetArray(), symbols.GetSize(), propertyIndices, longestMatchSize, longestMatchIndex);
 
 	// Adding a new property, even if one or more old properties with the same path exists.
-	AddPropertyOnNonExistingPath(path, longestMatchSize, longestMatchIndex, value);
+	AddPropertyOnNonExistingPath(symbols.GetArray(), symbols.GetSize(), longestMatchSize, longestMatchIndex, value);
 }
 
 void Properties::SetProperty(const char* path, const char* value)
 {
-	IndexVectorU propertyIndices;
-	unsigned longestMatchSize, longestMatchIndex;
-	Traverse(path, propertyIndices, longestMatchSize, longestMatchIndex);
+	IndexVectorU symbols;
+	InternPathSymbols(path, symbols);
+	SetProperty(symbols.GetArray(), symbols.GetSize(), value);
+}
 
-	if (propertyIndices.GetSize() > 0)
+////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+PropertyPath Properties::CompilePath(const char* path)
+{
+	PropertyPath result;
+	result.m_Owner = this;
+	result.m_Path = path;
+	InternPathSymbols(path, result.m_Symbols);
+	return result;
+}
+
+unsigned Properties::ResolvePropertyIndex(const PropertyPath& path) const
+{
+	assert(path.m_Owner == this);
+	if (path.m_StructureVersion != m_StructureVersion)
 	{
-		assert(propertyIndices.GetSize() == 1);
-		ModifyString(m_Properties[propertyIndices[0]].Value, value);
+		IndexVectorU propertyIndices;
+		unsigned longestMatchSize, longestMatchIndex;
+		Traverse(path.m_Symbols.GetArray(), path.m_Symbols.GetSize(), propertyIndices,
+			longestMatchSize, longestMatchIndex);
+
+		assert(propertyIndices.GetSize() <= 1);
+
+		path.m_PropertyIndex = (propertyIndices.GetSize() == 0 ? c_InvalidIndexU : propertyIndices[0]);
+		path.m_StructureVersion = m_StructureVersion;
+	}
+	return path.m_PropertyIndex;
+}
+
+const char* Properties::GetPropertyValueStr(const PropertyPath& path) const
+{
+	unsigned propertyIndex = ResolvePropertyIndex(path);
+	if (propertyIndex == c_InvalidIndexU) return nullptr;
+	return GetPropertyValueStrByIndex(propertyIndex);
+}
+
+bool Properties::HasProperty(const PropertyPath& path) const
+{
+	return (ResolvePropertyIndex(path) != c_InvalidIndexU);
+}
+
+void Properties::SetProperty(const PropertyPath& path, const char* value)
+{
+	unsigned propertyIndex = ResolvePropertyIndex(path);
+	if (propertyIndex != c_InvalidIndexU)
+	{
+		auto& property = m_Properties[propertyIndex];
+		ModifyString(property.Value, value);
+		++property.ValueVersion;
 	}
 	else
 	{
-		AddPropertyOnNonExistingPath(path, longestMatchSize, longestMatchIndex, value);
+		SetProperty(path.m_Symbols.GetArray(), path.m_Symbols.GetSize(), value);
 	}
 }
 
@@ -272,20 +410,21 @@ void Properties::LoadFromXml(const char* path)
 	LoadFromXmlString(text.c_str());
 }
 
-inline std::string GetNodeName(rapidxml::xml_node<>* node)
+inline std::string_view GetNodeName(rapidxml::xml_node<>* node)
 {
-	return std::string(node->name(), node->name_size());
+	return std::string_view(node->name(), node->name_size());
 }
 
-inline std::string GetAttributeValue(rapidxml::xml_attribute<>* attribute)
+inline std::string_view GetAttributeValue(rapidxml::xml_attribute<>* attribute)
 {
-	return std::string(attribute->value(), attribute->value_size());
+	return std::string_view(attribute->value(), attribute->value_size());
 }
 
 void Properties::LoadFromXmlString(const char* str)
 {
 	char* strCopy;
 	Copy(str, &strCopy);
+	std::unique_ptr<char[]> strCopyOwner(strCopy);
 	auto xmlDocument = std::make_unique<rapidxml::xml_document<>>();
 	xmlDocument->parse<0>(strCopy);
 
@@ -298,8 +437,7 @@ void Properties::LoadFromXmlString(const char* str)
 	std::queue<XmlLoadingData> queue;
 	for (auto rootNode = xmlDocument->first_node(); rootNode != nullptr; rootNode = rootNode->next_sibling())
 	{
-		unsigned rootNodeIndex = CreateNode(rootNode->name(), c_InvalidIndexU);
-		m_Roots.Add(rootNodeIndex);
+		unsigned rootNodeIndex = CreateNode(InternSymbol(GetNodeName(rootNode)), c_InvalidIndexU);
 		queue.push({ rootNode, rootNodeIndex });
 	}
 
@@ -319,14 +457,12 @@ void Properties::LoadFromXmlString(const char* str)
 				auto nameAttribute = childXmlNode->first_attribute("name");
 				auto valueAttribute = childXmlNode->first_attribute("value");
 				if (nameAttribute == nullptr || valueAttribute == nullptr) throw std::runtime_error("Invalid property.");
-				auto name = GetAttributeValue(nameAttribute);
-				auto value = GetAttributeValue(valueAttribute);
-				m_Nodes[nodeIndex].Properties.Add(CreateProperty(name.c_str(), value.c_str()));
+				auto value = std::string(GetAttributeValue(valueAttribute));
+				CreateProperty(InternSymbol(GetAttributeValue(nameAttribute)), value.c_str(), nodeIndex);
 			}
 			else
 			{
-				unsigned childNodeIndex = CreateNode(cName.c_str(), nodeIndex);
-				m_Nodes[nodeIndex].Children.Add(childNodeIndex);
+				unsigned childNodeIndex = CreateNode(InternSymbol(cName), nodeIndex);
 				queue.push({ childXmlNode, childNodeIndex });
 			}
 		}
@@ -354,7 +490,7 @@ std::string Properties::ToXmlString() const
 	{
 		uint32_t nodeIndex = m_Roots[i];
 		const auto node = xmlDocument->allocate_node(rapidxml::node_element,
-			m_Strings[m_Nodes[nodeIndex].Name].c_str());
+			GetSymbolName(m_Nodes[nodeIndex].Name));
 		xmlDocument->append_node(node);
 		queue.push({ node , nodeIndex });
 	}
@@ -374,7 +510,7 @@ std::string Properties::ToXmlString() const
 			const auto& property = m_Properties[node.Properties[i]];
 
 			const auto propertyNode = xmlDocument->allocate_node(rapidxml::node_element, "Property");
-			const auto propertyNameAttribute = xmlDocument->allocate_attribute("name", m_Strings[property.Name].c_str());
+			const auto propertyNameAttribute = xmlDocument->allocate_attribute("name", GetSymbolName(property.Name));
 			const auto propertyValueAttribute = xmlDocument->allocate_attribute("value", m_Strings[property.Value].c_str());
 			propertyNode->append_attribute(propertyNameAttribute);
 			propertyNode->append_attribute(propertyValueAttribute);
@@ -387,7 +523,7 @@ std::string Properties::ToXmlString() const
 		{
 			uint32_t childNodeIndex = node.Children[i];
 			const auto childNode = xmlDocument->allocate_node(rapidxml::node_element,
-				m_Strings[m_Nodes[childNodeIndex].Name].c_str());
+				GetSymbolName(m_Nodes[childNodeIndex].Name));
 			xmlNode->append_node(childNode);
 			queue.push({ childNode , childNodeIndex });
 		}
@@ -5,13 +5,71 @@
 
 #include <Core/DataStructures/SimpleTypeUnorderedVector.hpp>
 #include <Core/DataStructures/ResourceUnorderedVector.hpp>
+#include <Core/Constants.h>
 #include <Core/Parse.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace Core
 {
+	class Properties;
+
+	// A property path which is split and whose names are looked up only once. The property is resolved on the first
+	// use and it is only resolved again if nodes or properties were added since. A path can only be used with
+	// the Properties object which has compiled it.
+	class PropertyPath
+	{
+		friend class Properties;
+
+		const Properties* m_Owner;
+		std::string m_Path;
+		IndexVectorU m_Symbols;
+
+		mutable unsigned m_PropertyIndex;
+		mutable unsigned m_StructureVersion;
+
+	public:
+
+		PropertyPath()
+			: m_Owner(nullptr)
+			, m_PropertyIndex(c_InvalidIndexU)
+			, m_StructureVersion(0)
+		{
+		}
+
+		const char* GetPath() const { return m_Path.c_str(); }
+	};
+
+	// A compiled property path with the parsed value of the property. The value is only parsed again
+	// if the property was set since the last read.
+	template <typename T>
+	class CachedProperty
+	{
+		friend class Properties;
+
+		PropertyPath m_Path;
+
+		mutable unsigned m_PropertyIndex;
+		mutable unsigned m_ValueVersion;
+		mutable T m_Value;
+
+	public:
+
+		CachedProperty()
+			: m_PropertyIndex(c_InvalidIndexU)
+			, m_ValueVersion(0)
+			, m_Value()
+		{
+		}
+
+		const PropertyPath& GetPath() const { return m_Path; }
+	};
+
 	class Properties
 	{
 	private: // Simple string pool.
@@ -25,6 +83,22 @@ namespace Core
 
 		const char* GetString(unsigned index) const;
 
+	private: // Interned node and property names.
+
+		std::vector<std::string> m_SymbolNames;
+		std::unordered_multimap<std::uint64_t, unsigned> m_SymbolHashes;
+
+		unsigned InternSymbol(std::string_view name);
+
+		// Returns c_InvalidIndexU if the name was never used.
+		unsigned FindSymbol(std::string_view name) const;
+
+		const char* GetSymbolName(unsigned symbol) const;
+
+		// Splits the path at the dots and looks up or interns the names.
+		void GetPathSymbols(const char* path, IndexVectorU& symbols) const;
+		void InternPathSymbols(const char* path, IndexVectorU& symbols);
+
 	private:
 
 		struct NameValuePair
@@ -35,6 +109,8 @@ namespace Core
 
 		struct Property : public NameValuePair
 		{
+			unsigned NextWithSameName;
+			unsigned ValueVersion;
 			SimpleTypeUnorderedVectorU<NameValuePair> AdditionalData;
 		};
 
@@ -44,6 +120,7 @@ namespace Core
 			SimpleTypeUnorderedVectorU<unsigned> Children;
 
 			unsigned Name;
+			unsigned NextWithSameName;
 			SimpleTypeUnorderedVectorU<unsigned> Properties;
 		};
 
@@ -51,26 +128,43 @@ namespace Core
 		ResourceUnorderedVectorU<Node> m_Nodes;
 		ResourceUnorderedVectorU<Property> m_Properties;
 
-		unsigned CreateNode(const char* name, unsigned parent);
-		unsigned CreateNode(const char* name, unsigned nameSize, unsigned parent);
-		unsigned CreateProperty(const char* name, const char* value);
-		
-		bool IsMatchingNodeName(unsigned nameIndex, const char* path,
-			const char* dotSearchRes) const;
+		// (parent node, name) -> the first such child node, (node, name) -> the first such property.
+		// The further nodes and properties with the same name are linked through NextWithSameName.
+		// The roots are stored with c_InvalidIndexU as parent.
+		std::unordered_map<std::uint64_t, unsigned> m_ChildIndex;
+		std::unordered_map<std::uint64_t, unsigned> m_PropertyIndex;
+
+		// Incremented when a node or a property is added, invalidating the resolved paths.
+		unsigned m_StructureVersion;
+
+		unsigned GetFirstChild(unsigned nodeIndex, unsigned nameSymbol) const;
+		unsigned GetFirstProperty(unsigned nodeIndex, unsigned nameSymbol) const;
 
-		void Traverse(const char* path,
+		unsigned CreateNode(unsigned nameSymbol, unsigned parent);
+		unsigned CreateProperty(unsigned nameSymbol, const char* value, unsigned nodeIndex);
+
+		void Traverse(const unsigned* symbols, unsigned countSymbols,
 			IndexVectorU& propertyIndices,
 			unsigned& longestMatchSize,
 			unsigned& longestMatchIndex) const;
 
-		void AddPropertyOnNonExistingPath(const char* path,
+		void AddPropertyOnNonExistingPath(const unsigned* symbols, unsigned countSymbols,
 			unsigned matchSize, unsigned nodeIndex,
 			const char* value);
 
+		void SetProperty(const unsigned* symbols, unsigned countSymbols, const char* value);
+
+		unsigned ResolvePropertyIndex(const PropertyPath& path) const;
+
+		const char* GetPropertyValueStrByIndex(unsigned propertyIndex) const;
+		unsigned GetPropertyValueVersion(unsigned propertyIndex) const;
+
 		void RaiseExceptionOnPropertyNotFound(const char* path) const;
 
 	public:
 
+		Properties();
+
 		const char* GetPropertyValueStr(const char* path) const;
 		unsigned GetPropertyValuesStr(const char* path, const char** pPath, unsigned maxResultCount);
 		void AddProperty(const char* path, const char* value);
@@ -122,6 +216,76 @@ namespace Core
 			return GetPropertyValue<T>((std::string(prefix) + '.' + name).c_str());
 		}
 
+	public: // Compiled paths.
+
+		// The names of the path are interned, so the path can be resolved later, even if it doesn't exist yet.
+		PropertyPath CompilePath(const char* path);
+
+		template <typename T>
+		CachedProperty<T> CompileCachedProperty(const char* path)
+		{
+			CachedProperty<T> property;
+			property.m_Path = CompilePath(path);
+			return property;
+		}
+
+		const char* GetPropertyValueStr(const PropertyPath& path) const;
+		void SetProperty(const PropertyPath& path, const char* value);
+
+		bool HasProperty(const PropertyPath& path) const;
+
+		template <typename T>
+		bool TryGetPropertyValue(const PropertyPath& path, T& value) const
+		{
+			auto pStr = GetPropertyValueStr(path);
+			if (pStr == nullptr) return false;
+			value = Parse<T>(pStr);
+			return true;
+		}
+
+		template <typename T>
+		T GetPropertyValue(const PropertyPath& path) const
+		{
+			auto pStr = GetPropertyValueStr(path);
+			if (pStr == nullptr) RaiseExceptionOnPropertyNotFound(path.GetPath());
+			return Parse<T>(pStr);
+		}
+
+		// Returns nullptr if the property doesn't exist. The pointer is valid until the next read of the property.
+		template <typename T>
+		const T* GetCachedPropertyValue(const CachedProperty<T>& property) const
+		{
+			unsigned propertyIndex = ResolvePropertyIndex(property.m_Path);
+			if (propertyIndex == c_InvalidIndexU) return nullptr;
+			unsigned valueVersion = GetPropertyValueVersion(propertyIndex);
+			if (propertyIndex != property.m_PropertyIndex || valueVersion != property.m_ValueVersion)
+			{
+				property.m_Value = Parse<T>(GetPropertyValueStrByIndex(propertyIndex));
+				property.m_PropertyIndex = propertyIndex;
+				property.m_ValueVersion = valueVersion;
+			}
+			return &property.m_Value;
+		}
+
+		template <typename T>
+		bool TryGetPropertyValue(const CachedProperty<T>& property, T& value) const
+		{
+			auto pValue = GetCachedPropertyValue(property);
+			if (pValue == nullptr) return false;
+			value = *pValue;
+			return true;
+		}
+
+		template <typename T>
+		const T& GetPropertyValue(const CachedProperty<T>& property) const
+		{
+			auto pValue = GetCachedPropertyValue(property);
+			if (pValue == nullptr) RaiseExceptionOnPropertyNotFound(property.m_Path.GetPath());
+			return *pValue;
+		}
+
+	public:
+
 		void LoadFromXml(const char* path);
 		void LoadFromXmlString(const char* str);
 
@@ -130,4 +294,4 @@ namespace Core
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -5,6 +5,7 @@
 
 #include <Core/Platform.h>
 #include <Core/DataStructures/SimpleTypeVector.hpp>
+#include <Core/DataStructures/DenseIndexList.hpp>
 
 #include <map>
 #include <vector>
@@ -24,6 +25,9 @@ namespace Core
 		SimpleTypeVector<SizeType, SizeType> m_UnusedIndices;
 		SizeType m_CountElements;
 
+		// Packed list of the valid indices for iterating without touching the invalid slots.
+		DenseIndexList<SizeType> m_DenseIndices;
+
 		template <typename... _T>
 		CORE_FORCEINLINE SizeType InitializeNewObject(_T&& ... element)
 		{
@@ -33,6 +37,7 @@ namespace Core
 			m_Data.emplace_back(std::forward<_T>(element)...);
 			m_State.GetLastElement() = State::Valid;
 			m_State.PushBack(State::End);
+			m_DenseIndices.Add(index);
 			return index;
 		}
 
@@ -59,6 +64,7 @@ namespace Core
 				m_CountElements++;
 			}
 			m_State.PushBack(State::End);
+			m_DenseIndices.SetToRange(m_CountElements);
 		}
 
 		inline SizeType GetSize() const
@@ -108,6 +114,7 @@ namespace Core
 				auto index = m_UnusedIndices.PopBackReturn();
 				m_Data[index] = T(std::forward<_T>(element)...);
 				m_State[index] = State::Valid;
+				m_DenseIndices.Add(index);
 				return index;
 			}
 		}
@@ -126,6 +133,7 @@ namespace Core
 			{
 				auto index = m_UnusedIndices.PopBackReturn();
 				m_State[index] = State::Valid;
+				m_DenseIndices.Add(index);
 				return index;
 			}
 		}
@@ -145,6 +153,7 @@ namespace Core
 			--m_CountElements;
 			m_State[index] = State::Invalid;
 			m_UnusedIndices.PushBack(index);
+			m_DenseIndices.Remove(index);
 		}
 
 		inline void Clear()
@@ -154,6 +163,7 @@ namespace Core
 			m_UnusedIndices.Clear();
 			m_State.PushBack(State::End);
 			m_CountElements = 0;
+			m_DenseIndices.Clear();
 		}
 
 		inline SizeType GetCountUnusedElements() const
@@ -161,12 +171,11 @@ namespace Core
 			return m_UnusedIndices.GetSize();
 		}
 
+		// Returns the valid indices in increasing order.
 		SimpleTypeVector<SizeType, SizeType> GetIndices() const
 		{
-			SimpleTypeVector<SizeType, SizeType> indices;
-			indices.Reserve(m_CountElements);
-			SizeType limit = m_State.GetSize() - 1;
-			for (SizeType i = 0; i < limit; i++) if (m_State[i] == State::Valid) indices.UnsafePushBack(i);
+			SimpleTypeVector<SizeType, SizeType> indices(m_DenseIndices.GetArray(), m_DenseIndices.GetSize());
+			std::sort(indices.GetArray(), indices.GetEndPointer());
 			return indices;
 		}
 
@@ -189,11 +198,13 @@ namespace Core
 			m_State.PushBack(State::Valid, targetIndex);
 			m_State.PushBack(State::End);
 			m_UnusedIndices.Clear();
+			m_DenseIndices.SetToRange(targetIndex);
 
 			if (isShrinkingUnderlyingVectors)
 			{
 				m_State.ShrinkToFit();
 				m_Data.shrink_to_fit();
+				m_DenseIndices.ShrinkToFit();
 			}
 
 			return indexMap;
@@ -317,6 +328,39 @@ namespace Core
 		{
 			return _ToIndex(it);
 		}
+
+		// Dense iteration: the cost is proportional to the number of valid elements.
+		// Note that the dense order is NOT the index order, since removing an element moves
+		// the last valid index into its place.
+
+		using DenseIteratorType = DenseIterator<T, SizeType>;
+		using ConstDenseIteratorType = DenseIterator<const T, SizeType>;
+
+		// Returns the packed array of the valid indices. Its size is GetSize().
+		inline const SizeType* GetDenseIndices() const
+		{
+			return m_DenseIndices.GetArray();
+		}
+
+		inline DenseIteratorType GetDenseBeginIterator()
+		{
+			return DenseIteratorType(m_Data.data(), m_DenseIndices.GetArray());
+		}
+
+		inline DenseIteratorType GetDenseEndIterator()
+		{
+			return DenseIteratorType(m_Data.data(), m_DenseIndices.GetEndPointer());
+		}
+
+		inline ConstDenseIteratorType GetDenseBeginConstIterator() const
+		{
+			return ConstDenseIteratorType(m_Data.data(), m_DenseIndices.GetArray());
+		}
+
+		inline ConstDenseIteratorType GetDenseEndConstIterator() const
+		{
+			return ConstDenseIteratorType(m_Data.data(), m_DenseIndices.GetEndPointer());
+		}
 	};
 
 	template <typename T>
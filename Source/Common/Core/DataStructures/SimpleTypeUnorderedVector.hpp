@@ -3,6 +3,7 @@
 #pragma once
 
 #include <Core/DataStructures/SimpleTypeVector.hpp>
+#include <Core/DataStructures/DenseIndexList.hpp>
 #include <Core/SimpleBinarySerialization.hpp>
 
 #include <map>
@@ -22,6 +23,14 @@ namespace Core
 		SimpleTypeVector<SizeType, SizeType> m_UnusedIndices;
 		SizeType m_CountElements;
 
+		// Packed list of the valid indices for iterating without touching the invalid slots.
+		DenseIndexList<SizeType> m_DenseIndices;
+
+		inline void RebuildDenseIndices()
+		{
+			m_DenseIndices.Rebuild(m_Data.GetSize(), [this](SizeType i) { return m_State[i] == State::Valid; });
+		}
+
 		inline const T* GetLastElementPointer() const
 		{
 			assert(m_CountElements > 0);
@@ -47,6 +56,7 @@ namespace Core
 			m_Data.PushBackPlaceHolder();
 			m_State.GetLastElement() = State::Valid;
 			m_State.PushBack(State::End);
+			m_DenseIndices.Add(index);
 			return index;
 		}
 
@@ -73,6 +83,7 @@ namespace Core
 				m_CountElements++;
 			}
 			m_State.PushBack(State::End);
+			m_DenseIndices.SetToRange(m_CountElements);
 		}
 
 		inline SizeType GetSize() const
@@ -121,6 +132,7 @@ namespace Core
 			{
 				auto index = m_UnusedIndices.PopBackReturn();
 				m_State[index] = State::Valid;
+				m_DenseIndices.Add(index);
 				return index;
 			}
 		}
@@ -152,6 +164,7 @@ namespace Core
 			--m_CountElements;
 			m_State[index] = State::Invalid;
 			m_UnusedIndices.PushBack(index);
+			m_DenseIndices.Remove(index);
 		}
 
 		inline void SetByte(unsigned char value)
@@ -166,6 +179,7 @@ namespace Core
 			m_UnusedIndices.Clear();
 			m_State.PushBack(State::End);
 			m_CountElements = 0;
+			m_DenseIndices.Clear();
 		}
 
 		inline SizeType GetCountUnusedElements() const
@@ -192,11 +206,13 @@ namespace Core
 			m_State.PushBack(State::Valid, targetIndex);
 			m_State.PushBack(State::End);
 			m_UnusedIndices.Clear();
+			m_DenseIndices.SetToRange(targetIndex);
 
 			if (isShrinkingUnderlyingVectors)
 			{
 				m_State.ShrinkToFit();
 				m_Data.ShrinkToFit();
+				m_DenseIndices.ShrinkToFit();
 			}
 
 			return indexMap;
@@ -336,29 +352,52 @@ public:
 			return _ToIndex(it);
 		}
 
+		// Dense iteration: the cost is proportional to the number of valid elements.
+		// Note that the dense order is NOT the index order, since removing an element moves
+		// the last valid index into its place.
+
+		using DenseIteratorType = DenseIterator<T, SizeType>;
+		using ConstDenseIteratorType = DenseIterator<const T, SizeType>;
+
+		// Returns the packed array of the valid indices. Its size is GetSize().
+		// It can be used to iterate parallel unordered vectors having the same index layout.
+		inline const SizeType* GetDenseIndices() const
+		{
+			return m_DenseIndices.GetArray();
+		}
+
+		inline DenseIteratorType GetDenseBeginIterator()
+		{
+			return DenseIteratorType(m_Data.GetArray(), m_DenseIndices.GetArray());
+		}
+
+		inline DenseIteratorType GetDenseEndIterator()
+		{
+			return DenseIteratorType(m_Data.GetArray(), m_DenseIndices.GetEndPointer());
+		}
+
+		inline ConstDenseIteratorType GetDenseBeginConstIterator() const
+		{
+			return ConstDenseIteratorType(m_Data.GetArray(), m_DenseIndices.GetArray());
+		}
+
+		inline ConstDenseIteratorType GetDenseEndConstIterator() const
+		{
+			return ConstDenseIteratorType(m_Data.GetArray(), m_DenseIndices.GetEndPointer());
+		}
+
 		bool Contains(const T& element) const
 		{
 			auto pData = m_Data.GetArray();
-			auto pState = m_State.GetArray();
-			do
+			auto pIndex = m_DenseIndices.GetArray();
+			auto pEnd = m_DenseIndices.GetEndPointer();
+			for (; pIndex != pEnd; ++pIndex)
 			{
-				while (*pState == State::Invalid)
-				{
-					++pData;
-					++pState;
-				}
-				if (*pState == State::End)
-				{
-					break;
-				}
-				if (*pData == element)
+				if (pData[*pIndex] == element)
 				{
 					return true;
 				}
-				++pData;
-				++pState;
-			} while (true);
-
+			}
 			return false;
 		}
 
@@ -393,6 +432,9 @@ public:
 			Core::DeserializeSB(bytes, m_State);
 			Core::DeserializeSB(bytes, m_UnusedIndices);
 			Core::DeserializeSB(bytes, m_CountElements);
+
+			// The dense indices are not serialized to keep the format unchanged.
+			RebuildDenseIndices();
 		}
 	};
 
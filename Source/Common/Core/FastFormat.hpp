@@ -0,0 +1,276 @@
+// Core/FastFormat.hpp
+
+#ifndef _CORE_FASTFORMAT_HPP_INCLUDED_
+#define _CORE_FASTFORMAT_HPP_INCLUDED_
+
+#include <Core/Platform.h>
+#include <Core/DataStructures/SimpleTypeVector.hpp>
+
+#include <charconv>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// Formatting with '%x' placeholders, like Core::Format, but writing to a caller-provided target
+// without heap allocations. Numbers are converted with std::to_chars: integers are written in decimal,
+// floating-point values in the shortest form which is parsed back to the same value.
+//
+// The targets are: character arrays (truncating, null-terminated), CharBufferWriter, FixedSizedOutputStream,
+// std::string and SimpleTypeVector<char> (the latter two grow and are appended to).
+//
+// Format strings wrapped with CORE_FORMAT_STRING are parsed at compile time, and the count of the placeholders
+// is validated against the count of the arguments with a static_assert. Other format strings are parsed
+// at runtime and a placeholder count mismatch throws.
+//
+//   char buffer[64];
+//   Core::FormatTo(buffer, CORE_FORMAT_STRING("FPS: %x, draw calls: %x"), fps, countDrawCalls);
+
+namespace Core
+{
+	// Enough characters for any arithmetic value.
+	const size_t c_MaxNumberCharacters = 64;
+
+	struct CompileTimeFormatString {};
+
+	// Writes to a fixed sized character buffer. The text is truncated if the buffer is too small
+	// and it is always null-terminated.
+	class CharBufferWriter
+	{
+		char* m_Buffer;
+		size_t m_Capacity;
+		size_t m_Length;
+		bool m_IsTruncated;
+
+	public:
+
+		// The size includes the terminating null character and must be positive.
+		CharBufferWriter(char* buffer, size_t size)
+			: m_Buffer(buffer)
+			, m_Capacity(size - 1)
+			, m_Length(0)
+			, m_IsTruncated(false)
+		{
+			m_Buffer[0] = '\0';
+		}
+
+		void Append(const char* str, size_t length)
+		{
+			size_t remaining = m_Capacity - m_Length;
+			if (length > remaining)
+			{
+				length = remaining;
+				m_IsTruncated = true;
+			}
+			memcpy(m_Buffer + m_Length, str, length);
+			m_Length += length;
+			m_Buffer[m_Length] = '\0';
+		}
+
+		const char* GetString() const { return m_Buffer; }
+		size_t GetLength() const { return m_Length; }
+		bool IsTruncated() const { return m_IsTruncated; }
+	};
+
+	namespace detail
+	{
+		///////////////////////////////////// NUMBER CONVERSION /////////////////////////////////////
+
+		// Writes the value to [first, last) and returns the end of the written characters.
+		// Bools are written as '1' and '0', enums as their underlying value.
+		template <typename T>
+		inline char* ToChars(char* first, char* last, T value)
+		{
+			static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "Only numbers can be converted.");
+			if constexpr (std::is_same<T, bool>::value)
+			{
+				if (first == last) return first;
+				*first = (value ? '1' : '0');
+				return first + 1;
+			}
+			else if constexpr (std::is_enum<T>::value)
+			{
+				return ToChars(first, last, static_cast<std::underlying_type_t<T>>(value));
+			}
+			else
+			{
+				auto result = std::to_chars(first, last, value);
+				return (result.ec == std::errc() ? result.ptr : first);
+			}
+		}
+
+		///////////////////////////////////// TARGETS /////////////////////////////////////
+
+		inline void AppendChars(std::string& target, const char* str, size_t length)
+		{
+			target.append(str, length);
+		}
+
+		template <typename SizeType, typename AllocatorType>
+		inline void AppendChars(SimpleTypeVector<char, SizeType, AllocatorType>& target, const char* str, size_t length)
+		{
+			target.PushBack(str, static_cast<SizeType>(length));
+		}
+
+		// Targets with an Append(const char*, size_t) function.
+		template <typename TargetType>
+		inline void AppendChars(TargetType& target, const char* str, size_t length)
+		{
+			target.Append(str, length);
+		}
+
+		///////////////////////////////////// VALUES /////////////////////////////////////
+
+		// Numbers are converted without allocation, strings are copied and plain chars are written as characters,
+		// like with streams. Other types fall back to streams.
+		template <typename TargetType, typename T>
+		inline void AppendFormatValue(TargetType& target, const T& value)
+		{
+			if constexpr (std::is_same<T, char>::value)
+			{
+				AppendChars(target, &value, 1);
+			}
+			else if constexpr (std::is_arithmetic<T>::value || std::is_enum<T>::value)
+			{
+				char buffer[c_MaxNumberCharacters];
+				auto end = ToChars(buffer, buffer + c_MaxNumberCharacters, value);
+				AppendChars(target, buffer, static_cast<size_t>(end - buffer));
+			}
+			else if constexpr (std::is_convertible<const T&, std::string_view>::value)
+			{
+				std::string_view str(value);
+				AppendChars(target, str.data(), str.size());
+			}
+			else
+			{
+				std::ostringstream ss;
+				ss << value;
+				auto str = ss.str();
+				AppendChars(target, str.data(), str.size());
+			}
+		}
+
+		///////////////////////////////////// FORMAT STRING PARSING /////////////////////////////////////
+
+		inline CORE_CONSTEXPR bool IsFormatPlaceholder(const char* format, size_t index)
+		{
+			return (format[index] == '%' && format[index + 1] == 'x');
+		}
+
+		inline CORE_CONSTEXPR size_t GetFormatStringLength(const char* format)
+		{
+			size_t length = 0;
+			while (format[length] != '\0') ++length;
+			return length;
+		}
+
+		inline CORE_CONSTEXPR size_t CountFormatPlaceholders(const char* format)
+		{
+			size_t count = 0;
+			for (size_t i = 0; format[i] != '\0'; i++)
+			{
+				if (IsFormatPlaceholder(format, i)) { ++count; ++i; }
+			}
+			return count;
+		}
+
+		// The literal segments around the placeholders.
+		template <size_t CountPlaceholders>
+		struct FormatStringLayout
+		{
+			size_t Starts[CountPlaceholders + 1];
+			size_t Ends[CountPlaceholders + 1];
+		};
+
+		template <size_t CountPlaceholders>
+		inline CORE_CONSTEXPR FormatStringLayout<CountPlaceholders> ParseFormatString(const char* format)
+		{
+			FormatStringLayout<CountPlaceholders> layout = {};
+			size_t segmentIndex = 0;
+			size_t i = 0;
+			for (; format[i] != '\0' && segmentIndex < CountPlaceholders; i++)
+			{
+				if (IsFormatPlaceholder(format, i))
+				{
+					layout.Ends[segmentIndex] = i;
+					layout.Starts[++segmentIndex] = i + 2;
+					++i;
+				}
+			}
+			layout.Ends[CountPlaceholders] = GetFormatStringLength(format);
+			return layout;
+		}
+
+		///////////////////////////////////// FORMATTING /////////////////////////////////////
+
+		template <typename TargetType, typename FormatStringType, typename... Args, size_t... Indices>
+		inline void FormatToWithLayout(TargetType& target, std::index_sequence<Indices...>, const Args&... args)
+		{
+			const char* format = FormatStringType::Get();
+			static CORE_CONSTEXPR auto c_Layout = ParseFormatString<sizeof...(Args)>(FormatStringType::Get());
+			AppendChars(target, format, c_Layout.Ends[0]);
+			((AppendFormatValue(target, args),
+				AppendChars(target, format + c_Layout.Starts[Indices + 1], c_Layout.Ends[Indices + 1] - c_Layout.Starts[Indices + 1])), ...);
+		}
+
+		template <typename TargetType, typename FormatStringType, typename... Args>
+		inline void FormatTo(TargetType& target, const FormatStringType&, std::true_type, const Args&... args)
+		{
+			static_assert(CountFormatPlaceholders(FormatStringType::Get()) == sizeof...(Args),
+				"The count of the placeholders doesn't match the count of the arguments.");
+			FormatToWithLayout<TargetType, FormatStringType>(target, std::index_sequence_for<Args...>(), args...);
+		}
+
+		template <typename TargetType, typename... Args>
+		inline void FormatTo(TargetType& target, const char* format, std::false_type, const Args&... args)
+		{
+			if (CountFormatPlaceholders(format) != sizeof...(Args))
+			{
+				throw std::runtime_error("String format error.");
+			}
+			auto appendSegment = [&target, &format]() {
+				size_t length = 0;
+				while (format[length] != '\0' && !IsFormatPlaceholder(format, length)) ++length;
+				AppendChars(target, format, length);
+				format += length;
+				if (*format != '\0') format += 2;
+			};
+			appendSegment();
+			((AppendFormatValue(target, args), appendSegment()), ...);
+		}
+
+		template <typename FormatType>
+		using IsCompileTimeFormatString = std::is_base_of<CompileTimeFormatString, FormatType>;
+	}
+
+	// Appends the formatted text to the target.
+	template <typename TargetType, typename FormatType, typename... Args>
+	inline void FormatTo(TargetType& target, const FormatType& format, const Args&... args)
+	{
+		detail::FormatTo(target, format, detail::IsCompileTimeFormatString<FormatType>(), args...);
+	}
+
+	// Writes the formatted, null-terminated text to the buffer, truncating it if necessary. Returns the length.
+	template <size_t Size, typename FormatType, typename... Args>
+	inline size_t FormatTo(char (&buffer)[Size], const FormatType& format, const Args&... args)
+	{
+		CharBufferWriter writer(buffer, Size);
+		FormatTo(writer, format, args...);
+		return writer.GetLength();
+	}
+}
+
+// Wraps a string literal to a type, so that it can be parsed at compile time.
+#define CORE_FORMAT_STRING(format)													\
+	([]() {																			\
+		struct FormatStringType : Core::CompileTimeFormatString						\
+		{																			\
+			static CORE_CONSTEXPR const char* Get() { return format; }				\
+		};																			\
+		return FormatStringType();													\
+	}())
+
+#endif
@@ -6,8 +6,11 @@
 #include <array>
 #include <string>
 #include <cstdio>
+#include <cstring>
+#include <type_traits>
 
 #include <Core/Platform.h>
+#include <Core/FastFormat.hpp>
 
 namespace Core
 {
@@ -27,21 +30,10 @@ namespace Core
 			return (Size - m_StartIndex);
 		}
 
-		inline void AdjustStartIndex()
+		inline void CopyString(const char* str, size_t length)
 		{
-			while (m_StartIndex < Size && m_Buffer[m_StartIndex] != '\0') ++m_StartIndex;
-		}
-
-		inline void CopyString(const std::string& str)
-		{
-			size_t length = str.length();
-			memcpy(GetDestinationPointer(), str.data(), length);
-			m_StartIndex += length;
-		}
-
-		inline void CopyString(const char* str)
-		{
-			size_t length = strlen(str);
+			size_t remainingSize = GetRemainingSize();
+			if (length > remainingSize) length = remainingSize;
 			memcpy(GetDestinationPointer(), str, length);
 			m_StartIndex += length;
 		}
@@ -73,26 +65,39 @@ namespace Core
 			m_StartIndex = 0;
 		}
 
+		size_t GetLength() const
+		{
+			return m_StartIndex;
+		}
+
+		// Appends the string. The text is truncated if the stream is full.
+		void Append(const char* str, size_t length)
+		{
+			CopyString(str, length);
+		}
+
 		FixedSizedOutputStream& operator<<(const std::string& str)
 		{
-			CopyString(str);
+			CopyString(str.data(), str.length());
 			return *this;
 		}
 
 		FixedSizedOutputStream& operator<<(const char* str)
 		{
-			CopyString(str);
+			CopyString(str, strlen(str));
 			return *this;
 		}
 
-		FixedSizedOutputStream& operator<<(int i)
+		FixedSizedOutputStream& operator<<(char c)
 		{
-#ifdef IS_WINDOWS
-			_itoa_s(i, GetDestinationPointer(), GetRemainingSize(), 10);
-#else
-			itoa(i, GetDestinationPointer(), 10);
-#endif
-			AdjustStartIndex();
+			CopyString(&c, 1);
+			return *this;
+		}
+
+		template <typename T>
+		std::enable_if_t<std::is_arithmetic<T>::value || std::is_enum<T>::value, FixedSizedOutputStream&> operator<<(T value)
+		{
+			m_StartIndex = detail::ToChars(GetDestinationPointer(), m_Buffer.data() + Size, value) - m_Buffer.data();
 			return *this;
 		}
 	};
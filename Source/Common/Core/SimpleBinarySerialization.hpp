@@ -4,11 +4,14 @@
 #define _CORE_SIMPLEBINARYSERIALIZATION_HPP_
 
 #include <Core/DataStructures/SimpleTypeVector.hpp>
+#include <Core/DataStructures/ArrayView.hpp>
 
 #include <cstdint>
 #include <string>
 #include <vector>
 #include <map>
+#include <stdexcept>
+#include <type_traits>
 
 namespace Core
 {
@@ -30,6 +33,27 @@ namespace Core
 		return reinterpret_cast<PlaceHolderStruct<sizeof(T)>&>(value);
 	}
 
+	// Types which are serialized by copying their memory representation. Arrays of these types
+	// are serialized and deserialized with a single copy. Non-class types are bitwise serializable by default,
+	// trivially copyable classes can opt in with CORE_BITWISE_SERIALIZABLE_SB, in which case their
+	// SerializeSB/DeserializeSB functions are not used. Note that the padding bytes are also serialized.
+	template <typename T>
+	struct IsBitwiseSerializableSB
+	{
+		static const bool value = !std::is_class<T>::value && std::is_trivially_copyable<T>::value;
+	};
+
+	template <size_t Size>
+	struct IsBitwiseSerializableSB<PlaceHolderStruct<Size>>
+	{
+		static const bool value = true;
+	};
+
+	// Alignment of the array data written by SerializeAlignedSB. The alignment is relative to the
+	// beginning of the serialized buffer: it is an absolute alignment if the buffer itself is aligned,
+	// which is the case for memory-mapped files.
+	const size_t c_AlignmentSB = 64;
+
 	namespace detail
 	{
 		template <typename T, bool IsClass>
@@ -53,13 +77,13 @@ namespace Core
 		template <typename T>
 		inline void _SerializeSB(ByteVector& bytes, const T& object)
 		{
-			SerializerSB<T, std::is_class<T>::value>::SerializeSB(bytes, object);
+			SerializerSB<T, std::is_class<T>::value && !IsBitwiseSerializableSB<T>::value>::SerializeSB(bytes, object);
 		}
 
 		template <typename T>
 		inline void _DeserializeSB(const unsigned char*& bytes, T& object)
 		{
-			DeserializerSB<T, std::is_class<T>::value>::DeserializeSB(bytes, object);
+			DeserializerSB<T, std::is_class<T>::value && !IsBitwiseSerializableSB<T>::value>::DeserializeSB(bytes, object);
 		}
 
 		template <typename T>
@@ -92,16 +116,67 @@ namespace Core
 			return static_cast<SizeType>(size);
 		}
 
-		template <typename T, typename SizeType>
-		inline void SerializeArraySB(ByteVector& bytes, const T* data, SizeType size)
+		inline void SerializeAlignmentPaddingSB(ByteVector& bytes)
+		{
+			// The count of the padding bytes is stored in a single byte before the padding.
+			auto position = bytes.GetSize() + 1;
+			auto countPaddingBytes = static_cast<unsigned char>((c_AlignmentSB - position % c_AlignmentSB) % c_AlignmentSB);
+			bytes.PushBack(countPaddingBytes);
+			bytes.PushBack(static_cast<unsigned char>(0), countPaddingBytes);
+		}
+
+		inline void DeserializeAlignmentPaddingSB(const unsigned char*& bytes)
+		{
+			bytes += 1 + *bytes;
+		}
+
+		template <typename T>
+		inline void SerializeElementsSB(ByteVector& bytes, const T* data, size_t size, std::true_type)
+		{
+			bytes.PushBack(reinterpret_cast<const unsigned char*>(data), size * sizeof(T));
+		}
+
+		template <typename T>
+		inline void SerializeElementsSB(ByteVector& bytes, const T* data, size_t size, std::false_type)
 		{
-			SerializeSizeSB(bytes, size);
 			for (size_t i = 0; i < size; i++)
 			{
 				_SerializeSB(bytes, data[i]);
 			}
 		}
 
+		template <typename T>
+		inline void DeserializeElementsSB(const unsigned char*& bytes, T* data, size_t size, std::true_type)
+		{
+			const size_t copySize = size * sizeof(T);
+			memcpy(data, bytes, copySize);
+			bytes += copySize;
+		}
+
+		template <typename T>
+		inline void DeserializeElementsSB(const unsigned char*& bytes, T* data, size_t size, std::false_type)
+		{
+			for (size_t i = 0; i < size; i++)
+			{
+				_DeserializeSB(bytes, data[i]);
+			}
+		}
+
+		template <typename T, typename SizeType>
+		inline void SerializeArraySB(ByteVector& bytes, const T* data, SizeType size)
+		{
+			SerializeSizeSB(bytes, size);
+			SerializeElementsSB(bytes, data, static_cast<size_t>(size),
+				std::integral_constant<bool, IsBitwiseSerializableSB<T>::value>());
+		}
+
+		template <typename T>
+		inline void DeserializeArraySB(const unsigned char*& bytes, T* data, size_t size)
+		{
+			DeserializeElementsSB(bytes, data, size,
+				std::integral_constant<bool, IsBitwiseSerializableSB<T>::value>());
+		}
+
 		template <typename T>
 		struct SerializerSB<T, false>
 		{
@@ -178,10 +253,7 @@ namespace Core
 			{
 				auto size = DeserializeSizeSB<size_t>(bytes);
 				v.resize(size);
-				for (size_t i = 0; i < size; i++)
-				{
-					_DeserializeSB(bytes, v[i]);
-				}
+				DeserializeArraySB(bytes, v.data(), size);
 			}
 		};
 
@@ -231,12 +303,7 @@ namespace Core
 			static inline void DeserializeSB(const unsigned char*& bytes, std::string& str)
 			{
 				auto size = DeserializeSizeSB<size_t>(bytes);
-				str.clear();
-				str.append(size, 0);
-				for (size_t i = 0; i < size; i++)
-				{
-					str[i] = bytes[i];
-				}
+				str.assign(reinterpret_cast<const char*>(bytes), size);
 				bytes += size;
 			}
 		};
@@ -269,6 +336,72 @@ namespace Core
 		Core::detail::_DeserializeSB(bytes, object);
 	}
 
+	// Aligned array serialization. The array data is written to an aligned position,
+	// thus it can be accessed in-place by DeserializeViewSB without copying.
+	template <typename T>
+	inline void SerializeAlignedSB(ByteVector& bytes, const T* data, size_t size)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be serialized aligned.");
+		Core::detail::SerializeSizeSB(bytes, size);
+		Core::detail::SerializeAlignmentPaddingSB(bytes);
+		bytes.PushBack(reinterpret_cast<const unsigned char*>(data), size * sizeof(T));
+	}
+
+	template <typename T, typename SizeType, typename AllocatorType>
+	inline void SerializeAlignedSB(ByteVector& bytes, const SimpleTypeVector<T, SizeType, AllocatorType>& v)
+	{
+		SerializeAlignedSB(bytes, v.GetArray(), static_cast<size_t>(v.GetSize()));
+	}
+
+	template <typename T, typename SizeType, typename AllocatorType>
+	inline void DeserializeAlignedSB(const unsigned char*& bytes, SimpleTypeVector<T, SizeType, AllocatorType>& v)
+	{
+		auto size = Core::detail::DeserializeSizeSB<SizeType>(bytes);
+		Core::detail::DeserializeAlignmentPaddingSB(bytes);
+		v.Resize(size);
+		auto copySize = v.GetSizeInBytes();
+		if (copySize > 0) memcpy(v.GetArray(), bytes, copySize);
+		bytes += copySize;
+	}
+
+	// Deserializes an aligned array as a view into the serialized buffer. No data is copied,
+	// the buffer must outlive the view.
+	template <typename T>
+	inline void DeserializeViewSB(const unsigned char*& bytes, ArrayView<T>& view)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be viewed in-place.");
+		auto size = Core::detail::DeserializeSizeSB<size_t>(bytes);
+		Core::detail::DeserializeAlignmentPaddingSB(bytes);
+		if (reinterpret_cast<std::uintptr_t>(bytes) % alignof(T) != 0)
+		{
+			throw std::runtime_error("The serialized array is not aligned: it cannot be viewed in-place.");
+		}
+		view = ArrayView<T>(reinterpret_cast<const T*>(bytes), size);
+		bytes += size * sizeof(T);
+	}
+
+	// Bounded variant, which throws if the serialized array doesn't fit in [bytes, end),
+	// e.g. if an empty or a truncated file is viewed.
+	template <typename T>
+	inline void DeserializeViewSB(const unsigned char*& bytes, const unsigned char* end, ArrayView<T>& view)
+	{
+		const size_t sizeFieldSize = sizeof(std::uint64_t);
+		auto countAvailableBytes = static_cast<size_t>(end - bytes);
+		if (bytes == nullptr || countAvailableBytes <= sizeFieldSize
+			|| countAvailableBytes - sizeFieldSize - 1 < bytes[sizeFieldSize])
+		{
+			throw std::runtime_error("The serialized array is truncated: it cannot be viewed in-place.");
+		}
+		auto arrayBytes = bytes + sizeFieldSize + 1 + bytes[sizeFieldSize];
+		std::uint64_t size;
+		memcpy(&size, bytes, sizeFieldSize);
+		if (static_cast<size_t>(end - arrayBytes) / sizeof(T) < size)
+		{
+			throw std::runtime_error("The serialized array is truncated: it cannot be viewed in-place.");
+		}
+		DeserializeViewSB(bytes, view);
+	}
+
 	template <typename T>
 	inline void StartDeserializeSB(const unsigned char* bytes, T& object)
 	{
@@ -282,4 +415,16 @@ namespace Core
 	}
 }
 
+// Declares a trivially copyable class bitwise serializable. Must be used in the global namespace.
+#define CORE_BITWISE_SERIALIZABLE_SB(Type) \
+	namespace Core \
+	{ \
+		template <> \
+		struct IsBitwiseSerializableSB<Type> \
+		{ \
+			static_assert(std::is_trivially_copyable<Type>::value, "Only trivially copyable types can be bitwise serializable."); \
+			static const bool value = true; \
+		}; \
+	}
+
 #endif
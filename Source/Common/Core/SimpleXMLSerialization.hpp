@@ -4,6 +4,8 @@
 #define _CORE_SIMPLEXMLSERIALIZATION_HPP_
 
 #include <Core/DataStructures/SimpleTypeVector.hpp>
+#include <Core/BinarySXMLDocument.h>
+#include <Core/Constants.h>
 #include <Core/Parse.hpp>
 #include <Core/String.hpp>
 #include <Core/StringStreamHelper.h>
@@ -18,47 +20,118 @@
 #include <map>
 #include <utility>
 #include <cstdlib>
+#include <stdexcept>
 #include <type_traits>
 
 namespace Core
 {
+	// The serialization data either refers to a rapidxml document or to a binary document.
+	// The backend-independent functions below (CreateXMLNode, SetXMLNodeValue, SetValuesSXML, SetBytesSXML, ...)
+	// work with both backends.
 	struct SerializationSXMLData
 	{
 		rapidxml::xml_document<>* Document;
 		rapidxml::xml_node<>* Node;
-		std::stringstream* SS;
+		Core::SimpleTypeVector<char>* Chars;		// Reused buffer for formatting values.
+		BinarySXMLDocument* BinaryDocument = nullptr;
+		unsigned BinaryNode = c_InvalidIndexU;
+
+		inline bool IsBinary() const
+		{
+			return (BinaryDocument != nullptr);
+		}
 	};
 
 	struct DeserializationSXMLData
 	{
 		rapidxml::xml_node<>* Node;
 		Core::SimpleTypeVector<char>* Chars;
+		const BinarySXMLDocument* BinaryDocument = nullptr;
+		unsigned BinaryNode = c_InvalidIndexU;
 
 	private:
 
 		inline void Place(const char* source, size_t size)
 		{
 			Chars->Resize(size + 1);
-			memcpy(Chars->GetArray(), source, size);
+			if (size > 0) memcpy(Chars->GetArray(), source, size);
 			(*Chars)[size] = 0;
 		}
 
+		inline void PlaceBinaryValue(unsigned node)
+		{
+			if (BinaryDocument->IsNumeric(node))
+			{
+				BinaryDocument->FormatValue(node, *Chars);
+				Chars->PushBack('\0');
+			}
+			else
+			{
+				Place(reinterpret_cast<const char*>(BinaryDocument->GetValueData(node)),
+					BinaryDocument->GetValueCount(node));
+			}
+		}
+
 	public:
 
+		inline bool IsBinary() const
+		{
+			return (BinaryDocument != nullptr);
+		}
+
+		// Returns whether the node exists.
+		inline bool IsValid() const
+		{
+			return (IsBinary() ? BinaryNode != c_InvalidIndexU : Node != nullptr);
+		}
+
+		inline bool HasChildNodes() const
+		{
+			return (GetFirstChild().IsValid());
+		}
+
+		// Iterates over the child nodes. Attributes are skipped.
+		inline DeserializationSXMLData GetFirstChild() const
+		{
+			if (!IsBinary()) return { Node->first_node(), Chars };
+			auto child = BinaryDocument->GetFirstChild(BinaryNode);
+			while (child != c_InvalidIndexU && BinaryDocument->IsAttribute(child))
+				child = BinaryDocument->GetNextSibling(child);
+			return { nullptr, Chars, BinaryDocument, child };
+		}
+
+		inline DeserializationSXMLData GetNextSibling() const
+		{
+			if (!IsBinary()) return { Node->next_sibling(), Chars };
+			auto sibling = BinaryDocument->GetNextSibling(BinaryNode);
+			while (sibling != c_InvalidIndexU && BinaryDocument->IsAttribute(sibling))
+				sibling = BinaryDocument->GetNextSibling(sibling);
+			return { nullptr, Chars, BinaryDocument, sibling };
+		}
+
 		inline void PlaceNodeName()
 		{
-			Place(Node->name(), Node->name_size());
+			if (IsBinary()) Place(BinaryDocument->GetName(BinaryNode), BinaryDocument->GetNameSize(BinaryNode));
+			else Place(Node->name(), Node->name_size());
 		}
 
 		inline void PlaceNodeValue()
 		{
-			Place(Node->value(), Node->value_size());
+			if (IsBinary()) PlaceBinaryValue(BinaryNode);
+			else Place(Node->value(), Node->value_size());
 		}
 
 		inline void PlaceAttributeValue(const char* name)
 		{
-			auto attribute = Node->first_attribute(name);
-			Place(attribute->value(), attribute->value_size());
+			if (IsBinary())
+			{
+				PlaceBinaryValue(BinaryDocument->FindAttribute(BinaryNode, name));
+			}
+			else
+			{
+				auto attribute = Node->first_attribute(name);
+				Place(attribute->value(), attribute->value_size());
+			}
 		}
 	};
 
@@ -81,12 +154,21 @@ namespace Core
 	}
 #endif
 
+	struct SerializationBinaryDataWrapper { const unsigned char* Data; size_t Size; };
 	struct DeserializationBinaryDataWrapper { unsigned char** PData; size_t* PSize; };
 
+	// Binary data is written as raw bytes to binary documents and as base64 text to XML documents.
+	template <typename T>
+	inline SerializationBinaryDataWrapper AsBinaryData(const T* data, size_t size)
+	{
+		return { reinterpret_cast<const unsigned char*>(data), size };
+	}
+
+	// The deserialized data is allocated with new[].
 	template <typename T>
 	inline DeserializationBinaryDataWrapper AsBinaryData(T** pData, size_t* pSize)
 	{
-		return { pData, pSize };
+		return { reinterpret_cast<unsigned char**>(pData), pSize };
 	}
 
 	inline rapidxml::xml_node<>* CreateXMLNode(rapidxml::xml_document<>* pDocument, rapidxml::xml_node<>* pNode,
@@ -103,8 +185,18 @@ namespace Core
 	{
 		SerializationSXMLData newData;
 		newData.Document = data.Document;
-		newData.Node = CreateXMLNode(data.Document, data.Node, name, value);
-		newData.SS = data.SS;
+		newData.Chars = data.Chars;
+		newData.BinaryDocument = data.BinaryDocument;
+		if (data.IsBinary())
+		{
+			newData.Node = nullptr;
+			newData.BinaryNode = data.BinaryDocument->AddNode(data.BinaryNode, name);
+			if (value != nullptr) data.BinaryDocument->SetText(newData.BinaryNode, value, strlen(value));
+		}
+		else
+		{
+			newData.Node = CreateXMLNode(data.Document, data.Node, name, value);
+		}
 		return newData;
 	}
 
@@ -114,6 +206,12 @@ namespace Core
 		pNode->value(nodeValue, strlen(value));
 	}
 
+	inline void SetXMLNodeValue(SerializationSXMLData& data, const char* value)
+	{
+		if (data.IsBinary()) data.BinaryDocument->SetText(data.BinaryNode, value, strlen(value));
+		else SetXMLNodeValue(data.Document, data.Node, value);
+	}
+
 	inline rapidxml::xml_attribute<>* AddXMLAttribute(rapidxml::xml_document<>* pDocument, rapidxml::xml_node<>* pNode,
 		const char* name, const char* value)
 	{
@@ -127,15 +225,137 @@ namespace Core
 	template <typename T>
 	inline void AddXMLAttribute(SerializationSXMLData& data, const char* name, const T& value)
 	{
-		*data.SS << value;
-		AddXMLAttribute(data.Document, data.Node, name, data.SS->str().c_str());
-		data.SS->str("");
+		auto& chars = *data.Chars;
+		chars.Clear();
+		Core::detail::AppendFormatValue(chars, value);
+		if (data.IsBinary())
+		{
+			auto attribute = data.BinaryDocument->AddNode(data.BinaryNode, name, true);
+			data.BinaryDocument->SetText(attribute, chars.GetArray(), chars.GetSize());
+		}
+		else
+		{
+			chars.PushBack('\0');
+			AddXMLAttribute(data.Document, data.Node, name, chars.GetArray());
+		}
 	}
 
 	inline DeserializationSXMLData VisitChildXMLNode(DeserializationSXMLData& data, const char* childNodeName)
 	{
+		if (data.IsBinary())
+			return { nullptr, data.Chars, data.BinaryDocument, data.BinaryDocument->FindChild(data.BinaryNode, childNodeName) };
 		return { data.Node->first_node(childNodeName), data.Chars };
 	}
+
+	// Writes numbers. In XML documents the numbers of a group are separated by ',' and the groups by ';'.
+	// Binary documents store the numbers as a typed array.
+	template <typename T>
+	inline void SetValuesSXML(SerializationSXMLData& data, const T* values, size_t count, size_t groupSize = 1)
+	{
+		if (data.IsBinary())
+		{
+			data.BinaryDocument->SetValues(data.BinaryNode, values, count, groupSize);
+		}
+		else
+		{
+			auto& chars = *data.Chars;
+			chars.Clear();
+			for (size_t i = 0; i < count; i++)
+			{
+				char buffer[c_MaxNumberCharacters];
+				auto end = Core::detail::ToChars(buffer, buffer + c_MaxNumberCharacters, values[i]);
+				chars.PushBack(buffer, static_cast<unsigned>(end - buffer));
+				if (i + 1 < count) chars.PushBack((i + 1) % groupSize == 0 ? ';' : ',');
+			}
+			chars.PushBack('\0');
+			SetXMLNodeValue(data.Document, data.Node, chars.GetArray());
+		}
+	}
+
+	namespace detail
+	{
+		// Reads numbers to the array which is returned by the allocate function for the count of the numbers.
+		template <typename T, typename AllocateFunction>
+		inline void GetValuesSXML(DeserializationSXMLData& data, const AllocateFunction& allocate)
+		{
+			if (data.IsBinary() && data.BinaryDocument->IsNumeric(data.BinaryNode))
+			{
+				auto values = allocate(data.BinaryDocument->GetValueCount(data.BinaryNode));
+				data.BinaryDocument->GetValues(data.BinaryNode, values);
+			}
+			else
+			{
+				data.PlaceNodeValue();
+				auto parts = Core::Split(data.Chars->GetArray(), data.Chars->GetSize() - 1,
+					Core::IsAnyOf(",;"), true);
+				auto countParts = parts.size();
+				auto values = allocate(countParts);
+				for (size_t i = 0; i < countParts; i++)
+				{
+					values[i] = Core::Parse<T>(parts[i].c_str());
+				}
+			}
+		}
+	}
+
+	// Reads exactly 'count' numbers.
+	template <typename T>
+	inline void GetValuesSXML(DeserializationSXMLData& data, T* values, size_t count)
+	{
+		Core::detail::GetValuesSXML<T>(data, [values, count](size_t storedCount) {
+			if (storedCount != count) throw std::runtime_error("Unexpected number of values in the SXML document.");
+			return values;
+		});
+	}
+
+	template <typename T, typename SizeType, typename AllocatorType>
+	inline void GetValuesSXML(DeserializationSXMLData& data, SimpleTypeVector<T, SizeType, AllocatorType>& values)
+	{
+		Core::detail::GetValuesSXML<T>(data, [&values](size_t count) {
+			values.Resize(static_cast<SizeType>(count));
+			return values.GetArray();
+		});
+	}
+
+	template <typename T>
+	inline void GetValuesSXML(DeserializationSXMLData& data, std::vector<T>& values)
+	{
+		Core::detail::GetValuesSXML<T>(data, [&values](size_t count) {
+			values.resize(count);
+			return values.data();
+		});
+	}
+
+	inline void SetBytesSXML(SerializationSXMLData& data, const unsigned char* bytes, size_t size)
+	{
+		if (data.IsBinary()) data.BinaryDocument->SetBytes(data.BinaryNode, bytes, size);
+		else SetXMLNodeValue(data.Document, data.Node, ToBinaryText(bytes, size).c_str());
+	}
+
+	// The data is allocated with new[] for binary documents and by the base64 decoder for XML documents.
+	inline void GetBytesSXML(DeserializationSXMLData& data, unsigned char*& bytes, size_t& size)
+	{
+		if (data.IsBinary() && data.BinaryDocument->GetValueType(data.BinaryNode) == BinarySXMLValueType::Bytes)
+		{
+			size = data.BinaryDocument->GetValueCount(data.BinaryNode);
+			bytes = new unsigned char[size];
+			if (size > 0) memcpy(bytes, data.BinaryDocument->GetValueData(data.BinaryNode), size);
+		}
+		else
+		{
+			data.PlaceNodeValue();
+			ToBinaryData(std::string(data.Chars->GetArray(), data.Chars->GetSize() - 1), bytes, size);
+		}
+	}
+
+#if defined(TARGET_PLATFORM_X64)
+	inline void GetBytesSXML(DeserializationSXMLData& data, unsigned char*& bytes, unsigned& size)
+	{
+		size_t sSize;
+		GetBytesSXML(data, bytes, sSize);
+		size = static_cast<unsigned>(sSize);
+	}
+#endif
 	
 	namespace detail
 	{
@@ -187,13 +407,7 @@ namespace Core
 		{
 			static inline void SerializeSXML(Core::SerializationSXMLData& data, const T* array, size_t size)
 			{
-				for (size_t i = 0; i < size; i++)
-				{
-					*data.SS << array[i];
-					if (i + 1 < size) *data.SS << ";";
-				}
-				Core::SetXMLNodeValue(data.Document, data.Node, data.SS->str().c_str());
-				data.SS->str("");
+				Core::SetValuesSXML(data, array, size);
 			}
 		};
 
@@ -220,9 +434,7 @@ namespace Core
 		{
 			static inline void SerializeSXML(Core::SerializationSXMLData& data, const T& object)
 			{
-				*data.SS << object;
-				SetXMLNodeValue(data.Document, data.Node, data.SS->str().c_str());
-				data.SS->str("");
+				Core::SetValuesSXML(data, &object, 1);
 			}
 		};
 
@@ -231,8 +443,15 @@ namespace Core
 		{
 			static inline void DeserializeSXML(Core::DeserializationSXMLData& data, T& object)
 			{
-				data.PlaceNodeValue();
-				object = Core::Parse<T>(data.Chars->GetArray());
+				if (data.IsBinary() && data.BinaryDocument->IsNumeric(data.BinaryNode))
+				{
+					Core::GetValuesSXML(data, &object, 1);
+				}
+				else
+				{
+					data.PlaceNodeValue();
+					object = Core::Parse<T>(data.Chars->GetArray());
+				}
 			}
 		};
 
@@ -255,14 +474,7 @@ namespace Core
 		{
 			static inline void DeserializeSXML(Core::DeserializationSXMLData& data, SimpleTypeVector<T, SizeType, AllocatorType>& v)
 			{
-				data.PlaceNodeValue();
-				auto parts = Core::Split(std::string(data.Chars), Core::IsCharacter(';'), true);
-				auto countParts = parts.size();
-				v.Resize(static_cast<SizeType>(countParts));
-				for (size_t i = 0; i < countParts; i++)
-				{
-					v[i] = Core::Parse<T>(parts[i].c_str());
-				}
+				Core::GetValuesSXML(data, v);
 			}
 		};
 
@@ -271,9 +483,9 @@ namespace Core
 		{
 			static inline void DeserializeSXML(Core::DeserializationSXMLData& data, SimpleTypeVector<T, SizeType, AllocatorType>& v)
 			{
-				for (auto cNode = data.Node->first_node(); cNode != nullptr; cNode = cNode->next_sibling())
+				for (auto cData = data.GetFirstChild(); cData.IsValid(); cData = cData.GetNextSibling())
 				{
-					_DeserializeSXMLDirectly(Core::DeserializationSXMLData{ cNode, data.Chars }, v.PushBackPlaceHolder());
+					_DeserializeSXMLDirectly(cData, v.PushBackPlaceHolder());
 				}
 			}
 		};
@@ -306,15 +518,7 @@ namespace Core
 		{
 			static inline void DeserializeSXML(Core::DeserializationSXMLData& data, std::vector<T>& v)
 			{
-				data.PlaceNodeValue();
-				auto parts = Core::Split(data.Chars->GetArray(), data.Chars->GetSize() - 1,
-					Core::IsCharacter(';'), true);
-				auto countParts = parts.size();
-				v.reserve(countParts);
-				for (size_t i = 0; i < countParts; i++)
-				{
-					v.emplace_back(Core::Parse<T>(parts[i].c_str()));
-				}
+				Core::GetValuesSXML(data, v);
 			}
 		};
 
@@ -323,10 +527,10 @@ namespace Core
 		{
 			static inline void DeserializeSXML(Core::DeserializationSXMLData& data, std::vector<T>& v)
 			{
-				for (auto cNode = data.Node->first_node(); cNode != nullptr; cNode = cNode->next_sibling())
+				for (auto cData = data.GetFirstChild(); cData.IsValid(); cData = cData.GetNextSibling())
 				{
 					v.emplace_back();
-					_DeserializeSXMLDirectly(Core::DeserializationSXMLData{ cNode, data.Chars }, v.back());
+					_DeserializeSXMLDirectly(cData, v.back());
 				}
 			}
 		};
@@ -359,11 +563,11 @@ namespace Core
 		{
 			static inline void DeserializeSXML(Core::DeserializationSXMLData& data, std::map<K, D>& m)
 			{
-				for (auto cNode = data.Node->first_node(); cNode != nullptr; cNode = cNode->next_sibling())
+				for (auto cData = data.GetFirstChild(); cData.IsValid(); cData = cData.GetNextSibling())
 				{
 					std::pair<K, D> p;
-					_DeserializeSXML(data, p.first, "key");
-					_DeserializeSXML(data, p.second, "val");
+					_DeserializeSXML(cData, p.first, "key");
+					_DeserializeSXML(cData, p.second, "val");
 					m.insert(std::move(p));
 				}
 			}
@@ -394,7 +598,8 @@ namespace Core
 		{
 			static inline void SerializeSXML(Core::SerializationSXMLData& data, const std::string& str)
 			{
-				SetXMLNodeValue(data.Document, data.Node, str.c_str());
+				if (data.IsBinary()) data.BinaryDocument->SetText(data.BinaryNode, str.data(), str.length());
+				else SetXMLNodeValue(data.Document, data.Node, str.c_str());
 			}
 		};
 
@@ -403,8 +608,33 @@ namespace Core
 		{
 			static inline void DeserializeSXML(Core::DeserializationSXMLData& data, std::string& str)
 			{
-				auto nodeValue = data.Node->value();
-				str = std::string(nodeValue, nodeValue + data.Node->value_size());
+				if (data.IsBinary())
+				{
+					data.BinaryDocument->FormatValue(data.BinaryNode, str);
+				}
+				else
+				{
+					auto nodeValue = data.Node->value();
+					str = std::string(nodeValue, nodeValue + data.Node->value_size());
+				}
+			}
+		};
+
+		template <>
+		struct SerializerSXML<SerializationBinaryDataWrapper, true>
+		{
+			static inline void SerializeSXML(Core::SerializationSXMLData& data, const SerializationBinaryDataWrapper& wrapper)
+			{
+				SetBytesSXML(data, wrapper.Data, wrapper.Size);
+			}
+		};
+
+		template <>
+		struct DeserializerSXML<DeserializationBinaryDataWrapper, true>
+		{
+			static inline void DeserializeSXML(Core::DeserializationSXMLData& data, DeserializationBinaryDataWrapper& wrapper)
+			{
+				GetBytesSXML(data, *wrapper.PData, *wrapper.PSize);
 			}
 		};
 	}
@@ -423,8 +653,9 @@ namespace Core
 		AddXMLAttribute(&document, declarationNode, "version", "1.0");
 		AddXMLAttribute(&document, declarationNode, "encoding", "utf-8");
 		document.append_node(declarationNode);
-		std::stringstream toStringSS;
-		SerializeSXML(SerializationSXMLData{ &document, &document, &toStringSS }, object, objectName);
+		Core::SimpleTypeVector<char> chars;
+		SerializationSXMLData data{ &document, &document, &chars };
+		SerializeSXML(data, object, objectName);
 		std::stringstream docSS;
 		docSS << document;
 		str = docSS.str();
@@ -446,9 +677,129 @@ namespace Core
 		buffer[size] = 0;
 		document.parse<0>(buffer);
 		Core::SimpleTypeVector<char> chars;
-		DeserializeSXML(DeserializationSXMLData{ &document, &chars }, object, objectName);
+		DeserializationSXMLData data{ &document, &chars };
+		DeserializeSXML(data, object, objectName);
 		delete[] buffer;
 	}
+
+	////////////////////////////////////// BINARY BACKEND //////////////////////////////////////
+
+	// Serializes to a binary document. The same SerializeSXML functions are used as for XML,
+	// but the numbers are stored as typed arrays and the binary data as raw bytes.
+	template <typename T>
+	inline void StartSerializeBinarySXML(ByteVector& bytes, const T& object, const char* objectName)
+	{
+		BinarySXMLDocument document;
+		Core::SimpleTypeVector<char> chars;
+		SerializationSXMLData data{ nullptr, nullptr, &chars, &document, BinarySXMLDocument::c_RootNode };
+		SerializeSXML(data, object, objectName);
+		document.Save(bytes);
+	}
+
+	template <typename T>
+	inline void StartDeserializeBinarySXML(const unsigned char* bytes, size_t size, T& object, const char* objectName)
+	{
+		BinarySXMLDocument document;
+		document.Load(bytes, size);
+		Core::SimpleTypeVector<char> chars;
+		DeserializationSXMLData data{ nullptr, &chars, &document, BinarySXMLDocument::c_RootNode };
+		DeserializeSXML(data, object, objectName);
+	}
+
+	inline bool IsBinarySXML(const unsigned char* bytes, size_t size)
+	{
+		return BinarySXMLDocument::IsBinarySXML(bytes, size);
+	}
+
+	// Deserializes either a binary or an XML document.
+	template <typename T>
+	inline void StartDeserializeAnySXML(const unsigned char* bytes, size_t size, T& object, const char* objectName)
+	{
+		if (IsBinarySXML(bytes, size))
+		{
+			StartDeserializeBinarySXML(bytes, size, object, objectName);
+		}
+		else
+		{
+			StartDeserializeSXML(std::string(reinterpret_cast<const char*>(bytes), size), object, objectName);
+		}
+	}
+
+	namespace detail
+	{
+		inline void ConvertXMLToBinarySXML(rapidxml::xml_node<>* xmlNode, BinarySXMLDocument& document,
+			unsigned binaryNode)
+		{
+			for (auto attribute = xmlNode->first_attribute(); attribute != nullptr; attribute = attribute->next_attribute())
+			{
+				auto binaryAttribute = document.AddNode(binaryNode,
+					std::string(attribute->name(), attribute->name_size()).c_str(), true);
+				document.SetText(binaryAttribute, attribute->value(), attribute->value_size());
+			}
+			for (auto child = xmlNode->first_node(); child != nullptr; child = child->next_sibling())
+			{
+				if (child->type() != rapidxml::node_element) continue;
+				auto binaryChild = document.AddNode(binaryNode, std::string(child->name(), child->name_size()).c_str());
+				if (child->value_size() > 0) document.SetText(binaryChild, child->value(), child->value_size());
+				ConvertXMLToBinarySXML(child, document, binaryChild);
+			}
+		}
+
+		inline void ConvertBinaryToXMLSXML(const BinarySXMLDocument& document, unsigned binaryNode,
+			rapidxml::xml_document<>* xmlDocument, rapidxml::xml_node<>* xmlNode, std::string& text)
+		{
+			for (auto child = document.GetFirstChild(binaryNode); child != c_InvalidIndexU;
+				child = document.GetNextSibling(child))
+			{
+				std::string name(document.GetName(child), document.GetNameSize(child));
+				if (document.GetValueType(child) == BinarySXMLValueType::Bytes)
+					text = ToBinaryText(document.GetValueData(child), document.GetValueCount(child));
+				else
+					document.FormatValue(child, text);
+
+				if (document.IsAttribute(child))
+				{
+					AddXMLAttribute(xmlDocument, xmlNode, name.c_str(), text.c_str());
+				}
+				else
+				{
+					auto xmlChild = CreateXMLNode(xmlDocument, xmlNode, name.c_str(),
+						document.GetValueType(child) == BinarySXMLValueType::None ? nullptr : text.c_str());
+					ConvertBinaryToXMLSXML(document, child, xmlDocument, xmlChild, text);
+				}
+			}
+		}
+	}
+
+	// Converts an XML document to the binary form. Since XML doesn't store the types,
+	// the values are stored as text, which are parsed when they are deserialized.
+	inline void ConvertXMLToBinarySXML(const std::string& str, ByteVector& bytes)
+	{
+		rapidxml::xml_document<> xmlDocument;
+		std::vector<char> buffer(str.begin(), str.end());
+		buffer.push_back(0);
+		xmlDocument.parse<0>(buffer.data());
+		BinarySXMLDocument document;
+		detail::ConvertXMLToBinarySXML(&xmlDocument, document, BinarySXMLDocument::c_RootNode);
+		document.Save(bytes);
+	}
+
+	// Converts a binary document to XML. The result is the same as serializing the object directly to XML.
+	inline void ConvertBinaryToXMLSXML(const unsigned char* bytes, size_t size, std::string& str)
+	{
+		BinarySXMLDocument document;
+		document.Load(bytes, size);
+		rapidxml::xml_document<> xmlDocument;
+		auto declarationNode = xmlDocument.allocate_node(rapidxml::node_declaration);
+		AddXMLAttribute(&xmlDocument, declarationNode, "version", "1.0");
+		AddXMLAttribute(&xmlDocument, declarationNode, "encoding", "utf-8");
+		xmlDocument.append_node(declarationNode);
+		std::string text;
+		detail::ConvertBinaryToXMLSXML(document, BinarySXMLDocument::c_RootNode, &xmlDocument, &xmlDocument, text);
+		std::stringstream docSS;
+		docSS << xmlDocument;
+		str = docSS.str();
+	}
 }
 
 #define Core_SerializeSXML(data, variable)	Core::SerializeSXML(data, variable, #variable)
@@ -0,0 +1,679 @@
+// Core/StreamBinarySerialization.cpp
+
+#include <Core/StreamBinarySerialization.h>
+
+#include <Core/Platform.h>
+#include <Core/Windows.h>
+#include <Core/Checksum.h>
+#include <Core/Compression.h>
+
+#ifndef IS_WINDOWS
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <cerrno>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <sstream>
+#include <stdexcept>
+
+namespace Core
+{
+	namespace detail
+	{
+		struct StreamFileData
+		{
+			std::string Path;
+#ifdef IS_WINDOWS
+			HANDLE		Handle;
+#else
+			int			FileDesc;
+#endif
+		};
+
+		inline void ThrowStreamFileError(const std::string& path, const char* operation)
+		{
+			std::stringstream ss;
+			ss << "An error has occured while " << operation << ": " << path;
+			throw std::runtime_error(ss.str().c_str());
+		}
+
+		inline size_t GetRecordPaddingSize(std::uint64_t headerEnd)
+		{
+			return static_cast<size_t>((c_AlignmentSB - headerEnd % c_AlignmentSB) % c_AlignmentSB);
+		}
+
+		inline void ThrowUnexpectedEndOfStream()
+		{
+			throw std::runtime_error("Unexpected end of the serialized stream.");
+		}
+
+		StreamFileData* OpenStreamFile(const char* path, bool isWriting)
+		{
+			std::unique_ptr<StreamFileData> pData(new StreamFileData());
+			pData->Path = path;
+#ifdef IS_WINDOWS
+			pData->Handle = (isWriting
+				? CreateFileA(path, GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+					FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr)
+				: CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+					FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr));
+			if (pData->Handle == INVALID_HANDLE_VALUE)
+			{
+				ThrowStreamFileError(pData->Path, "opening");
+			}
+#else
+			pData->FileDesc = (isWriting
+				? open(path, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH)
+				: open(path, O_RDONLY));
+			if (pData->FileDesc < 0)
+			{
+				ThrowStreamFileError(pData->Path, "opening");
+			}
+#endif
+			return pData.release();
+		}
+
+		bool CloseStreamFile(StreamFileData* pData)
+		{
+#ifdef IS_WINDOWS
+			return (CloseHandle(pData->Handle) != 0);
+#else
+			return (close(pData->FileDesc) == 0);
+#endif
+		}
+
+		void WriteStreamFile(StreamFileData* pData, const ConstBufferSB* buffers, size_t countBuffers)
+		{
+#ifdef IS_WINDOWS
+			const size_t c_MaxWriteSize = 1 << 30;
+			for (size_t i = 0; i < countBuffers; i++)
+			{
+				auto data = buffers[i].Data;
+				auto size = buffers[i].Size;
+				while (size > 0)
+				{
+					DWORD countWritten;
+					auto writeSize = static_cast<DWORD>(std::min(size, c_MaxWriteSize));
+					if (!WriteFile(pData->Handle, data, writeSize, &countWritten, nullptr))
+					{
+						ThrowStreamFileError(pData->Path, "writing");
+					}
+					data += countWritten;
+					size -= countWritten;
+				}
+			}
+#else
+			const size_t c_MaxCountVectors = 64;
+			iovec vectors[c_MaxCountVectors];
+			size_t bufferIndex = 0;
+			size_t bufferOffset = 0;
+			while (bufferIndex < countBuffers)
+			{
+				size_t countVectors = 0;
+				for (size_t i = bufferIndex; i < countBuffers && countVectors < c_MaxCountVectors; i++)
+				{
+					size_t offset = (i == bufferIndex ? bufferOffset : 0);
+					if (buffers[i].Size == offset) continue;
+					vectors[countVectors].iov_base = const_cast<unsigned char*>(buffers[i].Data + offset);
+					vectors[countVectors].iov_len = buffers[i].Size - offset;
+					countVectors++;
+				}
+				if (countVectors == 0) break;
+
+				auto countWritten = writev(pData->FileDesc, vectors, static_cast<int>(countVectors));
+				if (countWritten < 0)
+				{
+					if (errno == EINTR) continue;
+					ThrowStreamFileError(pData->Path, "writing");
+				}
+
+				// Advancing over the written data, handling partial writes.
+				auto remaining = static_cast<size_t>(countWritten);
+				while (bufferIndex < countBuffers)
+				{
+					size_t available = buffers[bufferIndex].Size - bufferOffset;
+					if (remaining < available)
+					{
+						bufferOffset += remaining;
+						break;
+					}
+					remaining -= available;
+					bufferIndex++;
+					bufferOffset = 0;
+				}
+			}
+#endif
+		}
+
+		// Returns the count of the read bytes, which is 0 at the end of the file.
+		size_t ReadStreamFile(StreamFileData* pData, unsigned char* data, size_t size)
+		{
+#ifdef IS_WINDOWS
+			const size_t c_MaxReadSize = 1 << 30;
+			DWORD countRead;
+			if (!ReadFile(pData->Handle, data, static_cast<DWORD>(std::min(size, c_MaxReadSize)), &countRead, nullptr))
+			{
+				ThrowStreamFileError(pData->Path, "reading");
+			}
+			return static_cast<size_t>(countRead);
+#else
+			while (true)
+			{
+				auto countRead = read(pData->FileDesc, data, size);
+				if (countRead >= 0) return static_cast<size_t>(countRead);
+				if (errno != EINTR) ThrowStreamFileError(pData->Path, "reading");
+			}
+#endif
+		}
+
+		// Seeking past the end of the file succeeds, thus the target offset is checked against the file size.
+		void SkipStreamFile(StreamFileData* pData, size_t size)
+		{
+#ifdef IS_WINDOWS
+			LARGE_INTEGER zero, position, fileSize;
+			zero.QuadPart = 0;
+			if (!SetFilePointerEx(pData->Handle, zero, &position, FILE_CURRENT)
+				|| !GetFileSizeEx(pData->Handle, &fileSize))
+			{
+				ThrowStreamFileError(pData->Path, "seeking");
+			}
+			if (fileSize.QuadPart < position.QuadPart
+				|| static_cast<std::uint64_t>(fileSize.QuadPart - position.QuadPart) < size)
+			{
+				ThrowUnexpectedEndOfStream();
+			}
+			LARGE_INTEGER distance;
+			distance.QuadPart = static_cast<LONGLONG>(size);
+			if (!SetFilePointerEx(pData->Handle, distance, nullptr, FILE_CURRENT))
+			{
+				ThrowStreamFileError(pData->Path, "seeking");
+			}
+#else
+			struct stat fileStat;
+			auto position = lseek(pData->FileDesc, 0, SEEK_CUR);
+			if (position < 0 || fstat(pData->FileDesc, &fileStat) < 0)
+			{
+				ThrowStreamFileError(pData->Path, "seeking");
+			}
+			if (fileStat.st_size < position
+				|| static_cast<std::uint64_t>(fileStat.st_size - position) < size)
+			{
+				ThrowUnexpectedEndOfStream();
+			}
+			if (lseek(pData->FileDesc, static_cast<off_t>(size), SEEK_CUR) < 0)
+			{
+				ThrowStreamFileError(pData->Path, "seeking");
+			}
+#endif
+		}
+	}
+
+	//////////////////////////////////////// OUTPUT SINKS ////////////////////////////////////////
+
+	void OutputSinkSB::WriteGather(const ConstBufferSB* buffers, size_t countBuffers)
+	{
+		for (size_t i = 0; i < countBuffers; i++)
+		{
+			Write(buffers[i].Data, buffers[i].Size);
+		}
+	}
+
+	FileOutputSinkSB::FileOutputSinkSB(const char* path, size_t bufferSize)
+		: m_File(detail::OpenStreamFile(path, true))
+		, m_BufferSize(bufferSize)
+	{
+		m_Buffer.Reserve(bufferSize);
+	}
+
+	FileOutputSinkSB::FileOutputSinkSB(const std::string& path, size_t bufferSize)
+		: FileOutputSinkSB(path.c_str(), bufferSize)
+	{
+	}
+
+	FileOutputSinkSB::~FileOutputSinkSB()
+	{
+		// Close should be called explicitly to handle the errors.
+		if (m_File != nullptr)
+		{
+			try
+			{
+				Close();
+			}
+			catch (...)
+			{
+			}
+		}
+	}
+
+	void FileOutputSinkSB::WriteToFile(const ConstBufferSB* buffers, size_t countBuffers)
+	{
+		assert(m_File != nullptr);
+		detail::WriteStreamFile(m_File.get(), buffers, countBuffers);
+	}
+
+	void FileOutputSinkSB::Write(const unsigned char* data, size_t size)
+	{
+		if (m_Buffer.GetSize() + size <= m_BufferSize)
+		{
+			m_Buffer.PushBack(data, size);
+		}
+		else
+		{
+			ConstBufferSB buffers[] = { { m_Buffer.GetArray(), m_Buffer.GetSize() }, { data, size } };
+			WriteToFile(buffers, 2);
+			m_Buffer.Clear();
+		}
+	}
+
+	void FileOutputSinkSB::WriteGather(const ConstBufferSB* buffers, size_t countBuffers)
+	{
+		size_t totalSize = 0;
+		for (size_t i = 0; i < countBuffers; i++) totalSize += buffers[i].Size;
+
+		if (m_Buffer.GetSize() + totalSize <= m_BufferSize)
+		{
+			for (size_t i = 0; i < countBuffers; i++)
+			{
+				if (buffers[i].Size > 0) m_Buffer.PushBack(buffers[i].Data, buffers[i].Size);
+			}
+		}
+		else
+		{
+			SimpleTypeVector<ConstBufferSB> allBuffers;
+			allBuffers.Reserve(countBuffers + 1);
+			allBuffers.UnsafePushBack(ConstBufferSB{ m_Buffer.GetArray(), m_Buffer.GetSize() });
+			allBuffers.UnsafePushBack(buffers, countBuffers);
+			WriteToFile(allBuffers.GetArray(), allBuffers.GetSize());
+			m_Buffer.Clear();
+		}
+	}
+
+	void FileOutputSinkSB::Flush()
+	{
+		if (!m_Buffer.IsEmpty())
+		{
+			ConstBufferSB buffer = { m_Buffer.GetArray(), m_Buffer.GetSize() };
+			WriteToFile(&buffer, 1);
+			m_Buffer.Clear();
+		}
+	}
+
+	void FileOutputSinkSB::Close()
+	{
+		if (m_File == nullptr) return;
+
+		// The file is closed even if flushing fails.
+		std::exception_ptr flushException;
+		try
+		{
+			Flush();
+		}
+		catch (...)
+		{
+			flushException = std::current_exception();
+		}
+		m_Buffer.Clear();
+		bool isClosed = detail::CloseStreamFile(m_File.get());
+		auto path = std::move(m_File->Path);
+		m_File.reset();
+
+		if (flushException) std::rethrow_exception(flushException);
+		if (!isClosed) detail::ThrowStreamFileError(path, "closing");
+	}
+
+	MemoryOutputSinkSB::MemoryOutputSinkSB(ByteVector& bytes)
+		: m_Bytes(&bytes)
+	{
+	}
+
+	void MemoryOutputSinkSB::Write(const unsigned char* data, size_t size)
+	{
+		m_Bytes->PushBack(data, size);
+	}
+
+	HashingOutputSinkSB::HashingOutputSinkSB(OutputSinkSB* next)
+		: m_Next(next)
+		, m_CRC32C(0)
+		, m_CountBytes(0)
+	{
+	}
+
+	void HashingOutputSinkSB::Write(const unsigned char* data, size_t size)
+	{
+		m_CRC32C = ComputeCRC32C(data, size, m_CRC32C);
+		m_CountBytes += size;
+		if (m_Next != nullptr) m_Next->Write(data, size);
+	}
+
+	void HashingOutputSinkSB::WriteGather(const ConstBufferSB* buffers, size_t countBuffers)
+	{
+		for (size_t i = 0; i < countBuffers; i++)
+		{
+			m_CRC32C = ComputeCRC32C(buffers[i].Data, buffers[i].Size, m_CRC32C);
+			m_CountBytes += buffers[i].Size;
+		}
+		if (m_Next != nullptr) m_Next->WriteGather(buffers, countBuffers);
+	}
+
+	void HashingOutputSinkSB::Flush()
+	{
+		if (m_Next != nullptr) m_Next->Flush();
+	}
+
+	std::uint32_t HashingOutputSinkSB::GetCRC32C() const
+	{
+		return m_CRC32C;
+	}
+
+	std::uint64_t HashingOutputSinkSB::GetCountBytes() const
+	{
+		return m_CountBytes;
+	}
+
+	CompressingOutputSinkSB::CompressingOutputSinkSB(OutputSinkSB& next, size_t blockSize)
+		: m_Next(&next)
+		, m_BlockSize(blockSize)
+	{
+		assert(blockSize > 0 && blockSize <= 0xffffffffU);
+		m_Buffer.Reserve(blockSize);
+	}
+
+	void CompressingOutputSinkSB::WriteBlock(const unsigned char* data, size_t size)
+	{
+		const size_t c_HeaderSize = 2 * sizeof(std::uint32_t);
+		m_CompressedBuffer.Resize(c_HeaderSize);
+		CompressLZ(data, size, m_CompressedBuffer);
+
+		auto decompressedSize = static_cast<std::uint32_t>(size);
+		auto storedSize = static_cast<std::uint32_t>(m_CompressedBuffer.GetSize() - c_HeaderSize);
+		bool isStoringUncompressed = (storedSize >= decompressedSize);
+		if (isStoringUncompressed) storedSize = decompressedSize;
+
+		memcpy(m_CompressedBuffer.GetArray(), &decompressedSize, sizeof(std::uint32_t));
+		memcpy(m_CompressedBuffer.GetArray() + sizeof(std::uint32_t), &storedSize, sizeof(std::uint32_t));
+
+		if (isStoringUncompressed)
+		{
+			ConstBufferSB buffers[] = { { m_CompressedBuffer.GetArray(), c_HeaderSize }, { data, size } };
+			m_Next->WriteGather(buffers, 2);
+		}
+		else
+		{
+			m_Next->Write(m_CompressedBuffer.GetArray(), m_CompressedBuffer.GetSize());
+		}
+	}
+
+	void CompressingOutputSinkSB::Write(const unsigned char* data, size_t size)
+	{
+		while (size > 0)
+		{
+			size_t countCopied = std::min(size, m_BlockSize - m_Buffer.GetSize());
+			m_Buffer.PushBack(data, countCopied);
+			data += countCopied;
+			size -= countCopied;
+			if (m_Buffer.GetSize() == m_BlockSize)
+			{
+				WriteBlock(m_Buffer.GetArray(), m_Buffer.GetSize());
+				m_Buffer.Clear();
+			}
+		}
+	}
+
+	void CompressingOutputSinkSB::Flush()
+	{
+		if (!m_Buffer.IsEmpty())
+		{
+			WriteBlock(m_Buffer.GetArray(), m_Buffer.GetSize());
+			m_Buffer.Clear();
+		}
+		m_Next->Flush();
+	}
+
+	//////////////////////////////////////// INPUT SOURCES ////////////////////////////////////////
+
+	const unsigned char* InputSourceSB::Acquire(size_t size, ByteVector& buffer)
+	{
+		buffer.Resize(size);
+		Read(buffer.GetArray(), size);
+		return buffer.GetArray();
+	}
+
+	void InputSourceSB::Skip(size_t size)
+	{
+		const size_t c_ChunkSize = 1 << 16;
+		unsigned char chunk[c_ChunkSize];
+		while (size > 0)
+		{
+			size_t countRead = std::min(size, c_ChunkSize);
+			Read(chunk, countRead);
+			size -= countRead;
+		}
+	}
+
+	MemoryInputSourceSB::MemoryInputSourceSB(const unsigned char* data, size_t size)
+		: m_Data(data)
+		, m_End(data + size)
+	{
+	}
+
+	void MemoryInputSourceSB::CheckAvailable(size_t size) const
+	{
+		if (size > static_cast<size_t>(m_End - m_Data)) detail::ThrowUnexpectedEndOfStream();
+	}
+
+	void MemoryInputSourceSB::Read(unsigned char* data, size_t size)
+	{
+		CheckAvailable(size);
+		memcpy(data, m_Data, size);
+		m_Data += size;
+	}
+
+	const unsigned char* MemoryInputSourceSB::Acquire(size_t size, ByteVector&)
+	{
+		CheckAvailable(size);
+		auto result = m_Data;
+		m_Data += size;
+		return result;
+	}
+
+	void MemoryInputSourceSB::Skip(size_t size)
+	{
+		CheckAvailable(size);
+		m_Data += size;
+	}
+
+	size_t MemoryInputSourceSB::GetCountRemainingBytes() const
+	{
+		return static_cast<size_t>(m_End - m_Data);
+	}
+
+	FileInputSourceSB::FileInputSourceSB(const char* path, size_t bufferSize)
+		: m_File(detail::OpenStreamFile(path, false))
+		, m_BufferPosition(0)
+		, m_BufferSize(bufferSize)
+	{
+		m_Buffer.Reserve(bufferSize);
+	}
+
+	FileInputSourceSB::FileInputSourceSB(const std::string& path, size_t bufferSize)
+		: FileInputSourceSB(path.c_str(), bufferSize)
+	{
+	}
+
+	FileInputSourceSB::~FileInputSourceSB()
+	{
+		detail::CloseStreamFile(m_File.get());
+	}
+
+	size_t FileInputSourceSB::ReadFromFile(unsigned char* data, size_t size)
+	{
+		return detail::ReadStreamFile(m_File.get(), data, size);
+	}
+
+	void FileInputSourceSB::Read(unsigned char* data, size_t size)
+	{
+		while (size > 0)
+		{
+			size_t countAvailable = m_Buffer.GetSize() - m_BufferPosition;
+			if (countAvailable > 0)
+			{
+				size_t countCopied = std::min(size, countAvailable);
+				memcpy(data, m_Buffer.GetArray() + m_BufferPosition, countCopied);
+				m_BufferPosition += countCopied;
+				data += countCopied;
+				size -= countCopied;
+			}
+			else if (size >= m_BufferSize)
+			{
+				// Large reads bypass the buffer.
+				size_t countRead = ReadFromFile(data, size);
+				if (countRead == 0) detail::ThrowUnexpectedEndOfStream();
+				data += countRead;
+				size -= countRead;
+			}
+			else
+			{
+				m_Buffer.Resize(m_BufferSize);
+				size_t countRead = ReadFromFile(m_Buffer.GetArray(), m_BufferSize);
+				if (countRead == 0) detail::ThrowUnexpectedEndOfStream();
+				m_Buffer.Resize(countRead);
+				m_BufferPosition = 0;
+			}
+		}
+	}
+
+	void FileInputSourceSB::Skip(size_t size)
+	{
+		size_t countSkippedInBuffer = std::min(size, m_Buffer.GetSize() - m_BufferPosition);
+		m_BufferPosition += countSkippedInBuffer;
+		size -= countSkippedInBuffer;
+		if (size > 0)
+		{
+			detail::SkipStreamFile(m_File.get(), size);
+		}
+	}
+
+	DecompressingInputSourceSB::DecompressingInputSourceSB(InputSourceSB& source)
+		: m_Source(&source)
+		, m_BlockPosition(0)
+	{
+	}
+
+	void DecompressingInputSourceSB::ReadBlock()
+	{
+		std::uint32_t decompressedSize, storedSize;
+		m_Source->Read(reinterpret_cast<unsigned char*>(&decompressedSize), sizeof(std::uint32_t));
+		m_Source->Read(reinterpret_cast<unsigned char*>(&storedSize), sizeof(std::uint32_t));
+		if (decompressedSize == 0 || storedSize > decompressedSize)
+		{
+			throw std::runtime_error("The compressed stream is corrupt.");
+		}
+
+		m_Block.Resize(decompressedSize);
+		if (storedSize == decompressedSize)
+		{
+			m_Source->Read(m_Block.GetArray(), decompressedSize);
+		}
+		else
+		{
+			auto compressedData = m_Source->Acquire(storedSize, m_CompressedBlock);
+			DecompressLZ(compressedData, storedSize, m_Block.GetArray(), decompressedSize);
+		}
+		m_BlockPosition = 0;
+	}
+
+	void DecompressingInputSourceSB::Read(unsigned char* data, size_t size)
+	{
+		while (size > 0)
+		{
+			if (m_BlockPosition == m_Block.GetSize()) ReadBlock();
+			size_t countCopied = std::min(size, m_Block.GetSize() - m_BlockPosition);
+			memcpy(data, m_Block.GetArray() + m_BlockPosition, countCopied);
+			m_BlockPosition += countCopied;
+			data += countCopied;
+			size -= countCopied;
+		}
+	}
+
+	//////////////////////////////////////// SERIALIZER ////////////////////////////////////////
+
+	StreamSerializerSB::StreamSerializerSB(OutputSinkSB& sink, std::uint64_t startPosition)
+		: m_Sink(&sink)
+		, m_Position(startPosition)
+	{
+	}
+
+	void StreamSerializerSB::WriteRecord(const unsigned char* data0, size_t size0,
+		const unsigned char* data1, size_t size1)
+	{
+		unsigned char header[sizeof(std::uint64_t) + c_AlignmentSB] = {};
+		std::uint64_t payloadSize = size0 + size1;
+		memcpy(header, &payloadSize, sizeof(std::uint64_t));
+		size_t headerSize = sizeof(std::uint64_t) + detail::GetRecordPaddingSize(m_Position + sizeof(std::uint64_t));
+
+		ConstBufferSB buffers[] = { { header, headerSize }, { data0, size0 }, { data1, size1 } };
+		m_Sink->WriteGather(buffers, (size1 > 0 ? 3 : 2));
+		m_Position += headerSize + payloadSize;
+	}
+
+	void StreamSerializerSB::Flush()
+	{
+		m_Sink->Flush();
+	}
+
+	std::uint64_t StreamSerializerSB::GetPosition() const
+	{
+		return m_Position;
+	}
+
+	//////////////////////////////////////// DESERIALIZER ////////////////////////////////////////
+
+	StreamDeserializerSB::StreamDeserializerSB(InputSourceSB& source, std::uint64_t startPosition)
+		: m_Source(&source)
+		, m_Position(startPosition)
+	{
+	}
+
+	const unsigned char* StreamDeserializerSB::AcquireRecord(size_t& payloadSize)
+	{
+		std::uint64_t size;
+		m_Source->Read(reinterpret_cast<unsigned char*>(&size), sizeof(std::uint64_t));
+		if (size > static_cast<std::uint64_t>(static_cast<size_t>(-1)))
+		{
+			throw std::runtime_error("The serialized record is too large.");
+		}
+		size_t paddingSize = detail::GetRecordPaddingSize(m_Position + sizeof(std::uint64_t));
+		m_Source->Skip(paddingSize);
+		payloadSize = static_cast<size_t>(size);
+		m_Position += sizeof(std::uint64_t) + paddingSize + payloadSize;
+		return m_Source->Acquire(payloadSize, m_Buffer);
+	}
+
+	void StreamDeserializerSB::CheckRecordEnd(const unsigned char* bytes, const unsigned char* end) const
+	{
+		if (bytes != end)
+		{
+			throw std::runtime_error("The deserialized object doesn't match the size of the serialized record.");
+		}
+	}
+
+	void StreamDeserializerSB::SkipRecord()
+	{
+		std::uint64_t size;
+		m_Source->Read(reinterpret_cast<unsigned char*>(&size), sizeof(std::uint64_t));
+		size_t skippedSize = detail::GetRecordPaddingSize(m_Position + sizeof(std::uint64_t)) + static_cast<size_t>(size);
+		m_Source->Skip(skippedSize);
+		m_Position += sizeof(std::uint64_t) + skippedSize;
+	}
+
+	std::uint64_t StreamDeserializerSB::GetPosition() const
+	{
+		return m_Position;
+	}
+}
@@ -0,0 +1,303 @@
+// Core/StreamBinarySerialization.h
+
+#ifndef _CORE_STREAMBINARYSERIALIZATION_H_INCLUDED_
+#define _CORE_STREAMBINARYSERIALIZATION_H_INCLUDED_
+
+#include <Core/SimpleBinarySerialization.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace Core
+{
+	namespace detail
+	{
+		struct StreamFileData;
+	}
+
+	const size_t c_DefaultStreamBufferSizeSB = 1 << 20;
+
+	struct ConstBufferSB
+	{
+		const unsigned char* Data;
+		size_t Size;
+	};
+
+	//////////////////////////////////////// OUTPUT SINKS ////////////////////////////////////////
+
+	// Destination of streamed serialized data.
+	class OutputSinkSB
+	{
+	public:
+
+		virtual ~OutputSinkSB() {}
+
+		virtual void Write(const unsigned char* data, size_t size) = 0;
+
+		// Writes multiple buffers. Sinks may implement it as a single gather operation.
+		virtual void WriteGather(const ConstBufferSB* buffers, size_t countBuffers);
+
+		// Writes the buffered data to the final destination.
+		virtual void Flush() {}
+	};
+
+	// Buffered file output. Writes which don't fit into the buffer are written directly together with
+	// the buffered data in a single gather operation (writev on POSIX systems).
+	// Close must be called to flush the data and to check for errors.
+	class FileOutputSinkSB : public OutputSinkSB
+	{
+		std::unique_ptr<detail::StreamFileData> m_File;
+		ByteVector m_Buffer;
+		size_t m_BufferSize;
+
+		void WriteToFile(const ConstBufferSB* buffers, size_t countBuffers);
+
+	public:
+
+		explicit FileOutputSinkSB(const char* path, size_t bufferSize = c_DefaultStreamBufferSizeSB);
+		explicit FileOutputSinkSB(const std::string& path, size_t bufferSize = c_DefaultStreamBufferSizeSB);
+		~FileOutputSinkSB();
+
+		void Write(const unsigned char* data, size_t size) override;
+		void WriteGather(const ConstBufferSB* buffers, size_t countBuffers) override;
+		void Flush() override;
+
+		void Close();
+	};
+
+	// Appends the data to a byte vector.
+	class MemoryOutputSinkSB : public OutputSinkSB
+	{
+		ByteVector* m_Bytes;
+
+	public:
+
+		explicit MemoryOutputSinkSB(ByteVector& bytes);
+
+		void Write(const unsigned char* data, size_t size) override;
+	};
+
+	// Computes the CRC-32C checksum of the data and forwards it to the next sink, if there is one.
+	class HashingOutputSinkSB : public OutputSinkSB
+	{
+		OutputSinkSB* m_Next;
+		std::uint32_t m_CRC32C;
+		std::uint64_t m_CountBytes;
+
+	public:
+
+		explicit HashingOutputSinkSB(OutputSinkSB* next = nullptr);
+
+		void Write(const unsigned char* data, size_t size) override;
+		void WriteGather(const ConstBufferSB* buffers, size_t countBuffers) override;
+		void Flush() override;
+
+		std::uint32_t GetCRC32C() const;
+		std::uint64_t GetCountBytes() const;
+	};
+
+	// Compresses the data in blocks with CompressLZ and writes the blocks to the next sink.
+	// Block layout: uint32 decompressed size, uint32 stored size, stored data. If the stored size
+	// equals to the decompressed size, the block is stored uncompressed.
+	// Flush must be called after the last write.
+	class CompressingOutputSinkSB : public OutputSinkSB
+	{
+		OutputSinkSB* m_Next;
+		ByteVector m_Buffer;
+		ByteVector m_CompressedBuffer;
+		size_t m_BlockSize;
+
+		void WriteBlock(const unsigned char* data, size_t size);
+
+	public:
+
+		static const size_t c_DefaultBlockSize = 1 << 18;
+
+		explicit CompressingOutputSinkSB(OutputSinkSB& next, size_t blockSize = c_DefaultBlockSize);
+
+		void Write(const unsigned char* data, size_t size) override;
+		void Flush() override;
+	};
+
+	//////////////////////////////////////// INPUT SOURCES ////////////////////////////////////////
+
+	// Source of streamed serialized data.
+	class InputSourceSB
+	{
+	public:
+
+		virtual ~InputSourceSB() {}
+
+		// Reads exactly 'size' bytes. Throws if the source ends earlier.
+		virtual void Read(unsigned char* data, size_t size) = 0;
+
+		// Consumes the next 'size' bytes and returns a pointer to them. The data is either accessed in-place
+		// or read to the given buffer. In the latter case the pointer is valid until the buffer is modified.
+		virtual const unsigned char* Acquire(size_t size, ByteVector& buffer);
+
+		virtual void Skip(size_t size);
+	};
+
+	// Reads from memory, e.g. from a memory-mapped file. Acquire doesn't copy the data.
+	class MemoryInputSourceSB : public InputSourceSB
+	{
+		const unsigned char* m_Data;
+		const unsigned char* m_End;
+
+		void CheckAvailable(size_t size) const;
+
+	public:
+
+		MemoryInputSourceSB(const unsigned char* data, size_t size);
+
+		void Read(unsigned char* data, size_t size) override;
+		const unsigned char* Acquire(size_t size, ByteVector& buffer) override;
+		void Skip(size_t size) override;
+
+		size_t GetCountRemainingBytes() const;
+	};
+
+	// Buffered file input. Reads which are larger than the buffer are read directly to the destination.
+	class FileInputSourceSB : public InputSourceSB
+	{
+		std::unique_ptr<detail::StreamFileData> m_File;
+		ByteVector m_Buffer;
+		size_t m_BufferPosition;
+		size_t m_BufferSize;
+
+		size_t ReadFromFile(unsigned char* data, size_t size);
+
+	public:
+
+		explicit FileInputSourceSB(const char* path, size_t bufferSize = c_DefaultStreamBufferSizeSB);
+		explicit FileInputSourceSB(const std::string& path, size_t bufferSize = c_DefaultStreamBufferSizeSB);
+		~FileInputSourceSB();
+
+		void Read(unsigned char* data, size_t size) override;
+		void Skip(size_t size) override;
+	};
+
+	// Decompresses the blocks written by a CompressingOutputSinkSB.
+	class DecompressingInputSourceSB : public InputSourceSB
+	{
+		InputSourceSB* m_Source;
+		ByteVector m_Block;
+		ByteVector m_CompressedBlock;
+		size_t m_BlockPosition;
+
+		void ReadBlock();
+
+	public:
+
+		explicit DecompressingInputSourceSB(InputSourceSB& source);
+
+		void Read(unsigned char* data, size_t size) override;
+	};
+
+	//////////////////////////////////////// SERIALIZER ////////////////////////////////////////
+
+	// Serializes objects to an output sink as a sequence of records. A record contains one object, thus the memory
+	// usage is bounded by the largest object instead of the whole stream. Aligned arrays are written directly
+	// to the sink without copying.
+	//
+	// Record layout: uint64 payload size, padding, payload. The payload is aligned to c_AlignmentSB relative to
+	// the beginning of the stream, thus the aligned arrays of a file can be viewed in-place in a memory mapping.
+	class StreamSerializerSB
+	{
+		OutputSinkSB* m_Sink;
+		ByteVector m_Buffer;
+		std::uint64_t m_Position;
+
+		void WriteRecord(const unsigned char* data0, size_t size0, const unsigned char* data1, size_t size1);
+
+	public:
+
+		explicit StreamSerializerSB(OutputSinkSB& sink, std::uint64_t startPosition = 0);
+
+		template <typename T>
+		inline void Serialize(const T& object)
+		{
+			m_Buffer.Clear();
+			SerializeSB(m_Buffer, object);
+			WriteRecord(m_Buffer.GetArray(), m_Buffer.GetSize(), nullptr, 0);
+		}
+
+		// Writes the array in the format of SerializeAlignedSB.
+		template <typename T>
+		inline void SerializeAligned(const T* data, size_t size)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be serialized aligned.");
+			m_Buffer.Clear();
+			detail::SerializeSizeSB(m_Buffer, size);
+			detail::SerializeAlignmentPaddingSB(m_Buffer);
+			WriteRecord(m_Buffer.GetArray(), m_Buffer.GetSize(),
+				reinterpret_cast<const unsigned char*>(data), size * sizeof(T));
+		}
+
+		template <typename T, typename SizeType, typename AllocatorType>
+		inline void SerializeAligned(const SimpleTypeVector<T, SizeType, AllocatorType>& v)
+		{
+			SerializeAligned(v.GetArray(), static_cast<size_t>(v.GetSize()));
+		}
+
+		void Flush();
+
+		std::uint64_t GetPosition() const;
+	};
+
+	//////////////////////////////////////// DESERIALIZER ////////////////////////////////////////
+
+	// Deserializes the records written by a StreamSerializerSB.
+	class StreamDeserializerSB
+	{
+		InputSourceSB* m_Source;
+		ByteVector m_Buffer;
+		std::uint64_t m_Position;
+
+		const unsigned char* AcquireRecord(size_t& payloadSize);
+		void CheckRecordEnd(const unsigned char* bytes, const unsigned char* end) const;
+
+	public:
+
+		explicit StreamDeserializerSB(InputSourceSB& source, std::uint64_t startPosition = 0);
+
+		template <typename T>
+		inline void Deserialize(T& object)
+		{
+			size_t payloadSize;
+			auto payload = AcquireRecord(payloadSize);
+			auto bytes = payload;
+			DeserializeSB(bytes, object);
+			CheckRecordEnd(bytes, payload + payloadSize);
+		}
+
+		template <typename T, typename SizeType, typename AllocatorType>
+		inline void DeserializeAligned(SimpleTypeVector<T, SizeType, AllocatorType>& v)
+		{
+			size_t payloadSize;
+			auto payload = AcquireRecord(payloadSize);
+			auto bytes = payload;
+			DeserializeAlignedSB(bytes, v);
+			CheckRecordEnd(bytes, payload + payloadSize);
+		}
+
+		// Views an aligned array. If the source is a MemoryInputSourceSB, the view points to the source's memory,
+		// otherwise it is only valid until the next call of the deserializer.
+		template <typename T>
+		inline void DeserializeView(ArrayView<T>& view)
+		{
+			size_t payloadSize;
+			auto payload = AcquireRecord(payloadSize);
+			auto bytes = payload;
+			DeserializeViewSB(bytes, payload + payloadSize, view);
+			CheckRecordEnd(bytes, payload + payloadSize);
+		}
+
+		void SkipRecord();
+
+		std::uint64_t GetPosition() const;
+	};
+}
+
+#endif
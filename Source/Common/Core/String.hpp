@@ -15,8 +15,13 @@
 #include <cassert>
 #include <codecvt>
 #include <cstdlib>
+#include <cstdint>
+#include <string_view>
 
 #include <Core/Platform.h>
+#include <Core/FastFormat.hpp>
+#include <Core/StringSearch.h>
+#include <Core/Checksum.h>
 
 namespace Core
 {
@@ -50,6 +55,11 @@ namespace Core
 		{
 			return (ch == m_C);
 		}
+
+		char GetCharacter() const
+		{
+			return m_C;
+		}
 	};
 
 	class IsAnyOf
@@ -73,6 +83,16 @@ namespace Core
 			auto end = m_Chars.end();
 			return (std::find(m_Chars.begin(), end, ch) != end);
 		}
+
+		const char* GetCharacters() const
+		{
+			return m_Chars.data();
+		}
+
+		size_t GetCountCharacters() const
+		{
+			return m_Chars.size();
+		}
 	};
 
 	class IsWhitespace
@@ -95,6 +115,39 @@ namespace Core
 		}
 	};
 
+	namespace detail
+	{
+		// Returns the index of the first character which is accepted by the predicate or 'length'.
+		// The predefined predicates use vectorized search.
+		template <typename PredicateType>
+		inline size_t FindFirst(const char* str, size_t length, const PredicateType& predicate)
+		{
+			size_t i = 0;
+			for (; i < length && !predicate(str[i]); i++);
+			return i;
+		}
+
+		inline size_t FindFirst(const char* str, size_t length, const IsCharacter& predicate)
+		{
+			return FindCharacter(str, length, predicate.GetCharacter());
+		}
+
+		inline size_t FindFirst(const char* str, size_t length, const IsAnyOf& predicate)
+		{
+			return FindAnyOf(str, length, predicate.GetCharacters(), predicate.GetCountCharacters());
+		}
+
+		inline size_t FindFirst(const char* str, size_t length, const IsWhitespace&)
+		{
+			return FindWhitespace(str, length);
+		}
+
+		inline size_t FindFirst(const char* str, size_t length, const IsNewLine&)
+		{
+			return FindAnyOf(str, length, "\n\r", 2);
+		}
+	}
+
 	/////////////////////////////////////// TRIM ///////////////////////////////////////
 
 	namespace detail
@@ -137,6 +190,16 @@ namespace Core
 			return (i + 1);
 		}
 
+		inline size_t GetLeftTrimIndex(const std::string& str, const IsWhitespace&)
+		{
+			return FindNonWhitespace(str.data(), str.length());
+		}
+
+		inline size_t GetRightTrimIndex(const std::string& str, const IsWhitespace&)
+		{
+			return FindEndOfNonWhitespace(str.data(), str.length());
+		}
+
 		inline void CopyToBegining(std::string& str, size_t startIndex, size_t endIndex)
 		{
 			if (endIndex < startIndex)
@@ -146,10 +209,7 @@ namespace Core
 			else
 			{
 				size_t length = endIndex - startIndex;
-				for (size_t targetIndex = 0; targetIndex < length; targetIndex++, startIndex++)
-				{
-					str[targetIndex] = str[startIndex];
-				}
+				if (startIndex > 0 && length > 0) memmove(&str[0], &str[startIndex], length);
 				str.resize(length);
 			}
 		}
@@ -226,6 +286,14 @@ namespace Core
 		return Trim(std::move(str), IsWhitespace());
 	}
 
+	// Trims without copying.
+	inline std::string_view TrimView(std::string_view str)
+	{
+		size_t end = FindEndOfNonWhitespace(str.data(), str.length());
+		size_t start = FindNonWhitespace(str.data(), end);
+		return str.substr(start, end - start);
+	}
+
 	template <typename PredicateType>
 	inline void TrimInPlace(std::string& str, const PredicateType& predicate)
 	{
@@ -265,15 +333,7 @@ namespace Core
 	{
 		inline bool IsStartingWith(const std::string& str, const std::string& test, size_t startIndex)
 		{
-			size_t testLength = test.length();
-			for (size_t i = 0; i < testLength; i++)
-			{
-				if (str[startIndex + i] != test[i])
-				{
-					return false;
-				}
-			}
-			return true;
+			return (memcmp(str.data() + startIndex, test.data(), test.length()) == 0);
 		}
 	}
 
@@ -296,24 +356,7 @@ namespace Core
 		{
 			return false;
 		}
-		size_t checkLength = length - testLength;
-		for (size_t i = 0; i <= checkLength; i++)
-		{
-			bool isMatching = true;
-			for (size_t j = 0; j < testLength; j++)
-			{
-				if (str[i + j] != test[j])
-				{
-					isMatching = false;
-					break;
-				}
-			}
-			if (isMatching)
-			{
-				return true;
-			}
-		}
-		return false;
+		return (testLength == 0 || FindSubstring(str.data(), length, test.data(), testLength) < length);
 	}
 
 	/////////////////////////////////////// REPLACE ///////////////////////////////////////
@@ -465,27 +508,120 @@ namespace Core
 	}
 
 	/////////////////////////////////////// SPLIT ///////////////////////////////////////
-	
+
+	// Iterates over the parts of a string, which are separated by the characters accepted by the predicate.
+	// The parts refer to the string, thus no allocation is performed.
+	//
+	//   for (auto part : Core::SplitView(line, Core::IsCharacter(','), true)) { ... }
 	template <typename PredicateType>
-	inline void Split(const char* str, size_t length, const PredicateType& predicate,
-		bool isIgnoringEmptyResults, std::vector<std::string>& result)
+	class StringSplitRange
 	{
-		result.clear();
-		size_t start = 0;
-		for (size_t i = 0; i < length; i++)
+		std::string_view m_Str;
+		PredicateType m_Predicate;
+		bool m_IsIgnoringEmptyResults;
+
+	public:
+
+		class Iterator
 		{
-			if (predicate(str[i]))
+			const StringSplitRange* m_Range;
+			size_t m_Start;
+			size_t m_End;
+
+			inline void FindEnd()
+			{
+				auto& str = m_Range->m_Str;
+				m_End = m_Start + detail::FindFirst(str.data() + m_Start, str.length() - m_Start, m_Range->m_Predicate);
+			}
+
+			inline void SkipEmptyResults()
 			{
-				if (i > start || !isIgnoringEmptyResults)
+				if (!m_Range->m_IsIgnoringEmptyResults) return;
+				while (m_End == m_Start)
 				{
-					result.push_back(std::string(str + start, str + i));
+					if (m_End == m_Range->m_Str.length()) { m_Range = nullptr; return; }
+					m_Start = m_End + 1;
+					FindEnd();
 				}
-				start = i + 1;
 			}
+
+		public:
+
+			// End iterator.
+			Iterator()
+				: m_Range(nullptr), m_Start(0), m_End(0)
+			{
+			}
+
+			explicit Iterator(const StringSplitRange* range)
+				: m_Range(range), m_Start(0)
+			{
+				FindEnd();
+				SkipEmptyResults();
+			}
+
+			std::string_view operator*() const
+			{
+				return m_Range->m_Str.substr(m_Start, m_End - m_Start);
+			}
+
+			Iterator& operator++()
+			{
+				if (m_End == m_Range->m_Str.length())
+				{
+					m_Range = nullptr;
+				}
+				else
+				{
+					m_Start = m_End + 1;
+					FindEnd();
+					SkipEmptyResults();
+				}
+				return *this;
+			}
+
+			bool operator==(const Iterator& other) const
+			{
+				return (m_Range == other.m_Range && (m_Range == nullptr || m_Start == other.m_Start));
+			}
+
+			bool operator!=(const Iterator& other) const
+			{
+				return !(*this == other);
+			}
+		};
+
+		StringSplitRange(std::string_view str, const PredicateType& predicate, bool isIgnoringEmptyResults)
+			: m_Str(str)
+			, m_Predicate(predicate)
+			, m_IsIgnoringEmptyResults(isIgnoringEmptyResults)
+		{
 		}
-		if (length > start || !isIgnoringEmptyResults)
+
+		Iterator begin() const { return Iterator(this); }
+		Iterator end() const { return Iterator(); }
+	};
+
+	template <typename PredicateType>
+	inline StringSplitRange<PredicateType> SplitView(std::string_view str, const PredicateType& predicate,
+		bool isIgnoringEmptyResults)
+	{
+		return StringSplitRange<PredicateType>(str, predicate, isIgnoringEmptyResults);
+	}
+
+	inline StringSplitRange<IsWhitespace> SplitView(std::string_view str, bool isIgnoringEmptyResults)
+	{
+		return SplitView(str, IsWhitespace(), isIgnoringEmptyResults);
+	}
+
+	template <typename PredicateType>
+	inline void Split(const char* str, size_t length, const PredicateType& predicate,
+		bool isIgnoringEmptyResults, std::vector<std::string>& result)
+	{
+		result.clear();
+		for (auto part : SplitView(std::string_view(str, length), predicate, isIgnoringEmptyResults))
 		{
-			result.push_back(std::string(str + start, str + length));
+			result.emplace_back(part.data(), part.length());
 		}
 	}
 
@@ -560,43 +696,22 @@ namespace Core
 		throw new std::runtime_error("Unknown string hash algorithm.");
 	}
 
-	/////////////////////////////////////// FORMAT ///////////////////////////////////////
-
-	template <class ... T>
-	inline std::string Format(const std::string& format)
+	// Fast 64-bit hash with a low collision rate. See ComputeHash64.
+	inline std::uint64_t GetHash64(std::string_view str, std::uint64_t seed = 0)
 	{
-		auto placeHolder = "%x";
-
-		if (format.find(placeHolder) != std::string::npos)
-		{
-			throw std::runtime_error("String format error.");
-		}
-		return format;
+		return ComputeHash64(str.data(), str.length(), seed);
 	}
 
-	template <class Head, class ... Tail>
-	inline std::string Format(const std::string& format, const Head& head, const Tail& ... tail)
-	{
-		std::stringstream ss;
-
-		auto placeHolder = "%x";
-		unsigned placeHolderSize = 2;
-
-		size_t firstPlaceholderPos = format.find(placeHolder);
-
-		if (firstPlaceholderPos == std::string::npos)
-		{
-			throw std::runtime_error("String format error.");
-		}
-		else
-		{
-			std::string front(format, 0, firstPlaceholderPos);
-			std::string back(format, firstPlaceholderPos + placeHolderSize);
-
-			ss << front << head << Format(back, tail ...);
-		}
+	/////////////////////////////////////// FORMAT ///////////////////////////////////////
 
-		return ss.str();
+	// Replaces the '%x' placeholders with the arguments. See FastFormat.hpp for formatting without allocations.
+	template <class ... Args>
+	inline std::string Format(const std::string& format, const Args& ... args)
+	{
+		std::string result;
+		result.reserve(format.length() + sizeof...(Args) * 8);
+		FormatTo(result, format.c_str(), args ...);
+		return result;
 	}
 
 	/////////////////////////////////////// WSTRING ///////////////////////////////////////
@@ -0,0 +1,234 @@
+// Core/StringSearch.cpp
+
+#include <Core/StringSearch.h>
+
+#include <Core/DataStructures/BitSet.h>
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define CORE_STRINGSEARCH_USING_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#define CORE_STRINGSEARCH_USING_AVX2
+#include <immintrin.h>
+#endif
+
+namespace
+{
+	inline bool IsWhitespaceCharacter(char c)
+	{
+		return (c == ' ' || static_cast<unsigned char>(c - '\t') <= '\r' - '\t');
+	}
+
+	inline unsigned FindLastSet32(std::uint32_t word)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanReverse(&index, word);
+		return static_cast<unsigned>(index);
+#elif defined(__GNUC__)
+		return 31U - static_cast<unsigned>(__builtin_clz(word));
+#else
+		unsigned index = 31;
+		while ((word & (1U << index)) == 0) index--;
+		return index;
+#endif
+	}
+
+#if defined(CORE_STRINGSEARCH_USING_AVX2)
+
+	typedef __m256i Vector;
+	const size_t c_VectorSize = 32;
+	const std::uint32_t c_FullMask = 0xffffffffU;
+
+	inline Vector Load(const char* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+	inline Vector Broadcast(char c) { return _mm256_set1_epi8(c); }
+	inline Vector Equal(Vector a, Vector b) { return _mm256_cmpeq_epi8(a, b); }
+	inline Vector Or(Vector a, Vector b) { return _mm256_or_si256(a, b); }
+	inline Vector And(Vector a, Vector b) { return _mm256_and_si256(a, b); }
+	inline std::uint32_t GetMask(Vector v) { return static_cast<std::uint32_t>(_mm256_movemask_epi8(v)); }
+
+	// '\t' <= c <= '\r' is computed as min(c - '\t', 4) == c - '\t' with unsigned bytes.
+	inline Vector IsWhitespace(Vector v)
+	{
+		auto shifted = _mm256_sub_epi8(v, _mm256_set1_epi8('\t'));
+		auto isControl = _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, _mm256_set1_epi8('\r' - '\t')), shifted);
+		return _mm256_or_si256(isControl, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')));
+	}
+
+#elif defined(CORE_STRINGSEARCH_USING_SSE2)
+
+	typedef __m128i Vector;
+	const size_t c_VectorSize = 16;
+	const std::uint32_t c_FullMask = 0xffffU;
+
+	inline Vector Load(const char* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+	inline Vector Broadcast(char c) { return _mm_set1_epi8(c); }
+	inline Vector Equal(Vector a, Vector b) { return _mm_cmpeq_epi8(a, b); }
+	inline Vector Or(Vector a, Vector b) { return _mm_or_si128(a, b); }
+	inline Vector And(Vector a, Vector b) { return _mm_and_si128(a, b); }
+	inline std::uint32_t GetMask(Vector v) { return static_cast<std::uint32_t>(_mm_movemask_epi8(v)); }
+
+	inline Vector IsWhitespace(Vector v)
+	{
+		auto shifted = _mm_sub_epi8(v, _mm_set1_epi8('\t'));
+		auto isControl = _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8('\r' - '\t')), shifted);
+		return _mm_or_si128(isControl, _mm_cmpeq_epi8(v, _mm_set1_epi8(' ')));
+	}
+
+#endif
+
+#if defined(CORE_STRINGSEARCH_USING_SSE2)
+#define CORE_STRINGSEARCH_USING_VECTORS
+#endif
+
+	// Up to this count the characters of FindAnyOf are compared one by one, above it a table is used.
+	const size_t c_MaxCountVectorCharacters = 8;
+
+	inline size_t FindAnyOfWithTable(const char* str, size_t length, const char* chars, size_t countChars)
+	{
+		bool table[256] = {};
+		for (size_t i = 0; i < countChars; i++) table[static_cast<unsigned char>(chars[i])] = true;
+		for (size_t i = 0; i < length; i++)
+		{
+			if (table[static_cast<unsigned char>(str[i])]) return i;
+		}
+		return length;
+	}
+}
+
+namespace Core
+{
+	size_t FindCharacter(const char* str, size_t length, char c)
+	{
+		size_t i = 0;
+#ifdef CORE_STRINGSEARCH_USING_VECTORS
+		auto cv = Broadcast(c);
+		for (; i + c_VectorSize <= length; i += c_VectorSize)
+		{
+			auto mask = GetMask(Equal(Load(str + i), cv));
+			if (mask != 0) return i + FindFirstSet64(mask);
+		}
+#endif
+		for (; i < length; i++)
+		{
+			if (str[i] == c) return i;
+		}
+		return length;
+	}
+
+	size_t FindAnyOf(const char* str, size_t length, const char* chars, size_t countChars)
+	{
+		if (countChars == 0) return length;
+		if (countChars == 1) return FindCharacter(str, length, chars[0]);
+		if (countChars > c_MaxCountVectorCharacters) return FindAnyOfWithTable(str, length, chars, countChars);
+
+		size_t i = 0;
+#ifdef CORE_STRINGSEARCH_USING_VECTORS
+		Vector cvs[c_MaxCountVectorCharacters];
+		for (size_t j = 0; j < countChars; j++) cvs[j] = Broadcast(chars[j]);
+		for (; i + c_VectorSize <= length; i += c_VectorSize)
+		{
+			auto v = Load(str + i);
+			auto isMatching = Equal(v, cvs[0]);
+			for (size_t j = 1; j < countChars; j++) isMatching = Or(isMatching, Equal(v, cvs[j]));
+			auto mask = GetMask(isMatching);
+			if (mask != 0) return i + FindFirstSet64(mask);
+		}
+#endif
+		for (; i < length; i++)
+		{
+			if (memchr(chars, str[i], countChars) != nullptr) return i;
+		}
+		return length;
+	}
+
+	size_t FindWhitespace(const char* str, size_t length)
+	{
+		size_t i = 0;
+#ifdef CORE_STRINGSEARCH_USING_VECTORS
+		for (; i + c_VectorSize <= length; i += c_VectorSize)
+		{
+			auto mask = GetMask(IsWhitespace(Load(str + i)));
+			if (mask != 0) return i + FindFirstSet64(mask);
+		}
+#endif
+		for (; i < length; i++)
+		{
+			if (IsWhitespaceCharacter(str[i])) return i;
+		}
+		return length;
+	}
+
+	size_t FindNonWhitespace(const char* str, size_t length)
+	{
+		size_t i = 0;
+#ifdef CORE_STRINGSEARCH_USING_VECTORS
+		for (; i + c_VectorSize <= length; i += c_VectorSize)
+		{
+			auto mask = ~GetMask(IsWhitespace(Load(str + i))) & c_FullMask;
+			if (mask != 0) return i + FindFirstSet64(mask);
+		}
+#endif
+		for (; i < length; i++)
+		{
+			if (!IsWhitespaceCharacter(str[i])) return i;
+		}
+		return length;
+	}
+
+	size_t FindEndOfNonWhitespace(const char* str, size_t length)
+	{
+		size_t end = length;
+#ifdef CORE_STRINGSEARCH_USING_VECTORS
+		for (; end >= c_VectorSize; end -= c_VectorSize)
+		{
+			auto start = end - c_VectorSize;
+			auto mask = ~GetMask(IsWhitespace(Load(str + start))) & c_FullMask;
+			if (mask != 0) return start + FindLastSet32(mask) + 1;
+		}
+#endif
+		for (; end > 0; end--)
+		{
+			if (!IsWhitespaceCharacter(str[end - 1])) return end;
+		}
+		return 0;
+	}
+
+	// The candidate positions are found by comparing the first and the last character of the test string
+	// for a whole vector of positions, and only these candidates are compared completely.
+	size_t FindSubstring(const char* str, size_t length, const char* test, size_t testLength)
+	{
+		if (testLength == 0) return 0;
+		if (testLength > length) return length;
+		if (testLength == 1) return FindCharacter(str, length, test[0]);
+
+		size_t i = 0;
+		size_t lastIndex = length - testLength;
+#ifdef CORE_STRINGSEARCH_USING_VECTORS
+		auto first = Broadcast(test[0]);
+		auto last = Broadcast(test[testLength - 1]);
+		for (; i + c_VectorSize <= lastIndex + 1; i += c_VectorSize)
+		{
+			auto isFirstMatching = Equal(Load(str + i), first);
+			auto isLastMatching = Equal(Load(str + i + testLength - 1), last);
+			auto mask = GetMask(And(isFirstMatching, isLastMatching));
+			while (mask != 0)
+			{
+				auto position = i + FindFirstSet64(mask);
+				if (memcmp(str + position + 1, test + 1, testLength - 2) == 0) return position;
+				mask &= mask - 1;
+			}
+		}
+#endif
+		for (; i <= lastIndex; i++)
+		{
+			if (str[i] == test[0] && memcmp(str + i + 1, test + 1, testLength - 1) == 0) return i;
+		}
+		return length;
+	}
+}
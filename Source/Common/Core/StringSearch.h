@@ -0,0 +1,29 @@
+// Core/StringSearch.h
+
+#ifndef _CORE_STRINGSEARCH_H_INCLUDED_
+#define _CORE_STRINGSEARCH_H_INCLUDED_
+
+#include <cstddef>
+
+namespace Core
+{
+	// Character and substring search, processing 16 bytes per instruction with SSE2
+	// (32 bytes with AVX2, if the compiler targets it).
+	//
+	// The functions return the index of the first match, or 'length' if there is no match.
+	// Whitespaces are the characters of std::isspace in the "C" locale: ' ', '\t', '\n', '\v', '\f' and '\r'.
+
+	size_t FindCharacter(const char* str, size_t length, char c);
+	size_t FindAnyOf(const char* str, size_t length, const char* chars, size_t countChars);
+
+	size_t FindWhitespace(const char* str, size_t length);
+	size_t FindNonWhitespace(const char* str, size_t length);
+
+	// Returns the index after the last non-whitespace character, or 0 if there is no such character.
+	size_t FindEndOfNonWhitespace(const char* str, size_t length);
+
+	// Returns 0 for an empty test string.
+	size_t FindSubstring(const char* str, size_t length, const char* test, size_t testLength);
+}
+
+#endif
@@ -0,0 +1,697 @@
+// Core/System/AsyncFileIO.cpp
+
+#include <Core/System/AsyncFileIO.h>
+
+#include <Core/Platform.h>
+#include <Core/System/SimpleIO.h>
+
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#ifndef IS_WINDOWS
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#define CORE_ASYNCFILEIO_USING_IOURING
+#endif
+
+namespace Core
+{
+	namespace detail
+	{
+		enum class AsyncFileOperation : unsigned char
+		{
+			Read, Write
+		};
+
+		struct AsyncFileRequest
+		{
+			AsyncFileOperation Operation;
+			AsyncFileResult Result;
+			AsyncFileCallback Callback;
+
+			const unsigned char* WriteData = nullptr;
+			size_t Size = 0;
+			size_t Offset = 0;
+
+#ifndef IS_WINDOWS
+			int FileDesc = -1;
+
+			// The aligned buffer of the direct I/O.
+			unsigned char* DirectBuffer = nullptr;
+			size_t DirectBufferSize = 0;
+#endif
+		};
+
+		inline std::string GetErrorMessage(const char* operation, const std::string& path)
+		{
+			return std::string("An error has occured while ") + operation + ": " + path;
+		}
+
+		///////////////////////////////////// POSIX FILE OPERATIONS /////////////////////////////////////
+
+#ifndef IS_WINDOWS
+
+		const size_t c_DirectIOAlignment = 4096;
+
+		// The maximum size of a single read or write call.
+		const size_t c_MaxIOChunkSize = 1 << 30;
+
+		// Returns false if the request is completed after opening the file: on error or for empty files.
+		bool OpenFile(AsyncFileRequest& request, const AsyncFileIOSettings& settings)
+		{
+			auto path = request.Result.Path.c_str();
+			if (request.Operation == AsyncFileOperation::Write)
+			{
+				request.FileDesc = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+				if (request.FileDesc < 0)
+				{
+					request.Result.Error = GetErrorMessage("opening", request.Result.Path);
+					return false;
+				}
+				return (request.Size > 0);
+			}
+
+			bool isDirect = false;
+#ifdef O_DIRECT
+			if (settings.IsUsingDirectIO)
+			{
+				request.FileDesc = open(path, O_RDONLY | O_CLOEXEC | O_DIRECT);
+				isDirect = (request.FileDesc >= 0);
+			}
+#endif
+			if (!isDirect) request.FileDesc = open(path, O_RDONLY | O_CLOEXEC);
+			struct stat fileStat;
+			if (request.FileDesc < 0 || fstat(request.FileDesc, &fileStat) != 0)
+			{
+				request.Result.Error = GetErrorMessage("opening", request.Result.Path);
+				return false;
+			}
+			request.Size = static_cast<size_t>(fileStat.st_size);
+			request.Result.Bytes.Resize(request.Size);
+			if (request.Size == 0) return false;
+
+			if (isDirect)
+			{
+				request.DirectBufferSize = (request.Size + c_DirectIOAlignment - 1) & ~(c_DirectIOAlignment - 1);
+				void* buffer;
+				if (posix_memalign(&buffer, c_DirectIOAlignment, request.DirectBufferSize) != 0)
+				{
+					request.Result.Error = GetErrorMessage("allocating", request.Result.Path);
+					return false;
+				}
+				request.DirectBuffer = reinterpret_cast<unsigned char*>(buffer);
+			}
+
+#if defined(POSIX_FADV_SEQUENTIAL) && defined(POSIX_FADV_WILLNEED)
+			if (settings.IsReadingAhead && !isDirect)
+			{
+				posix_fadvise(request.FileDesc, 0, 0, POSIX_FADV_SEQUENTIAL);
+				posix_fadvise(request.FileDesc, 0, 0, POSIX_FADV_WILLNEED);
+			}
+#endif
+			return true;
+		}
+
+		inline unsigned char* GetIOBuffer(AsyncFileRequest& request)
+		{
+			if (request.Operation == AsyncFileOperation::Write)
+			{
+				return const_cast<unsigned char*>(request.WriteData) + request.Offset;
+			}
+			if (request.DirectBuffer != nullptr) return request.DirectBuffer + request.Offset;
+			return request.Result.Bytes.GetArray() + request.Offset;
+		}
+
+		// The length of the direct reads remains aligned, except for the short read at the end of the file.
+		inline size_t GetIOLength(const AsyncFileRequest& request)
+		{
+			size_t end = (request.DirectBuffer != nullptr ? request.DirectBufferSize : request.Size);
+			return std::min(end - request.Offset, c_MaxIOChunkSize);
+		}
+
+		// Processes the result of a read or write call. Returns true if the request is completed.
+		bool AdvanceIO(AsyncFileRequest& request, long long result)
+		{
+			auto operation = (request.Operation == AsyncFileOperation::Read ? "reading" : "writing");
+			if (result < 0)
+			{
+				request.Result.Error = GetErrorMessage(operation, request.Result.Path);
+				return true;
+			}
+			if (result == 0)
+			{
+				if (request.Offset < request.Size) request.Result.Error = GetErrorMessage(operation, request.Result.Path);
+				return true;
+			}
+			request.Offset += static_cast<size_t>(result);
+			return (request.Offset >= request.Size);
+		}
+
+		void CloseFile(AsyncFileRequest& request)
+		{
+			if (request.DirectBuffer != nullptr)
+			{
+				if (request.Result.IsSucceeded())
+				{
+					memcpy(request.Result.Bytes.GetArray(), request.DirectBuffer, request.Size);
+				}
+				free(request.DirectBuffer);
+				request.DirectBuffer = nullptr;
+			}
+			if (request.FileDesc >= 0)
+			{
+				if (close(request.FileDesc) != 0 && request.Result.IsSucceeded())
+				{
+					request.Result.Error = GetErrorMessage("closing", request.Result.Path);
+				}
+				request.FileDesc = -1;
+			}
+			if (!request.Result.IsSucceeded()) request.Result.Bytes.Clear();
+		}
+
+#endif
+
+		///////////////////////////////////// BACKEND BASE /////////////////////////////////////
+
+		class AsyncFileIOBackend
+		{
+		protected:
+
+			AsyncFileIOSettings m_Settings;
+
+			std::mutex m_Mutex;
+			std::condition_variable m_IdleCondition;
+			std::deque<std::unique_ptr<AsyncFileRequest>> m_Queue;
+			size_t m_CountPending;
+			bool m_IsStopping;
+
+			virtual void NotifyRequests() = 0;
+
+			void Complete(std::unique_ptr<AsyncFileRequest> request)
+			{
+				request->Callback(request->Result);
+				request.reset();
+
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				if (--m_CountPending == 0) m_IdleCondition.notify_all();
+			}
+
+			void Stop()
+			{
+				WaitAll();
+				{
+					std::lock_guard<std::mutex> lock(m_Mutex);
+					m_IsStopping = true;
+				}
+				NotifyRequests();
+			}
+
+		public:
+
+			AsyncFileIOBackend(const AsyncFileIOSettings& settings)
+				: m_Settings(settings)
+				, m_CountPending(0)
+				, m_IsStopping(false)
+			{
+			}
+
+			virtual ~AsyncFileIOBackend()
+			{
+			}
+
+			virtual AsyncFileIOBackendType GetType() const = 0;
+
+			void Submit(std::vector<std::unique_ptr<AsyncFileRequest>>& requests)
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_Mutex);
+					for (auto& request : requests) m_Queue.push_back(std::move(request));
+					m_CountPending += requests.size();
+				}
+				requests.clear();
+				NotifyRequests();
+			}
+
+			void WaitAll()
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				m_IdleCondition.wait(lock, [this]() { return m_CountPending == 0; });
+			}
+		};
+
+		///////////////////////////////////// THREAD POOL BACKEND /////////////////////////////////////
+
+		class ThreadPoolFileIOBackend : public AsyncFileIOBackend
+		{
+			std::condition_variable m_QueueCondition;
+			std::vector<std::thread> m_Threads;
+
+			void NotifyRequests() override
+			{
+				m_QueueCondition.notify_all();
+			}
+
+			void Execute(AsyncFileRequest& request)
+			{
+#ifdef IS_WINDOWS
+				try
+				{
+					auto path = request.Result.Path.c_str();
+					if (request.Operation == AsyncFileOperation::Read) Core::ReadAllBytes(path, request.Result.Bytes);
+					else Core::WriteAllBytes(path, request.WriteData, request.Size);
+				}
+				catch (const std::exception& exception)
+				{
+					request.Result.Error = exception.what();
+				}
+#else
+				if (OpenFile(request, m_Settings))
+				{
+					bool isDone = false;
+					while (!isDone)
+					{
+						long long result;
+						do
+						{
+							result = (request.Operation == AsyncFileOperation::Read
+								? pread(request.FileDesc, GetIOBuffer(request), GetIOLength(request), request.Offset)
+								: pwrite(request.FileDesc, GetIOBuffer(request), GetIOLength(request), request.Offset));
+						} while (result < 0 && errno == EINTR);
+						isDone = AdvanceIO(request, result);
+					}
+				}
+				CloseFile(request);
+#endif
+			}
+
+			void Run()
+			{
+				while (true)
+				{
+					std::unique_ptr<AsyncFileRequest> request;
+					{
+						std::unique_lock<std::mutex> lock(m_Mutex);
+						m_QueueCondition.wait(lock, [this]() { return m_IsStopping || !m_Queue.empty(); });
+						if (m_Queue.empty()) return;
+						request = std::move(m_Queue.front());
+						m_Queue.pop_front();
+					}
+					Execute(*request);
+					Complete(std::move(request));
+				}
+			}
+
+		public:
+
+			ThreadPoolFileIOBackend(const AsyncFileIOSettings& settings)
+				: AsyncFileIOBackend(settings)
+			{
+				unsigned countThreads = std::max(settings.CountThreads, 1U);
+				for (unsigned i = 0; i < countThreads; i++) m_Threads.emplace_back([this]() { Run(); });
+			}
+
+			~ThreadPoolFileIOBackend() override
+			{
+				Stop();
+				for (auto& thread : m_Threads) thread.join();
+			}
+
+			AsyncFileIOBackendType GetType() const override
+			{
+				return AsyncFileIOBackendType::ThreadPool;
+			}
+		};
+
+		///////////////////////////////////// IO_URING BACKEND /////////////////////////////////////
+
+#ifdef CORE_ASYNCFILEIO_USING_IOURING
+
+		// A single thread submits the requests and processes the completions. The files are opened
+		// on this thread, the reads and writes are performed by the kernel. New requests are signaled
+		// with an eventfd, whose read is also kept in the ring, so the thread waits only in io_uring_enter.
+		class IOUringFileIOBackend : public AsyncFileIOBackend
+		{
+			const std::uint64_t c_EventUserData = 0;
+
+			int m_RingFileDesc;
+			void* m_SQRing;
+			size_t m_SQRingSize;
+			void* m_CQRing;
+			size_t m_CQRingSize;
+			io_uring_sqe* m_SQEs;
+			size_t m_SQEsSize;
+
+			unsigned* m_SQTail;
+			unsigned m_SQMask;
+			unsigned* m_SQArray;
+			unsigned* m_CQHead;
+			unsigned* m_CQTail;
+			unsigned m_CQMask;
+			io_uring_cqe* m_CQEs;
+
+			unsigned m_CountEntries;
+			unsigned m_CountToSubmit;
+			unsigned m_CountInFlight;
+
+			int m_EventFileDesc;
+			std::uint64_t m_EventValue;
+
+			std::thread m_Thread;
+
+			void NotifyRequests() override
+			{
+				std::uint64_t value = 1;
+				while (write(m_EventFileDesc, &value, sizeof(value)) < 0 && errno == EINTR);
+			}
+
+			io_uring_sqe* GetSQE()
+			{
+				unsigned tail = *m_SQTail;
+				unsigned index = tail & m_SQMask;
+				auto sqe = &m_SQEs[index];
+				memset(sqe, 0, sizeof(io_uring_sqe));
+				m_SQArray[index] = index;
+				__atomic_store_n(m_SQTail, tail + 1, __ATOMIC_RELEASE);
+				++m_CountToSubmit;
+				return sqe;
+			}
+
+			void PushEventRead()
+			{
+				auto sqe = GetSQE();
+				sqe->opcode = IORING_OP_READ;
+				sqe->fd = m_EventFileDesc;
+				sqe->addr = reinterpret_cast<std::uint64_t>(&m_EventValue);
+				sqe->len = sizeof(m_EventValue);
+				sqe->user_data = c_EventUserData;
+			}
+
+			void PushIO(AsyncFileRequest* request)
+			{
+				auto sqe = GetSQE();
+				sqe->opcode = (request->Operation == AsyncFileOperation::Read ? IORING_OP_READ : IORING_OP_WRITE);
+				sqe->fd = request->FileDesc;
+				sqe->addr = reinterpret_cast<std::uint64_t>(GetIOBuffer(*request));
+				sqe->len = static_cast<std::uint32_t>(GetIOLength(*request));
+				sqe->off = request->Offset;
+				sqe->user_data = reinterpret_cast<std::uint64_t>(request);
+			}
+
+			void Finish(std::unique_ptr<AsyncFileRequest> request)
+			{
+				CloseFile(*request);
+				Complete(std::move(request));
+			}
+
+			// Returns false when stopping.
+			bool StartRequests()
+			{
+				std::vector<std::unique_ptr<AsyncFileRequest>> requests;
+				{
+					std::lock_guard<std::mutex> lock(m_Mutex);
+					while (!m_Queue.empty() && m_CountInFlight + requests.size() + 1 < m_CountEntries)
+					{
+						requests.push_back(std::move(m_Queue.front()));
+						m_Queue.pop_front();
+					}
+					if (m_IsStopping && m_Queue.empty() && requests.empty() && m_CountInFlight == 0) return false;
+				}
+				for (auto& request : requests)
+				{
+					if (OpenFile(*request, m_Settings))
+					{
+						PushIO(request.release());
+						++m_CountInFlight;
+					}
+					else
+					{
+						Finish(std::move(request));
+					}
+				}
+				return true;
+			}
+
+			void ProcessCompletions(bool& isEventArmed)
+			{
+				unsigned head = *m_CQHead;
+				unsigned tail = __atomic_load_n(m_CQTail, __ATOMIC_ACQUIRE);
+				for (; head != tail; ++head)
+				{
+					auto& cqe = m_CQEs[head & m_CQMask];
+					if (cqe.user_data == c_EventUserData)
+					{
+						isEventArmed = false;
+						continue;
+					}
+					auto request = reinterpret_cast<AsyncFileRequest*>(cqe.user_data);
+					if (AdvanceIO(*request, cqe.res))
+					{
+						--m_CountInFlight;
+						Finish(std::unique_ptr<AsyncFileRequest>(request));
+					}
+					else
+					{
+						PushIO(request);
+					}
+				}
+				__atomic_store_n(m_CQHead, head, __ATOMIC_RELEASE);
+			}
+
+			void Run()
+			{
+				bool isEventArmed = false;
+				while (true)
+				{
+					if (!isEventArmed)
+					{
+						PushEventRead();
+						isEventArmed = true;
+					}
+					if (!StartRequests()) break;
+
+					int result = static_cast<int>(syscall(__NR_io_uring_enter, m_RingFileDesc, m_CountToSubmit, 1,
+						IORING_ENTER_GETEVENTS, nullptr, 0));
+					if (result >= 0) m_CountToSubmit -= static_cast<unsigned>(result);
+					else if (errno != EINTR && errno != EAGAIN && errno != EBUSY) std::terminate();
+
+					ProcessCompletions(isEventArmed);
+				}
+			}
+
+			void Release()
+			{
+				if (m_SQEs != nullptr) munmap(m_SQEs, m_SQEsSize);
+				if (m_CQRing != nullptr && m_CQRing != m_SQRing) munmap(m_CQRing, m_CQRingSize);
+				if (m_SQRing != nullptr) munmap(m_SQRing, m_SQRingSize);
+				if (m_RingFileDesc >= 0) close(m_RingFileDesc);
+				if (m_EventFileDesc >= 0) close(m_EventFileDesc);
+			}
+
+			template <typename T>
+			static T* GetRingPointer(void* ring, unsigned offset)
+			{
+				return reinterpret_cast<T*>(reinterpret_cast<unsigned char*>(ring) + offset);
+			}
+
+			bool Initialize()
+			{
+				io_uring_params params;
+				memset(&params, 0, sizeof(params));
+				m_RingFileDesc = static_cast<int>(syscall(__NR_io_uring_setup, std::max(m_Settings.QueueDepth, 2U) + 1, &params));
+				if (m_RingFileDesc < 0) return false;
+
+				m_SQRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+				m_CQRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+				bool isSingleMapping = ((params.features & IORING_FEAT_SINGLE_MMAP) != 0);
+				if (isSingleMapping) m_SQRingSize = m_CQRingSize = std::max(m_SQRingSize, m_CQRingSize);
+
+				m_SQRing = mmap(nullptr, m_SQRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+					m_RingFileDesc, IORING_OFF_SQ_RING);
+				if (m_SQRing == MAP_FAILED) { m_SQRing = nullptr; return false; }
+				m_CQRing = (isSingleMapping ? m_SQRing : mmap(nullptr, m_CQRingSize, PROT_READ | PROT_WRITE,
+					MAP_SHARED | MAP_POPULATE, m_RingFileDesc, IORING_OFF_CQ_RING));
+				if (m_CQRing == MAP_FAILED) { m_CQRing = nullptr; return false; }
+				m_SQEsSize = params.sq_entries * sizeof(io_uring_sqe);
+				auto sqes = mmap(nullptr, m_SQEsSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+					m_RingFileDesc, IORING_OFF_SQES);
+				if (sqes == MAP_FAILED) return false;
+				m_SQEs = reinterpret_cast<io_uring_sqe*>(sqes);
+
+				m_SQTail = GetRingPointer<unsigned>(m_SQRing, params.sq_off.tail);
+				m_SQMask = *GetRingPointer<unsigned>(m_SQRing, params.sq_off.ring_mask);
+				m_SQArray = GetRingPointer<unsigned>(m_SQRing, params.sq_off.array);
+				m_CQHead = GetRingPointer<unsigned>(m_CQRing, params.cq_off.head);
+				m_CQTail = GetRingPointer<unsigned>(m_CQRing, params.cq_off.tail);
+				m_CQMask = *GetRingPointer<unsigned>(m_CQRing, params.cq_off.ring_mask);
+				m_CQEs = GetRingPointer<io_uring_cqe>(m_CQRing, params.cq_off.cqes);
+				m_CountEntries = params.sq_entries;
+
+				m_EventFileDesc = eventfd(0, EFD_CLOEXEC);
+				return (m_EventFileDesc >= 0);
+			}
+
+		public:
+
+			IOUringFileIOBackend(const AsyncFileIOSettings& settings)
+				: AsyncFileIOBackend(settings)
+				, m_RingFileDesc(-1)
+				, m_SQRing(nullptr)
+				, m_SQRingSize(0)
+				, m_CQRing(nullptr)
+				, m_CQRingSize(0)
+				, m_SQEs(nullptr)
+				, m_SQEsSize(0)
+				, m_CountToSubmit(0)
+				, m_CountInFlight(0)
+				, m_EventFileDesc(-1)
+				, m_EventValue(0)
+			{
+			}
+
+			~IOUringFileIOBackend() override
+			{
+				if (m_Thread.joinable())
+				{
+					Stop();
+					m_Thread.join();
+				}
+				Release();
+			}
+
+			// Returns nullptr if io_uring is not supported.
+			static std::unique_ptr<AsyncFileIOBackend> Create(const AsyncFileIOSettings& settings)
+			{
+				auto backend = std::make_unique<IOUringFileIOBackend>(settings);
+				if (!backend->Initialize()) return nullptr;
+				backend->m_Thread = std::thread([pBackend = backend.get()]() { pBackend->Run(); });
+				return backend;
+			}
+
+			AsyncFileIOBackendType GetType() const override
+			{
+				return AsyncFileIOBackendType::IOUring;
+			}
+		};
+
+#endif
+	}
+}
+
+using namespace Core;
+using namespace Core::detail;
+
+AsyncFileIO::AsyncFileIO(const AsyncFileIOSettings& settings)
+{
+#ifdef CORE_ASYNCFILEIO_USING_IOURING
+	if (settings.IsUsingIOUring) m_Backend = IOUringFileIOBackend::Create(settings);
+#endif
+	if (m_Backend == nullptr) m_Backend = std::make_unique<ThreadPoolFileIOBackend>(settings);
+}
+
+AsyncFileIO::~AsyncFileIO()
+{
+}
+
+AsyncFileIOBackendType AsyncFileIO::GetBackendType() const
+{
+	return m_Backend->GetType();
+}
+
+inline std::unique_ptr<AsyncFileRequest> CreateReadRequest(const std::string& path, AsyncFileCallback callback)
+{
+	auto request = std::make_unique<AsyncFileRequest>();
+	request->Operation = AsyncFileOperation::Read;
+	request->Result.Path = path;
+	request->Callback = std::move(callback);
+	return request;
+}
+
+inline AsyncFileCallback CreateReadPromiseCallback(std::future<Core::ByteVector>& future)
+{
+	auto promise = std::make_shared<std::promise<Core::ByteVector>>();
+	future = promise->get_future();
+	return [promise](AsyncFileResult& result) {
+		if (result.IsSucceeded()) promise->set_value(std::move(result.Bytes));
+		else promise->set_exception(std::make_exception_ptr(std::runtime_error(result.Error)));
+	};
+}
+
+void AsyncFileIO::ReadAllBytes(const char* path, AsyncFileCallback callback)
+{
+	std::vector<std::unique_ptr<AsyncFileRequest>> requests;
+	requests.push_back(CreateReadRequest(path, std::move(callback)));
+	m_Backend->Submit(requests);
+}
+
+void AsyncFileIO::ReadAllBytes(const std::vector<std::string>& paths, const AsyncFileCallback& callback)
+{
+	std::vector<std::unique_ptr<AsyncFileRequest>> requests;
+	for (auto& path : paths) requests.push_back(CreateReadRequest(path, callback));
+	m_Backend->Submit(requests);
+}
+
+std::future<Core::ByteVector> AsyncFileIO::ReadAllBytes(const char* path)
+{
+	std::future<Core::ByteVector> future;
+	ReadAllBytes(path, CreateReadPromiseCallback(future));
+	return future;
+}
+
+std::vector<std::future<Core::ByteVector>> AsyncFileIO::ReadAllBytes(const std::vector<std::string>& paths)
+{
+	std::vector<std::future<Core::ByteVector>> futures(paths.size());
+	std::vector<std::unique_ptr<AsyncFileRequest>> requests;
+	for (size_t i = 0; i < paths.size(); i++)
+	{
+		requests.push_back(CreateReadRequest(paths[i], CreateReadPromiseCallback(futures[i])));
+	}
+	m_Backend->Submit(requests);
+	return futures;
+}
+
+void AsyncFileIO::WriteAllBytes(const char* path, const void* bytes, size_t size, AsyncFileCallback callback)
+{
+	auto request = std::make_unique<AsyncFileRequest>();
+	request->Operation = AsyncFileOperation::Write;
+	request->Result.Path = path;
+	request->Callback = std::move(callback);
+	request->WriteData = reinterpret_cast<const unsigned char*>(bytes);
+	request->Size = size;
+
+	std::vector<std::unique_ptr<AsyncFileRequest>> requests;
+	requests.push_back(std::move(request));
+	m_Backend->Submit(requests);
+}
+
+std::future<void> AsyncFileIO::WriteAllBytes(const char* path, const void* bytes, size_t size)
+{
+	auto promise = std::make_shared<std::promise<void>>();
+	auto future = promise->get_future();
+	WriteAllBytes(path, bytes, size, [promise](AsyncFileResult& result) {
+		if (result.IsSucceeded()) promise->set_value();
+		else promise->set_exception(std::make_exception_ptr(std::runtime_error(result.Error)));
+	});
+	return future;
+}
+
+void AsyncFileIO::WaitAll()
+{
+	m_Backend->WaitAll();
+}
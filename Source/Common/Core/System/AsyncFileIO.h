@@ -0,0 +1,92 @@
+// Core/System/AsyncFileIO.h
+
+#ifndef _CORE_ASYNCFILEIO_H_INCLUDED_
+#define _CORE_ASYNCFILEIO_H_INCLUDED_
+
+#include <Core/DataStructures/SimpleTypeVector.hpp>
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Core
+{
+	namespace detail
+	{
+		class AsyncFileIOBackend;
+	}
+
+	enum class AsyncFileIOBackendType : unsigned char
+	{
+		ThreadPool, IOUring
+	};
+
+	struct AsyncFileIOSettings
+	{
+		// io_uring is used on Linux if the kernel supports it, otherwise the thread pool.
+		bool IsUsingIOUring = true;
+
+		// The count of the threads of the thread pool backend.
+		unsigned CountThreads = 4;
+
+		// The maximum count of the operations in flight of the io_uring backend.
+		unsigned QueueDepth = 64;
+
+		// Hints the operating system to read the whole file ahead (POSIX only).
+		bool IsReadingAhead = true;
+
+		// Bypasses the page cache, if the file system supports it (POSIX only). The data is read to an aligned
+		// buffer and copied to the result.
+		bool IsUsingDirectIO = false;
+	};
+
+	struct AsyncFileResult
+	{
+		std::string Path;
+
+		// The content of a read file. The callback may move it away.
+		Core::ByteVector Bytes;
+
+		// Empty on success.
+		std::string Error;
+
+		bool IsSucceeded() const { return Error.empty(); }
+	};
+
+	// Called on a thread of the I/O service. Long running work, like decoding, should be passed to other threads.
+	typedef std::function<void(AsyncFileResult& result)> AsyncFileCallback;
+
+	// Reads and writes whole files asynchronously. The requests of a batch are submitted together.
+	// The results are delivered either with callbacks or with futures, which rethrow the errors
+	// as std::runtime_error, like the functions of SimpleIO.
+	//
+	// The destructor waits for all requests.
+	class AsyncFileIO
+	{
+		std::unique_ptr<detail::AsyncFileIOBackend> m_Backend;
+
+	public:
+
+		AsyncFileIO(const AsyncFileIOSettings& settings = AsyncFileIOSettings());
+		~AsyncFileIO();
+
+		AsyncFileIOBackendType GetBackendType() const;
+
+		void ReadAllBytes(const char* path, AsyncFileCallback callback);
+		void ReadAllBytes(const std::vector<std::string>& paths, const AsyncFileCallback& callback);
+
+		std::future<Core::ByteVector> ReadAllBytes(const char* path);
+		std::vector<std::future<Core::ByteVector>> ReadAllBytes(const std::vector<std::string>& paths);
+
+		// The data must be valid until the request is completed.
+		void WriteAllBytes(const char* path, const void* bytes, size_t size, AsyncFileCallback callback);
+		std::future<void> WriteAllBytes(const char* path, const void* bytes, size_t size);
+
+		// Waits for the completion of all requests, including their callbacks.
+		void WaitAll();
+	};
+}
+
+#endif
@@ -0,0 +1,813 @@
+// Core/System/AsyncSocket.cpp
+
+#include <Core/System/AsyncSocket.h>
+
+#include <Core/Platform.h>
+
+#include <asio.hpp>
+
+#ifndef IS_WINDOWS
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <cerrno>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Core
+{
+	namespace detail
+	{
+		const size_t c_MessageHeaderSize = 4;
+
+		// The maximum count of the messages which are written with a single gathering write.
+		const size_t c_MaxCountGatheredMessages = 64;
+
+		// The maximum count of the buffers which are sent directly with a single vectored send.
+		const size_t c_MaxCountDirectSendBuffers = 64;
+
+		// A framed message which is shared between the send queues of the connections.
+		typedef std::shared_ptr<const std::vector<unsigned char>> AsyncSocketMessagePtr;
+
+		// Returns false if the message is too large to be sent.
+		inline bool GetMessageSize(const AsyncSocketBuffer* buffers, unsigned countBuffers, size_t maxMessageSize,
+			size_t& size)
+		{
+			size = 0;
+			for (unsigned i = 0; i < countBuffers; i++) size += buffers[i].Size;
+			return (size <= maxMessageSize && size <= std::numeric_limits<std::uint32_t>::max());
+		}
+
+		inline void WriteMessageHeader(unsigned char* header, size_t size)
+		{
+			for (size_t i = 0; i < c_MessageHeaderSize; i++)
+			{
+				header[i] = static_cast<unsigned char>(size >> (8 * i));
+			}
+		}
+
+		// Copies the frame of the message to a new buffer, omitting its first 'offset' bytes.
+		inline AsyncSocketMessagePtr CreateMessage(const unsigned char* header, const AsyncSocketBuffer* buffers,
+			unsigned countBuffers, size_t frameSize, size_t offset)
+		{
+			auto message = std::make_shared<std::vector<unsigned char>>(frameSize - offset);
+			auto data = message->data();
+			auto copyPart = [&](const void* partData, size_t partSize) {
+				size_t skipped = std::min(offset, partSize);
+				offset -= skipped;
+				if (partSize == skipped) return;
+				memcpy(data, static_cast<const unsigned char*>(partData) + skipped, partSize - skipped);
+				data += partSize - skipped;
+			};
+			copyPart(header, c_MessageHeaderSize);
+			for (unsigned i = 0; i < countBuffers; i++) copyPart(buffers[i].Data, buffers[i].Size);
+			return message;
+		}
+
+		inline AsyncSocketMessagePtr CreateMessage(const AsyncSocketBuffer* buffers, unsigned countBuffers,
+			size_t maxMessageSize)
+		{
+			size_t size;
+			if (!GetMessageSize(buffers, countBuffers, maxMessageSize, size)) return nullptr;
+			unsigned char header[c_MessageHeaderSize];
+			WriteMessageHeader(header, size);
+			return CreateMessage(header, buffers, countBuffers, c_MessageHeaderSize + size, 0);
+		}
+
+		// Sends the header and the buffers with a single vectored send without blocking.
+		// Returns the count of the sent bytes, which is 0 if the data cannot be sent immediately or an error
+		// has occured. In the latter case the error is reported by the asynchronous write of the rest.
+		size_t SendDirectly(asio::ip::tcp::socket::native_handle_type socket, const unsigned char* header,
+			const AsyncSocketBuffer* buffers, unsigned countBuffers)
+		{
+			if (countBuffers >= c_MaxCountDirectSendBuffers) return 0;
+#ifdef IS_WINDOWS
+			WSABUF wsaBuffers[c_MaxCountDirectSendBuffers];
+			wsaBuffers[0].buf = reinterpret_cast<CHAR*>(const_cast<unsigned char*>(header));
+			wsaBuffers[0].len = static_cast<ULONG>(c_MessageHeaderSize);
+			DWORD countWsaBuffers = 1;
+			for (unsigned i = 0; i < countBuffers; i++)
+			{
+				if (buffers[i].Size == 0) continue;
+				wsaBuffers[countWsaBuffers].buf = static_cast<CHAR*>(const_cast<void*>(buffers[i].Data));
+				wsaBuffers[countWsaBuffers].len = static_cast<ULONG>(buffers[i].Size);
+				countWsaBuffers++;
+			}
+			DWORD countSent;
+			if (WSASend(socket, wsaBuffers, countWsaBuffers, &countSent, 0, nullptr, nullptr) != 0) return 0;
+			return static_cast<size_t>(countSent);
+#else
+			iovec vectors[c_MaxCountDirectSendBuffers];
+			vectors[0].iov_base = const_cast<unsigned char*>(header);
+			vectors[0].iov_len = c_MessageHeaderSize;
+			size_t countVectors = 1;
+			for (unsigned i = 0; i < countBuffers; i++)
+			{
+				if (buffers[i].Size == 0) continue;
+				vectors[countVectors].iov_base = const_cast<void*>(buffers[i].Data);
+				vectors[countVectors].iov_len = buffers[i].Size;
+				countVectors++;
+			}
+			msghdr messageHeader = {};
+			messageHeader.msg_iov = vectors;
+			messageHeader.msg_iovlen = countVectors;
+			int flags = MSG_DONTWAIT;
+#ifdef MSG_NOSIGNAL
+			flags |= MSG_NOSIGNAL;
+#endif
+			while (true)
+			{
+				auto countSent = sendmsg(socket, &messageHeader, flags);
+				if (countSent >= 0) return static_cast<size_t>(countSent);
+				if (errno != EINTR) return 0;
+			}
+#endif
+		}
+
+		inline size_t ReadMessageSize(const unsigned char* header)
+		{
+			size_t size = 0;
+			for (size_t i = 0; i < c_MessageHeaderSize; i++)
+			{
+				size |= static_cast<size_t>(header[i]) << (8 * i);
+			}
+			return size;
+		}
+
+		class AsyncSocketConnection : public std::enable_shared_from_this<AsyncSocketConnection>
+		{
+			asio::ip::tcp::socket m_Socket;
+			const AsyncSocketSettings& m_Settings;
+			AsyncSocketConnectionId m_Id;
+
+			const AsyncSocketMessageHandler& m_MessageHandler;
+			std::function<void(AsyncSocketConnectionId)> m_ClosedHandler;
+
+			std::vector<unsigned char> m_ReceiveBuffer;
+			size_t m_ReceivedSize;
+
+			mutable std::mutex m_SendMutex;
+			std::deque<AsyncSocketMessagePtr> m_SendQueue;
+			std::vector<AsyncSocketMessagePtr> m_WrittenMessages;
+			std::vector<asio::const_buffer> m_WriteBuffers;
+			size_t m_QueuedSendSize;
+			bool m_IsWriting;
+			bool m_IsClosed;
+
+			void StartReceive()
+			{
+				if (m_ReceivedSize == m_ReceiveBuffer.size())
+				{
+					m_ReceiveBuffer.resize(m_ReceiveBuffer.size() * 2);
+				}
+				auto self = shared_from_this();
+				m_Socket.async_read_some(
+					asio::buffer(m_ReceiveBuffer.data() + m_ReceivedSize, m_ReceiveBuffer.size() - m_ReceivedSize),
+					[self](const asio::error_code& error, size_t countBytes) {
+					self->OnReceived(error, countBytes);
+				});
+			}
+
+			void OnReceived(const asio::error_code& error, size_t countBytes)
+			{
+				if (error)
+				{
+					Close();
+					return;
+				}
+				m_ReceivedSize += countBytes;
+
+				// Processing all complete messages of the buffer.
+				size_t start = 0;
+				while (m_ReceivedSize - start >= c_MessageHeaderSize)
+				{
+					size_t messageSize = ReadMessageSize(m_ReceiveBuffer.data() + start);
+					if (messageSize > m_Settings.MaxMessageSize)
+					{
+						Close();
+						return;
+					}
+					size_t frameSize = c_MessageHeaderSize + messageSize;
+					if (m_ReceivedSize - start < frameSize)
+					{
+						if (m_ReceiveBuffer.size() < frameSize) m_ReceiveBuffer.resize(frameSize);
+						break;
+					}
+					if (m_MessageHandler) m_MessageHandler(m_Id, m_ReceiveBuffer.data() + start + c_MessageHeaderSize, messageSize);
+					if (IsClosed()) return;
+					start += frameSize;
+				}
+
+				m_ReceivedSize -= start;
+				if (start > 0 && m_ReceivedSize > 0)
+				{
+					memmove(m_ReceiveBuffer.data(), m_ReceiveBuffer.data() + start, m_ReceivedSize);
+				}
+				StartReceive();
+			}
+
+			void StartWrite()
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_SendMutex);
+					assert(m_IsWriting && m_WrittenMessages.empty());
+					if (m_IsClosed || m_SendQueue.empty())
+					{
+						m_IsWriting = false;
+						return;
+					}
+					m_WriteBuffers.clear();
+					while (!m_SendQueue.empty() && m_WrittenMessages.size() < c_MaxCountGatheredMessages)
+					{
+						auto& message = m_SendQueue.front();
+						m_WriteBuffers.push_back(asio::buffer(*message));
+						m_WrittenMessages.push_back(std::move(message));
+						m_SendQueue.pop_front();
+					}
+				}
+				auto self = shared_from_this();
+				asio::async_write(m_Socket, m_WriteBuffers, [self](const asio::error_code& error, size_t) {
+					self->OnWritten(error);
+				});
+			}
+
+			void OnWritten(const asio::error_code& error)
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_SendMutex);
+					for (auto& message : m_WrittenMessages) m_QueuedSendSize -= message->size();
+					m_WrittenMessages.clear();
+				}
+				if (error)
+				{
+					Close();
+					{
+						std::lock_guard<std::mutex> lock(m_SendMutex);
+						m_IsWriting = false;
+					}
+					return;
+				}
+				StartWrite();
+			}
+
+			// The send mutex must be locked.
+			void QueueMessage(const AsyncSocketMessagePtr& message)
+			{
+				m_SendQueue.push_back(message);
+				m_QueuedSendSize += message->size();
+				if (!m_IsWriting)
+				{
+					m_IsWriting = true;
+					auto self = shared_from_this();
+					asio::post(m_Socket.get_executor(), [self]() { self->StartWrite(); });
+				}
+			}
+
+		public:
+
+			AsyncSocketConnection(asio::ip::tcp::socket&& socket, const AsyncSocketSettings& settings,
+				AsyncSocketConnectionId id, const AsyncSocketMessageHandler& messageHandler,
+				std::function<void(AsyncSocketConnectionId)> closedHandler)
+				: m_Socket(std::move(socket))
+				, m_Settings(settings)
+				, m_Id(id)
+				, m_MessageHandler(messageHandler)
+				, m_ClosedHandler(std::move(closedHandler))
+				, m_ReceiveBuffer(std::max(settings.ReceiveBufferSize, c_MessageHeaderSize))
+				, m_ReceivedSize(0)
+				, m_QueuedSendSize(0)
+				, m_IsWriting(false)
+				, m_IsClosed(false)
+			{
+#ifdef IS_WINDOWS
+				// The direct sends must not block. The asynchronous operations are not affected.
+				asio::error_code error;
+				m_Socket.non_blocking(true, error);
+#endif
+			}
+
+			AsyncSocketConnectionId GetId() const
+			{
+				return m_Id;
+			}
+
+			// Must be called on the event loop thread.
+			void Start()
+			{
+				asio::error_code error;
+				m_Socket.set_option(asio::ip::tcp::no_delay(m_Settings.IsNoDelay), error);
+				StartReceive();
+			}
+
+			bool IsClosed() const
+			{
+				std::lock_guard<std::mutex> lock(m_SendMutex);
+				return m_IsClosed;
+			}
+
+			// Must be called on the event loop thread.
+			void Close()
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_SendMutex);
+					if (m_IsClosed) return;
+					m_IsClosed = true;
+					for (auto& message : m_SendQueue) m_QueuedSendSize -= message->size();
+					m_SendQueue.clear();
+				}
+				asio::error_code error;
+				m_Socket.shutdown(asio::ip::tcp::socket::shutdown_both, error);
+				m_Socket.close(error);
+				if (m_ClosedHandler) m_ClosedHandler(m_Id);
+			}
+
+			void PostClose()
+			{
+				auto self = shared_from_this();
+				asio::post(m_Socket.get_executor(), [self]() { self->Close(); });
+			}
+
+			// Thread-safe.
+			bool Send(const AsyncSocketMessagePtr& message)
+			{
+				std::lock_guard<std::mutex> lock(m_SendMutex);
+				if (m_IsClosed) return false;
+
+				// A single message is always accepted, even if it is larger than the limit.
+				size_t size = message->size();
+				if (m_QueuedSendSize > 0 && m_QueuedSendSize + size > m_Settings.MaxQueuedSendSize) return false;
+
+				QueueMessage(message);
+				return true;
+			}
+
+			// Thread-safe. If no data is queued, the message is sent directly from the buffers with a single
+			// vectored send, and only its unsent part is copied to the send queue.
+			bool Send(const AsyncSocketBuffer* buffers, unsigned countBuffers, size_t size)
+			{
+				unsigned char header[c_MessageHeaderSize];
+				WriteMessageHeader(header, size);
+				size_t frameSize = c_MessageHeaderSize + size;
+
+				std::lock_guard<std::mutex> lock(m_SendMutex);
+				if (m_IsClosed) return false;
+
+				// The send queue is empty if no write is in progress, thus the order of the data is kept.
+				size_t countSent = 0;
+				if (!m_IsWriting)
+				{
+					assert(m_SendQueue.empty() && m_QueuedSendSize == 0);
+					countSent = SendDirectly(m_Socket.native_handle(), header, buffers, countBuffers);
+					if (countSent == frameSize) return true;
+				}
+				else if (m_QueuedSendSize > 0 && m_QueuedSendSize + frameSize > m_Settings.MaxQueuedSendSize)
+				{
+					return false;
+				}
+
+				QueueMessage(CreateMessage(header, buffers, countBuffers, frameSize, countSent));
+				return true;
+			}
+
+			size_t GetQueuedSendSize() const
+			{
+				std::lock_guard<std::mutex> lock(m_SendMutex);
+				return m_QueuedSendSize;
+			}
+		};
+
+		class AsyncSocketImplementor
+		{
+		protected:
+
+			AsyncSocketSettings m_Settings;
+			asio::io_context m_IOContext;
+			std::thread m_Thread;
+			asio::error_code m_LastError;
+
+			AsyncSocketConnectionHandler m_DisconnectionHandler;
+			AsyncSocketMessageHandler m_MessageHandler;
+
+			void StartEventLoop()
+			{
+				m_Thread = std::thread([this]() { m_IOContext.run(); });
+			}
+
+			// Runs the function on the event loop thread and waits for the event loop to finish.
+			template <typename Function>
+			void StopEventLoop(Function&& closeFunction)
+			{
+				if (!m_Thread.joinable()) return;
+				asio::post(m_IOContext, std::forward<Function>(closeFunction));
+				m_Thread.join();
+				m_IOContext.restart();
+			}
+
+		public:
+
+			AsyncSocketImplementor(const AsyncSocketSettings& settings)
+				: m_Settings(settings)
+			{
+			}
+
+			bool HasError() const
+			{
+				return static_cast<bool>(m_LastError.value());
+			}
+
+			void ClearError()
+			{
+				m_LastError.clear();
+			}
+
+			void SetDisconnectionHandler(AsyncSocketConnectionHandler handler)
+			{
+				m_DisconnectionHandler = std::move(handler);
+			}
+
+			void SetMessageHandler(AsyncSocketMessageHandler handler)
+			{
+				m_MessageHandler = std::move(handler);
+			}
+
+			AsyncSocketMessagePtr CreateMessage(const AsyncSocketBuffer* buffers, unsigned countBuffers) const
+			{
+				return detail::CreateMessage(buffers, countBuffers, m_Settings.MaxMessageSize);
+			}
+		};
+
+		class AsyncSocketServerImplementor : public AsyncSocketImplementor
+		{
+			asio::ip::tcp::acceptor m_Acceptor;
+
+			AsyncSocketConnectionHandler m_ConnectionHandler;
+
+			mutable std::mutex m_ConnectionsMutex;
+			std::unordered_map<AsyncSocketConnectionId, std::shared_ptr<AsyncSocketConnection>> m_Connections;
+			AsyncSocketConnectionId m_NextConnectionId;
+
+			void StartAccept()
+			{
+				m_Acceptor.async_accept([this](const asio::error_code& error, asio::ip::tcp::socket socket) {
+					if (error)
+					{
+						if (error != asio::error::operation_aborted) StartAccept();
+						return;
+					}
+					auto connection = std::make_shared<AsyncSocketConnection>(std::move(socket), m_Settings,
+						m_NextConnectionId++, m_MessageHandler,
+						[this](AsyncSocketConnectionId connectionId) { OnConnectionClosed(connectionId); });
+					{
+						std::lock_guard<std::mutex> lock(m_ConnectionsMutex);
+						m_Connections[connection->GetId()] = connection;
+					}
+					if (m_ConnectionHandler) m_ConnectionHandler(connection->GetId());
+					connection->Start();
+					StartAccept();
+				});
+			}
+
+			void OnConnectionClosed(AsyncSocketConnectionId connectionId)
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_ConnectionsMutex);
+					m_Connections.erase(connectionId);
+				}
+				if (m_DisconnectionHandler) m_DisconnectionHandler(connectionId);
+			}
+
+			std::shared_ptr<AsyncSocketConnection> GetConnection(AsyncSocketConnectionId connectionId) const
+			{
+				std::lock_guard<std::mutex> lock(m_ConnectionsMutex);
+				auto it = m_Connections.find(connectionId);
+				return (it == m_Connections.end() ? nullptr : it->second);
+			}
+
+			std::vector<std::shared_ptr<AsyncSocketConnection>> GetConnections() const
+			{
+				std::lock_guard<std::mutex> lock(m_ConnectionsMutex);
+				std::vector<std::shared_ptr<AsyncSocketConnection>> connections;
+				connections.reserve(m_Connections.size());
+				for (auto& it : m_Connections) connections.push_back(it.second);
+				return connections;
+			}
+
+		public:
+
+			AsyncSocketServerImplementor(const AsyncSocketSettings& settings)
+				: AsyncSocketImplementor(settings)
+				, m_Acceptor(m_IOContext)
+				, m_NextConnectionId(0)
+			{
+			}
+
+			~AsyncSocketServerImplementor()
+			{
+				Stop();
+			}
+
+			void SetConnectionHandler(AsyncSocketConnectionHandler handler)
+			{
+				m_ConnectionHandler = std::move(handler);
+			}
+
+			void Start(unsigned short portNumber)
+			{
+				assert(!m_Thread.joinable());
+				asio::ip::tcp::endpoint endpoint(asio::ip::tcp::v4(), portNumber);
+				m_Acceptor.open(endpoint.protocol(), m_LastError);
+				if (!HasError()) m_Acceptor.set_option(asio::ip::tcp::acceptor::reuse_address(true), m_LastError);
+				if (!HasError()) m_Acceptor.bind(endpoint, m_LastError);
+				if (!HasError()) m_Acceptor.listen(asio::socket_base::max_listen_connections, m_LastError);
+				if (HasError())
+				{
+					asio::error_code error;
+					m_Acceptor.close(error);
+					return;
+				}
+				StartAccept();
+				StartEventLoop();
+			}
+
+			void Stop()
+			{
+				StopEventLoop([this]() {
+					asio::error_code error;
+					m_Acceptor.close(error);
+					for (auto& connection : GetConnections()) connection->Close();
+				});
+			}
+
+			unsigned short GetPortNumber() const
+			{
+				asio::error_code error;
+				auto endpoint = m_Acceptor.local_endpoint(error);
+				return (error ? 0 : endpoint.port());
+			}
+
+			size_t GetCountConnections() const
+			{
+				std::lock_guard<std::mutex> lock(m_ConnectionsMutex);
+				return m_Connections.size();
+			}
+
+			bool Send(AsyncSocketConnectionId connectionId, const AsyncSocketBuffer* buffers, unsigned countBuffers)
+			{
+				auto connection = GetConnection(connectionId);
+				size_t size;
+				return (connection != nullptr && GetMessageSize(buffers, countBuffers, m_Settings.MaxMessageSize, size)
+					&& connection->Send(buffers, countBuffers, size));
+			}
+
+			unsigned Broadcast(const AsyncSocketBuffer* buffers, unsigned countBuffers)
+			{
+				auto message = CreateMessage(buffers, countBuffers);
+				if (message == nullptr) return 0;
+				unsigned countSent = 0;
+				for (auto& connection : GetConnections())
+				{
+					if (connection->Send(message)) ++countSent;
+				}
+				return countSent;
+			}
+
+			size_t GetQueuedSendSize(AsyncSocketConnectionId connectionId) const
+			{
+				auto connection = GetConnection(connectionId);
+				return (connection == nullptr ? 0 : connection->GetQueuedSendSize());
+			}
+
+			void CloseConnection(AsyncSocketConnectionId connectionId)
+			{
+				auto connection = GetConnection(connectionId);
+				if (connection != nullptr) connection->PostClose();
+			}
+		};
+
+		class AsyncSocketClientImplementor : public AsyncSocketImplementor
+		{
+			std::shared_ptr<AsyncSocketConnection> m_Connection;
+			std::atomic<bool> m_IsConnected;
+
+		public:
+
+			AsyncSocketClientImplementor(const AsyncSocketSettings& settings)
+				: AsyncSocketImplementor(settings)
+				, m_IsConnected(false)
+			{
+			}
+
+			~AsyncSocketClientImplementor()
+			{
+				Stop();
+			}
+
+			void Start(const std::string& hostName, unsigned short portNumber)
+			{
+				assert(!m_Thread.joinable());
+				std::stringstream ssPortNumber;
+				ssPortNumber << portNumber;
+
+				asio::ip::tcp::resolver resolver(m_IOContext);
+				auto endpoints = resolver.resolve(asio::ip::tcp::v4(), hostName, ssPortNumber.str(), m_LastError);
+				if (HasError()) return;
+
+				asio::ip::tcp::socket socket(m_IOContext);
+				asio::connect(socket, endpoints, m_LastError);
+				if (HasError()) return;
+
+				m_IsConnected = true;
+				m_Connection = std::make_shared<AsyncSocketConnection>(std::move(socket), m_Settings, 0, m_MessageHandler,
+					[this](AsyncSocketConnectionId connectionId) {
+					m_IsConnected = false;
+					if (m_DisconnectionHandler) m_DisconnectionHandler(connectionId);
+				});
+				asio::post(m_IOContext, [connection = m_Connection]() { connection->Start(); });
+				StartEventLoop();
+			}
+
+			void Stop()
+			{
+				StopEventLoop([this]() { m_Connection->Close(); });
+				m_Connection = nullptr;
+			}
+
+			bool IsConnected() const
+			{
+				return m_IsConnected;
+			}
+
+			bool Send(const AsyncSocketBuffer* buffers, unsigned countBuffers)
+			{
+				size_t size;
+				return (m_Connection != nullptr && GetMessageSize(buffers, countBuffers, m_Settings.MaxMessageSize, size)
+					&& m_Connection->Send(buffers, countBuffers, size));
+			}
+
+			size_t GetQueuedSendSize() const
+			{
+				return (m_Connection == nullptr ? 0 : m_Connection->GetQueuedSendSize());
+			}
+		};
+	}
+}
+
+using namespace Core;
+
+AsyncSocketServer::AsyncSocketServer(const AsyncSocketSettings& settings)
+	: m_Implementor(std::make_unique<detail::AsyncSocketServerImplementor>(settings))
+{
+}
+
+AsyncSocketServer::~AsyncSocketServer()
+{
+}
+
+void AsyncSocketServer::SetConnectionHandler(AsyncSocketConnectionHandler handler)
+{
+	m_Implementor->SetConnectionHandler(std::move(handler));
+}
+
+void AsyncSocketServer::SetDisconnectionHandler(AsyncSocketConnectionHandler handler)
+{
+	m_Implementor->SetDisconnectionHandler(std::move(handler));
+}
+
+void AsyncSocketServer::SetMessageHandler(AsyncSocketMessageHandler handler)
+{
+	m_Implementor->SetMessageHandler(std::move(handler));
+}
+
+bool AsyncSocketServer::HasError() const
+{
+	return m_Implementor->HasError();
+}
+
+void AsyncSocketServer::ClearError()
+{
+	m_Implementor->ClearError();
+}
+
+void AsyncSocketServer::Start(unsigned short portNumber)
+{
+	m_Implementor->Start(portNumber);
+}
+
+void AsyncSocketServer::Stop()
+{
+	m_Implementor->Stop();
+}
+
+unsigned short AsyncSocketServer::GetPortNumber() const
+{
+	return m_Implementor->GetPortNumber();
+}
+
+size_t AsyncSocketServer::GetCountConnections() const
+{
+	return m_Implementor->GetCountConnections();
+}
+
+bool AsyncSocketServer::Send(AsyncSocketConnectionId connectionId, const void* buffer, size_t size)
+{
+	AsyncSocketBuffer asyncBuffer = { buffer, size };
+	return m_Implementor->Send(connectionId, &asyncBuffer, 1);
+}
+
+bool AsyncSocketServer::Send(AsyncSocketConnectionId connectionId, const AsyncSocketBuffer* buffers,
+	unsigned countBuffers)
+{
+	return m_Implementor->Send(connectionId, buffers, countBuffers);
+}
+
+unsigned AsyncSocketServer::Broadcast(const void* buffer, size_t size)
+{
+	AsyncSocketBuffer asyncBuffer = { buffer, size };
+	return m_Implementor->Broadcast(&asyncBuffer, 1);
+}
+
+unsigned AsyncSocketServer::Broadcast(const AsyncSocketBuffer* buffers, unsigned countBuffers)
+{
+	return m_Implementor->Broadcast(buffers, countBuffers);
+}
+
+size_t AsyncSocketServer::GetQueuedSendSize(AsyncSocketConnectionId connectionId) const
+{
+	return m_Implementor->GetQueuedSendSize(connectionId);
+}
+
+void AsyncSocketServer::CloseConnection(AsyncSocketConnectionId connectionId)
+{
+	m_Implementor->CloseConnection(connectionId);
+}
+
+AsyncSocketClient::AsyncSocketClient(const AsyncSocketSettings& settings)
+	: m_Implementor(std::make_unique<detail::AsyncSocketClientImplementor>(settings))
+{
+}
+
+AsyncSocketClient::~AsyncSocketClient()
+{
+}
+
+void AsyncSocketClient::SetDisconnectionHandler(AsyncSocketConnectionHandler handler)
+{
+	m_Implementor->SetDisconnectionHandler(std::move(handler));
+}
+
+void AsyncSocketClient::SetMessageHandler(AsyncSocketMessageHandler handler)
+{
+	m_Implementor->SetMessageHandler(std::move(handler));
+}
+
+bool AsyncSocketClient::HasError() const
+{
+	return m_Implementor->HasError();
+}
+
+void AsyncSocketClient::ClearError()
+{
+	m_Implementor->ClearError();
+}
+
+void AsyncSocketClient::Start(const std::string& hostName, unsigned short portNumber)
+{
+	m_Implementor->Start(hostName, portNumber);
+}
+
+void AsyncSocketClient::Stop()
+{
+	m_Implementor->Stop();
+}
+
+bool AsyncSocketClient::IsConnected() const
+{
+	return m_Implementor->IsConnected();
+}
+
+bool AsyncSocketClient::Send(const void* buffer, size_t size)
+{
+	AsyncSocketBuffer asyncBuffer = { buffer, size };
+	return m_Implementor->Send(&asyncBuffer, 1);
+}
+
+bool AsyncSocketClient::Send(const AsyncSocketBuffer* buffers, unsigned countBuffers)
+{
+	return m_Implementor->Send(buffers, countBuffers);
+}
+
+size_t AsyncSocketClient::GetQueuedSendSize() const
+{
+	return m_Implementor->GetQueuedSendSize();
+}
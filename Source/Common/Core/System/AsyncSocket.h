@@ -0,0 +1,119 @@
+// Core/System/AsyncSocket.h
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace Core
+{
+	namespace detail
+	{
+		class AsyncSocketServerImplementor;
+		class AsyncSocketClientImplementor;
+	}
+
+	// Asynchronous, message based TCP sockets. An event loop thread serves all connections of a server or a client.
+	//
+	// Messages are framed with a 4 byte little-endian length prefix. A message can be sent as multiple buffers.
+	// If nothing is queued on the connection, the frame is sent directly from the caller's buffers with a single
+	// vectored send (WSASend or sendmsg), and only its unsent part is copied to the send queue. The queued messages
+	// of a connection are written with a single gathering write.
+	//
+	// The handlers are called on the event loop thread. Sending is thread-safe and doesn't block: if the queued,
+	// unsent data of a connection would exceed the limit of the settings, the message is rejected and Send
+	// returns false. The caller can then drop the message or retry later.
+
+	struct AsyncSocketBuffer
+	{
+		const void* Data;
+		size_t Size;
+	};
+
+	struct AsyncSocketSettings
+	{
+		// Connections sending larger messages are closed.
+		size_t MaxMessageSize = 64 * 1024 * 1024;
+
+		// The back-pressure limit of the queued, unsent data per connection.
+		size_t MaxQueuedSendSize = 16 * 1024 * 1024;
+
+		size_t ReceiveBufferSize = 64 * 1024;
+		bool IsNoDelay = true;
+	};
+
+	typedef std::uint32_t AsyncSocketConnectionId;
+
+	typedef std::function<void(AsyncSocketConnectionId connectionId)> AsyncSocketConnectionHandler;
+
+	// The message data is only valid during the call.
+	typedef std::function<void(AsyncSocketConnectionId connectionId, const unsigned char* message,
+		size_t size)> AsyncSocketMessageHandler;
+
+	class AsyncSocketServer
+	{
+		std::unique_ptr<detail::AsyncSocketServerImplementor> m_Implementor;
+
+	public:
+
+		AsyncSocketServer(const AsyncSocketSettings& settings = AsyncSocketSettings());
+		~AsyncSocketServer();
+
+		// The handlers must be set before starting the server.
+		void SetConnectionHandler(AsyncSocketConnectionHandler handler);
+		void SetDisconnectionHandler(AsyncSocketConnectionHandler handler);
+		void SetMessageHandler(AsyncSocketMessageHandler handler);
+
+		bool HasError() const;
+		void ClearError();
+
+		// Port number 0 selects a free port, which can be queried with GetPortNumber.
+		void Start(unsigned short portNumber);
+		void Stop();
+
+		unsigned short GetPortNumber() const;
+		size_t GetCountConnections() const;
+
+		bool Send(AsyncSocketConnectionId connectionId, const void* buffer, size_t size);
+		bool Send(AsyncSocketConnectionId connectionId, const AsyncSocketBuffer* buffers, unsigned countBuffers);
+
+		// Sends the message to all connections, copying it only once. Returns the count of the connections
+		// which have accepted the message.
+		unsigned Broadcast(const void* buffer, size_t size);
+		unsigned Broadcast(const AsyncSocketBuffer* buffers, unsigned countBuffers);
+
+		size_t GetQueuedSendSize(AsyncSocketConnectionId connectionId) const;
+
+		void CloseConnection(AsyncSocketConnectionId connectionId);
+	};
+
+	class AsyncSocketClient
+	{
+		std::unique_ptr<detail::AsyncSocketClientImplementor> m_Implementor;
+
+	public:
+
+		AsyncSocketClient(const AsyncSocketSettings& settings = AsyncSocketSettings());
+		~AsyncSocketClient();
+
+		// The handlers must be set before starting the client. The connection id is always 0.
+		void SetDisconnectionHandler(AsyncSocketConnectionHandler handler);
+		void SetMessageHandler(AsyncSocketMessageHandler handler);
+
+		bool HasError() const;
+		void ClearError();
+
+		void Start(const std::string& hostName, unsigned short portNumber);
+		void Stop();
+
+		bool IsConnected() const;
+
+		bool Send(const void* buffer, size_t size);
+		bool Send(const AsyncSocketBuffer* buffers, unsigned countBuffers);
+
+		size_t GetQueuedSendSize() const;
+	};
+}
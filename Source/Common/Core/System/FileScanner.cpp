@@ -0,0 +1,188 @@
+// Core/System/FileScanner.cpp
+
+#include <Core/System/FileScanner.h>
+
+#include <Core/Platform.h>
+#include <Core/System/ThreadPool.h>
+
+#ifdef IS_WINDOWS
+#include <filesystem>
+#else
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+
+namespace Core
+{
+	namespace detail
+	{
+		// Below this count the work is not distributed to the threads.
+		const size_t c_MinCountParallelStatusQueries = 64;
+		const size_t c_MinCountParallelDirectoryScans = 2;
+
+#ifndef IS_WINDOWS
+		inline FileStatus ToFileStatus(const struct stat& pathStat)
+		{
+#if defined(__APPLE__)
+			auto& modificationTime = pathStat.st_mtimespec;
+#else
+			auto& modificationTime = pathStat.st_mtim;
+#endif
+			FileStatus status;
+			status.Exists = true;
+			status.IsDirectory = S_ISDIR(pathStat.st_mode);
+			status.LastWriteTime = static_cast<long long>(modificationTime.tv_sec) * 1000000000LL + modificationTime.tv_nsec;
+			status.Size = static_cast<std::uint64_t>(pathStat.st_size);
+			return status;
+		}
+#endif
+
+		inline FileStatus GetNonExistingFileStatus()
+		{
+			return { false, false, 0, 0 };
+		}
+
+		inline std::string JoinPath(const std::string& directoryPath, const char* name)
+		{
+			std::string path = directoryPath;
+			if (!path.empty() && path.back() != '/' && path.back() != '\\') path += '/';
+			path += name;
+			return path;
+		}
+
+		// Appends the entries of a single directory and the paths of its subdirectories.
+		void ScanSingleDirectory(const std::string& path, std::vector<DirectoryEntry>& entries,
+			std::vector<std::string>& subdirectoryPaths)
+		{
+#ifdef IS_WINDOWS
+			std::error_code error;
+			for (auto it = std::filesystem::directory_iterator(path, error);
+				!error && it != std::filesystem::directory_iterator(); it.increment(error))
+			{
+				auto& entry = *it;
+				std::error_code entryError;
+				DirectoryEntry result;
+				result.Path = JoinPath(path, entry.path().filename().string().c_str());
+				result.Status.Exists = true;
+				result.Status.IsDirectory = entry.is_directory(entryError);
+				result.Status.LastWriteTime = entry.last_write_time(entryError).time_since_epoch().count();
+				result.Status.Size = (result.Status.IsDirectory ? 0 : entry.file_size(entryError));
+				if (result.Status.IsDirectory) subdirectoryPaths.push_back(result.Path);
+				entries.push_back(std::move(result));
+			}
+#else
+			auto directory = opendir(path.c_str());
+			if (directory == nullptr) return;
+			int directoryDesc = dirfd(directory);
+			while (auto entry = readdir(directory))
+			{
+				auto name = entry->d_name;
+				if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) continue;
+
+				// Querying relative to the directory avoids resolving the whole path again.
+				struct stat pathStat;
+				if (fstatat(directoryDesc, name, &pathStat, 0) != 0) continue;
+				DirectoryEntry result;
+				result.Path = JoinPath(path, name);
+				result.Status = ToFileStatus(pathStat);
+				if (result.Status.IsDirectory) subdirectoryPaths.push_back(result.Path);
+				entries.push_back(std::move(result));
+			}
+			closedir(directory);
+#endif
+		}
+
+		struct DirectoryScanLevel
+		{
+			const std::vector<std::string>* Paths;
+			std::vector<std::vector<DirectoryEntry>> Entries;
+			std::vector<std::vector<std::string>> SubdirectoryPaths;
+		};
+
+		void ScanDirectories(unsigned threadId, unsigned startIndex, unsigned endIndex, DirectoryScanLevel* pLevel)
+		{
+			for (unsigned i = startIndex; i < endIndex; i++)
+			{
+				ScanSingleDirectory((*pLevel->Paths)[i], pLevel->Entries[threadId], pLevel->SubdirectoryPaths[threadId]);
+			}
+		}
+
+		void GetFileStatusRange(unsigned threadId, unsigned startIndex, unsigned endIndex,
+			const std::string* paths, FileStatus* statuses)
+		{
+			for (unsigned i = startIndex; i < endIndex; i++) statuses[i] = GetFileStatus(paths[i]);
+		}
+	}
+
+	FileStatus GetFileStatus(const std::string& path)
+	{
+#ifdef IS_WINDOWS
+		std::error_code error;
+		auto fileStatus = std::filesystem::status(path, error);
+		if (error || !std::filesystem::exists(fileStatus)) return detail::GetNonExistingFileStatus();
+		FileStatus status;
+		status.Exists = true;
+		status.IsDirectory = std::filesystem::is_directory(fileStatus);
+		status.LastWriteTime = std::filesystem::last_write_time(path, error).time_since_epoch().count();
+		status.Size = (status.IsDirectory ? 0 : std::filesystem::file_size(path, error));
+		return status;
+#else
+		struct stat pathStat;
+		if (stat(path.c_str(), &pathStat) != 0) return detail::GetNonExistingFileStatus();
+		return detail::ToFileStatus(pathStat);
+#endif
+	}
+
+	void GetFileStatuses(const std::string* paths, size_t countPaths, FileStatus* statuses, ThreadPool* pThreadPool)
+	{
+		if (pThreadPool == nullptr || countPaths < detail::c_MinCountParallelStatusQueries)
+		{
+			detail::GetFileStatusRange(0, 0, static_cast<unsigned>(countPaths), paths, statuses);
+		}
+		else
+		{
+			pThreadPool->ExecuteWithStaticScheduling(static_cast<unsigned>(countPaths), &detail::GetFileStatusRange,
+				paths, statuses);
+		}
+	}
+
+	void ScanDirectory(const std::string& path, std::vector<DirectoryEntry>& entries, bool isRecursive,
+		ThreadPool* pThreadPool)
+	{
+		std::vector<std::string> paths(1, path);
+		std::vector<std::string> subdirectoryPaths;
+		detail::DirectoryScanLevel level;
+		while (!paths.empty())
+		{
+			subdirectoryPaths.clear();
+			if (pThreadPool == nullptr || paths.size() < detail::c_MinCountParallelDirectoryScans)
+			{
+				for (auto& directoryPath : paths) detail::ScanSingleDirectory(directoryPath, entries, subdirectoryPaths);
+			}
+			else
+			{
+				unsigned countThreads = pThreadPool->GetCountThreads();
+				level.Paths = &paths;
+				level.Entries.resize(countThreads);
+				level.SubdirectoryPaths.resize(countThreads);
+				pThreadPool->ExecuteWithStaticScheduling(static_cast<unsigned>(paths.size()), &detail::ScanDirectories,
+					&level);
+				for (unsigned i = 0; i < countThreads; i++)
+				{
+					auto& threadEntries = level.Entries[i];
+					auto& threadSubdirectoryPaths = level.SubdirectoryPaths[i];
+					entries.insert(entries.end(), std::make_move_iterator(threadEntries.begin()),
+						std::make_move_iterator(threadEntries.end()));
+					subdirectoryPaths.insert(subdirectoryPaths.end(), std::make_move_iterator(threadSubdirectoryPaths.begin()),
+						std::make_move_iterator(threadSubdirectoryPaths.end()));
+					threadEntries.clear();
+					threadSubdirectoryPaths.clear();
+				}
+			}
+			if (!isRecursive) break;
+			paths.swap(subdirectoryPaths);
+		}
+	}
+}
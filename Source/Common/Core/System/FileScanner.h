@@ -0,0 +1,45 @@
+// Core/System/FileScanner.h
+
+#ifndef _CORE_FILESCANNER_H_INCLUDED_
+#define _CORE_FILESCANNER_H_INCLUDED_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Core
+{
+	class ThreadPool;
+
+	struct FileStatus
+	{
+		bool Exists;
+		bool IsDirectory;
+
+		// Only comparable to other values of FileStatus: nanoseconds on POSIX systems, file clock ticks on Windows.
+		long long LastWriteTime;
+
+		std::uint64_t Size;
+	};
+
+	struct DirectoryEntry
+	{
+		std::string Path;
+		FileStatus Status;
+	};
+
+	FileStatus GetFileStatus(const std::string& path);
+
+	// Queries the statuses of the files with the threads of the thread pool, if it is given.
+	void GetFileStatuses(const std::string* paths, size_t countPaths, FileStatus* statuses,
+		ThreadPool* pThreadPool = nullptr);
+
+	// Appends the files and directories of the directory to the entries. The paths are the directory path
+	// joined with the file names. The subdirectories are scanned level by level, each level in parallel
+	// with the threads of the thread pool, if it is given. The order of the entries is unspecified.
+	void ScanDirectory(const std::string& path, std::vector<DirectoryEntry>& entries, bool isRecursive = true,
+		ThreadPool* pThreadPool = nullptr);
+}
+
+#endif
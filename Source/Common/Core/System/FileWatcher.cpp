@@ -0,0 +1,283 @@
+// Core/System/FileWatcher.cpp
+
+#include <Core/System/FileWatcher.h>
+
+#include <Core/Platform.h>
+#include <Core/Windows.h>
+#include <Core/System/FileScanner.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#ifndef IS_WINDOWS
+#include <errno.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <unordered_map>
+#endif
+
+namespace Core
+{
+	namespace detail
+	{
+		const size_t c_FileWatcherBufferSize = 64 * 1024;
+
+		inline std::string JoinWatchedPath(const std::string& directoryPath, const char* name, size_t nameLength)
+		{
+			std::string path = directoryPath;
+			if (!path.empty() && path.back() != '/' && path.back() != '\\') path += '/';
+			path.append(name, nameLength);
+			return path;
+		}
+
+		class FileWatcherImplementor
+		{
+			std::string m_DirectoryPath;
+			FileChangeHandler m_Handler;
+			std::thread m_Thread;
+
+#ifdef IS_WINDOWS
+
+			HANDLE m_DirectoryHandle;
+			HANDLE m_StopEvent;
+
+			void Run()
+			{
+				alignas(DWORD) BYTE buffer[c_FileWatcherBufferSize];
+				OVERLAPPED overlapped = {};
+				overlapped.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+				HANDLE events[] = { overlapped.hEvent, m_StopEvent };
+				while (true)
+				{
+					ResetEvent(overlapped.hEvent);
+					if (!ReadDirectoryChangesW(m_DirectoryHandle, buffer, sizeof(buffer), TRUE,
+						FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE,
+						nullptr, &overlapped, nullptr)) break;
+
+					DWORD countBytes = 0;
+					if (WaitForMultipleObjects(2, events, FALSE, INFINITE) != WAIT_OBJECT_0
+						|| !GetOverlappedResult(m_DirectoryHandle, &overlapped, &countBytes, FALSE))
+					{
+						CancelIo(m_DirectoryHandle);
+						GetOverlappedResult(m_DirectoryHandle, &overlapped, &countBytes, TRUE);
+						break;
+					}
+
+					// Zero bytes means that the buffer has overflown: the changes are lost.
+					if (countBytes == 0) continue;
+
+					auto info = reinterpret_cast<FILE_NOTIFY_INFORMATION*>(buffer);
+					while (true)
+					{
+						int nameLength = static_cast<int>(info->FileNameLength / sizeof(WCHAR));
+						int utf8Length = WideCharToMultiByte(CP_UTF8, 0, info->FileName, nameLength, nullptr, 0, nullptr, nullptr);
+						std::string name(static_cast<size_t>(utf8Length), '\0');
+						WideCharToMultiByte(CP_UTF8, 0, info->FileName, nameLength, &name[0], utf8Length, nullptr, nullptr);
+						for (auto& c : name) if (c == '\\') c = '/';
+
+						FileChange change;
+						change.Path = JoinWatchedPath(m_DirectoryPath, name.c_str(), name.length());
+						switch (info->Action)
+						{
+						case FILE_ACTION_ADDED: case FILE_ACTION_RENAMED_NEW_NAME: change.Type = FileChangeType::Created; break;
+						case FILE_ACTION_REMOVED: case FILE_ACTION_RENAMED_OLD_NAME: change.Type = FileChangeType::Removed; break;
+						default: change.Type = FileChangeType::Modified; break;
+						}
+						m_Handler(change);
+
+						if (info->NextEntryOffset == 0) break;
+						info = reinterpret_cast<FILE_NOTIFY_INFORMATION*>(reinterpret_cast<BYTE*>(info) + info->NextEntryOffset);
+					}
+				}
+				CloseHandle(overlapped.hEvent);
+			}
+
+			void Open()
+			{
+				m_DirectoryHandle = CreateFileA(m_DirectoryPath.c_str(), FILE_LIST_DIRECTORY,
+					FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+					FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+				if (m_DirectoryHandle == INVALID_HANDLE_VALUE)
+				{
+					throw std::runtime_error("Failed to watch directory: " + m_DirectoryPath);
+				}
+				m_StopEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+			}
+
+			void Close()
+			{
+				SetEvent(m_StopEvent);
+				m_Thread.join();
+				CloseHandle(m_StopEvent);
+				CloseHandle(m_DirectoryHandle);
+			}
+
+#else
+
+			int m_InotifyDesc;
+			int m_StopEventDesc;
+
+			// Watch descriptor -> directory path. Only accessed by the watcher thread after starting.
+			std::unordered_map<int, std::string> m_WatchedDirectories;
+
+			const std::uint32_t c_WatchMask = IN_CREATE | IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE
+				| IN_ONLYDIR;
+
+			void AddWatch(const std::string& directoryPath)
+			{
+				int watchDesc = inotify_add_watch(m_InotifyDesc, directoryPath.c_str(), c_WatchMask);
+				if (watchDesc >= 0) m_WatchedDirectories[watchDesc] = directoryPath;
+			}
+
+			// Inotify is not recursive, thus all subdirectories are watched separately. The files of a new directory
+			// may be created before its watch is added, so they are reported here.
+			void AddWatchRecursively(const std::string& directoryPath, bool isReportingFiles)
+			{
+				AddWatch(directoryPath);
+				std::vector<DirectoryEntry> entries;
+				ScanDirectory(directoryPath, entries);
+				for (auto& entry : entries)
+				{
+					if (entry.Status.IsDirectory) AddWatch(entry.Path);
+					else if (isReportingFiles) m_Handler({ entry.Path, FileChangeType::Created });
+				}
+			}
+
+			void ProcessEvent(const inotify_event& event)
+			{
+				if ((event.mask & IN_IGNORED) != 0)
+				{
+					m_WatchedDirectories.erase(event.wd);
+					return;
+				}
+				auto it = m_WatchedDirectories.find(event.wd);
+				if (it == m_WatchedDirectories.end() || event.len == 0) return;
+
+				auto path = JoinWatchedPath(it->second, event.name, strlen(event.name));
+				if ((event.mask & IN_ISDIR) != 0)
+				{
+					if ((event.mask & (IN_CREATE | IN_MOVED_TO)) != 0) AddWatchRecursively(path, true);
+					return;
+				}
+
+				FileChange change;
+				change.Path = std::move(path);
+				if ((event.mask & (IN_CREATE | IN_MOVED_TO)) != 0) change.Type = FileChangeType::Created;
+				else if ((event.mask & (IN_DELETE | IN_MOVED_FROM)) != 0) change.Type = FileChangeType::Removed;
+				else change.Type = FileChangeType::Modified;
+				m_Handler(change);
+			}
+
+			void Run()
+			{
+				alignas(inotify_event) char buffer[c_FileWatcherBufferSize];
+				pollfd descs[] = { { m_InotifyDesc, POLLIN, 0 }, { m_StopEventDesc, POLLIN, 0 } };
+				while (true)
+				{
+					if (poll(descs, 2, -1) < 0)
+					{
+						if (errno == EINTR) continue;
+						break;
+					}
+					if ((descs[1].revents & POLLIN) != 0) break;
+
+					auto countBytes = read(m_InotifyDesc, buffer, sizeof(buffer));
+					if (countBytes <= 0) continue;
+					for (char* pEvent = buffer; pEvent < buffer + countBytes;)
+					{
+						auto& event = *reinterpret_cast<inotify_event*>(pEvent);
+						ProcessEvent(event);
+						pEvent += sizeof(inotify_event) + event.len;
+					}
+				}
+			}
+
+			void Open()
+			{
+				m_InotifyDesc = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+				m_StopEventDesc = eventfd(0, EFD_CLOEXEC);
+				if (m_InotifyDesc < 0 || m_StopEventDesc < 0)
+				{
+					ReleaseDescriptors();
+					throw std::runtime_error("Failed to initialize file watching.");
+				}
+				AddWatchRecursively(m_DirectoryPath, false);
+				if (m_WatchedDirectories.empty())
+				{
+					ReleaseDescriptors();
+					throw std::runtime_error("Failed to watch directory: " + m_DirectoryPath);
+				}
+			}
+
+			void ReleaseDescriptors()
+			{
+				if (m_InotifyDesc >= 0) close(m_InotifyDesc);
+				if (m_StopEventDesc >= 0) close(m_StopEventDesc);
+				m_InotifyDesc = m_StopEventDesc = -1;
+				m_WatchedDirectories.clear();
+			}
+
+			void Close()
+			{
+				std::uint64_t value = 1;
+				while (write(m_StopEventDesc, &value, sizeof(value)) < 0 && errno == EINTR);
+				m_Thread.join();
+				ReleaseDescriptors();
+			}
+
+#endif
+
+		public:
+
+			FileWatcherImplementor(const std::string& directoryPath, FileChangeHandler handler)
+				: m_DirectoryPath(directoryPath)
+				, m_Handler(std::move(handler))
+#ifdef IS_WINDOWS
+				, m_DirectoryHandle(INVALID_HANDLE_VALUE)
+				, m_StopEvent(nullptr)
+#else
+				, m_InotifyDesc(-1)
+				, m_StopEventDesc(-1)
+#endif
+			{
+				Open();
+				m_Thread = std::thread([this]() { Run(); });
+			}
+
+			~FileWatcherImplementor()
+			{
+				Close();
+			}
+		};
+	}
+}
+
+using namespace Core;
+
+FileWatcher::FileWatcher()
+{
+}
+
+FileWatcher::~FileWatcher()
+{
+}
+
+void FileWatcher::Start(const std::string& directoryPath, FileChangeHandler handler)
+{
+	m_Implementor.reset();
+	m_Implementor = std::make_unique<detail::FileWatcherImplementor>(directoryPath, std::move(handler));
+}
+
+void FileWatcher::Stop()
+{
+	m_Implementor.reset();
+}
+
+bool FileWatcher::IsWatching() const
+{
+	return (m_Implementor != nullptr);
+}
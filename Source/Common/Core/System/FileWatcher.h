@@ -0,0 +1,52 @@
+// Core/System/FileWatcher.h
+
+#ifndef _CORE_FILEWATCHER_H_INCLUDED_
+#define _CORE_FILEWATCHER_H_INCLUDED_
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace Core
+{
+	namespace detail
+	{
+		class FileWatcherImplementor;
+	}
+
+	enum class FileChangeType : unsigned char
+	{
+		Modified, Created, Removed
+	};
+
+	struct FileChange
+	{
+		std::string Path;
+		FileChangeType Type;
+	};
+
+	// Called on the thread of the watcher.
+	typedef std::function<void(const FileChange& change)> FileChangeHandler;
+
+	// Watches a directory recursively for file changes without polling: with inotify on Linux
+	// and ReadDirectoryChangesW on Windows. The paths of the changes are the directory path joined with
+	// the relative paths of the changed files. A file which is written is reported when it's closed (on Linux)
+	// or on each write (on Windows).
+	class FileWatcher
+	{
+		std::unique_ptr<detail::FileWatcherImplementor> m_Implementor;
+
+	public:
+
+		FileWatcher();
+		~FileWatcher();
+
+		// Throws if the directory can't be watched.
+		void Start(const std::string& directoryPath, FileChangeHandler handler);
+		void Stop();
+
+		bool IsWatching() const;
+	};
+}
+
+#endif
@@ -9,6 +9,7 @@
 #include <filesystem>
 #else
 #include <Core/String.hpp>
+#include <Core/StringSearch.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -49,30 +50,27 @@ namespace Core
 			path.Tokens.push_back({ "", type });
 		}
 
-		inline void _AddToken(Path& path, const char* cPath, int start, int end, PathTokenType type)
+		inline void _AddToken(Path& path, const char* cPath, size_t start, size_t end, PathTokenType type)
 		{
-			auto size = end - start;
-			auto buffer = new char[size + 1];
-			strncpy(buffer, cPath + start, size);
-			path.Tokens.push_back({ buffer, type });
+			path.Tokens.push_back({ std::string(cPath + start, end - start), type });
 		}
 
 		inline Path ParsePath(const std::string& path)
 		{
-			int length = (int)path.length();
-			char* cPath = new char[length + 1];
-			strcpy(cPath, Core::Trim(path).c_str());
-			for (auto pc = cPath; *pc; ++pc) if (*pc == '\\') *pc = '/';
+			auto trimmedPath = Core::TrimView(path);
+			std::string normalizedPath(trimmedPath);
+			for (auto& c : normalizedPath) if (c == '\\') c = '/';
+			auto cPath = normalizedPath.c_str();
+			size_t length = normalizedPath.length();
 			Path pPath;
 			if (length == 0) return pPath;
-			auto& tokens = pPath.Tokens;
-			int index = 0;
-			int startIndex = 0;
+			size_t index = 0;
+			size_t startIndex = 0;
 			if (cPath[0] == '/')
 			{
 				if (length > 1 && cPath[1] == '/')
 				{
-					for (index = 2; index < length && cPath[index] != '/'; ++index);
+					index = 2 + FindCharacter(cPath + 2, length - 2, '/');
 					_AddToken(pPath, cPath, 0, index, PathTokenType::RootName);
 				}
 				else { _AddToken(pPath, PathTokenType::RootDirectory); index = 1; }
@@ -103,11 +101,10 @@ namespace Core
 				}
 				if (!processed)
 				{
-					for (; index < length && cPath[index] != '/'; ++index);
+					index += FindCharacter(cPath + index, length - index, '/');
 					_AddToken(pPath, cPath, startIndex, index, PathTokenType::FileName);
 				}
 			}
-			delete[] cPath;
 			return pPath;
 		}
 
@@ -219,6 +216,26 @@ namespace Core
 #endif
 	}
 
+	// Returns the absolute path with the '.' and '..' elements removed where it's possible.
+	inline std::string GetAbsolutePath(const std::string& path)
+	{
+#ifdef IS_WINDOWS
+		return std::filesystem::absolute(path).lexically_normal().generic_string();
+#else
+		auto pPath = detail::ParsePath(path);
+		if (detail::IsRelativePath(pPath))
+		{
+			char buffer[4096];
+			if (getcwd(buffer, sizeof(buffer)) == nullptr) return path;
+			auto currentPath = detail::ParsePath(buffer);
+			currentPath.Tokens.insert(currentPath.Tokens.end(), pPath.Tokens.begin(), pPath.Tokens.end());
+			pPath = std::move(currentPath);
+		}
+		detail::ReducePath(pPath);
+		return detail::ToString(pPath);
+#endif
+	}
+
 	inline long long GetLastWriteTime(const std::string& path)
 	{
 #ifdef IS_WINDOWS
@@ -247,8 +264,7 @@ namespace Core
 		return std::filesystem::is_directory(path);
 #else
 		struct stat path_stat;
-		stat(path.c_str(), &path_stat);
-		return S_ISDIR(path_stat.st_mode);
+		return (stat(path.c_str(), &path_stat) == 0 && S_ISDIR(path_stat.st_mode));
 #endif
 	}
 
@@ -299,7 +315,8 @@ namespace Core
 
 	inline void CreateDirectoryPath(const std::string& path)
 	{
-		if (!FileExists(path))
+		// The parent path of a relative path with a single element is empty.
+		if (!path.empty() && !FileExists(path))
 		{
 			CreateDirectoryPath(GetParentPath(path));
 			CreateDirectory_(path);
@@ -0,0 +1,212 @@
+// Core/System/MemoryMappedFile.cpp
+
+#include <Core/System/MemoryMappedFile.h>
+
+#include <Core/Platform.h>
+#include <Core/Windows.h>
+
+#ifndef IS_WINDOWS
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#endif
+
+#include <cassert>
+#include <sstream>
+#include <stdexcept>
+
+namespace Core
+{
+	namespace detail
+	{
+		struct MMF_Data
+		{
+			const unsigned char* MappedPtr;
+			size_t Size;
+
+#ifdef IS_WINDOWS
+			HANDLE		FileHandle;
+			HANDLE		MappingHandle;
+#endif
+		};
+
+		// Empty files cannot be mapped: their data pointer points here, thus it is never null and it is aligned.
+		alignas(64) const unsigned char c_EmptyFileData[1] = {};
+
+		inline void ThrowMappingError(const char* path, const char* operation)
+		{
+			std::stringstream ss;
+			ss << "An error has occured while " << operation << ": " << path;
+#ifdef IS_WINDOWS
+			ss << " (" << GetLastError() << ")";
+#endif
+			throw std::runtime_error(ss.str().c_str());
+		}
+
+		MMF_Data* OpenMapping(const char* path)
+		{
+			std::unique_ptr<MMF_Data> pData(new MMF_Data());
+			pData->MappedPtr = nullptr;
+			pData->Size = 0;
+
+#ifdef IS_WINDOWS
+			pData->MappingHandle = nullptr;
+			pData->FileHandle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+				FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			if (pData->FileHandle == INVALID_HANDLE_VALUE)
+			{
+				ThrowMappingError(path, "opening");
+			}
+			LARGE_INTEGER fileSize;
+			if (!GetFileSizeEx(pData->FileHandle, &fileSize))
+			{
+				CloseHandle(pData->FileHandle);
+				ThrowMappingError(path, "getting the file size");
+			}
+			pData->Size = static_cast<size_t>(fileSize.QuadPart);
+
+			// Empty files cannot be mapped.
+			if (pData->Size > 0)
+			{
+				pData->MappingHandle = CreateFileMappingA(pData->FileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+				if (pData->MappingHandle == nullptr)
+				{
+					CloseHandle(pData->FileHandle);
+					ThrowMappingError(path, "creating file mapping");
+				}
+				pData->MappedPtr = reinterpret_cast<const unsigned char*>(
+					MapViewOfFile(pData->MappingHandle, FILE_MAP_READ, 0, 0, 0));
+				if (pData->MappedPtr == nullptr)
+				{
+					CloseHandle(pData->MappingHandle);
+					CloseHandle(pData->FileHandle);
+					ThrowMappingError(path, "mapping file view");
+				}
+			}
+#else
+			auto fileDesc = open(path, O_RDONLY);
+			if (fileDesc < 0)
+			{
+				ThrowMappingError(path, "opening");
+			}
+			struct stat fileStat;
+			if (fstat(fileDesc, &fileStat) < 0)
+			{
+				close(fileDesc);
+				ThrowMappingError(path, "getting the file size");
+			}
+			pData->Size = static_cast<size_t>(fileStat.st_size);
+
+			// Empty files cannot be mapped.
+			if (pData->Size > 0)
+			{
+				auto mappedPtr = mmap(nullptr, pData->Size, PROT_READ, MAP_PRIVATE, fileDesc, 0);
+				if (mappedPtr == MAP_FAILED)
+				{
+					close(fileDesc);
+					ThrowMappingError(path, "mapping file view");
+				}
+				pData->MappedPtr = reinterpret_cast<const unsigned char*>(mappedPtr);
+
+				// The data is typically read sequentially by the deserialization. The advice values are not flags,
+				// thus they are given separately.
+				madvise(mappedPtr, pData->Size, MADV_SEQUENTIAL);
+				madvise(mappedPtr, pData->Size, MADV_WILLNEED);
+			}
+
+			// The mapping remains valid after closing the file descriptor.
+			close(fileDesc);
+#endif
+
+			return pData.release();
+		}
+
+		void CloseMapping(MMF_Data* pData)
+		{
+			if (pData == nullptr) return;
+#ifdef IS_WINDOWS
+			if (pData->MappedPtr != nullptr)
+			{
+				UnmapViewOfFile(pData->MappedPtr);
+				CloseHandle(pData->MappingHandle);
+			}
+			CloseHandle(pData->FileHandle);
+#else
+			if (pData->MappedPtr != nullptr)
+			{
+				munmap(const_cast<unsigned char*>(pData->MappedPtr), pData->Size);
+			}
+#endif
+		}
+	}
+
+	MemoryMappedFile::MemoryMappedFile()
+	{
+	}
+
+	MemoryMappedFile::MemoryMappedFile(const char* path)
+	{
+		Open(path);
+	}
+
+	MemoryMappedFile::MemoryMappedFile(const std::string& path)
+	{
+		Open(path);
+	}
+
+	MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& other)
+		: m_Data(std::move(other.m_Data))
+	{
+	}
+
+	MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& other)
+	{
+		if (this != &other)
+		{
+			Close();
+			m_Data = std::move(other.m_Data);
+		}
+		return *this;
+	}
+
+	MemoryMappedFile::~MemoryMappedFile()
+	{
+		Close();
+	}
+
+	void MemoryMappedFile::Open(const char* path)
+	{
+		Close();
+		m_Data.reset(detail::OpenMapping(path));
+	}
+
+	void MemoryMappedFile::Open(const std::string& path)
+	{
+		Open(path.c_str());
+	}
+
+	void MemoryMappedFile::Close()
+	{
+		detail::CloseMapping(m_Data.get());
+		m_Data.reset();
+	}
+
+	bool MemoryMappedFile::IsOpened() const
+	{
+		return (m_Data != nullptr);
+	}
+
+	const unsigned char* MemoryMappedFile::GetData() const
+	{
+		assert(IsOpened());
+		return (m_Data->MappedPtr != nullptr ? m_Data->MappedPtr : detail::c_EmptyFileData);
+	}
+
+	size_t MemoryMappedFile::GetSize() const
+	{
+		assert(IsOpened());
+		return m_Data->Size;
+	}
+}
@@ -0,0 +1,43 @@
+// Core/System/MemoryMappedFile.h
+
+#ifndef _CORE_MEMORYMAPPEDFILE_H_INCLUDED_
+#define _CORE_MEMORYMAPPEDFILE_H_INCLUDED_
+
+#include <memory>
+#include <string>
+
+namespace Core
+{
+	namespace detail
+	{
+		struct MMF_Data;
+	}
+
+	// Read-only memory mapping of a whole file. The mapped data is page-aligned.
+	// Views created into the mapped data are valid until the file is closed.
+	// Empty files are not mapped, but their data pointer is still valid and aligned.
+	class MemoryMappedFile
+	{
+		std::unique_ptr<detail::MMF_Data> m_Data;
+
+	public:
+
+		MemoryMappedFile();
+		explicit MemoryMappedFile(const char* path);
+		explicit MemoryMappedFile(const std::string& path);
+		MemoryMappedFile(MemoryMappedFile&& other);
+		MemoryMappedFile& operator=(MemoryMappedFile&& other);
+		~MemoryMappedFile();
+
+		void Open(const char* path);
+		void Open(const std::string& path);
+		void Close();
+
+		bool IsOpened() const;
+
+		const unsigned char* GetData() const;
+		size_t GetSize() const;
+	};
+}
+
+#endif
@@ -179,7 +179,7 @@ namespace Core
 				munmap(tempPtr, sizeof(SM_Header));
 				pData->Size = header.TotalSize - header.HeaderSize;
 			}
-			pData->MappedPtr = mmap(nullptr, sizeof(SM_Header),
+			pData->MappedPtr = mmap(nullptr, _GetTotalSize(pData->Size),
 				(accessMode == SharedMemoryAccessMode::ReadOnly
 					? PROT_READ 
 					: PROT_READ | PROT_WRITE), MAP_SHARED, pData->FileDesc, 0);
@@ -232,7 +232,8 @@ namespace Core
 				CloseHandle(pData->Handle);
 #else
 				munmap(pData->MappedPtr, _GetTotalSize(pData->Size));
-				Unlink(pData);
+				close(pData->FileDesc);
+				if (pData->Role == SharedMemoryHandlingRole::Create) Unlink(pData);
 #endif
 				pData->IsOpened = false;
 			}
@@ -252,7 +253,11 @@ namespace Core
 #else
 			auto fullName = _GetFullName(name);
 			auto fileDesc = shm_open(fullName.c_str(), O_RDONLY, S_IRUSR);
-			if (fileDesc >= 0) shm_unlink(fullName.c_str());
+			if (fileDesc >= 0)
+			{
+				close(fileDesc);
+				shm_unlink(fullName.c_str());
+			}
 #endif
 		}
 
@@ -301,4 +306,10 @@ namespace Core
 	{
 		return Core::detail::GetPointer(m_Data.get());
 	}
+
+	size_t SharedMemory::GetSize() const
+	{
+		assert(m_Data && m_Data->IsOpened);
+		return static_cast<size_t>(m_Data->Size);
+	}
 }
\ No newline at end of file
@@ -40,6 +40,7 @@ namespace Core
 		void Read(unsigned char* buffer, size_t size);
 
 		void* GetPointer();
+		size_t GetSize() const;
 	};
 }
 
@@ -0,0 +1,349 @@
+// Core/System/SharedMemoryRingBuffer.cpp
+
+#include <Core/System/SharedMemoryRingBuffer.h>
+
+#include <Core/Platform.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#define CORE_SMRB_USING_FUTEX
+#endif
+
+namespace Core
+{
+	namespace detail
+	{
+		const std::uint32_t c_SMRB_Magic = 0x42524d53; // "SMRB"
+		const std::uint32_t c_SMRB_Version = 1;
+
+		// The records are aligned to their header size, so the space at the end of the ring
+		// always fits a padding record.
+		const std::uint64_t c_SMRB_RecordAlignment = 16;
+		const std::uint64_t c_SMRB_MinCapacity = 256;
+
+		enum class SMRB_RecordType : std::uint32_t
+		{
+			Message = 1, Padding = 2
+		};
+
+		// A record is committed if its tag equals its position + 1. The consumer clears the tag of the read records.
+		struct SMRB_RecordHeader
+		{
+			std::atomic<std::uint64_t> CommitTag;
+			std::uint32_t Size;
+			SMRB_RecordType Type;
+		};
+
+		struct SMRB_Header
+		{
+			alignas(64) std::atomic<std::uint32_t> Magic;
+			std::uint32_t Version;
+			SharedMemoryRingBufferMode Mode;
+			std::uint64_t Capacity;
+
+			alignas(64) std::atomic<std::uint64_t> WritePosition;
+
+			alignas(64) std::atomic<std::uint64_t> ReadPosition;
+
+			// Futex words, which are incremented to wake the waiting processes.
+			alignas(64) std::atomic<std::uint32_t> DataSignal;
+			std::atomic<std::uint32_t> IsConsumerWaiting;
+
+			alignas(64) std::atomic<std::uint32_t> SpaceSignal;
+			std::atomic<std::uint32_t> CountWaitingProducers;
+		};
+
+		static_assert(sizeof(SMRB_RecordHeader) == c_SMRB_RecordAlignment, "Invalid record header size.");
+		static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Lock-free 64 bit atomics are required.");
+
+		inline std::uint64_t AlignRecordSize(std::uint64_t size)
+		{
+			return (size + c_SMRB_RecordAlignment - 1) & ~(c_SMRB_RecordAlignment - 1);
+		}
+
+		inline std::uint64_t GetPowerOfTwoCapacity(std::uint64_t capacity)
+		{
+			std::uint64_t result = c_SMRB_MinCapacity;
+			while (result < capacity) result <<= 1;
+			return result;
+		}
+
+		typedef std::chrono::steady_clock::time_point SMRB_Deadline;
+
+		inline SMRB_Deadline GetDeadline(int timeoutInMilliseconds)
+		{
+			return (timeoutInMilliseconds < 0
+				? SMRB_Deadline::max()
+				: std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutInMilliseconds));
+		}
+
+		// Blocks while the value equals to the expected value, until woken or until the deadline.
+		// May also return spuriously. Returns false if the deadline has passed.
+		inline bool WaitOnValue(std::atomic<std::uint32_t>& value, std::uint32_t expected, SMRB_Deadline deadline)
+		{
+			auto now = std::chrono::steady_clock::now();
+			if (now >= deadline) return false;
+#ifdef CORE_SMRB_USING_FUTEX
+			timespec timeout;
+			timespec* pTimeout = nullptr;
+			if (deadline != SMRB_Deadline::max())
+			{
+				auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now).count();
+				timeout.tv_sec = static_cast<time_t>(nanoseconds / 1000000000);
+				timeout.tv_nsec = static_cast<long>(nanoseconds % 1000000000);
+				pTimeout = &timeout;
+			}
+			// Not a private futex: the value is shared between processes.
+			syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&value), FUTEX_WAIT, expected, pTimeout, nullptr, 0);
+#else
+			if (value.load() == expected) std::this_thread::yield();
+#endif
+			return true;
+		}
+
+		inline void WakeWaiting(std::atomic<std::uint32_t>& value, int countWaiting)
+		{
+			value.fetch_add(1);
+#ifdef CORE_SMRB_USING_FUTEX
+			syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&value), FUTEX_WAKE, countWaiting, nullptr, nullptr, 0);
+#endif
+		}
+	}
+
+	using namespace detail;
+
+	SharedMemoryRingBuffer::SharedMemoryRingBuffer()
+		: m_Header(nullptr)
+		, m_Data(nullptr)
+		, m_Capacity(0)
+		, m_Mode(SharedMemoryRingBufferMode::SingleProducer)
+		, m_ReadPosition(0)
+		, m_ReadRecordSize(0)
+	{
+	}
+
+	SharedMemoryRingBuffer::~SharedMemoryRingBuffer()
+	{
+	}
+
+	void SharedMemoryRingBuffer::Initialize(SharedMemoryHandlingRole role, const char* name, size_t capacity,
+		SharedMemoryRingBufferMode mode)
+	{
+		if (role == SharedMemoryHandlingRole::Create)
+		{
+			auto powerOfTwoCapacity = GetPowerOfTwoCapacity(capacity);
+			m_SharedMemory.Initialize(role, SharedMemoryAccessMode::ReadWrite, name,
+				static_cast<size_t>(sizeof(SMRB_Header) + powerOfTwoCapacity));
+			auto pMemory = m_SharedMemory.GetPointer();
+			memset(pMemory, 0, m_SharedMemory.GetSize());
+			m_Header = new (pMemory) SMRB_Header();
+			m_Header->Version = c_SMRB_Version;
+			m_Header->Mode = mode;
+			m_Header->Capacity = powerOfTwoCapacity;
+			m_Header->Magic.store(c_SMRB_Magic, std::memory_order_release);
+		}
+		else
+		{
+			m_SharedMemory.Initialize(role, SharedMemoryAccessMode::ReadWrite, name);
+			m_Header = reinterpret_cast<SMRB_Header*>(m_SharedMemory.GetPointer());
+			if (m_SharedMemory.GetSize() < sizeof(SMRB_Header)
+				|| m_Header->Magic.load(std::memory_order_acquire) != c_SMRB_Magic
+				|| m_Header->Version != c_SMRB_Version)
+			{
+				throw std::runtime_error("Invalid shared memory ring buffer.");
+			}
+		}
+		m_Data = reinterpret_cast<unsigned char*>(m_Header + 1);
+		m_Capacity = m_Header->Capacity;
+		m_Mode = m_Header->Mode;
+		m_ReadPosition = m_Header->ReadPosition.load(std::memory_order_acquire);
+		m_ReadRecordSize = 0;
+	}
+
+	size_t SharedMemoryRingBuffer::GetCapacity() const
+	{
+		return static_cast<size_t>(m_Capacity);
+	}
+
+	// A message with padding before it must fit to the ring.
+	size_t SharedMemoryRingBuffer::GetMaxMessageSize() const
+	{
+		return static_cast<size_t>(std::min<std::uint64_t>(m_Capacity / 2 - sizeof(SMRB_RecordHeader), UINT32_MAX));
+	}
+
+	///////////////////////////////////// PRODUCER /////////////////////////////////////
+
+	bool SharedMemoryRingBuffer::TryReserve(size_t size, Reservation& reservation)
+	{
+		if (size > GetMaxMessageSize())
+		{
+			throw std::runtime_error("The message is too large for the shared memory ring buffer.");
+		}
+
+		auto recordSize = AlignRecordSize(sizeof(SMRB_RecordHeader) + size);
+		auto mask = m_Capacity - 1;
+		auto position = m_Header->WritePosition.load(std::memory_order_relaxed);
+		std::uint64_t paddingSize;
+		while (true)
+		{
+			auto offset = position & mask;
+			paddingSize = (offset + recordSize > m_Capacity ? m_Capacity - offset : 0);
+			auto newPosition = position + paddingSize + recordSize;
+			if (newPosition - m_Header->ReadPosition.load(std::memory_order_acquire) > m_Capacity) return false;
+
+			if (m_Mode == SharedMemoryRingBufferMode::SingleProducer)
+			{
+				m_Header->WritePosition.store(newPosition, std::memory_order_relaxed);
+				break;
+			}
+			if (m_Header->WritePosition.compare_exchange_weak(position, newPosition, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+
+		if (paddingSize > 0)
+		{
+			auto padding = reinterpret_cast<SMRB_RecordHeader*>(m_Data + (position & mask));
+			padding->Size = static_cast<std::uint32_t>(paddingSize - sizeof(SMRB_RecordHeader));
+			padding->Type = SMRB_RecordType::Padding;
+			padding->CommitTag.store(position + 1, std::memory_order_release);
+			position += paddingSize;
+		}
+
+		auto record = reinterpret_cast<SMRB_RecordHeader*>(m_Data + (position & mask));
+		record->Size = static_cast<std::uint32_t>(size);
+		record->Type = SMRB_RecordType::Message;
+
+		reservation.Data = record + 1;
+		reservation.Size = size;
+		reservation.Position = position;
+		return true;
+	}
+
+	void SharedMemoryRingBuffer::Commit(const Reservation& reservation)
+	{
+		auto record = reinterpret_cast<SMRB_RecordHeader*>(m_Data + (reservation.Position & (m_Capacity - 1)));
+		record->CommitTag.store(reservation.Position + 1, std::memory_order_release);
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (m_Header->IsConsumerWaiting.load(std::memory_order_relaxed) != 0)
+		{
+			WakeWaiting(m_Header->DataSignal, 1);
+		}
+	}
+
+	bool SharedMemoryRingBuffer::TryWrite(const void* data, size_t size)
+	{
+		Reservation reservation;
+		if (!TryReserve(size, reservation)) return false;
+		if (size > 0) memcpy(reservation.Data, data, size);
+		Commit(reservation);
+		return true;
+	}
+
+	bool SharedMemoryRingBuffer::Write(const void* data, size_t size, int timeoutInMilliseconds)
+	{
+		auto deadline = GetDeadline(timeoutInMilliseconds);
+		while (true)
+		{
+			if (TryWrite(data, size)) return true;
+
+			m_Header->CountWaitingProducers.fetch_add(1);
+			auto signal = m_Header->SpaceSignal.load();
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			bool isWritten = TryWrite(data, size);
+			bool isWaiting = (!isWritten && WaitOnValue(m_Header->SpaceSignal, signal, deadline));
+			m_Header->CountWaitingProducers.fetch_sub(1);
+			if (isWritten) return true;
+			if (!isWaiting) return false;
+		}
+	}
+
+	///////////////////////////////////// CONSUMER /////////////////////////////////////
+
+	// Skips the padding records.
+	bool SharedMemoryRingBuffer::IsReadable()
+	{
+		auto mask = m_Capacity - 1;
+		while (true)
+		{
+			auto record = reinterpret_cast<SMRB_RecordHeader*>(m_Data + (m_ReadPosition & mask));
+			if (record->CommitTag.load(std::memory_order_acquire) != m_ReadPosition + 1) return false;
+			if (record->Type == SMRB_RecordType::Message) return true;
+
+			record->CommitTag.store(0, std::memory_order_relaxed);
+			m_ReadPosition += sizeof(SMRB_RecordHeader) + record->Size;
+			m_Header->ReadPosition.store(m_ReadPosition, std::memory_order_release);
+		}
+	}
+
+	bool SharedMemoryRingBuffer::TryBeginRead(const void*& data, size_t& size)
+	{
+		assert(m_ReadRecordSize == 0);
+		if (!IsReadable()) return false;
+		auto record = reinterpret_cast<SMRB_RecordHeader*>(m_Data + (m_ReadPosition & (m_Capacity - 1)));
+		data = record + 1;
+		size = record->Size;
+		m_ReadRecordSize = AlignRecordSize(sizeof(SMRB_RecordHeader) + size);
+		return true;
+	}
+
+	void SharedMemoryRingBuffer::EndRead()
+	{
+		assert(m_ReadRecordSize > 0);
+		auto record = reinterpret_cast<SMRB_RecordHeader*>(m_Data + (m_ReadPosition & (m_Capacity - 1)));
+		record->CommitTag.store(0, std::memory_order_relaxed);
+		m_ReadPosition += m_ReadRecordSize;
+		m_ReadRecordSize = 0;
+		m_Header->ReadPosition.store(m_ReadPosition, std::memory_order_release);
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (m_Header->CountWaitingProducers.load(std::memory_order_relaxed) != 0)
+		{
+			WakeWaiting(m_Header->SpaceSignal, INT_MAX);
+		}
+	}
+
+	bool SharedMemoryRingBuffer::TryRead(std::vector<unsigned char>& message)
+	{
+		const void* data;
+		size_t size;
+		if (!TryBeginRead(data, size)) return false;
+		auto bytes = reinterpret_cast<const unsigned char*>(data);
+		message.assign(bytes, bytes + size);
+		EndRead();
+		return true;
+	}
+
+	bool SharedMemoryRingBuffer::WaitForMessage(int timeoutInMilliseconds)
+	{
+		auto deadline = GetDeadline(timeoutInMilliseconds);
+		while (true)
+		{
+			if (IsReadable()) return true;
+
+			m_Header->IsConsumerWaiting.store(1);
+			auto signal = m_Header->DataSignal.load();
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			bool isReadable = IsReadable();
+			bool isWaiting = (!isReadable && WaitOnValue(m_Header->DataSignal, signal, deadline));
+			m_Header->IsConsumerWaiting.store(0);
+			if (isReadable) return true;
+			if (!isWaiting) return false;
+		}
+	}
+}
@@ -0,0 +1,89 @@
+// Core/System/SharedMemoryRingBuffer.h
+
+#ifndef _CORE_SHARED_MEMORY_RING_BUFFER_H_
+#define _CORE_SHARED_MEMORY_RING_BUFFER_H_
+
+#include <Core/System/SharedMemory.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Core
+{
+	namespace detail
+	{
+		struct SMRB_Header;
+	}
+
+	enum class SharedMemoryRingBufferMode : unsigned
+	{
+		SingleProducer, MultipleProducers
+	};
+
+	// A lock-free message channel between processes, with a single consumer and one or more producers.
+	//
+	// Variable sized messages are stored contiguously in a ring buffer in a shared memory, so they can be written
+	// and read in place. A message which doesn't fit to the end of the ring is wrapped to its beginning.
+	// The read and write positions are on separate cache lines. The producers reserve the space for their messages
+	// with an atomic increment (or a plain store with a single producer) and commit them independently.
+	//
+	// The Try functions never block. The Wait functions block on a futex on Linux and yield on other platforms.
+	class SharedMemoryRingBuffer
+	{
+		SharedMemory m_SharedMemory;
+		detail::SMRB_Header* m_Header;
+		unsigned char* m_Data;
+		std::uint64_t m_Capacity;
+		SharedMemoryRingBufferMode m_Mode;
+
+		std::uint64_t m_ReadPosition;
+		std::uint64_t m_ReadRecordSize;
+
+		bool IsReadable();
+
+	public:
+
+		// A reserved, not yet committed message.
+		struct Reservation
+		{
+			void* Data;
+			size_t Size;
+			std::uint64_t Position;
+		};
+
+		SharedMemoryRingBuffer();
+		~SharedMemoryRingBuffer();
+
+		// The capacity is rounded up to a power of two. It is read from the shared memory when using the ring buffer.
+		void Initialize(SharedMemoryHandlingRole role, const char* name, size_t capacity = 0,
+			SharedMemoryRingBufferMode mode = SharedMemoryRingBufferMode::SingleProducer);
+
+		size_t GetCapacity() const;
+		size_t GetMaxMessageSize() const;
+
+		///////////////////////////////////// PRODUCER /////////////////////////////////////
+
+		// Returns false if there is not enough space. Throws if the message is larger than the maximum size.
+		bool TryReserve(size_t size, Reservation& reservation);
+		void Commit(const Reservation& reservation);
+
+		bool TryWrite(const void* data, size_t size);
+
+		// Returns false on timeout. A negative timeout means waiting infinitely.
+		bool Write(const void* data, size_t size, int timeoutInMilliseconds = -1);
+
+		///////////////////////////////////// CONSUMER /////////////////////////////////////
+
+		// The message is valid until EndRead, which must be called before reading the next message.
+		bool TryBeginRead(const void*& data, size_t& size);
+		void EndRead();
+
+		bool TryRead(std::vector<unsigned char>& message);
+
+		// Returns false on timeout. A negative timeout means waiting infinitely.
+		bool WaitForMessage(int timeoutInMilliseconds = -1);
+	};
+}
+
+#endif
@@ -0,0 +1,96 @@
+// AsyncFileIOTest.cpp : Defines the entry point for the console application.
+//
+
+#include "stdafx.h"
+
+#include <Core/System/AsyncFileIO.h>
+#include <Core/System/SimpleIO.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+const unsigned c_CountFiles = 64;
+
+std::string GetFilePath(unsigned index)
+{
+	return "AsyncFileIOTest_" + std::to_string(index) + ".bin";
+}
+
+Core::ByteVector GetFileContent(unsigned index)
+{
+	Core::ByteVector bytes;
+	bytes.Resize(index * 4099 + 1);
+	for (size_t i = 0; i < bytes.GetSize(); i++) bytes[i] = static_cast<unsigned char>(i * 31 + index);
+	return bytes;
+}
+
+bool IsEqual(const Core::ByteVector& a, const Core::ByteVector& b)
+{
+	return (a.GetSize() == b.GetSize() && std::equal(a.GetArray(), a.GetArray() + a.GetSize(), b.GetArray()));
+}
+
+void Test(const Core::AsyncFileIOSettings& settings)
+{
+	Core::AsyncFileIO io(settings);
+	auto startTime = std::chrono::steady_clock::now();
+
+	// Writing.
+	std::vector<Core::ByteVector> contents;
+	std::vector<std::future<void>> writeFutures;
+	for (unsigned i = 0; i < c_CountFiles; i++) contents.push_back(GetFileContent(i));
+	for (unsigned i = 0; i < c_CountFiles; i++)
+	{
+		writeFutures.push_back(io.WriteAllBytes(GetFilePath(i).c_str(), contents[i].GetArray(), contents[i].GetSize()));
+	}
+	for (auto& future : writeFutures) future.get();
+	io.WriteAllBytes(GetFilePath(c_CountFiles).c_str(), nullptr, 0).get();
+
+	// Batched reading with futures.
+	std::vector<std::string> paths;
+	for (unsigned i = 0; i <= c_CountFiles; i++) paths.push_back(GetFilePath(i));
+	auto readFutures = io.ReadAllBytes(paths);
+	for (unsigned i = 0; i < c_CountFiles; i++) assert(IsEqual(readFutures[i].get(), contents[i]));
+	assert(readFutures[c_CountFiles].get().GetSize() == 0);
+
+	// Reading with callbacks.
+	std::atomic<unsigned> countCorrect(0);
+	io.ReadAllBytes(paths, [&](Core::AsyncFileResult& result) {
+		unsigned index = std::stoi(result.Path.substr(result.Path.find('_') + 1));
+		if (result.IsSucceeded() && (index == c_CountFiles || IsEqual(result.Bytes, contents[index]))) ++countCorrect;
+	});
+	io.WaitAll();
+	assert(countCorrect == c_CountFiles + 1);
+
+	// Errors.
+	bool isThrowing = false;
+	try { io.ReadAllBytes("AsyncFileIOTest_NonExisting.bin").get(); }
+	catch (const std::runtime_error&) { isThrowing = true; }
+	assert(isThrowing);
+
+	auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+	printf("%s%s: %.2f ms\n", (io.GetBackendType() == Core::AsyncFileIOBackendType::IOUring ? "io_uring" : "thread pool"),
+		(settings.IsUsingDirectIO ? ", direct I/O" : ""), elapsed * 1000.0);
+
+	for (auto& path : paths) remove(path.c_str());
+}
+
+int main()
+{
+	Core::AsyncFileIOSettings settings;
+	Test(settings);
+	settings.IsUsingDirectIO = true;
+	Test(settings);
+	settings.IsUsingIOUring = false;
+	Test(settings);
+	settings.IsUsingIOUring = true;
+	settings.IsUsingDirectIO = false;
+	settings.QueueDepth = 2;
+	Test(settings);
+	return 0;
+}
@@ -0,0 +1,206 @@
+// AsyncSocketTest.cpp : Defines the entry point for the console application.
+//
+// Tests the asynchronous sockets and measures the loopback throughput and latency.
+
+#include "stdafx.h"
+
+#include <Core/System/AsyncSocket.h>
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+const unsigned c_CountClients = 4;
+const unsigned c_CountThroughputMessages = 20000;
+const size_t c_ThroughputMessageSize = 16 * 1024;
+const unsigned c_CountLatencyMessages = 2000;
+
+template <typename Predicate>
+void WaitFor(Predicate predicate)
+{
+	auto startTime = std::chrono::steady_clock::now();
+	while (!predicate())
+	{
+		assert(std::chrono::steady_clock::now() - startTime < std::chrono::seconds(30));
+		std::this_thread::yield();
+	}
+}
+
+double GetElapsedSeconds(std::chrono::steady_clock::time_point startTime)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+int main()
+{
+	Core::AsyncSocketServer server;
+
+	// Echoing the messages which start with 'E'. The messages starting with 'S' carry a sequence number.
+	std::atomic<unsigned> countServerMessages(0);
+	std::atomic<unsigned> countSequenceMessages(0);
+	std::atomic<bool> isSequenceOrdered(true);
+	std::atomic<unsigned> countConnections(0);
+	std::vector<Core::AsyncSocketConnectionId> connectionIds;
+	server.SetConnectionHandler([&](Core::AsyncSocketConnectionId connectionId) {
+		connectionIds.push_back(connectionId);
+		++countConnections;
+	});
+	server.SetMessageHandler([&](Core::AsyncSocketConnectionId connectionId, const unsigned char* message, size_t size) {
+		if (size > 0 && message[0] == 'E') server.Send(connectionId, message, size);
+		if (size == 1 + sizeof(unsigned) && message[0] == 'S')
+		{
+			unsigned index;
+			memcpy(&index, message + 1, sizeof(unsigned));
+			if (index != countSequenceMessages) isSequenceOrdered = false;
+			++countSequenceMessages;
+		}
+		++countServerMessages;
+	});
+	server.Start(0);
+	assert(!server.HasError());
+	unsigned short portNumber = server.GetPortNumber();
+	assert(portNumber != 0);
+
+	struct ClientData
+	{
+		Core::AsyncSocketClient Client;
+		std::atomic<unsigned> CountMessages;
+		std::atomic<size_t> CountBytes;
+		std::vector<unsigned char> LastMessage;
+		std::mutex Mutex;
+	};
+	std::vector<std::unique_ptr<ClientData>> clients;
+	for (unsigned i = 0; i < c_CountClients; i++)
+	{
+		clients.push_back(std::make_unique<ClientData>());
+		auto pClientData = clients.back().get();
+		pClientData->CountMessages = 0;
+		pClientData->CountBytes = 0;
+		pClientData->Client.SetMessageHandler([pClientData](Core::AsyncSocketConnectionId,
+			const unsigned char* message, size_t size) {
+			std::lock_guard<std::mutex> lock(pClientData->Mutex);
+			pClientData->LastMessage.assign(message, message + size);
+			pClientData->CountBytes += size;
+			++pClientData->CountMessages;
+		});
+		pClientData->Client.Start("127.0.0.1", portNumber);
+		assert(!pClientData->Client.HasError() && pClientData->Client.IsConnected());
+	}
+	WaitFor([&]() { return countConnections == c_CountClients; });
+	assert(server.GetCountConnections() == c_CountClients);
+
+	// Gathered sending and framing.
+	{
+		const char* parts[] = { "E", "", "chunk", "ed message" };
+		Core::AsyncSocketBuffer buffers[4];
+		for (unsigned i = 0; i < 4; i++) buffers[i] = { parts[i], strlen(parts[i]) };
+		assert(clients[0]->Client.Send(buffers, 4));
+		WaitFor([&]() { return clients[0]->CountMessages == 1; });
+		std::lock_guard<std::mutex> lock(clients[0]->Mutex);
+		assert(std::string(clients[0]->LastMessage.begin(), clients[0]->LastMessage.end()) == "Echunked message");
+
+		assert(clients[1]->Client.Send("", 0));
+		WaitFor([&]() { return countServerMessages == 2; });
+	}
+
+	// Large gathered message: the socket accepts only a part of it directly, the rest is queued.
+	{
+		std::vector<unsigned char> part1(3 * 1024 * 1024 + 1), part2(5 * 1024 * 1024 + 3);
+		for (size_t i = 0; i < part1.size(); i++) part1[i] = static_cast<unsigned char>(i * 7);
+		for (size_t i = 0; i < part2.size(); i++) part2[i] = static_cast<unsigned char>(i * 13);
+		part1[0] = 'E';
+		Core::AsyncSocketBuffer buffers[] = { { part1.data(), part1.size() }, { "", 0 }, { part2.data(), part2.size() } };
+		clients[0]->CountMessages = 0;
+		assert(clients[0]->Client.Send(buffers, 3));
+		WaitFor([&]() { return clients[0]->CountMessages == 1; });
+		std::lock_guard<std::mutex> lock(clients[0]->Mutex);
+		auto& message = clients[0]->LastMessage;
+		assert(message.size() == part1.size() + part2.size());
+		assert(memcmp(message.data(), part1.data(), part1.size()) == 0);
+		assert(memcmp(message.data() + part1.size(), part2.data(), part2.size()) == 0);
+	}
+
+	// The directly sent and the queued messages are received in order.
+	{
+		const unsigned countMessages = 20000;
+		std::vector<unsigned char> padding(4096, 'P');
+		for (unsigned i = 0; i < countMessages; i++)
+		{
+			Core::AsyncSocketBuffer buffers[] = { { "S", 1 }, { &i, sizeof(unsigned) } };
+			while (!clients[2]->Client.Send(buffers, 2)) std::this_thread::yield();
+
+			// Filling the socket buffer from time to time.
+			if (i % 1000 == 0)
+			{
+				for (unsigned j = 0; j < 1000; j++) while (!clients[2]->Client.Send(padding.data(), padding.size())) std::this_thread::yield();
+			}
+		}
+		WaitFor([&]() { return countSequenceMessages == countMessages; });
+		assert(isSequenceOrdered);
+	}
+
+	// Broadcast throughput: each message is copied once and sent to all clients. The sender waits while
+	// the back-pressure limit would reject the message.
+	{
+		Core::AsyncSocketSettings settings;
+		std::vector<unsigned char> message(c_ThroughputMessageSize, 'B');
+		for (auto& clientData : clients) clientData->CountMessages = 0;
+		auto isQueueFull = [&]() {
+			for (auto connectionId : connectionIds)
+			{
+				if (server.GetQueuedSendSize(connectionId) + c_ThroughputMessageSize > settings.MaxQueuedSendSize) return true;
+			}
+			return false;
+		};
+		auto startTime = std::chrono::steady_clock::now();
+		for (unsigned i = 0; i < c_CountThroughputMessages; i++)
+		{
+			while (isQueueFull()) std::this_thread::yield();
+			unsigned countSent = server.Broadcast(message.data(), message.size());
+			assert(countSent == c_CountClients);
+		}
+		WaitFor([&]() {
+			for (auto& clientData : clients)
+			{
+				if (clientData->CountMessages < c_CountThroughputMessages) return false;
+			}
+			return true;
+		});
+		double seconds = GetElapsedSeconds(startTime);
+		size_t countBytes = 0;
+		for (auto& clientData : clients) countBytes += clientData->CountBytes;
+		printf("Broadcast throughput: %.1f MB/s to %u clients.\n",
+			countBytes / seconds / (1024.0 * 1024.0), c_CountClients);
+	}
+
+	// Round-trip latency.
+	{
+		auto& clientData = *clients[1];
+		clientData.CountMessages = 0;
+		char message[64] = "Echo";
+		auto startTime = std::chrono::steady_clock::now();
+		for (unsigned i = 1; i <= c_CountLatencyMessages; i++)
+		{
+			assert(clientData.Client.Send(message, sizeof(message)));
+			WaitFor([&]() { return clientData.CountMessages == i; });
+		}
+		printf("Round-trip latency: %.1f us\n", GetElapsedSeconds(startTime) * 1e6 / c_CountLatencyMessages);
+	}
+
+	// Disconnection.
+	clients[3]->Client.Stop();
+	WaitFor([&]() { return server.GetCountConnections() == c_CountClients - 1; });
+	server.Stop();
+	WaitFor([&]() { return !clients[0]->Client.IsConnected(); });
+	assert(!clients[0]->Client.Send("E", 1));
+
+	return 0;
+}
@@ -0,0 +1,103 @@
+// BitSetTest.cpp : Defines the entry point for the console application.
+//
+
+#include "stdafx.h"
+
+#include <Core/DataStructures/BitSet.h>
+#include <Core/DataStructures/BitVector.h>
+
+#include <cassert>
+#include <random>
+#include <vector>
+
+std::mt19937 s_RandomGenerator;
+
+void TestBitSet(size_t size)
+{
+	Core::BitSet a(size), b(size);
+	std::vector<bool> refA(size), refB(size);
+	for (size_t i = 0; i < size; i++)
+	{
+		if (s_RandomGenerator() % 3 == 0) { a.Set(i); refA[i] = true; }
+		if (s_RandomGenerator() % 2 == 0) { b.Set(i); refB[i] = true; }
+	}
+
+	Core::BitSet c = a; c.And(b);
+	for (size_t i = 0; i < size; i++) assert(c.Get(i) == (refA[i] && refB[i]));
+	c = a; c.Or(b);
+	for (size_t i = 0; i < size; i++) assert(c.Get(i) == (refA[i] || refB[i]));
+	c = a; c.Xor(b);
+	for (size_t i = 0; i < size; i++) assert(c.Get(i) == (refA[i] != refB[i]));
+	c = a; c.AndNot(b);
+	for (size_t i = 0; i < size; i++) assert(c.Get(i) == (refA[i] && !refB[i]));
+
+	size_t countSetBits = 0;
+	for (size_t i = 0; i < size; i++) if (refA[i]) countSetBits++;
+	assert(a.PopCount() == countSetBits);
+
+	// Rank and select.
+	Core::BitSetRankSelect rankSelect(a);
+	size_t rank = 0;
+	for (size_t i = 0; i <= size; i++)
+	{
+		assert(rankSelect.Rank(i) == rank);
+		if (i < size && refA[i])
+		{
+			assert(rankSelect.Select(rank) == i);
+			rank++;
+		}
+	}
+	assert(rankSelect.Select(rank) == Core::BitSet::c_InvalidBitIndex);
+
+	// Set bit iteration.
+	Core::IndexVectorU indices;
+	a.GetSetBitIndices(indices);
+	assert(indices.GetSize() == countSetBits);
+	size_t index = a.FindFirstSet();
+	for (unsigned i = 0; i < indices.GetSize(); i++)
+	{
+		assert(index == indices[i]);
+		index = a.FindNextSet(index + 1);
+	}
+	assert(index == Core::BitSet::c_InvalidBitIndex);
+
+	// Byte mask conversion.
+	std::vector<unsigned char> mask(size);
+	a.ToByteMask(mask.data());
+	Core::BitSet d;
+	d.SetFromByteMask(mask.data(), size);
+	assert(d == a);
+}
+
+void TestUnpack(unsigned countBits)
+{
+	const size_t countValues = 300;
+	auto bitVector = Core::BitVector::CreateFromCountBitsPerElement(static_cast<unsigned char>(countBits));
+	std::vector<unsigned> values;
+	unsigned mask = (countBits == 32 ? 0xffffffff : ((1U << countBits) - 1));
+	for (size_t i = 0; i < countValues; i++)
+	{
+		values.push_back(static_cast<unsigned>(s_RandomGenerator()) & mask);
+		bitVector.Add(values.back());
+	}
+	for (size_t start : { 0, 1, 5, 17 })
+	{
+		std::vector<unsigned> output(countValues - start);
+		bitVector.GetRange(start, output.size(), output.data());
+		for (size_t i = 0; i < output.size(); i++) assert(output[i] == values[start + i]);
+	}
+}
+
+int main()
+{
+	for (size_t size : { 0, 1, 63, 64, 65, 500, 1000, 4097 })
+	{
+		TestBitSet(size);
+	}
+	for (unsigned countBits = 1; countBits <= 32; countBits++)
+	{
+		TestUnpack(countBits);
+	}
+
+	return 0;
+}
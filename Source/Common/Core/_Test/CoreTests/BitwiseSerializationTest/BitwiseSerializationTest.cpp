@@ -0,0 +1,245 @@
+// BitwiseSerializationTest.cpp : Defines the entry point for the console application.
+//
+
+#include "stdafx.h"
+
+#include <Core/SimpleBinarySerialization.hpp>
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Counts the calls of the element-wise serialization functions.
+unsigned s_CountElementSerializations = 0;
+unsigned s_CountElementDeserializations = 0;
+
+// Layouts of the built model's array elements without padding, thus the bitwise and the field-wise
+// serialization produce the same bytes. The field-wise variant is the serialization before the trait.
+template <bool IsBitwise>
+struct KeyFrameT
+{
+	float Location[12];
+	float Scaler[3];
+	float Weight;
+	double Time;
+
+	void SerializeSB(Core::ByteVector& bytes) const
+	{
+		s_CountElementSerializations++;
+		Core::SerializeSB(bytes, Core::ToPlaceHolder(Location));
+		Core::SerializeSB(bytes, Core::ToPlaceHolder(Scaler));
+		Core::SerializeSB(bytes, Weight);
+		Core::SerializeSB(bytes, Time);
+	}
+
+	void DeserializeSB(const unsigned char*& bytes)
+	{
+		s_CountElementDeserializations++;
+		Core::DeserializeSB(bytes, Core::ToPlaceHolder(Location));
+		Core::DeserializeSB(bytes, Core::ToPlaceHolder(Scaler));
+		Core::DeserializeSB(bytes, Weight);
+		Core::DeserializeSB(bytes, Time);
+	}
+};
+
+template <bool IsBitwise>
+struct BoneInfluenceT
+{
+	unsigned BoneIndex;
+	float Weight;
+
+	void SerializeSB(Core::ByteVector& bytes) const
+	{
+		s_CountElementSerializations++;
+		Core::SerializeSB(bytes, BoneIndex);
+		Core::SerializeSB(bytes, Weight);
+	}
+
+	void DeserializeSB(const unsigned char*& bytes)
+	{
+		s_CountElementDeserializations++;
+		Core::DeserializeSB(bytes, BoneIndex);
+		Core::DeserializeSB(bytes, Weight);
+	}
+};
+
+CORE_BITWISE_SERIALIZABLE_SB(KeyFrameT<true>)
+CORE_BITWISE_SERIALIZABLE_SB(BoneInfluenceT<true>)
+
+enum class TestEnum : unsigned char { A, B };
+
+static_assert(Core::IsBitwiseSerializableSB<int>::value, "Arithmetic types must be bitwise serializable.");
+static_assert(Core::IsBitwiseSerializableSB<double>::value, "Arithmetic types must be bitwise serializable.");
+static_assert(Core::IsBitwiseSerializableSB<TestEnum>::value, "Enums must be bitwise serializable.");
+static_assert(Core::IsBitwiseSerializableSB<Core::PlaceHolderStruct<12>>::value, "Place holders must be bitwise serializable.");
+static_assert(Core::IsBitwiseSerializableSB<KeyFrameT<true>>::value, "Opted-in classes must be bitwise serializable.");
+static_assert(!Core::IsBitwiseSerializableSB<KeyFrameT<false>>::value, "Classes must not be bitwise serializable by default.");
+static_assert(!Core::IsBitwiseSerializableSB<std::string>::value, "Strings must not be bitwise serializable.");
+static_assert(!Core::IsBitwiseSerializableSB<std::vector<int>>::value, "Vectors must not be bitwise serializable.");
+
+// Built model-like data: animation channels with key frames and per-vertex bone influences in std::vectors.
+template <bool IsBitwise>
+struct ModelT
+{
+	std::vector<std::string> ChannelNames;
+	std::vector<std::vector<KeyFrameT<IsBitwise>>> Channels;
+	std::vector<BoneInfluenceT<IsBitwise>> Influences;
+
+	void SerializeSB(Core::ByteVector& bytes) const
+	{
+		Core::SerializeSB(bytes, ChannelNames);
+		Core::SerializeSB(bytes, Channels);
+		Core::SerializeSB(bytes, Influences);
+	}
+
+	void DeserializeSB(const unsigned char*& bytes)
+	{
+		Core::DeserializeSB(bytes, ChannelNames);
+		Core::DeserializeSB(bytes, Channels);
+		Core::DeserializeSB(bytes, Influences);
+	}
+};
+
+template <bool IsBitwise>
+void CreateModel(ModelT<IsBitwise>& model, unsigned countChannels, unsigned countKeyFrames, unsigned countInfluences)
+{
+	model.ChannelNames.resize(countChannels);
+	model.Channels.resize(countChannels);
+	for (unsigned i = 0; i < countChannels; i++)
+	{
+		model.ChannelNames[i] = "Bone_" + std::to_string(i);
+		auto& keyFrames = model.Channels[i];
+		keyFrames.resize(countKeyFrames);
+		for (unsigned j = 0; j < countKeyFrames; j++)
+		{
+			auto& keyFrame = keyFrames[j];
+			for (unsigned k = 0; k < 12; k++) keyFrame.Location[k] = static_cast<float>(i + j + k);
+			for (unsigned k = 0; k < 3; k++) keyFrame.Scaler[k] = 1.0f + k;
+			keyFrame.Weight = 0.5f;
+			keyFrame.Time = j * 0.04;
+		}
+	}
+	model.Influences.resize(countInfluences);
+	for (unsigned i = 0; i < countInfluences; i++)
+	{
+		model.Influences[i].BoneIndex = i % countChannels;
+		model.Influences[i].Weight = 0.25f;
+	}
+}
+
+template <typename T1, typename T2>
+bool IsEqual(const T1& a, const T2& b)
+{
+	static_assert(sizeof(T1) == sizeof(T2), "Only the variants of the same type can be compared.");
+	return (memcmp(&a, &b, sizeof(T1)) == 0);
+}
+
+template <bool IsBitwise1, bool IsBitwise2>
+bool IsEqual(const ModelT<IsBitwise1>& a, const ModelT<IsBitwise2>& b)
+{
+	if (a.ChannelNames != b.ChannelNames || a.Channels.size() != b.Channels.size()
+		|| a.Influences.size() != b.Influences.size()) return false;
+	for (size_t i = 0; i < a.Channels.size(); i++)
+	{
+		if (a.Channels[i].size() != b.Channels[i].size()) return false;
+		for (size_t j = 0; j < a.Channels[i].size(); j++)
+		{
+			if (!IsEqual(a.Channels[i][j], b.Channels[i][j])) return false;
+		}
+	}
+	for (size_t i = 0; i < a.Influences.size(); i++)
+	{
+		if (!IsEqual(a.Influences[i], b.Influences[i])) return false;
+	}
+	return true;
+}
+
+// Bitwise serializable element types take the single copy path, the others are serialized element by element.
+void TestSerializationPath()
+{
+	const unsigned countElements = 100;
+
+	ModelT<true> bitwiseModel;
+	ModelT<false> fieldwiseModel;
+	CreateModel(bitwiseModel, 4, countElements, countElements);
+	CreateModel(fieldwiseModel, 4, countElements, countElements);
+	unsigned countModelElements = 5 * countElements;
+
+	Core::ByteVector bitwiseBytes, fieldwiseBytes;
+
+	s_CountElementSerializations = 0;
+	Core::SerializeSB(bitwiseBytes, bitwiseModel);
+	assert(s_CountElementSerializations == 0);
+
+	Core::SerializeSB(fieldwiseBytes, fieldwiseModel);
+	assert(s_CountElementSerializations == countModelElements);
+
+	// The serialized format doesn't depend on the path.
+	assert(bitwiseBytes.GetSize() == fieldwiseBytes.GetSize());
+	assert(memcmp(bitwiseBytes.GetArray(), fieldwiseBytes.GetArray(), bitwiseBytes.GetSize()) == 0);
+
+	ModelT<true> bitwiseModel2;
+	ModelT<false> fieldwiseModel2;
+
+	s_CountElementDeserializations = 0;
+	Core::StartDeserializeSB(fieldwiseBytes, bitwiseModel2);
+	assert(s_CountElementDeserializations == 0);
+	assert(IsEqual(bitwiseModel2, bitwiseModel));
+
+	Core::StartDeserializeSB(bitwiseBytes, fieldwiseModel2);
+	assert(s_CountElementDeserializations == countModelElements);
+	assert(IsEqual(fieldwiseModel2, fieldwiseModel));
+}
+
+std::chrono::high_resolution_clock::time_point s_StartTime;
+
+void Start()
+{
+	s_StartTime = std::chrono::high_resolution_clock::now();
+}
+
+long long Stop()
+{
+	auto endTime = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration_cast<std::chrono::microseconds>(endTime - s_StartTime).count();
+}
+
+template <bool IsBitwise>
+void MeasureSerialization(const char* name, unsigned countRepetitions)
+{
+	ModelT<IsBitwise> model, model2;
+	CreateModel(model, 200, 2000, 1000000);
+
+	long long serializationTime = 0, deserializationTime = 0;
+	size_t countBytes = 0;
+	for (unsigned i = 0; i < countRepetitions; i++)
+	{
+		Core::ByteVector bytes;
+		Start();
+		Core::SerializeSB(bytes, model);
+		serializationTime += Stop();
+
+		Start();
+		Core::StartDeserializeSB(bytes, model2);
+		deserializationTime += Stop();
+
+		countBytes = bytes.GetSize();
+	}
+	assert(IsEqual(model, model2));
+
+	printf("%s (%d MB): serialization: %lld us, deserialization: %lld us\n", name,
+		static_cast<int>(countBytes >> 20), serializationTime / countRepetitions, deserializationTime / countRepetitions);
+}
+
+int main()
+{
+	TestSerializationPath();
+
+	const unsigned countRepetitions = 5;
+	MeasureSerialization<false>("Element-wise", countRepetitions);
+	MeasureSerialization<true>("Bitwise", countRepetitions);
+
+	return 0;
+}
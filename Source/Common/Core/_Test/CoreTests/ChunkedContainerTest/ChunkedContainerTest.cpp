@@ -0,0 +1,116 @@
+// ChunkedContainerTest.cpp : Defines the entry point for the console application.
+//
+
+#include "stdafx.h"
+
+#include <Core/ChunkedContainer.h>
+#include <Core/Constants.h>
+
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+bool IsOpeningFailing(const Core::ByteVector& bytes)
+{
+	try
+	{
+		Core::ChunkedContainerReader reader(bytes.GetArray(), bytes.GetSize());
+	}
+	catch (std::runtime_error&)
+	{
+		return true;
+	}
+	return false;
+}
+
+int main()
+{
+	const std::uint32_t c_NameChunkId = Core::MakeFourCC('N', 'A', 'M', 'E');
+	const std::uint32_t c_ValueChunkId = Core::MakeFourCC('V', 'A', 'L', 'S');
+	const std::uint32_t c_ContentVersion = 7;
+
+	std::vector<std::string> names = { "alpha", "beta" };
+	Core::SimpleTypeVectorU<float> values;
+	for (unsigned i = 0; i < 1000; i++) values.PushBack(static_cast<float>(i));
+
+	Core::ByteVector bytes;
+	{
+		Core::MemoryOutputSinkSB sink(bytes);
+		Core::ChunkedContainerWriter writer(sink, c_ContentVersion);
+		{
+			Core::StreamSerializerSB serializer(writer.BeginChunk(c_NameChunkId));
+			serializer.Serialize(names);
+			writer.EndChunk();
+		}
+		{
+			Core::StreamSerializerSB serializer(writer.BeginChunk(c_ValueChunkId, 4096));
+			serializer.SerializeAligned(values);
+			writer.EndChunk();
+		}
+		writer.Finish();
+	}
+
+	assert(Core::ChunkedContainerReader::IsValid(bytes.GetArray(), bytes.GetSize(), c_ContentVersion));
+	assert(!Core::ChunkedContainerReader::IsValid(bytes.GetArray(), bytes.GetSize(), c_ContentVersion + 1));
+	assert(!Core::ChunkedContainerReader::IsValid(bytes.GetArray(), bytes.GetSize() - 1, c_ContentVersion));
+
+	// Reading the chunks in reverse order.
+	{
+		Core::ChunkedContainerReader reader(bytes.GetArray(), bytes.GetSize());
+		assert(reader.GetContentVersion() == c_ContentVersion);
+		assert(reader.GetCountChunks() == 2);
+		assert(reader.FindChunk(Core::MakeFourCC('N', 'O', 'N', 'E')) == Core::c_InvalidIndexU);
+
+		unsigned valueChunkIndex = reader.FindChunk(c_ValueChunkId);
+		assert(reader.GetChunkInfo(valueChunkIndex).Offset % 4096 == 0);
+		auto valueData = reader.GetVerifiedChunkData(valueChunkIndex);
+		Core::MemoryInputSourceSB valueSource(valueData.GetArray(), valueData.GetSize());
+		Core::StreamDeserializerSB valueDeserializer(valueSource);
+		Core::SimpleTypeVectorU<float> values2;
+		valueDeserializer.DeserializeAligned(values2);
+		assert(values2 == values);
+
+		auto nameData = reader.GetVerifiedChunkData(reader.FindChunk(c_NameChunkId));
+		Core::MemoryInputSourceSB nameSource(nameData.GetArray(), nameData.GetSize());
+		Core::StreamDeserializerSB nameDeserializer(nameSource);
+		std::vector<std::string> names2;
+		nameDeserializer.Deserialize(names2);
+		assert(names2 == names);
+	}
+
+	// Corrupting a chunk: only the chunk's checksum fails.
+	{
+		auto corruptBytes = bytes;
+		Core::ChunkedContainerReader reader(corruptBytes.GetArray(), corruptBytes.GetSize());
+		unsigned valueChunkIndex = reader.FindChunk(c_ValueChunkId);
+		corruptBytes[static_cast<unsigned>(reader.GetChunkInfo(valueChunkIndex).Offset) + 100] ^= 1;
+		assert(!reader.IsChunkIntact(valueChunkIndex));
+		assert(reader.IsChunkIntact(reader.FindChunk(c_NameChunkId)));
+		bool isThrowing = false;
+		try { reader.GetVerifiedChunkData(valueChunkIndex); }
+		catch (std::runtime_error&) { isThrowing = true; }
+		assert(isThrowing);
+	}
+
+	// Corrupting the header, the table of contents and the footer.
+	{
+		auto corruptBytes = bytes;
+		corruptBytes[0] ^= 1;
+		assert(IsOpeningFailing(corruptBytes));
+
+		corruptBytes = bytes;
+		corruptBytes[corruptBytes.GetSize() - 32 - 8] ^= 1;
+		assert(IsOpeningFailing(corruptBytes));
+
+		corruptBytes = bytes;
+		corruptBytes[corruptBytes.GetSize() - 20] ^= 1;
+		assert(IsOpeningFailing(corruptBytes));
+
+		corruptBytes = bytes;
+		corruptBytes.PopBack();
+		assert(IsOpeningFailing(corruptBytes));
+	}
+
+	return 0;
+}
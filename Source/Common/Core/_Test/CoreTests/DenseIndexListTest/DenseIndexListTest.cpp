@@ -0,0 +1,199 @@
+// DenseIndexListTest.cpp : Defines the entry point for the console application.
+//
+
+#include "stdafx.h"
+
+#include <Core/DataStructures/DenseIndexList.hpp>
+#include <Core/DataStructures/SimpleTypeUnorderedVector.hpp>
+#include <Core/DataStructures/ResourceUnorderedVector.hpp>
+
+#include <cassert>
+#include <random>
+#include <set>
+#include <vector>
+
+std::mt19937 s_RandomGenerator;
+
+template <typename SizeType>
+void CheckDenseIndexList(const Core::DenseIndexList<SizeType>& list, const std::set<SizeType>& reference)
+{
+	assert(list.GetSize() == reference.size());
+	assert(list.GetEndPointer() - list.GetArray() == static_cast<ptrdiff_t>(reference.size()));
+	std::set<SizeType> visited(list.GetArray(), list.GetEndPointer());
+	assert(visited == reference);
+}
+
+template <typename VectorType, typename T>
+void CheckDenseIteration(VectorType& v, const std::set<size_t>& reference, const std::vector<T>& values)
+{
+	assert(v.GetSize() == reference.size());
+
+	std::set<size_t> visited;
+	for (auto it = v.GetDenseBeginIterator(), end = v.GetDenseEndIterator(); it != end; ++it)
+	{
+		assert(*it == values[it.GetIndex()]);
+		assert(visited.insert(it.GetIndex()).second);
+	}
+	assert(visited == reference);
+
+	visited.clear();
+	const VectorType& cv = v;
+	for (auto it = cv.GetDenseBeginConstIterator(), end = cv.GetDenseEndConstIterator(); it != end; ++it)
+	{
+		assert(visited.insert(it.GetIndex()).second);
+	}
+	assert(visited == reference);
+
+	auto pIndices = v.GetDenseIndices();
+	assert(std::set<size_t>(pIndices, pIndices + v.GetSize()) == reference);
+}
+
+void TestDenseIndexList()
+{
+	Core::DenseIndexList<unsigned> list;
+	std::set<unsigned> reference;
+
+	// Empty list.
+	CheckDenseIndexList(list, reference);
+	assert(list.GetArray() == list.GetEndPointer());
+
+	// Add.
+	for (unsigned i = 0; i < 8; i++)
+	{
+		list.Add(i);
+		reference.insert(i);
+	}
+	CheckDenseIndexList(list, reference);
+
+	// Removing from the middle moves the last index into the removed position.
+	list.Remove(2);
+	reference.erase(2);
+	CheckDenseIndexList(list, reference);
+	assert(list.GetArray()[2] == 7);
+
+	// Removing the last index doesn't move anything.
+	list.Remove(6);
+	reference.erase(6);
+	CheckDenseIndexList(list, reference);
+	assert(list.GetArray()[list.GetSize() - 1] == 5);
+
+	// The swapped index must be removable through its updated position.
+	list.Remove(7);
+	reference.erase(7);
+	CheckDenseIndexList(list, reference);
+
+	// Readding a removed slot.
+	list.Add(2);
+	reference.insert(2);
+	CheckDenseIndexList(list, reference);
+
+	// Removing every index.
+	while (!reference.empty())
+	{
+		auto it = reference.begin();
+		std::advance(it, s_RandomGenerator() % reference.size());
+		list.Remove(*it);
+		reference.erase(it);
+		CheckDenseIndexList(list, reference);
+	}
+	assert(list.GetArray() == list.GetEndPointer());
+
+	list.SetToRange(5);
+	CheckDenseIndexList(list, std::set<unsigned>{ 0, 1, 2, 3, 4 });
+
+	list.Rebuild(10, [](unsigned i) { return (i % 3 == 0); });
+	CheckDenseIndexList(list, std::set<unsigned>{ 0, 3, 6, 9 });
+	list.Remove(0);
+	CheckDenseIndexList(list, std::set<unsigned>{ 3, 6, 9 });
+
+	list.Clear();
+	CheckDenseIndexList(list, std::set<unsigned>());
+}
+
+template <typename VectorType>
+void TestUnorderedVector()
+{
+	VectorType v;
+	std::set<size_t> reference;
+	std::vector<int> values;
+
+	// Iterating an empty vector.
+	CheckDenseIteration(v, reference, values);
+	assert(v.GetDenseBeginIterator() == v.GetDenseEndIterator());
+
+	// Random adds and removes.
+	for (int i = 0; i < 2000; i++)
+	{
+		if (reference.empty() || s_RandomGenerator() % 3 != 0)
+		{
+			int value = static_cast<int>(s_RandomGenerator() % 1000);
+			auto index = v.Add(value);
+			if (index >= values.size()) values.resize(index + 1);
+			values[index] = value;
+			assert(reference.insert(index).second);
+		}
+		else
+		{
+			auto it = reference.begin();
+			std::advance(it, s_RandomGenerator() % reference.size());
+			v.Remove(*it);
+			reference.erase(it);
+		}
+	}
+	CheckDenseIteration(v, reference, values);
+
+	// Removing the current element while iterating: the last live index is swapped into the
+	// current position, thus the iterator remains valid and must not be advanced. The end iterator
+	// has to be queried again after the removal.
+	size_t countElements = v.GetSize(), countVisited = 0;
+	for (auto it = v.GetDenseBeginIterator(); it != v.GetDenseEndIterator(); countVisited++)
+	{
+		auto index = it.GetIndex();
+		if (*it % 2 == 0)
+		{
+			v.Remove(index);
+			reference.erase(index);
+		}
+		else
+		{
+			++it;
+		}
+	}
+	assert(countVisited == countElements);
+	CheckDenseIteration(v, reference, values);
+	for (auto it = v.GetDenseBeginIterator(), end = v.GetDenseEndIterator(); it != end; ++it)
+	{
+		assert(*it % 2 != 0);
+	}
+
+	// Removing everything leaves an empty iteration range.
+	while (!reference.empty())
+	{
+		v.Remove(*reference.begin());
+		reference.erase(reference.begin());
+	}
+	CheckDenseIteration(v, reference, values);
+	assert(v.GetDenseBeginIterator() == v.GetDenseEndIterator());
+
+	// Reusing the freed slots.
+	for (int i = 0; i < 10; i++)
+	{
+		auto index = v.Add(i);
+		values[index] = i;
+		reference.insert(index);
+	}
+	CheckDenseIteration(v, reference, values);
+
+	v.Clear();
+	reference.clear();
+	CheckDenseIteration(v, reference, values);
+}
+
+int main()
+{
+	TestDenseIndexList();
+	TestUnorderedVector<Core::SimpleTypeUnorderedVector<int>>();
+	TestUnorderedVector<Core::ResourceUnorderedVector<int>>();
+
+	return 0;
+}
@@ -0,0 +1,194 @@
+// FileScannerTest.cpp : Defines the entry point for the console application.
+//
+
+#include "stdafx.h"
+
+#include <Core/System/FileScanner.h>
+#include <Core/System/FileWatcher.h>
+#include <Core/System/Filesystem.h>
+#include <Core/System/SimpleIO.h>
+#include <Core/System/ThreadPool.h>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+const std::string c_RootPath = "FileScannerTest";
+const unsigned c_CountDirectories = 16;
+const unsigned c_CountFilesPerDirectory = 64;
+
+std::string GetDirectoryPath(unsigned index)
+{
+	return c_RootPath + "/Directory_" + std::to_string(index);
+}
+
+std::string GetFilePath(unsigned directoryIndex, unsigned fileIndex)
+{
+	return GetDirectoryPath(directoryIndex) + "/File_" + std::to_string(fileIndex) + ".txt";
+}
+
+void WriteFile(const std::string& path, const std::string& content)
+{
+	Core::WriteAllText(path.c_str(), content);
+}
+
+void CreateFiles(std::vector<std::string>& filePaths)
+{
+	for (unsigned i = 0; i < c_CountDirectories; i++)
+	{
+		Core::CreateDirectoryPath(GetDirectoryPath(i));
+		for (unsigned j = 0; j < c_CountFilesPerDirectory; j++)
+		{
+			filePaths.push_back(GetFilePath(i, j));
+			WriteFile(filePaths.back(), std::string(j, 'x'));
+		}
+	}
+}
+
+void RemoveFiles(const std::vector<std::string>& filePaths)
+{
+	for (auto& path : filePaths) Core::RemoveFile(path);
+	for (unsigned i = 0; i < c_CountDirectories; i++) Core::RemoveFile(GetDirectoryPath(i));
+	Core::RemoveFile(c_RootPath);
+}
+
+void TestScanning(const std::vector<std::string>& filePaths, Core::ThreadPool* pThreadPool)
+{
+	auto startTime = std::chrono::steady_clock::now();
+
+	std::vector<Core::DirectoryEntry> entries;
+	Core::ScanDirectory(c_RootPath, entries, true, pThreadPool);
+
+	auto scanTime = std::chrono::steady_clock::now();
+
+	std::vector<Core::FileStatus> statuses(filePaths.size());
+	Core::GetFileStatuses(filePaths.data(), filePaths.size(), statuses.data(), pThreadPool);
+
+	auto endTime = std::chrono::steady_clock::now();
+
+	assert(entries.size() == c_CountDirectories * (c_CountFilesPerDirectory + 1));
+	std::vector<std::string> scannedFilePaths;
+	for (auto& entry : entries)
+	{
+		assert(entry.Status.Exists);
+		if (!entry.Status.IsDirectory) scannedFilePaths.push_back(entry.Path);
+	}
+	auto sortedFilePaths = filePaths;
+	std::sort(scannedFilePaths.begin(), scannedFilePaths.end());
+	std::sort(sortedFilePaths.begin(), sortedFilePaths.end());
+	assert(scannedFilePaths == sortedFilePaths);
+
+	for (size_t i = 0; i < filePaths.size(); i++)
+	{
+		assert(statuses[i].Exists && !statuses[i].IsDirectory);
+		assert(statuses[i].Size == i % c_CountFilesPerDirectory);
+	}
+
+	std::vector<Core::DirectoryEntry> topLevelEntries;
+	Core::ScanDirectory(c_RootPath, topLevelEntries, false, pThreadPool);
+	assert(topLevelEntries.size() == c_CountDirectories);
+
+	auto nonExistingStatus = Core::GetFileStatus(c_RootPath + "/NonExisting.txt");
+	assert(!nonExistingStatus.Exists);
+
+	printf("%s: scanning: %f ms, querying %d statuses: %f ms\n",
+		(pThreadPool == nullptr ? "Serial" : "Parallel"),
+		std::chrono::duration<double, std::milli>(scanTime - startTime).count(), (int)filePaths.size(),
+		std::chrono::duration<double, std::milli>(endTime - scanTime).count());
+}
+
+class ChangeCollector
+{
+	std::mutex m_Mutex;
+	std::condition_variable m_Condition;
+	std::vector<Core::FileChange> m_Changes;
+
+public:
+
+	void Add(const Core::FileChange& change)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Changes.push_back(change);
+		m_Condition.notify_all();
+	}
+
+	bool WaitFor(const std::string& path, Core::FileChangeType type)
+	{
+		auto isReceived = [&]() {
+			return std::any_of(m_Changes.begin(), m_Changes.end(), [&](const Core::FileChange& change) {
+				return (change.Path == path && change.Type == type); });
+		};
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		return m_Condition.wait_for(lock, std::chrono::seconds(5), isReceived);
+	}
+};
+
+void TestWatching(std::vector<std::string>& filePaths)
+{
+	auto rootPath = Core::GetAbsolutePath(c_RootPath);
+	auto getAbsolutePath = [&rootPath](const std::string& path) {
+		return rootPath + path.substr(c_RootPath.length());
+	};
+
+	ChangeCollector collector;
+	Core::FileWatcher watcher;
+	watcher.Start(rootPath, [&collector](const Core::FileChange& change) { collector.Add(change); });
+	assert(watcher.IsWatching());
+
+	// Modifying a file in a subdirectory.
+	WriteFile(filePaths[1], "Modified");
+	assert(collector.WaitFor(getAbsolutePath(filePaths[1]), Core::FileChangeType::Modified));
+
+	// Creating and removing a file.
+	auto newFilePath = GetDirectoryPath(0) + "/NewFile.txt";
+	WriteFile(newFilePath, "New");
+	assert(collector.WaitFor(getAbsolutePath(newFilePath), Core::FileChangeType::Created));
+	Core::RemoveFile(newFilePath);
+	assert(collector.WaitFor(getAbsolutePath(newFilePath), Core::FileChangeType::Removed));
+
+	// Files in a new directory.
+	auto newDirectoryIndex = c_CountDirectories;
+	Core::CreateDirectoryPath(GetDirectoryPath(newDirectoryIndex));
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	auto newDirectoryFilePath = GetFilePath(newDirectoryIndex, 0);
+	WriteFile(newDirectoryFilePath, "New");
+	assert(collector.WaitFor(getAbsolutePath(newDirectoryFilePath), Core::FileChangeType::Created));
+
+	watcher.Stop();
+	assert(!watcher.IsWatching());
+
+	Core::RemoveFile(newDirectoryFilePath);
+	Core::RemoveFile(GetDirectoryPath(newDirectoryIndex));
+
+	bool isThrown = false;
+	try
+	{
+		watcher.Start(c_RootPath + "/NonExisting", [](const Core::FileChange&) {});
+	}
+	catch (const std::runtime_error&)
+	{
+		isThrown = true;
+	}
+	assert(isThrown && !watcher.IsWatching());
+}
+
+int main()
+{
+	std::vector<std::string> filePaths;
+	CreateFiles(filePaths);
+
+	Core::ThreadPool threadPool;
+	TestScanning(filePaths, nullptr);
+	TestScanning(filePaths, &threadPool);
+	TestWatching(filePaths);
+
+	RemoveFiles(filePaths);
+
+	return 0;
+}
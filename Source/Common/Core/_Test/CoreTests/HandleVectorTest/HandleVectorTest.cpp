@@ -0,0 +1,63 @@
+// HandleVectorTest.cpp : Defines the entry point for the console application.
+//
+
+#include "stdafx.h"
+
+#include <Core/DataStructures/HandleVector.hpp>
+
+#include <cassert>
+#include <string>
+
+int main()
+{
+	Core::HandleVector<std::string> v;
+
+	auto h0 = v.Add("zero");
+	auto h1 = v.Add("one");
+	auto h2 = v.Add("two");
+
+	assert(v.GetSize() == 3);
+	assert(v[h0] == "zero" && v[h1] == "one" && v[h2] == "two");
+
+	// Removing from the middle keeps the storage dense and the other handles stable.
+	v.Remove(h0);
+	assert(v.GetSize() == 2);
+	assert(!v.IsValid(h0));
+	assert(v.TryGet(h0) == nullptr);
+	assert(v[h1] == "one" && v[h2] == "two");
+	assert(v.GetArray()[v.GetDenseIndex(h2)] == "two");
+
+	// The freed slot is reused with a new generation: the stale handle stays invalid.
+	auto h3 = v.Add("three");
+	assert(h3.Index == h0.Index && h3.Generation != h0.Generation);
+	assert(!v.IsValid(h0) && v.IsValid(h3));
+	assert(!v.TryRemove(h0));
+
+	// Handles can be reconstructed from the dense storage.
+	for (unsigned i = 0; i < v.GetSize(); i++)
+	{
+		assert(v[v.GetHandle(i)] == v.GetArray()[i]);
+	}
+
+	// Default constructed handles are never valid.
+	assert(!v.IsValid(Core::Handle()));
+	assert(!v.IsValid(Core::Handle(0, 0)));
+
+	// Round-trip through the packed representation.
+	assert(Core::Handle::FromU64(h3.ToU64()) == h3);
+
+	// Clearing invalidates all handles.
+	v.Clear();
+	assert(v.IsEmpty());
+	assert(!v.IsValid(h1) && !v.IsValid(h2) && !v.IsValid(h3));
+
+	// Serialization round-trip.
+	auto h4 = v.Add("four");
+	Core::ByteVector bytes;
+	Core::SerializeSB(bytes, v);
+	Core::HandleVector<std::string> v2;
+	Core::StartDeserializeSB(bytes, v2);
+	assert(v2.IsValid(h4) && v2[h4] == "four" && !v2.IsValid(h1));
+
+	return 0;
+}
@@ -0,0 +1,185 @@
+// MemoryMappedFileTest.cpp : Defines the entry point for the console application.
+//
+
+#include "stdafx.h"
+
+#include <Core/System/MemoryMappedFile.h>
+#include <Core/System/SimpleIO.h>
+#include <Core/SimpleBinarySerialization.hpp>
+#include <Core/StreamBinarySerialization.h>
+
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+struct Vertex
+{
+	float Position[3];
+	std::uint32_t Color;
+};
+
+template <typename T>
+bool IsAligned(const T* p, size_t alignment)
+{
+	return (reinterpret_cast<std::uintptr_t>(p) % alignment == 0);
+}
+
+template <typename T>
+bool IsInRange(const T* p, size_t size, const unsigned char* begin, const unsigned char* end)
+{
+	auto bytes = reinterpret_cast<const unsigned char*>(p);
+	return (bytes >= begin && bytes + size * sizeof(T) <= end);
+}
+
+void TestRoundTrip()
+{
+	const char* path = "MemoryMappedFileTest.bin";
+
+	Core::SimpleTypeVectorU<unsigned char> bytes8;
+	Core::SimpleTypeVectorU<double> doubles;
+	Core::SimpleTypeVectorU<Vertex> vertices;
+	Core::SimpleTypeVectorU<std::uint32_t> empty;
+	for (unsigned i = 0; i < 13; i++) bytes8.PushBack(static_cast<unsigned char>(i * 7));
+	for (unsigned i = 0; i < 1000; i++) doubles.PushBack(i * 0.25);
+	for (unsigned i = 0; i < 777; i++) vertices.PushBack({ { i * 1.0f, i * 2.0f, i * 3.0f }, i * 0x01010101U });
+
+	// The unaligned leading value shifts the arrays within the buffer.
+	Core::ByteVector serialized;
+	Core::SerializeSB(serialized, 42u);
+	Core::SerializeAlignedSB(serialized, bytes8);
+	Core::SerializeAlignedSB(serialized, doubles);
+	Core::SerializeAlignedSB(serialized, empty);
+	Core::SerializeAlignedSB(serialized, vertices);
+	Core::WriteAllBytes(path, serialized);
+
+	{
+		Core::MemoryMappedFile file(path);
+		assert(file.IsOpened() && file.GetSize() == serialized.GetSize());
+		auto begin = file.GetData();
+		auto end = begin + file.GetSize();
+		assert(IsAligned(begin, Core::c_AlignmentSB));
+
+		// In-place views.
+		{
+			auto bytes = begin;
+			unsigned u;
+			Core::ArrayView<unsigned char> bytes8View;
+			Core::ArrayView<double> doublesView;
+			Core::ArrayView<std::uint32_t> emptyView;
+			Core::ArrayView<Vertex> verticesView;
+			Core::DeserializeSB(bytes, u);
+			Core::DeserializeViewSB(bytes, end, bytes8View);
+			Core::DeserializeViewSB(bytes, end, doublesView);
+			Core::DeserializeViewSB(bytes, end, emptyView);
+			Core::DeserializeViewSB(bytes, end, verticesView);
+			assert(u == 42 && bytes == end);
+
+			assert(bytes8View.GetSize() == bytes8.GetSize());
+			assert(memcmp(bytes8View.GetArray(), bytes8.GetArray(), bytes8.GetSizeInBytes()) == 0);
+			assert(doublesView.GetSize() == doubles.GetSize());
+			assert(memcmp(doublesView.GetArray(), doubles.GetArray(), doubles.GetSizeInBytes()) == 0);
+			assert(emptyView.IsEmpty());
+			assert(verticesView.GetSize() == vertices.GetSize());
+			assert(memcmp(verticesView.GetArray(), vertices.GetArray(), vertices.GetSizeInBytes()) == 0);
+
+			// The views point into the mapping with absolute alignment.
+			assert(IsInRange(doublesView.GetArray(), doublesView.GetSize(), begin, end));
+			assert(IsInRange(verticesView.GetArray(), verticesView.GetSize(), begin, end));
+			assert(IsAligned(bytes8View.GetArray(), Core::c_AlignmentSB));
+			assert(IsAligned(doublesView.GetArray(), Core::c_AlignmentSB));
+			assert(IsAligned(verticesView.GetArray(), Core::c_AlignmentSB));
+		}
+
+		// Copying deserialization.
+		{
+			auto bytes = begin;
+			unsigned u;
+			Core::SimpleTypeVectorU<unsigned char> bytes8Copy;
+			Core::SimpleTypeVectorU<double> doublesCopy;
+			Core::SimpleTypeVectorU<std::uint32_t> emptyCopy;
+			Core::SimpleTypeVectorU<Vertex> verticesCopy;
+			Core::DeserializeSB(bytes, u);
+			Core::DeserializeAlignedSB(bytes, bytes8Copy);
+			Core::DeserializeAlignedSB(bytes, doublesCopy);
+			Core::DeserializeAlignedSB(bytes, emptyCopy);
+			Core::DeserializeAlignedSB(bytes, verticesCopy);
+			assert(bytes == end);
+			assert(bytes8Copy.GetSize() == bytes8.GetSize() && emptyCopy.GetSize() == 0);
+			assert(memcmp(doublesCopy.GetArray(), doubles.GetArray(), doubles.GetSizeInBytes()) == 0);
+			assert(memcmp(verticesCopy.GetArray(), vertices.GetArray(), vertices.GetSizeInBytes()) == 0);
+		}
+
+		// Viewing a truncated buffer throws.
+		{
+			auto bytes = begin + sizeof(unsigned);
+			Core::ArrayView<unsigned char> bytes8View;
+			Core::DeserializeViewSB(bytes, end, bytes8View);
+			Core::ArrayView<double> doublesView;
+			bool isThrown = false;
+			try { Core::DeserializeViewSB(bytes, bytes + 100, doublesView); }
+			catch (const std::runtime_error&) { isThrown = true; }
+			assert(isThrown && doublesView.IsEmpty());
+		}
+	}
+
+	// Moving the mapping.
+	{
+		Core::MemoryMappedFile file1(path);
+		auto data = file1.GetData();
+		Core::MemoryMappedFile file2(std::move(file1));
+		assert(!file1.IsOpened() && file2.IsOpened() && file2.GetData() == data);
+		file1 = std::move(file2);
+		assert(file1.IsOpened() && !file2.IsOpened() && file1.GetData() == data);
+		file1.Close();
+		assert(!file1.IsOpened());
+	}
+
+	remove(path);
+}
+
+void TestEmptyFile()
+{
+	const char* path = "MemoryMappedFileTest_Empty.bin";
+	Core::WriteAllBytes(path, nullptr, 0);
+
+	{
+		// An empty file has a valid, empty data range.
+		Core::MemoryMappedFile file(path);
+		assert(file.IsOpened() && file.GetSize() == 0);
+		assert(file.GetData() != nullptr);
+
+		// Viewing the empty range is rejected instead of reading past it.
+		auto bytes = file.GetData();
+		Core::ArrayView<float> view;
+		bool isThrown = false;
+		try { Core::DeserializeViewSB(bytes, file.GetData() + file.GetSize(), view); }
+		catch (const std::runtime_error&) { isThrown = true; }
+		assert(isThrown && bytes == file.GetData() && view.IsEmpty());
+
+		// The same through the stream deserializer.
+		Core::MemoryInputSourceSB source(file.GetData(), file.GetSize());
+		Core::StreamDeserializerSB deserializer(source);
+		isThrown = false;
+		try { deserializer.DeserializeView(view); }
+		catch (const std::runtime_error&) { isThrown = true; }
+		assert(isThrown);
+	}
+
+	remove(path);
+
+	// A missing file cannot be opened.
+	bool isThrown = false;
+	try { Core::MemoryMappedFile file(path); }
+	catch (const std::runtime_error&) { isThrown = true; }
+	assert(isThrown);
+}
+
+int main()
+{
+	TestRoundTrip();
+	TestEmptyFile();
+
+	return 0;
+}
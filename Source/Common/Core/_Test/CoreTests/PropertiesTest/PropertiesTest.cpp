@@ -0,0 +1,73 @@
+// PropertiesTest.cpp : Defines the entry point for the console application.
+//
+
+#include "stdafx.h"
+
+#include <Core/DataStructures/Properties.h>
+
+#include <cassert>
+#include <cstring>
+#include <string>
+
+int main()
+{
+	Core::Properties properties;
+	properties.LoadFromXmlString(
+		"<Configuration>"
+		"<Property name=\"Width\" value=\"1280\"/>"
+		"<Window><Property name=\"Title\" value=\"Test\"/></Window>"
+		"<Windows><Property name=\"Title\" value=\"Other\"/></Windows>"
+		"</Configuration>");
+
+	// String paths.
+	assert(properties.GetPropertyValue<int>("Configuration.Width") == 1280);
+	assert(strcmp(properties.GetPropertyValueStr("Configuration.Window.Title"), "Test") == 0);
+	assert(strcmp(properties.GetPropertyValueStr("Configuration.Windows.Title"), "Other") == 0);
+	assert(!properties.HasProperty("Configuration.Win.Title"));
+	assert(!properties.HasProperty("Configuration.Height"));
+	assert(!properties.HasProperty("Unknown.Width"));
+
+	int width = 0;
+	properties.TryGetRootConfigurationValue("Width", width);
+	assert(width == 1280);
+
+	// Compiled paths, also before the property exists.
+	auto heightPath = properties.CompilePath("Configuration.Height");
+	assert(!properties.HasProperty(heightPath));
+	properties.SetProperty("Configuration.Height", "720");
+	assert(properties.GetPropertyValue<int>(heightPath) == 720);
+	properties.SetProperty(heightPath, "1080");
+	assert(properties.GetPropertyValue<int>("Configuration.Height") == 1080);
+
+	bool isThrowing = false;
+	try { properties.GetPropertyValue<int>(properties.CompilePath("Configuration.Depth")); }
+	catch (const std::runtime_error&) { isThrowing = true; }
+	assert(isThrowing);
+
+	// Cached values are only parsed again after setting the property.
+	auto cachedWidth = properties.CompileCachedProperty<int>("Configuration.Width");
+	assert(properties.GetPropertyValue(cachedWidth) == 1280);
+	const int* pWidth = properties.GetCachedPropertyValue(cachedWidth);
+	properties.AddProperty("Configuration.Window.Height", "600");
+	assert(properties.GetCachedPropertyValue(cachedWidth) == pWidth && *pWidth == 1280);
+	properties.SetProperty("Configuration.Width", "1920");
+	assert(properties.GetPropertyValue(cachedWidth) == 1920);
+
+	auto cachedTitle = properties.CompileCachedProperty<std::string>("Configuration.Window.Title");
+	std::string title;
+	assert(properties.TryGetPropertyValue(cachedTitle, title) && title == "Test");
+
+	// Duplicate paths: the first property is found.
+	properties.AddProperty("Configuration.Width", "640");
+	const char* values[4];
+	assert(properties.GetPropertyValuesStr("Configuration.Width", values, 4) == 2);
+	assert(strcmp(values[0], "1920") == 0 && strcmp(values[1], "640") == 0);
+
+	// Round trip.
+	Core::Properties loaded;
+	loaded.LoadFromXmlString(properties.ToXmlString().c_str());
+	assert(loaded.GetPropertyValue<int>("Configuration.Window.Height") == 600);
+	assert(loaded.GetPropertyValue<int>("Configuration.Height") == 1080);
+
+	return 0;
+}
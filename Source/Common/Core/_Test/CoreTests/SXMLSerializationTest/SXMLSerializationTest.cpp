@@ -0,0 +1,142 @@
+// SXMLSerializationTest.cpp : Defines the entry point for the console application.
+//
+
+#include "stdafx.h"
+
+#include <Core/SimpleXMLSerialization.hpp>
+
+#include <cassert>
+#include <map>
+#include <string>
+#include <vector>
+
+enum class Kind : unsigned char { First, Second };
+
+struct Item
+{
+	int I;
+	std::string Name;
+
+	bool operator==(const Item& other) const { return I == other.I && Name == other.Name; }
+
+	void SerializeSXML(Core::SerializationSXMLData& data) const
+	{
+		Core_SerializeSXML(data, I);
+		Core_SerializeSXML(data, Name);
+	}
+
+	void DeserializeSXML(Core::DeserializationSXMLData& data)
+	{
+		Core_DeserializeSXML(data, I);
+		Core_DeserializeSXML(data, Name);
+	}
+};
+
+struct Document
+{
+	Kind Type = Kind::First;
+	float Scale = 0.0f;
+	std::vector<float> Values;
+	Core::SimpleTypeVectorU<unsigned> Indices;
+	std::vector<Item> Items;
+	std::map<int, std::string> Names;
+	std::vector<unsigned char> Blob;
+
+	void SerializeSXML(Core::SerializationSXMLData& data) const
+	{
+		Core_SerializeSXML(data, Type);
+		Core_SerializeSXML(data, Scale);
+		Core_SerializeSXML(data, Values);
+		Core_SerializeSXML(data, Indices);
+		Core_SerializeSXML(data, Items);
+		Core_SerializeSXML(data, Names);
+		Core::SerializeSXML(data, Core::AsBinaryData(Blob.data(), Blob.size()), "Blob");
+	}
+
+	void DeserializeSXML(Core::DeserializationSXMLData& data)
+	{
+		Core_DeserializeSXML(data, Type);
+		Core_DeserializeSXML(data, Scale);
+		Core_DeserializeSXML(data, Values);
+		Core_DeserializeSXML(data, Indices);
+		Core_DeserializeSXML(data, Items);
+		Core_DeserializeSXML(data, Names);
+		unsigned char* blob;
+		size_t blobSize;
+		auto blobWrapper = Core::AsBinaryData(&blob, &blobSize);
+		Core::DeserializeSXML(data, blobWrapper, "Blob");
+		Blob.assign(blob, blob + blobSize);
+		delete[] blob;
+	}
+
+	bool operator==(const Document& other) const
+	{
+		return Type == other.Type && Scale == other.Scale && Values == other.Values && Indices == other.Indices
+			&& Items == other.Items && Names == other.Names && Blob == other.Blob;
+	}
+};
+
+int main()
+{
+	Document document;
+	document.Type = Kind::Second;
+	document.Scale = 0.5f;
+	document.Values = { 1.0f, 2.5f, -3.0f };
+	document.Indices.PushBack(7);
+	document.Indices.PushBack(8);
+	document.Items.push_back({ 1, "one" });
+	document.Items.push_back({ 2, "two" });
+	document.Names[3] = "three";
+	document.Blob = { 0, 1, 2, 255 };
+
+	// Binary round-trip.
+	Core::ByteVector bytes;
+	Core::StartSerializeBinarySXML(bytes, document, "Document");
+	assert(Core::IsBinarySXML(bytes.GetArray(), bytes.GetSize()));
+	{
+		Document document2;
+		Core::StartDeserializeBinarySXML(bytes.GetArray(), bytes.GetSize(), document2, "Document");
+		assert(document2 == document);
+	}
+
+	// Converting the binary document to XML gives the same text as serializing to XML directly.
+	std::string text;
+	Core::StartSerializeSXML(text, document, "Document");
+	{
+		std::string convertedText;
+		Core::ConvertBinaryToXMLSXML(bytes.GetArray(), bytes.GetSize(), convertedText);
+		assert(convertedText == text);
+
+		Document document2;
+		Core::StartDeserializeSXML(text, document2, "Document");
+		assert(document2 == document);
+	}
+
+	// A converted XML document stores text values, which are parsed when deserializing.
+	{
+		Core::ByteVector convertedBytes;
+		Core::ConvertXMLToBinarySXML(text, convertedBytes);
+		Document document2;
+		Core::StartDeserializeAnySXML(convertedBytes.GetArray(), convertedBytes.GetSize(), document2, "Document");
+		assert(document2 == document);
+	}
+
+	// Corrupt documents are rejected.
+	{
+		bytes[bytes.GetSize() / 2] = 0xff;
+		bytes.PopBack();
+		bool isThrowing = false;
+		try
+		{
+			Document document2;
+			Core::StartDeserializeBinarySXML(bytes.GetArray(), bytes.GetSize(), document2, "Document");
+		}
+		catch (std::runtime_error&)
+		{
+			isThrowing = true;
+		}
+		assert(isThrowing);
+	}
+
+	return 0;
+}
@@ -0,0 +1,202 @@
+// SharedMemoryRingBufferTest.cpp : Defines the entry point for the console application.
+//
+// Tests the shared memory ring buffer and measures the message rate and the latency between processes
+// (between threads on Windows).
+
+#include "stdafx.h"
+
+#include <Core/Platform.h>
+#include <Core/System/SharedMemoryRingBuffer.h>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#ifndef IS_WINDOWS
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+const char* c_Name = "CoreSharedMemoryRingBufferTest";
+const unsigned c_CountBenchmarkMessages = 1000000;
+const unsigned c_BenchmarkMessageSize = 64;
+
+// The latency is measured with paced producers, otherwise it would be dominated by the queueing in the full ring.
+const unsigned c_CountLatencyMessages = 100000;
+const std::uint64_t c_LatencyMessagePeriodInNanoseconds = 5000;
+
+struct BenchmarkMessage
+{
+	std::uint64_t SendTime;
+	std::uint32_t ProducerIndex;
+	std::uint32_t Index;
+};
+
+std::uint64_t GetTimeInNanoseconds()
+{
+	return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Runs the producers in child processes on POSIX systems.
+void RunProducers(unsigned countProducers, const std::function<void(unsigned)>& producer,
+	const std::function<void()>& consumer)
+{
+#ifdef IS_WINDOWS
+	std::vector<std::thread> threads;
+	for (unsigned i = 0; i < countProducers; i++) threads.emplace_back(producer, i);
+	consumer();
+	for (auto& thread : threads) thread.join();
+#else
+	std::vector<pid_t> children;
+	for (unsigned i = 0; i < countProducers; i++)
+	{
+		pid_t pid = fork();
+		if (pid == 0)
+		{
+			producer(i);
+			_exit(0);
+		}
+		children.push_back(pid);
+	}
+	consumer();
+	for (auto pid : children)
+	{
+		int status;
+		waitpid(pid, &status, 0);
+		assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+	}
+#endif
+}
+
+void TestSingleProcess()
+{
+	std::vector<unsigned char> message;
+
+	// Variable sized messages, wrapping around the ring multiple times.
+	{
+		Core::SharedMemoryRingBuffer ringBuffer;
+		ringBuffer.Initialize(Core::SharedMemoryHandlingRole::Create, c_Name, 100);
+		assert(ringBuffer.GetCapacity() == 256 && ringBuffer.GetMaxMessageSize() == 112);
+
+		for (unsigned i = 0; i < 1000; i++)
+		{
+			size_t size = (i * 7) % 100;
+			std::vector<unsigned char> sent(size, static_cast<unsigned char>(i));
+			assert(ringBuffer.TryWrite(sent.data(), size));
+			assert(ringBuffer.TryRead(message) && message == sent);
+			assert(!ringBuffer.TryRead(message));
+		}
+	}
+
+	Core::SharedMemoryRingBuffer ringBuffer;
+	ringBuffer.Initialize(Core::SharedMemoryHandlingRole::Create, c_Name, 256);
+
+	// Full ring: 4 records of 16 + 48 bytes.
+	unsigned countWritten = 0;
+	unsigned char data[48] = {};
+	while (ringBuffer.TryWrite(data, sizeof(data))) ++countWritten;
+	assert(countWritten == 4);
+	assert(!ringBuffer.Write(data, sizeof(data), 10));
+
+	// In-place reading and writing.
+	const void* pData;
+	size_t size;
+	assert(ringBuffer.TryBeginRead(pData, size) && size == sizeof(data));
+	ringBuffer.EndRead();
+	Core::SharedMemoryRingBuffer::Reservation reservation;
+	assert(ringBuffer.TryReserve(sizeof(data), reservation));
+	memset(reservation.Data, 1, reservation.Size);
+	ringBuffer.Commit(reservation);
+	for (unsigned i = 0; i < 4; i++) assert(ringBuffer.TryRead(message) && message[0] == (i == 3 ? 1 : 0));
+	assert(!ringBuffer.WaitForMessage(10));
+
+	bool isThrowing = false;
+	try { ringBuffer.TryWrite(data, 200); }
+	catch (const std::runtime_error&) { isThrowing = true; }
+	assert(isThrowing);
+}
+
+void Benchmark(Core::SharedMemoryRingBufferMode mode, unsigned countProducers, bool isPaced)
+{
+	Core::SharedMemoryRingBuffer ringBuffer;
+	ringBuffer.Initialize(Core::SharedMemoryHandlingRole::Create, c_Name, 1 << 20, mode);
+
+	unsigned countMessagesPerProducer = (isPaced ? c_CountLatencyMessages : c_CountBenchmarkMessages) / countProducers;
+	std::vector<std::uint64_t> latencies;
+	latencies.reserve(countMessagesPerProducer * countProducers);
+	std::uint64_t startTime = 0, endTime = 0;
+
+	auto producer = [&](unsigned producerIndex) {
+		Core::SharedMemoryRingBuffer producerRingBuffer;
+		producerRingBuffer.Initialize(Core::SharedMemoryHandlingRole::Use, c_Name);
+		unsigned char data[c_BenchmarkMessageSize] = {};
+		for (unsigned i = 0; i < countMessagesPerProducer; i++)
+		{
+			if (isPaced)
+			{
+				auto nextTime = GetTimeInNanoseconds() + c_LatencyMessagePeriodInNanoseconds * countProducers;
+				while (GetTimeInNanoseconds() < nextTime);
+			}
+			BenchmarkMessage message = { GetTimeInNanoseconds(), producerIndex, i };
+			memcpy(data, &message, sizeof(message));
+			producerRingBuffer.Write(data, sizeof(data));
+		}
+	};
+
+	auto consumer = [&]() {
+		std::vector<std::uint32_t> nextIndices(countProducers, 0);
+		for (unsigned i = 0; i < countMessagesPerProducer * countProducers; i++)
+		{
+			ringBuffer.WaitForMessage();
+			const void* data;
+			size_t size;
+			ringBuffer.TryBeginRead(data, size);
+			assert(size == c_BenchmarkMessageSize);
+			BenchmarkMessage message;
+			memcpy(&message, data, sizeof(message));
+			ringBuffer.EndRead();
+
+			// The messages of a producer arrive in order.
+			assert(message.Index == nextIndices[message.ProducerIndex]++);
+			auto time = GetTimeInNanoseconds();
+			if (i == 0) startTime = time;
+			endTime = time;
+			latencies.push_back(time - message.SendTime);
+		}
+	};
+
+	RunProducers(countProducers, producer, consumer);
+
+	std::sort(latencies.begin(), latencies.end());
+	auto getPercentile = [&latencies](double percentile) {
+		return latencies[static_cast<size_t>(percentile * (latencies.size() - 1))] / 1000.0;
+	};
+	if (isPaced)
+	{
+		printf("%u producer(s): latency p50: %.2f us, p99: %.2f us, p99.9: %.2f us\n",
+			countProducers, getPercentile(0.5), getPercentile(0.99), getPercentile(0.999));
+	}
+	else
+	{
+		printf("%u producer(s): %.2f M messages/s\n", countProducers, latencies.size() * 1000.0 / (endTime - startTime));
+	}
+}
+
+int main()
+{
+	TestSingleProcess();
+	for (bool isPaced : { false, true })
+	{
+		Benchmark(Core::SharedMemoryRingBufferMode::SingleProducer, 1, isPaced);
+		Benchmark(Core::SharedMemoryRingBufferMode::MultipleProducers, 4, isPaced);
+	}
+	return 0;
+}
@@ -0,0 +1,151 @@
+// StreamSerializationTest.cpp : Defines the entry point for the console application.
+//
+
+#include "stdafx.h"
+
+#include <Core/StreamBinarySerialization.h>
+#include <Core/Compression.h>
+#include <Core/Checksum.h>
+#include <Core/System/SimpleIO.h>
+
+#include <cassert>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+int main()
+{
+	std::vector<std::string> names = { "alpha", "beta" };
+	Core::SimpleTypeVectorU<float> values;
+	for (unsigned i = 0; i < 100000; i++) values.PushBack(static_cast<float>(i % 100));
+
+	// Known CRC-32C check value.
+	assert(Core::ComputeCRC32C("123456789", 9) == 0xe3069283);
+
+	// Compression round-trip.
+	{
+		Core::ByteVector compressed;
+		auto input = reinterpret_cast<const unsigned char*>(values.GetArray());
+		Core::CompressLZ(input, values.GetSizeInBytes(), compressed);
+		assert(compressed.GetSize() < values.GetSizeInBytes());
+		Core::ByteVector decompressed;
+		decompressed.Resize(values.GetSizeInBytes());
+		Core::DecompressLZ(compressed.GetArray(), compressed.GetSize(), decompressed.GetArray(), decompressed.GetSize());
+		assert(memcmp(decompressed.GetArray(), input, decompressed.GetSize()) == 0);
+	}
+
+	// Streaming to memory through a hashing and a compressing sink.
+	Core::ByteVector bytes;
+	{
+		Core::MemoryOutputSinkSB memorySink(bytes);
+		Core::HashingOutputSinkSB hashingSink(&memorySink);
+		Core::CompressingOutputSinkSB compressingSink(hashingSink, 4096);
+		Core::StreamSerializerSB serializer(compressingSink);
+		serializer.Serialize(names);
+		serializer.SerializeAligned(values);
+		serializer.Serialize(42u);
+		serializer.Flush();
+		assert(hashingSink.GetCountBytes() == bytes.GetSize());
+		assert(hashingSink.GetCRC32C() == Core::ComputeCRC32C(bytes.GetArray(), bytes.GetSize()));
+	}
+	{
+		Core::MemoryInputSourceSB memorySource(bytes.GetArray(), bytes.GetSize());
+		Core::DecompressingInputSourceSB source(memorySource);
+		Core::StreamDeserializerSB deserializer(source);
+		std::vector<std::string> names2;
+		Core::SimpleTypeVectorU<float> values2;
+		unsigned u;
+		deserializer.Deserialize(names2);
+		deserializer.DeserializeAligned(values2);
+		deserializer.Deserialize(u);
+		assert(names2 == names && u == 42);
+		assert(values2.GetSize() == values.GetSize());
+		assert(memcmp(values2.GetArray(), values.GetArray(), values.GetSizeInBytes()) == 0);
+	}
+
+	// Uncompressed streams can be viewed in-place and records can be skipped.
+	bytes.Clear();
+	{
+		Core::MemoryOutputSinkSB memorySink(bytes);
+		Core::StreamSerializerSB serializer(memorySink);
+		serializer.Serialize(names);
+		serializer.SerializeAligned(values);
+	}
+	{
+		Core::MemoryInputSourceSB source(bytes.GetArray(), bytes.GetSize());
+		Core::StreamDeserializerSB deserializer(source);
+		deserializer.SkipRecord();
+		Core::ArrayView<float> view;
+		deserializer.DeserializeView(view);
+		assert(view.GetSize() == values.GetSize() && view[99] == 99.0f);
+		assert((view.GetArray() - reinterpret_cast<const float*>(bytes.GetArray())) % (Core::c_AlignmentSB / sizeof(float)) == 0);
+		assert(source.GetCountRemainingBytes() == 0);
+	}
+
+	// File round-trip. The small buffers make the records span buffer boundaries.
+	const char* path = "StreamSerializationTest.bin";
+	{
+		Core::FileOutputSinkSB fileSink(path, 1000);
+		Core::StreamSerializerSB serializer(fileSink);
+		serializer.Serialize(names);
+		serializer.SerializeAligned(values);
+		serializer.Serialize(42u);
+		serializer.Flush();
+		fileSink.Close();
+	}
+	{
+		Core::FileInputSourceSB source(path, 1000);
+		Core::StreamDeserializerSB deserializer(source);
+		std::vector<std::string> names2;
+		Core::SimpleTypeVectorU<float> values2;
+		unsigned u;
+		deserializer.Deserialize(names2);
+		deserializer.DeserializeAligned(values2);
+		deserializer.Deserialize(u);
+		assert(names2 == names && u == 42);
+		assert(memcmp(values2.GetArray(), values.GetArray(), values.GetSizeInBytes()) == 0);
+	}
+	{
+		// Skipping the large record seeks in the file.
+		Core::FileInputSourceSB source(path, 1000);
+		Core::StreamDeserializerSB deserializer(source);
+		unsigned u;
+		deserializer.SkipRecord();
+		deserializer.SkipRecord();
+		deserializer.Deserialize(u);
+		assert(u == 42);
+
+		// Skipping past the end of the file throws, also if it is reached within the buffer.
+		bool isThrown = false;
+		try { source.Skip(1); }
+		catch (const std::runtime_error&) { isThrown = true; }
+		assert(isThrown);
+	}
+	{
+		auto fileSize = Core::ReadAllBytes(path).GetSize();
+		unsigned char byte;
+		{
+			// Skipping exactly to the end of the file.
+			Core::FileInputSourceSB source(path, 1000);
+			source.Read(&byte, 1);
+			source.Skip(fileSize - 1);
+			bool isThrown = false;
+			try { source.Read(&byte, 1); }
+			catch (const std::runtime_error&) { isThrown = true; }
+			assert(isThrown);
+		}
+		{
+			// Skipping past the end of the file after the buffered data.
+			Core::FileInputSourceSB source(path, 1000);
+			source.Read(&byte, 1);
+			bool isThrown = false;
+			try { source.Skip(fileSize); }
+			catch (const std::runtime_error&) { isThrown = true; }
+			assert(isThrown);
+		}
+	}
+	remove(path);
+
+	return 0;
+}
@@ -4,8 +4,11 @@
 #include "stdafx.h"
 
 #include <Core/String.hpp>
+#include <Core/FixedSizedOutputStream.hpp>
 
 #include <cassert>
+#include <string_view>
+#include <vector>
 
 int main()
 {
@@ -248,6 +251,61 @@ int main()
 	assert(res14[1] == "efgh");
 	assert(res14[2] == "ijkl");
 
+	std::string longText = "  \t\n  first,second;;third,  fourth token with a long tail to cover the vector path\r\n ";
+	assert(Core::Trim(longText) == "first,second;;third,  fourth token with a long tail to cover the vector path");
+	assert(Core::TrimView(longText) == Core::Trim(longText));
+	assert(Core::TrimView("                                          ").empty());
+	assert(Core::IsContaining(longText, "vector path"));
+	assert(!Core::IsContaining(longText, "vector paths"));
+	assert(Core::FindSubstring(longText.data(), longText.length(), "path", 4) == longText.find("path"));
+	assert(Core::FindCharacter(longText.data(), longText.length(), 'v') == longText.find('v'));
+	assert(Core::FindAnyOf(longText.data(), longText.length(), "xyz", 3) == longText.length());
+
+	std::vector<std::string_view> views;
+	for (auto part : Core::SplitView(longText, Core::IsAnyOf(",;"), false)) views.push_back(part);
+	assert(views.size() == 5 && views[2].empty() && views[3] == "third");
+	views.clear();
+	for (auto part : Core::SplitView(longText, Core::IsAnyOf(",;"), true)) views.push_back(part);
+	assert(views.size() == 4 && views[2] == "third");
+	views.clear();
+	for (auto part : Core::SplitView(longText, true)) views.push_back(part);
+	assert(views.size() == 12 && views[0] == "first,second;;third," && views[11] == "path");
+	views.clear();
+	for (auto part : Core::SplitView(",,", Core::IsCharacter(','), true)) views.push_back(part);
+	assert(views.empty());
+	for (auto part : Core::SplitView("", Core::IsCharacter(','), false)) views.push_back(part);
+	assert(views.size() == 1 && views[0].empty());
+
+	assert(Core::GetHash64("abc") == Core::GetHash64(std::string("abc")));
+	assert(Core::GetHash64("abc") != Core::GetHash64("abd"));
+	assert(Core::GetHash64("abc") != Core::GetHash64("abc", 1));
+	assert(Core::GetHash64(longText) != Core::GetHash64(longText.substr(1)));
+
+	assert(Core::Format("abc") == "abc");
+	assert(Core::Format("%x-%x-%x", 12, -3.5, std::string("def")) == "12--3.5-def");
+	assert(Core::Format("%x%x", 'a', true) == "a1");
+	bool isThrowing = false;
+	try { Core::Format("%x %x", 1); }
+	catch (std::runtime_error&) { isThrowing = true; }
+	assert(isThrowing);
+
+	char buffer[16];
+	auto length = Core::FormatTo(buffer, CORE_FORMAT_STRING("FPS: %x, calls: %x"), 60u, 1234567);
+	assert(length == 15 && std::string(buffer) == "FPS: 60, calls:");
+	length = Core::FormatTo(buffer, CORE_FORMAT_STRING("%x;%x"), 0.1f, static_cast<std::int8_t>(-7));
+	assert(length == 6 && std::string(buffer) == "0.1;-7");
+	length = Core::FormatTo(buffer, CORE_FORMAT_STRING("no placeholder"));
+	assert(std::string(buffer) == "no placeholder");
+
+	Core::FixedSizedOutputStream<32> stream;
+	stream << "Draw calls: " << 42u << ", " << 2.5;
+	Core::FormatTo(stream, CORE_FORMAT_STRING(" %x"), -1ll);
+	assert(std::string(stream.ToCString()) == "Draw calls: 42, 2.5 -1");
+
+	std::string appended = "x=";
+	Core::FormatTo(appended, "%x", 1e20);
+	assert(appended == "x=1e+20");
+
     return 0;
 }
 
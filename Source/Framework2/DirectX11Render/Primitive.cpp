@@ -73,7 +73,7 @@ namespace DirectX11Render
 		unsigned strides[] = { primitive.PVertexBuffer->GetVertexStride() };
 		unsigned offsets[] = { 0U };
 		context->IASetVertexBuffers(0, 1, vbs, strides, offsets);
-		context->IASetIndexBuffer(primitive.PIndexBuffer->GetBuffer(), DXGI_FORMAT_R32_UINT, 0);
+		context->IASetIndexBuffer(primitive.PIndexBuffer->GetBuffer(), primitive.PIndexBuffer->GetFormat(), 0);
 		context->IASetPrimitiveTopology(c_PrimitiveTopologyMap[(int)primitive.PIndexBuffer->GetTopology()]);
 	}
 
@@ -4,21 +4,22 @@
 
 #include <EngineBuildingBlocks/ErrorHandling.h>
 
+#include <cassert>
+
 using namespace EngineBuildingBlocks;
 using namespace EngineBuildingBlocks::Graphics;
 using namespace DirectXRender;
 using namespace DirectX11Render;
 
-const unsigned c_IndexElementSize = static_cast<unsigned>(sizeof(uint32_t));
-
 IndexBuffer::IndexBuffer()
 	: m_CountIndices(0)
+	, m_Format(DXGI_FORMAT_R32_UINT)
 {
 }
 
 unsigned IndexBuffer::GetSizeInBytes() const
 {
-	return m_CountIndices * c_IndexElementSize;
+	return m_CountIndices * GetIndexSize();
 }
 
 unsigned IndexBuffer::GetCountIndices() const
@@ -26,6 +27,16 @@ unsigned IndexBuffer::GetCountIndices() const
 	return m_CountIndices;
 }
 
+unsigned IndexBuffer::GetIndexSize() const
+{
+	return (m_Format == DXGI_FORMAT_R16_UINT ? 2U : 4U);
+}
+
+DXGI_FORMAT IndexBuffer::GetFormat() const
+{
+	return m_Format;
+}
+
 PrimitiveTopology IndexBuffer::GetTopology() const
 {
 	return m_Topology;
@@ -36,7 +47,7 @@ ID3D11Buffer* IndexBuffer::GetBuffer()
 	return m_Buffer.Get();
 }
 
-void IndexBuffer::InitializeResource(ID3D11Device* device, D3D11_USAGE usage, const unsigned* pIndices)
+void IndexBuffer::InitializeResource(ID3D11Device* device, D3D11_USAGE usage, const void* pIndices)
 {
 	D3D11_BUFFER_DESC desc;
 	desc.ByteWidth = GetSizeInBytes();
@@ -46,7 +57,7 @@ void IndexBuffer::InitializeResource(ID3D11Device* device, D3D11_USAGE usage, co
 		| (usage == D3D11_USAGE_DYNAMIC ? D3D11_CPU_ACCESS_WRITE : 0)
 		| (usage == D3D11_USAGE_STAGING ? D3D11_CPU_ACCESS_READ : 0);
 	desc.MiscFlags = 0;
-	desc.StructureByteStride = c_IndexElementSize;
+	desc.StructureByteStride = GetIndexSize();
 
 	D3D11_SUBRESOURCE_DATA subresourceData{};
 	subresourceData.pSysMem = pIndices;
@@ -62,7 +73,18 @@ void IndexBuffer::Initialize(ID3D11Device* device, const IndexData& indexData)
 {
 	m_CountIndices = indexData.GetCountIndices();
 	m_Topology = indexData.Topology;
-	InitializeResource(device, D3D11_USAGE_IMMUTABLE, indexData.Data.GetArray());
+	if (indexData.CanUseUint16Indices())
+	{
+		Core::SimpleTypeVectorU<std::uint16_t> indices;
+		indexData.As_Uint16_Data(indices);
+		m_Format = DXGI_FORMAT_R16_UINT;
+		InitializeResource(device, D3D11_USAGE_IMMUTABLE, indices.GetArray());
+	}
+	else
+	{
+		m_Format = DXGI_FORMAT_R32_UINT;
+		InitializeResource(device, D3D11_USAGE_IMMUTABLE, indexData.Data.GetArray());
+	}
 }
 
 void IndexBuffer::Initialize(ID3D11Device* device, D3D11_USAGE usage, PrimitiveTopology topology,
@@ -70,6 +92,7 @@ void IndexBuffer::Initialize(ID3D11Device* device, D3D11_USAGE usage, PrimitiveT
 {
 	m_CountIndices = countIndices;
 	m_Topology = topology;
+	m_Format = DXGI_FORMAT_R32_UINT;
 	InitializeResource(device, usage, pIndices);
 }
 
@@ -81,12 +104,14 @@ void IndexBuffer::SetData(ID3D11DeviceContext* context, const unsigned* pIndices
 void IndexBuffer::SetData(ID3D11DeviceContext* context, const unsigned* pIndices,
 	unsigned startIndex, unsigned countIndices)
 {
+	assert(m_Format == DXGI_FORMAT_R32_UINT);
+
 	D3D11_MAPPED_SUBRESOURCE mappedResource;
 	auto hr = context->Map(m_Buffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource);
 	if (FAILED(hr))
 	{
 		EngineBuildingBlocks::RaiseException("Failed to map an index buffer.");
 	}
-	memcpy(reinterpret_cast<unsigned*>(mappedResource.pData) + startIndex, pIndices, countIndices * c_IndexElementSize);
+	memcpy(reinterpret_cast<unsigned*>(mappedResource.pData) + startIndex, pIndices, countIndices * sizeof(unsigned));
 	context->Unmap(m_Buffer.Get(), 0);
 }
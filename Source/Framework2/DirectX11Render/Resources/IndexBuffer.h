@@ -14,8 +14,9 @@ namespace DirectX11Render
 
 		unsigned m_CountIndices;
 		EngineBuildingBlocks::Graphics::PrimitiveTopology m_Topology;
+		DXGI_FORMAT m_Format;
 
-		void InitializeResource(ID3D11Device* device, D3D11_USAGE usage, const unsigned* pIndices);
+		void InitializeResource(ID3D11Device* device, D3D11_USAGE usage, const void* pIndices);
 
 	public:
 
@@ -23,6 +24,10 @@ namespace DirectX11Render
 
 		unsigned GetSizeInBytes() const;
 		unsigned GetCountIndices() const;
+		unsigned GetIndexSize() const;
+
+		// R16_UINT if the buffer was initialized from index data, which fits to 16 bits, R32_UINT otherwise.
+		DXGI_FORMAT GetFormat() const;
 
 		EngineBuildingBlocks::Graphics::PrimitiveTopology GetTopology() const;
 
@@ -34,6 +39,7 @@ namespace DirectX11Render
 			EngineBuildingBlocks::Graphics::PrimitiveTopology topology,
 			unsigned countIndices, const unsigned* pIndices = nullptr);
 	
+		// The buffer must have 32-bit indices.
 		void SetData(ID3D11DeviceContext* context, const unsigned* pIndices);
 		void SetData(ID3D11DeviceContext* context, const unsigned* pIndices,
 			unsigned startIndex, unsigned countIndices);
@@ -275,7 +275,7 @@ void TextRenderer::Render(const UtilityRenderContext& context)
 	unsigned vbStrides[] = { m_Primitive.PVertexBuffer->GetVertexStride(), m_SymbolInstanceBuffer.GetVertexStride() };
 	unsigned vbOffsets[] = { 0U, 0U };
 	d3dContext->IASetVertexBuffers(0, 2, vbs, vbStrides, vbOffsets);
-	d3dContext->IASetIndexBuffer(m_Primitive.PIndexBuffer->GetBuffer(), DXGI_FORMAT_R32_UINT, 0);
+	d3dContext->IASetIndexBuffer(m_Primitive.PIndexBuffer->GetBuffer(), m_Primitive.PIndexBuffer->GetFormat(), 0);
 	d3dContext->IASetPrimitiveTopology(c_PrimitiveTopologyMap[(int)m_Primitive.PIndexBuffer->GetTopology()]);
 
 	unsigned instanceIndex = 0;
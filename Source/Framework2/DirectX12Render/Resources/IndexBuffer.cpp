@@ -16,6 +16,7 @@ using namespace DirectX12Render;
 IndexBuffer::IndexBuffer()
 	: m_CountIndices(0)
 {
+	m_IndexBufferView.Format = DXGI_FORMAT_R32_UINT;
 }
 
 const D3D12_INDEX_BUFFER_VIEW& IndexBuffer::GetIndexBufferView() const
@@ -28,9 +29,14 @@ unsigned IndexBuffer::GetCountIndices() const
 	return m_CountIndices;
 }
 
+unsigned IndexBuffer::GetIndexSize() const
+{
+	return (m_IndexBufferView.Format == DXGI_FORMAT_R16_UINT ? 2U : 4U);
+}
+
 unsigned IndexBuffer::GetCPUSize() const
 {
-	return m_CountIndices * sizeof(unsigned);
+	return m_CountIndices * GetIndexSize();
 }
 
 unsigned IndexBuffer::GetGPUSize() const
@@ -61,7 +67,6 @@ void IndexBuffer::CreateResource(ID3D12Device* device, D3D12_HEAP_TYPE heapType)
 void IndexBuffer::InitializeView(ID3D12Device* device)
 {
 	m_IndexBufferView.BufferLocation = m_Resource->GetGPUVirtualAddress();
-	m_IndexBufferView.Format = DXGI_FORMAT_R32_UINT;
 	m_IndexBufferView.SizeInBytes = GetCPUSize();
 }
 
@@ -70,6 +75,15 @@ void IndexBuffer::SetData(TransferBufferManager* transferBufferManager,
 	const EngineBuildingBlocks::Graphics::IndexData& indexData)
 {
 	assert(c_PrimitiveTopologyMap[(unsigned char)indexData.Topology] == m_Topology);
+	assert(indexData.GetCountIndices() == m_CountIndices);
+
+	const void* pIndices = indexData.Data.GetArray();
+	Core::SimpleTypeVectorU<std::uint16_t> indices16;
+	if (m_IndexBufferView.Format == DXGI_FORMAT_R16_UINT)
+	{
+		indexData.As_Uint16_Data(indices16);
+		pIndices = indices16.GetArray();
+	}
 
 	unsigned cpuSize = GetCPUSize();
 	unsigned gpuSize = GetGPUSize();
@@ -83,7 +97,7 @@ void IndexBuffer::SetData(TransferBufferManager* transferBufferManager,
 	auto uploadBuffer = transferBufferManager->RequestUploadBuffer(device, uploadBufferDescription);
 
 	D3D12_SUBRESOURCE_DATA subresourceData;
-	subresourceData.pData = indexData.Data.GetArray();
+	subresourceData.pData = pIndices;
 	subresourceData.RowPitch = cpuSize;
 	subresourceData.SlicePitch = cpuSize;
 	UpdateSubresources(commandList, m_Resource.Get(), uploadBuffer->GetResource(), 0, 0, 1, &subresourceData);
@@ -95,6 +109,7 @@ void IndexBuffer::Initialize(TransferBufferManager* transferBufferManager,
 {
 	m_Topology = c_PrimitiveTopologyMap[(unsigned char)indexData.Topology];
 	m_CountIndices = indexData.Data.GetSize();
+	m_IndexBufferView.Format = (indexData.CanUseUint16Indices() ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT);
 	CreateResource(device, D3D12_HEAP_TYPE_DEFAULT);
 	InitializeView(device);
 	SetData(transferBufferManager, commandList, device, indexData);
@@ -105,6 +120,7 @@ void IndexBuffer::Initialize(ID3D12Device* device, D3D12_HEAP_TYPE heapType,
 {
 	m_Topology = c_PrimitiveTopologyMap[(unsigned char)topology];
 	m_CountIndices = countIndices;
+	m_IndexBufferView.Format = DXGI_FORMAT_R32_UINT;
 	CreateResource(device, heapType);
 	InitializeView(device);
 }
\ No newline at end of file
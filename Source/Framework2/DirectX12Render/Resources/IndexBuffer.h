@@ -27,6 +27,7 @@ namespace DirectX12Render
 		IndexBuffer();
 
 		unsigned GetCountIndices() const;
+		unsigned GetIndexSize() const;
 		unsigned GetCPUSize() const;
 		unsigned GetGPUSize() const;
 
@@ -34,6 +35,7 @@ namespace DirectX12Render
 
 		const D3D12_INDEX_BUFFER_VIEW& GetIndexBufferView() const;
 
+		// The buffer has 16-bit indices if the index data fits to 16 bits.
 		void Initialize(
 			TransferBufferManager* transferBufferManager,
 			ID3D12GraphicsCommandList* commandList,
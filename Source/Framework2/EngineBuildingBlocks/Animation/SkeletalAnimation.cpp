@@ -9,23 +9,6 @@ using namespace EngineBuildingBlocks::Animation;
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void KeyFrame::SerializeSB(Core::ByteVector& bytes) const
-{
-	Core::SerializeSB(bytes, Location);
-	Core::SerializeSB(bytes, Core::ToPlaceHolder(Scaler));
-	Core::SerializeSB(bytes, Time);
-}
-
-void KeyFrame::DeserializeSB(const unsigned char*& bytes)
-{
-	Core::DeserializeSB(bytes, Location);
-	Core::DeserializeSB(bytes, Core::ToPlaceHolder(Scaler));
-	Core::DeserializeSB(bytes, Time);
-}
-
-////////////////////////////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////////////////////////
-
 void BoneAnimationChannel::SerializeSB(Core::ByteVector& bytes) const
 {
 	Core::SerializeSB(bytes, BoneName);
@@ -93,18 +76,6 @@ bool BoneInfluence::operator<(const BoneInfluence& other) const
 	return false;
 }
 
-void BoneInfluence::SerializeSB(Core::ByteVector& bytes) const
-{
-	Core::SerializeSB(bytes, BoneIndex);
-	Core::SerializeSB(bytes, Weight);
-}
-
-void BoneInfluence::DeserializeSB(const unsigned char*& bytes)
-{
-	Core::DeserializeSB(bytes, BoneIndex);
-	Core::DeserializeSB(bytes, Weight);
-}
-
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
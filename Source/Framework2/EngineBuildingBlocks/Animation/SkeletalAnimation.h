@@ -6,6 +6,7 @@
 #include <Core/DataStructures/SimpleTypeVector.hpp>
 #include <Core/DataStructures/SimpleTypeUnorderedVector.hpp>
 #include <Core/DataStructures/ResourceUnorderedVector.hpp>
+#include <Core/SimpleBinarySerialization.hpp>
 #include <EngineBuildingBlocks/SceneNode.h>
 #include <EngineBuildingBlocks/SystemTime.h>
 
@@ -18,9 +19,6 @@ namespace EngineBuildingBlocks
 			EngineBuildingBlocks::RigidTransformation Location;
 			glm::vec3 Scaler;
 			double Time;
-
-			void SerializeSB(Core::ByteVector& bytes) const;
-			void DeserializeSB(const unsigned char*& bytes);
 		};
 
 		enum class AnimationWrapMode : unsigned char
@@ -64,9 +62,6 @@ namespace EngineBuildingBlocks
 			bool operator==(const BoneInfluence& other) const;
 			bool operator!=(const BoneInfluence& other) const;
 			bool operator<(const BoneInfluence& other) const;
-
-			void SerializeSB(Core::ByteVector& bytes) const;
-			void DeserializeSB(const unsigned char*& bytes);
 		};
 
 		struct BoneInfluence_IndexLessComparator
@@ -138,4 +133,7 @@ namespace EngineBuildingBlocks
 	}
 }
 
+CORE_BITWISE_SERIALIZABLE_SB(EngineBuildingBlocks::Animation::KeyFrame)
+CORE_BITWISE_SERIALIZABLE_SB(EngineBuildingBlocks::Animation::BoneInfluence)
+
 #endif
\ No newline at end of file
@@ -0,0 +1,115 @@
+// EngineBuildingBlocks/Graphics/MeshletCuller.cpp
+
+#include <EngineBuildingBlocks/Graphics/MeshletCuller.h>
+
+#include <EngineBuildingBlocks/Math/BoundingFrustum.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace EngineBuildingBlocks;
+using namespace EngineBuildingBlocks::Graphics;
+
+namespace
+{
+	inline bool IsSphereInFrustum(const Math::Plane* frustumPlanes, const glm::vec3& center, float radius)
+	{
+		for (unsigned i = 0; i < Math::c_CountFrustumPlanes; i++)
+		{
+			if (glm::dot(frustumPlanes[i].Normal, center) + frustumPlanes[i].D > radius)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+void MeshletCuller::CullInThread(unsigned threadId, unsigned startIndex, unsigned endIndex,
+	const Math::Plane* frustumPlanes, glm::vec3 cameraPosition,
+	const SceneNodeHandler* pSceneNodeHandler,
+	const MeshletCullingObject* objects, bool isCullingBackfaces,
+	VisibleMeshlet* outputMeshlets, unsigned* outputMeshletCountArray)
+{
+	auto transformations = pSceneNodeHandler->GetScaledWorldTransformations();
+	auto meshletOffsets = m_MeshletOffsets.GetArray();
+
+	unsigned targetIndex = startIndex;
+
+	// The object of the first meshlet: the last object, which starts at or before it.
+	unsigned objectIndex = static_cast<unsigned>(std::upper_bound(meshletOffsets,
+		m_MeshletOffsets.GetEndPointer(), startIndex) - meshletOffsets) - 1;
+
+	for (unsigned i = startIndex; i < endIndex; objectIndex++)
+	{
+		auto& object = objects[objectIndex];
+		unsigned objectEndIndex = std::min(endIndex, meshletOffsets[objectIndex + 1]);
+		if (i >= objectEndIndex) continue;
+
+		// The spheres are transformed to the world space, and the camera is transformed to the model space
+		// for the normal cones.
+		auto& transformation = transformations[object.SceneNodeIndex];
+		auto& A = transformation.A;
+		float radiusScaler = std::sqrt(std::max(glm::dot(A[0], A[0]),
+			std::max(glm::dot(A[1], A[1]), glm::dot(A[2], A[2]))));
+		auto localCameraPosition = glm::inverse(A) * (cameraPosition - transformation.Position);
+
+		for (; i < objectEndIndex; i++)
+		{
+			unsigned meshletIndex = i - meshletOffsets[objectIndex];
+			auto& meshlet = object.Meshlets[meshletIndex];
+			if (isCullingBackfaces && IsMeshletBackfacing(meshlet, localCameraPosition)) continue;
+			if (IsSphereInFrustum(frustumPlanes, A * meshlet.Center + transformation.Position,
+				meshlet.Radius * radiusScaler))
+			{
+				outputMeshlets[targetIndex++] = VisibleMeshlet{ objectIndex, meshletIndex };
+			}
+		}
+	}
+
+	outputMeshletCountArray[threadId] = targetIndex - startIndex;
+}
+
+void MeshletCuller::Cull(Camera& camera, Core::ThreadPool& threadPool,
+	const SceneNodeHandler& sceneNodeHandler,
+	const MeshletCullingObject* objects, unsigned countObjects,
+	Core::SimpleTypeVectorU<VisibleMeshlet>& visibleMeshlets,
+	bool isCullingBackfaces)
+{
+	m_MeshletOffsets.Resize(countObjects + 1);
+	m_MeshletOffsets[0] = 0;
+	for (unsigned i = 0; i < countObjects; i++)
+	{
+		m_MeshletOffsets[i + 1] = m_MeshletOffsets[i] + objects[i].CountMeshlets;
+	}
+	unsigned countMeshlets = m_MeshletOffsets[countObjects];
+
+	visibleMeshlets.Resize(countMeshlets);
+	if (countMeshlets == 0) return;
+
+	m_CountOutputMeshlets.Resize(threadPool.GetCountThreads());
+	m_CountOutputMeshlets.SetByte(0);
+
+	unsigned countThreads = threadPool.ExecuteWithStaticScheduling(countMeshlets,
+		&MeshletCuller::CullInThread, this,
+		camera.GetViewFrustum().GetPlanes().Planes, camera.GetPosition(),
+		&sceneNodeHandler, objects, isCullingBackfaces, visibleMeshlets.GetArray(),
+		m_CountOutputMeshlets.GetArray());
+
+	// Single-threaded compaction.
+	unsigned startIndex, endIndex;
+	Core::ThreadingHelper::GetTaskIndices(countMeshlets, countThreads, 0, startIndex, endIndex);
+	unsigned sourceIndex = endIndex - startIndex;
+	unsigned targetIndex = m_CountOutputMeshlets[0];
+	for (unsigned i = 1; i < countThreads; i++)
+	{
+		unsigned countOutputMeshlets = m_CountOutputMeshlets[i];
+		memmove(&visibleMeshlets[targetIndex], &visibleMeshlets[sourceIndex],
+			countOutputMeshlets * sizeof(VisibleMeshlet));
+		Core::ThreadingHelper::GetTaskIndices(countMeshlets, countThreads, i, startIndex, endIndex);
+		sourceIndex += endIndex - startIndex;
+		targetIndex += countOutputMeshlets;
+	}
+	visibleMeshlets.UnsafeResize(targetIndex);
+}
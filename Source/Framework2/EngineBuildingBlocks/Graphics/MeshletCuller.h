@@ -0,0 +1,59 @@
+// EngineBuildingBlocks/Graphics/MeshletCuller.h
+
+#ifndef _ENGINEBUILDINGBLOCKS_MESHLETCULLER_H_INCLUDED_
+#define _ENGINEBUILDINGBLOCKS_MESHLETCULLER_H_INCLUDED_
+
+#include <Core/System/ThreadPool.h>
+#include <EngineBuildingBlocks/SceneNode.h>
+#include <EngineBuildingBlocks/Graphics/Camera/Camera.h>
+#include <EngineBuildingBlocks/Graphics/Primitives/Meshlet.h>
+#include <EngineBuildingBlocks/Math/Plane.h>
+
+namespace EngineBuildingBlocks
+{
+	namespace Graphics
+	{
+		struct MeshletCullingObject
+		{
+			unsigned SceneNodeIndex;
+			const Meshlet* Meshlets;
+			unsigned CountMeshlets;
+		};
+
+		struct VisibleMeshlet
+		{
+			unsigned ObjectIndex;
+
+			// The index in the meshlets of the object.
+			unsigned MeshletIndex;
+		};
+
+		class MeshletCuller
+		{
+			Core::IndexVectorU m_MeshletOffsets;
+			Core::SimpleTypeVectorU<unsigned> m_CountOutputMeshlets;
+
+			void CullInThread(unsigned threadId, unsigned startIndex, unsigned endIndex,
+				const EngineBuildingBlocks::Math::Plane* frustumPlanes, glm::vec3 cameraPosition,
+				const EngineBuildingBlocks::SceneNodeHandler* pSceneNodeHandler,
+				const MeshletCullingObject* objects, bool isCullingBackfaces,
+				VisibleMeshlet* outputMeshlets, unsigned* outputMeshletCountArray);
+
+		public:
+
+			// Culls the meshlets of the objects with the view frustum and, optionally, with their normal cones,
+			// and outputs the visible meshlets in the order of the objects. It assumes, that the scene nodes'
+			// scaled world transformation is up-to-date. The meshlets of all objects are split uniformly between
+			// the threads, thus the work is balanced within huge meshes too. The backface culling assumes
+			// counter-clockwise front faces and transformations, which don't mirror.
+			// The results are conservative: the bounding spheres are tested against the frustum planes.
+			void Cull(Camera& camera, Core::ThreadPool& threadPool,
+				const SceneNodeHandler& sceneNodeHandler,
+				const MeshletCullingObject* objects, unsigned countObjects,
+				Core::SimpleTypeVectorU<VisibleMeshlet>& visibleMeshlets,
+				bool isCullingBackfaces = true);
+		};
+	}
+}
+
+#endif
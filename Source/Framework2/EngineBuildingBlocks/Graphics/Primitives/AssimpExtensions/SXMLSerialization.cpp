@@ -4,6 +4,7 @@
 
 #include <Core/SimpleXMLSerialization.hpp>
 #include <Core/System/SimpleIO.h>
+#include <Core/System/MemoryMappedFile.h>
 #include <Core/String.hpp>
 #include <Core/Constants.h>
 
@@ -14,6 +15,8 @@ namespace EngineBuildingBlocks
 {
 	namespace Graphics
 	{
+		// The numbers are written as a single typed array to binary documents. Only the first
+		// 'elementSize' numbers of each element are written.
 		template <typename NumberType, typename ElementType>
 		inline void SerializeSXML(Core::SerializationSXMLData& data, const ElementType* array,
 			unsigned elementSize, unsigned elementCount, const char* objectName)
@@ -21,21 +24,25 @@ namespace EngineBuildingBlocks
 			if (array != nullptr)
 			{
 				auto values = reinterpret_cast<const NumberType*>(array);
-				unsigned elementLimit = elementCount - 1;
-				unsigned valueLimit = elementSize - 1;
-				unsigned index = 0;
 				unsigned elementStride = sizeof(ElementType) / sizeof(NumberType);
-				for (unsigned i = 0; i < elementCount; i++, index += elementStride)
+				auto newData = Core::CreateXMLNode(data, objectName);
+				if (elementSize == elementStride)
+				{
+					Core::SetValuesSXML(newData, values, elementCount * elementSize, elementSize);
+				}
+				else
 				{
-					for (unsigned j = 0; j < elementSize; j++)
+					std::vector<NumberType> packedValues(elementCount * elementSize);
+					unsigned index = 0;
+					for (unsigned i = 0; i < elementCount; i++, index += elementStride)
 					{
-						*data.SS << values[index + j];
-						if (j < valueLimit) *data.SS << ",";
+						for (unsigned j = 0; j < elementSize; j++)
+						{
+							packedValues[i * elementSize + j] = values[index + j];
+						}
 					}
-					if (i < elementLimit) *data.SS << ";";
+					Core::SetValuesSXML(newData, packedValues.data(), packedValues.size(), elementSize);
 				}
-				Core::CreateXMLNode(data, objectName, data.SS->str().c_str());
-				data.SS->str("");
 			}
 		}
 
@@ -51,12 +58,11 @@ namespace EngineBuildingBlocks
 			unsigned elementSize, unsigned& elementCount, const char* objectName)
 		{
 			auto newData = Core::VisitChildXMLNode(data, objectName);
-			if (newData.Node != nullptr)
+			if (newData.IsValid() && elementSize > 0)
 			{
-				newData.PlaceNodeValue();
-				auto parts = Core::Split(newData.Chars->GetArray(), Core::IsCharacter(';'), true);
-				std::vector<std::string> numberStrs;
-				auto newElementCount = static_cast<unsigned>(parts.size());
+				std::vector<NumberType> packedValues;
+				Core::GetValuesSXML(newData, packedValues);
+				auto newElementCount = static_cast<unsigned>(packedValues.size() / elementSize);
 				if (array == nullptr)
 				{
 					if (elementCount == 0) elementCount = newElementCount;
@@ -65,17 +71,11 @@ namespace EngineBuildingBlocks
 				}
 				else assert(elementCount == newElementCount);
 				auto values = reinterpret_cast<NumberType*>(array);
-				unsigned elementLimit = elementCount - 1;
-				unsigned valueLimit = elementSize - 1;
 				unsigned index = 0;
 				unsigned elementStride = sizeof(ElementType) / sizeof(NumberType);
 				for (unsigned i = 0; i < elementCount; i++, index += elementStride)
 				{
-					for (unsigned j = 0; j < elementSize; j++)
-					{
-						Core::Split(parts[i], Core::IsCharacter(','), true, numberStrs);
-						values[index + j] = Core::Parse<NumberType>(numberStrs[j].c_str());
-					}
+					for (unsigned j = 0; j < elementSize; j++) values[index + j] = packedValues[i * elementSize + j];
 					for (unsigned j = elementSize; j < elementStride; ++j) values[index + j] = NumberType(0);
 				}
 			}
@@ -304,8 +304,7 @@ namespace EngineBuildingBlocks
 				auto Sematic = Property->mSemantic;
 				auto Index = Property->mIndex;
 				auto Type = Property->mType;
-				auto Data = Core::ToBinaryText(reinterpret_cast<const unsigned char*>(Property->mData),
-					Property->mDataLength);
+				auto Data = Core::AsBinaryData(Property->mData, Property->mDataLength);
 
 				Core_SerializeSXML(data, Key);
 				Core_SerializeSXML(data, Sematic);
@@ -323,7 +322,8 @@ namespace EngineBuildingBlocks
 				auto& Sematic = Property->mSemantic;
 				auto& Index = Property->mIndex;
 				auto& Type = Property->mType;
-				std::string Data;
+				size_t dataLength;
+				auto Data = Core::AsBinaryData(&Property->mData, &dataLength);
 
 				Core_DeserializeSXML(data, Key);
 				Core_DeserializeSXML(data, Sematic);
@@ -332,8 +332,7 @@ namespace EngineBuildingBlocks
 				Core_DeserializeSXML(data, Data);
 
 				Property->mKey = Key.c_str();
-				Core::ToBinaryData(Data, reinterpret_cast<unsigned char*&>(Property->mData),
-					Property->mDataLength);
+				Property->mDataLength = static_cast<unsigned>(dataLength);
 			}
 		};
 
@@ -564,14 +563,12 @@ namespace EngineBuildingBlocks
 
 				std::vector<std::string> Keys;
 				std::vector<aiMetadataType> Types;
-				std::vector<std::string> Data;
+				std::vector<Core::SerializationBinaryDataWrapper> Data;
 				for (unsigned i = 0; i < Metadata->mNumProperties; i++)
 				{
 					Keys.emplace_back(Metadata->mKeys[i].C_Str());
 					Types.push_back(Metadata->mValues[i].mType);
-					Data.push_back(Core::ToBinaryText(
-						reinterpret_cast<const unsigned char*>(Metadata->mValues[i].mData),
-						GetEntrySize(Metadata->mValues[i])));
+					Data.push_back(Core::AsBinaryData(Metadata->mValues[i].mData, GetEntrySize(Metadata->mValues[i])));
 				}
 				Core_SerializeSXML(data, Keys);
 				Core_SerializeSXML(data, Types);
@@ -581,27 +578,30 @@ namespace EngineBuildingBlocks
 			inline void DeserializeSXML(Core::DeserializationSXMLData& data)
 			{
 				assert(Metadata == nullptr);
-				if (data.Node->first_node() != nullptr)
+				if (data.HasChildNodes())
 				{
 					Metadata = new aiMetadata();
 
 					std::vector<std::string> Keys;
 					std::vector<aiMetadataType> Types;
-					std::vector<std::string> Data;
 					Core_DeserializeSXML(data, Keys);
 					Core_DeserializeSXML(data, Types);
-					Core_DeserializeSXML(data, Data);
-					assert(Keys.size() == Types.size() && Keys.size() == Data.size());
+					assert(Keys.size() == Types.size());
 
 					Metadata->mNumProperties = static_cast<unsigned>(Keys.size());
 					Metadata->mKeys = new aiString[Metadata->mNumProperties];
 					Metadata->mValues = new aiMetadataEntry[Metadata->mNumProperties];
-					for (unsigned i = 0; i < Metadata->mNumProperties; i++)
+
+					// The binary data elements are deserialized directly to the entries.
+					auto dataNode = Core::VisitChildXMLNode(data, "Data");
+					auto cData = dataNode.GetFirstChild();
+					for (unsigned i = 0; i < Metadata->mNumProperties; i++, cData = cData.GetNextSibling())
 					{
+						assert(cData.IsValid());
 						Metadata->mKeys[i] = Keys[i].c_str();
 						Metadata->mValues[i].mType = Types[i];
-						unsigned dataLength;
-						Core::ToBinaryData(Data[i], reinterpret_cast<unsigned char*&>(Metadata->mValues[i].mData),
+						size_t dataLength;
+						Core::GetBytesSXML(cData, reinterpret_cast<unsigned char*&>(Metadata->mValues[i].mData),
 							dataLength);
 					}
 				}
@@ -777,17 +777,27 @@ namespace EngineBuildingBlocks
 		aiScene* ImportAssimpSceneSXML(const char* path)
 		{
 			auto scene = new aiScene();
-			std::string text;
-			Core::ReadAllText(path, text);
-			Core::StartDeserializeSXML(text, SceneWrapper(scene), "Scene");
+			SceneWrapper sceneWrapper(scene);
+			Core::MemoryMappedFile file(path);
+			Core::StartDeserializeAnySXML(file.GetData(), file.GetSize(), sceneWrapper, "Scene");
 			return scene;
 		}
 
-		void ExportAssimpSceneSXML(const aiScene* scene, const char* path)
+		void ExportAssimpSceneSXML(const aiScene* scene, const char* path, bool isBinary)
 		{
-			std::string text;
-			Core::StartSerializeSXML(text, SceneWrapper(scene), "Scene");
-			Core::WriteAllText(path, text);
+			SceneWrapper sceneWrapper(scene);
+			if (isBinary)
+			{
+				Core::ByteVector bytes;
+				Core::StartSerializeBinarySXML(bytes, sceneWrapper, "Scene");
+				Core::WriteAllBytes(path, bytes);
+			}
+			else
+			{
+				std::string text;
+				Core::StartSerializeSXML(text, sceneWrapper, "Scene");
+				Core::WriteAllText(path, text);
+			}
 		}
 	}
 }
\ No newline at end of file
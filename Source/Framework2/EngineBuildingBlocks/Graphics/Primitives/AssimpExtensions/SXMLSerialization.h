@@ -9,8 +9,9 @@ namespace EngineBuildingBlocks
 {
 	namespace Graphics
 	{
+		// Imports both the XML and the binary form.
 		aiScene* ImportAssimpSceneSXML(const char* path);
-		void ExportAssimpSceneSXML(const aiScene* scene, const char* path);
+		void ExportAssimpSceneSXML(const aiScene* scene, const char* path, bool isBinary = true);
 	}
 }
 
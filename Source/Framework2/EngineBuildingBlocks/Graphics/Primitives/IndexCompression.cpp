@@ -0,0 +1,226 @@
+// EngineBuildingBlocks/Graphics/Primitives/IndexCompression.cpp
+
+#include <EngineBuildingBlocks/Graphics/Primitives/IndexCompression.h>
+
+#include <Core/Constants.h>
+#include <EngineBuildingBlocks/ErrorHandling.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+using namespace EngineBuildingBlocks;
+using namespace EngineBuildingBlocks::Graphics;
+
+namespace
+{
+	// A 33-bit code takes at most 5 bytes.
+	const unsigned c_MaximumCodeSize = 5;
+
+	// The count of the recently referenced vertices, which can be referred by their position in a FIFO.
+	const unsigned c_CountRecentIndices = 16;
+
+	const std::uint64_t c_FirstRecentIndexCode = 1;
+	const std::uint64_t c_FirstDifferenceCode = c_FirstRecentIndexCode + c_CountRecentIndices;
+
+	inline std::uint32_t ZigzagEncode(std::uint32_t difference)
+	{
+		return (difference << 1) ^ static_cast<std::uint32_t>(static_cast<std::int32_t>(difference) >> 31);
+	}
+
+	inline std::uint32_t ZigzagDecode(std::uint32_t code)
+	{
+		return (code >> 1) ^ (0U - (code & 1U));
+	}
+
+	// The state of the codec, which is updated identically by the encoder and the decoder. The vertices,
+	// which are not found in the FIFO, are added to it.
+	struct CompressedIndexState
+	{
+		unsigned RecentIndices[c_CountRecentIndices];
+		unsigned RecentIndexPosition;
+		unsigned NextIndex;
+		unsigned PreviousIndex;
+
+		CompressedIndexState()
+			: RecentIndexPosition(0)
+			, NextIndex(0)
+			, PreviousIndex(0)
+		{
+			std::fill(RecentIndices, RecentIndices + c_CountRecentIndices, Core::c_InvalidIndexU);
+		}
+
+		// Returns the position of the index in the FIFO: 0 for the most recently added one.
+		inline unsigned FindRecentIndex(unsigned index) const
+		{
+			for (unsigned i = 0; i < c_CountRecentIndices; i++)
+			{
+				if (GetRecentIndex(i) == index) return i;
+			}
+			return Core::c_InvalidIndexU;
+		}
+
+		inline unsigned GetRecentIndex(unsigned position) const
+		{
+			return RecentIndices[(RecentIndexPosition - 1 - position) & (c_CountRecentIndices - 1)];
+		}
+
+		inline void Update(unsigned index, bool isRecentIndex)
+		{
+			if (!isRecentIndex)
+			{
+				RecentIndices[RecentIndexPosition] = index;
+				RecentIndexPosition = (RecentIndexPosition + 1) & (c_CountRecentIndices - 1);
+			}
+			NextIndex = std::max(NextIndex, index + 1);
+			PreviousIndex = index;
+		}
+	};
+
+	void EncodeCompressedIndices(const unsigned* indices, unsigned countIndices, Core::ByteVectorU& bytes)
+	{
+		unsigned startSize = bytes.GetSize();
+		bytes.Resize(startSize + countIndices * c_MaximumCodeSize);
+		auto target = bytes.GetArray() + startSize;
+
+		CompressedIndexState state;
+		for (unsigned i = 0; i < countIndices; i++)
+		{
+			unsigned index = indices[i];
+			unsigned recentPosition = state.FindRecentIndex(index);
+			std::uint64_t code;
+			if (index == state.NextIndex) code = 0;
+			else if (recentPosition != Core::c_InvalidIndexU) code = c_FirstRecentIndexCode + recentPosition;
+			else code = c_FirstDifferenceCode + ZigzagEncode(index - state.PreviousIndex);
+			while (code >= 0x80)
+			{
+				*target++ = static_cast<unsigned char>(code | 0x80);
+				code >>= 7;
+			}
+			*target++ = static_cast<unsigned char>(code);
+			state.Update(index, index != state.NextIndex && recentPosition != Core::c_InvalidIndexU);
+		}
+
+		bytes.Resize(static_cast<unsigned>(target - bytes.GetArray()));
+	}
+
+	const unsigned char* DecodeCompressedIndices(const unsigned char* bytes, const unsigned char* end,
+		unsigned* indices, unsigned countIndices)
+	{
+		CompressedIndexState state;
+		for (unsigned i = 0; i < countIndices; i++)
+		{
+			if (bytes == end) RaiseException("The compressed indices are incomplete.");
+			std::uint64_t code = *bytes++;
+			if (code >= 0x80)
+			{
+				code &= 0x7f;
+				for (unsigned shift = 7; ; shift += 7)
+				{
+					if (bytes == end || shift >= 7 * c_MaximumCodeSize) RaiseException("The compressed indices are invalid.");
+					std::uint64_t byte = *bytes++;
+					code |= (byte & 0x7f) << shift;
+					if (byte < 0x80) break;
+				}
+			}
+			unsigned index;
+			bool isRecentIndex = (code >= c_FirstRecentIndexCode && code < c_FirstDifferenceCode);
+			if (code == 0) index = state.NextIndex;
+			else if (isRecentIndex) index = state.GetRecentIndex(static_cast<unsigned>(code - c_FirstRecentIndexCode));
+			else index = state.PreviousIndex + ZigzagDecode(static_cast<std::uint32_t>(code - c_FirstDifferenceCode));
+			indices[i] = index;
+			state.Update(index, isRecentIndex);
+		}
+		return bytes;
+	}
+
+	inline void CheckSize(const unsigned char* bytes, const unsigned char* end, size_t size)
+	{
+		if (static_cast<size_t>(end - bytes) < size) RaiseException("The encoded indices are incomplete.");
+	}
+}
+
+namespace EngineBuildingBlocks
+{
+	namespace Graphics
+	{
+		unsigned GetMaximumIndex(const unsigned* indices, unsigned countIndices)
+		{
+			unsigned maximum = 0;
+			for (unsigned i = 0; i < countIndices; i++) maximum = std::max(maximum, indices[i]);
+			return maximum;
+		}
+
+		IndexEncoding GetSmallestIndexEncoding(const unsigned* indices, unsigned countIndices)
+		{
+			return (GetMaximumIndex(indices, countIndices) <= c_MaximumUint16Index
+				? IndexEncoding::Uint16 : IndexEncoding::Uint32);
+		}
+
+		void ConvertIndicesToUint16(const unsigned* indices, unsigned countIndices, std::uint16_t* result)
+		{
+			for (unsigned i = 0; i < countIndices; i++)
+			{
+				assert(indices[i] <= c_MaximumUint16Index);
+				result[i] = static_cast<std::uint16_t>(indices[i]);
+			}
+		}
+
+		void EncodeIndices(const unsigned* indices, unsigned countIndices, IndexEncoding encoding,
+			Core::ByteVectorU& bytes)
+		{
+			unsigned startSize = bytes.GetSize();
+			switch (encoding)
+			{
+			case IndexEncoding::Uint32:
+				bytes.Resize(startSize + countIndices * sizeof(unsigned));
+				memcpy(bytes.GetArray() + startSize, indices, countIndices * sizeof(unsigned));
+				break;
+			case IndexEncoding::Uint16:
+			{
+				if (GetMaximumIndex(indices, countIndices) > c_MaximumUint16Index)
+					RaiseException("The indices don't fit to 16 bits.");
+				bytes.Resize(startSize + countIndices * sizeof(std::uint16_t));
+				auto target = bytes.GetArray() + startSize;
+				for (unsigned i = 0; i < countIndices; i++, target += sizeof(std::uint16_t))
+				{
+					auto index = static_cast<std::uint16_t>(indices[i]);
+					memcpy(target, &index, sizeof(std::uint16_t));
+				}
+				break;
+			}
+			case IndexEncoding::Compressed:
+				EncodeCompressedIndices(indices, countIndices, bytes);
+				break;
+			default:
+				RaiseException("Unknown index encoding.");
+			}
+		}
+
+		const unsigned char* DecodeIndices(const unsigned char* bytes, const unsigned char* end,
+			IndexEncoding encoding, unsigned* indices, unsigned countIndices)
+		{
+			switch (encoding)
+			{
+			case IndexEncoding::Uint32:
+				CheckSize(bytes, end, countIndices * sizeof(unsigned));
+				memcpy(indices, bytes, countIndices * sizeof(unsigned));
+				return bytes + countIndices * sizeof(unsigned);
+			case IndexEncoding::Uint16:
+				CheckSize(bytes, end, countIndices * sizeof(std::uint16_t));
+				for (unsigned i = 0; i < countIndices; i++, bytes += sizeof(std::uint16_t))
+				{
+					std::uint16_t index;
+					memcpy(&index, bytes, sizeof(std::uint16_t));
+					indices[i] = index;
+				}
+				return bytes;
+			case IndexEncoding::Compressed:
+				return DecodeCompressedIndices(bytes, end, indices, countIndices);
+			default:
+				RaiseException("Unknown index encoding.");
+				return bytes;
+			}
+		}
+	}
+}
@@ -0,0 +1,47 @@
+// EngineBuildingBlocks/Graphics/Primitives/IndexCompression.h
+
+#ifndef _ENGINEBUILDINGBLOCKS_INDEXCOMPRESSION_H_INCLUDED_
+#define _ENGINEBUILDINGBLOCKS_INDEXCOMPRESSION_H_INCLUDED_
+
+#include <Core/DataStructures/SimpleTypeVector.hpp>
+
+#include <cstdint>
+
+namespace EngineBuildingBlocks
+{
+	namespace Graphics
+	{
+		const unsigned c_MaximumUint16Index = 0xffff;
+
+		enum class IndexEncoding : unsigned char
+		{
+			Uint32, Uint16,
+
+			// A variable length code in 7-bit groups. An index, which is the next unused vertex (the vertices
+			// are ordered by their first use after the vertex fetch optimization), is stored as 0, an index
+			// of the FIFO of the 16 recently added vertices is stored as its position, other indices are stored
+			// as the zigzag coded difference from the previous index. The indices of a cache optimized mesh
+			// take 1-1.5 bytes in average.
+			Compressed
+		};
+
+		unsigned GetMaximumIndex(const unsigned* indices, unsigned countIndices);
+
+		// Returns Uint16 if all indices fit to 16 bits, Uint32 otherwise.
+		IndexEncoding GetSmallestIndexEncoding(const unsigned* indices, unsigned countIndices);
+
+		// The indices must fit to 16 bits.
+		void ConvertIndicesToUint16(const unsigned* indices, unsigned countIndices, std::uint16_t* result);
+
+		// Appends the encoded indices to the byte vector. Throws if the indices don't fit to the encoding.
+		void EncodeIndices(const unsigned* indices, unsigned countIndices, IndexEncoding encoding,
+			Core::ByteVectorU& bytes);
+
+		// Decodes the given count of indices and returns the end of their encoded data.
+		// Throws if the data ends before the indices are decoded.
+		const unsigned char* DecodeIndices(const unsigned char* bytes, const unsigned char* end,
+			IndexEncoding encoding, unsigned* indices, unsigned countIndices);
+	}
+}
+
+#endif
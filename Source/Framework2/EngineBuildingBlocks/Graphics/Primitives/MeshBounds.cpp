@@ -0,0 +1,280 @@
+// EngineBuildingBlocks/Graphics/Primitives/MeshBounds.cpp
+
+#include <EngineBuildingBlocks/Graphics/Primitives/MeshBounds.h>
+
+#include <Core/System/ThreadPool.h>
+
+#include <xmmintrin.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace EngineBuildingBlocks;
+using namespace EngineBuildingBlocks::Graphics;
+using namespace EngineBuildingBlocks::Math;
+
+namespace
+{
+	// The vertex ranges are split to chunks for the threads.
+	const unsigned c_CountChunkVertices = 1 << 14;
+
+	// Loads 4 positions from 3 vectors: (x0 y0 z0 x1), (y1 z1 x2 y2), (z2 x3 y3 z3), and transposes them
+	// to the vectors of their coordinates.
+	inline void LoadTransposedPositions(const glm::vec3* positions, __m128& x, __m128& y, __m128& z)
+	{
+		auto data = reinterpret_cast<const float*>(positions);
+		__m128 v0 = _mm_loadu_ps(data);
+		__m128 v1 = _mm_loadu_ps(data + 4);
+		__m128 v2 = _mm_loadu_ps(data + 8);
+		x = _mm_shuffle_ps(v0, _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+		y = _mm_shuffle_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(0, 0, 1, 1)),
+			_mm_shuffle_ps(v1, v2, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+		z = _mm_shuffle_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 1, 2, 2)),
+			_mm_shuffle_ps(v2, v2, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+	}
+
+	inline float GetHorizontalMinimum(__m128 x)
+	{
+		x = _mm_min_ps(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 0, 3, 2)));
+		x = _mm_min_ps(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm_cvtss_f32(x);
+	}
+
+	inline float GetHorizontalMaximum(__m128 x)
+	{
+		x = _mm_max_ps(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 0, 3, 2)));
+		x = _mm_max_ps(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm_cvtss_f32(x);
+	}
+
+	// Computes 4 transformed coordinates: a0 * x + a1 * y + a2 * z + p.
+	inline __m128 TransformCoordinate(__m128 x, __m128 y, __m128 z, float a0, float a1, float a2, float p)
+	{
+		return _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(a0), x), _mm_mul_ps(_mm_set1_ps(a1), y)),
+			_mm_add_ps(_mm_mul_ps(_mm_set1_ps(a2), z), _mm_set1_ps(p)));
+	}
+
+	template <bool IsTransforming>
+	AABoundingBox ComputeBoundingBoxKernel(const glm::vec3* positions, unsigned countPositions,
+		const ScaledTransformation* transformation)
+	{
+		auto box = c_InvalidAABB;
+		unsigned countVectorized = countPositions & ~3U;
+		if (countVectorized > 0)
+		{
+			__m128 minimumX = _mm_set1_ps(std::numeric_limits<float>::max());
+			__m128 minimumY = minimumX, minimumZ = minimumX;
+			__m128 maximumX = _mm_set1_ps(-std::numeric_limits<float>::max());
+			__m128 maximumY = maximumX, maximumZ = maximumX;
+			for (unsigned i = 0; i < countVectorized; i += 4)
+			{
+				__m128 x, y, z;
+				LoadTransposedPositions(positions + i, x, y, z);
+				if (IsTransforming)
+				{
+					// The matrix is column-major.
+					auto& a = transformation->A;
+					auto& p = transformation->Position;
+					__m128 tx = TransformCoordinate(x, y, z, a[0][0], a[1][0], a[2][0], p.x);
+					__m128 ty = TransformCoordinate(x, y, z, a[0][1], a[1][1], a[2][1], p.y);
+					__m128 tz = TransformCoordinate(x, y, z, a[0][2], a[1][2], a[2][2], p.z);
+					x = tx; y = ty; z = tz;
+				}
+				minimumX = _mm_min_ps(minimumX, x); maximumX = _mm_max_ps(maximumX, x);
+				minimumY = _mm_min_ps(minimumY, y); maximumY = _mm_max_ps(maximumY, y);
+				minimumZ = _mm_min_ps(minimumZ, z); maximumZ = _mm_max_ps(maximumZ, z);
+			}
+			box.Minimum = glm::vec3(GetHorizontalMinimum(minimumX), GetHorizontalMinimum(minimumY),
+				GetHorizontalMinimum(minimumZ));
+			box.Maximum = glm::vec3(GetHorizontalMaximum(maximumX), GetHorizontalMaximum(maximumY),
+				GetHorizontalMaximum(maximumZ));
+		}
+		for (unsigned i = countVectorized; i < countPositions; i++)
+		{
+			auto position = (IsTransforming ? transformation->A * positions[i] + transformation->Position : positions[i]);
+			box.Minimum = glm::min(box.Minimum, position);
+			box.Maximum = glm::max(box.Maximum, position);
+		}
+		return box;
+	}
+
+	struct BoundsChunk
+	{
+		// The mesh or object index.
+		unsigned ItemIndex;
+
+		unsigned StartVertex;
+		unsigned EndVertex;
+	};
+
+	struct BoundsTask
+	{
+		const glm::vec3* Positions;
+		const BoundsChunk* Chunks;
+
+		// The transformations of the items for the transformed boxes.
+		const ScaledTransformation* Transformations;
+
+		// The sphere centers of the items for the radii.
+		const glm::vec3* Centers;
+
+		AABoundingBox* ChunkBoxes;
+		float* ChunkRadii;
+	};
+
+	void AddChunks(unsigned itemIndex, const MeshGeometryData& mesh, Core::SimpleTypeVectorU<BoundsChunk>& chunks)
+	{
+		unsigned endVertex = mesh.BaseVertex + mesh.CountVertices;
+		for (unsigned i = mesh.BaseVertex; i < endVertex; i += c_CountChunkVertices)
+		{
+			chunks.PushBack(BoundsChunk{ itemIndex, i, std::min(i + c_CountChunkVertices, endVertex) });
+		}
+	}
+
+	void ComputeChunkBoxes(unsigned threadIndex, unsigned startIndex, unsigned endIndex, const BoundsTask* task)
+	{
+		for (unsigned i = startIndex; i < endIndex; i++)
+		{
+			auto& chunk = task->Chunks[i];
+			auto positions = task->Positions + chunk.StartVertex;
+			unsigned countPositions = chunk.EndVertex - chunk.StartVertex;
+			task->ChunkBoxes[i] = (task->Transformations == nullptr
+				? ComputeBoundingBox(positions, countPositions)
+				: ComputeBoundingBox(positions, countPositions, task->Transformations[chunk.ItemIndex]));
+		}
+	}
+
+	void ComputeChunkRadii(unsigned threadIndex, unsigned startIndex, unsigned endIndex, const BoundsTask* task)
+	{
+		for (unsigned i = startIndex; i < endIndex; i++)
+		{
+			auto& chunk = task->Chunks[i];
+			task->ChunkRadii[i] = ComputeBoundingSphereRadius(task->Positions + chunk.StartVertex,
+				chunk.EndVertex - chunk.StartVertex, task->Centers[chunk.ItemIndex]);
+		}
+	}
+
+	void ExecuteChunks(void(*function)(unsigned, unsigned, unsigned, const BoundsTask*), const BoundsTask& task,
+		unsigned countChunks, Core::ThreadPool* threadPool)
+	{
+		if (threadPool != nullptr && countChunks > 1)
+		{
+			threadPool->ExecuteWithStaticScheduling(countChunks, function, &task);
+		}
+		else
+		{
+			function(0, 0, countChunks, &task);
+		}
+	}
+
+	void ReduceChunkBoxes(const Core::SimpleTypeVectorU<BoundsChunk>& chunks, const AABoundingBox* chunkBoxes,
+		AABoundingBox* boxes, unsigned countItems)
+	{
+		std::fill(boxes, boxes + countItems, c_InvalidAABB);
+		for (unsigned i = 0; i < chunks.GetSize(); i++)
+		{
+			auto& box = boxes[chunks[i].ItemIndex];
+			box = AABoundingBox::Union(box, chunkBoxes[i]);
+		}
+	}
+}
+
+namespace EngineBuildingBlocks
+{
+	namespace Graphics
+	{
+		AABoundingBox ComputeBoundingBox(const glm::vec3* positions, unsigned countPositions)
+		{
+			return ComputeBoundingBoxKernel<false>(positions, countPositions, nullptr);
+		}
+
+		AABoundingBox ComputeBoundingBox(const glm::vec3* positions, unsigned countPositions,
+			const ScaledTransformation& transformation)
+		{
+			return ComputeBoundingBoxKernel<true>(positions, countPositions, &transformation);
+		}
+
+		float ComputeBoundingSphereRadius(const glm::vec3* positions, unsigned countPositions, const glm::vec3& center)
+		{
+			float maximumDistance = 0.0f;
+			unsigned countVectorized = countPositions & ~3U;
+			if (countVectorized > 0)
+			{
+				__m128 centerX = _mm_set1_ps(center.x);
+				__m128 centerY = _mm_set1_ps(center.y);
+				__m128 centerZ = _mm_set1_ps(center.z);
+				__m128 maximum = _mm_setzero_ps();
+				for (unsigned i = 0; i < countVectorized; i += 4)
+				{
+					__m128 x, y, z;
+					LoadTransposedPositions(positions + i, x, y, z);
+					x = _mm_sub_ps(x, centerX);
+					y = _mm_sub_ps(y, centerY);
+					z = _mm_sub_ps(z, centerZ);
+					maximum = _mm_max_ps(maximum,
+						_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+				}
+				maximumDistance = GetHorizontalMaximum(maximum);
+			}
+			for (unsigned i = countVectorized; i < countPositions; i++)
+			{
+				auto difference = positions[i] - center;
+				maximumDistance = std::max(maximumDistance, glm::dot(difference, difference));
+			}
+			return std::sqrt(maximumDistance);
+		}
+
+		void ComputeMeshBounds(const glm::vec3* positions, const MeshGeometryData* meshes, unsigned countMeshes,
+			Core::SimpleTypeVectorU<MeshBounds>& meshBounds, Core::ThreadPool* threadPool)
+		{
+			meshBounds.Resize(countMeshes);
+
+			Core::SimpleTypeVectorU<BoundsChunk> chunks;
+			for (unsigned i = 0; i < countMeshes; i++) AddChunks(i, meshes[i], chunks);
+			unsigned countChunks = chunks.GetSize();
+
+			Core::SimpleTypeVectorU<AABoundingBox> chunkBoxes(countChunks);
+			Core::SimpleTypeVectorU<AABoundingBox> boxes(countMeshes);
+			BoundsTask boxTask{ positions, chunks.GetArray(), nullptr, nullptr, chunkBoxes.GetArray(), nullptr };
+			ExecuteChunks(&ComputeChunkBoxes, boxTask, countChunks, threadPool);
+			ReduceChunkBoxes(chunks, chunkBoxes.GetArray(), boxes.GetArray(), countMeshes);
+
+			// The radii are computed in a second pass, since the centers are known from the boxes.
+			Core::SimpleTypeVectorU<glm::vec3> centers(countMeshes);
+			for (unsigned i = 0; i < countMeshes; i++)
+			{
+				centers[i] = (boxes[i].IsValid() ? boxes[i].GetCenter() : glm::vec3(0.0f));
+			}
+			Core::SimpleTypeVectorU<float> chunkRadii(countChunks);
+			BoundsTask radiusTask{ positions, chunks.GetArray(), nullptr, centers.GetArray(), nullptr, chunkRadii.GetArray() };
+			ExecuteChunks(&ComputeChunkRadii, radiusTask, countChunks, threadPool);
+
+			for (unsigned i = 0; i < countMeshes; i++)
+			{
+				meshBounds[i] = MeshBounds{ boxes[i], centers[i], 0.0f };
+			}
+			for (unsigned i = 0; i < countChunks; i++)
+			{
+				auto& radius = meshBounds[chunks[i].ItemIndex].SphereRadius;
+				radius = std::max(radius, chunkRadii[i]);
+			}
+		}
+
+		void ComputeTransformedMeshBoxes(const glm::vec3* positions, const MeshGeometryData* meshes,
+			const unsigned* objectMeshIndices, const ScaledTransformation* objectTransformations, unsigned countObjects,
+			Core::SimpleTypeVectorU<AABoundingBox>& objectBoxes, Core::ThreadPool* threadPool)
+		{
+			objectBoxes.Resize(countObjects);
+
+			Core::SimpleTypeVectorU<BoundsChunk> chunks;
+			for (unsigned i = 0; i < countObjects; i++) AddChunks(i, meshes[objectMeshIndices[i]], chunks);
+			unsigned countChunks = chunks.GetSize();
+
+			Core::SimpleTypeVectorU<AABoundingBox> chunkBoxes(countChunks);
+			BoundsTask task{ positions, chunks.GetArray(), objectTransformations, nullptr, chunkBoxes.GetArray(), nullptr };
+			ExecuteChunks(&ComputeChunkBoxes, task, countChunks, threadPool);
+			ReduceChunkBoxes(chunks, chunkBoxes.GetArray(), objectBoxes.GetArray(), countObjects);
+		}
+	}
+}
@@ -0,0 +1,61 @@
+// EngineBuildingBlocks/Graphics/Primitives/MeshBounds.h
+
+#ifndef _ENGINEBUILDINGBLOCKS_MESHBOUNDS_H_INCLUDED_
+#define _ENGINEBUILDINGBLOCKS_MESHBOUNDS_H_INCLUDED_
+
+#include <Core/DataStructures/SimpleTypeVector.hpp>
+#include <Core/SimpleBinarySerialization.hpp>
+#include <EngineBuildingBlocks/Graphics/Primitives/Primitive.h>
+#include <EngineBuildingBlocks/Math/AABoundingBox.h>
+#include <EngineBuildingBlocks/Math/GLM.h>
+#include <EngineBuildingBlocks/Math/Transformations.h>
+
+namespace Core
+{
+	class ThreadPool;
+}
+
+namespace EngineBuildingBlocks
+{
+	namespace Graphics
+	{
+		// The bounding volumes of a mesh in its local space.
+		struct MeshBounds
+		{
+			EngineBuildingBlocks::Math::AABoundingBox Box;
+
+			// The sphere is centered at the center of the box.
+			glm::vec3 SphereCenter;
+			float SphereRadius;
+		};
+
+		// The vectorized kernels process the positions in groups of 4, which are transposed to coordinate vectors.
+		// An empty position range results in c_InvalidAABB and zero radius.
+
+		EngineBuildingBlocks::Math::AABoundingBox ComputeBoundingBox(const glm::vec3* positions, unsigned countPositions);
+
+		// Returns the bounding box of the transformed positions.
+		EngineBuildingBlocks::Math::AABoundingBox ComputeBoundingBox(const glm::vec3* positions, unsigned countPositions,
+			const ScaledTransformation& transformation);
+
+		// Returns the largest distance of the positions from the center.
+		float ComputeBoundingSphereRadius(const glm::vec3* positions, unsigned countPositions, const glm::vec3& center);
+
+		// The vertices of all meshes are split to uniform chunks, thus huge meshes are processed in parallel too
+		// if a thread pool is given. The partial results of the chunks are reduced on the calling thread.
+
+		void ComputeMeshBounds(const glm::vec3* positions, const MeshGeometryData* meshes, unsigned countMeshes,
+			Core::SimpleTypeVectorU<MeshBounds>& meshBounds, Core::ThreadPool* threadPool = nullptr);
+
+		// Computes the bounding box of each object from the positions of its mesh, which are transformed
+		// with the object's transformation.
+		void ComputeTransformedMeshBoxes(const glm::vec3* positions, const MeshGeometryData* meshes,
+			const unsigned* objectMeshIndices, const ScaledTransformation* objectTransformations, unsigned countObjects,
+			Core::SimpleTypeVectorU<EngineBuildingBlocks::Math::AABoundingBox>& objectBoxes,
+			Core::ThreadPool* threadPool = nullptr);
+	}
+}
+
+CORE_BITWISE_SERIALIZABLE_SB(EngineBuildingBlocks::Graphics::MeshBounds)
+
+#endif
@@ -0,0 +1,670 @@
+// EngineBuildingBlocks/Graphics/Primitives/MeshOptimization.cpp
+
+#include <EngineBuildingBlocks/Graphics/Primitives/MeshOptimization.h>
+
+#include <Core/Checksum.h>
+#include <Core/Comparison.h>
+#include <Core/Constants.h>
+#include <EngineBuildingBlocks/ErrorHandling.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+using namespace EngineBuildingBlocks;
+using namespace EngineBuildingBlocks::Graphics;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+MeshOptimizationOptionsType::MeshOptimizationOptionsType(bool isOptimizing)
+	: IsWeldingVertices(isOptimizing)
+	, IsOptimizingVertexCache(isOptimizing)
+	, IsOptimizingOverdraw(isOptimizing)
+	, IsOptimizingVertexFetch(isOptimizing)
+	, OverdrawThreshold(1.05f)
+{
+}
+
+bool MeshOptimizationOptionsType::operator==(const MeshOptimizationOptionsType& other) const
+{
+	BoolEqualCompareBlock(IsWeldingVertices);
+	BoolEqualCompareBlock(IsOptimizingVertexCache);
+	BoolEqualCompareBlock(IsOptimizingOverdraw);
+	BoolEqualCompareBlock(IsOptimizingVertexFetch);
+	NumericalEqualCompareBlock(OverdrawThreshold);
+	return true;
+}
+
+bool MeshOptimizationOptionsType::operator!=(const MeshOptimizationOptionsType& other) const
+{
+	return !(*this == other);
+}
+
+bool MeshOptimizationOptionsType::operator<(const MeshOptimizationOptionsType& other) const
+{
+	BoolLessCompareBlock(IsWeldingVertices);
+	BoolLessCompareBlock(IsOptimizingVertexCache);
+	BoolLessCompareBlock(IsOptimizingOverdraw);
+	BoolLessCompareBlock(IsOptimizingVertexFetch);
+	NumericalLessCompareBlock(OverdrawThreshold);
+	return false;
+}
+
+void MeshOptimizationOptionsType::SerializeSB(Core::ByteVector& bytes) const
+{
+	Core::SerializeSB(bytes, IsWeldingVertices);
+	Core::SerializeSB(bytes, IsOptimizingVertexCache);
+	Core::SerializeSB(bytes, IsOptimizingOverdraw);
+	Core::SerializeSB(bytes, IsOptimizingVertexFetch);
+	Core::SerializeSB(bytes, OverdrawThreshold);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	// A FIFO cache: a vertex is in the cache if it was transformed at most 'cacheSize' transformations ago.
+	class FIFOVertexCache
+	{
+		Core::IndexVectorU m_Timestamps;
+		unsigned m_CacheSize;
+		unsigned m_Timestamp;
+
+	public:
+
+		FIFOVertexCache(unsigned countVertices, unsigned cacheSize)
+			: m_CacheSize(cacheSize)
+			, m_Timestamp(cacheSize + 1)
+		{
+			m_Timestamps.Resize(countVertices);
+			m_Timestamps.SetByte(0);
+		}
+
+		void Flush()
+		{
+			m_Timestamp += m_CacheSize + 1;
+		}
+
+		// Returns the count of the cache misses.
+		unsigned ProcessTriangle(const unsigned* triangle)
+		{
+			unsigned countMisses = 0;
+			for (unsigned i = 0; i < 3; i++)
+			{
+				auto& timestamp = m_Timestamps[triangle[i]];
+				if (m_Timestamp - timestamp > m_CacheSize)
+				{
+					timestamp = m_Timestamp++;
+					++countMisses;
+				}
+			}
+			return countMisses;
+		}
+	};
+
+	///////////////////////////////////// VERTEX CACHE /////////////////////////////////////
+
+	// Tom Forsyth: Linear-Speed Vertex Cache Optimisation. The vertices are scored by their position
+	// in a simulated LRU cache and by their count of remaining triangles. The next triangle is the best scored
+	// triangle of the cached vertices, which makes the algorithm linear.
+	const unsigned c_ForsythCacheSize = 32;
+	const unsigned c_ForsythMaxValence = 32;
+	const float c_ForsythLastTriangleScore = 0.75f;
+	const float c_ForsythCacheDecayPower = 1.5f;
+	const float c_ForsythValenceBoostScale = 2.0f;
+	const float c_ForsythValenceBoostPower = 0.5f;
+
+	struct ForsythScoreTable
+	{
+		float CacheScores[c_ForsythCacheSize];
+		float ValenceScores[c_ForsythMaxValence + 1];
+
+		ForsythScoreTable()
+		{
+			for (unsigned i = 0; i < c_ForsythCacheSize; i++)
+			{
+				// The vertices of the last triangle get a fixed score, so the algorithm doesn't prefer
+				// the triangles which use them again.
+				if (i < 3) CacheScores[i] = c_ForsythLastTriangleScore;
+				else
+				{
+					float scaler = 1.0f / (c_ForsythCacheSize - 3);
+					CacheScores[i] = std::pow(1.0f - (i - 3) * scaler, c_ForsythCacheDecayPower);
+				}
+			}
+			ValenceScores[0] = 0.0f;
+			for (unsigned i = 1; i <= c_ForsythMaxValence; i++)
+			{
+				ValenceScores[i] = c_ForsythValenceBoostScale * std::pow(static_cast<float>(i), -c_ForsythValenceBoostPower);
+			}
+		}
+
+		float GetVertexScore(unsigned cachePosition, unsigned countRemainingTriangles) const
+		{
+			// A vertex without remaining triangles can't improve any triangle.
+			if (countRemainingTriangles == 0) return -1.0f;
+			float score = (cachePosition < c_ForsythCacheSize ? CacheScores[cachePosition] : 0.0f);
+			return score + ValenceScores[std::min(countRemainingTriangles, c_ForsythMaxValence)];
+		}
+	};
+
+	///////////////////////////////////// OVERDRAW /////////////////////////////////////
+
+	// Splits the triangles to clusters where the cache is flushed, i.e. all vertices of a triangle are missing.
+	void GenerateHardBoundaries(const unsigned* indices, unsigned countTriangles, unsigned countVertices,
+		Core::IndexVectorU& boundaries)
+	{
+		FIFOVertexCache cache(countVertices, c_DefaultVertexCacheSize);
+		for (unsigned i = 0; i < countTriangles; i++)
+		{
+			if (cache.ProcessTriangle(indices + i * 3) == 3) boundaries.PushBack(i);
+		}
+	}
+
+	// Splits the hard clusters further where the ACMR of the subcluster is not higher
+	// than the ACMR of the cluster multiplied with the threshold.
+	void GenerateSoftBoundaries(const unsigned* indices, unsigned countTriangles, unsigned countVertices,
+		const Core::IndexVectorU& hardBoundaries, float threshold, Core::IndexVectorU& boundaries)
+	{
+		FIFOVertexCache cache(countVertices, c_DefaultVertexCacheSize);
+		unsigned countHardBoundaries = hardBoundaries.GetSize();
+		for (unsigned i = 0; i < countHardBoundaries; i++)
+		{
+			unsigned start = hardBoundaries[i];
+			unsigned end = (i + 1 < countHardBoundaries ? hardBoundaries[i + 1] : countTriangles);
+
+			cache.Flush();
+			unsigned countClusterMisses = 0;
+			for (unsigned j = start; j < end; j++) countClusterMisses += cache.ProcessTriangle(indices + j * 3);
+			float clusterThreshold = threshold * countClusterMisses / (end - start);
+
+			boundaries.PushBack(start);
+			cache.Flush();
+			unsigned countMisses = 0, countSubclusterTriangles = 0;
+			for (unsigned j = start; j < end; j++)
+			{
+				countMisses += cache.ProcessTriangle(indices + j * 3);
+				++countSubclusterTriangles;
+				if (static_cast<float>(countMisses) / countSubclusterTriangles <= clusterThreshold && j + 1 < end)
+				{
+					boundaries.PushBack(j + 1);
+					cache.Flush();
+					countMisses = 0;
+					countSubclusterTriangles = 0;
+				}
+			}
+		}
+	}
+
+	///////////////////////////////////// VERTEX DATA /////////////////////////////////////
+
+	// Maps every vertex of the mesh to the first vertex, which is bitwise equal to it.
+	void GenerateWeldingRemap(const Vertex_SOA_Data& vertexData, const MeshGeometryData& mesh,
+		Core::IndexVectorU& remap)
+	{
+		unsigned countVertices = mesh.CountVertices;
+		remap.Resize(countVertices);
+		if (countVertices == 0) return;
+
+		auto& elements = vertexData.InputLayout.Elements;
+		unsigned countElements = static_cast<unsigned>(elements.size());
+		Core::SimpleTypeVectorU<const unsigned char*> arrays;
+		Core::IndexVectorU elementSizes;
+		for (unsigned i = 0; i < countElements; i++)
+		{
+			unsigned elementSize = elements[i].GetTotalSize();
+			arrays.PushBack(vertexData.Data[i].GetArray() + mesh.BaseVertex * elementSize);
+			elementSizes.PushBack(elementSize);
+		}
+		auto isEqual = [&](unsigned vertex1, unsigned vertex2) {
+			for (unsigned i = 0; i < countElements; i++)
+			{
+				unsigned elementSize = elementSizes[i];
+				if (memcmp(arrays[i] + vertex1 * elementSize, arrays[i] + vertex2 * elementSize, elementSize) != 0)
+					return false;
+			}
+			return true;
+		};
+
+		// Open addressing hash table with linear probing, with at most 50% load.
+		unsigned tableSize = 1;
+		while (tableSize < countVertices * 2) tableSize *= 2;
+		Core::IndexVectorU table;
+		table.Resize(tableSize);
+		table.SetByte(0xff);
+		for (unsigned i = 0; i < countVertices; i++)
+		{
+			std::uint64_t hashValue = 0;
+			for (unsigned j = 0; j < countElements; j++)
+			{
+				hashValue = Core::ComputeHash64(arrays[j] + i * elementSizes[j], elementSizes[j], hashValue);
+			}
+			for (unsigned k = static_cast<unsigned>(hashValue) & (tableSize - 1);; k = (k + 1) & (tableSize - 1))
+			{
+				if (table[k] == Core::c_InvalidIndexU)
+				{
+					table[k] = i;
+					remap[i] = i;
+					break;
+				}
+				if (isEqual(table[k], i))
+				{
+					remap[i] = table[k];
+					break;
+				}
+			}
+		}
+	}
+
+	// Moves the vertices of the meshes to new positions and removes the vertices with invalid new index.
+	// The meshes are stored successively in the result.
+	void RemapVertices(Vertex_SOA_Data& vertexData, MeshGeometryData* meshes, unsigned countMeshes,
+		const Core::IndexVectorU* localRemaps, const unsigned* countNewVertices, Core::IndexVectorU* vertexRemap)
+	{
+		auto& elements = vertexData.InputLayout.Elements;
+		unsigned countElements = static_cast<unsigned>(elements.size());
+		unsigned countOldVertices = vertexData.GetCountVertices();
+		unsigned countAllNewVertices = 0;
+		for (unsigned i = 0; i < countMeshes; i++) countAllNewVertices += countNewVertices[i];
+
+		if (vertexRemap != nullptr)
+		{
+			vertexRemap->Resize(countOldVertices);
+			vertexRemap->SetByte(0xff);
+		}
+
+		std::vector<Core::ByteVectorU> newData(countElements);
+		for (unsigned i = 0; i < countElements; i++)
+		{
+			unsigned elementSize = elements[i].GetTotalSize();
+			auto& source = vertexData.Data[i];
+			auto& target = newData[i];
+			target.Resize(countAllNewVertices * elementSize);
+			for (unsigned j = 0, newBaseVertex = 0; j < countMeshes; j++)
+			{
+				auto& mesh = meshes[j];
+				auto& remap = localRemaps[j];
+				auto pSource = source.GetArray() + mesh.BaseVertex * elementSize;
+				auto pTarget = target.GetArray() + newBaseVertex * elementSize;
+				for (unsigned k = 0; k < mesh.CountVertices; k++)
+				{
+					if (remap[k] != Core::c_InvalidIndexU)
+					{
+						memcpy(pTarget + remap[k] * elementSize, pSource + k * elementSize, elementSize);
+					}
+				}
+				newBaseVertex += countNewVertices[j];
+			}
+		}
+		vertexData.Data = std::move(newData);
+
+		for (unsigned j = 0, newBaseVertex = 0; j < countMeshes; j++)
+		{
+			auto& mesh = meshes[j];
+			auto& remap = localRemaps[j];
+			if (vertexRemap != nullptr)
+			{
+				for (unsigned k = 0; k < mesh.CountVertices; k++)
+				{
+					if (remap[k] != Core::c_InvalidIndexU) (*vertexRemap)[mesh.BaseVertex + k] = newBaseVertex + remap[k];
+				}
+			}
+			mesh.BaseVertex = newBaseVertex;
+			mesh.CountVertices = countNewVertices[j];
+			newBaseVertex += countNewVertices[j];
+		}
+	}
+
+	void AddStatistics(VertexCacheStatistics& target, const VertexCacheStatistics& source)
+	{
+		target.CountVertices += source.CountVertices;
+		target.CountTriangles += source.CountTriangles;
+		target.CountTransformedVertices += source.CountTransformedVertices;
+	}
+
+	void ComputeRatios(VertexCacheStatistics& statistics)
+	{
+		float countTransformedVertices = static_cast<float>(statistics.CountTransformedVertices);
+		statistics.ACMR = (statistics.CountTriangles > 0 ? countTransformedVertices / statistics.CountTriangles : 0.0f);
+		statistics.ATVR = (statistics.CountVertices > 0 ? countTransformedVertices / statistics.CountVertices : 0.0f);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace EngineBuildingBlocks
+{
+	namespace Graphics
+	{
+		VertexCacheStatistics AnalyzeVertexCache(const unsigned* indices, unsigned countIndices,
+			unsigned countVertices, unsigned cacheSize)
+		{
+			VertexCacheStatistics statistics = {};
+			statistics.CountTriangles = countIndices / 3;
+
+			FIFOVertexCache cache(countVertices, cacheSize);
+			Core::ByteVectorU isReferenced;
+			isReferenced.Resize(countVertices);
+			isReferenced.SetByte(0);
+			for (unsigned i = 0; i < statistics.CountTriangles; i++)
+			{
+				auto triangle = indices + i * 3;
+				statistics.CountTransformedVertices += cache.ProcessTriangle(triangle);
+				for (unsigned j = 0; j < 3; j++)
+				{
+					assert(triangle[j] < countVertices);
+					if (isReferenced[triangle[j]] == 0)
+					{
+						isReferenced[triangle[j]] = 1;
+						++statistics.CountVertices;
+					}
+				}
+			}
+			ComputeRatios(statistics);
+			return statistics;
+		}
+
+		void OptimizeVertexCache(unsigned* indices, unsigned countIndices, unsigned countVertices)
+		{
+			static const ForsythScoreTable scoreTable;
+
+			unsigned countTriangles = countIndices / 3;
+			if (countTriangles < 2) return;
+
+			// Creating the triangle adjacency of the vertices. The first 'countRemainingTriangles'
+			// triangles of a vertex are not emitted yet.
+			Core::IndexVectorU countRemainingTriangles, adjacencyOffsets, adjacency;
+			countRemainingTriangles.Resize(countVertices);
+			countRemainingTriangles.SetByte(0);
+			for (unsigned i = 0; i < countTriangles * 3; i++) ++countRemainingTriangles[indices[i]];
+			adjacencyOffsets.Resize(countVertices);
+			for (unsigned i = 0, offset = 0; i < countVertices; i++)
+			{
+				adjacencyOffsets[i] = offset;
+				offset += countRemainingTriangles[i];
+			}
+			adjacency.Resize(countTriangles * 3);
+			{
+				Core::IndexVectorU fillCounts;
+				fillCounts.Resize(countVertices);
+				fillCounts.SetByte(0);
+				for (unsigned i = 0; i < countTriangles * 3; i++)
+				{
+					unsigned vertex = indices[i];
+					adjacency[adjacencyOffsets[vertex] + fillCounts[vertex]++] = i / 3;
+				}
+			}
+
+			// Computing the initial scores.
+			Core::SimpleTypeVectorU<float> vertexScores, triangleScores;
+			vertexScores.Resize(countVertices);
+			triangleScores.Resize(countTriangles);
+			for (unsigned i = 0; i < countVertices; i++)
+			{
+				vertexScores[i] = scoreTable.GetVertexScore(Core::c_InvalidIndexU, countRemainingTriangles[i]);
+			}
+			unsigned bestTriangle = 0;
+			for (unsigned i = 0; i < countTriangles; i++)
+			{
+				auto triangle = indices + i * 3;
+				triangleScores[i] = vertexScores[triangle[0]] + vertexScores[triangle[1]] + vertexScores[triangle[2]];
+				if (triangleScores[i] > triangleScores[bestTriangle]) bestTriangle = i;
+			}
+
+			Core::IndexVectorU sourceIndices;
+			sourceIndices.PushBack(indices, countTriangles * 3);
+			Core::ByteVectorU isEmitted;
+			isEmitted.Resize(countTriangles);
+			isEmitted.SetByte(0);
+
+			unsigned cache[c_ForsythCacheSize + 3];
+			unsigned cacheSize = 0;
+			unsigned inputCursor = 0;
+			for (unsigned emittedCount = 0; emittedCount < countTriangles; emittedCount++)
+			{
+				// If no cached vertex has remaining triangles, continuing with the next triangle in input order.
+				if (bestTriangle == Core::c_InvalidIndexU)
+				{
+					while (isEmitted[inputCursor] != 0) ++inputCursor;
+					bestTriangle = inputCursor;
+				}
+
+				auto triangle = sourceIndices.GetArray() + bestTriangle * 3;
+				memcpy(indices + emittedCount * 3, triangle, 3 * sizeof(unsigned));
+				isEmitted[bestTriangle] = 1;
+
+				// Removing the triangle from the remaining triangles of its vertices.
+				for (unsigned i = 0; i < 3; i++)
+				{
+					unsigned vertex = triangle[i];
+					auto vertexTriangles = adjacency.GetArray() + adjacencyOffsets[vertex];
+					unsigned& countVertexTriangles = countRemainingTriangles[vertex];
+					for (unsigned j = 0; j < countVertexTriangles; j++)
+					{
+						if (vertexTriangles[j] == bestTriangle)
+						{
+							vertexTriangles[j] = vertexTriangles[--countVertexTriangles];
+							break;
+						}
+					}
+				}
+
+				// Moving the vertices of the triangle to the front of the LRU cache.
+				unsigned newCache[c_ForsythCacheSize + 3];
+				unsigned newCacheSize = 0;
+				for (unsigned i = 0; i < 3; i++)
+				{
+					if (std::find(newCache, newCache + newCacheSize, triangle[i]) == newCache + newCacheSize)
+						newCache[newCacheSize++] = triangle[i];
+				}
+				for (unsigned i = 0; i < cacheSize; i++)
+				{
+					unsigned vertex = cache[i];
+					if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+						newCache[newCacheSize++] = vertex;
+				}
+
+				// Updating the scores of the vertices, which were in the cache, including the evicted ones.
+				for (unsigned i = 0; i < newCacheSize; i++)
+				{
+					unsigned vertex = newCache[i];
+					unsigned cachePosition = (i < c_ForsythCacheSize ? i : Core::c_InvalidIndexU);
+					vertexScores[vertex] = scoreTable.GetVertexScore(cachePosition, countRemainingTriangles[vertex]);
+				}
+
+				// Updating the scores of the affected triangles and finding the best one.
+				bestTriangle = Core::c_InvalidIndexU;
+				float bestScore = -1.0f;
+				for (unsigned i = 0; i < newCacheSize; i++)
+				{
+					unsigned vertex = newCache[i];
+					auto vertexTriangles = adjacency.GetArray() + adjacencyOffsets[vertex];
+					for (unsigned j = 0; j < countRemainingTriangles[vertex]; j++)
+					{
+						unsigned triangleIndex = vertexTriangles[j];
+						auto adjacentTriangle = sourceIndices.GetArray() + triangleIndex * 3;
+						float score = vertexScores[adjacentTriangle[0]] + vertexScores[adjacentTriangle[1]]
+							+ vertexScores[adjacentTriangle[2]];
+						triangleScores[triangleIndex] = score;
+						if (score > bestScore)
+						{
+							bestScore = score;
+							bestTriangle = triangleIndex;
+						}
+					}
+				}
+
+				cacheSize = std::min(newCacheSize, c_ForsythCacheSize);
+				memcpy(cache, newCache, cacheSize * sizeof(unsigned));
+			}
+		}
+
+		// Sander, Nehab, Barczak: Fast Triangle Reordering for Vertex Locality and Reduced Overdraw.
+		// The cache-optimized triangles are split to clusters, and the clusters are sorted by the dot product
+		// of their normal and their centroid's offset from the mesh centroid, so the outer surfaces, which are
+		// likely to occlude the others, are drawn first.
+		void OptimizeOverdraw(unsigned* indices, unsigned countIndices, const glm::vec3* positions,
+			unsigned countVertices, float threshold)
+		{
+			unsigned countTriangles = countIndices / 3;
+			if (countTriangles < 2) return;
+
+			Core::IndexVectorU hardBoundaries, boundaries;
+			GenerateHardBoundaries(indices, countTriangles, countVertices, hardBoundaries);
+			GenerateSoftBoundaries(indices, countTriangles, countVertices, hardBoundaries, threshold, boundaries);
+			unsigned countClusters = boundaries.GetSize();
+			if (countClusters < 2) return;
+
+			glm::vec3 meshCentroid(0.0f);
+			for (unsigned i = 0; i < countTriangles * 3; i++) meshCentroid += positions[indices[i]];
+			meshCentroid /= static_cast<float>(countTriangles * 3);
+
+			Core::SimpleTypeVectorU<float> sortKeys;
+			sortKeys.Resize(countClusters);
+			for (unsigned i = 0; i < countClusters; i++)
+			{
+				unsigned start = boundaries[i];
+				unsigned end = (i + 1 < countClusters ? boundaries[i + 1] : countTriangles);
+
+				// The triangles are weighted by their area.
+				glm::vec3 centroid(0.0f), normal(0.0f);
+				float area = 0.0f;
+				for (unsigned j = start; j < end; j++)
+				{
+					auto& p0 = positions[indices[j * 3]];
+					auto& p1 = positions[indices[j * 3 + 1]];
+					auto& p2 = positions[indices[j * 3 + 2]];
+					auto triangleNormal = glm::cross(p1 - p0, p2 - p0);
+					float triangleArea = glm::length(triangleNormal);
+					centroid += (p0 + p1 + p2) * (triangleArea / 3.0f);
+					normal += triangleNormal;
+					area += triangleArea;
+				}
+				if (area > 0.0f) centroid /= area;
+				float normalLength = glm::length(normal);
+				if (normalLength > 0.0f) normal /= normalLength;
+				sortKeys[i] = glm::dot(centroid - meshCentroid, normal);
+			}
+
+			Core::IndexVectorU clusterOrder;
+			clusterOrder.Resize(countClusters);
+			for (unsigned i = 0; i < countClusters; i++) clusterOrder[i] = i;
+			std::stable_sort(clusterOrder.GetArray(), clusterOrder.GetArray() + countClusters,
+				[&sortKeys](unsigned a, unsigned b) { return sortKeys[a] > sortKeys[b]; });
+
+			Core::IndexVectorU sourceIndices;
+			sourceIndices.PushBack(indices, countTriangles * 3);
+			auto target = indices;
+			for (unsigned i = 0; i < countClusters; i++)
+			{
+				unsigned cluster = clusterOrder[i];
+				unsigned start = boundaries[cluster];
+				unsigned end = (cluster + 1 < countClusters ? boundaries[cluster + 1] : countTriangles);
+				unsigned countClusterIndices = (end - start) * 3;
+				memcpy(target, sourceIndices.GetArray() + start * 3, countClusterIndices * sizeof(unsigned));
+				target += countClusterIndices;
+			}
+		}
+
+		MeshOptimizationStatistics OptimizeMesh(Vertex_SOA_Data& vertexData, IndexData& indexData,
+			const MeshOptimizationOptionsType& options)
+		{
+			MeshGeometryData mesh = { vertexData.GetCountVertices(), indexData.GetCountIndices(), 0, 0 };
+			return OptimizeMeshes(vertexData, indexData, &mesh, 1, options);
+		}
+
+		MeshOptimizationStatistics OptimizeMeshes(Vertex_SOA_Data& vertexData, IndexData& indexData,
+			MeshGeometryData* meshes, unsigned countMeshes, const MeshOptimizationOptionsType& options,
+			Core::IndexVectorU* vertexRemap)
+		{
+			if (indexData.Topology != PrimitiveTopology::TriangleList)
+				RaiseException("Only triangle lists can be optimized.");
+
+			MeshOptimizationStatistics statistics = {};
+			bool isOptimizingOverdraw = (options.IsOptimizingOverdraw && vertexData.InputLayout.HasPositions());
+			auto positions = (isOptimizingOverdraw ? vertexData.GetPositions() : nullptr);
+			bool isRemappingVertices = (options.IsWeldingVertices || options.IsOptimizingVertexFetch);
+			std::vector<Core::IndexVectorU> localRemaps(isRemappingVertices ? countMeshes : 0);
+			Core::IndexVectorU countNewVertices;
+			countNewVertices.Resize(countMeshes);
+			for (unsigned i = 0; i < countMeshes; i++)
+			{
+				auto& mesh = meshes[i];
+				auto indices = indexData.Data.GetArray() + mesh.BaseIndex;
+				unsigned countIndices = mesh.CountIndices;
+				unsigned countVertices = mesh.CountVertices;
+
+				auto before = AnalyzeVertexCache(indices, countIndices, countVertices);
+				AddStatistics(statistics.Before, before);
+
+				// Welding before the triangle reordering, so the welded vertices are shared by the cache.
+				if (options.IsWeldingVertices)
+				{
+					auto& remap = localRemaps[i];
+					GenerateWeldingRemap(vertexData, mesh, remap);
+					for (unsigned j = 0; j < countIndices; j++) indices[j] = remap[indices[j]];
+				}
+
+				if (options.IsOptimizingVertexCache) OptimizeVertexCache(indices, countIndices, countVertices);
+				if (isOptimizingOverdraw)
+				{
+					OptimizeOverdraw(indices, countIndices, positions + mesh.BaseVertex, countVertices,
+						options.OverdrawThreshold);
+				}
+
+				// Creating the new order of the vertices: the order of the first use, or the original order.
+				// The unused vertices are removed.
+				if (isRemappingVertices)
+				{
+					auto& remap = localRemaps[i];
+					remap.Resize(countVertices);
+					remap.SetByte(0xff);
+					unsigned countUsedVertices = 0;
+					if (options.IsOptimizingVertexFetch)
+					{
+						for (unsigned j = 0; j < countIndices; j++)
+						{
+							if (remap[indices[j]] == Core::c_InvalidIndexU) remap[indices[j]] = countUsedVertices++;
+						}
+					}
+					else
+					{
+						for (unsigned j = 0; j < countIndices; j++) remap[indices[j]] = 0;
+						for (unsigned j = 0; j < countVertices; j++)
+						{
+							if (remap[j] != Core::c_InvalidIndexU) remap[j] = countUsedVertices++;
+						}
+					}
+					for (unsigned j = 0; j < countIndices; j++) indices[j] = remap[indices[j]];
+					countNewVertices[i] = countUsedVertices;
+				}
+				else
+				{
+					countNewVertices[i] = countVertices;
+				}
+
+				auto after = AnalyzeVertexCache(indices, countIndices, countNewVertices[i]);
+				AddStatistics(statistics.After, after);
+			}
+
+			if (isRemappingVertices)
+			{
+				RemapVertices(vertexData, meshes, countMeshes, localRemaps.data(), countNewVertices.GetArray(), vertexRemap);
+			}
+			else if (vertexRemap != nullptr)
+			{
+				unsigned countVertices = vertexData.GetCountVertices();
+				vertexRemap->Resize(countVertices);
+				for (unsigned i = 0; i < countVertices; i++) (*vertexRemap)[i] = i;
+			}
+
+			ComputeRatios(statistics.Before);
+			ComputeRatios(statistics.After);
+			return statistics;
+		}
+	}
+}
@@ -0,0 +1,92 @@
+// EngineBuildingBlocks/Graphics/Primitives/MeshOptimization.h
+
+#ifndef _ENGINEBUILDINGBLOCKS_MESHOPTIMIZATION_H_INCLUDED_
+#define _ENGINEBUILDINGBLOCKS_MESHOPTIMIZATION_H_INCLUDED_
+
+#include <Core/DataStructures/SimpleTypeVector.hpp>
+#include <Core/SimpleBinarySerialization.hpp>
+#include <EngineBuildingBlocks/Graphics/Primitives/Primitive.h>
+
+namespace EngineBuildingBlocks
+{
+	namespace Graphics
+	{
+		struct MeshOptimizationOptionsType
+		{
+			// Merges the vertices of a mesh, which are bitwise equal in all vertex elements.
+			bool IsWeldingVertices;
+
+			// Reorders the triangles for the post-transform vertex cache (Forsyth).
+			bool IsOptimizingVertexCache;
+
+			// Reorders clusters of the cache-optimized triangles, so the outer, front-facing surfaces
+			// are drawn first (Sander et al.). Requires positions.
+			bool IsOptimizingOverdraw;
+
+			// Reorders the vertices in the order of their first use and removes the unused vertices.
+			bool IsOptimizingVertexFetch;
+
+			// The overdraw optimization may increase the ACMR of the triangles by this factor.
+			float OverdrawThreshold;
+
+			// The optimization is disabled by default, since it changes the order of the triangles and the vertices,
+			// which the face and vertex indices stored for the built models refer to.
+			MeshOptimizationOptionsType(bool isOptimizing = false);
+
+			bool operator==(const MeshOptimizationOptionsType& other) const;
+			bool operator!=(const MeshOptimizationOptionsType& other) const;
+			bool operator<(const MeshOptimizationOptionsType& other) const;
+
+			void SerializeSB(Core::ByteVector& bytes) const;
+		};
+
+		// The statistics of a FIFO post-transform vertex cache simulation.
+		struct VertexCacheStatistics
+		{
+			unsigned CountVertices;
+			unsigned CountTriangles;
+			unsigned CountTransformedVertices;
+
+			// Average cache miss ratio: transformed vertices per triangle. It's between 0.5 and 3.
+			float ACMR;
+
+			// Average transformed vertex ratio: transformed vertices per referenced vertex. The optimum is 1.
+			float ATVR;
+		};
+
+		struct MeshOptimizationStatistics
+		{
+			VertexCacheStatistics Before;
+			VertexCacheStatistics After;
+		};
+
+		const unsigned c_DefaultVertexCacheSize = 16;
+
+		// The functions work with triangle lists.
+
+		VertexCacheStatistics AnalyzeVertexCache(const unsigned* indices, unsigned countIndices,
+			unsigned countVertices, unsigned cacheSize = c_DefaultVertexCacheSize);
+
+		void OptimizeVertexCache(unsigned* indices, unsigned countIndices, unsigned countVertices);
+
+		// The indices should be optimized for the vertex cache.
+		void OptimizeOverdraw(unsigned* indices, unsigned countIndices, const glm::vec3* positions,
+			unsigned countVertices, float threshold);
+
+		MeshOptimizationStatistics OptimizeMesh(Vertex_SOA_Data& vertexData, IndexData& indexData,
+			const MeshOptimizationOptionsType& options = MeshOptimizationOptionsType(true));
+
+		// Optimizes the meshes of shared buffers independently. Welding and vertex fetch optimization change
+		// the vertex ranges of the meshes. If a remap is given, it's filled with the new index of each vertex
+		// or Core::c_InvalidIndexU for the removed vertices, so the data stored per vertex elsewhere
+		// can be updated.
+		MeshOptimizationStatistics OptimizeMeshes(Vertex_SOA_Data& vertexData, IndexData& indexData,
+			MeshGeometryData* meshes, unsigned countMeshes,
+			const MeshOptimizationOptionsType& options = MeshOptimizationOptionsType(true),
+			Core::IndexVectorU* vertexRemap = nullptr);
+	}
+}
+
+CORE_BITWISE_SERIALIZABLE_SB(EngineBuildingBlocks::Graphics::MeshOptimizationStatistics)
+
+#endif
@@ -0,0 +1,812 @@
+// EngineBuildingBlocks/Graphics/Primitives/MeshSimplification.cpp
+
+#include <EngineBuildingBlocks/Graphics/Primitives/MeshSimplification.h>
+
+#include <Core/Comparison.h>
+#include <Core/System/ThreadPool.h>
+#include <EngineBuildingBlocks/ErrorHandling.h>
+#include <EngineBuildingBlocks/Animation/SkeletalAnimation.h>
+#include <EngineBuildingBlocks/Graphics/Primitives/MeshOptimization.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <vector>
+
+using namespace EngineBuildingBlocks;
+using namespace EngineBuildingBlocks::Graphics;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+MeshSimplificationOptionsType::MeshSimplificationOptionsType(bool isGeneratingLODs)
+	: IsGeneratingLODs(isGeneratingLODs)
+	, MaximumCountLODs(4)
+	, TriangleRatio(0.5f)
+	, MaximumRelativeError(0.02f)
+{
+}
+
+bool MeshSimplificationOptionsType::operator==(const MeshSimplificationOptionsType& other) const
+{
+	BoolEqualCompareBlock(IsGeneratingLODs);
+	NumericalEqualCompareBlock(MaximumCountLODs);
+	NumericalEqualCompareBlock(TriangleRatio);
+	NumericalEqualCompareBlock(MaximumRelativeError);
+	return true;
+}
+
+bool MeshSimplificationOptionsType::operator!=(const MeshSimplificationOptionsType& other) const
+{
+	return !(*this == other);
+}
+
+bool MeshSimplificationOptionsType::operator<(const MeshSimplificationOptionsType& other) const
+{
+	BoolLessCompareBlock(IsGeneratingLODs);
+	NumericalLessCompareBlock(MaximumCountLODs);
+	NumericalLessCompareBlock(TriangleRatio);
+	NumericalLessCompareBlock(MaximumRelativeError);
+	return false;
+}
+
+void MeshSimplificationOptionsType::SerializeSB(Core::ByteVector& bytes) const
+{
+	Core::SerializeSB(bytes, IsGeneratingLODs);
+	Core::SerializeSB(bytes, MaximumCountLODs);
+	Core::SerializeSB(bytes, TriangleRatio);
+	Core::SerializeSB(bytes, MaximumRelativeError);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	// The open edges are weighted more than the triangles, since they only have a single plane.
+	const double c_BorderQuadricWeight = 10.0;
+
+	// A complete change of the bone weights costs as much as a geometric error of this ratio of the mesh's extent.
+	const float c_BoneWeightErrorRatio = 0.1f;
+
+	// The normals of the remaining triangles of a collapse may rotate by at most 75 degrees, relative to both
+	// their current and their original normals, which also avoids the slivers.
+	const float c_MinimumNormalCosine = 0.25f;
+
+	// The levels, which don't remove at least this ratio of the previous level's triangles, are not stored.
+	const float c_MinimumLODReduction = 0.1f;
+
+	enum class CollapseVertexKind : unsigned char
+	{
+		// Interior vertex, which can be collapsed to any neighbour.
+		Manifold,
+
+		// A vertex of an open border, which can be collapsed along the border.
+		Border,
+
+		// A vertex with two wedges, which can be collapsed along the seam with both wedges.
+		Seam,
+
+		// Corners and complex topology.
+		Locked
+	};
+
+	// The squared distances from the planes of the triangles, weighted by their areas.
+	struct Quadric
+	{
+		double A00, A11, A22, A01, A02, A12;
+		double B0, B1, B2;
+		double C;
+		double Weight;
+
+		void AddPlane(const glm::vec3& normal, float d, double weight)
+		{
+			double x = normal.x, y = normal.y, z = normal.z;
+			A00 += weight * x * x; A11 += weight * y * y; A22 += weight * z * z;
+			A01 += weight * x * y; A02 += weight * x * z; A12 += weight * y * z;
+			B0 += weight * x * d; B1 += weight * y * d; B2 += weight * z * d;
+			C += weight * d * d;
+			Weight += weight;
+		}
+
+		void Add(const Quadric& other)
+		{
+			A00 += other.A00; A11 += other.A11; A22 += other.A22;
+			A01 += other.A01; A02 += other.A02; A12 += other.A12;
+			B0 += other.B0; B1 += other.B1; B2 += other.B2;
+			C += other.C;
+			Weight += other.Weight;
+		}
+
+		// Returns the weighted mean of the squared distances.
+		double Evaluate(const glm::vec3& point) const
+		{
+			if (Weight <= 0.0) return 0.0;
+			double x = point.x, y = point.y, z = point.z;
+			double error = A00 * x * x + A11 * y * y + A22 * z * z
+				+ 2.0 * (A01 * x * y + A02 * x * z + A12 * y * z)
+				+ 2.0 * (B0 * x + B1 * y + B2 * z) + C;
+			return std::max(error, 0.0) / Weight;
+		}
+	};
+
+	struct Collapse
+	{
+		unsigned Source;
+		unsigned Target;
+		float Error;
+	};
+
+	// The bits of a position, where the negative zeros are replaced by positive zeros.
+	struct PositionKey
+	{
+		std::uint32_t Bits[3];
+	};
+
+	inline PositionKey GetPositionKey(const glm::vec3& position)
+	{
+		PositionKey key;
+		memcpy(key.Bits, &position, sizeof(key.Bits));
+		for (unsigned i = 0; i < 3; i++) if (key.Bits[i] == 0x80000000) key.Bits[i] = 0;
+		return key;
+	}
+
+	inline std::uint64_t MakeEdgeKey(unsigned start, unsigned end)
+	{
+		return (static_cast<std::uint64_t>(start) << 32) | end;
+	}
+
+	// Returns the half of the L1 distance of the bone weights, which is between 0 and 1.
+	float GetBoneWeightDistance(const glm::uvec4& boneIndices1, const glm::vec4& boneWeights1,
+		const glm::uvec4& boneIndices2, const glm::vec4& boneWeights2)
+	{
+		float distance = 0.0f;
+		for (int i = 0; i < 4; i++)
+		{
+			if (boneWeights1[i] == 0.0f) continue;
+			float weight2 = 0.0f;
+			for (int j = 0; j < 4; j++)
+			{
+				if (boneWeights2[j] != 0.0f && boneIndices2[j] == boneIndices1[i]) weight2 += boneWeights2[j];
+			}
+			distance += std::abs(boneWeights1[i] - weight2);
+		}
+		for (int j = 0; j < 4; j++)
+		{
+			if (boneWeights2[j] == 0.0f) continue;
+			bool isShared = false;
+			for (int i = 0; i < 4; i++) isShared |= (boneWeights1[i] != 0.0f && boneIndices1[i] == boneIndices2[j]);
+			if (!isShared) distance += boneWeights2[j];
+		}
+		return 0.5f * distance;
+	}
+
+	class MeshSimplifier
+	{
+		const glm::vec3* m_Positions;
+		const glm::uvec4* m_BoneIndices;
+		const glm::vec4* m_BoneWeights;
+		unsigned m_CountVertices;
+
+		// The representative vertex of the position of each vertex, and the next vertex with the same position
+		// in a cycle. The vertices with the same position are the wedges of the position.
+		Core::IndexVectorU m_PositionRemap;
+		Core::IndexVectorU m_Wedges;
+
+		Core::SimpleTypeVectorU<CollapseVertexKind> m_Kinds;
+
+		// The neighbours along the open edges of the border and seam vertices.
+		Core::IndexVectorU m_OpenNext;
+		Core::IndexVectorU m_OpenPrevious;
+
+		// Indexed by the representative vertices.
+		std::vector<Quadric> m_Quadrics;
+
+		// The original normals of the current triangles. The rotation of the triangles is also limited relative
+		// to them, thus the small rotations of the successive collapses can't fold the surface.
+		Core::SimpleTypeVectorU<glm::vec3> m_TriangleNormals;
+
+		float m_BoneWeightErrorScaler;
+
+		// The data of a pass: the triangles of the vertices, the targets of the collapsed vertices
+		// and the locked positions, which can't be collapsed in the pass.
+		Core::IndexVectorU m_TriangleOffsets;
+		Core::IndexVectorU m_VertexTriangles;
+		Core::IndexVectorU m_CollapseTargets;
+		Core::ByteVectorU m_IsLocked;
+		Core::SimpleTypeVectorU<Collapse> m_Collapses;
+
+		void CreatePositionRemap();
+		void RemoveDegenerateTriangles();
+		void ClassifyVertices();
+		void CreateQuadrics();
+
+		bool GetSeamPartners(unsigned source, unsigned target, unsigned& source2, unsigned& target2) const;
+		float GetCollapseError(unsigned source, unsigned target, unsigned source2, unsigned target2) const;
+		bool IsCollapseFlipping(unsigned source, unsigned target, unsigned& countRemovedTriangles) const;
+		void LockNeighbours(unsigned source);
+		void RemoveFromOpenChain(unsigned vertex);
+
+		bool CollapseEdges(unsigned targetCountIndices, float maximumError);
+
+	public:
+
+		// The current indices and the largest error of the collapses.
+		Core::IndexVectorU Indices;
+		float Error;
+
+		// The extent of the mesh: the largest size of its bounding box.
+		float Extent;
+
+		MeshSimplifier(const unsigned* indices, unsigned countIndices, const glm::vec3* positions,
+			unsigned countVertices, const glm::uvec4* boneIndices, const glm::vec4* boneWeights);
+
+		void Simplify(unsigned targetCountIndices, float maximumError);
+	};
+
+	MeshSimplifier::MeshSimplifier(const unsigned* indices, unsigned countIndices, const glm::vec3* positions,
+		unsigned countVertices, const glm::uvec4* boneIndices, const glm::vec4* boneWeights)
+		: m_Positions(positions)
+		, m_BoneIndices(boneIndices)
+		, m_BoneWeights(boneWeights)
+		, m_CountVertices(countVertices)
+		, Error(0.0f)
+		, Extent(0.0f)
+	{
+		Indices.PushBack(indices, countIndices);
+
+		glm::vec3 minimum(std::numeric_limits<float>::max()), maximum(-std::numeric_limits<float>::max());
+		for (unsigned i = 0; i < countIndices; i++)
+		{
+			minimum = glm::min(minimum, positions[indices[i]]);
+			maximum = glm::max(maximum, positions[indices[i]]);
+		}
+		if (countIndices > 0)
+		{
+			auto size = maximum - minimum;
+			Extent = std::max(size.x, std::max(size.y, size.z));
+		}
+		m_BoneWeightErrorScaler = c_BoneWeightErrorRatio * Extent;
+
+		CreatePositionRemap();
+		RemoveDegenerateTriangles();
+		m_TriangleNormals.Resize(Indices.GetSize() / 3);
+		for (unsigned i = 0; i < Indices.GetSize(); i += 3)
+		{
+			auto& p0 = positions[Indices[i]];
+			m_TriangleNormals[i / 3] = glm::cross(positions[Indices[i + 1]] - p0, positions[Indices[i + 2]] - p0);
+		}
+		ClassifyVertices();
+		CreateQuadrics();
+	}
+
+	void MeshSimplifier::CreatePositionRemap()
+	{
+		m_PositionRemap.Resize(m_CountVertices);
+		m_Wedges.Resize(m_CountVertices);
+		for (unsigned i = 0; i < m_CountVertices; i++) m_PositionRemap[i] = m_Wedges[i] = i;
+
+		// Only the referenced vertices are the wedges of a position.
+		Core::ByteVectorU isReferenced(m_CountVertices);
+		isReferenced.SetByte(0);
+		for (unsigned i = 0; i < Indices.GetSize(); i++) isReferenced[Indices[i]] = 1;
+		Core::IndexVectorU vertices;
+		for (unsigned i = 0; i < m_CountVertices; i++) if (isReferenced[i]) vertices.PushBack(i);
+		unsigned countReferenced = vertices.GetSize();
+
+		// The positions are compared bitwise.
+		Core::SimpleTypeVectorU<PositionKey> keys(m_CountVertices);
+		for (unsigned i = 0; i < countReferenced; i++) keys[vertices[i]] = GetPositionKey(m_Positions[vertices[i]]);
+		auto pKeys = keys.GetArray();
+		std::sort(vertices.GetArray(), vertices.GetEndPointer(), [pKeys](unsigned a, unsigned b) {
+			int result = memcmp(&pKeys[a], &pKeys[b], sizeof(PositionKey));
+			return (result != 0 ? result < 0 : a < b);
+		});
+		for (unsigned start = 0, end; start < countReferenced; start = end)
+		{
+			unsigned representative = vertices[start];
+			for (end = start + 1; end < countReferenced
+				&& memcmp(&pKeys[vertices[end]], &pKeys[representative], sizeof(PositionKey)) == 0; end++)
+			{
+				m_PositionRemap[vertices[end]] = representative;
+			}
+			for (unsigned i = start; i < end; i++)
+			{
+				m_Wedges[vertices[i]] = vertices[i + 1 < end ? i + 1 : start];
+			}
+		}
+	}
+
+	void MeshSimplifier::RemoveDegenerateTriangles()
+	{
+		unsigned countIndices = Indices.GetSize();
+		unsigned targetIndex = 0;
+		for (unsigned i = 0; i < countIndices; i += 3)
+		{
+			unsigned p0 = m_PositionRemap[Indices[i]];
+			unsigned p1 = m_PositionRemap[Indices[i + 1]];
+			unsigned p2 = m_PositionRemap[Indices[i + 2]];
+			if (p0 == p1 || p1 == p2 || p2 == p0) continue;
+			if (m_TriangleNormals.GetSize() > 0) m_TriangleNormals[targetIndex / 3] = m_TriangleNormals[i / 3];
+			Indices[targetIndex++] = Indices[i];
+			Indices[targetIndex++] = Indices[i + 1];
+			Indices[targetIndex++] = Indices[i + 2];
+		}
+		Indices.Resize(targetIndex);
+		if (m_TriangleNormals.GetSize() > 0) m_TriangleNormals.Resize(targetIndex / 3);
+	}
+
+	void MeshSimplifier::ClassifyVertices()
+	{
+		unsigned countIndices = Indices.GetSize();
+
+		// The directed edges of the triangles with the vertices and with the positions.
+		Core::SimpleTypeVectorU<std::uint64_t> edges(countIndices), positionEdges(countIndices);
+		for (unsigned i = 0; i < countIndices; i++)
+		{
+			unsigned start = Indices[i];
+			unsigned end = Indices[i % 3 == 2 ? i - 2 : i + 1];
+			edges[i] = MakeEdgeKey(start, end);
+			positionEdges[i] = MakeEdgeKey(m_PositionRemap[start], m_PositionRemap[end]);
+		}
+		std::sort(edges.GetArray(), edges.GetEndPointer());
+		std::sort(positionEdges.GetArray(), positionEdges.GetEndPointer());
+
+		// Counting the open edges of the vertices and of the positions. The positions of the edges,
+		// which are used more than once in the same direction, are locked.
+		Core::IndexVectorU countOpenOut(m_CountVertices), countOpenIn(m_CountVertices);
+		Core::IndexVectorU countPositionOpenOut(m_CountVertices), countPositionOpenIn(m_CountVertices);
+		Core::ByteVectorU isComplex(m_CountVertices);
+		countOpenOut.SetByte(0);
+		countOpenIn.SetByte(0);
+		countPositionOpenOut.SetByte(0);
+		countPositionOpenIn.SetByte(0);
+		isComplex.SetByte(0);
+		m_OpenNext.Resize(m_CountVertices);
+		m_OpenPrevious.Resize(m_CountVertices);
+		m_OpenNext.SetByte(0xff);
+		m_OpenPrevious.SetByte(0xff);
+		for (unsigned i = 0; i < countIndices; i++)
+		{
+			unsigned start = Indices[i];
+			unsigned end = Indices[i % 3 == 2 ? i - 2 : i + 1];
+			if (!std::binary_search(edges.GetArray(), edges.GetEndPointer(), MakeEdgeKey(end, start)))
+			{
+				countOpenOut[start]++;
+				countOpenIn[end]++;
+				m_OpenNext[start] = end;
+				m_OpenPrevious[end] = start;
+			}
+
+			unsigned startPosition = m_PositionRemap[start];
+			unsigned endPosition = m_PositionRemap[end];
+			if (!std::binary_search(positionEdges.GetArray(), positionEdges.GetEndPointer(),
+				MakeEdgeKey(endPosition, startPosition)))
+			{
+				countPositionOpenOut[startPosition]++;
+				countPositionOpenIn[endPosition]++;
+			}
+			auto range = std::equal_range(positionEdges.GetArray(), positionEdges.GetEndPointer(),
+				MakeEdgeKey(startPosition, endPosition));
+			if (range.second - range.first > 1) isComplex[startPosition] = isComplex[endPosition] = 1;
+		}
+
+		m_Kinds.Resize(m_CountVertices);
+		for (unsigned i = 0; i < m_CountVertices; i++)
+		{
+			unsigned position = m_PositionRemap[i];
+			unsigned countWedges = 1;
+			for (unsigned j = m_Wedges[i]; j != i; j = m_Wedges[j]) countWedges++;
+
+			auto kind = CollapseVertexKind::Locked;
+			if (!isComplex[position] && countWedges == 1)
+			{
+				if (countOpenOut[i] == 0 && countOpenIn[i] == 0)
+				{
+					kind = CollapseVertexKind::Manifold;
+				}
+				else if (countOpenOut[i] == 1 && countOpenIn[i] == 1
+					&& countPositionOpenOut[position] == 1 && countPositionOpenIn[position] == 1)
+				{
+					kind = CollapseVertexKind::Border;
+				}
+			}
+			else if (!isComplex[position] && countWedges == 2)
+			{
+				// The seam must continue through the position on both wedges, which are traversed
+				// in opposite directions.
+				unsigned wedge = m_Wedges[i];
+				if (countPositionOpenOut[position] == 0 && countPositionOpenIn[position] == 0
+					&& countOpenOut[i] == 1 && countOpenIn[i] == 1 && countOpenOut[wedge] == 1 && countOpenIn[wedge] == 1
+					&& m_PositionRemap[m_OpenNext[i]] == m_PositionRemap[m_OpenPrevious[wedge]]
+					&& m_PositionRemap[m_OpenPrevious[i]] == m_PositionRemap[m_OpenNext[wedge]])
+				{
+					kind = CollapseVertexKind::Seam;
+				}
+			}
+			m_Kinds[i] = kind;
+		}
+	}
+
+	void MeshSimplifier::CreateQuadrics()
+	{
+		m_Quadrics.clear();
+		m_Quadrics.resize(m_CountVertices, Quadric());
+
+		unsigned countIndices = Indices.GetSize();
+		for (unsigned i = 0; i < countIndices; i += 3)
+		{
+			auto& p0 = m_Positions[Indices[i]];
+			auto& p1 = m_Positions[Indices[i + 1]];
+			auto& p2 = m_Positions[Indices[i + 2]];
+			auto normal = glm::cross(p1 - p0, p2 - p0);
+			float doubleArea = glm::length(normal);
+			if (doubleArea == 0.0f) continue;
+			normal /= doubleArea;
+
+			Quadric quadric = {};
+			quadric.AddPlane(normal, -glm::dot(normal, p0), 0.5 * doubleArea);
+			for (unsigned j = 0; j < 3; j++) m_Quadrics[m_PositionRemap[Indices[i + j]]].Add(quadric);
+
+			// The open edges are kept by the planes, which are perpendicular to the triangle.
+			for (unsigned j = 0; j < 3; j++)
+			{
+				unsigned start = Indices[i + j];
+				unsigned end = Indices[i + (j + 1) % 3];
+				if (m_OpenNext[start] != end) continue;
+				auto edge = m_Positions[end] - m_Positions[start];
+				auto edgeNormal = glm::cross(edge, normal);
+				float edgeLength = glm::length(edgeNormal);
+				if (edgeLength == 0.0f) continue;
+				edgeNormal /= edgeLength;
+
+				Quadric edgeQuadric = {};
+				edgeQuadric.AddPlane(edgeNormal, -glm::dot(edgeNormal, m_Positions[start]),
+					c_BorderQuadricWeight * edgeLength * edgeLength);
+				m_Quadrics[m_PositionRemap[start]].Add(edgeQuadric);
+				m_Quadrics[m_PositionRemap[end]].Add(edgeQuadric);
+			}
+		}
+	}
+
+	// Returns whether the collapse is allowed. The other wedge of a seam source is collapsed to the wedge
+	// of the target on its side of the seam, otherwise the second source is invalid.
+	bool MeshSimplifier::GetSeamPartners(unsigned source, unsigned target, unsigned& source2, unsigned& target2) const
+	{
+		source2 = target2 = Core::c_InvalidIndexU;
+		auto targetKind = m_Kinds[target];
+		switch (m_Kinds[source])
+		{
+		case CollapseVertexKind::Manifold:
+			return true;
+		case CollapseVertexKind::Border:
+			return ((targetKind == CollapseVertexKind::Border || targetKind == CollapseVertexKind::Locked)
+				&& (m_OpenNext[source] == target || m_OpenPrevious[source] == target));
+		case CollapseVertexKind::Seam:
+		{
+			if (targetKind != CollapseVertexKind::Seam && targetKind != CollapseVertexKind::Locked) return false;
+			source2 = m_Wedges[source];
+			if (m_OpenNext[source] == target) target2 = m_OpenPrevious[source2];
+			else if (m_OpenPrevious[source] == target) target2 = m_OpenNext[source2];
+			else return false;
+			return (m_PositionRemap[target2] == m_PositionRemap[target]);
+		}
+		default:
+			return false;
+		}
+	}
+
+	float MeshSimplifier::GetCollapseError(unsigned source, unsigned target, unsigned source2, unsigned target2) const
+	{
+		float error = static_cast<float>(std::sqrt(m_Quadrics[m_PositionRemap[source]].Evaluate(m_Positions[target])));
+		if (m_BoneWeights != nullptr)
+		{
+			float distance = GetBoneWeightDistance(m_BoneIndices[source], m_BoneWeights[source],
+				m_BoneIndices[target], m_BoneWeights[target]);
+			if (source2 != Core::c_InvalidIndexU)
+			{
+				distance = std::max(distance, GetBoneWeightDistance(m_BoneIndices[source2], m_BoneWeights[source2],
+					m_BoneIndices[target2], m_BoneWeights[target2]));
+			}
+			error += distance * m_BoneWeightErrorScaler;
+		}
+		return error;
+	}
+
+	// Returns whether a remaining triangle of the source would be flipped, rotated too much or become degenerate,
+	// and counts the triangles, which are removed by the collapse.
+	bool MeshSimplifier::IsCollapseFlipping(unsigned source, unsigned target, unsigned& countRemovedTriangles) const
+	{
+		auto& sourcePosition = m_Positions[source];
+		auto& targetPosition = m_Positions[target];
+		unsigned targetRepresentative = m_PositionRemap[target];
+		for (unsigned i = m_TriangleOffsets[source]; i < m_TriangleOffsets[source + 1]; i++)
+		{
+			unsigned triangleIndex = m_VertexTriangles[i];
+			auto triangle = Indices.GetArray() + 3 * triangleIndex;
+			unsigned k = (triangle[0] == source ? 0 : (triangle[1] == source ? 1 : 2));
+			unsigned vertex1 = triangle[(k + 1) % 3];
+			unsigned vertex2 = triangle[(k + 2) % 3];
+			if (m_PositionRemap[vertex1] == targetRepresentative || m_PositionRemap[vertex2] == targetRepresentative)
+			{
+				countRemovedTriangles++;
+				continue;
+			}
+			auto& p1 = m_Positions[vertex1];
+			auto& p2 = m_Positions[vertex2];
+			auto oldNormal = glm::cross(p1 - sourcePosition, p2 - sourcePosition);
+			auto newNormal = glm::cross(p1 - targetPosition, p2 - targetPosition);
+			auto& originalNormal = m_TriangleNormals[triangleIndex];
+			float newLength = glm::length(newNormal);
+			if (glm::dot(oldNormal, oldNormal) > 0.0f
+				&& (glm::dot(oldNormal, newNormal) <= c_MinimumNormalCosine * glm::length(oldNormal) * newLength
+				|| glm::dot(originalNormal, newNormal) <= c_MinimumNormalCosine * glm::length(originalNormal) * newLength))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void MeshSimplifier::LockNeighbours(unsigned source)
+	{
+		for (unsigned i = m_TriangleOffsets[source]; i < m_TriangleOffsets[source + 1]; i++)
+		{
+			auto triangle = Indices.GetArray() + 3 * m_VertexTriangles[i];
+			for (unsigned j = 0; j < 3; j++) m_IsLocked[m_PositionRemap[triangle[j]]] = 1;
+		}
+	}
+
+	// The open neighbours of the collapsed border and seam vertices are linked, so the borders and the seams
+	// can be collapsed further.
+	void MeshSimplifier::RemoveFromOpenChain(unsigned vertex)
+	{
+		unsigned previous = m_OpenPrevious[vertex];
+		unsigned next = m_OpenNext[vertex];
+		m_OpenNext[previous] = next;
+		m_OpenPrevious[next] = previous;
+	}
+
+	// Performs a pass of independent collapses in the order of their errors. The neighbours of a collapsed
+	// vertex are locked in the pass, thus the flip tests remain valid. Returns false if no collapse was made.
+	bool MeshSimplifier::CollapseEdges(unsigned targetCountIndices, float maximumError)
+	{
+		unsigned countIndices = Indices.GetSize();
+		unsigned countTriangles = countIndices / 3;
+
+		// Creating the triangle adjacency of the vertices.
+		m_TriangleOffsets.Resize(m_CountVertices + 1);
+		m_TriangleOffsets.SetByte(0);
+		for (unsigned i = 0; i < countIndices; i++) m_TriangleOffsets[Indices[i] + 1]++;
+		for (unsigned i = 0; i < m_CountVertices; i++) m_TriangleOffsets[i + 1] += m_TriangleOffsets[i];
+		m_VertexTriangles.Resize(countIndices);
+		{
+			Core::IndexVectorU positions(m_TriangleOffsets.GetArray(), m_CountVertices);
+			for (unsigned i = 0; i < countIndices; i++) m_VertexTriangles[positions[Indices[i]]++] = i / 3;
+		}
+
+		// Collecting the collapses of the edges in both directions.
+		m_Collapses.Clear();
+		for (unsigned i = 0; i < countIndices; i++)
+		{
+			unsigned vertex1 = Indices[i];
+			unsigned vertex2 = Indices[i % 3 == 2 ? i - 2 : i + 1];
+			for (unsigned j = 0; j < 2; j++)
+			{
+				unsigned source = (j == 0 ? vertex1 : vertex2);
+				unsigned target = (j == 0 ? vertex2 : vertex1);
+				unsigned source2, target2;
+				if (!GetSeamPartners(source, target, source2, target2)) continue;
+				float error = GetCollapseError(source, target, source2, target2);
+				if (error <= maximumError) m_Collapses.PushBack(Collapse{ source, target, error });
+			}
+		}
+		std::sort(m_Collapses.GetArray(), m_Collapses.GetEndPointer(), [](const Collapse& a, const Collapse& b) {
+			return a.Error < b.Error; });
+
+		m_CollapseTargets.Resize(m_CountVertices);
+		for (unsigned i = 0; i < m_CountVertices; i++) m_CollapseTargets[i] = i;
+		m_IsLocked.Resize(m_CountVertices);
+		m_IsLocked.SetByte(0);
+
+		unsigned countTrianglesToRemove = countTriangles - std::min(countTriangles, targetCountIndices / 3);
+		unsigned countRemovedTriangles = 0;
+		unsigned countCollapses = 0;
+		for (unsigned i = 0; i < m_Collapses.GetSize() && countRemovedTriangles < countTrianglesToRemove; i++)
+		{
+			auto& collapse = m_Collapses[i];
+			unsigned source = collapse.Source;
+			unsigned target = collapse.Target;
+			unsigned sourceRepresentative = m_PositionRemap[source];
+			unsigned targetRepresentative = m_PositionRemap[target];
+			if (m_IsLocked[sourceRepresentative] || m_IsLocked[targetRepresentative]) continue;
+
+			unsigned source2, target2;
+			GetSeamPartners(source, target, source2, target2);
+			unsigned countCollapseRemovedTriangles = 0;
+			if (IsCollapseFlipping(source, target, countCollapseRemovedTriangles)) continue;
+			if (source2 != Core::c_InvalidIndexU
+				&& IsCollapseFlipping(source2, target2, countCollapseRemovedTriangles)) continue;
+
+			m_CollapseTargets[source] = target;
+			LockNeighbours(source);
+			if (m_Kinds[source] != CollapseVertexKind::Manifold) RemoveFromOpenChain(source);
+			if (source2 != Core::c_InvalidIndexU)
+			{
+				m_CollapseTargets[source2] = target2;
+				LockNeighbours(source2);
+				RemoveFromOpenChain(source2);
+			}
+			m_Quadrics[targetRepresentative].Add(m_Quadrics[sourceRepresentative]);
+
+			Error = std::max(Error, collapse.Error);
+			countRemovedTriangles += countCollapseRemovedTriangles;
+			countCollapses++;
+		}
+		if (countCollapses == 0) return false;
+
+		for (unsigned i = 0; i < countIndices; i++) Indices[i] = m_CollapseTargets[Indices[i]];
+		RemoveDegenerateTriangles();
+		return true;
+	}
+
+	void MeshSimplifier::Simplify(unsigned targetCountIndices, float maximumError)
+	{
+		while (Indices.GetSize() > targetCountIndices && CollapseEdges(targetCountIndices, maximumError));
+	}
+
+	struct MeshLODGenerator
+	{
+		const unsigned* Indices;
+		const glm::vec3* Positions;
+		const glm::uvec4* BoneIndices;
+		const glm::vec4* BoneWeights;
+		const MeshGeometryData* Meshes;
+		const MeshSimplificationOptionsType* Options;
+		Core::IndexVectorU* MeshLODIndices;
+		Core::SimpleTypeVectorU<MeshLOD>* MeshLODs;
+		std::exception_ptr* Exceptions;
+
+		void Process(unsigned threadIndex, unsigned startIndex, unsigned endIndex)
+		{
+			try
+			{
+				for (unsigned i = startIndex; i < endIndex; i++)
+				{
+					auto& mesh = Meshes[i];
+					bool isSkinned = (BoneWeights != nullptr);
+					GenerateMeshLODs(Indices + mesh.BaseIndex, mesh.CountIndices, Positions + mesh.BaseVertex,
+						mesh.CountVertices, isSkinned ? BoneIndices + mesh.BaseVertex : nullptr,
+						isSkinned ? BoneWeights + mesh.BaseVertex : nullptr, *Options, MeshLODIndices[i], MeshLODs[i]);
+				}
+			}
+			catch (...)
+			{
+				if (!Exceptions[threadIndex]) Exceptions[threadIndex] = std::current_exception();
+			}
+		}
+	};
+}
+
+namespace EngineBuildingBlocks
+{
+	namespace Graphics
+	{
+		void GenerateMeshLODs(const unsigned* indices, unsigned countIndices, const glm::vec3* positions,
+			unsigned countVertices, const glm::uvec4* boneIndices, const glm::vec4* boneWeights,
+			const MeshSimplificationOptionsType& options, Core::IndexVectorU& lodIndices,
+			Core::SimpleTypeVectorU<MeshLOD>& lods)
+		{
+			if (countIndices < 3) return;
+
+			MeshSimplifier simplifier(indices, countIndices, positions, countVertices, boneIndices, boneWeights);
+			float maximumError = options.MaximumRelativeError * simplifier.Extent;
+
+			unsigned countPreviousIndices = countIndices;
+			for (unsigned i = 0; i < options.MaximumCountLODs; i++)
+			{
+				unsigned targetCountIndices = static_cast<unsigned>(countPreviousIndices / 3 * options.TriangleRatio) * 3;
+				if (targetCountIndices == 0) break;
+
+				simplifier.Simplify(targetCountIndices, maximumError);
+
+				unsigned countLODIndices = simplifier.Indices.GetSize();
+				if (countLODIndices == 0 || countPreviousIndices - countLODIndices
+					< static_cast<unsigned>(countPreviousIndices * c_MinimumLODReduction)) break;
+
+				unsigned baseIndex = lodIndices.GetSize();
+				lodIndices.PushBack(simplifier.Indices.GetArray(), countLODIndices);
+				OptimizeVertexCache(lodIndices.GetArray() + baseIndex, countLODIndices, countVertices);
+				lods.PushBack(MeshLOD{ baseIndex, countLODIndices, simplifier.Error });
+				countPreviousIndices = countLODIndices;
+			}
+		}
+
+		void GenerateMeshLODs(const Vertex_SOA_Data& vertexData, const IndexData& indexData,
+			const MeshGeometryData* meshes, unsigned countMeshes, const MeshSimplificationOptionsType& options,
+			Core::IndexVectorU& lodIndices, Core::SimpleTypeVectorU<MeshLOD>& lods,
+			Core::SimpleTypeVectorU<MeshLODRange>& lodRanges,
+			const EngineBuildingBlocks::Animation::BoneData* boneData, Core::ThreadPool* threadPool)
+		{
+			if (indexData.Topology != PrimitiveTopology::TriangleList)
+				RaiseException("Meshes can only be simplified as triangle lists.");
+			auto& inputLayout = vertexData.InputLayout;
+			if (!inputLayout.HasPositions()
+				|| inputLayout.GetVertexElement(c_PositionVertexElement.Name.c_str()) != c_PositionVertexElement)
+				RaiseException("Meshes can only be simplified with floating point positions.");
+
+			// Getting the bone influences. At most 4 influences are used per vertex.
+			unsigned countVertices = vertexData.GetCountVertices();
+			Core::SimpleTypeVectorU<glm::uvec4> boneIndexVector;
+			Core::SimpleTypeVectorU<glm::vec4> boneWeightVector;
+			const glm::uvec4* boneIndices = nullptr;
+			const glm::vec4* boneWeights = nullptr;
+			if (boneData != nullptr && boneData->GetCountBones() > 0)
+			{
+				if (boneData->GetCountVertices() != countVertices)
+					RaiseException("The bone data doesn't match the vertices of the simplified meshes.");
+				boneIndexVector.Resize(countVertices);
+				boneWeightVector.Resize(countVertices);
+				boneIndexVector.SetByte(0);
+				boneWeightVector.SetByte(0);
+				for (unsigned i = 0; i < countVertices; i++)
+				{
+					auto influences = boneData->GetInfluences(i);
+					unsigned countInfluences = std::min(boneData->GetCountBones(i), 4U);
+					for (unsigned j = 0; j < countInfluences; j++)
+					{
+						boneIndexVector[i][j] = influences[j].BoneIndex;
+						boneWeightVector[i][j] = influences[j].Weight;
+					}
+				}
+				boneIndices = boneIndexVector.GetArray();
+				boneWeights = boneWeightVector.GetArray();
+			}
+			else if (inputLayout.HasVertexElement(c_VertexBoneWeightVertexElement.Name.c_str())
+				&& inputLayout.HasVertexElement(c_VertexBoneIndexVertexElement.Name.c_str())
+				&& inputLayout.GetVertexElement(c_VertexBoneWeightVertexElement.Name.c_str()) == c_VertexBoneWeightVertexElement
+				&& inputLayout.GetVertexElement(c_VertexBoneIndexVertexElement.Name.c_str()) == c_VertexBoneIndexVertexElement)
+			{
+				boneIndices = vertexData.GetVertexBoneIndices();
+				boneWeights = vertexData.GetVertexBoneWeights();
+			}
+
+			// The meshes are simplified to separate vectors. The costs of the meshes are very different,
+			// therefore they are scheduled dynamically.
+			std::vector<Core::IndexVectorU> meshLODIndices(countMeshes);
+			std::vector<Core::SimpleTypeVectorU<MeshLOD>> meshLODs(countMeshes);
+			std::vector<std::exception_ptr> exceptions(threadPool != nullptr ? threadPool->GetCountThreads() : 1);
+			MeshLODGenerator generator{ indexData.Data.GetArray(), vertexData.GetPositions(), boneIndices, boneWeights,
+				meshes, &options, meshLODIndices.data(), meshLODs.data(), exceptions.data() };
+			if (threadPool != nullptr && countMeshes > 1)
+			{
+				threadPool->ExecuteWithDynamicScheduling(countMeshes, &MeshLODGenerator::Process, &generator);
+			}
+			else
+			{
+				generator.Process(0, 0, countMeshes);
+			}
+			for (auto& exception : exceptions)
+			{
+				if (exception) std::rethrow_exception(exception);
+			}
+
+			for (unsigned i = 0; i < countMeshes; i++)
+			{
+				unsigned baseIndex = lodIndices.GetSize();
+				unsigned baseLOD = lods.GetSize();
+				lodIndices.PushBack(meshLODIndices[i].GetArray(), meshLODIndices[i].GetSize());
+				for (unsigned j = 0; j < meshLODs[i].GetSize(); j++)
+				{
+					auto lod = meshLODs[i][j];
+					lod.BaseIndex += baseIndex;
+					lods.PushBack(lod);
+				}
+				lodRanges.PushBack(MeshLODRange{ baseLOD, meshLODs[i].GetSize() });
+			}
+		}
+	}
+}
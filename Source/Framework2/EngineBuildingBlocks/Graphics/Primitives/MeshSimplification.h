@@ -0,0 +1,109 @@
+// EngineBuildingBlocks/Graphics/Primitives/MeshSimplification.h
+
+#ifndef _ENGINEBUILDINGBLOCKS_MESHSIMPLIFICATION_H_INCLUDED_
+#define _ENGINEBUILDINGBLOCKS_MESHSIMPLIFICATION_H_INCLUDED_
+
+#include <Core/Constants.h>
+#include <Core/DataStructures/SimpleTypeVector.hpp>
+#include <Core/SimpleBinarySerialization.hpp>
+#include <EngineBuildingBlocks/Graphics/Primitives/Primitive.h>
+#include <EngineBuildingBlocks/Math/GLM.h>
+
+namespace Core
+{
+	class ThreadPool;
+}
+
+namespace EngineBuildingBlocks
+{
+	namespace Animation
+	{
+		struct BoneData;
+	}
+
+	namespace Graphics
+	{
+		struct MeshSimplificationOptionsType
+		{
+			bool IsGeneratingLODs;
+
+			// The maximum count of the levels of detail of a mesh, excluding the original mesh.
+			unsigned MaximumCountLODs;
+
+			// The target count of the triangles of a level relative to the previous level.
+			float TriangleRatio;
+
+			// The simplification stops at this error, which is relative to the largest extent of the mesh.
+			float MaximumRelativeError;
+
+			MeshSimplificationOptionsType(bool isGeneratingLODs = false);
+
+			bool operator==(const MeshSimplificationOptionsType& other) const;
+			bool operator!=(const MeshSimplificationOptionsType& other) const;
+			bool operator<(const MeshSimplificationOptionsType& other) const;
+
+			void SerializeSB(Core::ByteVector& bytes) const;
+		};
+
+		// A simplified version of a mesh. Its indices refer to the vertices of the mesh, thus it's drawn
+		// with the base vertex of the mesh.
+		struct MeshLOD
+		{
+			// Index of the first index in the LOD index vector.
+			unsigned BaseIndex;
+			unsigned CountIndices;
+
+			// The geometric error in the model space. The errors of the levels of a mesh are non-decreasing.
+			float Error;
+		};
+
+		// The levels of detail of a mesh.
+		struct MeshLODRange
+		{
+			unsigned BaseLOD;
+			unsigned CountLODs;
+		};
+
+		// Returns the index of the coarsest level, whose projected error is not larger than the given threshold
+		// in pixels, or Core::c_InvalidIndexU if the original mesh has to be drawn. The error scaler should
+		// contain the scale of the model's transformation, and the projection scaler is the height of the viewport
+		// divided by 2 * tan(fovY / 2) for perspective projections.
+		inline unsigned SelectMeshLOD(const MeshLOD* lods, unsigned countLODs, float distance,
+			float errorScaler, float projectionScaler, float pixelThreshold)
+		{
+			if (distance <= 0.0f) return Core::c_InvalidIndexU;
+			float maximumError = pixelThreshold * distance / (errorScaler * projectionScaler);
+			for (unsigned i = countLODs; i > 0; i--)
+			{
+				if (lods[i - 1].Error <= maximumError) return i - 1;
+			}
+			return Core::c_InvalidIndexU;
+		}
+
+		// The functions work with triangle lists. The meshes are simplified by quadric error metric edge collapses,
+		// which move a vertex to one of its neighbours, thus no vertices are created. The vertices with the same
+		// position are the wedges of an attribute seam, e.g. a UV border or a hard edge. The seams and the open
+		// borders are only collapsed along themselves, and the corners of them are kept. The differences
+		// of the bone weights are added to the error of the collapses. The levels are generated progressively
+		// from the previous levels.
+
+		void GenerateMeshLODs(const unsigned* indices, unsigned countIndices, const glm::vec3* positions,
+			unsigned countVertices, const glm::uvec4* boneIndices, const glm::vec4* boneWeights,
+			const MeshSimplificationOptionsType& options, Core::IndexVectorU& lodIndices,
+			Core::SimpleTypeVectorU<MeshLOD>& lods);
+
+		// Generates the levels of detail of each mesh of shared buffers. The bone influences are taken
+		// from the bone data if it's given, otherwise from the bone elements of the vertex data if it has them.
+		// The meshes are processed in parallel if a thread pool is given.
+		void GenerateMeshLODs(const Vertex_SOA_Data& vertexData, const IndexData& indexData,
+			const MeshGeometryData* meshes, unsigned countMeshes, const MeshSimplificationOptionsType& options,
+			Core::IndexVectorU& lodIndices, Core::SimpleTypeVectorU<MeshLOD>& lods,
+			Core::SimpleTypeVectorU<MeshLODRange>& lodRanges,
+			const EngineBuildingBlocks::Animation::BoneData* boneData = nullptr, Core::ThreadPool* threadPool = nullptr);
+	}
+}
+
+CORE_BITWISE_SERIALIZABLE_SB(EngineBuildingBlocks::Graphics::MeshLOD)
+CORE_BITWISE_SERIALIZABLE_SB(EngineBuildingBlocks::Graphics::MeshLODRange)
+
+#endif
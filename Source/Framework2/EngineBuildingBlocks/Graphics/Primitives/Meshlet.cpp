@@ -0,0 +1,280 @@
+// EngineBuildingBlocks/Graphics/Primitives/Meshlet.cpp
+
+#include <EngineBuildingBlocks/Graphics/Primitives/Meshlet.h>
+
+#include <Core/Comparison.h>
+#include <Core/Constants.h>
+#include <EngineBuildingBlocks/ErrorHandling.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+using namespace EngineBuildingBlocks;
+using namespace EngineBuildingBlocks::Graphics;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+MeshletBuildOptionsType::MeshletBuildOptionsType(bool isBuildingMeshlets)
+	: IsBuildingMeshlets(isBuildingMeshlets)
+	, MaximumCountVertices(64)
+	, MaximumCountTriangles(124)
+{
+}
+
+bool MeshletBuildOptionsType::operator==(const MeshletBuildOptionsType& other) const
+{
+	BoolEqualCompareBlock(IsBuildingMeshlets);
+	NumericalEqualCompareBlock(MaximumCountVertices);
+	NumericalEqualCompareBlock(MaximumCountTriangles);
+	return true;
+}
+
+bool MeshletBuildOptionsType::operator!=(const MeshletBuildOptionsType& other) const
+{
+	return !(*this == other);
+}
+
+bool MeshletBuildOptionsType::operator<(const MeshletBuildOptionsType& other) const
+{
+	BoolLessCompareBlock(IsBuildingMeshlets);
+	NumericalLessCompareBlock(MaximumCountVertices);
+	NumericalLessCompareBlock(MaximumCountTriangles);
+	return false;
+}
+
+void MeshletBuildOptionsType::SerializeSB(Core::ByteVector& bytes) const
+{
+	Core::SerializeSB(bytes, IsBuildingMeshlets);
+	Core::SerializeSB(bytes, MaximumCountVertices);
+	Core::SerializeSB(bytes, MaximumCountTriangles);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	// Ritter's bounding sphere: the sphere of the two approximately farthest points, which is grown
+	// to contain all points.
+	void ComputeBoundingSphere(const glm::vec3* points, unsigned countPoints, glm::vec3& center, float& radius)
+	{
+		auto getFarthest = [points, countPoints](const glm::vec3& point) {
+			unsigned farthest = 0;
+			float maximumDistance = -1.0f;
+			for (unsigned i = 0; i < countPoints; i++)
+			{
+				float distance = glm::dot(points[i] - point, points[i] - point);
+				if (distance > maximumDistance)
+				{
+					maximumDistance = distance;
+					farthest = i;
+				}
+			}
+			return farthest;
+		};
+
+		auto& x = points[getFarthest(points[0])];
+		auto& y = points[getFarthest(x)];
+		center = (x + y) * 0.5f;
+		radius = glm::length(y - x) * 0.5f;
+		for (unsigned i = 0; i < countPoints; i++)
+		{
+			float distance = glm::length(points[i] - center);
+			if (distance > radius)
+			{
+				float newRadius = (radius + distance) * 0.5f;
+				center += (points[i] - center) * ((newRadius - radius) / distance);
+				radius = newRadius;
+			}
+		}
+	}
+
+	void ComputeMeshletBounds(Meshlet& meshlet, const unsigned* indices, const glm::vec3* positions,
+		const glm::vec3* triangleNormals, const unsigned* triangles, Core::SimpleTypeVectorU<glm::vec3>& points)
+	{
+		unsigned countTriangles = meshlet.CountIndices / 3;
+		points.Resize(meshlet.CountIndices);
+		for (unsigned i = 0; i < meshlet.CountIndices; i++) points[i] = positions[indices[i]];
+		ComputeBoundingSphere(points.GetArray(), points.GetSize(), meshlet.Center, meshlet.Radius);
+
+		// The cone of the normals of the non-degenerate triangles. The cone is valid if all normals are
+		// in the half space of its axis.
+		glm::vec3 normalSum(0.0f);
+		for (unsigned i = 0; i < countTriangles; i++) normalSum += triangleNormals[triangles[i]];
+		float length = glm::length(normalSum);
+		meshlet.ConeAxis = (length > 0.0f ? normalSum / length : glm::vec3(0.0f, 0.0f, 1.0f));
+		meshlet.ConeCutoff = 1.0f;
+		if (length == 0.0f) return;
+		float minimumDot = 1.0f;
+		for (unsigned i = 0; i < countTriangles; i++)
+		{
+			auto& normal = triangleNormals[triangles[i]];
+			if (normal != glm::vec3(0.0f)) minimumDot = std::min(minimumDot, glm::dot(normal, meshlet.ConeAxis));
+		}
+		if (minimumDot > 0.0f) meshlet.ConeCutoff = std::sqrt(std::max(0.0f, 1.0f - minimumDot * minimumDot));
+	}
+}
+
+namespace EngineBuildingBlocks
+{
+	namespace Graphics
+	{
+		void BuildMeshlets(unsigned* indices, unsigned countIndices, const glm::vec3* positions,
+			unsigned countVertices, const MeshletBuildOptionsType& options, Core::SimpleTypeVectorU<Meshlet>& meshlets)
+		{
+			unsigned maximumCountVertices = options.MaximumCountVertices;
+			unsigned maximumCountTriangles = options.MaximumCountTriangles;
+			if (maximumCountVertices < 3 || maximumCountTriangles < 1)
+				RaiseException("A meshlet must be able to contain a triangle.");
+
+			unsigned countTriangles = countIndices / 3;
+			if (countTriangles == 0) return;
+
+			// The triangles of the vertices.
+			Core::IndexVectorU vertexTriangleOffsets(countVertices + 1, 0U);
+			Core::IndexVectorU vertexTriangles(countTriangles * 3);
+			for (unsigned i = 0; i < countTriangles * 3; i++) vertexTriangleOffsets[indices[i] + 1]++;
+			for (unsigned i = 0; i < countVertices; i++) vertexTriangleOffsets[i + 1] += vertexTriangleOffsets[i];
+			{
+				auto offsets = vertexTriangleOffsets;
+				for (unsigned i = 0; i < countTriangles * 3; i++) vertexTriangles[offsets[indices[i]]++] = i / 3;
+			}
+
+			Core::SimpleTypeVectorU<glm::vec3> centroids(countTriangles), normals(countTriangles);
+			for (unsigned i = 0; i < countTriangles; i++)
+			{
+				auto& p0 = positions[indices[3 * i]];
+				auto& p1 = positions[indices[3 * i + 1]];
+				auto& p2 = positions[indices[3 * i + 2]];
+				centroids[i] = (p0 + p1 + p2) * (1.0f / 3.0f);
+				auto normal = glm::cross(p1 - p0, p2 - p0);
+				float length = glm::length(normal);
+				normals[i] = (length > 0.0f ? normal / length : glm::vec3(0.0f));
+			}
+
+			// The marks store the index of the meshlet, which contains the vertex or has the triangle as candidate.
+			Core::ByteVectorU isTriangleUsed(countTriangles, static_cast<unsigned char>(0));
+			Core::IndexVectorU vertexMarks(countVertices, Core::c_InvalidIndexU);
+			Core::IndexVectorU candidateMarks(countTriangles, Core::c_InvalidIndexU);
+
+			Core::IndexVectorU newIndices(countTriangles * 3);
+			Core::IndexVectorU meshletTriangles, candidates;
+			Core::SimpleTypeVectorU<glm::vec3> points;
+			unsigned countUsedTriangles = 0, nextSeed = 0;
+			for (unsigned meshletIndex = 0; countUsedTriangles < countTriangles; meshletIndex++)
+			{
+				unsigned countMeshletVertices = 0;
+				glm::vec3 centroidSum(0.0f);
+				meshletTriangles.Clear();
+				candidates.Clear();
+
+				auto getCountNewVertices = [&](unsigned triangle) {
+					unsigned count = 0;
+					for (unsigned j = 0; j < 3; j++) count += (vertexMarks[indices[3 * triangle + j]] != meshletIndex);
+					return count;
+				};
+
+				while (meshletTriangles.GetSize() < maximumCountTriangles)
+				{
+					// Selecting the candidate, which adds the least new vertices and is the closest to the meshlet.
+					unsigned bestTriangle = Core::c_InvalidIndexU;
+					unsigned bestCountNewVertices = 4;
+					float bestDistance = std::numeric_limits<float>::max();
+					glm::vec3 center = centroidSum / static_cast<float>(std::max(1U, meshletTriangles.GetSize()));
+					unsigned countCandidates = 0;
+					for (unsigned i = 0; i < candidates.GetSize(); i++)
+					{
+						unsigned triangle = candidates[i];
+						if (isTriangleUsed[triangle]) continue;
+						candidates[countCandidates++] = triangle;
+						unsigned countNewVertices = getCountNewVertices(triangle);
+						if (countMeshletVertices + countNewVertices > maximumCountVertices
+							|| countNewVertices > bestCountNewVertices) continue;
+						auto difference = centroids[triangle] - center;
+						float distance = glm::dot(difference, difference);
+						if (countNewVertices < bestCountNewVertices || distance < bestDistance)
+						{
+							bestTriangle = triangle;
+							bestCountNewVertices = countNewVertices;
+							bestDistance = distance;
+						}
+					}
+					candidates.Resize(countCandidates);
+
+					// Continuing with the next unused triangle, if the meshlet has no adjacent triangle.
+					if (bestTriangle == Core::c_InvalidIndexU && countCandidates == 0)
+					{
+						while (nextSeed < countTriangles && isTriangleUsed[nextSeed]) nextSeed++;
+						if (nextSeed < countTriangles
+							&& countMeshletVertices + getCountNewVertices(nextSeed) <= maximumCountVertices)
+						{
+							bestTriangle = nextSeed;
+						}
+					}
+					if (bestTriangle == Core::c_InvalidIndexU) break;
+
+					// Adding the triangle and its adjacent triangles as candidates.
+					isTriangleUsed[bestTriangle] = 1;
+					countUsedTriangles++;
+					meshletTriangles.PushBack(bestTriangle);
+					centroidSum += centroids[bestTriangle];
+					for (unsigned j = 0; j < 3; j++)
+					{
+						unsigned vertex = indices[3 * bestTriangle + j];
+						if (vertexMarks[vertex] == meshletIndex) continue;
+						vertexMarks[vertex] = meshletIndex;
+						countMeshletVertices++;
+						for (unsigned k = vertexTriangleOffsets[vertex]; k < vertexTriangleOffsets[vertex + 1]; k++)
+						{
+							unsigned triangle = vertexTriangles[k];
+							if (isTriangleUsed[triangle] || candidateMarks[triangle] == meshletIndex) continue;
+							candidateMarks[triangle] = meshletIndex;
+							candidates.PushBack(triangle);
+						}
+					}
+				}
+
+				// The triangles keep their original order in the meshlet, which preserves the vertex cache locality.
+				std::sort(meshletTriangles.GetArray(), meshletTriangles.GetEndPointer());
+				Meshlet meshlet;
+				meshlet.BaseIndex = (countUsedTriangles - meshletTriangles.GetSize()) * 3;
+				meshlet.CountIndices = meshletTriangles.GetSize() * 3;
+				meshlet.CountVertices = countMeshletVertices;
+				auto meshletIndices = newIndices.GetArray() + meshlet.BaseIndex;
+				for (unsigned i = 0; i < meshletTriangles.GetSize(); i++)
+				{
+					memcpy(meshletIndices + 3 * i, indices + 3 * meshletTriangles[i], 3 * sizeof(unsigned));
+				}
+				ComputeMeshletBounds(meshlet, meshletIndices, positions, normals.GetArray(),
+					meshletTriangles.GetArray(), points);
+				meshlets.PushBack(meshlet);
+			}
+
+			memcpy(indices, newIndices.GetArray(), countTriangles * 3 * sizeof(unsigned));
+		}
+
+		void BuildMeshlets(const Vertex_SOA_Data& vertexData, IndexData& indexData,
+			const MeshGeometryData* meshes, unsigned countMeshes, const MeshletBuildOptionsType& options,
+			Core::SimpleTypeVectorU<Meshlet>& meshlets, Core::SimpleTypeVectorU<MeshletRange>& meshletRanges)
+		{
+			if (indexData.Topology != PrimitiveTopology::TriangleList)
+				RaiseException("Meshlets can only be built from triangle lists.");
+			if (!vertexData.InputLayout.HasPositions()
+				|| vertexData.InputLayout.GetVertexElement(c_PositionVertexElement.Name.c_str()) != c_PositionVertexElement)
+				RaiseException("Meshlets can only be built from floating point positions.");
+
+			auto positions = vertexData.GetPositions();
+			for (unsigned i = 0; i < countMeshes; i++)
+			{
+				auto& mesh = meshes[i];
+				unsigned baseMeshlet = meshlets.GetSize();
+				BuildMeshlets(indexData.Data.GetArray() + mesh.BaseIndex, mesh.CountIndices,
+					positions + mesh.BaseVertex, mesh.CountVertices, options, meshlets);
+				meshletRanges.PushBack(MeshletRange{ baseMeshlet, meshlets.GetSize() - baseMeshlet });
+			}
+		}
+	}
+}
@@ -0,0 +1,83 @@
+// EngineBuildingBlocks/Graphics/Primitives/Meshlet.h
+
+#ifndef _ENGINEBUILDINGBLOCKS_MESHLET_H_INCLUDED_
+#define _ENGINEBUILDINGBLOCKS_MESHLET_H_INCLUDED_
+
+#include <Core/DataStructures/SimpleTypeVector.hpp>
+#include <Core/SimpleBinarySerialization.hpp>
+#include <EngineBuildingBlocks/Graphics/Primitives/Primitive.h>
+#include <EngineBuildingBlocks/Math/GLM.h>
+
+namespace EngineBuildingBlocks
+{
+	namespace Graphics
+	{
+		struct MeshletBuildOptionsType
+		{
+			bool IsBuildingMeshlets;
+			unsigned MaximumCountVertices;
+			unsigned MaximumCountTriangles;
+
+			MeshletBuildOptionsType(bool isBuildingMeshlets = false);
+
+			bool operator==(const MeshletBuildOptionsType& other) const;
+			bool operator!=(const MeshletBuildOptionsType& other) const;
+			bool operator<(const MeshletBuildOptionsType& other) const;
+
+			void SerializeSB(Core::ByteVector& bytes) const;
+		};
+
+		// A cluster of adjacent triangles of a mesh. The triangles of a meshlet are contiguous in the index range
+		// of the mesh, thus a meshlet can be drawn as a part of the mesh.
+		struct Meshlet
+		{
+			// Relative to the base index of the mesh.
+			unsigned BaseIndex;
+			unsigned CountIndices;
+			unsigned CountVertices;
+
+			// The bounding sphere of the triangles in the model space.
+			glm::vec3 Center;
+			float Radius;
+
+			// The normal cone of the triangles: the sine of the half angle of the cone, which contains the normals.
+			// The cutoff is 1 if the normals are not in a half space, in which case the meshlet is never backfacing.
+			glm::vec3 ConeAxis;
+			float ConeCutoff;
+		};
+
+		// The meshlets of a mesh.
+		struct MeshletRange
+		{
+			unsigned BaseMeshlet;
+			unsigned CountMeshlets;
+		};
+
+		// Returns true if all triangles of the meshlet are backfacing from the given position in the model space.
+		inline bool IsMeshletBackfacing(const Meshlet& meshlet, const glm::vec3& viewPosition)
+		{
+			// The directions to all points of the bounding sphere must be out of the cone.
+			auto direction = meshlet.Center - viewPosition;
+			return (glm::dot(direction, meshlet.ConeAxis)
+				>= meshlet.ConeCutoff * (glm::length(direction) + meshlet.Radius) + meshlet.Radius);
+		}
+
+		// The functions work with triangle lists. The triangles of the mesh are reordered, so the triangles
+		// of a meshlet are contiguous. The meshlets are grown from the triangles in their original order by adding
+		// the adjacent triangle which adds the least new vertices and is the closest to the meshlet.
+
+		void BuildMeshlets(unsigned* indices, unsigned countIndices, const glm::vec3* positions,
+			unsigned countVertices, const MeshletBuildOptionsType& options, Core::SimpleTypeVectorU<Meshlet>& meshlets);
+
+		// Builds the meshlets of each mesh of shared buffers. The meshlets are appended to the vector, and the range
+		// of the meshlets of each mesh is stored. Requires positions.
+		void BuildMeshlets(const Vertex_SOA_Data& vertexData, IndexData& indexData,
+			const MeshGeometryData* meshes, unsigned countMeshes, const MeshletBuildOptionsType& options,
+			Core::SimpleTypeVectorU<Meshlet>& meshlets, Core::SimpleTypeVectorU<MeshletRange>& meshletRanges);
+	}
+}
+
+CORE_BITWISE_SERIALIZABLE_SB(EngineBuildingBlocks::Graphics::Meshlet)
+CORE_BITWISE_SERIALIZABLE_SB(EngineBuildingBlocks::Graphics::MeshletRange)
+
+#endif
@@ -7,7 +7,9 @@
 #include <Core/String.hpp>
 #include <Core/AlgorithmExtensions.hpp>
 #include <Core/System/SimpleIO.h>
+#include <Core/System/MemoryMappedFile.h>
 #include <Core/System/Filesystem.h>
+#include <Core/System/ThreadPool.h>
 #include <EngineBuildingBlocks/PathHandler.h>
 #include <EngineBuildingBlocks/ResourceDatabase.h>
 #include <EngineBuildingBlocks/ErrorHandling.h>
@@ -16,13 +18,17 @@
 #include <EngineBuildingBlocks/Graphics/Primitives/AssimpExtensions/SXMLSerialization.h>
 
 #include <assimp/config.h>
+#include <assimp/DefaultIOSystem.h>
 #include <assimp/Exporter.hpp>
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 
+#include <chrono>
 #include <queue>
 #include <cassert>
+#include <cstring>
+#include <exception>
 
 using namespace EngineBuildingBlocks;
 using namespace EngineBuildingBlocks::Graphics;
@@ -89,6 +95,7 @@ GeometryBuildOptions::GeometryBuildOptions()
 	, IsFindingInvalidData(true)
 	, BoneWeightEpsilon(0.0f)
 	, IsForcingTextureCoordinates(true)
+	, IsCompressingIndices(false)
 {
 }
 
@@ -104,6 +111,11 @@ bool GeometryBuildOptions::operator==(const GeometryBuildOptions& other)const
 	NumericalEqualCompareBlock(BoneWeightEpsilon);
 	BoolEqualCompareBlock(IsForcingTextureCoordinates);
 	StructureEqualCompareBlock(MeshSplitOptions);
+	StructureEqualCompareBlock(MeshOptimizationOptions);
+	StructureEqualCompareBlock(VertexQuantizationOptions);
+	StructureEqualCompareBlock(MeshletBuildOptions);
+	StructureEqualCompareBlock(MeshSimplificationOptions);
+	BoolEqualCompareBlock(IsCompressingIndices);
 	return true;
 }
 
@@ -124,6 +136,11 @@ bool GeometryBuildOptions::operator<(const GeometryBuildOptions& other)const
 	NumericalLessCompareBlock(BoneWeightEpsilon);
 	BoolLessCompareBlock(IsForcingTextureCoordinates);
 	StructureLessCompareBlock(MeshSplitOptions);
+	StructureLessCompareBlock(MeshOptimizationOptions);
+	StructureLessCompareBlock(VertexQuantizationOptions);
+	StructureLessCompareBlock(MeshletBuildOptions);
+	StructureLessCompareBlock(MeshSimplificationOptions);
+	BoolLessCompareBlock(IsCompressingIndices);
 	return false;
 }
 
@@ -139,6 +156,11 @@ void GeometryBuildOptions::SerializeSB(Core::ByteVector& bytes) const
 	Core::SerializeSB(bytes, BoneWeightEpsilon);
 	Core::SerializeSB(bytes, IsForcingTextureCoordinates);
 	Core::SerializeSB(bytes, MeshSplitOptions);
+	Core::SerializeSB(bytes, MeshOptimizationOptions);
+	Core::SerializeSB(bytes, VertexQuantizationOptions);
+	Core::SerializeSB(bytes, MeshletBuildOptions);
+	Core::SerializeSB(bytes, MeshSimplificationOptions);
+	Core::SerializeSB(bytes, IsCompressingIndices);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -200,8 +222,13 @@ bool ModelBuildingDescription::operator<(const ModelBuildingDescription& other)
 	return false;
 }
 
+// The version of the built model file format. Since the serialized building description identifies
+// the built resource, increasing the version causes the outdated built models to be rebuilt.
+const unsigned c_BuiltModelFormatVersion = 6;
+
 void ModelBuildingDescription::SerializeSB(Core::ByteVector& bytes) const
 {
+	Core::SerializeSB(bytes, c_BuiltModelFormatVersion);
 	Core::SerializeSB(bytes, IsBuiltModel);
 	Core::SerializeSB(bytes, FilePath);
 	Core::SerializeSB(bytes, GeometryOptions);
@@ -275,25 +302,6 @@ void ModelLoadingDescription::SerializeSB(Core::ByteVector& bytes) const
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void MeshGeometryData::SerializeSB(Core::ByteVector& bytes) const
-{
-	Core::SerializeSB(bytes, CountVertices);
-	Core::SerializeSB(bytes, CountIndices);
-	Core::SerializeSB(bytes, BaseVertex);
-	Core::SerializeSB(bytes, BaseIndex);
-}
-
-void MeshGeometryData::DeserializeSB(const unsigned char*& bytes)
-{
-	Core::DeserializeSB(bytes, CountVertices);
-	Core::DeserializeSB(bytes, CountIndices);
-	Core::DeserializeSB(bytes, BaseVertex);
-	Core::DeserializeSB(bytes, BaseIndex);
-}
-
-////////////////////////////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////////////////////////
-
 void MaterialData::SerializeSB(Core::ByteVector& bytes) const
 {
 	Core::SerializeSB(bytes, Name);
@@ -338,23 +346,6 @@ void ObjectData::DeserializeSB(const unsigned char*& bytes)
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void SceneNodeData::SerializeSB(Core::ByteVector& bytes) const
-{
-	Core::SerializeSB(bytes, ParentIndex);
-	Core::SerializeSB(bytes, Core::ToPlaceHolder(LocalTransformation));
-	Core::SerializeSB(bytes, UpdateLevel);
-}
-
-void SceneNodeData::DeserializeSB(const unsigned char*& bytes)
-{
-	Core::DeserializeSB(bytes, ParentIndex);
-	Core::DeserializeSB(bytes, Core::ToPlaceHolder(LocalTransformation));
-	Core::DeserializeSB(bytes, UpdateLevel);
-}
-
-////////////////////////////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////////////////////////
-
 Core::IndexVectorU BuiltModel::GetGlobalIndices() const
 {
 	auto& indices = Indices.Data;
@@ -390,7 +381,16 @@ void BuiltModel::SerializeSB(Core::ByteVector& bytes) const
 	Core::SerializeSB(bytes, Vertices);
 	Core::SerializeSB(bytes, Indices);
 	Core::SerializeSB(bytes, NonAnimatedBox);
+	Core::SerializeSB(bytes, MeshLocalBounds);
+	Core::SerializeSB(bytes, NonAnimatedObjectBoxes);
 	Core::SerializeSB(bytes, Textures);
+	Core::SerializeSB(bytes, OptimizationStatistics);
+	Core::SerializeSB(bytes, QuantizationErrors);
+	Core::SerializeSB(bytes, Meshlets);
+	Core::SerializeSB(bytes, MeshletRanges);
+	Core::SerializeSB(bytes, LODIndices);
+	Core::SerializeSB(bytes, LODs);
+	Core::SerializeSB(bytes, LODRanges);
 }
 
 void BuiltModel::DeserializeSB(const unsigned char*& bytes)
@@ -405,7 +405,294 @@ void BuiltModel::DeserializeSB(const unsigned char*& bytes)
 	Core::DeserializeSB(bytes, Vertices);
 	Core::DeserializeSB(bytes, Indices);
 	Core::DeserializeSB(bytes, NonAnimatedBox);
+	Core::DeserializeSB(bytes, MeshLocalBounds);
+	Core::DeserializeSB(bytes, NonAnimatedObjectBoxes);
 	Core::DeserializeSB(bytes, Textures);
+	Core::DeserializeSB(bytes, OptimizationStatistics);
+	Core::DeserializeSB(bytes, QuantizationErrors);
+	Core::DeserializeSB(bytes, Meshlets);
+	Core::DeserializeSB(bytes, MeshletRanges);
+	Core::DeserializeSB(bytes, LODIndices);
+	Core::DeserializeSB(bytes, LODs);
+	Core::DeserializeSB(bytes, LODRanges);
+}
+
+namespace
+{
+	const std::uint32_t c_SceneChunkId = Core::MakeFourCC('S', 'C', 'E', 'N');
+	const std::uint32_t c_MaterialChunkId = Core::MakeFourCC('M', 'A', 'T', 'L');
+	const std::uint32_t c_AnimationChunkId = Core::MakeFourCC('A', 'N', 'I', 'M');
+	const std::uint32_t c_BoneChunkId = Core::MakeFourCC('B', 'O', 'N', 'E');
+	const std::uint32_t c_VertexChunkId = Core::MakeFourCC('V', 'E', 'R', 'T');
+	const std::uint32_t c_IndexChunkId = Core::MakeFourCC('I', 'N', 'D', 'X');
+	const std::uint32_t c_TextureChunkId = Core::MakeFourCC('T', 'E', 'X', 'R');
+	const std::uint32_t c_StatisticsChunkId = Core::MakeFourCC('S', 'T', 'A', 'T');
+	const std::uint32_t c_MeshletChunkId = Core::MakeFourCC('M', 'S', 'H', 'L');
+	const std::uint32_t c_LODChunkId = Core::MakeFourCC('L', 'O', 'D', 'S');
+
+	// The indices are encoded in segments: a segment for each mesh if the meshes cover the indices
+	// contiguously, otherwise a single segment. The encoding of a segment is stored in its first byte.
+	void SerializeIndices(const BuiltModel& builtModel, bool isCompressingIndices,
+		Core::StreamSerializerSB& serializer)
+	{
+		auto& indices = builtModel.Indices.Data;
+		auto& meshes = builtModel.Meshes;
+		unsigned countIndices = indices.GetSize();
+		unsigned countMeshes = meshes.GetSize();
+
+		Core::IndexVectorU segmentSizes;
+		unsigned baseIndex = 0;
+		for (unsigned i = 0; i < countMeshes && meshes[i].BaseIndex == baseIndex; i++)
+		{
+			segmentSizes.PushBack(meshes[i].CountIndices);
+			baseIndex += meshes[i].CountIndices;
+		}
+		if (baseIndex != countIndices)
+		{
+			segmentSizes.Clear();
+			segmentSizes.PushBack(countIndices);
+		}
+
+		Core::ByteVectorU encodedIndices;
+		baseIndex = 0;
+		for (unsigned i = 0; i < segmentSizes.GetSize(); i++)
+		{
+			auto segmentIndices = indices.GetArray() + baseIndex;
+			auto encoding = (isCompressingIndices ? IndexEncoding::Compressed
+				: GetSmallestIndexEncoding(segmentIndices, segmentSizes[i]));
+			encodedIndices.PushBack(static_cast<unsigned char>(encoding));
+			EncodeIndices(segmentIndices, segmentSizes[i], encoding, encodedIndices);
+			baseIndex += segmentSizes[i];
+		}
+
+		serializer.Serialize(builtModel.Indices.Topology);
+		serializer.Serialize(segmentSizes);
+		serializer.SerializeAligned(encodedIndices);
+	}
+
+	void DeserializeIndices(BuiltModel& builtModel, Core::StreamDeserializerSB& deserializer)
+	{
+		Core::IndexVectorU segmentSizes;
+		Core::ArrayView<unsigned char> encodedIndices;
+		deserializer.Deserialize(builtModel.Indices.Topology);
+		deserializer.Deserialize(segmentSizes);
+		deserializer.DeserializeView(encodedIndices);
+
+		unsigned countIndices = 0;
+		for (unsigned i = 0; i < segmentSizes.GetSize(); i++) countIndices += segmentSizes[i];
+		auto& indices = builtModel.Indices.Data;
+		indices.Resize(countIndices);
+
+		auto bytes = encodedIndices.GetArray();
+		auto end = encodedIndices.GetEndPointer();
+		unsigned baseIndex = 0;
+		for (unsigned i = 0; i < segmentSizes.GetSize(); i++)
+		{
+			if (bytes == end) RaiseException("The indices of the built model are incomplete.");
+			auto encoding = static_cast<IndexEncoding>(*bytes++);
+			bytes = DecodeIndices(bytes, end, encoding, indices.GetArray() + baseIndex, segmentSizes[i]);
+			baseIndex += segmentSizes[i];
+		}
+	}
+
+	// The indices of the levels of detail are encoded in a single segment.
+	void SerializeLODs(const BuiltModel& builtModel, bool isCompressingIndices, Core::StreamSerializerSB& serializer)
+	{
+		auto& indices = builtModel.LODIndices;
+		auto encoding = (isCompressingIndices ? IndexEncoding::Compressed
+			: GetSmallestIndexEncoding(indices.GetArray(), indices.GetSize()));
+		Core::ByteVectorU encodedIndices;
+		encodedIndices.PushBack(static_cast<unsigned char>(encoding));
+		EncodeIndices(indices.GetArray(), indices.GetSize(), encoding, encodedIndices);
+
+		serializer.Serialize(builtModel.LODs);
+		serializer.Serialize(builtModel.LODRanges);
+		serializer.Serialize(indices.GetSize());
+		serializer.SerializeAligned(encodedIndices);
+	}
+
+	void DeserializeLODs(BuiltModel& builtModel, Core::StreamDeserializerSB& deserializer)
+	{
+		unsigned countIndices;
+		Core::ArrayView<unsigned char> encodedIndices;
+		deserializer.Deserialize(builtModel.LODs);
+		deserializer.Deserialize(builtModel.LODRanges);
+		deserializer.Deserialize(countIndices);
+		deserializer.DeserializeView(encodedIndices);
+
+		auto bytes = encodedIndices.GetArray();
+		auto end = encodedIndices.GetEndPointer();
+		if (bytes == end) RaiseException("The level of detail indices of the built model are incomplete.");
+		auto encoding = static_cast<IndexEncoding>(*bytes++);
+		builtModel.LODIndices.Resize(countIndices);
+		DecodeIndices(bytes, end, encoding, builtModel.LODIndices.GetArray(), countIndices);
+	}
+
+	struct ChunkTask
+	{
+		unsigned ChunkIndex;
+		unsigned TextureIndex;
+	};
+
+	void DeserializeChunk(BuiltModel& builtModel, const Core::ChunkedContainerReader& reader,
+		const ChunkTask& task)
+	{
+		auto data = reader.GetVerifiedChunkData(task.ChunkIndex);
+		Core::MemoryInputSourceSB source(data.GetArray(), data.GetSize());
+		Core::StreamDeserializerSB deserializer(source);
+
+		switch (reader.GetChunkInfo(task.ChunkIndex).Id)
+		{
+		case c_SceneChunkId:
+			deserializer.Deserialize(builtModel.SceneNodes);
+			deserializer.Deserialize(builtModel.Objects);
+			deserializer.Deserialize(builtModel.Meshes);
+			deserializer.Deserialize(builtModel.SceneNodeNames);
+			deserializer.Deserialize(builtModel.NonAnimatedBox);
+			deserializer.Deserialize(builtModel.MeshLocalBounds);
+			deserializer.Deserialize(builtModel.NonAnimatedObjectBoxes);
+			break;
+		case c_MaterialChunkId: deserializer.Deserialize(builtModel.Materials); break;
+		case c_AnimationChunkId: deserializer.Deserialize(builtModel.SkeletalAnimations); break;
+		case c_BoneChunkId: deserializer.Deserialize(builtModel.BoneData); break;
+		case c_VertexChunkId: builtModel.Vertices.DeserializeStreamSB(deserializer); break;
+		case c_IndexChunkId: DeserializeIndices(builtModel, deserializer); break;
+		case c_TextureChunkId: deserializer.Deserialize(builtModel.Textures[task.TextureIndex]); break;
+		case c_StatisticsChunkId:
+			deserializer.Deserialize(builtModel.OptimizationStatistics);
+			deserializer.Deserialize(builtModel.QuantizationErrors);
+			break;
+		case c_MeshletChunkId:
+			deserializer.Deserialize(builtModel.Meshlets);
+			deserializer.Deserialize(builtModel.MeshletRanges);
+			break;
+		case c_LODChunkId: DeserializeLODs(builtModel, deserializer); break;
+		}
+	}
+
+	// The exceptions are stored per thread and rethrown after joining the threads.
+	void DeserializeChunksInThread(unsigned threadIndex, unsigned startIndex, unsigned endIndex,
+		BuiltModel* builtModel, const Core::ChunkedContainerReader* reader, const ChunkTask* tasks,
+		std::exception_ptr* exceptions)
+	{
+		try
+		{
+			for (unsigned i = startIndex; i < endIndex; i++)
+			{
+				DeserializeChunk(*builtModel, *reader, tasks[i]);
+			}
+		}
+		catch (...)
+		{
+			exceptions[threadIndex] = std::current_exception();
+		}
+	}
+}
+
+void BuiltModel::SerializeChunksSB(Core::ChunkedContainerWriter& writer, bool isCompressingIndices) const
+{
+	{
+		Core::StreamSerializerSB serializer(writer.BeginChunk(c_SceneChunkId));
+		serializer.Serialize(SceneNodes);
+		serializer.Serialize(Objects);
+		serializer.Serialize(Meshes);
+		serializer.Serialize(SceneNodeNames);
+		serializer.Serialize(NonAnimatedBox);
+		serializer.Serialize(MeshLocalBounds);
+		serializer.Serialize(NonAnimatedObjectBoxes);
+		writer.EndChunk();
+	}
+	{
+		Core::StreamSerializerSB serializer(writer.BeginChunk(c_MaterialChunkId));
+		serializer.Serialize(Materials);
+		writer.EndChunk();
+	}
+	{
+		Core::StreamSerializerSB serializer(writer.BeginChunk(c_AnimationChunkId));
+		serializer.Serialize(SkeletalAnimations);
+		writer.EndChunk();
+	}
+	{
+		Core::StreamSerializerSB serializer(writer.BeginChunk(c_BoneChunkId));
+		serializer.Serialize(BoneData);
+		writer.EndChunk();
+	}
+	{
+		Core::StreamSerializerSB serializer(writer.BeginChunk(c_VertexChunkId));
+		Vertices.SerializeStreamSB(serializer);
+		writer.EndChunk();
+	}
+	{
+		Core::StreamSerializerSB serializer(writer.BeginChunk(c_IndexChunkId));
+		SerializeIndices(*this, isCompressingIndices, serializer);
+		writer.EndChunk();
+	}
+	for (auto& texture : Textures)
+	{
+		Core::StreamSerializerSB serializer(writer.BeginChunk(c_TextureChunkId));
+		serializer.Serialize(texture);
+		writer.EndChunk();
+	}
+	{
+		Core::StreamSerializerSB serializer(writer.BeginChunk(c_StatisticsChunkId));
+		serializer.Serialize(OptimizationStatistics);
+		serializer.Serialize(QuantizationErrors);
+		writer.EndChunk();
+	}
+	if (Meshlets.GetSize() > 0)
+	{
+		Core::StreamSerializerSB serializer(writer.BeginChunk(c_MeshletChunkId));
+		serializer.Serialize(Meshlets);
+		serializer.Serialize(MeshletRanges);
+		writer.EndChunk();
+	}
+	if (LODs.GetSize() > 0)
+	{
+		Core::StreamSerializerSB serializer(writer.BeginChunk(c_LODChunkId));
+		SerializeLODs(*this, isCompressingIndices, serializer);
+		writer.EndChunk();
+	}
+}
+
+void BuiltModel::DeserializeChunksSB(const Core::ChunkedContainerReader& reader, Core::ThreadPool* threadPool)
+{
+	// Creating the tasks. The textures are stored in the order of their chunks.
+	// Unknown chunks are ignored.
+	Core::SimpleTypeVectorU<ChunkTask> tasks;
+	unsigned countTextures = 0;
+	unsigned countChunks = reader.GetCountChunks();
+	for (unsigned i = 0; i < countChunks; i++)
+	{
+		switch (reader.GetChunkInfo(i).Id)
+		{
+		case c_SceneChunkId: case c_MaterialChunkId: case c_AnimationChunkId: case c_BoneChunkId:
+		case c_VertexChunkId: case c_IndexChunkId: case c_StatisticsChunkId: case c_MeshletChunkId: case c_LODChunkId:
+			tasks.PushBack(ChunkTask{ i, Core::c_InvalidIndexU });
+			break;
+		case c_TextureChunkId:
+			tasks.PushBack(ChunkTask{ i, countTextures++ });
+			break;
+		}
+	}
+	Textures.clear();
+	Textures.resize(countTextures);
+
+	// The chunks write disjoint members, therefore they can be deserialized in parallel.
+	unsigned countTasks = tasks.GetSize();
+	std::vector<std::exception_ptr> exceptions(threadPool != nullptr ? threadPool->GetCountThreads() : 1);
+	if (threadPool != nullptr && countTasks > 1)
+	{
+		threadPool->ExecuteWithStaticScheduling(countTasks, &DeserializeChunksInThread,
+			this, &reader, tasks.GetArray(), exceptions.data());
+	}
+	else
+	{
+		DeserializeChunksInThread(0, 0, countTasks, this, &reader, tasks.GetArray(), exceptions.data());
+	}
+	for (auto& exception : exceptions)
+	{
+		if (exception) std::rethrow_exception(exception);
+	}
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -721,25 +1008,30 @@ inline ScaledTransformation GetSceneNodeTransformation(const BuiltModel& builtMo
 	return { parentTr.A * localTr.A, parentTr.A * localTr.Position + parentTr.Position };
 }
 
-inline void ComputeNonAnimatedBox(BuiltModel& builtModel)
+// The bounds are computed from the final floating point positions, thus before the quantization.
+inline void ComputeGeometryBounds(BuiltModel& builtModel, Core::ThreadPool* threadPool)
 {
-	auto box = EngineBuildingBlocks::Math::c_InvalidAABB;
-	unsigned countObjects = builtModel.Objects.GetSize();
+	auto positions = builtModel.Vertices.GetPositions();
+	auto& meshes = builtModel.Meshes;
+	auto& objects = builtModel.Objects;
+	unsigned countObjects = objects.GetSize();
+
+	ComputeMeshBounds(positions, meshes.GetArray(), meshes.GetSize(), builtModel.MeshLocalBounds, threadPool);
+
+	Core::IndexVectorU objectMeshIndices(countObjects);
+	Core::SimpleTypeVectorU<ScaledTransformation> objectTransformations(countObjects);
 	for (unsigned i = 0; i < countObjects; i++)
 	{
-		auto& obj = builtModel.Objects[i];
-		auto& mesh = builtModel.Meshes[obj.MeshIndex];
-
-		auto transformation = GetSceneNodeTransformation(builtModel, obj.SceneNodeIndex);
+		objectMeshIndices[i] = objects[i].MeshIndex;
+		objectTransformations[i] = GetSceneNodeTransformation(builtModel, objects[i].SceneNodeIndex);
+	}
+	ComputeTransformedMeshBoxes(positions, meshes.GetArray(), objectMeshIndices.GetArray(),
+		objectTransformations.GetArray(), countObjects, builtModel.NonAnimatedObjectBoxes, threadPool);
 
-		auto positions = builtModel.Vertices.GetPositions();
-		unsigned limitVertex = mesh.BaseVertex + mesh.CountVertices;
-		for (unsigned i = mesh.BaseVertex; i < limitVertex; i++)
-		{
-			auto transformedPosition = transformation.A * positions[i] + transformation.Position;
-			box.Minimum = glm::min(box.Minimum, transformedPosition);
-			box.Maximum = glm::max(box.Maximum, transformedPosition);
-		}
+	auto box = EngineBuildingBlocks::Math::c_InvalidAABB;
+	for (unsigned i = 0; i < countObjects; i++)
+	{
+		box = EngineBuildingBlocks::Math::AABoundingBox::Union(box, builtModel.NonAnimatedObjectBoxes[i]);
 	}
 	builtModel.NonAnimatedBox = box;
 }
@@ -920,6 +1212,71 @@ inline void CreateBoneData(const aiScene* scene, BuiltModel& builtModel,
 	builtModel.BoneData.SetInfluenceVector(influenceVector);
 }
 
+inline void OptimizeGeometry(BuiltModel& builtModel, const GeometryBuildOptions& geometryOptions)
+{
+	auto& meshes = builtModel.Meshes;
+	unsigned countMeshes = meshes.GetSize();
+	unsigned countMeshVertices = 0;
+	for (unsigned i = 0; i < countMeshes; i++) countMeshVertices += meshes[i].CountVertices;
+
+	// The vertices of the skipped meshes are missing from the vertex buffer.
+	if (countMeshes == 0 || countMeshVertices != builtModel.Vertices.GetCountVertices()) return;
+
+	auto options = geometryOptions.MeshOptimizationOptions;
+	if (builtModel.BoneData.GetCountBones() > 0) options.IsWeldingVertices = false;
+
+	Core::IndexVectorU vertexRemap;
+	builtModel.OptimizationStatistics = OptimizeMeshes(builtModel.Vertices, builtModel.Indices,
+		meshes.GetArray(), countMeshes, options, &vertexRemap);
+
+	// Moving the bone influences with their vertices.
+	auto influenceVector = builtModel.BoneData.GetInfluenceVector();
+	BoneInfluenceVector remappedInfluenceVector(builtModel.Vertices.GetCountVertices());
+	for (unsigned i = 0; i < vertexRemap.GetSize(); i++)
+	{
+		if (vertexRemap[i] != Core::c_InvalidIndexU) remappedInfluenceVector[vertexRemap[i]] = std::move(influenceVector[i]);
+	}
+	builtModel.BoneData.SetInfluenceVector(remappedInfluenceVector);
+}
+
+inline void BuildGeometryMeshlets(BuiltModel& builtModel, const GeometryBuildOptions& geometryOptions)
+{
+	builtModel.Meshlets.Clear();
+	builtModel.MeshletRanges.Clear();
+
+	// The meshlets are built from the floating point positions of triangle lists.
+	auto& inputLayout = builtModel.Vertices.InputLayout;
+	if (!geometryOptions.MeshletBuildOptions.IsBuildingMeshlets || builtModel.Meshes.GetSize() == 0
+		|| builtModel.Indices.Topology != PrimitiveTopology::TriangleList || !inputLayout.HasPositions()
+		|| inputLayout.GetVertexElement(c_PositionVertexElement.Name.c_str()) != c_PositionVertexElement) return;
+
+	BuildMeshlets(builtModel.Vertices, builtModel.Indices, builtModel.Meshes.GetArray(), builtModel.Meshes.GetSize(),
+		geometryOptions.MeshletBuildOptions, builtModel.Meshlets, builtModel.MeshletRanges);
+}
+
+inline void GenerateGeometryLODs(BuiltModel& builtModel, const GeometryBuildOptions& geometryOptions,
+	Core::ThreadPool* threadPool)
+{
+	builtModel.LODIndices.Clear();
+	builtModel.LODs.Clear();
+	builtModel.LODRanges.Clear();
+
+	// The levels of detail are generated from the floating point positions of triangle lists.
+	auto& inputLayout = builtModel.Vertices.InputLayout;
+	if (!geometryOptions.MeshSimplificationOptions.IsGeneratingLODs || builtModel.Meshes.GetSize() == 0
+		|| builtModel.Indices.Topology != PrimitiveTopology::TriangleList || !inputLayout.HasPositions()
+		|| inputLayout.GetVertexElement(c_PositionVertexElement.Name.c_str()) != c_PositionVertexElement) return;
+
+	// The bone influences must be known for all vertices.
+	auto& boneData = builtModel.BoneData;
+	bool isSkinned = (boneData.GetCountBones() > 0);
+	if (isSkinned && boneData.GetCountVertices() != builtModel.Vertices.GetCountVertices()) return;
+
+	GenerateMeshLODs(builtModel.Vertices, builtModel.Indices, builtModel.Meshes.GetArray(), builtModel.Meshes.GetSize(),
+		geometryOptions.MeshSimplificationOptions, builtModel.LODIndices, builtModel.LODs, builtModel.LODRanges,
+		isSkinned ? &boneData : nullptr, threadPool);
+}
+
 inline bool RemoveAnimationFrameDuplicates(BuiltModel& builtModel, const AnimationBuildOptions& animationOptions)
 {
 	bool hasDuplicate = false;
@@ -1181,6 +1538,7 @@ inline void InstantiateSceneNodes(const ModelInstantiationDescription& instantia
 ModelLoader::ModelLoader(PathHandler* pathHandler, ResourceDatabase* resourceDatabase)
 	: m_PathHandler(pathHandler)
 	, m_ResourceDatabase(resourceDatabase)
+	, m_ThreadPool(nullptr)
 	, m_Importer(std::make_unique<Assimp::Importer>())
 	, m_Exporter(std::make_unique<Assimp::Exporter>())
 {
@@ -1191,73 +1549,90 @@ ModelLoader::~ModelLoader()
 {
 }
 
+void ModelLoader::SetThreadPool(Core::ThreadPool* threadPool)
+{
+	m_ThreadPool = threadPool;
+}
+
 inline void HandleModelPath(EngineBuildingBlocks::PathHandler* pathHandler, std::string& filePath)
 {
 	if (Core::IsRelativePath(filePath))
 		filePath = pathHandler->GetPathFromResourcesDirectory("Models/" + filePath);
 }
 
-ModelLoadingResult ModelLoader::Load(const ModelLoadingDescription& description,
-	Vertex_SOA_Data& vertexData, IndexData& indexData)
+inline bool IsBuiltResourceValid(const std::string& builtResourceFilePath)
 {
-	// Copying and modifying description.
-	auto descriptionCopy = description;
-	HandleModelPath(m_PathHandler, descriptionCopy.BuildingDescription.FilePath);
-
-	// Getting built resource description.
-	BuiltResourceDescription builtResourceDescription;
-	{
-		ResourceDescription resourceDescription;
-		resourceDescription.IsBuiltResource = descriptionCopy.BuildingDescription.IsBuiltModel;
-		resourceDescription.ResourceFilePath = descriptionCopy.BuildingDescription.FilePath;
-
-		// Serializing model building description.
-		Core::StartSerializeSB(m_Buffer, descriptionCopy.BuildingDescription);
-		resourceDescription.SerializedBuildOptions.PushBack(m_Buffer.GetArray(),
-			static_cast<unsigned>(m_Buffer.GetSize()));
+	if (!Core::FileExists(builtResourceFilePath)) return false;
+	Core::MemoryMappedFile builtResourceFile(builtResourceFilePath);
+	return Core::ChunkedContainerReader::IsValid(builtResourceFile.GetData(), builtResourceFile.GetSize(),
+		c_BuiltModelFormatVersion);
+}
 
-		// Currently dependencies are not set in the resource description.
+// Records the paths of the files, which are opened by the importer, e.g. the material libraries of an OBJ file.
+class RecordingIOSystem : public Assimp::DefaultIOSystem
+{
+public:
 
-		m_ResourceDatabase->GetBuiltResourceDescription(resourceDescription, builtResourceDescription);
-	}
+	std::vector<std::string> OpenedFilePaths;
 
-	// If the resource is not up-to-date, we are building it.
-	auto& builtResourceFilePath = builtResourceDescription.BuiltResourceFilePath;
-	if (!builtResourceDescription.IsUpToDate)
+	Assimp::IOStream* Open(const char* filePath, const char* mode) override
 	{
-		BuildResource(descriptionCopy, builtResourceFilePath);
+		auto stream = Assimp::DefaultIOSystem::Open(filePath, mode);
+		if (stream != nullptr) OpenedFilePaths.push_back(filePath);
+		return stream;
 	}
+};
 
-	// Loading from the built resource.
-	return LoadFromBuiltResource(descriptionCopy, builtResourceFilePath, vertexData, indexData);
-}
-
-void ModelLoader::BuildResource(const ModelLoadingDescription& description,
-	const std::string& builtResourceFilePath)
+// Adds the files, which were read by the import, to the dependency paths: the files opened by the importer
+// and the external textures of the materials. The thread pool is used for the levels of detail and the bounds
+// if it's given.
+void BuildModel(Assimp::Importer* importer, const ModelLoadingDescription& description,
+	const std::string& builtResourceFilePath, BuiltModel& builtModel, std::vector<std::string>& dependencyPaths,
+	Core::ThreadPool* threadPool)
 {
-	// We store the model, so it can be directly accessed without loading.
-	unsigned builtModelIndex = m_BuiltModels.Add();
-	auto& builtModel = m_BuiltModels[builtModelIndex];
-	m_BuiltModelMap[builtResourceFilePath] = builtModelIndex;
-
 	auto& buildingDescription = description.BuildingDescription;
 
 	// Loading resource.
 	{
-		auto& vertices = builtModel.Vertices;
-		auto& indices = builtModel.Indices;
-		auto& vertexInputLayout = builtModel.Vertices.InputLayout;
-
-		// Importing scene.
-		auto scene = ImportScene(m_Importer.get(), buildingDescription);
+		// Importing scene. The importer owns the IO system and deletes it when it's replaced.
+		auto ioSystem = new RecordingIOSystem;
+		importer->SetIOHandler(ioSystem);
+		const aiScene* scene;
+		try
+		{
+			scene = ImportScene(importer, buildingDescription);
+		}
+		catch (...)
+		{
+			importer->SetIOHandler(nullptr);
+			throw;
+		}
+		dependencyPaths.insert(dependencyPaths.end(), ioSystem->OpenedFilePaths.begin(),
+			ioSystem->OpenedFilePaths.end());
+		importer->SetIOHandler(nullptr);
 
 		// Creating components.
 		CreateSceneNodesAndObjects(scene, builtModel, description);
 		CreateGeometry(scene, builtModel, description.BuildingDescription.GeometryOptions);
-		ComputeNonAnimatedBox(builtModel);
 		CreateTexturesAndMaterials(description.BuildingDescription.GetModelBasePath(), scene,
 			builtModel.Textures, builtModel.Materials);
+		for (auto& material : builtModel.Materials)
+		{
+			for (auto textureName : { &material.DiffuseTextureName, &material.OpacityTextureName,
+				&material.NormalTextureName })
+			{
+				// Embedded and replacement textures are not files of the model.
+				if (textureName->empty() || (*textureName)[0] == '*' || *textureName == "white_pixel.png") continue;
+				dependencyPaths.push_back(*textureName);
+			}
+		}
 		CreateBoneData(scene, builtModel, description.BuildingDescription.GeometryOptions);
+		OptimizeGeometry(builtModel, description.BuildingDescription.GeometryOptions);
+		BuildGeometryMeshlets(builtModel, description.BuildingDescription.GeometryOptions);
+		GenerateGeometryLODs(builtModel, description.BuildingDescription.GeometryOptions, threadPool);
+		ComputeGeometryBounds(builtModel, threadPool);
+		QuantizeVertexData(builtModel.Vertices, description.BuildingDescription.GeometryOptions.VertexQuantizationOptions,
+			&builtModel.QuantizationErrors);
 		CreateAnimations(scene, builtModel, buildingDescription.FilePath,
 			description.BuildingDescription.AnimationOptions);
 
@@ -1266,96 +1641,561 @@ void ModelLoader::BuildResource(const ModelLoadingDescription& description,
 	}
 
 	// Saving built resource.
+	SaveBuiltModel(builtModel, builtResourceFilePath, description.BuildingDescription.GeometryOptions.IsCompressingIndices);
+}
+
+void LoadBuiltModel(const std::string& builtResourceFilePath, BuiltModel& builtModel, Core::ThreadPool* threadPool)
+{
+	// The built model is deserialized directly from the mapped pages, which avoids reading
+	// the whole file to an intermediate buffer. The mapped data is page-aligned, therefore
+	// the aligned vertex and index arrays are copied with aligned memory access.
+	// The chunks' checksums are verified when they are deserialized.
+	Core::MemoryMappedFile builtResourceFile(builtResourceFilePath);
+	Core::ChunkedContainerReader reader(builtResourceFile.GetData(), builtResourceFile.GetSize());
+	if (reader.GetContentVersion() != c_BuiltModelFormatVersion)
+		RaiseException("The built model has an invalid format version: " + builtResourceFilePath);
+
+	builtModel.DeserializeChunksSB(reader, threadPool);
+}
+
+// Sets the input layout and the topology of the output buffers if they are empty,
+// otherwise checks whether the model can be appended to them.
+void PrepareGeometryAppending(const BuiltModel& builtModel, Vertex_SOA_Data& vertexData, IndexData& indexData)
+{
+	auto& inputVertices = builtModel.Vertices;
+	auto& outputVertices = vertexData;
+
+	if (outputVertices.InputLayout.Elements.size() > 0)
+	{
+		if (!VertexInputLayout::IsSubset(inputVertices.InputLayout, outputVertices.InputLayout))
+			RaiseException("Cannot propagate vertex buffer: the input layout of the output buffer is not a subset of the input layout of the input buffer.");
+	}
+	else
+	{
+		outputVertices.SetInputLayout(inputVertices.InputLayout);
+
+		if (!inputVertices.InputLayout.HasPositions())
+			RaiseException("Positions were not found in model.");
+		if(!inputVertices.InputLayout.HasTextureCoordinates())
+			RaiseWarning("Texture coordinates were not found in model.");
+		if (!inputVertices.InputLayout.HasNormals())
+			RaiseWarning("Normals were not found in model.");
+	}
+	if (indexData.GetCountIndices() == 0)
 	{
-		Core::StartSerializeSB(m_Buffer, builtModel);
-		Core::WriteAllBytes(builtResourceFilePath, m_Buffer.GetArray(), m_Buffer.GetSize());
+		indexData.Topology = builtModel.Indices.Topology;
+	}
+	else if (indexData.Topology != builtModel.Indices.Topology)
+	{
+		RaiseException("Indiceses with different primitive topologies cannot be appended.");
 	}
 }
 
-ModelLoadingResult ModelLoader::LoadFromBuiltResource(const ModelLoadingDescription& loadingDescription,
-	const std::string& builtResourceFilePath, Vertex_SOA_Data& vertexData, IndexData& indexData)
+// Returns the count of the indices of a single primitive of a list topology.
+inline unsigned GetCountIndicesPerPrimitive(PrimitiveTopology topology)
 {
-	unsigned builtModelIndex;
+	switch (topology)
+	{
+	case PrimitiveTopology::PointList: return 1;
+	case PrimitiveTopology::LineList: return 2;
+	case PrimitiveTopology::TriangleList: return 3;
+	case PrimitiveTopology::LineListWithAdjacency: return 4;
+	case PrimitiveTopology::TriangleListWithAdjacency: return 6;
+	default:
+		if (topology >= PrimitiveTopology::ControlPointPatchList_1 && topology <= PrimitiveTopology::ControlPointPatchList_32)
+		{
+			return static_cast<unsigned>(topology) - static_cast<unsigned>(PrimitiveTopology::ControlPointPatchList_1) + 1;
+		}
+		RaiseException("Faces can only be selected for list topologies.");
+		return 0;
+	}
+}
+
+// The selected part of a built model. The output meshes contain an entry for each mesh of the model,
+// where the meshes, which are not allowed, have no vertices and indices.
+struct PartialGeometry
+{
+	Core::SimpleTypeVectorU<MeshGeometryData> Meshes;
+
+	// The model's vertex index for each selected vertex.
+	Core::IndexVectorU VertexIndices;
+
+	// Mesh-local indices, which refer to the selected vertices, followed by the indices of the levels of detail.
+	Core::IndexVectorU Indices;
+
+	Core::SimpleTypeVectorU<MeshLOD> LODs;
+	Core::SimpleTypeVectorU<MeshLODRange> LODRanges;
+};
+
+// Selects the allowed meshes and faces. The vertices of the meshes, where faces are selected, are compacted:
+// only the vertices, which are referenced by the selected faces, are kept in the order of their first reference.
+void SelectGeometry(const BuiltModel& builtModel, const PartialModelLoadingOptionsType& options,
+	PartialGeometry& geometry)
+{
+	auto& meshes = builtModel.Meshes;
+	auto& inputIndices = builtModel.Indices.Data;
+	unsigned countMeshes = meshes.GetSize();
+
+	std::vector<bool> isMeshAllowed(countMeshes, options.AllowedMeshIndices.IsEmpty());
+	for (unsigned i = 0; i < options.AllowedMeshIndices.GetSize(); i++)
+	{
+		unsigned meshIndex = options.AllowedMeshIndices[i];
+		if (meshIndex >= countMeshes) RaiseException("An allowed mesh index of the partial model loading options is invalid.");
+		isMeshAllowed[meshIndex] = true;
+	}
 
-	// Getting built resource from cache or file.
-	auto rIt = m_BuiltModelMap.find(builtResourceFilePath);
-	if (rIt == m_BuiltModelMap.end())
+	Core::IndexVectorU vertexMap;
+	for (unsigned meshIndex = 0; meshIndex < countMeshes; meshIndex++)
 	{
-		Core::ReadAllBytes(builtResourceFilePath, m_Buffer);
+		auto& inputMesh = meshes[meshIndex];
+		unsigned baseVertex = geometry.VertexIndices.GetSize();
+		unsigned baseIndex = geometry.Indices.GetSize();
 
-		builtModelIndex = m_BuiltModels.Add();
-		Core::StartDeserializeSB(m_Buffer, m_BuiltModels[builtModelIndex]);
+		if (isMeshAllowed[meshIndex])
+		{
+			auto fIt = options.AllowedFaces.find(meshIndex);
+			if (fIt == options.AllowedFaces.end())
+			{
+				for (unsigned i = 0; i < inputMesh.CountVertices; i++) geometry.VertexIndices.PushBack(inputMesh.BaseVertex + i);
+				geometry.Indices.PushBack(inputIndices.GetArray() + inputMesh.BaseIndex, inputMesh.CountIndices);
+			}
+			else
+			{
+				// The faces of the interval are selected with the given step. The last face is inclusive.
+				auto& faces = fIt->second;
+				unsigned countIndicesPerFace = GetCountIndicesPerPrimitive(builtModel.Indices.Topology);
+				unsigned countFaces = inputMesh.CountIndices / countIndicesPerFace;
+				unsigned step = std::max(faces.Step, 1U);
+				unsigned lastFace = std::min(faces.Last, countFaces - 1);
+
+				vertexMap.Resize(inputMesh.CountVertices);
+				vertexMap.SetByte(0xff);
+				auto pInputIndices = inputIndices.GetArray() + inputMesh.BaseIndex;
+				for (unsigned face = faces.First; countFaces > 0 && face <= lastFace; face += step)
+				{
+					for (unsigned i = 0; i < countIndicesPerFace; i++)
+					{
+						unsigned index = pInputIndices[face * countIndicesPerFace + i];
+						auto& outputIndex = vertexMap[index];
+						if (outputIndex == Core::c_InvalidIndexU)
+						{
+							outputIndex = geometry.VertexIndices.GetSize() - baseVertex;
+							geometry.VertexIndices.PushBack(inputMesh.BaseVertex + index);
+						}
+						geometry.Indices.PushBack(outputIndex);
+					}
+					if (lastFace - face < step) break;
+				}
+			}
+		}
 
-		m_BuiltModelMap[builtResourceFilePath] = builtModelIndex;
+		auto& outputMesh = geometry.Meshes.PushBackPlaceHolder();
+		outputMesh.CountVertices = geometry.VertexIndices.GetSize() - baseVertex;
+		outputMesh.CountIndices = geometry.Indices.GetSize() - baseIndex;
+		outputMesh.BaseVertex = baseVertex;
+		outputMesh.BaseIndex = baseIndex;
 	}
-	else
+
+	// The levels of detail are appended for the allowed meshes without selected faces, whose vertices are
+	// not compacted, thus the indices of the levels remain valid.
+	if (builtModel.LODRanges.GetSize() != countMeshes) return;
+	for (unsigned meshIndex = 0; meshIndex < countMeshes; meshIndex++)
 	{
-		builtModelIndex = rIt->second;
+		auto& inputRange = builtModel.LODRanges[meshIndex];
+		auto& outputRange = geometry.LODRanges.PushBackPlaceHolder();
+		outputRange.BaseLOD = geometry.LODs.GetSize();
+		if (isMeshAllowed[meshIndex] && options.AllowedFaces.find(meshIndex) == options.AllowedFaces.end())
+		{
+			for (unsigned i = 0; i < inputRange.CountLODs; i++)
+			{
+				auto& inputLOD = builtModel.LODs[inputRange.BaseLOD + i];
+				geometry.LODs.PushBack({ geometry.Indices.GetSize(), inputLOD.CountIndices, inputLOD.Error });
+				geometry.Indices.PushBack(builtModel.LODIndices.GetArray() + inputLOD.BaseIndex, inputLOD.CountIndices);
+			}
+		}
+		outputRange.CountLODs = geometry.LODs.GetSize() - outputRange.BaseLOD;
 	}
-	auto& builtModel = m_BuiltModels[builtModelIndex];
+}
 
+ModelLoadingResult CreateLoadingResult(unsigned builtModelIndex, const BuiltModel& builtModel,
+	const PartialGeometry* partialGeometry)
+{
 	ModelLoadingResult result;
 	result.ModelIndex = builtModelIndex;
 
-	// Setting vertex and index buffers.
-	assert((builtModel.Meshes.GetSize() > 0) == (builtModel.Objects.GetSize() > 0));
-	if(builtModel.Meshes.GetSize() > 0)
+	// The selected meshes are already compacted.
+	if (partialGeometry != nullptr)
 	{
-		auto& inputVertices = builtModel.Vertices;
-		auto& outputVertices = vertexData;
-		
-		if (outputVertices.InputLayout.Elements.size() > 0)
+		result.Meshes = partialGeometry->Meshes;
+		result.LODs = partialGeometry->LODs;
+		result.LODRanges = partialGeometry->LODRanges;
+		return result;
+	}
+
+	// Copying geometry and meshes.
+	auto& inputMeshes = builtModel.Meshes;
+	auto& outputMeshes = result.Meshes;
+
+	unsigned countInputMeshes = inputMeshes.GetSize();
+	unsigned baseVertex = 0;
+	unsigned baseIndex = 0;
+	for (unsigned meshIndex = 0; meshIndex < countInputMeshes; meshIndex++)
+	{
+		auto& inputGeometryData = inputMeshes[meshIndex];
+		unsigned countInputVertices = inputGeometryData.CountVertices;
+		unsigned countInputIndices = inputGeometryData.CountIndices;
+
+		auto& outputGeometryData = outputMeshes.PushBackPlaceHolder();
+		outputGeometryData.CountVertices = countInputVertices;
+		outputGeometryData.CountIndices = countInputIndices;
+		outputGeometryData.BaseVertex = baseVertex;	// Setting resource-dependent base vertex.
+		outputGeometryData.BaseIndex = baseIndex;	// Setting resource-dependent base index.
+	
+		baseVertex += countInputVertices;
+		baseIndex += countInputIndices;
+	}
+
+	// The indices of the levels of detail follow the indices of the meshes.
+	result.LODs = builtModel.LODs;
+	result.LODRanges = builtModel.LODRanges;
+	for (unsigned i = 0; i < result.LODs.GetSize(); i++) result.LODs[i].BaseIndex += builtModel.Indices.GetCountIndices();
+
+	return result;
+}
+
+MeshGeometryData ModelLoadingResult::SelectMeshGeometry(unsigned meshIndex, float distance, float errorScaler,
+	float projectionScaler, float pixelThreshold) const
+{
+	auto geometry = Meshes[meshIndex];
+	if (LODRanges.GetSize() == 0) return geometry;
+
+	auto& lodRange = LODRanges[meshIndex];
+	unsigned lodIndex = SelectMeshLOD(LODs.GetArray() + lodRange.BaseLOD, lodRange.CountLODs, distance,
+		errorScaler, projectionScaler, pixelThreshold);
+	if (lodIndex != Core::c_InvalidIndexU)
+	{
+		auto& lod = LODs[lodRange.BaseLOD + lodIndex];
+		geometry.BaseIndex = lod.BaseIndex;
+		geometry.CountIndices = lod.CountIndices;
+	}
+	return geometry;
+}
+
+namespace
+{
+	struct ModelBatchTask
+	{
+		const ModelLoadingDescription* Description;
+		const BuiltResourceDescription* BuiltDescription;
+		const ResourceDescription* Resource;
+		BuiltModel* Model;
+
+		// Output of the build.
+		bool IsBuilt;
+		std::vector<std::string> DiscoveredDependencyPaths;
+		double BuildDuration;
+	};
+
+	// Builds or deserializes the models. The exceptions are stored per thread and rethrown after joining the threads.
+	struct ModelBatchLoader
+	{
+		ModelBatchTask* Tasks;
+		Assimp::Importer* const* Importers;
+		Core::ThreadPool* ModelThreadPool;
+		std::exception_ptr* Exceptions;
+
+		void Process(unsigned threadIndex, unsigned startIndex, unsigned endIndex)
+		{
+			try
+			{
+				for (unsigned i = startIndex; i < endIndex; i++)
+				{
+					// A built resource, which is not cached, is also rebuilt if its header or footer is invalid,
+					// e.g. if it was truncated or written by an incompatible version. This check only reads
+					// the first and the last page of the file.
+					auto& task = Tasks[i];
+					auto& builtResourceFilePath = task.BuiltDescription->BuiltResourceFilePath;
+					if (!task.BuiltDescription->IsUpToDate || !IsBuiltResourceValid(builtResourceFilePath))
+					{
+						auto startTime = std::chrono::steady_clock::now();
+						BuildModel(Importers[threadIndex], *task.Description, builtResourceFilePath, *task.Model,
+							task.DiscoveredDependencyPaths, ModelThreadPool);
+						task.BuildDuration = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+						task.IsBuilt = true;
+					}
+					else
+					{
+						LoadBuiltModel(builtResourceFilePath, *task.Model, ModelThreadPool);
+					}
+				}
+			}
+			catch (...)
+			{
+				if (!Exceptions[threadIndex]) Exceptions[threadIndex] = std::current_exception();
+			}
+		}
+	};
+
+	struct GeometryCopyTask
+	{
+		const BuiltModel* Model;
+		const PartialGeometry* Partial;
+		unsigned BaseVertex;
+		unsigned BaseIndex;
+	};
+
+	void CopyGeometry(unsigned threadIndex, unsigned startIndex, unsigned endIndex,
+		const GeometryCopyTask* tasks, Vertex_SOA_Data* vertexData, unsigned char* const* vertexArrays,
+		unsigned* indices)
+	{
+		auto& elements = vertexData->InputLayout.Elements;
+		unsigned countVertexElements = static_cast<unsigned>(elements.size());
+		for (unsigned i = startIndex; i < endIndex; i++)
+		{
+			auto& task = tasks[i];
+			auto& inputVertices = task.Model->Vertices;
+			auto& inputIndices = (task.Partial != nullptr ? task.Partial->Indices : task.Model->Indices.Data);
+			for (unsigned j = 0; j < countVertexElements; j++)
+			{
+				auto& inputArray = inputVertices.Data[inputVertices.InputLayout.GetVertexElementIndex(elements[j].Name.c_str())];
+				unsigned elementSize = elements[j].GetTotalSize();
+				auto target = vertexArrays[j] + task.BaseVertex * elementSize;
+				if (task.Partial != nullptr)
+				{
+					// Gathering the selected vertices.
+					auto& vertexIndices = task.Partial->VertexIndices;
+					unsigned countVertices = vertexIndices.GetSize();
+					for (unsigned k = 0; k < countVertices; k++)
+					{
+						memcpy(target + k * elementSize, inputArray.GetArray() + vertexIndices[k] * elementSize, elementSize);
+					}
+				}
+				else
+				{
+					memcpy(target, inputArray.GetArray(), inputArray.GetSize());
+				}
+			}
+			memcpy(indices + task.BaseIndex, inputIndices.GetArray(), inputIndices.GetSize() * sizeof(unsigned));
+			auto& lodIndices = task.Model->LODIndices;
+			if (task.Partial == nullptr && lodIndices.GetSize() > 0)
+			{
+				memcpy(indices + task.BaseIndex + inputIndices.GetSize(), lodIndices.GetArray(),
+					lodIndices.GetSize() * sizeof(unsigned));
+			}
+		}
+	}
+}
+
+ModelLoadingResult ModelLoader::Load(const ModelLoadingDescription& description,
+	Vertex_SOA_Data& vertexData, IndexData& indexData)
+{
+	return std::move(LoadBatch({ description }, vertexData, indexData)[0]);
+}
+
+std::vector<ModelLoadingResult> ModelLoader::LoadBatch(const std::vector<ModelLoadingDescription>& descriptions,
+	Vertex_SOA_Data& vertexData, IndexData& indexData)
+{
+	unsigned countDescriptions = static_cast<unsigned>(descriptions.size());
+
+	// Copying and modifying descriptions. Identical building descriptions are built and loaded only once,
+	// since they result in the same built resource.
+	std::vector<ModelLoadingDescription> uniqueDescriptions;
+	Core::IndexVectorU uniqueIndices;
+	{
+		std::map<ModelBuildingDescription, unsigned> uniqueIndexMap;
+		for (auto& description : descriptions)
 		{
-			if (!VertexInputLayout::IsSubset(inputVertices.InputLayout, outputVertices.InputLayout))
-				RaiseException("Cannot propagate vertex buffer: the input layout of the output buffer is not a subset of the input layout of the input buffer.");
+			auto descriptionCopy = description;
+			HandleModelPath(m_PathHandler, descriptionCopy.BuildingDescription.FilePath);
+			auto it = uniqueIndexMap.find(descriptionCopy.BuildingDescription);
+			if (it == uniqueIndexMap.end())
+			{
+				auto uniqueIndex = static_cast<unsigned>(uniqueDescriptions.size());
+				it = uniqueIndexMap.insert({ descriptionCopy.BuildingDescription, uniqueIndex }).first;
+				uniqueDescriptions.push_back(std::move(descriptionCopy));
+			}
+			uniqueIndices.PushBack(it->second);
+		}
+	}
+	unsigned countUniqueDescriptions = static_cast<unsigned>(uniqueDescriptions.size());
+
+	// Getting built resource descriptions. The file statuses are checked in a single batch.
+	// The dependencies of the models are discovered when they are built, and the resource database
+	// records them, therefore they are not set in the resource descriptions.
+	std::vector<ResourceDescription> resourceDescriptions(countUniqueDescriptions);
+	std::vector<BuiltResourceDescription> builtResourceDescriptions(countUniqueDescriptions);
+	{
+		for (unsigned i = 0; i < countUniqueDescriptions; i++)
+		{
+			auto& buildingDescription = uniqueDescriptions[i].BuildingDescription;
+			auto& resourceDescription = resourceDescriptions[i];
+			resourceDescription.IsBuiltResource = buildingDescription.IsBuiltModel;
+			resourceDescription.ResourceFilePath = buildingDescription.FilePath;
+
+			// Serializing model building description.
+			Core::StartSerializeSB(m_Buffer, buildingDescription);
+			resourceDescription.SerializedBuildOptions.PushBack(m_Buffer.GetArray(),
+				static_cast<unsigned>(m_Buffer.GetSize()));
+		}
+		m_ResourceDatabase->GetBuiltResourceDescriptions(resourceDescriptions.data(), countUniqueDescriptions,
+			builtResourceDescriptions.data());
+	}
+
+	// Creating the tasks for the models, which are not up-to-date or not cached. The slots of the models
+	// are added before the tasks are executed, therefore the tasks don't modify the model container.
+	Core::IndexVectorU builtModelIndices;
+	builtModelIndices.Resize(countUniqueDescriptions);
+	Core::IndexVectorU addedModelIndices;
+	std::vector<ModelBatchTask> tasks;
+	for (unsigned i = 0; i < countUniqueDescriptions; i++)
+	{
+		auto& builtResourceDescription = builtResourceDescriptions[i];
+		auto rIt = m_BuiltModelMap.find(builtResourceDescription.BuiltResourceFilePath);
+		if (builtResourceDescription.IsUpToDate && rIt != m_BuiltModelMap.end())
+		{
+			builtModelIndices[i] = rIt->second;
 		}
 		else
 		{
-			outputVertices.SetInputLayout(inputVertices.InputLayout);
-
-			if (!inputVertices.InputLayout.HasPositions())
-				RaiseException("Positions were not found in model.");
-			if(!inputVertices.InputLayout.HasTextureCoordinates())
-				RaiseWarning("Texture coordinates were not found in model.");
-			if (!inputVertices.InputLayout.HasNormals())
-				RaiseWarning("Normals were not found in model.");
+			builtModelIndices[i] = m_BuiltModels.Add();
+			addedModelIndices.PushBack(i);
 		}
-		if (indexData.GetCountIndices() == 0)
+	}
+	unsigned countAddedModels = addedModelIndices.GetSize();
+
+	// The levels of the build graph are processed in increasing order, since a model may depend on the built
+	// resources of the lower levels.
+	SortByBuildOrder(builtResourceDescriptions.data(), addedModelIndices.GetArray(), countAddedModels);
+	for (unsigned j = 0; j < countAddedModels; j++)
+	{
+		unsigned i = addedModelIndices[j];
+		tasks.push_back(ModelBatchTask{ &uniqueDescriptions[i], &builtResourceDescriptions[i], &resourceDescriptions[i],
+			&m_BuiltModels[builtModelIndices[i]], false, {}, 0.0 });
+	}
+
+	// Building and loading the models. Every thread uses its own importer, since an importer
+	// can't be shared between threads. A single model is processed on this thread, deserializing its chunks
+	// or generating its levels of detail and bounds in parallel instead.
+	unsigned countTasks = static_cast<unsigned>(tasks.size());
+	bool isParallel = (m_ThreadPool != nullptr && countTasks > 1);
+	unsigned countThreads = (isParallel ? m_ThreadPool->GetCountThreads() : 1);
+	std::vector<Assimp::Importer*> importers(countThreads, m_Importer.get());
+	if (isParallel)
+	{
+		while (m_WorkerImporters.size() < countThreads) m_WorkerImporters.push_back(std::make_unique<Assimp::Importer>());
+		for (unsigned i = 0; i < countThreads; i++) importers[i] = m_WorkerImporters[i].get();
+	}
+	std::vector<std::exception_ptr> exceptions(countThreads);
+	ModelBatchLoader loader{ tasks.data(), importers.data(), (isParallel ? nullptr : m_ThreadPool),
+		exceptions.data() };
+	for (unsigned levelStart = 0, levelEnd; levelStart < countTasks; levelStart = levelEnd)
+	{
+		unsigned level = tasks[levelStart].BuiltDescription->BuildLevel;
+		for (levelEnd = levelStart + 1; levelEnd < countTasks && tasks[levelEnd].BuiltDescription->BuildLevel == level;
+			levelEnd++);
+		unsigned countLevelTasks = levelEnd - levelStart;
+		if (isParallel && countLevelTasks > 1)
+		{
+			// The costs of the tasks are very different, therefore they are scheduled dynamically.
+			loader.Tasks = tasks.data() + levelStart;
+			m_ThreadPool->ExecuteWithDynamicScheduling(countLevelTasks, &ModelBatchLoader::Process, &loader);
+		}
+		else
 		{
-			indexData.Topology = builtModel.Indices.Topology;
+			loader.Tasks = tasks.data();
+			loader.Process(0, levelStart, levelEnd);
 		}
+		for (auto& exception : exceptions)
+		{
+			if (exception)
+			{
+				for (unsigned j = 0; j < countAddedModels; j++) m_BuiltModels.Remove(builtModelIndices[addedModelIndices[j]]);
+				std::rethrow_exception(exception);
+			}
+		}
+	}
 
-		// MUADDIB_TODO: implement object and triangle selection.
+	// Recording the built models with their dependencies in a single batch.
+	{
+		std::vector<ResourceBuildResult> buildResults;
+		for (auto& task : tasks)
+		{
+			if (task.IsBuilt)
+			{
+				buildResults.push_back({ task.Resource, std::move(task.DiscoveredDependencyPaths),
+					task.BuildDuration });
+			}
+		}
+		if (!buildResults.empty()) m_ResourceDatabase->SetResourcesBuilt(buildResults.data(), buildResults.size());
+	}
 
-		// Copying indices and vertices.
-		indexData.Append(builtModel.Indices);
-		vertexData.Append(builtModel.Vertices);
+	// We store the models, so they can be directly accessed without loading.
+	for (unsigned j = 0; j < countAddedModels; j++)
+	{
+		unsigned i = addedModelIndices[j];
+		m_BuiltModelMap[builtResourceDescriptions[i].BuiltResourceFilePath] = builtModelIndices[i];
+	}
 
-		// Copying geometry and meshes.
-		auto& inputMeshes = builtModel.Meshes;
-		auto& outputMeshes = result.Meshes;
+	// Computing the offsets of the models' geometry in the output buffers. The geometry is appended
+	// in the order of the descriptions, including the repeated ones. Only the selected meshes and faces
+	// of the partially loaded models are appended, thus the output size is proportional to the selection.
+	std::vector<ModelLoadingResult> results(countDescriptions);
+	std::vector<PartialGeometry> partialGeometries(countDescriptions);
+	Core::SimpleTypeVectorU<GeometryCopyTask> copyTasks;
+	unsigned countVertices = 0;
+	unsigned countIndices = 0;
+	for (unsigned i = 0; i < countDescriptions; i++)
+	{
+		unsigned builtModelIndex = builtModelIndices[uniqueIndices[i]];
+		auto& builtModel = m_BuiltModels[builtModelIndex];
+		auto& partialOptions = descriptions[i].PartialModelLoadingOptions;
+		PartialGeometry* partialGeometry = nullptr;
+		if (partialOptions.IsPartialModelLoadingAllowed)
+		{
+			partialGeometry = &partialGeometries[i];
+			SelectGeometry(builtModel, partialOptions, *partialGeometry);
+		}
+		results[i] = CreateLoadingResult(builtModelIndex, builtModel, partialGeometry);
 
-		unsigned countInputMeshes = inputMeshes.GetSize();
-		unsigned baseVertex = 0;
-		unsigned baseIndex = 0;
-		for (unsigned meshIndex = 0; meshIndex < countInputMeshes; meshIndex++)
+		// Setting vertex and index buffers.
+		assert((builtModel.Meshes.GetSize() > 0) == (builtModel.Objects.GetSize() > 0));
+		if (builtModel.Meshes.GetSize() > 0)
 		{
-			auto& inputGeometryData = inputMeshes[meshIndex];
-			unsigned countInputVertices = inputGeometryData.CountVertices;
-			unsigned countInputIndices = inputGeometryData.CountIndices;
-
-			auto& outputGeometryData = outputMeshes.PushBackPlaceHolder();
-			outputGeometryData.CountVertices = countInputVertices;
-			outputGeometryData.CountIndices = countInputIndices;
-			outputGeometryData.BaseVertex = baseVertex;	// Setting resource-dependent base vertex.
-			outputGeometryData.BaseIndex = baseIndex;	// Setting resource-dependent base index.
-		
-			baseVertex += countInputVertices;
-			baseIndex += countInputIndices;
+			PrepareGeometryAppending(builtModel, vertexData, indexData);
+			copyTasks.PushBack(GeometryCopyTask{ &builtModel, partialGeometry, countVertices, countIndices });
+			if (partialGeometry != nullptr)
+			{
+				countVertices += partialGeometry->VertexIndices.GetSize();
+				countIndices += partialGeometry->Indices.GetSize();
+			}
+			else
+			{
+				countVertices += builtModel.Vertices.GetCountVertices();
+				countIndices += builtModel.Indices.GetCountIndices() + builtModel.LODIndices.GetSize();
+			}
 		}
 	}
 
-	return result;
+	// Copying indices and vertices. The buffers are resized only once.
+	unsigned countCopyTasks = copyTasks.GetSize();
+	if (countCopyTasks > 0)
+	{
+		Core::SimpleTypeVectorU<unsigned char*> vertexArrays;
+		unsigned baseVertex, baseIndex;
+		vertexData.PrepareForAppending(countVertices, vertexArrays, baseVertex);
+		auto indices = indexData.PrepareForAppending(countIndices, baseIndex);
+		if (m_ThreadPool != nullptr && countCopyTasks > 1)
+		{
+			m_ThreadPool->ExecuteWithStaticScheduling(countCopyTasks, &CopyGeometry, copyTasks.GetArray(),
+				&vertexData, vertexArrays.GetArray(), indices);
+		}
+		else
+		{
+			CopyGeometry(0, 0, countCopyTasks, copyTasks.GetArray(), &vertexData, vertexArrays.GetArray(), indices);
+		}
+	}
+
+	return results;
 }
 
 ModelInstantiationResult ModelLoader::Instatiate(unsigned modelIndex,
@@ -1390,6 +2230,17 @@ namespace EngineBuildingBlocks
 			::InstantiateSceneNodes(description, builtModel, sceneNodeHandler, result);
 			return result;
 		}
+
+		void SaveBuiltModel(const BuiltModel& builtModel, const std::string& filePath, bool isCompressingIndices)
+		{
+			// The model is streamed to the file chunk by chunk,
+			// thus no serialized copy of the whole model is held in the memory.
+			Core::FileOutputSinkSB fileSink(filePath);
+			Core::ChunkedContainerWriter writer(fileSink, c_BuiltModelFormatVersion);
+			builtModel.SerializeChunksSB(writer, isCompressingIndices);
+			writer.Finish();
+			fileSink.Close();
+		}
 	}
 }
 
@@ -6,8 +6,14 @@
 #include <Core/DataStructures/SimpleTypeVector.hpp>
 #include <Core/IntervalData.hpp>
 #include <Core/SimpleBinarySerialization.hpp>
+#include <Core/ChunkedContainer.h>
 #include <Core/DataStructures/ResourceUnorderedVector.hpp>
 #include <EngineBuildingBlocks/Graphics/Primitives/Primitive.h>
+#include <EngineBuildingBlocks/Graphics/Primitives/MeshOptimization.h>
+#include <EngineBuildingBlocks/Graphics/Primitives/IndexCompression.h>
+#include <EngineBuildingBlocks/Graphics/Primitives/Meshlet.h>
+#include <EngineBuildingBlocks/Graphics/Primitives/MeshSimplification.h>
+#include <EngineBuildingBlocks/Graphics/Primitives/MeshBounds.h>
 #include <EngineBuildingBlocks/SceneNode.h>
 #include <EngineBuildingBlocks/Animation/SkeletalAnimation.h>
 #include <EngineBuildingBlocks/Graphics/Resources/ImageHelper.h>
@@ -18,6 +24,11 @@
 #include <map>
 #include <memory>
 
+namespace Core
+{
+	class ThreadPool;
+}
+
 namespace Assimp
 {
 	class Importer;
@@ -63,6 +74,26 @@ namespace EngineBuildingBlocks
 
 			MeshSplitOptionsType MeshSplitOptions;
 
+			// The engine-side optimization of the meshes, which runs after the import. The vertices of skinned
+			// models are not welded, since the bone influences are not compared. It's opt-in: the faces of
+			// the partial model loading options refer to the triangle order of the built model.
+			MeshOptimizationOptionsType MeshOptimizationOptions;
+
+			// The vertex elements are converted to the packed formats after the optimization. The bone influences
+			// are kept in BoneData, thus the bone formats are applied by Vertex_SOA_Data::AddBoneData, when it's
+			// called with these options.
+			VertexQuantizationOptionsType VertexQuantizationOptions;
+
+			// The meshlets are built after the optimization, which reorders the triangles of the meshes.
+			MeshletBuildOptionsType MeshletBuildOptions;
+
+			// The levels of detail are generated after the mesh optimization.
+			MeshSimplificationOptionsType MeshSimplificationOptions;
+
+			// The indices of the built model are stored in the compressed encoding instead of
+			// the smallest fixed size encoding of each mesh. They are decoded when the model is loaded.
+			bool IsCompressingIndices;
+
 			GeometryBuildOptions();
 
 			bool operator==(const GeometryBuildOptions& other)const;
@@ -101,6 +132,10 @@ namespace EngineBuildingBlocks
 			void SerializeSB(Core::ByteVector& bytes) const;
 		};
 
+		// Selects the meshes and faces of the model, which are appended to the output buffers on loading.
+		// If no mesh indices are given, all meshes are allowed. The faces of a mesh can be restricted to an interval
+		// (with inclusive last face and a step), in which case only the vertices of the selected faces are copied.
+		// The result contains an entry for every mesh, where the meshes, which are not allowed, are empty.
 		struct PartialModelLoadingOptionsType
 		{
 			bool IsPartialModelLoadingAllowed;
@@ -133,17 +168,6 @@ namespace EngineBuildingBlocks
 			bool IsStatic = false;
 		};
 
-		struct MeshGeometryData
-		{
-			unsigned CountVertices;
-			unsigned CountIndices;
-			unsigned BaseVertex;
-			unsigned BaseIndex;
-
-			void SerializeSB(Core::ByteVector& bytes) const;
-			void DeserializeSB(const unsigned char*& bytes);
-		};
-
 		struct MaterialData
 		{
 			std::string Name;
@@ -177,9 +201,6 @@ namespace EngineBuildingBlocks
 			unsigned ParentIndex;
 			ScaledTransformation LocalTransformation;
 			unsigned UpdateLevel;
-
-			void SerializeSB(Core::ByteVector& bytes) const;
-			void DeserializeSB(const unsigned char*& bytes);
 		};
 
 		struct BuiltModel
@@ -198,18 +219,62 @@ namespace EngineBuildingBlocks
 
 			EngineBuildingBlocks::Math::AABoundingBox NonAnimatedBox;
 
+			// The bounds of each mesh in its local space, and the bounding box of each object in the model space
+			// with the non-animated scene node transformations. The bounds are conservative for the partially
+			// loaded faces of a mesh.
+			Core::SimpleTypeVectorU<MeshBounds> MeshLocalBounds;
+			Core::SimpleTypeVectorU<EngineBuildingBlocks::Math::AABoundingBox> NonAnimatedObjectBoxes;
+
+			// The vertex cache statistics of the geometry before and after the mesh optimization.
+			MeshOptimizationStatistics OptimizationStatistics;
+
+			// The errors of the quantized vertex elements.
+			std::vector<VertexQuantizationError> QuantizationErrors;
+
+			// The meshlets of the meshes, if they were built: MeshletRanges has an entry for each mesh.
+			// The meshlets are not valid for the partially loaded faces of a mesh.
+			Core::SimpleTypeVectorU<Meshlet> Meshlets;
+			Core::SimpleTypeVectorU<MeshletRange> MeshletRanges;
+
+			// The levels of detail of the meshes, if they were generated: LODRanges has an entry for each mesh.
+			// The indices of a level refer to the vertices of its mesh like the mesh's indices, thus they are
+			// drawn with the base vertex of the mesh. The levels are not valid for the partially loaded faces of a mesh.
+			Core::IndexVectorU LODIndices;
+			Core::SimpleTypeVectorU<MeshLOD> LODs;
+			Core::SimpleTypeVectorU<MeshLODRange> LODRanges;
+
 			// Returns an index vector where the base vertex values
 			// are added to the vertex indices.
 			Core::IndexVectorU GetGlobalIndices() const;
 
 			void SerializeSB(Core::ByteVector& bytes) const;
 			void DeserializeSB(const unsigned char*& bytes);
+
+			// Chunked serialization: the scene, the materials, the animations, the bone data, the vertices,
+			// the indices and each texture are written to separate chunks, which can be verified and
+			// deserialized independently. If a thread pool is given, the chunks are deserialized in parallel.
+			// The indices of each mesh are written with 16 bits if they fit, or in the compressed encoding.
+			// The meshlets and the levels of detail are written to optional chunks.
+			void SerializeChunksSB(Core::ChunkedContainerWriter& writer, bool isCompressingIndices = false) const;
+			void DeserializeChunksSB(const Core::ChunkedContainerReader& reader, Core::ThreadPool* threadPool = nullptr);
 		};
 
 		struct ModelLoadingResult
 		{
 			unsigned ModelIndex;
 			Core::SimpleTypeVectorU<MeshGeometryData> Meshes;
+
+			// The levels of detail of the meshes, if they were generated: LODRanges has an entry for each mesh.
+			// The indices of the levels are appended after the indices of the meshes, and their base indices are
+			// resource-dependent like the base indices of the meshes. The levels of the meshes, whose faces are
+			// selected by the partial model loading options, are not loaded.
+			Core::SimpleTypeVectorU<MeshLOD> LODs;
+			Core::SimpleTypeVectorU<MeshLODRange> LODRanges;
+
+			// Returns the geometry of the mesh with the index range of its level of detail, which is selected
+			// by SelectMeshLOD, or the geometry of the mesh if the original mesh has to be drawn.
+			MeshGeometryData SelectMeshGeometry(unsigned meshIndex, float distance, float errorScaler,
+				float projectionScaler, float pixelThreshold) const;
 		};
 
 		struct ModelInstantiationResult
@@ -240,16 +305,13 @@ namespace EngineBuildingBlocks
 
 			Core::ByteVector m_Buffer;
 
+			Core::ThreadPool* m_ThreadPool;
+
 			std::unique_ptr<Assimp::Importer> m_Importer;
 			std::unique_ptr<Assimp::Exporter> m_Exporter;
 
-			void BuildResource(const ModelLoadingDescription& description,
-				const std::string& builtResourceFilePath);
-
-			ModelLoadingResult LoadFromBuiltResource(
-				const ModelLoadingDescription& loadingDescription,
-				const std::string& builtResourceFilePath,
-				Vertex_SOA_Data& vertexData, IndexData& indexData);
+			// The importers of the thread pool's threads for building models in parallel.
+			std::vector<std::unique_ptr<Assimp::Importer>> m_WorkerImporters;
 
 		public:
 
@@ -257,9 +319,19 @@ namespace EngineBuildingBlocks
 				EngineBuildingBlocks::ResourceDatabase* resourceDatabase);
 			~ModelLoader();
 
+			// Sets the thread pool which is used for loading the built models. It can be nullptr.
+			void SetThreadPool(Core::ThreadPool* threadPool);
+
 			ModelLoadingResult Load(const ModelLoadingDescription& description,
 				Vertex_SOA_Data& vertexData, IndexData& indexData);
 
+			// Loads the models like successive Load calls, returning the same results, but the models,
+			// which are not up-to-date, are built and the others are deserialized in parallel with the thread pool.
+			// Identical building descriptions are built and loaded only once. The geometry of the models is copied
+			// to the output buffers in parallel after resizing them only once.
+			std::vector<ModelLoadingResult> LoadBatch(const std::vector<ModelLoadingDescription>& descriptions,
+				Vertex_SOA_Data& vertexData, IndexData& indexData);
+
 			ModelInstantiationResult Instatiate(unsigned modelIndex,
 				EngineBuildingBlocks::SceneNodeHandler& sceneNodeHandler,
 				const ModelInstantiationDescription& description = ModelInstantiationDescription());
@@ -273,7 +345,13 @@ namespace EngineBuildingBlocks
 		ModelInstantiationResult InstantiateSceneNodes(
 			const BuiltModel& builtModel, SceneNodeHandler& sceneNodeHandler,
 			const ModelInstantiationDescription& description = ModelInstantiationDescription());
+
+		// Saves the model in the built format. The model loader loads it directly if its building description
+		// is a built model, e.g. for models, which are exported by other tools.
+		void SaveBuiltModel(const BuiltModel& builtModel, const std::string& filePath, bool isCompressingIndices = false);
 	}
 }
 
+CORE_BITWISE_SERIALIZABLE_SB(EngineBuildingBlocks::Graphics::SceneNodeData)
+
 #endif
\ No newline at end of file
@@ -5,8 +5,15 @@
 #include <Core/Comparison.h>
 #include <Core/Constants.h>
 #include <EngineBuildingBlocks/ErrorHandling.h>
+#include <EngineBuildingBlocks/Graphics/Primitives/IndexCompression.h>
+#include <EngineBuildingBlocks/Graphics/Primitives/VertexInterleaving.h>
+
+#include <glm-0.9.8.1/glm/gtc/packing.hpp>
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 
 using namespace EngineBuildingBlocks;
 using namespace EngineBuildingBlocks::Animation;
@@ -15,6 +22,27 @@ using namespace EngineBuildingBlocks::Graphics;
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace EngineBuildingBlocks
+{
+	namespace Graphics
+	{
+		bool IsNormalizedVertexElementType(VertexElementType type)
+		{
+			switch (type)
+			{
+			case VertexElementType::Snorm16:
+			case VertexElementType::Unorm16:
+			case VertexElementType::Snorm8:
+			case VertexElementType::Unorm8:
+			case VertexElementType::Unorm10_10_10_2:
+				return true;
+			default:
+				return false;
+			}
+		}
+	}
+}
+
 VertexElement::VertexElement()
 	: Type(VertexElementType::Unknown)
 	, TypeSize(0)
@@ -36,6 +64,11 @@ unsigned VertexElement::GetTotalSize() const
 	return Count * TypeSize;
 }
 
+unsigned VertexElement::GetCountComponents() const
+{
+	return (Type == VertexElementType::Unorm10_10_10_2 ? 4 : Count);
+}
+
 bool VertexElement::operator==(const VertexElement& other) const
 {
 	StringEqualCompareBlock(Name);
@@ -272,7 +305,7 @@ void VertexInputLayout::DeserializeSB(const unsigned char*& bytes)
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void  Vertex_AOS_Data::As_SOA_Data(std::vector<Core::ByteVectorU>& resultData) const
+void Vertex_AOS_Data::As_SOA_Data(std::vector<Core::ByteVectorU>& resultData, Core::ThreadPool* threadPool) const
 {
 	auto countElements = static_cast<unsigned>(InputLayout.Elements.size());
 	auto sizes = InputLayout.GetElementSizes();
@@ -287,37 +320,21 @@ void  Vertex_AOS_Data::As_SOA_Data(std::vector<Core::ByteVectorU>& resultData) c
 		targetPtrs[i] = targetArray.GetArray();
 	}
 
-	As_SOA_Data(targetPtrs.GetArray());
+	As_SOA_Data(targetPtrs.GetArray(), threadPool);
 }
 
-void Vertex_AOS_Data::As_SOA_Data(unsigned char** resultData) const
+void Vertex_AOS_Data::As_SOA_Data(unsigned char** resultData, Core::ThreadPool* threadPool) const
 {
-	auto& elements = InputLayout.Elements;
-	auto countElements = static_cast<unsigned>(elements.size());
 	auto sizes = InputLayout.GetElementSizes();
-	unsigned countVertices = GetCountVertices();
-
-	Core::SimpleTypeVectorU<unsigned char*> targetPtrs;
-	targetPtrs.PushBack(resultData, countElements);
-
-	const unsigned char* sourcePtr = this->Data.GetArray();
-	for (unsigned i = 0; i < countVertices; i++)
-	{
-		for (unsigned j = 0; j < countElements; j++)
-		{
-			unsigned size = sizes[j];
-			memcpy(targetPtrs[j], sourcePtr, size);
-			sourcePtr += size;
-			targetPtrs[j] += size;
-		}
-	}
+	DeinterleaveVertexElements(this->Data.GetArray(), sizes.GetArray(), sizes.GetSize(), GetCountVertices(),
+		resultData, threadPool);
 }
 
-Vertex_SOA_Data Vertex_AOS_Data::As_SOA_Data() const
+Vertex_SOA_Data Vertex_AOS_Data::As_SOA_Data(Core::ThreadPool* threadPool) const
 {
 	Vertex_SOA_Data result;
 	result.InputLayout = InputLayout;
-	As_SOA_Data(result.Data);
+	As_SOA_Data(result.Data, threadPool);
 	return result;
 }
 
@@ -448,10 +465,31 @@ void Vertex_SOA_Data::AddBoneData(const Core::SimpleTypeVectorU<glm::uvec4>& bon
 	AddVertexElement(c_VertexBoneWeightVertexElement, boneWeights.GetArray(), countVertices);
 }
 
+void Vertex_SOA_Data::AddBoneData(const BoneData& boneData, const VertexQuantizationOptionsType& options)
+{
+	AddBoneData(BoneData(boneData), options);
+}
+
+void Vertex_SOA_Data::AddBoneData(BoneData&& boneData, const VertexQuantizationOptionsType& options)
+{
+	AddBoneData(std::move(boneData));
+
+	VertexQuantizationOptionsType boneOptions;
+	boneOptions.BoneWeightFormat = options.BoneWeightFormat;
+	boneOptions.BoneIndexFormat = options.BoneIndexFormat;
+	QuantizeVertexData(*this, boneOptions);
+}
+
 bool Vertex_SOA_Data::RemoveBoneData()
 {
-	return RemoveVertexElement(c_VertexBoneIndexVertexElement)
-		&& RemoveVertexElement(c_VertexBoneWeightVertexElement);
+	// The bone elements might have been quantized, so they are removed with their current types.
+	auto& boneIndexName = c_VertexBoneIndexVertexElement.Name;
+	auto& boneWeightName = c_VertexBoneWeightVertexElement.Name;
+	if (!InputLayout.HasVertexElement(boneIndexName.c_str())
+		|| !InputLayout.HasVertexElement(boneWeightName.c_str())) return false;
+	auto boneIndexElement = InputLayout.GetVertexElement(boneIndexName.c_str());
+	auto boneWeightElement = InputLayout.GetVertexElement(boneWeightName.c_str());
+	return RemoveVertexElement(boneIndexElement) && RemoveVertexElement(boneWeightElement);
 }
 
 void Vertex_SOA_Data::AddVertexElement(const VertexElement& vertexElement, const void* data,
@@ -559,26 +597,24 @@ void Vertex_SOA_Data::PrepareForAppending(unsigned countNewVertices,
 	}
 }
 
-Vertex_AOS_Data Vertex_SOA_Data::As_AOS_Data() const
+Vertex_AOS_Data Vertex_SOA_Data::As_AOS_Data(Core::ThreadPool* threadPool) const
 {
 	Vertex_AOS_Data result;
 	result.InputLayout = InputLayout;
-	As_AOS_Data(result.Data);
+	As_AOS_Data(result.Data, threadPool);
 	return result;
 }
 
-void Vertex_SOA_Data::As_AOS_Data(Core::ByteVectorU& resultData) const
+void Vertex_SOA_Data::As_AOS_Data(Core::ByteVectorU& resultData, Core::ThreadPool* threadPool) const
 {
 	resultData.Resize(GetSize());
-	As_AOS_Data(resultData.GetArray());
+	As_AOS_Data(resultData.GetArray(), threadPool);
 }
 
-void Vertex_SOA_Data::As_AOS_Data(unsigned char* resultData) const
+void Vertex_SOA_Data::As_AOS_Data(unsigned char* resultData, Core::ThreadPool* threadPool) const
 {
-	auto& elements = InputLayout.Elements;
-	unsigned countElements = static_cast<unsigned>(elements.size());
+	unsigned countElements = static_cast<unsigned>(InputLayout.Elements.size());
 	auto sizes = InputLayout.GetElementSizes();
-	unsigned countVertices = GetCountVertices();
 
 	Core::SimpleTypeVectorU<const unsigned char*> sourcePtrs(countElements);
 	for (unsigned i = 0; i < countElements; i++)
@@ -586,29 +622,490 @@ void Vertex_SOA_Data::As_AOS_Data(unsigned char* resultData) const
 		sourcePtrs[i] = this->Data[i].GetArray();
 	}
 
-	unsigned char* targetPtr = resultData;
-	for (unsigned i = 0; i < countVertices; i++)
-	{
-		for (unsigned j = 0; j < countElements; j++)
-		{
-			unsigned size = sizes[j];
-			memcpy(targetPtr, sourcePtrs[j], size);
-			sourcePtrs[j] += size;
-			targetPtr += size;
-		}
-	}
+	InterleaveVertexElements(sourcePtrs.GetArray(), sizes.GetArray(), countElements, GetCountVertices(),
+		resultData, threadPool);
 }
 
 void Vertex_SOA_Data::SerializeSB(Core::ByteVector& bytes) const
 {
 	Core::SerializeSB(bytes, InputLayout);
-	Core::SerializeSB(bytes, Data);
+
+	// The vertex element arrays are aligned, thus they can be viewed in-place in a memory-mapped file.
+	Core::SerializeSB(bytes, static_cast<std::uint64_t>(Data.size()));
+	for (auto& elementData : Data)
+	{
+		Core::SerializeAlignedSB(bytes, elementData);
+	}
 }
 
 void Vertex_SOA_Data::DeserializeSB(const unsigned char*& bytes)
 {
 	Core::DeserializeSB(bytes, InputLayout);
-	Core::DeserializeSB(bytes, Data);
+
+	std::uint64_t countElements;
+	Core::DeserializeSB(bytes, countElements);
+	Data.resize(static_cast<size_t>(countElements));
+	for (auto& elementData : Data)
+	{
+		Core::DeserializeAlignedSB(bytes, elementData);
+	}
+}
+
+void Vertex_SOA_Data::SerializeStreamSB(Core::StreamSerializerSB& serializer) const
+{
+	serializer.Serialize(InputLayout);
+	serializer.Serialize(static_cast<std::uint64_t>(Data.size()));
+	for (auto& elementData : Data)
+	{
+		serializer.SerializeAligned(elementData);
+	}
+}
+
+void Vertex_SOA_Data::DeserializeStreamSB(Core::StreamDeserializerSB& deserializer)
+{
+	deserializer.Deserialize(InputLayout);
+
+	std::uint64_t countElements;
+	deserializer.Deserialize(countElements);
+	Data.resize(static_cast<size_t>(countElements));
+	for (auto& elementData : Data)
+	{
+		deserializer.DeserializeAligned(elementData);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+VertexQuantizationOptionsType::VertexQuantizationOptionsType()
+	: PositionFormat(VertexElementFormat::Unchanged)
+	, TextureCoordinateFormat(VertexElementFormat::Unchanged)
+	, NormalFormat(VertexElementFormat::Unchanged)
+	, TangentFormat(VertexElementFormat::Unchanged)
+	, VertexColorFormat(VertexElementFormat::Unchanged)
+	, BoneWeightFormat(VertexElementFormat::Unchanged)
+	, BoneIndexFormat(VertexElementFormat::Unchanged)
+{
+}
+
+VertexQuantizationOptionsType VertexQuantizationOptionsType::GetCompact()
+{
+	VertexQuantizationOptionsType options;
+	options.PositionFormat = VertexElementFormat::Half;
+	options.TextureCoordinateFormat = VertexElementFormat::Half;
+	options.NormalFormat = VertexElementFormat::Octahedral16;
+	options.TangentFormat = VertexElementFormat::Octahedral8;
+	options.VertexColorFormat = VertexElementFormat::Unorm8;
+	options.BoneWeightFormat = VertexElementFormat::Unorm8;
+	options.BoneIndexFormat = VertexElementFormat::Uint8;
+	return options;
+}
+
+bool VertexQuantizationOptionsType::operator==(const VertexQuantizationOptionsType& other) const
+{
+	NumericalEqualCompareBlock(PositionFormat);
+	NumericalEqualCompareBlock(TextureCoordinateFormat);
+	NumericalEqualCompareBlock(NormalFormat);
+	NumericalEqualCompareBlock(TangentFormat);
+	NumericalEqualCompareBlock(VertexColorFormat);
+	NumericalEqualCompareBlock(BoneWeightFormat);
+	NumericalEqualCompareBlock(BoneIndexFormat);
+	return true;
+}
+
+bool VertexQuantizationOptionsType::operator!=(const VertexQuantizationOptionsType& other) const
+{
+	return !(*this == other);
+}
+
+bool VertexQuantizationOptionsType::operator<(const VertexQuantizationOptionsType& other) const
+{
+	NumericalLessCompareBlock(PositionFormat);
+	NumericalLessCompareBlock(TextureCoordinateFormat);
+	NumericalLessCompareBlock(NormalFormat);
+	NumericalLessCompareBlock(TangentFormat);
+	NumericalLessCompareBlock(VertexColorFormat);
+	NumericalLessCompareBlock(BoneWeightFormat);
+	NumericalLessCompareBlock(BoneIndexFormat);
+	return false;
+}
+
+void VertexQuantizationOptionsType::SerializeSB(Core::ByteVector& bytes) const
+{
+	Core::SerializeSB(bytes, PositionFormat);
+	Core::SerializeSB(bytes, TextureCoordinateFormat);
+	Core::SerializeSB(bytes, NormalFormat);
+	Core::SerializeSB(bytes, TangentFormat);
+	Core::SerializeSB(bytes, VertexColorFormat);
+	Core::SerializeSB(bytes, BoneWeightFormat);
+	Core::SerializeSB(bytes, BoneIndexFormat);
+}
+
+void VertexQuantizationError::SerializeSB(Core::ByteVector& bytes) const
+{
+	Core::SerializeSB(bytes, ElementName);
+	Core::SerializeSB(bytes, MaxError);
+	Core::SerializeSB(bytes, MeanError);
+}
+
+void VertexQuantizationError::DeserializeSB(const unsigned char*& bytes)
+{
+	Core::DeserializeSB(bytes, ElementName);
+	Core::DeserializeSB(bytes, MaxError);
+	Core::DeserializeSB(bytes, MeanError);
+}
+
+namespace
+{
+	const int c_Snorm16Max = 32767;
+	const int c_Snorm8Max = 127;
+	const unsigned c_Unorm16Max = 65535;
+	const unsigned c_Unorm8Max = 255;
+	const unsigned c_Unorm10Max = 1023;
+
+	inline int QuantizeSnorm(float value, int maxValue)
+	{
+		return static_cast<int>(std::round(std::min(std::max(value, -1.0f), 1.0f) * maxValue));
+	}
+
+	inline float DequantizeSnorm(int value, int maxValue)
+	{
+		return std::max(static_cast<float>(value) / maxValue, -1.0f);
+	}
+
+	inline unsigned QuantizeUnorm(float value, unsigned maxValue)
+	{
+		return static_cast<unsigned>(std::round(std::min(std::max(value, 0.0f), 1.0f) * maxValue));
+	}
+
+	inline float DequantizeUnorm(unsigned value, unsigned maxValue)
+	{
+		return static_cast<float>(value) / maxValue;
+	}
+
+	inline float SignNotZero(float value)
+	{
+		return (value >= 0.0f ? 1.0f : -1.0f);
+	}
+
+	void EncodeOctahedral(const float* vector, float* encoded)
+	{
+		float length1 = std::abs(vector[0]) + std::abs(vector[1]) + std::abs(vector[2]);
+		if (length1 == 0.0f)
+		{
+			encoded[0] = encoded[1] = 0.0f;
+			return;
+		}
+		float x = vector[0] / length1;
+		float y = vector[1] / length1;
+		if (vector[2] < 0.0f)
+		{
+			encoded[0] = (1.0f - std::abs(y)) * SignNotZero(x);
+			encoded[1] = (1.0f - std::abs(x)) * SignNotZero(y);
+		}
+		else
+		{
+			encoded[0] = x;
+			encoded[1] = y;
+		}
+	}
+
+	void DecodeOctahedral(const float* encoded, float* vector)
+	{
+		float x = encoded[0];
+		float y = encoded[1];
+		float z = 1.0f - std::abs(x) - std::abs(y);
+		if (z < 0.0f)
+		{
+			float foldedX = (1.0f - std::abs(y)) * SignNotZero(x);
+			y = (1.0f - std::abs(x)) * SignNotZero(y);
+			x = foldedX;
+		}
+		float length = std::sqrt(x * x + y * y + z * z);
+		vector[0] = x / length;
+		vector[1] = y / length;
+		vector[2] = z / length;
+	}
+
+	// Rounding the encoded components independently is not optimal, so the closest of the 4 neighbouring
+	// lattice points is chosen. The candidates are compared by their distances: the dot products of
+	// the 16-bit candidates are not distinguishable in single precision.
+	void QuantizeOctahedral(const float* vector, int maxValue, int* quantized, float* decoded)
+	{
+		float encoded[2];
+		EncodeOctahedral(vector, encoded);
+		float bases[2] = { std::floor(encoded[0] * maxValue), std::floor(encoded[1] * maxValue) };
+		float bestSquaredDistance = std::numeric_limits<float>::max();
+		for (int i = 0; i < 4; i++)
+		{
+			int candidate[2];
+			float candidateEncoded[2], candidateDecoded[3];
+			for (int j = 0; j < 2; j++)
+			{
+				candidate[j] = std::min(std::max(static_cast<int>(bases[j]) + ((i >> j) & 1), -maxValue), maxValue);
+				candidateEncoded[j] = DequantizeSnorm(candidate[j], maxValue);
+			}
+			DecodeOctahedral(candidateEncoded, candidateDecoded);
+			float squaredDistance = 0.0f;
+			for (int j = 0; j < 3; j++)
+			{
+				float difference = candidateDecoded[j] - vector[j];
+				squaredDistance += difference * difference;
+			}
+			if (squaredDistance < bestSquaredDistance)
+			{
+				bestSquaredDistance = squaredDistance;
+				quantized[0] = candidate[0];
+				quantized[1] = candidate[1];
+				memcpy(decoded, candidateDecoded, sizeof(float) * 3);
+			}
+		}
+	}
+
+	template <typename T>
+	inline void WriteComponent(unsigned char*& target, T value)
+	{
+		memcpy(target, &value, sizeof(T));
+		target += sizeof(T);
+	}
+
+	// Writes the quantized value of a float vertex element and returns the decoded value.
+	void QuantizeFloatValue(const float* source, unsigned count, VertexElementFormat format,
+		unsigned char* target, float* decoded)
+	{
+		switch (format)
+		{
+		case VertexElementFormat::Octahedral16:
+		case VertexElementFormat::Octahedral8:
+		{
+			int maxValue = (format == VertexElementFormat::Octahedral16 ? c_Snorm16Max : c_Snorm8Max);
+			int quantized[2];
+			QuantizeOctahedral(source, maxValue, quantized, decoded);
+			for (int i = 0; i < 2; i++)
+			{
+				if (format == VertexElementFormat::Octahedral16)
+					WriteComponent(target, static_cast<std::int16_t>(quantized[i]));
+				else
+					WriteComponent(target, static_cast<std::int8_t>(quantized[i]));
+			}
+			return;
+		}
+		case VertexElementFormat::Unorm10_10_10_2:
+		{
+			std::uint32_t packed = 0;
+			for (unsigned i = 0; i < 3; i++)
+			{
+				unsigned quantized = QuantizeUnorm(source[i] * 0.5f + 0.5f, c_Unorm10Max);
+				packed |= quantized << (10 * i);
+				decoded[i] = DequantizeUnorm(quantized, c_Unorm10Max) * 2.0f - 1.0f;
+			}
+			WriteComponent(target, packed);
+			return;
+		}
+		default: break;
+		}
+
+		// The 3-component elements are padded with a zero component.
+		unsigned countTargetComponents = (count == 3 ? 4 : count);
+		for (unsigned i = 0; i < countTargetComponents; i++)
+		{
+			float value = (i < count ? source[i] : 0.0f);
+			float decodedValue;
+			switch (format)
+			{
+			case VertexElementFormat::Half:
+			{
+				auto quantized = glm::packHalf1x16(value);
+				decodedValue = glm::unpackHalf1x16(quantized);
+				WriteComponent(target, quantized);
+				break;
+			}
+			case VertexElementFormat::Snorm16:
+			{
+				int quantized = QuantizeSnorm(value, c_Snorm16Max);
+				decodedValue = DequantizeSnorm(quantized, c_Snorm16Max);
+				WriteComponent(target, static_cast<std::int16_t>(quantized));
+				break;
+			}
+			case VertexElementFormat::Unorm16:
+			{
+				unsigned quantized = QuantizeUnorm(value, c_Unorm16Max);
+				decodedValue = DequantizeUnorm(quantized, c_Unorm16Max);
+				WriteComponent(target, static_cast<std::uint16_t>(quantized));
+				break;
+			}
+			case VertexElementFormat::Snorm8:
+			{
+				int quantized = QuantizeSnorm(value, c_Snorm8Max);
+				decodedValue = DequantizeSnorm(quantized, c_Snorm8Max);
+				WriteComponent(target, static_cast<std::int8_t>(quantized));
+				break;
+			}
+			case VertexElementFormat::Unorm8:
+			{
+				unsigned quantized = QuantizeUnorm(value, c_Unorm8Max);
+				decodedValue = DequantizeUnorm(quantized, c_Unorm8Max);
+				WriteComponent(target, static_cast<std::uint8_t>(quantized));
+				break;
+			}
+			default: assert(false); decodedValue = 0.0f; break;
+			}
+			if (i < count) decoded[i] = decodedValue;
+		}
+	}
+
+	void RaiseExceptionOnInvalidQuantization(const VertexElement& element, VertexElementFormat format)
+	{
+		std::stringstream ss;
+		ss << "Vertex element '" << element.Name << "' cannot be quantized to format " << static_cast<int>(format) << ".";
+		RaiseException(ss);
+	}
+}
+
+namespace EngineBuildingBlocks
+{
+	namespace Graphics
+	{
+		VertexElement QuantizeVertexElement(const VertexElement& element, const Core::ByteVectorU& data,
+			VertexElementFormat format, Core::ByteVectorU& result, VertexQuantizationError* error)
+		{
+			unsigned countVertices = data.GetSize() / element.GetTotalSize();
+			if (error != nullptr)
+			{
+				error->ElementName = element.Name;
+				error->MaxError = 0.0f;
+				error->MeanError = 0.0f;
+			}
+
+			VertexElement resultElement;
+			resultElement.Name = element.Name;
+			switch (format)
+			{
+			case VertexElementFormat::Unchanged:
+				result = data;
+				return element;
+			case VertexElementFormat::Half:
+			case VertexElementFormat::Snorm16:
+			case VertexElementFormat::Unorm16:
+			case VertexElementFormat::Snorm8:
+			case VertexElementFormat::Unorm8:
+			{
+				if (element.Type != VertexElementType::Float) RaiseExceptionOnInvalidQuantization(element, format);
+				const VertexElementType types[] = { VertexElementType::Half, VertexElementType::Snorm16,
+					VertexElementType::Unorm16, VertexElementType::Snorm8, VertexElementType::Unorm8 };
+				resultElement.Type = types[static_cast<int>(format) - static_cast<int>(VertexElementFormat::Half)];
+				resultElement.TypeSize = (format == VertexElementFormat::Snorm8 || format == VertexElementFormat::Unorm8 ? 1 : 2);
+				resultElement.Count = (element.Count == 3 ? 4 : element.Count);
+				break;
+			}
+			case VertexElementFormat::Octahedral16:
+			case VertexElementFormat::Octahedral8:
+				if (element.Type != VertexElementType::Float || element.Count != 3)
+					RaiseExceptionOnInvalidQuantization(element, format);
+				resultElement.Type = (format == VertexElementFormat::Octahedral16
+					? VertexElementType::Snorm16 : VertexElementType::Snorm8);
+				resultElement.TypeSize = (format == VertexElementFormat::Octahedral16 ? 2 : 1);
+				resultElement.Count = 2;
+				break;
+			case VertexElementFormat::Unorm10_10_10_2:
+				if (element.Type != VertexElementType::Float || element.Count != 3)
+					RaiseExceptionOnInvalidQuantization(element, format);
+				resultElement.Type = VertexElementType::Unorm10_10_10_2;
+				resultElement.TypeSize = 4;
+				resultElement.Count = 1;
+				break;
+			case VertexElementFormat::Uint16:
+			case VertexElementFormat::Uint8:
+				if (element.Type != VertexElementType::Uint32) RaiseExceptionOnInvalidQuantization(element, format);
+				resultElement.Type = (format == VertexElementFormat::Uint16 ? VertexElementType::Uint16 : VertexElementType::Uint8);
+				resultElement.TypeSize = (format == VertexElementFormat::Uint16 ? 2 : 1);
+				resultElement.Count = element.Count;
+				break;
+			default:
+				RaiseExceptionOnInvalidQuantization(element, format);
+			}
+			assert(element.TypeSize == 4);
+
+			result.Clear();
+			result.Resize(countVertices * resultElement.GetTotalSize());
+			auto target = result.GetArray();
+
+			if (element.Type == VertexElementType::Uint32)
+			{
+				unsigned maxValue = (resultElement.Type == VertexElementType::Uint16 ? c_Unorm16Max : c_Unorm8Max);
+				auto source = reinterpret_cast<const unsigned*>(data.GetArray());
+				unsigned countValues = countVertices * element.Count;
+				for (unsigned i = 0; i < countValues; i++)
+				{
+					if (source[i] > maxValue)
+					{
+						std::stringstream ss;
+						ss << "Value " << source[i] << " of vertex element '" << element.Name
+							<< "' doesn't fit to the quantized format.";
+						RaiseException(ss);
+					}
+					if (resultElement.TypeSize == 2) WriteComponent(target, static_cast<std::uint16_t>(source[i]));
+					else WriteComponent(target, static_cast<std::uint8_t>(source[i]));
+				}
+				return resultElement;
+			}
+
+			auto source = reinterpret_cast<const float*>(data.GetArray());
+			unsigned resultSize = resultElement.GetTotalSize();
+			double sumError = 0.0;
+			float maxError = 0.0f;
+			float decoded[4];
+			for (unsigned i = 0; i < countVertices; i++, source += element.Count, target += resultSize)
+			{
+				QuantizeFloatValue(source, element.Count, format, target, decoded);
+				float squaredError = 0.0f;
+				for (unsigned j = 0; j < element.Count; j++)
+				{
+					float difference = decoded[j] - source[j];
+					squaredError += difference * difference;
+				}
+				float vertexError = std::sqrt(squaredError);
+				sumError += vertexError;
+				maxError = std::max(maxError, vertexError);
+			}
+			if (error != nullptr)
+			{
+				error->MaxError = maxError;
+				error->MeanError = (countVertices == 0 ? 0.0f : static_cast<float>(sumError / countVertices));
+			}
+			return resultElement;
+		}
+
+		void QuantizeVertexData(Vertex_SOA_Data& vertexData, const VertexQuantizationOptionsType& options,
+			std::vector<VertexQuantizationError>* errors)
+		{
+			const std::pair<const VertexElement*, VertexElementFormat> elementFormats[] =
+			{
+				{ &c_PositionVertexElement, options.PositionFormat },
+				{ &c_TextureCoordinateVertexElement, options.TextureCoordinateFormat },
+				{ &c_NormalVertexElement, options.NormalFormat },
+				{ &c_TangentVertexElement, options.TangentFormat },
+				{ &c_BitangentVertexElement, options.TangentFormat },
+				{ &c_VertexColorVertexElement, options.VertexColorFormat },
+				{ &c_VertexBoneWeightVertexElement, options.BoneWeightFormat },
+				{ &c_VertexBoneIndexVertexElement, options.BoneIndexFormat }
+			};
+
+			Core::ByteVectorU result;
+			for (auto& elementFormat : elementFormats)
+			{
+				if (elementFormat.second == VertexElementFormat::Unchanged) continue;
+				unsigned index = vertexData.InputLayout.GetVertexElementIndex(elementFormat.first->Name.c_str());
+				if (index == Core::c_InvalidIndexU) continue;
+
+				auto& element = vertexData.InputLayout.Elements[index];
+				VertexQuantizationError error;
+				element = QuantizeVertexElement(element, vertexData.Data[index], elementFormat.second, result, &error);
+				std::swap(vertexData.Data[index], result);
+				if (errors != nullptr) errors->push_back(std::move(error));
+			}
+		}
+	}
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -624,6 +1121,17 @@ unsigned IndexData::GetSizeInBytes() const
 	return Data.GetSize() * static_cast<unsigned>(sizeof(unsigned));
 }
 
+bool IndexData::CanUseUint16Indices() const
+{
+	return (GetSmallestIndexEncoding(Data.GetArray(), Data.GetSize()) == IndexEncoding::Uint16);
+}
+
+void IndexData::As_Uint16_Data(Core::SimpleTypeVectorU<std::uint16_t>& resultData) const
+{
+	resultData.Resize(Data.GetSize());
+	ConvertIndicesToUint16(Data.GetArray(), Data.GetSize(), resultData.GetArray());
+}
+
 void IndexData::Append(const IndexData& data)
 {
 	if (data.Topology != Topology) RaiseException("Indiceses with different primitive topologies cannot be appended.");
@@ -652,11 +1160,42 @@ bool IndexData::operator!=(const IndexData& other) const
 void IndexData::SerializeSB(Core::ByteVector& bytes) const
 {
 	Core::SerializeSB(bytes, Topology);
-	Core::SerializeSB(bytes, Data);
+	Core::SerializeAlignedSB(bytes, Data);
 }
 
 void IndexData::DeserializeSB(const unsigned char*& bytes)
 {
 	Core::DeserializeSB(bytes, Topology);
-	Core::DeserializeSB(bytes, Data);
+	Core::DeserializeAlignedSB(bytes, Data);
+}
+
+void IndexData::SerializeStreamSB(Core::StreamSerializerSB& serializer) const
+{
+	serializer.Serialize(Topology);
+	serializer.SerializeAligned(Data);
+}
+
+void IndexData::DeserializeStreamSB(Core::StreamDeserializerSB& deserializer)
+{
+	deserializer.Deserialize(Topology);
+	deserializer.DeserializeAligned(Data);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void MeshGeometryData::SerializeSB(Core::ByteVector& bytes) const
+{
+	Core::SerializeSB(bytes, CountVertices);
+	Core::SerializeSB(bytes, CountIndices);
+	Core::SerializeSB(bytes, BaseVertex);
+	Core::SerializeSB(bytes, BaseIndex);
+}
+
+void MeshGeometryData::DeserializeSB(const unsigned char*& bytes)
+{
+	Core::DeserializeSB(bytes, CountVertices);
+	Core::DeserializeSB(bytes, CountIndices);
+	Core::DeserializeSB(bytes, BaseVertex);
+	Core::DeserializeSB(bytes, BaseIndex);
 }
\ No newline at end of file
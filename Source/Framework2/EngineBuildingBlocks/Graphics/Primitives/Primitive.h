@@ -5,22 +5,38 @@
 
 #include <Core/DataStructures/SimpleTypeVector.hpp>
 #include <Core/SimpleBinarySerialization.hpp>
+#include <Core/StreamBinarySerialization.h>
 #include <Core/Constants.h>
 #include <EngineBuildingBlocks/Math/GLM.h>
 #include <EngineBuildingBlocks/Animation/SkeletalAnimation.h>
 
+#include <cstdint>
 #include <vector>
 #include <string>
 
+namespace Core
+{
+	class ThreadPool;
+}
+
 namespace EngineBuildingBlocks
 {
 	namespace Graphics
 	{
 		enum class VertexElementType : unsigned char
 		{
-			Unknown = 0, Float, Uint32
+			Unknown = 0, Float, Uint32,
+
+			// Packed types. The normalized types are converted to floats by the input assembler:
+			// snorm to [-1, 1] and unorm to [0, 1].
+			Half, Snorm16, Unorm16, Snorm8, Unorm8, Uint16, Uint8,
+
+			// Three 10-bit and a 2-bit unorm components in 32 bits. The type size is 4 and the count is 1.
+			Unorm10_10_10_2
 		};
 
+		bool IsNormalizedVertexElementType(VertexElementType type);
+
 		struct VertexElement
 		{
 			// E.g.: "Position"
@@ -42,6 +58,10 @@ namespace EngineBuildingBlocks
 
 			unsigned GetTotalSize() const;
 
+			// The count of the components, which are seen by the shader. It differs from the count
+			// for the packed types.
+			unsigned GetCountComponents() const;
+
 			bool operator==(const VertexElement& other) const;
 			bool operator!=(const VertexElement& other) const;
 			bool operator<(const VertexElement& other) const;
@@ -102,15 +122,17 @@ namespace EngineBuildingBlocks
 		};
 
 		struct Vertex_SOA_Data;
+		struct VertexQuantizationOptionsType;
 
 		struct Vertex_AOS_Data
 		{
 			VertexInputLayout InputLayout;
 			Core::ByteVectorU Data;
 
-			void As_SOA_Data(std::vector<Core::ByteVectorU>& resultData) const;
-			void As_SOA_Data(unsigned char** resultData) const;
-			Vertex_SOA_Data As_SOA_Data() const;
+			// If a thread pool is given, the vertices are converted in parallel.
+			void As_SOA_Data(std::vector<Core::ByteVectorU>& resultData, Core::ThreadPool* threadPool = nullptr) const;
+			void As_SOA_Data(unsigned char** resultData, Core::ThreadPool* threadPool = nullptr) const;
+			Vertex_SOA_Data As_SOA_Data(Core::ThreadPool* threadPool = nullptr) const;
 
 			unsigned GetCountVertices() const;
 			unsigned GetSize() const;
@@ -146,6 +168,14 @@ namespace EngineBuildingBlocks
 			void AddBoneData(EngineBuildingBlocks::Animation::BoneData&& boneData);
 			void AddBoneData(const Core::SimpleTypeVectorU<glm::uvec4>& boneIndices,
 				const Core::SimpleTypeVectorU<glm::vec4>& boneWeights);
+
+			// Converts the added bone elements to the bone weight and bone index formats of the options.
+			// The other formats are ignored.
+			void AddBoneData(const EngineBuildingBlocks::Animation::BoneData& boneData,
+				const VertexQuantizationOptionsType& options);
+			void AddBoneData(EngineBuildingBlocks::Animation::BoneData&& boneData,
+				const VertexQuantizationOptionsType& options);
+
 			bool RemoveBoneData();
 
 			void AddVertexElement(const VertexElement& vertexElement,
@@ -176,14 +206,88 @@ namespace EngineBuildingBlocks
 			void PrepareForAppending(unsigned countNewVertices,
 				Core::SimpleTypeVectorU<unsigned char*>& dataArrays, unsigned& baseVertex);
 
-			void As_AOS_Data(Core::ByteVectorU& resultData) const;
-			void As_AOS_Data(unsigned char* resultData) const;
-			Vertex_AOS_Data As_AOS_Data() const;
+			// If a thread pool is given, the vertices are converted in parallel.
+			void As_AOS_Data(Core::ByteVectorU& resultData, Core::ThreadPool* threadPool = nullptr) const;
+			void As_AOS_Data(unsigned char* resultData, Core::ThreadPool* threadPool = nullptr) const;
+			Vertex_AOS_Data As_AOS_Data(Core::ThreadPool* threadPool = nullptr) const;
 		
 			void SerializeSB(Core::ByteVector& bytes) const;
 			void DeserializeSB(const unsigned char*& bytes);
+
+			void SerializeStreamSB(Core::StreamSerializerSB& serializer) const;
+			void DeserializeStreamSB(Core::StreamDeserializerSB& deserializer);
+		};
+
+		///////////////////////////////////// QUANTIZATION /////////////////////////////////////
+
+		// The formats, to which the vertex elements can be converted.
+		enum class VertexElementFormat : unsigned char
+		{
+			Unchanged,
+
+			// For float elements. The values are clamped to the range of the normalized formats.
+			Half, Snorm16, Unorm16, Snorm8, Unorm8,
+
+			// For unit vectors, e.g. normals and tangents. The octahedral formats store 2 snorm components:
+			// the vector is projected to the octahedron |x| + |y| + |z| = 1, and the lower hemisphere is folded
+			// over the diagonals. The shader decodes them as:
+			//   n = vec3(e.xy, 1 - |e.x| - |e.y|); if (n.z < 0) n.xy = (1 - |n.yx|) * sign(n.xy); n = normalize(n).
+			// Unorm10_10_10_2 stores the components mapped from [-1, 1] to [0, 1], and 0 in the 2-bit component.
+			Octahedral16, Octahedral8, Unorm10_10_10_2,
+
+			// For unsigned integer elements, e.g. bone indices. The values must fit to the format.
+			Uint16, Uint8
 		};
 
+		struct VertexQuantizationOptionsType
+		{
+			VertexElementFormat PositionFormat;
+			VertexElementFormat TextureCoordinateFormat;
+			VertexElementFormat NormalFormat;
+
+			// The format of the tangents and the bitangents.
+			VertexElementFormat TangentFormat;
+
+			VertexElementFormat VertexColorFormat;
+			VertexElementFormat BoneWeightFormat;
+			VertexElementFormat BoneIndexFormat;
+
+			// Leaves all vertex elements unchanged.
+			VertexQuantizationOptionsType();
+
+			// Half positions and texture coordinates, 16-bit octahedral normals, 8-bit octahedral tangents,
+			// 8-bit colors and bone weights and 8-bit bone indices.
+			static VertexQuantizationOptionsType GetCompact();
+
+			bool operator==(const VertexQuantizationOptionsType& other) const;
+			bool operator!=(const VertexQuantizationOptionsType& other) const;
+			bool operator<(const VertexQuantizationOptionsType& other) const;
+
+			void SerializeSB(Core::ByteVector& bytes) const;
+		};
+
+		// The error of the quantization of a vertex element: the Euclidean distance of the original
+		// and the decoded values.
+		struct VertexQuantizationError
+		{
+			std::string ElementName;
+			float MaxError;
+			float MeanError;
+
+			void SerializeSB(Core::ByteVector& bytes) const;
+			void DeserializeSB(const unsigned char*& bytes);
+		};
+
+		// Converts the vertex elements with the default names to the formats of the options.
+		// Throws if a format can't be applied to an element. Note that the typed accessors of
+		// Vertex_SOA_Data can't be used for the converted elements.
+		void QuantizeVertexData(Vertex_SOA_Data& vertexData, const VertexQuantizationOptionsType& options,
+			std::vector<VertexQuantizationError>* errors = nullptr);
+
+		// Converts a float or an unsigned integer vertex element to the format. Returns the converted element.
+		VertexElement QuantizeVertexElement(const VertexElement& element, const Core::ByteVectorU& data,
+			VertexElementFormat format, Core::ByteVectorU& result, VertexQuantizationError* error = nullptr);
+
 		enum class PrimitiveTopology : unsigned char
 		{
 			Undefined,
@@ -238,6 +342,11 @@ namespace EngineBuildingBlocks
 			unsigned GetCountIndices() const;
 			unsigned GetSizeInBytes() const;
 
+			// Returns true if the indices fit to 16 bits. The indices of the meshes with at most 65536 vertices
+			// fit, since they are relative to the base vertex.
+			bool CanUseUint16Indices() const;
+			void As_Uint16_Data(Core::SimpleTypeVectorU<std::uint16_t>& resultData) const;
+
 			void Append(const IndexData& data);
 
 			unsigned* PrepareForAppending(unsigned newIndexCount, unsigned& baseIndex);
@@ -247,6 +356,21 @@ namespace EngineBuildingBlocks
 
 			void SerializeSB(Core::ByteVector& bytes) const;
 			void DeserializeSB(const unsigned char*& bytes);
+
+			void SerializeStreamSB(Core::StreamSerializerSB& serializer) const;
+			void DeserializeStreamSB(Core::StreamDeserializerSB& deserializer);
+		};
+
+		// The vertex and index range of a mesh in shared buffers. The indices are relative to the base vertex.
+		struct MeshGeometryData
+		{
+			unsigned CountVertices;
+			unsigned CountIndices;
+			unsigned BaseVertex;
+			unsigned BaseIndex;
+
+			void SerializeSB(Core::ByteVector& bytes) const;
+			void DeserializeSB(const unsigned char*& bytes);
 		};
 	}
 }
@@ -0,0 +1,325 @@
+// EngineBuildingBlocks/Graphics/Primitives/VertexInterleaving.cpp
+
+#include <EngineBuildingBlocks/Graphics/Primitives/VertexInterleaving.h>
+
+#include <Core/DataStructures/SimpleTypeVector.hpp>
+#include <Core/System/ThreadPool.h>
+
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <type_traits>
+
+using namespace EngineBuildingBlocks::Graphics;
+
+namespace
+{
+	const unsigned c_VectorSize = 16;
+
+	// The vertices are split to chunks for the threads. The streamed output is staged in blocks,
+	// which fit to the L1 cache.
+	const unsigned c_CountBlockVertices = 64;
+	const unsigned c_CountChunkVertices = 256 * c_CountBlockVertices;
+	const unsigned c_MaximumStagedStride = 256;
+
+	// Smaller outputs are likely to be read from the cache.
+	const unsigned c_MinimumStreamedSize = 1 << 20;
+
+	template <unsigned... Sizes>
+	struct FixedLayout
+	{
+		static constexpr unsigned c_Sizes[] = { Sizes... };
+
+		static constexpr unsigned GetCountElements() { return sizeof...(Sizes); }
+		static constexpr unsigned GetSize(unsigned index) { return c_Sizes[index]; }
+		static constexpr unsigned GetStride() { return (Sizes + ...); }
+	};
+
+	struct RuntimeLayout
+	{
+		const unsigned* Sizes;
+		unsigned CountElements;
+		unsigned Stride;
+
+		unsigned GetCountElements() const { return CountElements; }
+		unsigned GetSize(unsigned index) const { return Sizes[index]; }
+		unsigned GetStride() const { return Stride; }
+	};
+
+	template <unsigned... Sizes>
+	bool IsLayout(const unsigned* sizes, unsigned countElements)
+	{
+		const unsigned layoutSizes[] = { Sizes... };
+		return (countElements == sizeof...(Sizes) && std::equal(layoutSizes, layoutSizes + countElements, sizes));
+	}
+
+	// Calls the function with the specialized layout of the element sizes or with the runtime layout.
+	template <typename FunctionType>
+	void DispatchLayout(const unsigned* sizes, unsigned countElements, FunctionType&& function)
+	{
+		// Position, texture coordinate, normal, tangent, bitangent as built by the model loader.
+		if (IsLayout<12, 8, 12>(sizes, countElements)) function(FixedLayout<12, 8, 12>());
+		else if (IsLayout<12, 8, 12, 16, 16>(sizes, countElements)) function(FixedLayout<12, 8, 12, 16, 16>());
+		else if (IsLayout<12, 8, 12, 12, 12>(sizes, countElements)) function(FixedLayout<12, 8, 12, 12, 12>());
+		else if (IsLayout<12, 8, 12, 12, 12, 16, 16>(sizes, countElements)) function(FixedLayout<12, 8, 12, 12, 12, 16, 16>());
+
+		// Position, normal, tangent, bitangent, texture coordinate.
+		else if (IsLayout<12, 12, 12, 12, 8>(sizes, countElements)) function(FixedLayout<12, 12, 12, 12, 8>());
+		else if (IsLayout<12, 12, 12, 12, 8, 16, 16>(sizes, countElements)) function(FixedLayout<12, 12, 12, 12, 8, 16, 16>());
+
+		else function(RuntimeLayout{ sizes, countElements, std::accumulate(sizes, sizes + countElements, 0U) });
+	}
+
+	inline unsigned SubtractClamped(unsigned x, unsigned y)
+	{
+		return (x > y ? x - y : 0);
+	}
+
+	// An overlapping copy writes a whole vector, which overwrites the beginning of the next element or vertex.
+	// Since the elements are written in increasing order, the overwritten bytes are written again later.
+	template <bool IsOverlapping>
+	inline void CopyElement(unsigned char* target, const unsigned char* source, unsigned size)
+	{
+		if (IsOverlapping)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(target),
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(source)));
+		}
+		else
+		{
+			memcpy(target, source, size);
+		}
+	}
+
+	// The count of the last vertices of a range, whose overlapping copies would access memory after the range.
+	template <typename LayoutType>
+	unsigned GetCountOverlappingVertices(const LayoutType& layout)
+	{
+		unsigned countElements = layout.GetCountElements();
+		unsigned stride = layout.GetStride();
+		unsigned lastOffset = stride - layout.GetSize(countElements - 1);
+		unsigned count = (lastOffset + c_VectorSize + stride - 1) / stride - 1;
+		for (unsigned i = 0; i < countElements; i++)
+		{
+			unsigned size = layout.GetSize(i);
+			count = std::max(count, (c_VectorSize + size - 1) / size - 1);
+		}
+		return count;
+	}
+
+	///////////////////////////////////// INTERLEAVING /////////////////////////////////////
+
+	template <typename LayoutType>
+	struct InterleavingTask
+	{
+		LayoutType Layout;
+		const unsigned char* const* Sources;
+		unsigned char* Target;
+		unsigned CountVertices;
+		unsigned CountOverlappingVertices;
+		bool IsStreaming;
+	};
+
+	template <bool IsOverlapping, typename LayoutType>
+	inline void InterleaveVertex(const LayoutType& layout, const unsigned char* const* sources,
+		unsigned vertexIndex, unsigned char* target)
+	{
+		for (unsigned i = 0; i < layout.GetCountElements(); i++)
+		{
+			unsigned size = layout.GetSize(i);
+			CopyElement<IsOverlapping>(target, sources[i] + vertexIndex * size, size);
+			target += size;
+		}
+	}
+
+	// The vertices before the overlapping end are copied with vectors.
+	template <typename LayoutType>
+	void InterleaveVertices(const LayoutType& layout, const unsigned char* const* sources,
+		unsigned startVertex, unsigned endVertex, unsigned overlappingEnd, unsigned char* target)
+	{
+		unsigned stride = layout.GetStride();
+		overlappingEnd = std::max(startVertex, std::min(endVertex, overlappingEnd));
+		unsigned i = startVertex;
+		for (; i < overlappingEnd; i++, target += stride) InterleaveVertex<true>(layout, sources, i, target);
+		for (; i < endVertex; i++, target += stride) InterleaveVertex<false>(layout, sources, i, target);
+	}
+
+	template <typename LayoutType>
+	void InterleaveChunks(unsigned threadIndex, unsigned startIndex, unsigned endIndex,
+		const InterleavingTask<LayoutType>* task)
+	{
+		auto& layout = task->Layout;
+		unsigned stride = layout.GetStride();
+		unsigned startVertex = startIndex * c_CountChunkVertices;
+		unsigned endVertex = std::min(endIndex * c_CountChunkVertices, task->CountVertices);
+		auto target = task->Target + static_cast<size_t>(startVertex) * stride;
+
+		if (task->IsStreaming)
+		{
+			// The staging buffer is padded for the overlapping copies of the last vertex of a block. The size
+			// of a block is a multiple of the vector size and the chunks start at aligned addresses.
+			alignas(c_VectorSize) unsigned char stagingBuffer[c_CountBlockVertices * c_MaximumStagedStride + c_VectorSize];
+			unsigned blockSize = c_CountBlockVertices * stride;
+			unsigned overlappingEnd = SubtractClamped(task->CountVertices, task->CountOverlappingVertices);
+			for (; startVertex + c_CountBlockVertices <= endVertex; startVertex += c_CountBlockVertices, target += blockSize)
+			{
+				InterleaveVertices(layout, task->Sources, startVertex, startVertex + c_CountBlockVertices,
+					overlappingEnd, stagingBuffer);
+				for (unsigned i = 0; i < blockSize; i += c_VectorSize)
+				{
+					_mm_stream_si128(reinterpret_cast<__m128i*>(target + i),
+						_mm_load_si128(reinterpret_cast<const __m128i*>(stagingBuffer + i)));
+				}
+			}
+			_mm_sfence();
+		}
+
+		InterleaveVertices(layout, task->Sources, startVertex, endVertex,
+			SubtractClamped(endVertex, task->CountOverlappingVertices), target);
+	}
+
+	///////////////////////////////////// DEINTERLEAVING /////////////////////////////////////
+
+	template <typename LayoutType>
+	struct DeinterleavingTask
+	{
+		LayoutType Layout;
+		const unsigned char* Source;
+		unsigned char* const* Targets;
+		unsigned CountVertices;
+		unsigned CountOverlappingVertices;
+	};
+
+	template <bool IsOverlapping, typename LayoutType>
+	inline void DeinterleaveVertex(const LayoutType& layout, const unsigned char* source,
+		unsigned vertexIndex, unsigned char* const* targets)
+	{
+		for (unsigned i = 0; i < layout.GetCountElements(); i++)
+		{
+			unsigned size = layout.GetSize(i);
+			CopyElement<IsOverlapping>(targets[i] + vertexIndex * size, source, size);
+			source += size;
+		}
+	}
+
+	template <typename LayoutType>
+	void DeinterleaveChunks(unsigned threadIndex, unsigned startIndex, unsigned endIndex,
+		const DeinterleavingTask<LayoutType>* task)
+	{
+		auto& layout = task->Layout;
+		unsigned stride = layout.GetStride();
+		unsigned startVertex = startIndex * c_CountChunkVertices;
+		unsigned endVertex = std::min(endIndex * c_CountChunkVertices, task->CountVertices);
+		unsigned overlappingEnd = std::max(startVertex, SubtractClamped(endVertex, task->CountOverlappingVertices));
+		auto source = task->Source + static_cast<size_t>(startVertex) * stride;
+
+		unsigned i = startVertex;
+		for (; i < overlappingEnd; i++, source += stride) DeinterleaveVertex<true>(layout, source, i, task->Targets);
+		for (; i < endVertex; i++, source += stride) DeinterleaveVertex<false>(layout, source, i, task->Targets);
+	}
+
+	template <typename TaskType>
+	void ExecuteChunks(void(*function)(unsigned, unsigned, unsigned, const TaskType*), const TaskType& task,
+		Core::ThreadPool* threadPool)
+	{
+		unsigned countChunks = (task.CountVertices + c_CountChunkVertices - 1) / c_CountChunkVertices;
+		if (threadPool != nullptr && countChunks > 1)
+		{
+			threadPool->ExecuteWithStaticScheduling(countChunks, function, &task);
+		}
+		else
+		{
+			function(0, 0, countChunks, &task);
+		}
+	}
+
+	bool IsVectorizable(const unsigned* elementSizes, unsigned countElements)
+	{
+		return (countElements > 0 && *std::max_element(elementSizes, elementSizes + countElements) <= c_VectorSize);
+	}
+}
+
+namespace EngineBuildingBlocks
+{
+	namespace Graphics
+	{
+		void InterleaveVertexElements(const unsigned char* const* sources, const unsigned* elementSizes,
+			unsigned countElements, unsigned countVertices, unsigned char* target,
+			Core::ThreadPool* threadPool)
+		{
+			if (!IsVectorizable(elementSizes, countElements))
+			{
+				InterleaveVertexElementsGeneric(sources, elementSizes, countElements, countVertices, target);
+				return;
+			}
+			DispatchLayout(elementSizes, countElements, [&](const auto& layout)
+			{
+				using LayoutType = std::decay_t<decltype(layout)>;
+				unsigned stride = layout.GetStride();
+				bool isStreaming = (stride <= c_MaximumStagedStride
+					&& static_cast<size_t>(countVertices) * stride >= c_MinimumStreamedSize
+					&& reinterpret_cast<std::uintptr_t>(target) % c_VectorSize == 0);
+				InterleavingTask<LayoutType> task{ layout, sources, target, countVertices,
+					GetCountOverlappingVertices(layout), isStreaming };
+				ExecuteChunks(&InterleaveChunks<LayoutType>, task, threadPool);
+			});
+		}
+
+		void DeinterleaveVertexElements(const unsigned char* source, const unsigned* elementSizes,
+			unsigned countElements, unsigned countVertices, unsigned char* const* targets,
+			Core::ThreadPool* threadPool)
+		{
+			if (!IsVectorizable(elementSizes, countElements))
+			{
+				DeinterleaveVertexElementsGeneric(source, elementSizes, countElements, countVertices, targets);
+				return;
+			}
+			DispatchLayout(elementSizes, countElements, [&](const auto& layout)
+			{
+				using LayoutType = std::decay_t<decltype(layout)>;
+				DeinterleavingTask<LayoutType> task{ layout, source, targets, countVertices,
+					GetCountOverlappingVertices(layout) };
+				ExecuteChunks(&DeinterleaveChunks<LayoutType>, task, threadPool);
+			});
+		}
+
+		void InterleaveVertexElementsGeneric(const unsigned char* const* sources, const unsigned* elementSizes,
+			unsigned countElements, unsigned countVertices, unsigned char* target)
+		{
+			Core::SimpleTypeVectorU<const unsigned char*> sourcePtrs;
+			sourcePtrs.PushBack(sources, countElements);
+
+			for (unsigned i = 0; i < countVertices; i++)
+			{
+				for (unsigned j = 0; j < countElements; j++)
+				{
+					unsigned size = elementSizes[j];
+					memcpy(target, sourcePtrs[j], size);
+					sourcePtrs[j] += size;
+					target += size;
+				}
+			}
+		}
+
+		void DeinterleaveVertexElementsGeneric(const unsigned char* source, const unsigned* elementSizes,
+			unsigned countElements, unsigned countVertices, unsigned char* const* targets)
+		{
+			Core::SimpleTypeVectorU<unsigned char*> targetPtrs;
+			targetPtrs.PushBack(targets, countElements);
+
+			for (unsigned i = 0; i < countVertices; i++)
+			{
+				for (unsigned j = 0; j < countElements; j++)
+				{
+					unsigned size = elementSizes[j];
+					memcpy(targetPtrs[j], source, size);
+					source += size;
+					targetPtrs[j] += size;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,41 @@
+// EngineBuildingBlocks/Graphics/Primitives/VertexInterleaving.h
+
+#ifndef _ENGINEBUILDINGBLOCKS_VERTEXINTERLEAVING_H_INCLUDED_
+#define _ENGINEBUILDINGBLOCKS_VERTEXINTERLEAVING_H_INCLUDED_
+
+namespace Core
+{
+	class ThreadPool;
+}
+
+namespace EngineBuildingBlocks
+{
+	namespace Graphics
+	{
+		// Conversion between the vertex element arrays (SOA) and the interleaved vertices (AOS).
+		//
+		// The vertex elements are copied with overlapping 16 byte vector loads and stores, where the layouts
+		// of the common vertex formats (position, texture coordinate, normal, optionally tangent, bitangent
+		// and bone data) have specialized kernels with compile time element sizes. Large interleaved outputs
+		// are written with streaming stores, since they are usually uploaded to the GPU and not read by the CPU.
+		// If a thread pool is given, the vertices are converted in parallel in chunks.
+
+		void InterleaveVertexElements(const unsigned char* const* sources, const unsigned* elementSizes,
+			unsigned countElements, unsigned countVertices, unsigned char* target,
+			Core::ThreadPool* threadPool = nullptr);
+
+		void DeinterleaveVertexElements(const unsigned char* source, const unsigned* elementSizes,
+			unsigned countElements, unsigned countVertices, unsigned char* const* targets,
+			Core::ThreadPool* threadPool = nullptr);
+
+		// The reference implementations, which copy the vertex elements one by one.
+
+		void InterleaveVertexElementsGeneric(const unsigned char* const* sources, const unsigned* elementSizes,
+			unsigned countElements, unsigned countVertices, unsigned char* target);
+
+		void DeinterleaveVertexElementsGeneric(const unsigned char* source, const unsigned* elementSizes,
+			unsigned countElements, unsigned countVertices, unsigned char* const* targets);
+	}
+}
+
+#endif
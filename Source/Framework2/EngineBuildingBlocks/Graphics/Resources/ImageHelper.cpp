@@ -7,6 +7,7 @@
 #include <Core/Constants.h>
 #include <Core/Utility.hpp>
 #include <Core/System/Filesystem.h>
+#include <Core/System/AsyncFileIO.h>
 #include <Core/SimpleBinarySerialization.hpp>
 #include <EngineBuildingBlocks/ErrorHandling.h>
 
@@ -267,22 +268,6 @@ inline void LoadSimpleImage(Core::ByteVectorU& data, Image2DDescription& descrip
 	FreeImage_Unload(pBitmap);
 }
 
-inline void LoadSimpleImage(Core::ByteVectorU& data, Image2DDescription& description, const std::string& fileName,
-	const FormatSupportHandler& formatSupportHandler, int iFif)
-{
-	auto fif = static_cast<FREE_IMAGE_FORMAT>(iFif);
-
-	// Loading to bitmap.
-	FIBITMAP* pBitmap = FreeImage_Load(fif, fileName.c_str(), 0);
-	if (pBitmap == nullptr)
-	{
-		std::string message = "Cannot load image file to bitmap: ";
-		EngineBuildingBlocks::RaiseException(message + fileName);
-	}
-
-	LoadSimpleImage(data, description, pBitmap, formatSupportHandler);
-}
-
 inline void LoadDDSImage(std::vector<Core::ByteVectorU>& data, Image2DDescription& description,
 	const std::string& fileName, const FormatSupportHandler& formatSupportHandler)
 {
@@ -322,6 +307,71 @@ inline void LoadDDSImage(std::vector<Core::ByteVectorU>& data, Image2DDescriptio
 	dds_close(&info);
 }
 
+// The image files are read by an asynchronous I/O service, which is shared by all loads.
+// The files of a composition are requested together, and each file is decoded while the next ones are read.
+inline Core::AsyncFileIO& GetImageFileIO()
+{
+	static Core::AsyncFileIO fileIO;
+	return fileIO;
+}
+
+// The DDS loader can only read from files, therefore DDS files are not read by the I/O service.
+inline bool IsDDSFileName(const std::string& fileName)
+{
+	return (FreeImage_GetFIFFromFilename(fileName.c_str()) == FIF_DDS);
+}
+
+inline void CheckImageFileExists(const std::string& fileName)
+{
+	if (!Core::FileExists(fileName))
+	{
+		std::string message = "Image file doesn't exists: ";
+		EngineBuildingBlocks::RaiseException(message + fileName);
+	}
+}
+
+inline void LoadImageFromBytes(std::vector<Core::ByteVectorU>& data, Image2DDescription& description,
+	const Core::ByteVector& bytes, const std::string& fileName, const FormatSupportHandler& formatSupportHandler)
+{
+	auto stream = FreeImage_OpenMemory((BYTE*)bytes.GetArray(), bytes.GetSize());
+
+	// Checking the file signature and deducing its format.
+	FREE_IMAGE_FORMAT fif = FreeImage_GetFileTypeFromMemory(stream, 0);
+	if (fif == FIF_UNKNOWN)
+	{
+		// If there's no signature, trying to guess the file format from the file extension.
+		fif = FreeImage_GetFIFFromFilename(fileName.c_str());
+	}
+
+	// Checking whether FreeImage can read the file.
+	if (fif == FIF_UNKNOWN || !FreeImage_FIFSupportsReading(fif))
+	{
+		FreeImage_CloseMemory(stream);
+		std::string message = "Cannot load image file: ";
+		EngineBuildingBlocks::RaiseException(message + fileName);
+	}
+
+	if (fif == FIF_DDS)
+	{
+		// A DDS file with a different extension.
+		FreeImage_CloseMemory(stream);
+		LoadDDSImage(data, description, fileName, formatSupportHandler);
+		return;
+	}
+
+	// Loading to bitmap. The bitmap doesn't reference the memory stream.
+	FIBITMAP* pBitmap = FreeImage_LoadFromMemory(fif, stream, 0);
+	FreeImage_CloseMemory(stream);
+	if (pBitmap == nullptr)
+	{
+		std::string message = "Cannot load image file to bitmap: ";
+		EngineBuildingBlocks::RaiseException(message + fileName);
+	}
+
+	if (data.size() == 0) data.resize(1);
+	LoadSimpleImage(data[0], description, pBitmap, formatSupportHandler);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -381,37 +431,16 @@ namespace EngineBuildingBlocks
 		void LoadImageFromFile(std::vector<Core::ByteVectorU>& data, Image2DDescription& description,
 			const std::string& fileName, const FormatSupportHandler& formatSupportHandler)
 		{
-			if (!Core::FileExists(fileName))
-			{
-				std::string message = "Image file doesn't exists: ";
-				EngineBuildingBlocks::RaiseException(message + fileName);
-			}
-
-			FREE_IMAGE_FORMAT fif = FIF_UNKNOWN;
-
-			// Checking the file signature and deducing its format (the second argument is currently not used by FreeImage).
-			fif = FreeImage_GetFileType(fileName.c_str(), 0);
-			if (fif == FIF_UNKNOWN)
-			{
-				// If there's no signature, trying to guess the file format from the file extension.
-				fif = FreeImage_GetFIFFromFilename(fileName.c_str());
-			}
+			CheckImageFileExists(fileName);
 
-			// Checking whether FreeImage can read the file.
-			if (fif == FIF_UNKNOWN || !FreeImage_FIFSupportsReading(fif))
-			{
-				std::string message = "Cannot load image file: ";
-				EngineBuildingBlocks::RaiseException(message + fileName);
-			}
-
-			if (fif == FIF_DDS)
+			if (IsDDSFileName(fileName))
 			{
 				LoadDDSImage(data, description, fileName, formatSupportHandler);
 			}
 			else
 			{
-				if (data.size() == 0) data.resize(1);
-				LoadSimpleImage(data[0], description, fileName, formatSupportHandler, static_cast<int>(fif));
+				auto bytes = GetImageFileIO().ReadAllBytes(fileName.c_str()).get();
+				LoadImageFromBytes(data, description, bytes, fileName, formatSupportHandler);
 			}
 		}
 
@@ -440,12 +469,37 @@ namespace EngineBuildingBlocks
 				isSourceUsed[sources[i].Source] = true;
 			}
 
-			// Loading sources.
+			// Requesting the used source files together.
+			std::vector<std::string> readFileNames;
+			Core::IndexVectorU readSources;
 			for (unsigned i = 0; i < countSources; i++)
 			{
 				if (isSourceUsed[i])
 				{
-					LoadImageFromFile(datas[i], descriptions[i], fileNames[i], formatSupportHandler);
+					CheckImageFileExists(fileNames[i]);
+					if (!IsDDSFileName(fileNames[i]))
+					{
+						readFileNames.push_back(fileNames[i]);
+						readSources.PushBack(i);
+					}
+				}
+			}
+			auto readResults = GetImageFileIO().ReadAllBytes(readFileNames);
+
+			// Loading sources. A source is decoded while the following ones are being read.
+			for (unsigned i = 0, readIndex = 0; i < countSources; i++)
+			{
+				if (isSourceUsed[i])
+				{
+					if (readIndex < readSources.GetSize() && readSources[readIndex] == i)
+					{
+						auto bytes = readResults[readIndex++].get();
+						LoadImageFromBytes(datas[i], descriptions[i], bytes, fileNames[i], formatSupportHandler);
+					}
+					else
+					{
+						LoadDDSImage(datas[i], descriptions[i], fileNames[i], formatSupportHandler);
+					}
 				}
 			}
 
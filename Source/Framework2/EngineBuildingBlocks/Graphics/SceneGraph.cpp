@@ -36,27 +36,39 @@ void SceneGraph::Synchronize(Camera& camera, const char* name)
 	else camera.SetData(*pCameraData);
 }
 
-inline std::string GetSceneGraphPath(EngineBuildingBlocks::PathHandler* pathHandler, const std::string& name)
+inline std::string GetSceneGraphPath(EngineBuildingBlocks::PathHandler* pathHandler, const std::string& name,
+	bool isBinary)
 {
-	return pathHandler->GetPathFromResourcesDirectory("Scenes/" + name + ".xml");
+	return pathHandler->GetPathFromResourcesDirectory("Scenes/" + name + (isBinary ? ".bsxml" : ".xml"));
 }
 
 void SceneGraph::Load(EngineBuildingBlocks::PathHandler* pathHandler, const std::string& name)
 {
-	auto path = GetSceneGraphPath(pathHandler, name);
+	// The binary form is preferred if both exist.
+	auto path = GetSceneGraphPath(pathHandler, name, true);
+	if (!Core::FileExists(path)) path = GetSceneGraphPath(pathHandler, name, false);
 	if (Core::FileExists(path))
 	{
-		std::string text;
-		Core::ReadAllText(path, text);
-		Core::StartDeserializeSXML(text, *this, "Scene");
+		Core::ByteVector bytes;
+		Core::ReadAllBytes(path, bytes);
+		Core::StartDeserializeAnySXML(bytes.GetArray(), bytes.GetSize(), *this, "Scene");
 	}
 }
 
-void SceneGraph::Save(EngineBuildingBlocks::PathHandler* pathHandler, const std::string& name) const
+void SceneGraph::Save(EngineBuildingBlocks::PathHandler* pathHandler, const std::string& name, bool isBinary) const
 {
-	std::string str;
-	Core::StartSerializeSXML(str, *this, "Scene");
-	Core::WriteAllText(GetSceneGraphPath(pathHandler, name), str);
+	if (isBinary)
+	{
+		Core::ByteVector bytes;
+		Core::StartSerializeBinarySXML(bytes, *this, "Scene");
+		Core::WriteAllBytes(GetSceneGraphPath(pathHandler, name, true), bytes);
+	}
+	else
+	{
+		std::string str;
+		Core::StartSerializeSXML(str, *this, "Scene");
+		Core::WriteAllText(GetSceneGraphPath(pathHandler, name, false), str);
+	}
 }
 
 void SceneGraph::SerializeSXML(Core::SerializationSXMLData& data) const
@@ -24,8 +24,9 @@ namespace EngineBuildingBlocks
 			void Set(const Camera& camera, const char* name);
 			void Synchronize(Camera& camera, const char* name);
 		
+			// Loads the binary or the XML form.
 			void Load(EngineBuildingBlocks::PathHandler* pathHandler, const std::string& name);
-			void Save(EngineBuildingBlocks::PathHandler* pathHandler, const std::string& name) const;
+			void Save(EngineBuildingBlocks::PathHandler* pathHandler, const std::string& name, bool isBinary = false) const;
 		
 			void SerializeSXML(Core::SerializationSXMLData& data) const;
 			void DeserializeSXML(Core::DeserializationSXMLData& data);
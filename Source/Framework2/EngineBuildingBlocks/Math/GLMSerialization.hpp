@@ -14,24 +14,13 @@ namespace EngineBuildingBlocks
 	template <typename T>
 	inline void SerializeAsArraySXML(Core::SerializationSXMLData& data, const T* v, size_t size)
 	{
-		auto& ss = *data.SS;
-		size_t limit = size - 1;
-		for (size_t i = 0; i < size; i++)
-		{
-			ss << v[i];
-			if (i < limit) ss << ",";
-		}
-		Core::SetXMLNodeValue(data.Document, data.Node, ss.str().c_str());
-		ss.str("");
+		Core::SetValuesSXML(data, v, size, size);
 	}
 
 	template <typename T>
 	inline void DeserializeAsArraySXML(Core::DeserializationSXMLData& data, T* v, size_t size)
 	{
-		data.PlaceNodeValue();
-		auto parts = Core::Split(data.Chars->GetArray(), Core::IsCharacter(','), true);
-		assert(parts.size() == size);
-		for (unsigned i = 0; i < 3; i++) v[i] = Core::Parse<T>(parts[i].c_str());
+		Core::GetValuesSXML(data, v, size);
 	}
 
 	template <typename T, glm::precision P>
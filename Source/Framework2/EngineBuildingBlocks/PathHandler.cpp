@@ -18,9 +18,8 @@ using namespace EngineBuildingBlocks;
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
-PathHandler::PathHandler()
+inline std::string GetExecutablePath()
 {
-	// Setting executable path.
 #ifdef IS_WINDOWS
 
 	wchar_t buffer[MAX_PATH];
@@ -29,7 +28,7 @@ PathHandler::PathHandler()
 	{
 		EngineBuildingBlocks::RaiseException("Error getting executable path.");
 	}
-	m_ExecutablePath = Core::ToString(buffer);
+	return Core::ToString(buffer);
 
 #else
 
@@ -44,11 +43,15 @@ PathHandler::PathHandler()
 		EngineBuildingBlocks::RaiseException("Error getting executable path.");
 	}
 	path[numChars] = '\0';
-	m_ExecutablePath = path;
+	return path;
 
 #endif
+}
 
-	// Setting executable path.
+PathHandler::PathHandler()
+	: m_ExecutablePath(GetExecutablePath())
+{
+	// Setting executable directory.
 	m_ExecutableDirectory = Core::GetParentPath(m_ExecutablePath);
 
 	// Solution folder contains a folder called 'Sources', the project folder of the file.
@@ -67,6 +70,13 @@ PathHandler::PathHandler()
 	EngineBuildingBlocks::RaiseException(ss);
 }
 
+PathHandler::PathHandler(const std::string& solutionDirectory)
+	: m_ExecutablePath(GetExecutablePath())
+	, m_ExecutableDirectory(Core::GetParentPath(m_ExecutablePath))
+	, m_SolutionDirectory(solutionDirectory)
+{
+}
+
 // Note that this only works for EXISTING paths.
 std::string PathHandler::CompletePath(const std::string& path) const
 {
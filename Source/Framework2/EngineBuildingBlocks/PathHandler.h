@@ -19,6 +19,10 @@ namespace EngineBuildingBlocks
 
 		PathHandler();
 
+		// The resources and the built resources are in the given solution directory, e.g. a temporary directory
+		// of a test.
+		explicit PathHandler(const std::string& solutionDirectory);
+
 		std::string GetPathFromExecutableDirectory(const std::string& relativePath) const;
 		std::string GetPathFromSolution(const std::string& relativePath) const;
 		std::string GetPathFromResourcesDirectory(const std::string& relativePath) const;
@@ -3,12 +3,24 @@
 #include <EngineBuildingBlocks/ResourceDatabase.h>
 
 #include <Core/String.hpp>
+#include <Core/Checksum.h>
+#include <Core/ChunkedContainer.h>
 #include <Core/Comparison.h>
+#include <Core/Constants.h>
+#include <Core/Platform.h>
+#include <Core/Windows.h>
+#include <Core/SimpleBinarySerialization.hpp>
+#include <Core/StreamBinarySerialization.h>
+#include <Core/System/FileScanner.h>
 #include <Core/System/Filesystem.h>
+#include <Core/System/MemoryMappedFile.h>
+#include <Core/System/ThreadPool.h>
 #include <EngineBuildingBlocks/PathHandler.h>
 #include <EngineBuildingBlocks/ErrorHandling.h>
 
-#include <functional>
+#include <algorithm>
+#include <cstdio>
+#include <exception>
 #include <sstream>
 
 using namespace EngineBuildingBlocks;
@@ -41,90 +53,584 @@ bool ResourceDescription::operator<(const ResourceDescription& other) const
 	return false;
 }
 
+void ResourceDescription::SerializeSB(Core::ByteVector& bytes) const
+{
+	Core::SerializeSB(bytes, IsBuiltResource);
+	Core::SerializeSB(bytes, ResourceFilePath);
+	Core::SerializeSB(bytes, DependencyPaths);
+	Core::SerializeSB(bytes, SerializedBuildOptions);
+}
+
+void ResourceDescription::DeserializeSB(const unsigned char*& bytes)
+{
+	Core::DeserializeSB(bytes, IsBuiltResource);
+	Core::DeserializeSB(bytes, ResourceFilePath);
+	Core::DeserializeSB(bytes, DependencyPaths);
+	Core::DeserializeSB(bytes, SerializedBuildOptions);
+}
+
+void ResourceSourceRecord::SerializeSB(Core::ByteVector& bytes) const
+{
+	Core::SerializeSB(bytes, Path);
+	Core::SerializeSB(bytes, Size);
+	Core::SerializeSB(bytes, LastWriteTime);
+	Core::SerializeSB(bytes, ContentHash);
+}
+
+void ResourceSourceRecord::DeserializeSB(const unsigned char*& bytes)
+{
+	Core::DeserializeSB(bytes, Path);
+	Core::DeserializeSB(bytes, Size);
+	Core::DeserializeSB(bytes, LastWriteTime);
+	Core::DeserializeSB(bytes, ContentHash);
+}
+
+void ResourceBuildRecord::SerializeSB(Core::ByteVector& bytes) const
+{
+	Core::SerializeSB(bytes, Description);
+	Core::SerializeSB(bytes, Sources);
+	Core::SerializeSB(bytes, BuildDuration);
+}
+
+void ResourceBuildRecord::DeserializeSB(const unsigned char*& bytes)
+{
+	Core::DeserializeSB(bytes, Description);
+	Core::DeserializeSB(bytes, Sources);
+	Core::DeserializeSB(bytes, BuildDuration);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+	const std::uint32_t c_ManifestFormatVersion = 1;
+	const std::uint32_t c_ManifestChunkId = Core::MakeFourCC('R', 'D', 'B', 'M');
+
+	const char* c_ManifestFileName = "ResourceDatabase.manifest";
+
+	// Replaces the target file with the source file atomically: the target is either the old or the new file,
+	// even if the process is terminated.
+	inline bool ReplaceFileAtomically(const std::string& sourcePath, const std::string& targetPath)
+	{
+#ifdef IS_WINDOWS
+		return (MoveFileExW(Core::ToWString(sourcePath).c_str(), Core::ToWString(targetPath).c_str(),
+			MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0);
+#else
+		return (std::rename(sourcePath.c_str(), targetPath.c_str()) == 0);
+#endif
+	}
+
+	// The resource hash only depends on these members, the dependencies may change between the queries.
+	inline bool IsSameResource(const ResourceDescription& description1, const ResourceDescription& description2)
+	{
+		return (description1.ResourceFilePath == description2.ResourceFilePath
+			&& description1.SerializedBuildOptions == description2.SerializedBuildOptions);
+	}
+
+	// A file, which can't be read, gets a zero hash, thus its resources are considered to be changed.
+	void ComputeContentHashes(unsigned threadIndex, unsigned startIndex, unsigned endIndex,
+		const std::string* paths, const unsigned* pathIndices, std::uint64_t* contentHashes)
+	{
+		for (unsigned i = startIndex; i < endIndex; i++)
+		{
+			unsigned pathIndex = pathIndices[i];
+			try
+			{
+				Core::MemoryMappedFile file(paths[pathIndex]);
+				contentHashes[pathIndex] = Core::ComputeHash64(file.GetData(), file.GetSize());
+			}
+			catch (const std::exception&)
+			{
+				contentHashes[pathIndex] = 0;
+			}
+		}
+	}
+
+	// Collects the distinct paths of a batch.
+	class PathBatch
+	{
+		std::unordered_map<std::string, unsigned> m_PathIndices;
+
+	public:
+
+		std::vector<std::string> Paths;
+		std::vector<Core::FileStatus> Statuses;
+		std::vector<std::uint64_t> ContentHashes;
+		Core::IndexVectorU PathsToHash;
+
+		unsigned Add(const std::string& path)
+		{
+			auto it = m_PathIndices.find(path);
+			if (it == m_PathIndices.end())
+			{
+				it = m_PathIndices.insert({ path, static_cast<unsigned>(Paths.size()) }).first;
+				Paths.push_back(path);
+			}
+			return it->second;
+		}
+
+		void QueryStatuses(Core::ThreadPool* threadPool)
+		{
+			Statuses.resize(Paths.size());
+			Core::GetFileStatuses(Paths.data(), Paths.size(), Statuses.data(), threadPool);
+		}
+
+		void ComputeHashes(Core::ThreadPool* threadPool)
+		{
+			ContentHashes.resize(Paths.size());
+			unsigned countPaths = PathsToHash.GetSize();
+			if (threadPool != nullptr && countPaths > 1)
+			{
+				threadPool->ExecuteWithStaticScheduling(countPaths, &ComputeContentHashes,
+					Paths.data(), PathsToHash.GetArray(), ContentHashes.data());
+			}
+			else
+			{
+				ComputeContentHashes(0, 0, countPaths, Paths.data(), PathsToHash.GetArray(), ContentHashes.data());
+			}
+		}
+	};
+}
+
 ResourceDatabase::ResourceDatabase(PathHandler* pathHandler)
 	: m_PathHandler(pathHandler)
+	, m_ThreadPool(nullptr)
+	, m_IsManifestLoaded(false)
+	, m_IsManifestDirty(false)
 {
 }
 
-std::string ResourceDatabase::GetBuiltResourceFilePath(const ResourceDescription& description)
+ResourceDatabase::~ResourceDatabase()
 {
-	auto& filePath = description.ResourceFilePath;
-	auto& serializedBuildOptions = description.SerializedBuildOptions;
+	// The watcher thread must be stopped before the members it accesses are destroyed.
+	m_SourceWatcher.Stop();
+
+	try
+	{
+		SaveManifest();
+	}
+	catch (const std::exception& ex)
+	{
+		RaiseWarning(std::string("Failed to save the resource database manifest: ") + ex.what());
+	}
+}
+
+void ResourceDatabase::SetThreadPool(Core::ThreadPool* threadPool)
+{
+	m_ThreadPool = threadPool;
+}
+
+std::string ResourceDatabase::GetManifestFilePath() const
+{
+	return m_PathHandler->GetPathFromBuiltResourcesDirectory(c_ManifestFileName);
+}
+
+void ResourceDatabase::LoadManifest()
+{
+	if (m_IsManifestLoaded) return;
+	m_IsManifestLoaded = true;
 
-	unsigned filePathLength = static_cast<unsigned>(filePath.length());
-	unsigned bufferLength = serializedBuildOptions.GetSize();
+	auto manifestFilePath = GetManifestFilePath();
+	if (!Core::FileExists(manifestFilePath)) return;
 
-	// Serializing data to buffer.
-	std::string buffer;
-	buffer.append(reinterpret_cast<const char*>(&filePathLength), sizeof(unsigned));
-	buffer.append(reinterpret_cast<const char*>(filePath.c_str()), filePathLength);
-	buffer.append(reinterpret_cast<const char*>(&bufferLength), sizeof(unsigned));
-	buffer.append(reinterpret_cast<const char*>(serializedBuildOptions.GetArray()),
-		bufferLength);
+	// An invalid manifest is ignored: all resources are rebuilt and the manifest is rewritten.
+	try
+	{
+		Core::MemoryMappedFile manifestFile(manifestFilePath);
+		Core::ChunkedContainerReader reader(manifestFile.GetData(), manifestFile.GetSize());
+		if (reader.GetContentVersion() != c_ManifestFormatVersion) return;
+		unsigned chunkIndex = reader.FindChunk(c_ManifestChunkId);
+		if (chunkIndex == Core::c_InvalidIndexU) return;
+		auto data = reader.GetVerifiedChunkData(chunkIndex);
+
+		const unsigned char* bytes = data.GetArray();
+		unsigned countRecords;
+		Core::DeserializeSB(bytes, countRecords);
+		for (unsigned i = 0; i < countRecords; i++)
+		{
+			std::uint64_t hashValue;
+			Core::DeserializeSB(bytes, hashValue);
+			auto& record = m_Records[hashValue];
+			Core::DeserializeSB(bytes, record);
+			m_Products[GetBuiltResourceFilePath(hashValue, record.Description)] = hashValue;
+		}
+	}
+	catch (const std::exception&)
+	{
+		RaiseWarning("The resource database manifest is invalid: " + manifestFilePath);
+		m_Records.clear();
+		m_Products.clear();
+	}
+}
+
+void ResourceDatabase::SaveManifest()
+{
+	if (!m_IsManifestDirty) return;
+
+	// Only the records of the built resources are stored.
+	Core::ByteVector bytes;
+	unsigned countRecords = 0;
+	Core::SerializeSB(bytes, countRecords);
+	for (auto& recordData : m_Records)
+	{
+		if (recordData.second.Sources.empty()) continue;
+		Core::SerializeSB(bytes, recordData.first);
+		Core::SerializeSB(bytes, recordData.second);
+		++countRecords;
+	}
+	memcpy(bytes.GetArray(), &countRecords, sizeof(countRecords));
+
+	// The manifest is written to a temporary file and then replaced, thus it's never left incomplete.
+	auto manifestFilePath = GetManifestFilePath();
+	auto temporaryFilePath = manifestFilePath + ".tmp";
+	Core::PreparePath(manifestFilePath);
+	{
+		Core::FileOutputSinkSB fileSink(temporaryFilePath);
+		Core::ChunkedContainerWriter writer(fileSink, c_ManifestFormatVersion);
+		writer.BeginChunk(c_ManifestChunkId).Write(bytes.GetArray(), bytes.GetSize());
+		writer.EndChunk();
+		writer.Finish();
+		fileSink.Close();
+	}
+	if (!ReplaceFileAtomically(temporaryFilePath, manifestFilePath))
+	{
+		RaiseException("Failed to write the resource database manifest: " + manifestFilePath);
+	}
+
+	m_IsManifestDirty = false;
+}
+
+std::uint64_t ResourceDatabase::GetResourceHash(const ResourceDescription& description)
+{
+	auto& serializedBuildOptions = description.SerializedBuildOptions;
 
-	auto hashValue = std::hash<std::string>()(buffer);
+	// The hash of the file path seeds the hash of the build options. Unlike std::hash, the hash value
+	// doesn't depend on the standard library implementation, thus the built resource file names are stable.
+	auto hashValue = Core::ComputeHash64(serializedBuildOptions.GetArray(), serializedBuildOptions.GetSize(),
+		Core::GetHash64(description.ResourceFilePath));
 
-	// Checking hash collisions.
-	// Note that this solution is not complete: it is possible that the same hash and name is assigned
-	// to two different resources, however we save/load them in different program instances.
-	auto hIt = m_Hashes.find(hashValue);
-	if (hIt == m_Hashes.end())
+	// Checking hash collisions. The records contain the descriptions of the resources of the previous program
+	// runs, thus the collisions between them are also detected.
+	auto rIt = m_Records.find(hashValue);
+	if (rIt == m_Records.end())
 	{
-		m_Hashes[hashValue] = description;
+		auto& record = m_Records[hashValue];
+		record.Description = description;
+		record.BuildDuration = 0.0;
 	}
-	else if (hIt->second != description)
+	else if (!IsSameResource(rIt->second.Description, description))
 	{
 		EngineBuildingBlocks::RaiseException("A hash collision has occured.");
 	}
+	else if (rIt->second.Description != description)
+	{
+		// The dependencies have changed, thus the resource has to be rebuilt.
+		rIt->second.Description = description;
+		rIt->second.Sources.clear();
+		m_IsManifestDirty = true;
+	}
+
+	return hashValue;
+}
 
+std::string ResourceDatabase::GetBuiltResourceFilePath(std::uint64_t hashValue, const ResourceDescription& description)
+{
 	// We also use the file name to make built resources to resource connection readable for humans.
 	std::stringstream ss;
-	ss << Core::Replace(Core::GetFileName(filePath), ".", "_") << "_" << hashValue << ".bin";
+	ss << Core::Replace(Core::GetFileName(description.ResourceFilePath), ".", "_") << "_" << hashValue << ".bin";
 
 	return m_PathHandler->GetPathFromBuiltResourcesDirectory(ss.str());
 }
 
+// A resource is one level higher than the highest built resource it depends on.
+unsigned ResourceDatabase::GetBuildLevel(std::uint64_t hashValue, std::unordered_map<std::uint64_t, unsigned>& levels)
+{
+	auto lIt = levels.find(hashValue);
+	if (lIt != levels.end()) return lIt->second;
+
+	// Inserting the level before the recursion terminates dependency cycles.
+	levels[hashValue] = 0;
+	unsigned level = 0;
+	auto updateLevel = [&](const std::string& path) {
+		auto pIt = m_Products.find(path);
+		if (pIt != m_Products.end() && pIt->second != hashValue)
+		{
+			level = std::max(level, GetBuildLevel(pIt->second, levels) + 1);
+		}
+	};
+	auto& record = m_Records[hashValue];
+	for (auto& dependencyPath : record.Description.DependencyPaths) updateLevel(dependencyPath);
+	for (auto& source : record.Sources) updateLevel(source.Path);
+	levels[hashValue] = level;
+	return level;
+}
+
 void ResourceDatabase::GetBuiltResourceDescription(
 	const ResourceDescription& resourceDescription,
 	BuiltResourceDescription& builtResourceDescription)
 {
-	auto& filePath = resourceDescription.ResourceFilePath;
-	if (resourceDescription.IsBuiltResource)
-	{
-		builtResourceDescription.BuiltResourceFilePath = filePath;
-		builtResourceDescription.IsUpToDate = true;
-	}
-	else
+	GetBuiltResourceDescriptions(&resourceDescription, 1, &builtResourceDescription);
+}
+
+void ResourceDatabase::GetBuiltResourceDescriptions(
+	const ResourceDescription* resourceDescriptions,
+	size_t countResources,
+	BuiltResourceDescription* builtResourceDescriptions)
+{
+	LoadManifest();
+
+	// Collecting the distinct paths: the built files and the recorded sources.
+	// Resources often share dependencies, e.g. textures and material libraries.
+	PathBatch batch;
+	std::vector<std::uint64_t> hashValues(countResources);
+	Core::IndexVectorU builtPathIndices;
+	builtPathIndices.Resize(static_cast<unsigned>(countResources));
+	Core::IndexVectorU sourcePathIndices;
+	for (size_t i = 0; i < countResources; i++)
 	{
-		auto builtFilePath = GetBuiltResourceFilePath(resourceDescription);
-		bool isUptoDate = Core::FileExists(builtFilePath);
-		if (isUptoDate)
+		auto& resourceDescription = resourceDescriptions[i];
+		auto& builtResourceDescription = builtResourceDescriptions[i];
+		builtResourceDescription.BuildLevel = 0;
+		builtResourceDescription.LastBuildDuration = 0.0;
+		if (resourceDescription.IsBuiltResource)
+		{
+			builtResourceDescription.BuiltResourceFilePath = resourceDescription.ResourceFilePath;
+			builtResourceDescription.IsUpToDate = true;
+		}
+		else
 		{
-			auto resourceLastWriteTime = Core::GetLastWriteTime(filePath);
-			auto builtResourceCacheLastWriteTime = Core::GetLastWriteTime(builtFilePath);
+			auto hashValue = GetResourceHash(resourceDescription);
+			hashValues[i] = hashValue;
+			builtResourceDescription.BuiltResourceFilePath = GetBuiltResourceFilePath(hashValue, resourceDescription);
+			builtPathIndices[i] = batch.Add(builtResourceDescription.BuiltResourceFilePath);
+			m_Products[builtResourceDescription.BuiltResourceFilePath] = hashValue;
+			for (auto& source : m_Records[hashValue].Sources) sourcePathIndices.PushBack(batch.Add(source.Path));
+		}
+	}
+	batch.QueryStatuses(m_ThreadPool);
 
-			isUptoDate = (resourceLastWriteTime < builtResourceCacheLastWriteTime);
+	// Comparing the sizes and the last write times with the recorded ones. If only the last write time
+	// of a file differs, its content hash decides.
+	std::vector<bool> isUpToDate(countResources, true);
+	auto compareSources = [&](bool isComparingHashes) {
+		const unsigned* pSourcePathIndex = sourcePathIndices.GetArray();
+		for (size_t i = 0; i < countResources; i++)
+		{
+			if (resourceDescriptions[i].IsBuiltResource) continue;
+			auto& record = m_Records[hashValues[i]];
+			if (record.Sources.empty() || !batch.Statuses[builtPathIndices[i]].Exists) isUpToDate[i] = false;
 
-			if (isUptoDate)
+			// A missing resource file doesn't invalidate the built resource: it can't be rebuilt anyway.
+			for (size_t j = 0; j < record.Sources.size(); j++)
 			{
-				auto& dependencyPaths = resourceDescription.DependencyPaths;
-				for (size_t i = 0; i < dependencyPaths.size(); i++)
+				unsigned pathIndex = *pSourcePathIndex++;
+				auto& status = batch.Statuses[pathIndex];
+				auto& source = record.Sources[j];
+				if (!status.Exists)
 				{
-					auto dependencyLastWriteTime = Core::GetLastWriteTime(dependencyPaths[i]);
-
-					isUptoDate = (dependencyLastWriteTime < builtResourceCacheLastWriteTime);
-
-					if (!isUptoDate)
+					if (j > 0) isUpToDate[i] = false;
+				}
+				else if (status.Size != source.Size)
+				{
+					isUpToDate[i] = false;
+				}
+				else if (status.LastWriteTime != source.LastWriteTime)
+				{
+					if (!isComparingHashes)
+					{
+						batch.PathsToHash.PushBack(pathIndex);
+					}
+					else if (batch.ContentHashes[pathIndex] != source.ContentHash)
 					{
-						break;
+						isUpToDate[i] = false;
+					}
+					else
+					{
+						// Only the time has changed, e.g. the file was saved or checked out without modification.
+						source.LastWriteTime = status.LastWriteTime;
+						m_IsManifestDirty = true;
 					}
 				}
 			}
 		}
-		builtResourceDescription.BuiltResourceFilePath = builtFilePath;
-		builtResourceDescription.IsUpToDate = isUptoDate;
+	};
+	compareSources(false);
+	std::sort(batch.PathsToHash.GetArray(), batch.PathsToHash.GetArray() + batch.PathsToHash.GetSize());
+	batch.PathsToHash.Resize(static_cast<unsigned>(std::unique(batch.PathsToHash.GetArray(),
+		batch.PathsToHash.GetArray() + batch.PathsToHash.GetSize()) - batch.PathsToHash.GetArray()));
+	batch.ComputeHashes(m_ThreadPool);
+	compareSources(true);
+
+	std::lock_guard<std::mutex> lock(m_WatchMutex);
+	bool isWatching = m_SourceWatcher.IsWatching();
+	std::unordered_map<std::uint64_t, size_t> batchIndices;
+	for (size_t i = 0; i < countResources; i++)
+	{
+		if (resourceDescriptions[i].IsBuiltResource) continue;
+		batchIndices[hashValues[i]] = i;
+
+		// The invalidation by the watcher is consumed by the query, since the resource is rebuilt after it.
+		if (m_OutdatedResources.erase(hashValues[i]) > 0) isUpToDate[i] = false;
+		if (isWatching) RegisterSources(hashValues[i], m_Records[hashValues[i]]);
+	}
+
+	// Propagating the invalidation to the resources of the batch, which depend on invalidated built resources.
+	for (bool isChanged = true; isChanged;)
+	{
+		isChanged = false;
+		for (size_t i = 0; i < countResources; i++)
+		{
+			if (resourceDescriptions[i].IsBuiltResource || !isUpToDate[i]) continue;
+			for (auto& source : m_Records[hashValues[i]].Sources)
+			{
+				auto pIt = m_Products.find(source.Path);
+				if (pIt == m_Products.end()) continue;
+				auto bIt = batchIndices.find(pIt->second);
+				if (bIt != batchIndices.end() && !isUpToDate[bIt->second])
+				{
+					isUpToDate[i] = false;
+					isChanged = true;
+					break;
+				}
+			}
+		}
+	}
+
+	std::unordered_map<std::uint64_t, unsigned> levels;
+	for (size_t i = 0; i < countResources; i++)
+	{
+		if (resourceDescriptions[i].IsBuiltResource) continue;
+		auto& builtResourceDescription = builtResourceDescriptions[i];
+		builtResourceDescription.IsUpToDate = isUpToDate[i];
+		builtResourceDescription.BuildLevel = GetBuildLevel(hashValues[i], levels);
+		builtResourceDescription.LastBuildDuration = m_Records[hashValues[i]].BuildDuration;
 	}
-}
\ No newline at end of file
+}
+
+void ResourceDatabase::SetResourceBuilt(const ResourceBuildResult& result)
+{
+	SetResourcesBuilt(&result, 1);
+}
+
+void ResourceDatabase::SetResourcesBuilt(const ResourceBuildResult* results, size_t countResults)
+{
+	LoadManifest();
+
+	// The resource file is the first source, followed by the given and the discovered dependencies.
+	PathBatch batch;
+	std::vector<Core::IndexVectorU> sourcePathIndices(countResults);
+	for (size_t i = 0; i < countResults; i++)
+	{
+		auto& result = results[i];
+		auto& pathIndices = sourcePathIndices[i];
+		auto addSource = [&](const std::string& path) {
+			unsigned pathIndex = batch.Add(path);
+			if (std::find(pathIndices.GetArray(), pathIndices.GetArray() + pathIndices.GetSize(), pathIndex)
+				== pathIndices.GetArray() + pathIndices.GetSize())
+			{
+				pathIndices.PushBack(pathIndex);
+			}
+		};
+		addSource(result.Description->ResourceFilePath);
+		for (auto& dependencyPath : result.Description->DependencyPaths) addSource(dependencyPath);
+		for (auto& dependencyPath : result.DiscoveredDependencyPaths) addSource(dependencyPath);
+	}
+	batch.QueryStatuses(m_ThreadPool);
+	for (unsigned i = 0; i < static_cast<unsigned>(batch.Paths.size()); i++)
+	{
+		if (batch.Statuses[i].Exists) batch.PathsToHash.PushBack(i);
+	}
+	batch.ComputeHashes(m_ThreadPool);
+
+	std::lock_guard<std::mutex> lock(m_WatchMutex);
+	bool isWatching = m_SourceWatcher.IsWatching();
+	for (size_t i = 0; i < countResults; i++)
+	{
+		auto& result = results[i];
+		auto hashValue = GetResourceHash(*result.Description);
+		auto& record = m_Records[hashValue];
+		record.Sources.clear();
+		auto& pathIndices = sourcePathIndices[i];
+		for (unsigned j = 0; j < pathIndices.GetSize(); j++)
+		{
+			unsigned pathIndex = pathIndices[j];
+			auto& status = batch.Statuses[pathIndex];
+			if (!status.Exists) continue;
+			record.Sources.push_back({ batch.Paths[pathIndex], status.Size, status.LastWriteTime,
+				batch.ContentHashes[pathIndex] });
+		}
+		record.BuildDuration = result.BuildDuration;
+		m_Products[GetBuiltResourceFilePath(hashValue, record.Description)] = hashValue;
+		if (isWatching) RegisterSources(hashValue, record);
+	}
+
+	m_IsManifestDirty = true;
+	SaveManifest();
+}
+
+void ResourceDatabase::RegisterSources(std::uint64_t hashValue, const ResourceBuildRecord& record)
+{
+	auto registerSource = [this, hashValue](const std::string& path) {
+		auto& hashValues = m_SourceResources[Core::GetAbsolutePath(path)];
+		if (std::find(hashValues.begin(), hashValues.end(), hashValue) == hashValues.end())
+		{
+			hashValues.push_back(hashValue);
+		}
+	};
+	registerSource(record.Description.ResourceFilePath);
+	for (auto& dependencyPath : record.Description.DependencyPaths) registerSource(dependencyPath);
+	for (auto& source : record.Sources) registerSource(source.Path);
+}
+
+void ResourceDatabase::OnSourceChanged(const Core::FileChange& change)
+{
+	std::lock_guard<std::mutex> lock(m_WatchMutex);
+	auto it = m_SourceResources.find(change.Path);
+	if (it == m_SourceResources.end()) return;
+	for (auto hashValue : it->second)
+	{
+		m_OutdatedResources.insert(hashValue);
+		m_InvalidatedResources.insert(hashValue);
+	}
+}
+
+void ResourceDatabase::StartWatchingSources(const std::string& directoryPath)
+{
+	LoadManifest();
+	StopWatchingSources();
+	{
+		std::lock_guard<std::mutex> lock(m_WatchMutex);
+		for (auto& recordData : m_Records) RegisterSources(recordData.first, recordData.second);
+	}
+	m_SourceWatcher.Start(Core::GetAbsolutePath(directoryPath),
+		[this](const Core::FileChange& change) { OnSourceChanged(change); });
+}
+
+void ResourceDatabase::StopWatchingSources()
+{
+	m_SourceWatcher.Stop();
+	std::lock_guard<std::mutex> lock(m_WatchMutex);
+	m_SourceResources.clear();
+}
+
+void ResourceDatabase::GetInvalidatedResources(std::vector<ResourceDescription>& resourceDescriptions)
+{
+	std::lock_guard<std::mutex> lock(m_WatchMutex);
+	for (auto hashValue : m_InvalidatedResources)
+	{
+		resourceDescriptions.push_back(m_Records[hashValue].Description);
+	}
+	m_InvalidatedResources.clear();
+}
+
+void EngineBuildingBlocks::SortByBuildOrder(const BuiltResourceDescription* builtResourceDescriptions,
+	unsigned* indices, unsigned countIndices)
+{
+	std::stable_sort(indices, indices + countIndices, [builtResourceDescriptions](unsigned index1, unsigned index2) {
+		auto& description1 = builtResourceDescriptions[index1];
+		auto& description2 = builtResourceDescriptions[index2];
+		if (description1.BuildLevel != description2.BuildLevel) return description1.BuildLevel < description2.BuildLevel;
+		return description1.LastBuildDuration > description2.LastBuildDuration;
+	});
+}
@@ -4,10 +4,20 @@
 #define _ENGINEBUILDINGBLOCKS_RESOURCEDATABASE_H_INCLUDED_
 
 #include <Core/DataStructures/SimpleTypeVector.hpp>
+#include <Core/System/FileWatcher.h>
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <map>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+
+namespace Core
+{
+	class ThreadPool;
+}
 
 namespace EngineBuildingBlocks
 {
@@ -28,30 +38,149 @@ namespace EngineBuildingBlocks
 		bool operator==(const ResourceDescription& other) const;
 		bool operator!=(const ResourceDescription& other) const;
 		bool operator<(const ResourceDescription& other) const;
+
+		void SerializeSB(Core::ByteVector& bytes) const;
+		void DeserializeSB(const unsigned char*& bytes);
 	};
 
 	struct BuiltResourceDescription
 	{
 		std::string BuiltResourceFilePath;
 		bool IsUpToDate;
+
+		// The resources of a level only depend on built resources of lower levels, thus the resources
+		// of the same level can be built in parallel, and the levels must be built in increasing order.
+		unsigned BuildLevel;
+
+		// The duration of the last build in seconds, or 0 if it's unknown.
+		double LastBuildDuration;
 	};
 
+	// The state of a source file when its resource was built.
+	struct ResourceSourceRecord
+	{
+		std::string Path;
+		std::uint64_t Size;
+		long long LastWriteTime;
+		std::uint64_t ContentHash;
+
+		void SerializeSB(Core::ByteVector& bytes) const;
+		void DeserializeSB(const unsigned char*& bytes);
+	};
+
+	struct ResourceBuildRecord
+	{
+		ResourceDescription Description;
+
+		// The resource file and all dependencies, including the discovered ones. Empty if the resource
+		// has not been built.
+		std::vector<ResourceSourceRecord> Sources;
+
+		double BuildDuration;
+
+		void SerializeSB(Core::ByteVector& bytes) const;
+		void DeserializeSB(const unsigned char*& bytes);
+	};
+
+	struct ResourceBuildResult
+	{
+		const ResourceDescription* Description;
+
+		// The dependencies, which were found by building the resource, e.g. the material libraries of a model.
+		std::vector<std::string> DiscoveredDependencyPaths;
+
+		double BuildDuration;
+	};
+
+	// Maps resources to built resource files and decides whether they are up-to-date. The build records
+	// are stored in a manifest in the built resources directory, thus the decision is made across program runs
+	// by comparing the content hashes of the source files with the recorded ones. A content hash is only computed
+	// if the size or the last write time of a file has changed, otherwise a single lookup in the records
+	// and a batched file status query is sufficient.
 	class ResourceDatabase
 	{
 		PathHandler* m_PathHandler;
+		Core::ThreadPool* m_ThreadPool;
+
+		///////////////////////////////////// BUILD RECORDS /////////////////////////////////////
+
+		// Resource hash -> build record. It also contains the records of the resources, which were queried
+		// but haven't been built.
+		std::unordered_map<std::uint64_t, ResourceBuildRecord> m_Records;
+
+		// Built resource file path -> resource hash, for finding the resources which depend on built resources.
+		std::unordered_map<std::string, std::uint64_t> m_Products;
+
+		bool m_IsManifestLoaded;
+		bool m_IsManifestDirty;
 
-		std::map<size_t, ResourceDescription> m_Hashes;
+		std::string GetManifestFilePath() const;
+		void LoadManifest();
 
-		std::string GetBuiltResourceFilePath(const ResourceDescription& description);
+		std::uint64_t GetResourceHash(const ResourceDescription& description);
+		std::string GetBuiltResourceFilePath(std::uint64_t hashValue, const ResourceDescription& description);
+		unsigned GetBuildLevel(std::uint64_t hashValue, std::unordered_map<std::uint64_t, unsigned>& levels);
+
+		///////////////////////////////////// SOURCE WATCHING /////////////////////////////////////
+
+		Core::FileWatcher m_SourceWatcher;
+
+		// Protects the members below, which are also accessed by the thread of the watcher.
+		std::mutex m_WatchMutex;
+
+		// Absolute source file path -> hashes of the resources with the source file.
+		std::unordered_map<std::string, std::vector<std::uint64_t>> m_SourceResources;
+		std::set<std::uint64_t> m_OutdatedResources;
+		std::set<std::uint64_t> m_InvalidatedResources;
+
+		void RegisterSources(std::uint64_t hashValue, const ResourceBuildRecord& record);
+		void OnSourceChanged(const Core::FileChange& change);
 
 	public:
 
 		ResourceDatabase(PathHandler* pathHandler);
+		~ResourceDatabase();
+
+		// The file statuses and content hashes are computed with the threads of the thread pool.
+		void SetThreadPool(Core::ThreadPool* threadPool);
 
 		void GetBuiltResourceDescription(
 			const ResourceDescription& resourceDescription,
 			BuiltResourceDescription& builtResourceDescription);
+
+		// Queries the file statuses of all resources and dependencies in a single batch,
+		// querying each distinct path only once. A resource is not up-to-date if its built file doesn't exist,
+		// the content of a source file has changed, or it depends on a built resource, which is not up-to-date.
+		// Throws if the resource hash collides with a resource of the current or a previous program run.
+		void GetBuiltResourceDescriptions(
+			const ResourceDescription* resourceDescriptions,
+			size_t countResources,
+			BuiltResourceDescription* builtResourceDescriptions);
+
+		// Records that the resources have been built: the content hashes of their resource files
+		// and dependencies and the durations of the builds. The manifest is saved.
+		void SetResourceBuilt(const ResourceBuildResult& result);
+		void SetResourcesBuilt(const ResourceBuildResult* results, size_t countResults);
+
+		// Saves the manifest if the records have changed since it was saved. It's also saved on destruction.
+		void SaveManifest();
+
+		// Watches the source files under the directory. When a resource file or a dependency changes,
+		// its built resources are invalidated: they are reported as not up-to-date by the next query,
+		// and they are returned by GetInvalidatedResources for hot-reloading. Throws if the directory
+		// can't be watched.
+		void StartWatchingSources(const std::string& directoryPath);
+		void StopWatchingSources();
+
+		// Appends the descriptions of the resources, which have been invalidated since the last call, to the vector.
+		void GetInvalidatedResources(std::vector<ResourceDescription>& resourceDescriptions);
 	};
+
+	// Sorts the indices of the resources to their build order. The levels are built in increasing order, and within
+	// a level the longest builds are started first, which shortens the time while only a few threads are working
+	// at the end of the level. The resources with equal levels and durations keep their order.
+	void SortByBuildOrder(const BuiltResourceDescription* builtResourceDescriptions, unsigned* indices,
+		unsigned countIndices);
 }
 
-#endif
\ No newline at end of file
+#endif
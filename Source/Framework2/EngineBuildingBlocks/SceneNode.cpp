@@ -83,21 +83,22 @@ bool SceneNodeMainData::HasChild() const
 ///////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////
 
-unsigned SceneNodeHandler::_RegisterWrappedSceneNode(WrappedSceneNode* wrappedSceneNode)
+Core::Handle SceneNodeHandler::_RegisterWrappedSceneNode(WrappedSceneNode* wrappedSceneNode)
 {
 	return m_WrappedSceneNodes.Add(wrappedSceneNode);
 }
 
-void SceneNodeHandler::_DeregisterWrappedSceneNode(unsigned wrappedSceneNodeIndex)
+void SceneNodeHandler::_DeregisterWrappedSceneNode(Core::Handle wrappedSceneNodeHandle)
 {
-	m_WrappedSceneNodes.Remove(wrappedSceneNodeIndex);
+	m_WrappedSceneNodes.TryRemove(wrappedSceneNodeHandle);
 }
 
-void SceneNodeHandler::_UpdateWrappedSceneNode(unsigned wrappedSceneNodeIndex, WrappedSceneNode* newWrappedSceneNode)
+void SceneNodeHandler::_UpdateWrappedSceneNode(Core::Handle wrappedSceneNodeHandle, WrappedSceneNode* newWrappedSceneNode)
 {
-	if (wrappedSceneNodeIndex != Core::c_InvalidIndexU)
+	auto pWrappedSceneNode = m_WrappedSceneNodes.TryGet(wrappedSceneNodeHandle);
+	if (pWrappedSceneNode != nullptr)
 	{
-		m_WrappedSceneNodes[wrappedSceneNodeIndex] = newWrappedSceneNode;
+		*pWrappedSceneNode = newWrappedSceneNode;
 	}
 }
 
@@ -980,6 +981,16 @@ void SceneNodeHandler::UpdateTransformations(const Core::ByteVectorU& allowedMas
 	}
 }
 
+void SceneNodeHandler::UpdateTransformations(const Core::BitSet& allowedMask)
+{
+	auto countUpdateLevels = static_cast<unsigned char>(m_SceneNodeIndicesForUpdate.size());
+	for (unsigned char updateLevel = 0; updateLevel < countUpdateLevels; updateLevel++)
+	{
+		GatherDirtyIndices(updateLevel, allowedMask);
+		UpdateTransformationsInParallel(updateLevel);
+	}
+}
+
 void SceneNodeHandler::UpdateTransformations(const Core::IndexVectorU& allowedIndices)
 {
 	auto countUpdateLevels = static_cast<unsigned char>(m_SceneNodeIndicesForUpdate.size());
@@ -1011,8 +1022,8 @@ void SceneNodeHandler::GatherDirtyIndices(unsigned char updateLevel)
 	auto& nodeIndices = m_SceneNodeIndicesForUpdate[updateLevel];
 	m_DirtySceneNodeIndices.ClearAndReserve(nodeIndices.GetSize());
 
-	auto it = nodeIndices.GetBeginConstIterator();
-	auto end = nodeIndices.GetEndConstIterator();
+	auto it = nodeIndices.GetDenseBeginConstIterator();
+	auto end = nodeIndices.GetDenseEndConstIterator();
 	for (; it != end; ++it)
 	{
 		unsigned sceneNodeIndex = *it;
@@ -1024,21 +1035,61 @@ void SceneNodeHandler::GatherDirtyIndices(unsigned char updateLevel)
 	}
 }
 
-void SceneNodeHandler::GatherDirtyIndices(unsigned char updateLevel, const Core::ByteVectorU& allowedMask)
+inline unsigned GetAllowedMaskSize(const Core::ByteVectorU& allowedMask)
+{
+	return allowedMask.GetSize();
+}
+
+inline unsigned GetAllowedMaskSize(const Core::BitSet& allowedMask)
+{
+	return static_cast<unsigned>(allowedMask.GetSize());
+}
+
+inline bool IsAllowedByMask(const Core::ByteVectorU& allowedMask, unsigned index)
+{
+	return (allowedMask[index] != 0);
+}
+
+inline bool IsAllowedByMask(const Core::BitSet& allowedMask, unsigned index)
+{
+	return allowedMask.Get(index);
+}
+
+template <typename Function>
+inline void ForEachAllowedIndex(const Core::ByteVectorU& allowedMask, Function&& function)
+{
+	unsigned allowedMaskSize = allowedMask.GetSize();
+	for (unsigned i = 0; i < allowedMaskSize; i++)
+	{
+		if (allowedMask[i])
+		{
+			function(i);
+		}
+	}
+}
+
+template <typename Function>
+inline void ForEachAllowedIndex(const Core::BitSet& allowedMask, Function&& function)
+{
+	allowedMask.ForEachSetBit([&](size_t i) { function(static_cast<unsigned>(i)); });
+}
+
+template <typename AllowedMaskType>
+void SceneNodeHandler::GatherDirtyIndices(unsigned char updateLevel, const AllowedMaskType& allowedMask)
 {
-	auto allowedMaskSize = allowedMask.GetSize();
+	auto allowedMaskSize = GetAllowedMaskSize(allowedMask);
 	auto mainData = GetMainData();
 	auto& nodeIndices = m_SceneNodeIndicesForUpdate[updateLevel];
 	m_DirtySceneNodeIndices.ClearAndReserve(nodeIndices.GetSize());
 
-	auto it = nodeIndices.GetBeginConstIterator();
-	auto end = nodeIndices.GetEndConstIterator();
+	auto it = nodeIndices.GetDenseBeginConstIterator();
+	auto end = nodeIndices.GetDenseEndConstIterator();
 	for (; it != end; ++it)
 	{
 		unsigned sceneNodeIndex = *it;
 
 		if (mainData[sceneNodeIndex].IsTransformationDirtyForHandler()
-			&& sceneNodeIndex < allowedMaskSize && allowedMask[sceneNodeIndex])
+			&& sceneNodeIndex < allowedMaskSize && IsAllowedByMask(allowedMask, sceneNodeIndex))
 		{
 			m_DirtySceneNodeIndices.UnsafePushBackPlaceHolder() = sceneNodeIndex;
 		}
@@ -1047,17 +1098,15 @@ void SceneNodeHandler::GatherDirtyIndices(unsigned char updateLevel, const Core:
 #ifdef _DEBUG
 	if (m_CheckForSubsetUpdateSafety)
 	{
-		for (unsigned i = 0; i < allowedMaskSize; i++)
+		ForEachAllowedIndex(allowedMask, [&](unsigned i)
 		{
-			if (allowedMask[i])
+			unsigned parentIndex = mainData[i].ParentIndex;
+			if (parentIndex != Core::c_InvalidIndexU
+				&& (parentIndex >= allowedMaskSize || !IsAllowedByMask(allowedMask, parentIndex)))
 			{
-				unsigned parentIndex = mainData[i].ParentIndex;
-				if (parentIndex != Core::c_InvalidIndexU && (parentIndex >= allowedMaskSize || !allowedMask[parentIndex]))
-				{
-					EngineBuildingBlocks::RaiseException("The given subset of scene nodes cannot be safely updated.");
-				}
+				EngineBuildingBlocks::RaiseException("The given subset of scene nodes cannot be safely updated.");
 			}
-		}
+		});
 	}
 #endif
 }
@@ -1355,11 +1404,11 @@ std::map<unsigned, unsigned> SceneNodeHandler::CompactSceneNodes(bool isShrinkin
 	indexMapping.erase(Core::c_InvalidIndexU);
 
 	// Updating wrapped scene nodes.
-	auto wIt = m_WrappedSceneNodes.GetBeginIterator();
-	auto wEnd = m_WrappedSceneNodes.GetEndIterator();
-	for (; wIt != wEnd; ++wIt)
+	auto wrappedSceneNodes = m_WrappedSceneNodes.GetArray();
+	unsigned countWrappedSceneNodes = m_WrappedSceneNodes.GetSize();
+	for (unsigned i = 0; i < countWrappedSceneNodes; i++)
 	{
-		(*wIt)->_UpdateSceneNodeIndex(indexMapping);
+		wrappedSceneNodes[i]->_UpdateSceneNodeIndex(indexMapping);
 	}
 
 	return indexMapping;
@@ -1371,7 +1420,6 @@ std::map<unsigned, unsigned> SceneNodeHandler::CompactSceneNodes(bool isShrinkin
 WrappedSceneNode::WrappedSceneNode()
 	: m_Handler(nullptr)
 	, m_SceneNodeIndex(Core::c_InvalidIndexU)
-	, m_WrappedSceneNodeIndex(Core::c_InvalidIndexU)
 {
 }
 
@@ -1380,33 +1428,33 @@ WrappedSceneNode::WrappedSceneNode(SceneNodeHandler* handler, bool isStatic,
 	: m_Handler(handler)
 {
 	m_SceneNodeIndex = m_Handler->CreateSceneNode(isStatic, updateLevelHint);
-	m_WrappedSceneNodeIndex = m_Handler->_RegisterWrappedSceneNode(this);
+	m_WrappedSceneNodeHandle = m_Handler->_RegisterWrappedSceneNode(this);
 }
 
 WrappedSceneNode::WrappedSceneNode(SceneNodeHandler* handler, unsigned sceneNodeIndex)
 	: m_Handler(handler)
 	, m_SceneNodeIndex(sceneNodeIndex)
 {
-	m_WrappedSceneNodeIndex = m_Handler->_RegisterWrappedSceneNode(this);
+	m_WrappedSceneNodeHandle = m_Handler->_RegisterWrappedSceneNode(this);
 }
 
 WrappedSceneNode::WrappedSceneNode(WrappedSceneNode&& other)
 	: m_Handler(other.m_Handler)
 	, m_SceneNodeIndex(other.m_SceneNodeIndex)
-	, m_WrappedSceneNodeIndex(other.m_WrappedSceneNodeIndex)
+	, m_WrappedSceneNodeHandle(other.m_WrappedSceneNodeHandle)
 {
 	other.m_SceneNodeIndex = Core::c_InvalidIndexU;
-	other.m_WrappedSceneNodeIndex = Core::c_InvalidIndexU;
+	other.m_WrappedSceneNodeHandle = Core::Handle();
 	other.m_Handler = nullptr;
 
-	m_Handler->_UpdateWrappedSceneNode(m_WrappedSceneNodeIndex, this);
+	m_Handler->_UpdateWrappedSceneNode(m_WrappedSceneNodeHandle, this);
 }
 
 void WrappedSceneNode::DeleteSceneNode()
 {
 	if (IsValid())
 	{
-		m_Handler->_DeregisterWrappedSceneNode(m_WrappedSceneNodeIndex);
+		m_Handler->_DeregisterWrappedSceneNode(m_WrappedSceneNodeHandle);
 		m_Handler->DeleteSceneNode(m_SceneNodeIndex, true);
 	}
 }
@@ -1426,11 +1474,11 @@ WrappedSceneNode::~WrappedSceneNode()
 WrappedSceneNode& WrappedSceneNode::operator=(WrappedSceneNode&& other)
 {
 	std::swap(m_SceneNodeIndex, other.m_SceneNodeIndex);
-	std::swap(m_WrappedSceneNodeIndex, other.m_WrappedSceneNodeIndex);
+	std::swap(m_WrappedSceneNodeHandle, other.m_WrappedSceneNodeHandle);
 	std::swap(m_Handler, other.m_Handler);
 
-	m_Handler->_UpdateWrappedSceneNode(m_WrappedSceneNodeIndex, this);
-	m_Handler->_UpdateWrappedSceneNode(other.m_WrappedSceneNodeIndex, &other);
+	m_Handler->_UpdateWrappedSceneNode(m_WrappedSceneNodeHandle, this);
+	m_Handler->_UpdateWrappedSceneNode(other.m_WrappedSceneNodeHandle, &other);
 
 	return *this;
 }
@@ -1445,7 +1493,7 @@ void WrappedSceneNode::Set(SceneNodeHandler* handler, unsigned sceneNodeIndex)
 	DeleteSceneNode();
 	m_Handler = handler;
 	m_SceneNodeIndex = sceneNodeIndex;
-	m_WrappedSceneNodeIndex = handler->_RegisterWrappedSceneNode(this);
+	m_WrappedSceneNodeHandle = handler->_RegisterWrappedSceneNode(this);
 }
 
 SceneNodeHandler* WrappedSceneNode::GetSceneNodeHandler()
@@ -5,6 +5,8 @@
 
 #include <Core/DataStructures/SimpleTypeVector.hpp>
 #include <Core/DataStructures/SimpleTypeUnorderedVector.hpp>
+#include <Core/DataStructures/HandleVector.hpp>
+#include <Core/DataStructures/BitSet.h>
 #include <Core/System/ThreadPool.h>
 #include <EngineBuildingBlocks/Math/Transformations.h>
 
@@ -78,14 +80,16 @@ namespace EngineBuildingBlocks
 
 	private: // Special handling for wrapped scene nodes.
 
-		Core::SimpleTypeUnorderedVectorU<WrappedSceneNode*> m_WrappedSceneNodes;
+		// The registry hands out generational handles, thus a wrapped scene node that refers
+		// to a registration of a cleared handler is detected and ignored.
+		Core::HandleVector<WrappedSceneNode*> m_WrappedSceneNodes;
 
 	public:
 
-		unsigned _RegisterWrappedSceneNode(WrappedSceneNode* wrappedSceneNode);
-		void _DeregisterWrappedSceneNode(unsigned wrappedSceneNodeIndex);
+		Core::Handle _RegisterWrappedSceneNode(WrappedSceneNode* wrappedSceneNode);
+		void _DeregisterWrappedSceneNode(Core::Handle wrappedSceneNodeHandle);
 
-		void _UpdateWrappedSceneNode(unsigned wrappedSceneNodeIndex, WrappedSceneNode* newWrappedSceneNode);
+		void _UpdateWrappedSceneNode(Core::Handle wrappedSceneNodeHandle, WrappedSceneNode* newWrappedSceneNode);
 
 	public:
 
@@ -244,7 +248,11 @@ namespace EngineBuildingBlocks
 		// TODO: review this design. O(n^2) memory consumption!
 
 		void GatherDirtyIndices(unsigned char updateLevel);
-		void GatherDirtyIndices(unsigned char updateLevel, const Core::ByteVectorU& allowedMask);
+
+		// The allowed mask is either a Core::ByteVectorU or a Core::BitSet.
+		template <typename AllowedMaskType>
+		void GatherDirtyIndices(unsigned char updateLevel, const AllowedMaskType& allowedMask);
+
 		void UpdateAllowedMask(const Core::IndexVectorU& allowedIndices);
 		void UpdateTransformationsInParallel(unsigned char updateLevel);
 
@@ -258,6 +266,7 @@ namespace EngineBuildingBlocks
 
 		void UpdateTransformations();
 		void UpdateTransformations(const Core::ByteVectorU& allowedMask);
+		void UpdateTransformations(const Core::BitSet& allowedMask);
 		void UpdateTransformations(const Core::IndexVectorU& allowedIndices);
 
 #ifdef _DEBUG
@@ -279,7 +288,7 @@ namespace EngineBuildingBlocks
 	{
 		SceneNodeHandler* m_Handler;
 		unsigned m_SceneNodeIndex;
-		unsigned m_WrappedSceneNodeIndex;
+		Core::Handle m_WrappedSceneNodeHandle;
 
 		void DeleteSceneNode();
 
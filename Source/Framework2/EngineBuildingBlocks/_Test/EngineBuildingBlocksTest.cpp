@@ -4,10 +4,28 @@
 #include "stdafx.h"
 
 #include <EngineBuildingBlocks/_Test/SceneNodeTest.h>
+#include <EngineBuildingBlocks/_Test/MeshOptimizationTest.h>
+#include <EngineBuildingBlocks/_Test/VertexQuantizationTest.h>
+#include <EngineBuildingBlocks/_Test/IndexCompressionTest.h>
+#include <EngineBuildingBlocks/_Test/VertexInterleavingTest.h>
+#include <EngineBuildingBlocks/_Test/MeshletTest.h>
+#include <EngineBuildingBlocks/_Test/MeshSimplificationTest.h>
+#include <EngineBuildingBlocks/_Test/MeshBoundsTest.h>
+#include <EngineBuildingBlocks/_Test/ModelLoaderTest.h>
+#include <EngineBuildingBlocks/_Test/ResourceDataBaseTest.h>
 
 int main()
 {
 	EngineBuildingBlocksTest::SceneNodeTest::Test();
+	EngineBuildingBlocksTest::MeshOptimizationTest::Test();
+	EngineBuildingBlocksTest::VertexQuantizationTest::Test();
+	EngineBuildingBlocksTest::IndexCompressionTest::Test();
+	EngineBuildingBlocksTest::VertexInterleavingTest::Test();
+	EngineBuildingBlocksTest::MeshletTest::Test();
+	EngineBuildingBlocksTest::MeshSimplificationTest::Test();
+	EngineBuildingBlocksTest::MeshBoundsTest::Test();
+	EngineBuildingBlocksTest::ModelLoaderTest::Test();
+	EngineBuildingBlocksTest::ResourceDataBaseTest::Test();
 
     return 0;
 }
\ No newline at end of file
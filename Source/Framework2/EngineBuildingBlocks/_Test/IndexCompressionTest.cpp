@@ -0,0 +1,112 @@
+// EngineBuildingBlocks/_Test/IndexCompressionTest.cpp
+
+#include "stdafx.h"
+
+#include <EngineBuildingBlocks/_Test/IndexCompressionTest.h>
+
+#include <Core/Constants.h>
+#include <EngineBuildingBlocks/Graphics/Primitives/IndexCompression.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+using namespace EngineBuildingBlocks::Graphics;
+using namespace EngineBuildingBlocksTest;
+
+const unsigned c_GridSize = 200;
+const unsigned c_CountDecodingIterations = 20;
+
+// Creates the triangles of a grid row by row, where the vertices are in the order of their first use.
+Core::IndexVectorU CreateGridIndices(unsigned gridSize)
+{
+	Core::IndexVectorU indices;
+	for (unsigned y = 0; y < gridSize; y++)
+	{
+		for (unsigned x = 0; x < gridSize; x++)
+		{
+			unsigned i0 = y * (gridSize + 1) + x;
+			unsigned i1 = i0 + 1;
+			unsigned i2 = i0 + gridSize + 1;
+			unsigned i3 = i2 + 1;
+			unsigned triangles[] = { i0, i2, i1, i1, i2, i3 };
+			indices.PushBack(triangles, 6);
+		}
+	}
+	return indices;
+}
+
+// Relabels the vertices in the order of their first use.
+void ReorderVerticesByFirstUse(Core::IndexVectorU& indices)
+{
+	unsigned countVertices = GetMaximumIndex(indices.GetArray(), indices.GetSize()) + 1;
+	Core::IndexVectorU remap(countVertices, Core::c_InvalidIndexU);
+	unsigned nextVertex = 0;
+	for (unsigned i = 0; i < indices.GetSize(); i++)
+	{
+		if (remap[indices[i]] == Core::c_InvalidIndexU) remap[indices[i]] = nextVertex++;
+		indices[i] = remap[indices[i]];
+	}
+}
+
+bool TestEncoding(const char* name, const Core::IndexVectorU& indices, IndexEncoding encoding)
+{
+	unsigned countIndices = indices.GetSize();
+	Core::ByteVectorU bytes;
+	EncodeIndices(indices.GetArray(), countIndices, encoding, bytes);
+
+	Core::IndexVectorU decoded(countIndices);
+	auto start = std::chrono::high_resolution_clock::now();
+	for (unsigned i = 0; i < c_CountDecodingIterations; i++)
+	{
+		auto end = DecodeIndices(bytes.GetArray(), bytes.GetArray() + bytes.GetSize(), encoding,
+			decoded.GetArray(), countIndices);
+		if (end != bytes.GetArray() + bytes.GetSize()) return false;
+	}
+	auto elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+	bool isCorrect = (memcmp(decoded.GetArray(), indices.GetArray(), countIndices * sizeof(unsigned)) == 0);
+	double indicesPerSecond = countIndices * static_cast<double>(c_CountDecodingIterations) / elapsed;
+	printf("%s: %u indices, %.2f bytes per index, decoding: %.1f M indices/s, %s\n", name, countIndices,
+		bytes.GetSize() / static_cast<double>(countIndices), indicesPerSecond * 1e-6,
+		isCorrect ? "correct" : "INCORRECT");
+	return isCorrect;
+}
+
+void IndexCompressionTest::Test()
+{
+	bool isCorrect = true;
+
+	auto gridIndices = CreateGridIndices(c_GridSize);
+	ReorderVerticesByFirstUse(gridIndices);
+	isCorrect &= (GetSmallestIndexEncoding(gridIndices.GetArray(), gridIndices.GetSize()) == IndexEncoding::Uint16);
+	isCorrect &= TestEncoding("Grid, 32-bit", gridIndices, IndexEncoding::Uint32);
+	isCorrect &= TestEncoding("Grid, 16-bit", gridIndices, IndexEncoding::Uint16);
+	isCorrect &= TestEncoding("Grid, compressed", gridIndices, IndexEncoding::Compressed);
+
+	// The triangles in random order and indices, which don't fit to 16 bits.
+	std::mt19937 randomGenerator;
+	Core::IndexVectorU randomIndices(gridIndices.GetSize());
+	std::uniform_int_distribution<unsigned> distribution(0, 0xffffffffU);
+	for (unsigned i = 0; i < randomIndices.GetSize(); i++) randomIndices[i] = distribution(randomGenerator);
+	isCorrect &= (GetSmallestIndexEncoding(randomIndices.GetArray(), randomIndices.GetSize()) == IndexEncoding::Uint32);
+	isCorrect &= TestEncoding("Random, compressed", randomIndices, IndexEncoding::Compressed);
+
+	// Truncated data must be detected.
+	Core::ByteVectorU bytes;
+	EncodeIndices(gridIndices.GetArray(), gridIndices.GetSize(), IndexEncoding::Compressed, bytes);
+	Core::IndexVectorU decoded(gridIndices.GetSize());
+	try
+	{
+		DecodeIndices(bytes.GetArray(), bytes.GetArray() + bytes.GetSize() / 2, IndexEncoding::Compressed,
+			decoded.GetArray(), decoded.GetSize());
+		isCorrect = false;
+	}
+	catch (const std::exception&)
+	{
+	}
+
+	printf(isCorrect ? "Result is correct!\n" : "Result is incorrect!\n");
+}
@@ -0,0 +1,16 @@
+// EngineBuildingBlocks/_Test/IndexCompressionTest.h
+
+#ifndef _ENGINEBUILDINGBLOCKS__TEST_INDEXCOMPRESSIONTEST_H_INCLUDED_
+#define _ENGINEBUILDINGBLOCKS__TEST_INDEXCOMPRESSIONTEST_H_INCLUDED_
+
+namespace EngineBuildingBlocksTest
+{
+	class IndexCompressionTest
+	{
+	public:
+
+		static void Test();
+	};
+}
+
+#endif
@@ -0,0 +1,106 @@
+// EngineBuildingBlocks/_Test/MeshBoundsTest.cpp
+
+#include "stdafx.h"
+
+#include <EngineBuildingBlocks/_Test/MeshBoundsTest.h>
+
+#include <Core/System/ThreadPool.h>
+#include <EngineBuildingBlocks/Graphics/Primitives/MeshBounds.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+using namespace EngineBuildingBlocks;
+using namespace EngineBuildingBlocks::Graphics;
+using namespace EngineBuildingBlocks::Math;
+using namespace EngineBuildingBlocksTest;
+
+// The meshes include empty ones, ones with incomplete vector groups and ones with partial chunks.
+const unsigned c_BoundsTestMeshSizes[] = { 0, 1, 3, 4, 7, 100, 16385, 1000 * 1000 + 13 };
+
+bool IsBoundsEqual(const glm::vec3& x, const glm::vec3& y)
+{
+	return (glm::length(x - y) <= 1e-4f);
+}
+
+AABoundingBox ComputeReferenceBox(const glm::vec3* positions, unsigned countPositions,
+	const ScaledTransformation& transformation)
+{
+	auto box = c_InvalidAABB;
+	for (unsigned i = 0; i < countPositions; i++)
+	{
+		auto position = transformation.A * positions[i] + transformation.Position;
+		box.Minimum = glm::min(box.Minimum, position);
+		box.Maximum = glm::max(box.Maximum, position);
+	}
+	return box;
+}
+
+bool TestMeshBounds(const Core::SimpleTypeVectorU<glm::vec3>& positions,
+	const Core::SimpleTypeVectorU<MeshGeometryData>& meshes, const ScaledTransformation* transformations,
+	Core::ThreadPool* threadPool)
+{
+	unsigned countMeshes = meshes.GetSize();
+	Core::SimpleTypeVectorU<MeshBounds> meshBounds;
+	Core::SimpleTypeVectorU<AABoundingBox> objectBoxes;
+	Core::IndexVectorU objectMeshIndices(countMeshes);
+	for (unsigned i = 0; i < countMeshes; i++) objectMeshIndices[i] = i;
+
+	auto start = std::chrono::high_resolution_clock::now();
+	ComputeMeshBounds(positions.GetArray(), meshes.GetArray(), countMeshes, meshBounds, threadPool);
+	ComputeTransformedMeshBoxes(positions.GetArray(), meshes.GetArray(), objectMeshIndices.GetArray(),
+		transformations, countMeshes, objectBoxes, threadPool);
+	auto elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+	bool isCorrect = (meshBounds.GetSize() == countMeshes && objectBoxes.GetSize() == countMeshes);
+	for (unsigned i = 0; i < countMeshes && isCorrect; i++)
+	{
+		auto meshPositions = positions.GetArray() + meshes[i].BaseVertex;
+		unsigned countPositions = meshes[i].CountVertices;
+		auto box = AABoundingBox::GetBoundingBox(meshPositions, countPositions);
+		auto center = (countPositions > 0 ? box.GetCenter() : glm::vec3(0.0f));
+		float radius = 0.0f;
+		for (unsigned j = 0; j < countPositions; j++) radius = std::max(radius, glm::length(meshPositions[j] - center));
+		auto transformedBox = ComputeReferenceBox(meshPositions, countPositions, transformations[i]);
+
+		auto& bounds = meshBounds[i];
+		isCorrect &= (IsBoundsEqual(bounds.Box.Minimum, box.Minimum) && IsBoundsEqual(bounds.Box.Maximum, box.Maximum));
+		isCorrect &= (IsBoundsEqual(bounds.SphereCenter, center) && std::fabs(bounds.SphereRadius - radius) <= 1e-4f);
+		isCorrect &= (IsBoundsEqual(objectBoxes[i].Minimum, transformedBox.Minimum)
+			&& IsBoundsEqual(objectBoxes[i].Maximum, transformedBox.Maximum));
+	}
+
+	printf("Mesh bounds, %s: %.2f ms, %s\n", threadPool == nullptr ? "single-threaded" : "multi-threaded",
+		elapsed * 1e3, isCorrect ? "correct" : "INCORRECT");
+	return isCorrect;
+}
+
+void MeshBoundsTest::Test()
+{
+	std::mt19937 randomGenerator;
+	std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+	auto getRandomVector = [&]() {
+		return glm::vec3(distribution(randomGenerator), distribution(randomGenerator), distribution(randomGenerator));
+	};
+
+	Core::SimpleTypeVectorU<glm::vec3> positions;
+	Core::SimpleTypeVectorU<MeshGeometryData> meshes;
+	Core::SimpleTypeVectorU<ScaledTransformation> transformations;
+	for (unsigned countVertices : c_BoundsTestMeshSizes)
+	{
+		meshes.PushBack(MeshGeometryData{ countVertices, 0, positions.GetSize(), 0 });
+		glm::vec3 offset = getRandomVector();
+		for (unsigned i = 0; i < countVertices; i++) positions.PushBack(getRandomVector() * 0.5f + offset);
+		transformations.PushBack(ScaledTransformation(glm::mat3(getRandomVector(), getRandomVector(), getRandomVector()),
+			getRandomVector()));
+	}
+
+	bool isCorrect = true;
+	Core::ThreadPool threadPool;
+	isCorrect &= TestMeshBounds(positions, meshes, transformations.GetArray(), nullptr);
+	isCorrect &= TestMeshBounds(positions, meshes, transformations.GetArray(), &threadPool);
+
+	printf(isCorrect ? "Result is correct!\n" : "Result is incorrect!\n");
+}
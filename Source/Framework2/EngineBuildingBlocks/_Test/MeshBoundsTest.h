@@ -0,0 +1,16 @@
+// EngineBuildingBlocks/_Test/MeshBoundsTest.h
+
+#ifndef _ENGINEBUILDINGBLOCKS__TEST_MESHBOUNDSTEST_H_INCLUDED_
+#define _ENGINEBUILDINGBLOCKS__TEST_MESHBOUNDSTEST_H_INCLUDED_
+
+namespace EngineBuildingBlocksTest
+{
+	class MeshBoundsTest
+	{
+	public:
+
+		static void Test();
+	};
+}
+
+#endif
@@ -0,0 +1,197 @@
+// EngineBuildingBlocks/_Test/MeshOptimizationTest.cpp
+
+#include "stdafx.h"
+
+#include <EngineBuildingBlocks/_Test/MeshOptimizationTest.h>
+
+#include <Core/Constants.h>
+#include <EngineBuildingBlocks/Graphics/Primitives/MeshOptimization.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace EngineBuildingBlocks::Graphics;
+using namespace EngineBuildingBlocksTest;
+
+const unsigned c_OptimizationGridSize = 64;
+
+typedef std::vector<std::array<unsigned, 3>> TriangleList;
+
+// Creates the triangles of a grid in random order.
+void CreateShuffledGrid(unsigned gridSize, Core::SimpleTypeVectorU<glm::vec3>& positions, Core::IndexVectorU& indices)
+{
+	for (unsigned y = 0; y <= gridSize; y++)
+	{
+		for (unsigned x = 0; x <= gridSize; x++) positions.PushBack(glm::vec3(float(x), float(y), 0.0f));
+	}
+	TriangleList triangles;
+	for (unsigned y = 0; y < gridSize; y++)
+	{
+		for (unsigned x = 0; x < gridSize; x++)
+		{
+			unsigned i0 = y * (gridSize + 1) + x;
+			unsigned i1 = i0 + 1;
+			unsigned i2 = i0 + gridSize + 1;
+			unsigned i3 = i2 + 1;
+			triangles.push_back({ i0, i1, i2 });
+			triangles.push_back({ i1, i3, i2 });
+		}
+	}
+	std::shuffle(triangles.begin(), triangles.end(), std::mt19937());
+	for (auto& triangle : triangles) indices.PushBack(triangle.data(), 3);
+}
+
+// Returns the sorted triangles, which are rotated to start with their smallest index, thus their winding is kept.
+TriangleList GetTriangleSet(const unsigned* indices, unsigned countIndices)
+{
+	TriangleList triangles;
+	for (unsigned i = 0; i < countIndices; i += 3)
+	{
+		std::array<unsigned, 3> triangle = { indices[i], indices[i + 1], indices[i + 2] };
+		std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+		triangles.push_back(triangle);
+	}
+	std::sort(triangles.begin(), triangles.end());
+	return triangles;
+}
+
+bool TestTriangleReordering()
+{
+	Core::SimpleTypeVectorU<glm::vec3> positions;
+	Core::IndexVectorU indices;
+	CreateShuffledGrid(c_OptimizationGridSize, positions, indices);
+	unsigned countVertices = positions.GetSize();
+	auto triangleSet = GetTriangleSet(indices.GetArray(), indices.GetSize());
+
+	auto before = AnalyzeVertexCache(indices.GetArray(), indices.GetSize(), countVertices);
+	OptimizeVertexCache(indices.GetArray(), indices.GetSize(), countVertices);
+	auto after = AnalyzeVertexCache(indices.GetArray(), indices.GetSize(), countVertices);
+	bool isCorrect = (after.ACMR <= before.ACMR && GetTriangleSet(indices.GetArray(), indices.GetSize()) == triangleSet);
+
+	OptimizeOverdraw(indices.GetArray(), indices.GetSize(), positions.GetArray(), countVertices, 1.05f);
+	auto afterOverdraw = AnalyzeVertexCache(indices.GetArray(), indices.GetSize(), countVertices);
+	isCorrect &= (GetTriangleSet(indices.GetArray(), indices.GetSize()) == triangleSet);
+
+	printf("Vertex cache: ACMR: %.3f -> %.3f, after the overdraw optimization: %.3f, %s\n", before.ACMR, after.ACMR,
+		afterOverdraw.ACMR, isCorrect ? "correct" : "INCORRECT");
+	return isCorrect;
+}
+
+bool TestWelding()
+{
+	// Each quad of the grid has its own vertices, thus the neighbouring quads have bitwise equal vertices.
+	// Two vertices differ slightly: one in its position, and one in its vertex index element.
+	const unsigned gridSize = c_OptimizationGridSize;
+	Core::SimpleTypeVectorU<glm::vec3> positions;
+	Core::IndexVectorU vertexIndices;
+	IndexData indexData;
+	indexData.Topology = PrimitiveTopology::TriangleList;
+	for (unsigned y = 0; y < gridSize; y++)
+	{
+		for (unsigned x = 0; x < gridSize; x++)
+		{
+			unsigned baseVertex = positions.GetSize();
+			positions.PushBack(glm::vec3(float(x), float(y), 0.0f));
+			positions.PushBack(glm::vec3(float(x + 1), float(y), 0.0f));
+			positions.PushBack(glm::vec3(float(x), float(y + 1), 0.0f));
+			positions.PushBack(glm::vec3(float(x + 1), float(y + 1), 0.0f));
+			for (unsigned i = 0; i < 4; i++) vertexIndices.PushBack(0U);
+			unsigned quad[] = { baseVertex, baseVertex + 1, baseVertex + 2, baseVertex + 1, baseVertex + 3, baseVertex + 2 };
+			indexData.Data.PushBack(quad, 6);
+		}
+	}
+	unsigned countInputVertices = positions.GetSize();
+	positions[5].x = std::nextafter(positions[5].x, 3.0f);
+	vertexIndices[9] = 1;
+
+	Vertex_SOA_Data vertexData;
+	vertexData.AddPositionVertexElement(positions.GetArray(), countInputVertices);
+	vertexData.AddVertexIndexVertexElement(vertexIndices.GetArray(), countInputVertices);
+	auto inputIndices = indexData.Data;
+
+	MeshOptimizationOptionsType options;
+	options.IsWeldingVertices = true;
+	MeshGeometryData mesh = { countInputVertices, indexData.GetCountIndices(), 0, 0 };
+	OptimizeMeshes(vertexData, indexData, &mesh, 1, options);
+
+	// The grid vertices and the two modified vertices remain.
+	unsigned countExpectedVertices = (gridSize + 1) * (gridSize + 1) + 2;
+	bool isCorrect = (vertexData.GetCountVertices() == countExpectedVertices && mesh.CountVertices == countExpectedVertices);
+
+	// The triangles are not reordered, and they refer to bitwise equal vertices.
+	auto weldedPositions = vertexData.GetPositions();
+	auto weldedVertexIndices = vertexData.GetVertexElements<unsigned>(c_VertexIndexVertexElement.Name.c_str());
+	for (unsigned i = 0; i < inputIndices.GetSize() && isCorrect; i++)
+	{
+		unsigned inputIndex = inputIndices[i];
+		unsigned index = indexData.Data[i];
+		isCorrect &= (index < countExpectedVertices
+			&& memcmp(&weldedPositions[index], &positions[inputIndex], sizeof(glm::vec3)) == 0
+			&& weldedVertexIndices[index] == vertexIndices[inputIndex]);
+	}
+
+	printf("Welding: %u -> %u vertices, %s\n", countInputVertices, vertexData.GetCountVertices(),
+		isCorrect ? "correct" : "INCORRECT");
+	return isCorrect;
+}
+
+bool TestVertexFetchOptimization()
+{
+	Core::SimpleTypeVectorU<glm::vec3> positions;
+	IndexData indexData;
+	indexData.Topology = PrimitiveTopology::TriangleList;
+	CreateShuffledGrid(c_OptimizationGridSize, positions, indexData.Data);
+	unsigned countVertices = positions.GetSize();
+
+	Vertex_SOA_Data vertexData;
+	vertexData.AddPositionVertexElement(positions.GetArray(), countVertices);
+	auto inputIndices = indexData.Data;
+
+	MeshOptimizationOptionsType options;
+	options.IsOptimizingVertexFetch = true;
+	Core::IndexVectorU vertexRemap;
+	MeshGeometryData mesh = { countVertices, indexData.GetCountIndices(), 0, 0 };
+	OptimizeMeshes(vertexData, indexData, &mesh, 1, options, &vertexRemap);
+
+	// All vertices are used, thus the remap is a permutation, which moves the vertices with their references.
+	bool isCorrect = (vertexData.GetCountVertices() == countVertices && vertexRemap.GetSize() == countVertices);
+	std::vector<bool> isTarget(countVertices, false);
+	auto remappedPositions = vertexData.GetPositions();
+	for (unsigned i = 0; i < countVertices && isCorrect; i++)
+	{
+		unsigned target = vertexRemap[i];
+		isCorrect &= (target < countVertices && !isTarget[target]
+			&& memcmp(&remappedPositions[target], &positions[i], sizeof(glm::vec3)) == 0);
+		if (isCorrect) isTarget[target] = true;
+	}
+	for (unsigned i = 0; i < inputIndices.GetSize() && isCorrect; i++)
+	{
+		isCorrect &= (indexData.Data[i] == vertexRemap[inputIndices[i]]);
+	}
+
+	// The vertices are in the order of their first use.
+	unsigned nextVertex = 0;
+	for (unsigned i = 0; i < indexData.Data.GetSize() && isCorrect; i++)
+	{
+		isCorrect &= (indexData.Data[i] <= nextVertex);
+		if (indexData.Data[i] == nextVertex) nextVertex++;
+	}
+
+	printf("Vertex fetch optimization: %s\n", isCorrect ? "correct" : "INCORRECT");
+	return isCorrect;
+}
+
+void MeshOptimizationTest::Test()
+{
+	bool isCorrect = true;
+	isCorrect &= TestTriangleReordering();
+	isCorrect &= TestWelding();
+	isCorrect &= TestVertexFetchOptimization();
+
+	printf(isCorrect ? "Result is correct!\n" : "Result is incorrect!\n");
+}
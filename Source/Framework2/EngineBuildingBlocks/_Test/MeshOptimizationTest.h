@@ -0,0 +1,16 @@
+// EngineBuildingBlocks/_Test/MeshOptimizationTest.h
+
+#ifndef _ENGINEBUILDINGBLOCKS__TEST_MESHOPTIMIZATIONTEST_H_INCLUDED_
+#define _ENGINEBUILDINGBLOCKS__TEST_MESHOPTIMIZATIONTEST_H_INCLUDED_
+
+namespace EngineBuildingBlocksTest
+{
+	class MeshOptimizationTest
+	{
+	public:
+
+		static void Test();
+	};
+}
+
+#endif
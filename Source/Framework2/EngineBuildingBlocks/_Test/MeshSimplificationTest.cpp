@@ -0,0 +1,120 @@
+// EngineBuildingBlocks/_Test/MeshSimplificationTest.cpp
+
+#include "stdafx.h"
+
+#include <EngineBuildingBlocks/_Test/MeshSimplificationTest.h>
+
+#include <Core/Constants.h>
+#include <EngineBuildingBlocks/Graphics/Primitives/MeshSimplification.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+using namespace EngineBuildingBlocks::Graphics;
+using namespace EngineBuildingBlocksTest;
+
+const unsigned c_CountSphereRings = 100;
+const unsigned c_CountSphereSegments = 200;
+
+// Creates a UV sphere, where the first and the last column of the vertices have the same positions,
+// thus they form a seam.
+void CreateUVSphere(unsigned countRings, unsigned countSegments,
+	Core::SimpleTypeVectorU<glm::vec3>& positions, Core::IndexVectorU& indices)
+{
+	const float pi = glm::pi<float>();
+	for (unsigned y = 0; y <= countRings; y++)
+	{
+		float theta = pi * y / countRings;
+		float sinTheta = (y == 0 || y == countRings ? 0.0f : std::sin(theta));
+		float cosTheta = (y == 0 ? 1.0f : (y == countRings ? -1.0f : std::cos(theta)));
+		for (unsigned x = 0; x <= countSegments; x++)
+		{
+			float phi = 2.0f * pi * (x % countSegments) / countSegments;
+			positions.PushBack(glm::vec3(sinTheta * std::cos(phi), cosTheta, sinTheta * std::sin(phi)));
+		}
+	}
+	for (unsigned y = 0; y < countRings; y++)
+	{
+		for (unsigned x = 0; x < countSegments; x++)
+		{
+			unsigned i0 = y * (countSegments + 1) + x;
+			unsigned i1 = i0 + 1;
+			unsigned i2 = i0 + countSegments + 1;
+			unsigned i3 = i2 + 1;
+			if (y > 0)
+			{
+				unsigned triangle[] = { i0, i1, i2 };
+				indices.PushBack(triangle, 3);
+			}
+			if (y < countRings - 1)
+			{
+				unsigned triangle[] = { i1, i3, i2 };
+				indices.PushBack(triangle, 3);
+			}
+		}
+	}
+}
+
+void MeshSimplificationTest::Test()
+{
+	bool isCorrect = true;
+
+	Core::SimpleTypeVectorU<glm::vec3> positions;
+	Core::IndexVectorU indices;
+	CreateUVSphere(c_CountSphereRings, c_CountSphereSegments, positions, indices);
+	unsigned countVertices = positions.GetSize();
+
+	MeshSimplificationOptionsType options(true);
+	Core::IndexVectorU lodIndices;
+	Core::SimpleTypeVectorU<MeshLOD> lods;
+	auto start = std::chrono::high_resolution_clock::now();
+	GenerateMeshLODs(indices.GetArray(), indices.GetSize(), positions.GetArray(), countVertices,
+		nullptr, nullptr, options, lodIndices, lods);
+	auto elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+	printf("Sphere: %u triangles, %u levels generated in %.3f s\n", indices.GetSize() / 3, lods.GetSize(), elapsed);
+	isCorrect &= (lods.GetSize() > 0 && lods.GetSize() <= options.MaximumCountLODs);
+
+	unsigned previousCountIndices = indices.GetSize();
+	float previousError = 0.0f;
+	for (unsigned i = 0; i < lods.GetSize(); i++)
+	{
+		auto& lod = lods[i];
+		printf("Level %u: %u triangles, error: %f\n", i, lod.CountIndices / 3, lod.Error);
+
+		// The levels must be smaller and coarser than the previous ones, and within the error limit.
+		isCorrect &= (lod.CountIndices > 0 && lod.CountIndices < previousCountIndices && lod.CountIndices % 3 == 0);
+		isCorrect &= (lod.Error >= previousError && lod.Error <= options.MaximumRelativeError * 2.0f);
+		isCorrect &= (lod.BaseIndex + lod.CountIndices <= lodIndices.GetSize());
+		previousCountIndices = lod.CountIndices;
+		previousError = lod.Error;
+
+		// The triangles must be valid, and they must be on the same side of the seam as in the original mesh:
+		// a triangle never references both seam columns.
+		auto lodIndexArray = lodIndices.GetArray() + lod.BaseIndex;
+		for (unsigned j = 0; j < lod.CountIndices; j += 3)
+		{
+			auto triangle = lodIndexArray + j;
+			bool isOnFirstColumn = false, isOnLastColumn = false;
+			for (unsigned k = 0; k < 3; k++)
+			{
+				isCorrect &= (triangle[k] < countVertices);
+				unsigned column = triangle[k] % (c_CountSphereSegments + 1);
+				isOnFirstColumn |= (column == 0);
+				isOnLastColumn |= (column == c_CountSphereSegments);
+			}
+			isCorrect &= (triangle[0] != triangle[1] && triangle[1] != triangle[2] && triangle[0] != triangle[2]);
+			isCorrect &= !(isOnFirstColumn && isOnLastColumn);
+		}
+	}
+
+	// The original mesh is selected close to the camera, and the coarsest level far away.
+	const float projectionScaler = 1080.0f / (2.0f * std::tan(glm::radians(30.0f)));
+	isCorrect &= (SelectMeshLOD(lods.GetArray(), lods.GetSize(), 0.01f, 1.0f, projectionScaler, 1.0f)
+		== Core::c_InvalidIndexU);
+	isCorrect &= (SelectMeshLOD(lods.GetArray(), lods.GetSize(), 1e6f, 1.0f, projectionScaler, 1.0f)
+		== lods.GetSize() - 1);
+
+	printf(isCorrect ? "Result is correct!\n" : "Result is incorrect!\n");
+}
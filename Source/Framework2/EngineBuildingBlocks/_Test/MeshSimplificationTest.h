@@ -0,0 +1,16 @@
+// EngineBuildingBlocks/_Test/MeshSimplificationTest.h
+
+#ifndef _ENGINEBUILDINGBLOCKS__TEST_MESHSIMPLIFICATIONTEST_H_INCLUDED_
+#define _ENGINEBUILDINGBLOCKS__TEST_MESHSIMPLIFICATIONTEST_H_INCLUDED_
+
+namespace EngineBuildingBlocksTest
+{
+	class MeshSimplificationTest
+	{
+	public:
+
+		static void Test();
+	};
+}
+
+#endif
@@ -0,0 +1,284 @@
+// EngineBuildingBlocks/_Test/MeshletTest.cpp
+
+#include "stdafx.h"
+
+#include <EngineBuildingBlocks/_Test/MeshletTest.h>
+
+#include <Core/Constants.h>
+#include <Core/System/ThreadPool.h>
+#include <EngineBuildingBlocks/SceneNode.h>
+#include <EngineBuildingBlocks/Graphics/Camera/Camera.h>
+#include <EngineBuildingBlocks/Graphics/MeshletCuller.h>
+#include <EngineBuildingBlocks/Graphics/Primitives/Meshlet.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace EngineBuildingBlocks;
+using namespace EngineBuildingBlocks::Graphics;
+using namespace EngineBuildingBlocksTest;
+
+const unsigned c_MeshletGridSize = 32;
+
+// Creates the triangles of a grid in the [-1, 1] square of the z = 0 plane in random order. The triangles
+// are counter-clockwise from the +z direction, or from the -z direction if they are flipped.
+void CreateMeshletGrid(bool isFlipped, Core::SimpleTypeVectorU<glm::vec3>& positions, Core::IndexVectorU& indices)
+{
+	const unsigned gridSize = c_MeshletGridSize;
+	for (unsigned y = 0; y <= gridSize; y++)
+	{
+		for (unsigned x = 0; x <= gridSize; x++)
+		{
+			positions.PushBack(glm::vec3(2.0f * x / gridSize - 1.0f, 2.0f * y / gridSize - 1.0f, 0.0f));
+		}
+	}
+	std::vector<std::array<unsigned, 3>> triangles;
+	for (unsigned y = 0; y < gridSize; y++)
+	{
+		for (unsigned x = 0; x < gridSize; x++)
+		{
+			unsigned i0 = y * (gridSize + 1) + x;
+			unsigned i1 = i0 + 1;
+			unsigned i2 = i0 + gridSize + 1;
+			unsigned i3 = i2 + 1;
+			triangles.push_back({ i0, i1, i2 });
+			triangles.push_back({ i1, i3, i2 });
+		}
+	}
+	std::shuffle(triangles.begin(), triangles.end(), std::mt19937());
+	for (auto& triangle : triangles)
+	{
+		if (isFlipped) std::swap(triangle[1], triangle[2]);
+		indices.PushBack(triangle.data(), 3);
+	}
+}
+
+// Creates a closed UV sphere with outward facing counter-clockwise triangles.
+void CreateMeshletSphere(Core::SimpleTypeVectorU<glm::vec3>& positions, Core::IndexVectorU& indices)
+{
+	const unsigned countRings = 24, countSegments = 48;
+	const float pi = 3.14159265f;
+	positions.PushBack(glm::vec3(0.0f, 0.0f, 1.0f));
+	for (unsigned i = 1; i < countRings; i++)
+	{
+		float theta = pi * i / countRings;
+		for (unsigned j = 0; j < countSegments; j++)
+		{
+			float phi = 2.0f * pi * j / countSegments;
+			positions.PushBack(glm::vec3(std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta)));
+		}
+	}
+	positions.PushBack(glm::vec3(0.0f, 0.0f, -1.0f));
+	unsigned bottom = positions.GetSize() - 1;
+	auto getVertex = [](unsigned ring, unsigned segment) { return 1 + (ring - 1) * countSegments + segment % countSegments; };
+	for (unsigned j = 0; j < countSegments; j++)
+	{
+		unsigned top[] = { 0, getVertex(1, j), getVertex(1, j + 1) };
+		indices.PushBack(top, 3);
+		for (unsigned i = 1; i + 1 < countRings; i++)
+		{
+			unsigned quad[] = { getVertex(i, j), getVertex(i + 1, j), getVertex(i + 1, j + 1),
+				getVertex(i, j), getVertex(i + 1, j + 1), getVertex(i, j + 1) };
+			indices.PushBack(quad, 6);
+		}
+		unsigned bottomTriangle[] = { bottom, getVertex(countRings - 1, j + 1), getVertex(countRings - 1, j) };
+		indices.PushBack(bottomTriangle, 3);
+	}
+}
+
+std::vector<std::array<unsigned, 3>> GetSortedMeshletTriangles(const unsigned* indices, unsigned countIndices)
+{
+	std::vector<std::array<unsigned, 3>> triangles;
+	for (unsigned i = 0; i < countIndices; i += 3) triangles.push_back({ indices[i], indices[i + 1], indices[i + 2] });
+	std::sort(triangles.begin(), triangles.end());
+	return triangles;
+}
+
+bool TestMeshletBuilding(const char* name, const Core::SimpleTypeVectorU<glm::vec3>& positions,
+	const Core::IndexVectorU& inputIndices, unsigned maximumCountVertices, unsigned maximumCountTriangles)
+{
+	MeshletBuildOptionsType options(true);
+	options.MaximumCountVertices = maximumCountVertices;
+	options.MaximumCountTriangles = maximumCountTriangles;
+	auto indices = inputIndices;
+	Core::SimpleTypeVectorU<Meshlet> meshlets;
+	BuildMeshlets(indices.GetArray(), indices.GetSize(), positions.GetArray(), positions.GetSize(), options, meshlets);
+
+	// The meshlets cover the index range without gaps and overlaps, and the triangles are only reordered,
+	// thus each input triangle is in exactly one meshlet.
+	bool isCorrect = (meshlets.GetSize() > 0
+		&& GetSortedMeshletTriangles(indices.GetArray(), indices.GetSize())
+		== GetSortedMeshletTriangles(inputIndices.GetArray(), inputIndices.GetSize()));
+	unsigned nextBaseIndex = 0;
+	Core::IndexVectorU vertexMarks(positions.GetSize(), Core::c_InvalidIndexU);
+	for (unsigned i = 0; i < meshlets.GetSize() && isCorrect; i++)
+	{
+		auto& meshlet = meshlets[i];
+		isCorrect &= (meshlet.BaseIndex == nextBaseIndex && meshlet.CountIndices > 0 && meshlet.CountIndices % 3 == 0
+			&& meshlet.CountIndices / 3 <= maximumCountTriangles);
+		nextBaseIndex += meshlet.CountIndices;
+		if (!isCorrect) break;
+
+		// The vertex count is the count of the distinct vertices, and the bounding sphere contains them.
+		unsigned countVertices = 0;
+		for (unsigned j = meshlet.BaseIndex; j < meshlet.BaseIndex + meshlet.CountIndices; j++)
+		{
+			unsigned vertex = indices[j];
+			if (vertexMarks[vertex] != i)
+			{
+				vertexMarks[vertex] = i;
+				countVertices++;
+			}
+			float distance = glm::length(positions[vertex] - meshlet.Center);
+			isCorrect &= (distance <= meshlet.Radius * (1.0f + 1e-5f) + 1e-6f);
+		}
+		isCorrect &= (countVertices == meshlet.CountVertices && countVertices <= maximumCountVertices);
+	}
+	isCorrect &= (nextBaseIndex == indices.GetSize());
+
+	printf("%s, %u vertices, %u triangles: %u meshlets, %s\n", name, maximumCountVertices, maximumCountTriangles,
+		meshlets.GetSize(), isCorrect ? "correct" : "INCORRECT");
+	return isCorrect;
+}
+
+bool TestMeshletBuilding()
+{
+	Core::SimpleTypeVectorU<glm::vec3> gridPositions, spherePositions;
+	Core::IndexVectorU gridIndices, sphereIndices;
+	CreateMeshletGrid(false, gridPositions, gridIndices);
+	CreateMeshletSphere(spherePositions, sphereIndices);
+
+	bool isCorrect = true;
+	for (auto limits : { std::array<unsigned, 2>{ 64, 124 }, std::array<unsigned, 2>{ 32, 16 },
+		std::array<unsigned, 2>{ 16, 64 }, std::array<unsigned, 2>{ 3, 1 } })
+	{
+		isCorrect &= TestMeshletBuilding("Grid", gridPositions, gridIndices, limits[0], limits[1]);
+		isCorrect &= TestMeshletBuilding("Sphere", spherePositions, sphereIndices, limits[0], limits[1]);
+	}
+	return isCorrect;
+}
+
+bool TestMeshletCones()
+{
+	MeshletBuildOptionsType options(true);
+	Core::SimpleTypeVectorU<glm::vec3> positions;
+	Core::IndexVectorU indices;
+	Core::SimpleTypeVectorU<Meshlet> meshlets;
+
+	// The clusters of the grid face the +z direction, and the flipped clusters face the -z direction.
+	bool isCorrect = true;
+	for (bool isFlipped : { false, true })
+	{
+		positions.Clear();
+		indices.Clear();
+		meshlets.Clear();
+		CreateMeshletGrid(isFlipped, positions, indices);
+		BuildMeshlets(indices.GetArray(), indices.GetSize(), positions.GetArray(), positions.GetSize(), options, meshlets);
+		glm::vec3 frontPosition(0.0f, 0.0f, isFlipped ? -3.0f : 3.0f);
+		for (unsigned i = 0; i < meshlets.GetSize(); i++)
+		{
+			isCorrect &= (!IsMeshletBackfacing(meshlets[i], frontPosition) && IsMeshletBackfacing(meshlets[i], -frontPosition));
+		}
+	}
+
+	// The culling is conservative: all triangles of a backfacing cluster are backfacing.
+	positions.Clear();
+	indices.Clear();
+	meshlets.Clear();
+	CreateMeshletSphere(positions, indices);
+	BuildMeshlets(indices.GetArray(), indices.GetSize(), positions.GetArray(), positions.GetSize(), options, meshlets);
+	std::mt19937 generator;
+	std::uniform_real_distribution<float> distribution(-4.0f, 4.0f);
+	unsigned countBackfacing = 0;
+	for (unsigned i = 0; i < 64; i++)
+	{
+		glm::vec3 viewPosition(distribution(generator), distribution(generator), distribution(generator));
+		for (unsigned j = 0; j < meshlets.GetSize(); j++)
+		{
+			auto& meshlet = meshlets[j];
+			if (!IsMeshletBackfacing(meshlet, viewPosition)) continue;
+			countBackfacing++;
+			for (unsigned k = meshlet.BaseIndex; k < meshlet.BaseIndex + meshlet.CountIndices; k += 3)
+			{
+				auto& p0 = positions[indices[k]];
+				auto normal = glm::cross(positions[indices[k + 1]] - p0, positions[indices[k + 2]] - p0);
+				isCorrect &= (glm::dot(normal, p0 - viewPosition) >= 0.0f);
+			}
+		}
+	}
+	isCorrect &= (countBackfacing > 0);
+
+	printf("Meshlet cones: %u backfacing sphere meshlets, %s\n", countBackfacing, isCorrect ? "correct" : "INCORRECT");
+	return isCorrect;
+}
+
+bool TestMeshletCulling()
+{
+	MeshletBuildOptionsType options(true);
+	Core::SimpleTypeVectorU<glm::vec3> frontPositions, backPositions;
+	Core::IndexVectorU frontIndices, backIndices;
+	Core::SimpleTypeVectorU<Meshlet> frontMeshlets, backMeshlets;
+	CreateMeshletGrid(false, frontPositions, frontIndices);
+	CreateMeshletGrid(true, backPositions, backIndices);
+	BuildMeshlets(frontIndices.GetArray(), frontIndices.GetSize(), frontPositions.GetArray(), frontPositions.GetSize(),
+		options, frontMeshlets);
+	BuildMeshlets(backIndices.GetArray(), backIndices.GetSize(), backPositions.GetArray(), backPositions.GetSize(),
+		options, backMeshlets);
+
+	// The camera looks at the grids in the origin from the +z direction. The third object is out of the frustum.
+	SceneNodeHandler sceneNodeHandler;
+	Camera camera(&sceneNodeHandler);
+	camera.SetPosition({ 0.0f, 0.0f, 3.0f });
+	camera.LookAt({ 0.0f, 0.0f, 0.0f });
+	unsigned frontNode = sceneNodeHandler.CreateSceneNode(false);
+	unsigned backNode = sceneNodeHandler.CreateSceneNode(false);
+	unsigned outsideNode = sceneNodeHandler.CreateSceneNode(false);
+	sceneNodeHandler.SetLocalPosition(outsideNode, { 100.0f, 0.0f, 0.0f });
+	sceneNodeHandler.UpdateTransformations();
+
+	MeshletCullingObject objects[] =
+	{
+		{ frontNode, frontMeshlets.GetArray(), frontMeshlets.GetSize() },
+		{ backNode, backMeshlets.GetArray(), backMeshlets.GetSize() },
+		{ outsideNode, frontMeshlets.GetArray(), frontMeshlets.GetSize() }
+	};
+
+	// The visible meshlets are in the order of the objects.
+	auto isExpected = [&](const Core::SimpleTypeVectorU<VisibleMeshlet>& visibleMeshlets, bool isBackVisible) {
+		unsigned countExpected = frontMeshlets.GetSize() + (isBackVisible ? backMeshlets.GetSize() : 0);
+		if (visibleMeshlets.GetSize() != countExpected) return false;
+		for (unsigned i = 0; i < countExpected; i++)
+		{
+			bool isFront = (i < frontMeshlets.GetSize());
+			unsigned objectIndex = (isFront ? 0 : 1);
+			unsigned meshletIndex = (isFront ? i : i - frontMeshlets.GetSize());
+			if (visibleMeshlets[i].ObjectIndex != objectIndex || visibleMeshlets[i].MeshletIndex != meshletIndex) return false;
+		}
+		return true;
+	};
+
+	Core::ThreadPool threadPool;
+	MeshletCuller meshletCuller;
+	Core::SimpleTypeVectorU<VisibleMeshlet> visibleMeshlets;
+	meshletCuller.Cull(camera, threadPool, sceneNodeHandler, objects, 3, visibleMeshlets, true);
+	bool isCorrect = isExpected(visibleMeshlets, false);
+	meshletCuller.Cull(camera, threadPool, sceneNodeHandler, objects, 3, visibleMeshlets, false);
+	isCorrect &= isExpected(visibleMeshlets, true);
+
+	printf("Meshlet culling: %u visible meshlets, %s\n", visibleMeshlets.GetSize(), isCorrect ? "correct" : "INCORRECT");
+	return isCorrect;
+}
+
+void MeshletTest::Test()
+{
+	bool isCorrect = true;
+	isCorrect &= TestMeshletBuilding();
+	isCorrect &= TestMeshletCones();
+	isCorrect &= TestMeshletCulling();
+
+	printf(isCorrect ? "Result is correct!\n" : "Result is incorrect!\n");
+}
@@ -0,0 +1,16 @@
+// EngineBuildingBlocks/_Test/MeshletTest.h
+
+#ifndef _ENGINEBUILDINGBLOCKS__TEST_MESHLETTEST_H_INCLUDED_
+#define _ENGINEBUILDINGBLOCKS__TEST_MESHLETTEST_H_INCLUDED_
+
+namespace EngineBuildingBlocksTest
+{
+	class MeshletTest
+	{
+	public:
+
+		static void Test();
+	};
+}
+
+#endif
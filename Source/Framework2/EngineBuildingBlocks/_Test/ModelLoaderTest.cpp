@@ -0,0 +1,559 @@
+// EngineBuildingBlocks/_Test/ModelLoaderTest.cpp
+
+#include "stdafx.h"
+
+#include <EngineBuildingBlocks/_Test/ModelLoaderTest.h>
+
+#include <Core/Constants.h>
+#include <Core/System/SimpleIO.h>
+#include <Core/System/ThreadPool.h>
+#include <EngineBuildingBlocks/PathHandler.h>
+#include <EngineBuildingBlocks/ResourceDatabase.h>
+#include <EngineBuildingBlocks/Graphics/Primitives/ModelLoader.h>
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+
+using namespace EngineBuildingBlocks;
+using namespace EngineBuildingBlocks::Graphics;
+using namespace EngineBuildingBlocksTest;
+
+const unsigned c_ModelGridSizes[] = { 8, 16, 4, 32 };
+const unsigned c_ModelCountMeshes[] = { 2, 3, 1, 2 };
+
+// Writes an OBJ file with a group of a quad grid for each mesh.
+void CreateGridModelFile(const std::string& path, unsigned gridSize, unsigned countMeshes)
+{
+	std::stringstream ss;
+	unsigned countMeshVertices = (gridSize + 1) * (gridSize + 1);
+	for (unsigned meshIndex = 0; meshIndex < countMeshes; meshIndex++)
+	{
+		ss << "g Mesh_" << meshIndex << "\n";
+		for (unsigned y = 0; y <= gridSize; y++)
+		{
+			for (unsigned x = 0; x <= gridSize; x++) ss << "v " << x << " " << y << " " << meshIndex << "\n";
+		}
+
+		// The vertex indices of OBJ files start with 1.
+		unsigned baseVertex = meshIndex * countMeshVertices + 1;
+		for (unsigned y = 0; y < gridSize; y++)
+		{
+			for (unsigned x = 0; x < gridSize; x++)
+			{
+				unsigned i = baseVertex + y * (gridSize + 1) + x;
+				ss << "f " << i << " " << i + 1 << " " << i + gridSize + 2 << " " << i + gridSize + 1 << "\n";
+			}
+		}
+	}
+	Core::WriteAllText(path, ss.str());
+}
+
+ModelLoadingDescription CreateGridModelDescription(const std::string& path)
+{
+	ModelLoadingDescription description;
+	description.BuildingDescription.FilePath = path;
+
+	// Keeping the groups as separate meshes.
+	description.BuildingDescription.GeometryOptions.IsOptimizingMeshes = false;
+	description.BuildingDescription.GeometryOptions.IsOptimizingGraph = false;
+	return description;
+}
+
+bool IsLoadedGeometryEqual(const Vertex_SOA_Data& vertexData1, const IndexData& indexData1,
+	const Vertex_SOA_Data& vertexData2, const IndexData& indexData2)
+{
+	if (vertexData1.Data.size() != vertexData2.Data.size() || indexData1 != indexData2) return false;
+	for (size_t i = 0; i < vertexData1.Data.size(); i++)
+	{
+		auto& data1 = vertexData1.Data[i];
+		auto& data2 = vertexData2.Data[i];
+		if (data1.GetSize() != data2.GetSize() || memcmp(data1.GetArray(), data2.GetArray(), data1.GetSize()) != 0)
+			return false;
+	}
+	return true;
+}
+
+bool IsLoadedMeshesEqual(const ModelLoadingResult& result1, const ModelLoadingResult& result2)
+{
+	auto& meshes1 = result1.Meshes;
+	auto& meshes2 = result2.Meshes;
+	return (meshes1.GetSize() == meshes2.GetSize()
+		&& memcmp(meshes1.GetArray(), meshes2.GetArray(), meshes1.GetSize() * sizeof(MeshGeometryData)) == 0);
+}
+
+// The levels are built in increasing order, the longest builds of a level first.
+bool TestBuildOrder()
+{
+	BuiltResourceDescription descriptions[] =
+	{
+		{ "", false, 1, 2.0 },
+		{ "", false, 0, 0.5 },
+		{ "", false, 2, 1.0 },
+		{ "", false, 0, 3.0 },
+		{ "", false, 1, 2.0 },
+		{ "", false, 0, 0.0 },
+		{ "", false, 1, 5.0 }
+	};
+	unsigned allIndices[] = { 0, 1, 2, 3, 4, 5, 6 };
+	const unsigned expectedAllIndices[] = { 3, 1, 5, 6, 0, 4, 2 };
+	SortByBuildOrder(descriptions, allIndices, 7);
+
+	// The resources with equal levels and durations keep their order.
+	unsigned someIndices[] = { 4, 2, 0 };
+	const unsigned expectedSomeIndices[] = { 4, 0, 2 };
+	SortByBuildOrder(descriptions, someIndices, 3);
+
+	bool isCorrect = (memcmp(allIndices, expectedAllIndices, sizeof(allIndices)) == 0
+		&& memcmp(someIndices, expectedSomeIndices, sizeof(someIndices)) == 0);
+	printf("Build order: %s\n", isCorrect ? "correct" : "INCORRECT");
+	return isCorrect;
+}
+
+// The batches must return the same results as loading the models one by one, including a duplicate request
+// and a partial request of a model.
+bool TestLoadBatchResults(PathHandler& pathHandler, ResourceDatabase& resourceDatabase, Core::ThreadPool& threadPool,
+	const std::vector<std::string>& modelPaths)
+{
+	unsigned countModels = static_cast<unsigned>(modelPaths.size());
+	std::vector<ModelLoadingDescription> descriptions;
+	for (auto& path : modelPaths) descriptions.push_back(CreateGridModelDescription(path));
+	descriptions.push_back(descriptions[0]);
+	auto partialDescription = descriptions[1];
+	auto& partialOptions = partialDescription.PartialModelLoadingOptions;
+	partialOptions.IsPartialModelLoadingAllowed = true;
+	partialOptions.AllowedMeshIndices.PushBack(0);
+	partialOptions.AllowedMeshIndices.PushBack(2);
+	partialOptions.AllowedFaces[2] = { 3, 40, 2 };
+	descriptions.push_back(partialDescription);
+	unsigned countDescriptions = static_cast<unsigned>(descriptions.size());
+
+	// The models are built by the first batch and deserialized by the second one. The reference is loaded
+	// model by model without a thread pool.
+	ModelLoader buildingLoader(&pathHandler, &resourceDatabase);
+	ModelLoader loadingLoader(&pathHandler, &resourceDatabase);
+	ModelLoader referenceLoader(&pathHandler, &resourceDatabase);
+	buildingLoader.SetThreadPool(&threadPool);
+	loadingLoader.SetThreadPool(&threadPool);
+
+	Vertex_SOA_Data builtVertexData, loadedVertexData, referenceVertexData;
+	IndexData builtIndexData, loadedIndexData, referenceIndexData;
+	auto builtResults = buildingLoader.LoadBatch(descriptions, builtVertexData, builtIndexData);
+	auto loadedResults = loadingLoader.LoadBatch(descriptions, loadedVertexData, loadedIndexData);
+	std::vector<ModelLoadingResult> referenceResults;
+	for (auto& description : descriptions)
+	{
+		referenceResults.push_back(referenceLoader.Load(description, referenceVertexData, referenceIndexData));
+	}
+
+	// The geometry is copied in parallel to the same place as by the successive loads.
+	bool isCorrect = (builtResults.size() == countDescriptions && loadedResults.size() == countDescriptions);
+	isCorrect &= IsLoadedGeometryEqual(builtVertexData, builtIndexData, referenceVertexData, referenceIndexData);
+	isCorrect &= IsLoadedGeometryEqual(loadedVertexData, loadedIndexData, referenceVertexData, referenceIndexData);
+	for (unsigned i = 0; i < countDescriptions && isCorrect; i++)
+	{
+		isCorrect &= (IsLoadedMeshesEqual(builtResults[i], referenceResults[i])
+			&& IsLoadedMeshesEqual(loadedResults[i], referenceResults[i]));
+	}
+	if (isCorrect)
+	{
+		// The identical building descriptions are loaded to the same model, but their geometry is appended
+		// for each request.
+		for (auto results : { &builtResults, &loadedResults, &referenceResults })
+		{
+			auto& r = *results;
+			isCorrect &= (r[countModels].ModelIndex == r[0].ModelIndex && r[countModels + 1].ModelIndex == r[1].ModelIndex);
+			for (unsigned i = 1; i < countModels; i++) isCorrect &= (r[i].ModelIndex != r[0].ModelIndex);
+		}
+		unsigned countVertices = 0, countIndices = 0;
+		for (auto& result : builtResults)
+		{
+			for (unsigned i = 0; i < result.Meshes.GetSize(); i++)
+			{
+				countVertices += result.Meshes[i].CountVertices;
+				countIndices += result.Meshes[i].CountIndices;
+			}
+		}
+		isCorrect &= (builtVertexData.GetCountVertices() == countVertices && builtIndexData.GetCountIndices() == countIndices);
+
+		// Only the selected meshes and faces of the partial request are appended.
+		auto& partialMeshes = builtResults[countModels + 1].Meshes;
+		isCorrect &= (partialMeshes.GetSize() == c_ModelCountMeshes[1] && partialMeshes[0].CountIndices > 0
+			&& partialMeshes[1].CountIndices == 0 && partialMeshes[2].CountIndices == 19 * 3);
+	}
+
+	printf("Batch loading results: %s\n", isCorrect ? "correct" : "INCORRECT");
+	return isCorrect;
+}
+
+// If a model of a batch can't be built, the models, which were built or loaded by the batch, are removed
+// and the output buffers are not modified.
+bool TestLoadBatchRollback(PathHandler& pathHandler, ResourceDatabase& resourceDatabase, Core::ThreadPool& threadPool,
+	const std::vector<std::string>& modelPaths, const std::string& missingModelPath)
+{
+	ModelLoader loader(&pathHandler, &resourceDatabase);
+	loader.SetThreadPool(&threadPool);
+
+	Vertex_SOA_Data vertexData;
+	IndexData indexData;
+	auto firstResult = loader.Load(CreateGridModelDescription(modelPaths[0]), vertexData, indexData);
+	unsigned countVertices = vertexData.GetCountVertices();
+	unsigned countIndices = indexData.GetCountIndices();
+
+	std::vector<ModelLoadingDescription> descriptions;
+	for (size_t i = 1; i < modelPaths.size(); i++) descriptions.push_back(CreateGridModelDescription(modelPaths[i]));
+	descriptions.insert(descriptions.begin() + 1, CreateGridModelDescription(missingModelPath));
+	unsigned countFailedDescriptions = static_cast<unsigned>(descriptions.size());
+	bool isThrown = false;
+	try
+	{
+		loader.LoadBatch(descriptions, vertexData, indexData);
+	}
+	catch (const std::runtime_error&)
+	{
+		isThrown = true;
+	}
+
+	bool isCorrect = (isThrown && vertexData.GetCountVertices() == countVertices
+		&& indexData.GetCountIndices() == countIndices
+		&& loader.GetModel(firstResult.ModelIndex).Meshes.GetSize() == c_ModelCountMeshes[0]);
+
+	// The removed models are not cached, and their slots are reused: the first model and the slots of the failed
+	// batch are the only ones.
+	descriptions.erase(descriptions.begin() + 1);
+	auto results = loader.LoadBatch(descriptions, vertexData, indexData);
+	for (unsigned i = 0; i < static_cast<unsigned>(results.size()); i++)
+	{
+		isCorrect &= (results[i].ModelIndex != firstResult.ModelIndex && results[i].ModelIndex <= countFailedDescriptions
+			&& results[i].Meshes.GetSize() == c_ModelCountMeshes[i + 1]);
+	}
+
+	printf("Batch loading rollback: %s\n", isCorrect ? "correct" : "INCORRECT");
+	return isCorrect;
+}
+
+// The meshes of the selection model are triangle strips: face f of a mesh consists of the vertices f, f + 1 and f + 2.
+// The last two vertices of the second mesh are not referenced. The x coordinate of a position is the vertex index
+// of the model.
+const unsigned c_SelectionMeshCountVertices[] = { 6, 12, 5 };
+const unsigned c_SelectionMeshCountFaces[] = { 4, 8, 3 };
+const unsigned c_SelectionCountMeshes = 3;
+
+void CreateSelectionModel(BuiltModel& builtModel)
+{
+	builtModel.SceneNodes.PushBack({ Core::c_InvalidIndexU, ScaledTransformation(glm::mat3(1.0f), glm::vec3(0.0f)), 0 });
+	builtModel.SceneNodeNames.push_back("Root");
+	builtModel.Materials.resize(1);
+
+	Core::SimpleTypeVectorU<glm::vec3> positions, normals;
+	Core::SimpleTypeVectorU<glm::vec2> textureCoordinates;
+	auto& indices = builtModel.Indices;
+	indices.Topology = PrimitiveTopology::TriangleList;
+	for (unsigned meshIndex = 0; meshIndex < c_SelectionCountMeshes; meshIndex++)
+	{
+		unsigned countVertices = c_SelectionMeshCountVertices[meshIndex];
+		unsigned countFaces = c_SelectionMeshCountFaces[meshIndex];
+		builtModel.Meshes.PushBack({ countVertices, countFaces * 3, positions.GetSize(), indices.Data.GetSize() });
+		builtModel.Objects.PushBack({ 0, meshIndex, 0 });
+		for (unsigned i = 0; i < countVertices; i++)
+		{
+			positions.PushBack(glm::vec3(static_cast<float>(positions.GetSize()), static_cast<float>(meshIndex), 0.0f));
+			normals.PushBack(glm::vec3(0.0f, 0.0f, 1.0f));
+			textureCoordinates.PushBack(glm::vec2(0.0f));
+		}
+		for (unsigned face = 0; face < countFaces; face++)
+		{
+			for (unsigned i = 0; i < 3; i++) indices.Data.PushBack(face + i);
+		}
+	}
+	unsigned countVertices = positions.GetSize();
+	builtModel.Vertices.AddPositionVertexElement(positions.GetArray(), countVertices);
+	builtModel.Vertices.AddNormalVertexElement(normals.GetArray(), countVertices);
+	builtModel.Vertices.AddTextureCoordinateVertexElement(textureCoordinates.GetArray(), countVertices);
+}
+
+// Returns the model's vertex index for each selected index of a mesh. The face interval is iterated
+// with 64 bit arithmetic, thus it can't overflow.
+void GetSelectedFaceVertices(const PartialModelLoadingOptionsType& options, unsigned meshIndex,
+	Core::IndexVectorU& faceVertices)
+{
+	auto& allowedMeshIndices = options.AllowedMeshIndices;
+	if (!allowedMeshIndices.IsEmpty() && std::find(allowedMeshIndices.GetArray(), allowedMeshIndices.GetEndPointer(),
+		meshIndex) == allowedMeshIndices.GetEndPointer()) return;
+
+	unsigned baseVertex = 0;
+	for (unsigned i = 0; i < meshIndex; i++) baseVertex += c_SelectionMeshCountVertices[i];
+	std::uint64_t countFaces = c_SelectionMeshCountFaces[meshIndex];
+	std::uint64_t first = 0, last = countFaces - 1, step = 1;
+	auto fIt = options.AllowedFaces.find(meshIndex);
+	if (fIt != options.AllowedFaces.end())
+	{
+		first = fIt->second.First;
+		last = std::min<std::uint64_t>(fIt->second.Last, countFaces - 1);
+		step = std::max(fIt->second.Step, 1U);
+	}
+	for (std::uint64_t face = first; face <= last; face += step)
+	{
+		for (unsigned i = 0; i < 3; i++) faceVertices.PushBack(baseVertex + static_cast<unsigned>(face) + i);
+	}
+}
+
+struct GeometrySelectionTestCase
+{
+	const char* Name;
+	PartialModelLoadingOptionsType Options;
+
+	// The count of the vertices and the indices of each mesh.
+	std::array<unsigned, 2 * c_SelectionCountMeshes> ExpectedCounts;
+};
+
+std::vector<GeometrySelectionTestCase> CreateGeometrySelectionTestCases()
+{
+	std::vector<GeometrySelectionTestCase> testCases;
+	auto addTestCase = [&testCases](const char* name, std::initializer_list<unsigned> allowedMeshIndices,
+		std::map<unsigned, Core::IntervalData<unsigned>> allowedFaces,
+		const std::array<unsigned, 2 * c_SelectionCountMeshes>& expectedCounts) {
+		GeometrySelectionTestCase testCase;
+		testCase.Name = name;
+		testCase.Options.IsPartialModelLoadingAllowed = true;
+		for (auto meshIndex : allowedMeshIndices) testCase.Options.AllowedMeshIndices.PushBack(meshIndex);
+		testCase.Options.AllowedFaces = std::move(allowedFaces);
+		testCase.ExpectedCounts = expectedCounts;
+		testCases.push_back(std::move(testCase));
+	};
+
+	// Whole meshes are copied without compaction, including the unreferenced vertices of the second mesh.
+	addTestCase("all meshes", {}, {}, { 6, 12, 12, 24, 5, 9 });
+	addTestCase("allowed meshes", { 0, 2 }, {}, { 6, 12, 0, 0, 5, 9 });
+
+	// Faces 2-5.
+	addTestCase("face interval", {}, { { 1, { 2, 5, 1 } } }, { 6, 12, 6, 12, 5, 9 });
+
+	// Faces 0 and 2, which share a vertex, and faces 1, 4 and 7.
+	addTestCase("face step", {}, { { 0, { 0, 3, 2 } }, { 1, { 1, 7, 3 } } }, { 5, 6, 9, 9, 5, 9 });
+
+	// The last face is clamped to the last face of the mesh. Stepping from face 1 of the third mesh overflows,
+	// thus only face 1 is selected.
+	addTestCase("out-of-range last", {}, { { 0, { 2, 1000, 1 } }, { 2, { 1, UINT_MAX, UINT_MAX } } },
+		{ 4, 6, 12, 24, 3, 3 });
+
+	// No face is selected if the first face is out of range. The faces of the meshes, which are not allowed,
+	// are ignored. The zero step is handled as 1.
+	addTestCase("out-of-range first", { 0, 2 }, { { 0, { 10, 20, 1 } }, { 1, { 0, 0, 1 } }, { 2, { 0, 1, 0 } } },
+		{ 0, 0, 0, 0, 4, 6 });
+
+	// Selecting all faces of the second mesh removes its unreferenced vertices.
+	addTestCase("compaction", { 1 }, { { 1, { 0, 7, 1 } } }, { 0, 0, 10, 24, 0, 0 });
+
+	return testCases;
+}
+
+// The selected meshes and faces of a built model are appended. The vertices of the meshes, where faces are selected,
+// are compacted in the order of their first reference.
+bool TestGeometrySelection(PathHandler& pathHandler, ResourceDatabase& resourceDatabase, const std::string& modelPath)
+{
+	{
+		BuiltModel builtModel;
+		CreateSelectionModel(builtModel);
+		SaveBuiltModel(builtModel, modelPath);
+	}
+
+	auto testCases = CreateGeometrySelectionTestCases();
+	std::vector<ModelLoadingDescription> descriptions;
+	for (auto& testCase : testCases)
+	{
+		ModelLoadingDescription description;
+		description.BuildingDescription.IsBuiltModel = true;
+		description.BuildingDescription.FilePath = modelPath;
+		description.PartialModelLoadingOptions = testCase.Options;
+		descriptions.push_back(description);
+	}
+
+	ModelLoader loader(&pathHandler, &resourceDatabase);
+	Vertex_SOA_Data vertexData;
+	IndexData indexData;
+	auto results = loader.LoadBatch(descriptions, vertexData, indexData);
+
+	bool isCorrect = true;
+	auto positions = vertexData.GetPositions();
+	unsigned baseVertex = 0, baseIndex = 0;
+	for (size_t i = 0; i < testCases.size(); i++)
+	{
+		auto& testCase = testCases[i];
+		auto& meshes = results[i].Meshes;
+		bool isCaseCorrect = (meshes.GetSize() == c_SelectionCountMeshes);
+		for (unsigned meshIndex = 0; meshIndex < c_SelectionCountMeshes && isCaseCorrect; meshIndex++)
+		{
+			auto& mesh = meshes[meshIndex];
+			isCaseCorrect &= (mesh.CountVertices == testCase.ExpectedCounts[2 * meshIndex]
+				&& mesh.CountIndices == testCase.ExpectedCounts[2 * meshIndex + 1]);
+
+			// The selected faces refer to the vertices of the model's faces.
+			Core::IndexVectorU faceVertices;
+			GetSelectedFaceVertices(testCase.Options, meshIndex, faceVertices);
+			isCaseCorrect &= (faceVertices.GetSize() == mesh.CountIndices);
+			unsigned countReferencedVertices = 0;
+			for (unsigned j = 0; j < mesh.CountIndices && isCaseCorrect; j++)
+			{
+				unsigned index = indexData.Data[baseIndex + mesh.BaseIndex + j];
+				isCaseCorrect &= (index < mesh.CountVertices && index <= countReferencedVertices
+					&& positions[baseVertex + mesh.BaseVertex + index].x == static_cast<float>(faceVertices[j]));
+				if (index == countReferencedVertices) countReferencedVertices++;
+			}
+		}
+		for (unsigned meshIndex = 0; meshIndex < meshes.GetSize(); meshIndex++)
+		{
+			baseVertex += meshes[meshIndex].CountVertices;
+			baseIndex += meshes[meshIndex].CountIndices;
+		}
+
+		printf("Geometry selection, %s: %s\n", testCase.Name, isCaseCorrect ? "correct" : "INCORRECT");
+		isCorrect &= isCaseCorrect;
+	}
+	isCorrect &= (vertexData.GetCountVertices() == baseVertex && indexData.GetCountIndices() == baseIndex);
+
+	// An invalid mesh index throws.
+	auto invalidDescription = descriptions[0];
+	invalidDescription.PartialModelLoadingOptions.AllowedMeshIndices.PushBack(c_SelectionCountMeshes);
+	bool isThrown = false;
+	try
+	{
+		loader.Load(invalidDescription, vertexData, indexData);
+	}
+	catch (const std::runtime_error&)
+	{
+		isThrown = true;
+	}
+	isCorrect &= (isThrown && vertexData.GetCountVertices() == baseVertex);
+
+	return isCorrect;
+}
+
+// The levels of detail of the selection model: two levels of the first mesh and one level of the third mesh.
+const unsigned c_SelectionLODIndices[] = { 0, 1, 2, 2, 3, 4, 0, 1, 2, 1, 2, 3 };
+const MeshLOD c_SelectionLODs[] = { { 0, 6, 0.1f }, { 6, 3, 0.5f }, { 9, 3, 0.2f } };
+const MeshLODRange c_SelectionLODRanges[] = { { 0, 2 }, { 2, 0 }, { 2, 1 } };
+
+// The levels of detail are appended after the indices of the meshes, except for the meshes with selected faces.
+bool TestLoadedLODs(PathHandler& pathHandler, ResourceDatabase& resourceDatabase, const std::string& modelPath)
+{
+	{
+		BuiltModel builtModel;
+		CreateSelectionModel(builtModel);
+		builtModel.LODIndices.PushBack(c_SelectionLODIndices, 12);
+		builtModel.LODs.PushBack(c_SelectionLODs, 3);
+		builtModel.LODRanges.PushBack(c_SelectionLODRanges, c_SelectionCountMeshes);
+		SaveBuiltModel(builtModel, modelPath);
+	}
+
+	// The whole model, the allowed meshes without selected faces and the selected faces of the first mesh.
+	std::vector<ModelLoadingDescription> descriptions(3);
+	for (auto& description : descriptions)
+	{
+		description.BuildingDescription.IsBuiltModel = true;
+		description.BuildingDescription.FilePath = modelPath;
+	}
+	descriptions[1].PartialModelLoadingOptions.IsPartialModelLoadingAllowed = true;
+	descriptions[1].PartialModelLoadingOptions.AllowedMeshIndices.PushBack(0);
+	descriptions[1].PartialModelLoadingOptions.AllowedMeshIndices.PushBack(2);
+	descriptions[2].PartialModelLoadingOptions.IsPartialModelLoadingAllowed = true;
+	descriptions[2].PartialModelLoadingOptions.AllowedFaces[0] = { 0, 3, 1 };
+	const unsigned expectedCountLODs[][c_SelectionCountMeshes] = { { 2, 0, 1 }, { 2, 0, 1 }, { 0, 0, 1 } };
+
+	ModelLoader loader(&pathHandler, &resourceDatabase);
+	Vertex_SOA_Data vertexData;
+	IndexData indexData;
+	auto results = loader.LoadBatch(descriptions, vertexData, indexData);
+
+	bool isCorrect = true;
+	auto positions = vertexData.GetPositions();
+	unsigned baseVertex = 0, baseIndex = 0;
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		auto& result = results[i];
+		isCorrect &= (result.LODRanges.GetSize() == c_SelectionCountMeshes);
+		for (unsigned meshIndex = 0; meshIndex < c_SelectionCountMeshes && isCorrect; meshIndex++)
+		{
+			auto& mesh = result.Meshes[meshIndex];
+			auto& lodRange = result.LODRanges[meshIndex];
+			isCorrect &= (lodRange.CountLODs == expectedCountLODs[i][meshIndex]);
+			for (unsigned j = 0; j < lodRange.CountLODs && isCorrect; j++)
+			{
+				// The indices of a level refer to the model's vertices of the mesh.
+				auto& lod = result.LODs[lodRange.BaseLOD + j];
+				auto& builtLOD = c_SelectionLODs[c_SelectionLODRanges[meshIndex].BaseLOD + j];
+				isCorrect &= (lod.CountIndices == builtLOD.CountIndices && lod.Error == builtLOD.Error);
+				unsigned builtBaseVertex = 0;
+				for (unsigned k = 0; k < meshIndex; k++) builtBaseVertex += c_SelectionMeshCountVertices[k];
+				for (unsigned k = 0; k < lod.CountIndices && isCorrect; k++)
+				{
+					unsigned index = indexData.Data[baseIndex + lod.BaseIndex + k];
+					isCorrect &= (index == c_SelectionLODIndices[builtLOD.BaseIndex + k]
+						&& positions[baseVertex + mesh.BaseVertex + index].x == static_cast<float>(builtBaseVertex + index));
+				}
+			}
+		}
+		for (unsigned meshIndex = 0; meshIndex < result.Meshes.GetSize(); meshIndex++)
+		{
+			baseVertex += result.Meshes[meshIndex].CountVertices;
+			baseIndex += result.Meshes[meshIndex].CountIndices;
+		}
+		for (unsigned j = 0; j < result.LODs.GetSize(); j++) baseIndex += result.LODs[j].CountIndices;
+	}
+	isCorrect &= (vertexData.GetCountVertices() == baseVertex && indexData.GetCountIndices() == baseIndex);
+
+	// The coarsest level within the error threshold is selected: the error threshold equals the distance.
+	if (isCorrect)
+	{
+		auto& result = results[0];
+		auto original = result.SelectMeshGeometry(0, 0.05f, 1.0f, 1.0f, 1.0f);
+		auto lod0 = result.SelectMeshGeometry(0, 0.2f, 1.0f, 1.0f, 1.0f);
+		auto lod1 = result.SelectMeshGeometry(0, 1.0f, 1.0f, 1.0f, 1.0f);
+		auto withoutLODs = result.SelectMeshGeometry(1, 1.0f, 1.0f, 1.0f, 1.0f);
+		isCorrect &= (original.BaseIndex == result.Meshes[0].BaseIndex && original.CountIndices == 12
+			&& lod0.BaseIndex == result.LODs[0].BaseIndex && lod0.CountIndices == 6
+			&& lod1.BaseIndex == result.LODs[1].BaseIndex && lod1.CountIndices == 3
+			&& lod1.BaseVertex == result.Meshes[0].BaseVertex
+			&& withoutLODs.BaseIndex == result.Meshes[1].BaseIndex && withoutLODs.CountIndices == 24);
+	}
+
+	printf("Loaded levels of detail: %s\n", isCorrect ? "correct" : "INCORRECT");
+	return isCorrect;
+}
+
+void ModelLoaderTest::Test()
+{
+	// The models are generated and built in a temporary solution directory.
+	auto directory = (std::filesystem::temp_directory_path() / "ModelLoaderTest").generic_string();
+	std::filesystem::remove_all(directory);
+	std::filesystem::create_directories(directory + "/Build/Resources");
+
+	std::vector<std::string> modelPaths;
+	for (unsigned i = 0; i < 4; i++)
+	{
+		modelPaths.push_back(directory + "/Grid_" + std::to_string(i) + ".obj");
+		CreateGridModelFile(modelPaths.back(), c_ModelGridSizes[i], c_ModelCountMeshes[i]);
+	}
+
+	bool isCorrect = TestBuildOrder();
+	{
+		PathHandler pathHandler(directory);
+		ResourceDatabase resourceDatabase(&pathHandler);
+		Core::ThreadPool threadPool(4);
+		isCorrect &= TestLoadBatchResults(pathHandler, resourceDatabase, threadPool, modelPaths);
+		isCorrect &= TestLoadBatchRollback(pathHandler, resourceDatabase, threadPool, modelPaths,
+			directory + "/Missing.obj");
+		isCorrect &= TestGeometrySelection(pathHandler, resourceDatabase, directory + "/Selection.bin");
+		isCorrect &= TestLoadedLODs(pathHandler, resourceDatabase, directory + "/SelectionLODs.bin");
+	}
+
+	std::filesystem::remove_all(directory);
+
+	printf(isCorrect ? "Result is correct!\n" : "Result is incorrect!\n");
+}
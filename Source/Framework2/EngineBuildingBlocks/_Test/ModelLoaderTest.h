@@ -0,0 +1,16 @@
+// EngineBuildingBlocks/_Test/ModelLoaderTest.h
+
+#ifndef _ENGINEBUILDINGBLOCKS__TEST_MODELLOADERTEST_H_INCLUDED_
+#define _ENGINEBUILDINGBLOCKS__TEST_MODELLOADERTEST_H_INCLUDED_
+
+namespace EngineBuildingBlocksTest
+{
+	class ModelLoaderTest
+	{
+	public:
+
+		static void Test();
+	};
+}
+
+#endif
@@ -0,0 +1,351 @@
+// EngineBuildingBlocks/_Test/ResourceDataBaseTest.cpp
+
+#include "stdafx.h"
+
+#include <EngineBuildingBlocks/_Test/ResourceDataBaseTest.h>
+
+#include <Core/ChunkedContainer.h>
+#include <Core/SimpleBinarySerialization.hpp>
+#include <Core/StreamBinarySerialization.h>
+#include <Core/System/Filesystem.h>
+#include <Core/System/MemoryMappedFile.h>
+#include <Core/System/SimpleIO.h>
+#include <EngineBuildingBlocks/PathHandler.h>
+#include <EngineBuildingBlocks/ResourceDatabase.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <utility>
+
+using namespace EngineBuildingBlocks;
+using namespace EngineBuildingBlocksTest;
+
+// Moves the last write time of the file without modifying its content.
+void TouchResourceFile(const std::string& path, int seconds)
+{
+	std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::seconds(seconds));
+}
+
+// Writes the file and moves its last write time, thus the modification is detected independently of the resolution
+// of the file system's time stamps.
+void WriteResourceFile(const std::string& path, const char* text, int seconds)
+{
+	auto lastWriteTime = std::filesystem::last_write_time(path);
+	Core::WriteAllText(path, text);
+	std::filesystem::last_write_time(path, lastWriteTime + std::chrono::seconds(seconds));
+}
+
+ResourceDescription CreateTestResourceDescription(const std::string& path,
+	const std::vector<std::string>& dependencyPaths = {})
+{
+	ResourceDescription description;
+	description.ResourceFilePath = path;
+	description.DependencyPaths = dependencyPaths;
+	// The built resource file path only depends on the resource file path and the build options, thus the dependencies
+	// can be set after querying the built resource file paths.
+	description.SerializedBuildOptions.PushBack(1);
+	return description;
+}
+
+std::vector<BuiltResourceDescription> QueryResources(ResourceDatabase& resourceDatabase,
+	const std::vector<ResourceDescription>& descriptions)
+{
+	std::vector<BuiltResourceDescription> builtDescriptions(descriptions.size());
+	resourceDatabase.GetBuiltResourceDescriptions(descriptions.data(), descriptions.size(), builtDescriptions.data());
+	return builtDescriptions;
+}
+
+// Writes the built files of the resources and records them with different build durations.
+void BuildResources(ResourceDatabase& resourceDatabase, const std::vector<ResourceDescription>& descriptions)
+{
+	auto builtDescriptions = QueryResources(resourceDatabase, descriptions);
+	std::vector<ResourceBuildResult> results;
+	for (size_t i = 0; i < descriptions.size(); i++)
+	{
+		Core::WriteAllText(builtDescriptions[i].BuiltResourceFilePath, "Built " + descriptions[i].ResourceFilePath);
+		results.push_back({ &descriptions[i], {}, 0.5 * (i + 1) });
+	}
+	resourceDatabase.SetResourcesBuilt(results.data(), results.size());
+}
+
+bool IsOutdatedSet(ResourceDatabase& resourceDatabase, const std::vector<ResourceDescription>& descriptions,
+	const std::vector<unsigned>& expectedIndices)
+{
+	auto builtDescriptions = QueryResources(resourceDatabase, descriptions);
+	std::vector<unsigned> outdatedIndices;
+	for (unsigned i = 0; i < static_cast<unsigned>(builtDescriptions.size()); i++)
+	{
+		if (!builtDescriptions[i].IsUpToDate) outdatedIndices.push_back(i);
+	}
+	return (outdatedIndices == expectedIndices);
+}
+
+// A resource is only outdated if the content of a source has changed. The content hashes are only computed
+// for the sources with changed last write times.
+bool TestSourceChanges(const std::string& directory)
+{
+	PathHandler pathHandler(directory);
+	ResourceDatabase resourceDatabase(&pathHandler);
+
+	auto sourcePath1 = directory + "/Source1.txt";
+	auto sourcePath2 = directory + "/Source2.txt";
+	auto dependencyPath = directory + "/Dependency.txt";
+	Core::WriteAllText(sourcePath1, "Source 1");
+	Core::WriteAllText(sourcePath2, "Source 2");
+	Core::WriteAllText(dependencyPath, "Dependency");
+	std::vector<ResourceDescription> descriptions = { CreateTestResourceDescription(sourcePath1, { dependencyPath }),
+		CreateTestResourceDescription(sourcePath2) };
+
+	bool isCorrect = IsOutdatedSet(resourceDatabase, descriptions, { 0, 1 });
+	BuildResources(resourceDatabase, descriptions);
+	isCorrect &= IsOutdatedSet(resourceDatabase, descriptions, {});
+
+	// Touching a source: its content hash matches, thus the products stay valid, and the new last write time
+	// is recorded.
+	TouchResourceFile(dependencyPath, 10);
+	isCorrect &= IsOutdatedSet(resourceDatabase, descriptions, {});
+
+	// Modifying the content without changing the size and the recorded last write time: the source is not hashed
+	// again, thus the modification is not detected until the last write time changes.
+	auto lastWriteTime = std::filesystem::last_write_time(dependencyPath);
+	Core::WriteAllText(dependencyPath, "Dependencx");
+	std::filesystem::last_write_time(dependencyPath, lastWriteTime);
+	isCorrect &= IsOutdatedSet(resourceDatabase, descriptions, {});
+	TouchResourceFile(dependencyPath, 10);
+	isCorrect &= IsOutdatedSet(resourceDatabase, descriptions, { 0 });
+	BuildResources(resourceDatabase, descriptions);
+	isCorrect &= IsOutdatedSet(resourceDatabase, descriptions, {});
+
+	// Rewriting a source with the same content.
+	WriteResourceFile(sourcePath1, "Source 1", 20);
+	isCorrect &= IsOutdatedSet(resourceDatabase, descriptions, {});
+
+	// Changing the content with the same size and with a different size.
+	WriteResourceFile(sourcePath1, "Source X", 30);
+	isCorrect &= IsOutdatedSet(resourceDatabase, descriptions, { 0 });
+	WriteResourceFile(sourcePath2, "Source 2, changed", 30);
+	isCorrect &= IsOutdatedSet(resourceDatabase, descriptions, { 0, 1 });
+
+	// A missing dependency invalidates the product.
+	BuildResources(resourceDatabase, descriptions);
+	Core::RemoveFile(dependencyPath);
+	isCorrect &= IsOutdatedSet(resourceDatabase, descriptions, { 0 });
+
+	printf("Resource database, source changes: %s\n", isCorrect ? "correct" : "INCORRECT");
+	return isCorrect;
+}
+
+// The resources, which depend on built resources, are invalidated with them, and they are built
+// on higher levels.
+bool TestDependentInvalidation(const std::string& directory)
+{
+	PathHandler pathHandler(directory);
+	ResourceDatabase resourceDatabase(&pathHandler);
+
+	std::vector<std::string> sourcePaths;
+	for (unsigned i = 0; i < 4; i++)
+	{
+		sourcePaths.push_back(directory + "/Source" + std::to_string(i) + ".txt");
+		Core::WriteAllText(sourcePaths[i], "Source");
+	}
+
+	// The second resource depends on the first one, the third resource on the second one.
+	std::vector<ResourceDescription> descriptions;
+	for (auto& sourcePath : sourcePaths) descriptions.push_back(CreateTestResourceDescription(sourcePath));
+	auto builtDescriptions = QueryResources(resourceDatabase, descriptions);
+	descriptions[1] = CreateTestResourceDescription(sourcePaths[1], { builtDescriptions[0].BuiltResourceFilePath });
+	descriptions[2] = CreateTestResourceDescription(sourcePaths[2], { builtDescriptions[1].BuiltResourceFilePath });
+	BuildResources(resourceDatabase, descriptions);
+
+	builtDescriptions = QueryResources(resourceDatabase, descriptions);
+	bool isCorrect = (builtDescriptions[0].BuildLevel == 0 && builtDescriptions[1].BuildLevel == 1
+		&& builtDescriptions[2].BuildLevel == 2 && builtDescriptions[3].BuildLevel == 0);
+	isCorrect &= IsOutdatedSet(resourceDatabase, descriptions, {});
+
+	WriteResourceFile(sourcePaths[0], "Changed", 10);
+	isCorrect &= IsOutdatedSet(resourceDatabase, descriptions, { 0, 1, 2 });
+	BuildResources(resourceDatabase, descriptions);
+	isCorrect &= IsOutdatedSet(resourceDatabase, descriptions, {});
+
+	WriteResourceFile(sourcePaths[1], "Changed", 10);
+	isCorrect &= IsOutdatedSet(resourceDatabase, descriptions, { 1, 2 });
+
+	printf("Resource database, dependent invalidation: %s\n", isCorrect ? "correct" : "INCORRECT");
+	return isCorrect;
+}
+
+// The build records are stored in the manifest, thus the decisions are the same after loading it.
+bool TestManifest(const std::string& directory)
+{
+	auto sourcePath1 = directory + "/Source1.txt";
+	auto sourcePath2 = directory + "/Source2.txt";
+	Core::WriteAllText(sourcePath1, "Source 1");
+	Core::WriteAllText(sourcePath2, "Source 2");
+
+	PathHandler pathHandler(directory);
+	auto manifestFilePath = pathHandler.GetPathFromBuiltResourcesDirectory("ResourceDatabase.manifest");
+	std::vector<ResourceDescription> descriptions = { CreateTestResourceDescription(sourcePath1) };
+	std::vector<BuiltResourceDescription> builtDescriptions;
+	{
+		ResourceDatabase resourceDatabase(&pathHandler);
+		BuildResources(resourceDatabase, descriptions);
+		builtDescriptions = QueryResources(resourceDatabase, descriptions);
+		descriptions.push_back(CreateTestResourceDescription(sourcePath2, { builtDescriptions[0].BuiltResourceFilePath }));
+		BuildResources(resourceDatabase, descriptions);
+		builtDescriptions = QueryResources(resourceDatabase, descriptions);
+	}
+
+	// The manifest is replaced by each save, and no temporary file is left.
+	bool isCorrect = (Core::FileExists(manifestFilePath) && !Core::FileExists(manifestFilePath + ".tmp"));
+	for (unsigned i = 0; i < 2; i++)
+	{
+		ResourceDatabase resourceDatabase(&pathHandler);
+		auto loadedDescriptions = QueryResources(resourceDatabase, descriptions);
+		for (size_t j = 0; j < descriptions.size(); j++)
+		{
+			isCorrect &= (loadedDescriptions[j].IsUpToDate
+				&& loadedDescriptions[j].BuiltResourceFilePath == builtDescriptions[j].BuiltResourceFilePath
+				&& loadedDescriptions[j].BuildLevel == builtDescriptions[j].BuildLevel
+				&& loadedDescriptions[j].LastBuildDuration == builtDescriptions[j].LastBuildDuration);
+		}
+
+		// Saving over the existing manifest.
+		if (i == 0) BuildResources(resourceDatabase, descriptions);
+	}
+	isCorrect &= (builtDescriptions[1].BuildLevel == 1 && builtDescriptions[1].LastBuildDuration == 1.0);
+
+	// The records are loaded on demand, thus a source change after saving is detected.
+	WriteResourceFile(sourcePath2, "Source X", 10);
+	{
+		ResourceDatabase resourceDatabase(&pathHandler);
+		isCorrect &= IsOutdatedSet(resourceDatabase, descriptions, { 1 });
+	}
+
+	printf("Resource database, manifest: %s\n", isCorrect ? "correct" : "INCORRECT");
+	return isCorrect;
+}
+
+// The manifest is rewritten, so a record of a different resource has the hash of the queried resource.
+bool TestHashCollision(const std::string& directory)
+{
+	auto sourcePath = directory + "/Source.txt";
+	Core::WriteAllText(sourcePath, "Source");
+
+	PathHandler pathHandler(directory);
+	auto manifestFilePath = pathHandler.GetPathFromBuiltResourcesDirectory("ResourceDatabase.manifest");
+	std::vector<ResourceDescription> descriptions = { CreateTestResourceDescription(sourcePath) };
+	{
+		ResourceDatabase resourceDatabase(&pathHandler);
+		BuildResources(resourceDatabase, descriptions);
+	}
+
+	Core::ByteVector bytes;
+	std::uint32_t contentVersion, chunkId;
+	{
+		Core::MemoryMappedFile manifestFile(manifestFilePath);
+		Core::ChunkedContainerReader reader(manifestFile.GetData(), manifestFile.GetSize());
+		contentVersion = reader.GetContentVersion();
+		chunkId = reader.GetChunkInfo(0).Id;
+		auto data = reader.GetVerifiedChunkData(0);
+
+		const unsigned char* pData = data.GetArray();
+		unsigned countRecords;
+		Core::DeserializeSB(pData, countRecords);
+		Core::SerializeSB(bytes, countRecords);
+		for (unsigned i = 0; i < countRecords; i++)
+		{
+			std::uint64_t hashValue;
+			ResourceBuildRecord record;
+			Core::DeserializeSB(pData, hashValue);
+			Core::DeserializeSB(pData, record);
+			record.Description.ResourceFilePath = directory + "/Other.txt";
+			Core::SerializeSB(bytes, hashValue);
+			Core::SerializeSB(bytes, record);
+		}
+	}
+	{
+		Core::FileOutputSinkSB fileSink(manifestFilePath);
+		Core::ChunkedContainerWriter writer(fileSink, contentVersion);
+		writer.BeginChunk(chunkId).Write(bytes.GetArray(), bytes.GetSize());
+		writer.EndChunk();
+		writer.Finish();
+		fileSink.Close();
+	}
+
+	bool isThrown = false;
+	{
+		ResourceDatabase resourceDatabase(&pathHandler);
+		try
+		{
+			QueryResources(resourceDatabase, descriptions);
+		}
+		catch (const std::runtime_error&)
+		{
+			isThrown = true;
+		}
+	}
+
+	printf("Resource database, hash collision: %s\n", isThrown ? "correct" : "INCORRECT");
+	return isThrown;
+}
+
+// The build levels of resources, which depend on each other or on themselves, are finite.
+bool TestDependencyCycle(const std::string& directory)
+{
+	PathHandler pathHandler(directory);
+	ResourceDatabase resourceDatabase(&pathHandler);
+
+	std::vector<std::string> sourcePaths;
+	std::vector<ResourceDescription> descriptions;
+	for (unsigned i = 0; i < 3; i++)
+	{
+		sourcePaths.push_back(directory + "/Source" + std::to_string(i) + ".txt");
+		Core::WriteAllText(sourcePaths[i], "Source");
+		descriptions.push_back(CreateTestResourceDescription(sourcePaths[i]));
+	}
+	auto builtDescriptions = QueryResources(resourceDatabase, descriptions);
+	descriptions[0] = CreateTestResourceDescription(sourcePaths[0], { builtDescriptions[1].BuiltResourceFilePath });
+	descriptions[1] = CreateTestResourceDescription(sourcePaths[1], { builtDescriptions[0].BuiltResourceFilePath });
+	descriptions[2] = CreateTestResourceDescription(sourcePaths[2], { builtDescriptions[2].BuiltResourceFilePath });
+	BuildResources(resourceDatabase, descriptions);
+
+	builtDescriptions = QueryResources(resourceDatabase, descriptions);
+	bool isCorrect = (builtDescriptions[0].BuildLevel <= 2 && builtDescriptions[1].BuildLevel <= 2
+		&& builtDescriptions[0].BuildLevel != builtDescriptions[1].BuildLevel && builtDescriptions[2].BuildLevel == 0);
+	isCorrect &= IsOutdatedSet(resourceDatabase, descriptions, {});
+	WriteResourceFile(sourcePaths[0], "Changed", 10);
+	isCorrect &= IsOutdatedSet(resourceDatabase, descriptions, { 0, 1 });
+
+	printf("Resource database, dependency cycle: %s\n", isCorrect ? "correct" : "INCORRECT");
+	return isCorrect;
+}
+
+void ResourceDataBaseTest::Test()
+{
+	// Each test uses its own solution directory, thus its own built resources directory and manifest.
+	auto directory = (std::filesystem::temp_directory_path() / "ResourceDataBaseTest").generic_string();
+	std::filesystem::remove_all(directory);
+
+	std::pair<const char*, bool(*)(const std::string&)> tests[] =
+	{
+		{ "SourceChanges", &TestSourceChanges },
+		{ "DependentInvalidation", &TestDependentInvalidation },
+		{ "Manifest", &TestManifest },
+		{ "HashCollision", &TestHashCollision },
+		{ "DependencyCycle", &TestDependencyCycle }
+	};
+	bool isCorrect = true;
+	for (auto& test : tests)
+	{
+		auto testDirectory = directory + "/" + test.first;
+		std::filesystem::create_directories(testDirectory + "/Build/Resources");
+		isCorrect &= test.second(testDirectory);
+	}
+
+	std::filesystem::remove_all(directory);
+
+	printf(isCorrect ? "Result is correct!\n" : "Result is incorrect!\n");
+}
@@ -0,0 +1,16 @@
+// EngineBuildingBlocks/_Test/ResourceDataBaseTest.h
+
+#ifndef _ENGINEBUILDINGBLOCKS__TEST_RESOURCEDATABASETEST_H_INCLUDED_
+#define _ENGINEBUILDINGBLOCKS__TEST_RESOURCEDATABASETEST_H_INCLUDED_
+
+namespace EngineBuildingBlocksTest
+{
+	class ResourceDataBaseTest
+	{
+	public:
+
+		static void Test();
+	};
+}
+
+#endif
@@ -107,6 +107,59 @@ struct SceneNodeUpdater
 	}
 };
 
+// Updates the same hierarchy with a byte mask, with a bit set and with an index list and checks that
+// the same scene nodes are gathered for the update, i.e. exactly the allowed nodes become up-to-date.
+bool TestMaskedUpdates()
+{
+	const unsigned countNodes = 1000;
+
+	EngineBuildingBlocks::SceneNodeHandler handlers[3];
+	Core::ByteVectorU byteMask;
+	Core::BitSet bitMask(countNodes);
+	Core::IndexVectorU allowedIndices;
+	std::vector<unsigned> parents(countNodes, Core::c_InvalidIndexU);
+	for (unsigned i = 0; i < countNodes; i++)
+	{
+		for (auto& handler : handlers) handler.CreateSceneNode(false);
+
+		// A node may only be allowed if its parent is allowed.
+		if (i > 0 && GetRandomFloat() < 0.5f) parents[i] = s_RandomGenerator() % i;
+		bool isParentAllowed = (parents[i] == Core::c_InvalidIndexU || byteMask[parents[i]] != 0);
+		bool isAllowed = (isParentAllowed && GetRandomFloat() < 0.6f);
+		byteMask.PushBack(isAllowed ? Core::c_True : Core::c_False);
+		if (isAllowed)
+		{
+			bitMask.Set(i);
+			allowedIndices.PushBack(i);
+		}
+	}
+	for (auto& handler : handlers)
+	{
+		for (unsigned i = 0; i < countNodes; i++)
+		{
+			if (parents[i] != Core::c_InvalidIndexU) handler.SetConnection(parents[i], i);
+			handler.SetLocalPosition(i, GetRandomPosition());
+			handler.SetSceneNodeDirty(i);
+		}
+	}
+
+	handlers[0].UpdateTransformations(byteMask);
+	handlers[1].UpdateTransformations(bitMask);
+	handlers[2].UpdateTransformations(allowedIndices);
+
+	for (unsigned i = 0; i < countNodes; i++)
+	{
+		bool isDirty = handlers[0].GetMainData()[i].IsTransformationDirtyForHandler();
+		if (isDirty == (byteMask[i] != 0)
+			|| handlers[1].GetMainData()[i].IsTransformationDirtyForHandler() != isDirty
+			|| handlers[2].GetMainData()[i].IsTransformationDirtyForHandler() != isDirty)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
 void SceneNodeTest::Test()
 {
 	// Creating scene nodes for Framework1.
@@ -257,6 +310,15 @@ void SceneNodeTest::Test()
 		printf("Result is incorrect!\n");
 	}
 
+	if (TestMaskedUpdates())
+	{
+		printf("Masked update result is correct!\n");
+	}
+	else
+	{
+		printf("Masked update result is incorrect!\n");
+	}
+
 	// Creating camera.
 	EngineBuildingBlocks::Graphics::Camera camera(&sceneNodeHandler);
 	camera.SetPosition({ 0.0f, 0.0f, -3.0f });
@@ -0,0 +1,120 @@
+// EngineBuildingBlocks/_Test/VertexInterleavingTest.cpp
+
+#include "stdafx.h"
+
+#include <EngineBuildingBlocks/_Test/VertexInterleavingTest.h>
+
+#include <Core/DataStructures/SimpleTypeVector.hpp>
+#include <Core/System/ThreadPool.h>
+#include <EngineBuildingBlocks/Graphics/Primitives/VertexInterleaving.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace EngineBuildingBlocks::Graphics;
+using namespace EngineBuildingBlocksTest;
+
+// An odd count of vertices, so the chunks and blocks are not full.
+const unsigned c_CountInterleavedVertices = 1000 * 1000 + 13;
+const unsigned c_CountInterleavingIterations = 10;
+
+struct InterleavingTestLayout
+{
+	const char* Name;
+	std::vector<unsigned> ElementSizes;
+};
+
+double MeasureInterleaving(const std::function<void()>& function)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+	for (unsigned i = 0; i < c_CountInterleavingIterations; i++) function();
+	auto elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+	return elapsed / c_CountInterleavingIterations * 1e3;
+}
+
+bool TestInterleavingLayout(const InterleavingTestLayout& layout, Core::ThreadPool& threadPool)
+{
+	auto sizes = layout.ElementSizes.data();
+	auto countElements = static_cast<unsigned>(layout.ElementSizes.size());
+	unsigned stride = 0;
+	for (unsigned i = 0; i < countElements; i++) stride += sizes[i];
+	unsigned countVertices = c_CountInterleavedVertices;
+
+	std::mt19937 randomGenerator;
+	std::uniform_int_distribution<unsigned> distribution(0, 255);
+	std::vector<Core::ByteVectorU> sourceArrays(countElements), resultArrays(countElements);
+	Core::SimpleTypeVectorU<const unsigned char*> sources;
+	Core::SimpleTypeVectorU<unsigned char*> results;
+	for (unsigned i = 0; i < countElements; i++)
+	{
+		sourceArrays[i].Resize(countVertices * sizes[i]);
+		resultArrays[i].Resize(countVertices * sizes[i]);
+		for (unsigned j = 0; j < sourceArrays[i].GetSize(); j++)
+		{
+			sourceArrays[i][j] = static_cast<unsigned char>(distribution(randomGenerator));
+		}
+		sources.PushBack(sourceArrays[i].GetArray());
+		results.PushBack(resultArrays[i].GetArray());
+	}
+
+	Core::ByteVectorU expected(countVertices * stride), interleaved(countVertices * stride);
+	auto genericTime = MeasureInterleaving([&]() {
+		InterleaveVertexElementsGeneric(sources.GetArray(), sizes, countElements, countVertices, expected.GetArray()); });
+	auto optimizedTime = MeasureInterleaving([&]() {
+		InterleaveVertexElements(sources.GetArray(), sizes, countElements, countVertices, interleaved.GetArray()); });
+	bool isCorrect = (memcmp(expected.GetArray(), interleaved.GetArray(), expected.GetSize()) == 0);
+
+	memset(interleaved.GetArray(), 0, interleaved.GetSize());
+	auto parallelTime = MeasureInterleaving([&]() {
+		InterleaveVertexElements(sources.GetArray(), sizes, countElements, countVertices, interleaved.GetArray(),
+			&threadPool); });
+	isCorrect &= (memcmp(expected.GetArray(), interleaved.GetArray(), expected.GetSize()) == 0);
+
+	printf("%s, interleaving: generic: %.2f ms, optimized: %.2f ms, parallel: %.2f ms\n",
+		layout.Name, genericTime, optimizedTime, parallelTime);
+
+	genericTime = MeasureInterleaving([&]() {
+		DeinterleaveVertexElementsGeneric(expected.GetArray(), sizes, countElements, countVertices, results.GetArray()); });
+	optimizedTime = MeasureInterleaving([&]() {
+		DeinterleaveVertexElements(expected.GetArray(), sizes, countElements, countVertices, results.GetArray()); });
+	for (unsigned i = 0; i < countElements; i++)
+	{
+		isCorrect &= (memcmp(sourceArrays[i].GetArray(), resultArrays[i].GetArray(), sourceArrays[i].GetSize()) == 0);
+		memset(resultArrays[i].GetArray(), 0, resultArrays[i].GetSize());
+	}
+	parallelTime = MeasureInterleaving([&]() {
+		DeinterleaveVertexElements(expected.GetArray(), sizes, countElements, countVertices, results.GetArray(),
+			&threadPool); });
+	for (unsigned i = 0; i < countElements; i++)
+	{
+		isCorrect &= (memcmp(sourceArrays[i].GetArray(), resultArrays[i].GetArray(), sourceArrays[i].GetSize()) == 0);
+	}
+
+	printf("%s, deinterleaving: generic: %.2f ms, optimized: %.2f ms, parallel: %.2f ms, %s\n",
+		layout.Name, genericTime, optimizedTime, parallelTime, isCorrect ? "correct" : "INCORRECT");
+	return isCorrect;
+}
+
+void VertexInterleavingTest::Test()
+{
+	Core::ThreadPool threadPool;
+
+	InterleavingTestLayout layouts[] =
+	{
+		{ "Position, texture coordinate, normal", { 12, 8, 12 } },
+		{ "Position, normal, tangent, bitangent, texture coordinate", { 12, 12, 12, 12, 8 } },
+		{ "Position, texture coordinate, normal, tangent, bitangent, bones", { 12, 8, 12, 12, 12, 16, 16 } },
+
+		// Not specialized: quantized elements.
+		{ "Quantized", { 8, 4, 4, 2 } }
+	};
+
+	bool isCorrect = true;
+	for (auto& layout : layouts) isCorrect &= TestInterleavingLayout(layout, threadPool);
+
+	printf(isCorrect ? "Result is correct!\n" : "Result is incorrect!\n");
+}
@@ -0,0 +1,16 @@
+// EngineBuildingBlocks/_Test/VertexInterleavingTest.h
+
+#ifndef _ENGINEBUILDINGBLOCKS__TEST_VERTEXINTERLEAVINGTEST_H_INCLUDED_
+#define _ENGINEBUILDINGBLOCKS__TEST_VERTEXINTERLEAVINGTEST_H_INCLUDED_
+
+namespace EngineBuildingBlocksTest
+{
+	class VertexInterleavingTest
+	{
+	public:
+
+		static void Test();
+	};
+}
+
+#endif
@@ -0,0 +1,395 @@
+// EngineBuildingBlocks/_Test/VertexQuantizationTest.cpp
+
+#include "stdafx.h"
+
+#include <EngineBuildingBlocks/_Test/VertexQuantizationTest.h>
+
+#include <EngineBuildingBlocks/Graphics/Primitives/Primitive.h>
+
+#include <glm-0.9.8.1/glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace EngineBuildingBlocks::Animation;
+using namespace EngineBuildingBlocks::Graphics;
+using namespace EngineBuildingBlocksTest;
+
+const unsigned c_QuantizationVertexCount = 4096;
+
+template <typename T>
+inline T ReadQuantizedComponent(const unsigned char*& source)
+{
+	T value;
+	memcpy(&value, source, sizeof(T));
+	source += sizeof(T);
+	return value;
+}
+
+// Decodes the components of a vertex as the input assembler.
+void DecodeQuantizedVertex(const VertexElement& element, const unsigned char* source, float* decoded)
+{
+	if (element.Type == VertexElementType::Unorm10_10_10_2)
+	{
+		auto packed = ReadQuantizedComponent<std::uint32_t>(source);
+		for (unsigned i = 0; i < 3; i++) decoded[i] = static_cast<float>((packed >> (10 * i)) & 1023) / 1023.0f;
+		decoded[3] = static_cast<float>(packed >> 30) / 3.0f;
+		return;
+	}
+	for (unsigned i = 0; i < element.Count; i++)
+	{
+		switch (element.Type)
+		{
+		case VertexElementType::Float: decoded[i] = ReadQuantizedComponent<float>(source); break;
+		case VertexElementType::Uint32: decoded[i] = static_cast<float>(ReadQuantizedComponent<std::uint32_t>(source)); break;
+		case VertexElementType::Half: decoded[i] = glm::unpackHalf1x16(ReadQuantizedComponent<std::uint16_t>(source)); break;
+		case VertexElementType::Snorm16: decoded[i] = std::max(ReadQuantizedComponent<std::int16_t>(source) / 32767.0f, -1.0f); break;
+		case VertexElementType::Unorm16: decoded[i] = ReadQuantizedComponent<std::uint16_t>(source) / 65535.0f; break;
+		case VertexElementType::Snorm8: decoded[i] = std::max(ReadQuantizedComponent<std::int8_t>(source) / 127.0f, -1.0f); break;
+		case VertexElementType::Unorm8: decoded[i] = ReadQuantizedComponent<std::uint8_t>(source) / 255.0f; break;
+		case VertexElementType::Uint16: decoded[i] = static_cast<float>(ReadQuantizedComponent<std::uint16_t>(source)); break;
+		case VertexElementType::Uint8: decoded[i] = static_cast<float>(ReadQuantizedComponent<std::uint8_t>(source)); break;
+		default: decoded[i] = 0.0f; break;
+		}
+	}
+}
+
+// Decodes a unit vector with the shader code of the octahedral formats.
+void DecodeOctahedralVertex(const float* encoded, float* vector)
+{
+	float n[3] = { encoded[0], encoded[1], 1.0f - std::abs(encoded[0]) - std::abs(encoded[1]) };
+	if (n[2] < 0.0f)
+	{
+		float x = (1.0f - std::abs(n[1])) * (n[0] >= 0.0f ? 1.0f : -1.0f);
+		float y = (1.0f - std::abs(n[0])) * (n[1] >= 0.0f ? 1.0f : -1.0f);
+		n[0] = x;
+		n[1] = y;
+	}
+	float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+	for (unsigned i = 0; i < 3; i++) vector[i] = n[i] / length;
+}
+
+// Returns the random unit vectors, the axes and the diagonals.
+std::vector<glm::vec3> CreateUnitVectors()
+{
+	std::vector<glm::vec3> vectors;
+	for (int i = 0; i < 3; i++)
+	{
+		for (float sign : { -1.0f, 1.0f })
+		{
+			glm::vec3 axis(0.0f);
+			axis[i] = sign;
+			vectors.push_back(axis);
+		}
+	}
+	for (int i = 0; i < 8; i++)
+	{
+		vectors.push_back(glm::vec3((i & 1) ? -1.0f : 1.0f, (i & 2) ? -1.0f : 1.0f, (i & 4) ? -1.0f : 1.0f) / std::sqrt(3.0f));
+	}
+	std::mt19937 generator;
+	std::normal_distribution<float> distribution;
+	while (vectors.size() < c_QuantizationVertexCount)
+	{
+		glm::vec3 v(distribution(generator), distribution(generator), distribution(generator));
+		float length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+		if (length > 1e-3f) vectors.push_back(v / length);
+	}
+	return vectors;
+}
+
+Core::ByteVectorU CreateElementData(const void* data, unsigned size)
+{
+	Core::ByteVectorU bytes(size);
+	memcpy(bytes.GetArray(), data, size);
+	return bytes;
+}
+
+// The reported maximum error must match the error of the decoded values.
+bool IsReportedErrorCorrect(const VertexQuantizationError& error, const char* elementName, float maxError)
+{
+	return (error.ElementName == elementName && std::abs(error.MaxError - maxError) <= 1e-6f + maxError * 1e-4f
+		&& error.MeanError <= error.MaxError);
+}
+
+bool TestFloatRoundTrip(const char* name, VertexElementFormat format, VertexElementType expectedType,
+	unsigned expectedTypeSize, float minValue, float maxComponentError)
+{
+	std::mt19937 generator;
+	std::uniform_real_distribution<float> distribution(minValue, 1.0f);
+	std::vector<float> values(c_QuantizationVertexCount * 3);
+	for (auto& value : values) value = distribution(generator);
+	values[0] = minValue;
+	values[1] = 1.0f;
+	values[2] = 0.0f;
+
+	// The 3-component elements are padded to 4 components.
+	Core::ByteVectorU result;
+	VertexQuantizationError error;
+	auto element = QuantizeVertexElement(c_NormalVertexElement,
+		CreateElementData(values.data(), static_cast<unsigned>(values.size() * sizeof(float))), format, result, &error);
+	bool isCorrect = (element.Name == c_NormalVertexElement.Name && element.Type == expectedType
+		&& element.TypeSize == expectedTypeSize && element.Count == 4
+		&& result.GetSize() == c_QuantizationVertexCount * element.GetTotalSize());
+
+	float maxError = 0.0f;
+	for (unsigned i = 0; i < c_QuantizationVertexCount && isCorrect; i++)
+	{
+		float decoded[4];
+		DecodeQuantizedVertex(element, result.GetArray() + i * element.GetTotalSize(), decoded);
+		float squaredError = 0.0f;
+		for (unsigned j = 0; j < 3; j++)
+		{
+			float difference = decoded[j] - values[i * 3 + j];
+			isCorrect &= (std::abs(difference) <= maxComponentError);
+			squaredError += difference * difference;
+		}
+		isCorrect &= (decoded[3] == 0.0f);
+		maxError = std::max(maxError, std::sqrt(squaredError));
+	}
+	isCorrect &= IsReportedErrorCorrect(error, c_NormalVertexElement.Name.c_str(), maxError);
+
+	printf("%s round-trip: %s\n", name, isCorrect ? "correct" : "INCORRECT");
+	return isCorrect;
+}
+
+bool TestUnitVectorRoundTrip(const char* name, VertexElementFormat format, float maxAngleInDegrees)
+{
+	auto vectors = CreateUnitVectors();
+	Core::ByteVectorU result;
+	VertexQuantizationError error;
+	auto element = QuantizeVertexElement(c_NormalVertexElement,
+		CreateElementData(vectors.data(), static_cast<unsigned>(vectors.size() * sizeof(glm::vec3))), format, result, &error);
+	bool isOctahedral = (format != VertexElementFormat::Unorm10_10_10_2);
+	bool isCorrect = (element.Count == (isOctahedral ? 2U : 1U)
+		&& result.GetSize() == c_QuantizationVertexCount * element.GetTotalSize());
+
+	float maxAngle = 0.0f, maxError = 0.0f;
+	for (unsigned i = 0; i < c_QuantizationVertexCount && isCorrect; i++)
+	{
+		float decoded[4], vector[3];
+		DecodeQuantizedVertex(element, result.GetArray() + i * element.GetTotalSize(), decoded);
+		if (isOctahedral) DecodeOctahedralVertex(decoded, vector);
+		else
+		{
+			for (unsigned j = 0; j < 3; j++) vector[j] = decoded[j] * 2.0f - 1.0f;
+			isCorrect &= (decoded[3] == 0.0f);
+		}
+		float squaredError = 0.0f;
+		double squaredLength = 0.0;
+		for (unsigned j = 0; j < 3; j++)
+		{
+			squaredError += (vector[j] - vectors[i][j]) * (vector[j] - vectors[i][j]);
+			squaredLength += static_cast<double>(vector[j]) * vector[j];
+		}
+
+		// The angle is computed from the chord, since the arc cosine is imprecise for the small angles.
+		double squaredChord = 0.0;
+		for (unsigned j = 0; j < 3; j++)
+		{
+			double difference = vector[j] / std::sqrt(squaredLength) - vectors[i][j];
+			squaredChord += difference * difference;
+		}
+		float angle = static_cast<float>(2.0 * std::asin(std::sqrt(squaredChord) * 0.5) * 180.0 / 3.14159265358979);
+		maxAngle = std::max(maxAngle, angle);
+		maxError = std::max(maxError, std::sqrt(squaredError));
+	}
+	isCorrect &= (maxAngle <= maxAngleInDegrees);
+	isCorrect &= IsReportedErrorCorrect(error, c_NormalVertexElement.Name.c_str(), maxError);
+
+	printf("%s round-trip: maximum angle error: %f degrees, %s\n", name, maxAngle, isCorrect ? "correct" : "INCORRECT");
+	return isCorrect;
+}
+
+bool TestIntegerRoundTrip(const char* name, VertexElementFormat format, unsigned maxValue)
+{
+	std::mt19937 generator;
+	std::uniform_int_distribution<unsigned> distribution(0, maxValue);
+	std::vector<unsigned> values(c_QuantizationVertexCount * 4);
+	for (auto& value : values) value = distribution(generator);
+	values[0] = maxValue;
+
+	Core::ByteVectorU result;
+	auto element = QuantizeVertexElement(c_VertexBoneIndexVertexElement,
+		CreateElementData(values.data(), static_cast<unsigned>(values.size() * sizeof(unsigned))), format, result);
+	bool isCorrect = (element.Count == 4 && result.GetSize() == c_QuantizationVertexCount * element.GetTotalSize());
+	for (unsigned i = 0; i < c_QuantizationVertexCount && isCorrect; i++)
+	{
+		float decoded[4];
+		DecodeQuantizedVertex(element, result.GetArray() + i * element.GetTotalSize(), decoded);
+		for (unsigned j = 0; j < 4; j++) isCorrect &= (decoded[j] == static_cast<float>(values[i * 4 + j]));
+	}
+
+	// The values, which don't fit to the format are rejected.
+	values[0] = maxValue + 1;
+	try
+	{
+		QuantizeVertexElement(c_VertexBoneIndexVertexElement,
+			CreateElementData(values.data(), static_cast<unsigned>(values.size() * sizeof(unsigned))), format, result);
+		isCorrect = false;
+	}
+	catch (const std::exception&)
+	{
+	}
+
+	printf("%s round-trip: %s\n", name, isCorrect ? "correct" : "INCORRECT");
+	return isCorrect;
+}
+
+bool TestRoundTrips()
+{
+	bool isCorrect = true;
+	isCorrect &= TestFloatRoundTrip("Half", VertexElementFormat::Half, VertexElementType::Half, 2, -1.0f, 1.0f / 2048.0f);
+	isCorrect &= TestFloatRoundTrip("Snorm16", VertexElementFormat::Snorm16, VertexElementType::Snorm16, 2, -1.0f, 0.5f / 32767.0f + 1e-7f);
+	isCorrect &= TestFloatRoundTrip("Unorm16", VertexElementFormat::Unorm16, VertexElementType::Unorm16, 2, 0.0f, 0.5f / 65535.0f + 1e-7f);
+	isCorrect &= TestFloatRoundTrip("Snorm8", VertexElementFormat::Snorm8, VertexElementType::Snorm8, 1, -1.0f, 0.5f / 127.0f + 1e-7f);
+	isCorrect &= TestFloatRoundTrip("Unorm8", VertexElementFormat::Unorm8, VertexElementType::Unorm8, 1, 0.0f, 0.5f / 255.0f + 1e-7f);
+	isCorrect &= TestUnitVectorRoundTrip("Unorm10_10_10_2", VertexElementFormat::Unorm10_10_10_2, 0.2f);
+	isCorrect &= TestIntegerRoundTrip("Uint16", VertexElementFormat::Uint16, 65535);
+	isCorrect &= TestIntegerRoundTrip("Uint8", VertexElementFormat::Uint8, 255);
+
+	// The formats are checked against the element types.
+	Core::ByteVectorU data(c_QuantizationVertexCount * c_PositionVertexElement.GetTotalSize(), 0), result;
+	for (auto format : { VertexElementFormat::Uint8, VertexElementFormat::Octahedral16 })
+	{
+		auto& element = (format == VertexElementFormat::Uint8 ? c_PositionVertexElement : c_TextureCoordinateVertexElement);
+		try
+		{
+			QuantizeVertexElement(element, data, format, result);
+			isCorrect = false;
+		}
+		catch (const std::exception&)
+		{
+		}
+	}
+
+	return isCorrect;
+}
+
+bool TestOctahedralNormals()
+{
+	// The lattice points are 1 / (2^(n-1) - 1) apart, thus every encoded value is at most sqrt(2) / 2 lattice
+	// steps from the closest one. The decoding stretches the encoded distances at most twice, which bounds
+	// the angle error by sqrt(2) lattice steps in radians.
+	const float c_RadiansToDegrees = 57.29578f;
+	const float c_Margin = 1.01f;
+	bool isCorrect = true;
+	isCorrect &= TestUnitVectorRoundTrip("Octahedral16", VertexElementFormat::Octahedral16,
+		std::sqrt(2.0f) / 32767.0f * c_RadiansToDegrees * c_Margin);
+	isCorrect &= TestUnitVectorRoundTrip("Octahedral8", VertexElementFormat::Octahedral8,
+		std::sqrt(2.0f) / 127.0f * c_RadiansToDegrees * c_Margin);
+	return isCorrect;
+}
+
+bool TestQuantizationErrors()
+{
+	auto normals = CreateUnitVectors();
+	std::vector<glm::vec3> positions(c_QuantizationVertexCount);
+	std::vector<glm::vec2> textureCoordinates(c_QuantizationVertexCount);
+	std::vector<glm::vec4> colors(c_QuantizationVertexCount);
+	for (unsigned i = 0; i < c_QuantizationVertexCount; i++)
+	{
+		positions[i] = normals[i] * (1.0f + static_cast<float>(i % 64));
+		textureCoordinates[i] = glm::vec2(normals[i][0], normals[i][1]);
+		colors[i] = glm::vec4(std::abs(normals[i][0]), std::abs(normals[i][1]), std::abs(normals[i][2]), 1.0f);
+	}
+
+	Vertex_SOA_Data vertexData;
+	vertexData.AddPositionVertexElement(positions.data(), c_QuantizationVertexCount);
+	vertexData.AddTextureCoordinateVertexElement(textureCoordinates.data(), c_QuantizationVertexCount);
+	vertexData.AddNormalVertexElement(normals.data(), c_QuantizationVertexCount);
+	vertexData.AddVertexColorVertexElement(colors.data(), c_QuantizationVertexCount);
+	auto originalData = vertexData.Data;
+
+	// The missing bone elements and the unchanged texture coordinates have no errors.
+	VertexQuantizationOptionsType options;
+	options.PositionFormat = VertexElementFormat::Half;
+	options.NormalFormat = VertexElementFormat::Octahedral8;
+	options.VertexColorFormat = VertexElementFormat::Unorm8;
+	options.BoneWeightFormat = VertexElementFormat::Unorm8;
+	std::vector<VertexQuantizationError> errors;
+	QuantizeVertexData(vertexData, options, &errors);
+	bool isCorrect = (errors.size() == 3 && vertexData.Data[1] == originalData[1]
+		&& vertexData.InputLayout.Elements[1] == c_TextureCoordinateVertexElement);
+
+	const VertexElement* originalElements[] = { &c_PositionVertexElement, &c_NormalVertexElement, &c_VertexColorVertexElement };
+	const unsigned elementIndices[] = { 0, 2, 3 };
+	for (unsigned i = 0; i < 3 && isCorrect; i++)
+	{
+		auto& originalElement = *originalElements[i];
+		auto& element = vertexData.InputLayout.Elements[elementIndices[i]];
+		auto original = reinterpret_cast<const float*>(originalData[elementIndices[i]].GetArray());
+		auto quantized = vertexData.Data[elementIndices[i]].GetArray();
+		float maxError = 0.0f;
+		double sumError = 0.0;
+		for (unsigned j = 0; j < c_QuantizationVertexCount; j++)
+		{
+			float decoded[4], vector[4];
+			DecodeQuantizedVertex(element, quantized + j * element.GetTotalSize(), decoded);
+			if (i == 1) DecodeOctahedralVertex(decoded, vector);
+			else memcpy(vector, decoded, sizeof(decoded));
+			float squaredError = 0.0f;
+			for (unsigned k = 0; k < originalElement.Count; k++)
+			{
+				float difference = vector[k] - original[j * originalElement.Count + k];
+				squaredError += difference * difference;
+			}
+			maxError = std::max(maxError, std::sqrt(squaredError));
+			sumError += std::sqrt(squaredError);
+		}
+		float meanError = static_cast<float>(sumError / c_QuantizationVertexCount);
+		isCorrect &= (maxError > 0.0f && IsReportedErrorCorrect(errors[i], originalElement.Name.c_str(), maxError)
+			&& std::abs(errors[i].MeanError - meanError) <= meanError * 1e-3f);
+	}
+
+	// The bone formats are applied when the bone data is added.
+	BoneInfluenceVector influences(c_QuantizationVertexCount);
+	for (unsigned i = 0; i < c_QuantizationVertexCount; i++)
+	{
+		influences[i].PushBack({ i % 200, 0.75f });
+		if (i % 3 != 0) influences[i].PushBack({ (i + 1) % 200, 0.25f });
+	}
+	BoneData boneData;
+	boneData.SetInfluenceVector(influences);
+	vertexData.AddBoneData(boneData, VertexQuantizationOptionsType::GetCompact());
+	auto& layout = vertexData.InputLayout;
+	unsigned boneIndexIndex = layout.GetVertexElementIndex(c_VertexBoneIndexVertexElement.Name.c_str());
+	unsigned boneWeightIndex = layout.GetVertexElementIndex(c_VertexBoneWeightVertexElement.Name.c_str());
+	isCorrect &= (boneIndexIndex != Core::c_InvalidIndexU && boneWeightIndex != Core::c_InvalidIndexU);
+	if (isCorrect)
+	{
+		auto& boneIndexElement = layout.Elements[boneIndexIndex];
+		auto& boneWeightElement = layout.Elements[boneWeightIndex];
+		isCorrect &= (boneIndexElement.Type == VertexElementType::Uint8 && boneWeightElement.Type == VertexElementType::Unorm8);
+		for (unsigned i = 0; i < c_QuantizationVertexCount && isCorrect; i++)
+		{
+			float boneIndices[4], boneWeights[4];
+			DecodeQuantizedVertex(boneIndexElement, vertexData.Data[boneIndexIndex].GetArray() + i * 4, boneIndices);
+			DecodeQuantizedVertex(boneWeightElement, vertexData.Data[boneWeightIndex].GetArray() + i * 4, boneWeights);
+			for (unsigned j = 0; j < 4; j++)
+			{
+				bool isInfluence = (j < influences[i].GetSize());
+				float boneIndex = (isInfluence ? static_cast<float>(influences[i][j].BoneIndex) : 0.0f);
+				float boneWeight = (isInfluence ? influences[i][j].Weight : 0.0f);
+				isCorrect &= (boneIndices[j] == boneIndex && std::abs(boneWeights[j] - boneWeight) <= 0.5f / 255.0f + 1e-7f);
+			}
+		}
+	}
+
+	printf("Quantization errors: %s\n", isCorrect ? "correct" : "INCORRECT");
+	return isCorrect;
+}
+
+void VertexQuantizationTest::Test()
+{
+	bool isCorrect = true;
+	isCorrect &= TestRoundTrips();
+	isCorrect &= TestOctahedralNormals();
+	isCorrect &= TestQuantizationErrors();
+
+	printf(isCorrect ? "Result is correct!\n" : "Result is incorrect!\n");
+}
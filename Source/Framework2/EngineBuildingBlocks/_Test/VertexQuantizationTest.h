@@ -0,0 +1,16 @@
+// EngineBuildingBlocks/_Test/VertexQuantizationTest.h
+
+#ifndef _ENGINEBUILDINGBLOCKS__TEST_VERTEXQUANTIZATIONTEST_H_INCLUDED_
+#define _ENGINEBUILDINGBLOCKS__TEST_VERTEXQUANTIZATIONTEST_H_INCLUDED_
+
+namespace EngineBuildingBlocksTest
+{
+	class VertexQuantizationTest
+	{
+	public:
+
+		static void Test();
+	};
+}
+
+#endif
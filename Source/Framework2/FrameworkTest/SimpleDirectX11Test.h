@@ -190,8 +190,7 @@ namespace FrameworkTest
 			const EngineBuildingBlocks::Graphics::ModelInstantiationResult& instRes, bool& isOpaque);
 		unsigned AddRenderTask(unsigned objectIndex,
 			const EngineBuildingBlocks::Graphics::ModelLoadingResult& loadRes,
-			const EngineBuildingBlocks::Graphics::ModelInstantiationResult& instRes,
-			const EngineBuildingBlocks::Graphics::Vertex_SOA_Data& vertexData);
+			const EngineBuildingBlocks::Graphics::ModelInstantiationResult& instRes);
 	
 	public:
 
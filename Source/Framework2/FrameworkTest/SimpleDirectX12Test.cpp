@@ -2,6 +2,7 @@
 
 #include <FrameworkTest/SimpleDirectX12Test.h>
 
+#include <Core/FixedSizedOutputStream.hpp>
 #include <EngineBuildingBlocks/SystemTime.h>
 #include <EngineBuildingBlocks/Graphics/Resources/ImageHelper.h>
 #include <EngineBuildingBlocks/Input/DefaultInputBinder.h>
@@ -548,8 +549,7 @@ unsigned SimpleDirectX12Test::AddRenderTask(unsigned objectIndex,
 	renderTask.Primitive.BaseVertex = geometryData.BaseVertex;
 	renderTask.Primitive.BaseIndex = geometryData.BaseIndex;
 	
-	renderTask.BoundingBox = AABoundingBox::GetBoundingBox(
-		m_VertexData.GetPositions() + geometryData.BaseVertex, geometryData.CountVertices);
+	renderTask.BoundingBox = model.MeshLocalBounds[objectData.MeshIndex].Box;
 
 	return m_RenderTasks.Add(renderTask);
 }
@@ -723,14 +723,8 @@ void SimpleDirectX12Test::UpdateRenderableSceneNodeData()
 	// Updating renderable scene node indices.
 	if (!m_IsSceneNodeVectorsUpToDate)
 	{
-		m_RenderTaskIndices.Resize(m_RenderTasks.GetSize());
-
-		auto it = m_RenderTasks.GetBeginIterator();
-		auto end = m_RenderTasks.GetEndIterator();
-		for (int i = 0; it != end; ++i, ++it)
-		{
-			m_RenderTaskIndices[i] = m_RenderTasks.ToIndex(it);
-		}
+		m_RenderTaskIndices.Clear();
+		m_RenderTaskIndices.PushBack(m_RenderTasks.GetDenseIndices(), m_RenderTasks.GetSize());
 
 		m_IsSceneNodeVectorsUpToDate = true;
 	}
@@ -761,13 +755,13 @@ void SimpleDirectX12Test::DerivedPostUpdate(EngineBuildingBlocks::PostUpdateCont
 
 		if (m_IsWindowed)
 		{
-			std::stringstream ssTitle;
-			ssTitle << m_Title << " :: FPS: " << fps << " :: Draw calls: " << m_CountDrawCalls;
-			m_Window.SetTitle(ssTitle.str());
+			Core::FixedSizedOutputStream<256> title;
+			Core::FormatTo(title, CORE_FORMAT_STRING("%x :: FPS: %x :: Draw calls: %x"), m_Title, fps, m_CountDrawCalls);
+			m_Window.SetTitle(title.ToCString());
 		}
-		std::stringstream ssTRT;
-		ssTRT << "FPS: " << fps << "\nDraw calls : " << m_CountDrawCalls;	
-		m_Statistics_TRT.SetText(ssTRT.str().c_str());
+		char statisticsText[64];
+		Core::FormatTo(statisticsText, CORE_FORMAT_STRING("FPS: %x\nDraw calls : %x"), fps, m_CountDrawCalls);
+		m_Statistics_TRT.SetText(statisticsText);
 		m_Statistics_TRT.Update(m_DX12U.TextRenderer);
 	}
 }
@@ -2,6 +2,7 @@
 
 #include <FrameworkTest/SimpleOpenGLTest.h>
 
+#include <Core/FixedSizedOutputStream.hpp>
 #include <EngineBuildingBlocks/Input/DefaultInputBinder.h>
 #include <EngineBuildingBlocks/Graphics/Lighting/Lighting1.h>
 #include <OpenGLRender/GLFW.h>
@@ -358,8 +359,7 @@ unsigned SimpleOpenGLTest::GetMaterialIndex(unsigned objectIndex,
 }
 
 unsigned SimpleOpenGLTest::AddRenderTask(unsigned objectIndex,
-	const ModelLoadingResult& loadRes, const ModelInstantiationResult& instRes,
-	const Vertex_SOA_Data& vertexData)
+	const ModelLoadingResult& loadRes, const ModelInstantiationResult& instRes)
 {
 	auto& model = m_ModelLoader.GetModel(loadRes.ModelIndex);
 	auto& objectData = model.Objects[objectIndex];
@@ -384,8 +384,7 @@ unsigned SimpleOpenGLTest::AddRenderTask(unsigned objectIndex,
 	renderTask.Primitive.CountVertices = geometryData.CountVertices;
 	renderTask.Primitive.CountIndices = geometryData.CountIndices;
 	
-	renderTask.BoundingBox = AABoundingBox::GetBoundingBox(vertexData.GetPositions() + geometryData.BaseVertex,
-		geometryData.CountVertices);
+	renderTask.BoundingBox = model.MeshLocalBounds[objectData.MeshIndex].Box;
 
 	unsigned rtgIndex = (isOpaque ? 0 : 1);
 
@@ -425,7 +424,7 @@ void SimpleOpenGLTest::LoadAssets()
 		// Adding objects.
 		for (unsigned i = 0; i < countObjects; i++)
 		{
-			AddRenderTask(i, modelLoadingResult, modelInstantiationResult, vertexData);
+			AddRenderTask(i, modelLoadingResult, modelInstantiationResult);
 		}
 
 		// Setting position, orientation, scaler.
@@ -511,13 +510,13 @@ void SimpleOpenGLTest::DerivedPostUpdate(EngineBuildingBlocks::PostUpdateContext
 
 		if (m_IsWindowed)
 		{
-			std::stringstream ssTitle;
-			ssTitle << m_Title << " :: FPS: " << fps << " :: Draw calls: " << m_CountDrawCalls;
-			m_Window.SetTitle(ssTitle.str());
+			Core::FixedSizedOutputStream<256> title;
+			Core::FormatTo(title, CORE_FORMAT_STRING("%x :: FPS: %x :: Draw calls: %x"), m_Title, fps, m_CountDrawCalls);
+			m_Window.SetTitle(title.ToCString());
 		}
-		std::stringstream ssTRT;
-		ssTRT << "FPS: " << fps << "\nDraw calls : " << m_CountDrawCalls;
-		m_Statistics_TRT.SetText(ssTRT.str().c_str());
+		char statisticsText[64];
+		Core::FormatTo(statisticsText, CORE_FORMAT_STRING("FPS: %x\nDraw calls : %x"), fps, m_CountDrawCalls);
+		m_Statistics_TRT.SetText(statisticsText);
 		m_Statistics_TRT.Update(m_OGLU.TextRenderer);
 	}
 }
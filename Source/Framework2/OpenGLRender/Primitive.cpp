@@ -83,8 +83,10 @@ namespace OpenGLRender
 {
 	void DrawPrimitive(const IndexedPrimitive& primitive)
 	{
+		auto pIndexBuffer = primitive.PIndexBuffer;
 		glDrawElementsBaseVertex(c_PrimitiveTopologyMap[(int)primitive.Topology], primitive.CountIndices,
-			GL_UNSIGNED_INT, (void*)(size_t)(primitive.BaseIndex << 2), primitive.BaseVertex);
+			pIndexBuffer->GetIndexType(), (void*)(size_t)(primitive.BaseIndex * pIndexBuffer->GetIndexSize()),
+			primitive.BaseVertex);
 	}
 }
 
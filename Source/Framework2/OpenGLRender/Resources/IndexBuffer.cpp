@@ -4,15 +4,31 @@
 
 using namespace OpenGLRender;
 
+IndexBuffer::IndexBuffer()
+	: m_IndexType(GL_UNSIGNED_INT)
+{
+}
+
 void IndexBuffer::Initialize(BufferUsage usage, unsigned countIndices, const unsigned* pData)
 {
-	auto size = countIndices << 2; // Indices are always unsigned values.
+	m_IndexType = GL_UNSIGNED_INT;
+	auto size = countIndices << 2;
 	m_Buffer.Initialize(BufferTarget::IndexBuffer, size, usage, pData);
 }
 
 void IndexBuffer::Initialize(BufferUsage usage, const EngineBuildingBlocks::Graphics::IndexData& indexData)
 {
-	Initialize(usage, indexData.GetCountIndices(), indexData.Data.GetArray());
+	if (indexData.CanUseUint16Indices())
+	{
+		Core::SimpleTypeVectorU<std::uint16_t> indices;
+		indexData.As_Uint16_Data(indices);
+		m_IndexType = GL_UNSIGNED_SHORT;
+		m_Buffer.Initialize(BufferTarget::IndexBuffer, indices.GetSize() << 1, usage, indices.GetArray());
+	}
+	else
+	{
+		Initialize(usage, indexData.GetCountIndices(), indexData.Data.GetArray());
+	}
 }
 
 void IndexBuffer::Delete()
@@ -25,6 +41,16 @@ GLuint IndexBuffer::GetHandle() const
 	return m_Buffer.GetHandle();
 }
 
+GLenum IndexBuffer::GetIndexType() const
+{
+	return m_IndexType;
+}
+
+unsigned IndexBuffer::GetIndexSize() const
+{
+	return (m_IndexType == GL_UNSIGNED_SHORT ? 2U : 4U);
+}
+
 void IndexBuffer::Bind()
 {
 	m_Buffer.Bind(BufferTarget::IndexBuffer);
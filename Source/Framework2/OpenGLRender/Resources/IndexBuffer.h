@@ -11,17 +11,26 @@ namespace OpenGLRender
 	class IndexBuffer
 	{
 		Buffer m_Buffer;
+		GLenum m_IndexType;
 
 	public:
 
+		IndexBuffer();
+
 		void Initialize(BufferUsage usage, unsigned countIndices,
 			const unsigned* pData = nullptr);
+
+		// The buffer has 16-bit indices if the index data fits to 16 bits.
 		void Initialize(BufferUsage usage,
 			const EngineBuildingBlocks::Graphics::IndexData& indexData);
 		void Delete();
 
 		GLuint GetHandle() const;
 
+		// GL_UNSIGNED_SHORT or GL_UNSIGNED_INT.
+		GLenum GetIndexType() const;
+		unsigned GetIndexSize() const;
+
 		void Bind();
 		void Unbind();
 
@@ -14,11 +14,26 @@ using namespace OpenGLRender;
 
 const unsigned c_VertexElementTypeMap[] =
 {
-	0,					// Unknown
-	GL_FLOAT,			// Float
-	GL_UNSIGNED_INT		// Uint32
+	0,									// Unknown
+	GL_FLOAT,							// Float
+	GL_UNSIGNED_INT,					// Uint32
+	GL_HALF_FLOAT,						// Half
+	GL_SHORT,							// Snorm16
+	GL_UNSIGNED_SHORT,					// Unorm16
+	GL_BYTE,							// Snorm8
+	GL_UNSIGNED_BYTE,					// Unorm8
+	GL_UNSIGNED_SHORT,					// Uint16
+	GL_UNSIGNED_BYTE,					// Uint8
+	GL_UNSIGNED_INT_2_10_10_10_REV		// Unorm10_10_10_2
 };
 
+inline void SetVertexElementAttributeBuffer(ShaderProgram& program, GLint location, const VertexElement& element,
+	int stride, int offset)
+{
+	program.SetAttributeBuffer(location, (int)element.GetCountComponents(), c_VertexElementTypeMap[(int)element.Type],
+		stride, offset, (IsNormalizedVertexElementType(element.Type) ? GL_TRUE : GL_FALSE));
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -281,7 +296,9 @@ void ShaderProgram::SetAttributeBuffer(GLint location, int tupleSize, GLenum typ
 	case GL_UNSIGNED_SHORT:
 	case GL_INT:
 	case GL_UNSIGNED_INT:
-		glVertexAttribIPointer(location, tupleSize, type, stride, offsetPtr); break;
+		if (normalized) glVertexAttribPointer(location, tupleSize, type, normalized, stride, offsetPtr);
+		else glVertexAttribIPointer(location, tupleSize, type, stride, offsetPtr);
+		break;
 	case GL_DOUBLE:
 		glVertexAttribLPointer(location, tupleSize, type, stride, offsetPtr); break;
 	default:
@@ -333,7 +350,7 @@ void ShaderProgram::SetInputLayout(const VertexInputLayout& inputLayout, unsigne
 		auto& element = ilElements[i];
 		auto location = GetAttributeLocation(element.Name.c_str());
 		assert(location != -1);
-		SetAttributeBuffer(location, element.Count, c_VertexElementTypeMap[(int)element.Type], stride, offset, GL_FALSE);
+		SetVertexElementAttributeBuffer(*this, location, element, stride, offset);
 		EnableAttributeArray(location);
 		if (vertexAttributeDivisor != Core::c_InvalidSizeU) SetAttributeDivisor(location, vertexAttributeDivisor);
 		offset += element.GetTotalSize();
@@ -355,7 +372,7 @@ void ShaderProgram::TrySetInputLayoutElements(const VertexInputLayout& inputLayo
 		auto& element = ilElements[i];
 		auto location = GetAttributeLocation(element.Name.c_str());
 		if (location == -1) continue;
-		SetAttributeBuffer(location, element.Count, c_VertexElementTypeMap[(int)element.Type], stride, offset, GL_FALSE);
+		SetVertexElementAttributeBuffer(*this, location, element, stride, offset);
 		EnableAttributeArray(location);
 		if (vertexAttributeDivisor != Core::c_InvalidSizeU) SetAttributeDivisor(location, vertexAttributeDivisor);
 		offset += element.GetTotalSize();
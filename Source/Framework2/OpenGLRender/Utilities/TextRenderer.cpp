@@ -260,8 +260,10 @@ inline void OGL_TR_UpdateConstantBuffer(UniformBuffer* cb, const TextRenderTaskD
 
 inline void OGL_TR_Draw(const IndexedPrimitive& primitive, unsigned instanceIndex, unsigned countInstances)
 {
+	auto pIndexBuffer = primitive.PIndexBuffer;
 	glDrawElementsInstancedBaseVertexBaseInstance(c_PrimitiveTopologyMap[(int)primitive.Topology],
-		primitive.CountIndices, GL_UNSIGNED_INT, (const void*)(size_t)(primitive.BaseIndex << 2),
+		primitive.CountIndices, pIndexBuffer->GetIndexType(),
+		(const void*)(size_t)(primitive.BaseIndex * pIndexBuffer->GetIndexSize()),
 		countInstances, primitive.BaseVertex, instanceIndex);
 }
 
@@ -644,6 +644,72 @@ namespace DirectXRender
 			case 4: return DXGI_FORMAT_R32G32B32A32_UINT;
 			}
 			break;
+		case EngineBuildingBlocks::Graphics::VertexElementType::Half:
+			assert(typeSize == 2);
+			switch (count)
+			{
+			case 1: return DXGI_FORMAT_R16_FLOAT;
+			case 2: return DXGI_FORMAT_R16G16_FLOAT;
+			case 4: return DXGI_FORMAT_R16G16B16A16_FLOAT;
+			}
+			break;
+		case EngineBuildingBlocks::Graphics::VertexElementType::Snorm16:
+			assert(typeSize == 2);
+			switch (count)
+			{
+			case 1: return DXGI_FORMAT_R16_SNORM;
+			case 2: return DXGI_FORMAT_R16G16_SNORM;
+			case 4: return DXGI_FORMAT_R16G16B16A16_SNORM;
+			}
+			break;
+		case EngineBuildingBlocks::Graphics::VertexElementType::Unorm16:
+			assert(typeSize == 2);
+			switch (count)
+			{
+			case 1: return DXGI_FORMAT_R16_UNORM;
+			case 2: return DXGI_FORMAT_R16G16_UNORM;
+			case 4: return DXGI_FORMAT_R16G16B16A16_UNORM;
+			}
+			break;
+		case EngineBuildingBlocks::Graphics::VertexElementType::Uint16:
+			assert(typeSize == 2);
+			switch (count)
+			{
+			case 1: return DXGI_FORMAT_R16_UINT;
+			case 2: return DXGI_FORMAT_R16G16_UINT;
+			case 4: return DXGI_FORMAT_R16G16B16A16_UINT;
+			}
+			break;
+		case EngineBuildingBlocks::Graphics::VertexElementType::Snorm8:
+			assert(typeSize == 1);
+			switch (count)
+			{
+			case 1: return DXGI_FORMAT_R8_SNORM;
+			case 2: return DXGI_FORMAT_R8G8_SNORM;
+			case 4: return DXGI_FORMAT_R8G8B8A8_SNORM;
+			}
+			break;
+		case EngineBuildingBlocks::Graphics::VertexElementType::Unorm8:
+			assert(typeSize == 1);
+			switch (count)
+			{
+			case 1: return DXGI_FORMAT_R8_UNORM;
+			case 2: return DXGI_FORMAT_R8G8_UNORM;
+			case 4: return DXGI_FORMAT_R8G8B8A8_UNORM;
+			}
+			break;
+		case EngineBuildingBlocks::Graphics::VertexElementType::Uint8:
+			assert(typeSize == 1);
+			switch (count)
+			{
+			case 1: return DXGI_FORMAT_R8_UINT;
+			case 2: return DXGI_FORMAT_R8G8_UINT;
+			case 4: return DXGI_FORMAT_R8G8B8A8_UINT;
+			}
+			break;
+		case EngineBuildingBlocks::Graphics::VertexElementType::Unorm10_10_10_2:
+			assert(typeSize == 4 && count == 1);
+			return DXGI_FORMAT_R10G10B10A2_UNORM;
 		}
 		EngineBuildingBlocks::RaiseException("Unknown vertex element format was used.");
 